@@ -48,7 +48,7 @@ typedef unsigned int GLenum;
 
 // Version number for shader translation API.
 // It is incremented every time the API changes.
-#define ANGLE_SH_VERSION 132
+#define ANGLE_SH_VERSION 139
 
 typedef enum {
   SH_GLES2_SPEC = 0x8B40,
@@ -172,6 +172,13 @@ typedef enum {
   // It is intended as a workaround for drivers that do not handle
   // struct scopes correctly, including all Mac drivers and Linux AMD.
   SH_REGENERATE_STRUCT_NAMES = 0x80000,
+
+  // This flag shrinks the translated code: it removes the functions main()
+  // does not call, propagates and folds constants, removes if statements
+  // with constant conditions, and removes variables that are never read.
+  // Variables are collected from the shrunk code, so a uniform only used by
+  // removed code is not reported as statically used.
+  SH_OPTIMIZE = 0x100000,
 } ShCompileOptions;
 
 // Defines alternate strategies for implementing array index clamping.
@@ -329,6 +336,156 @@ COMPILER_EXPORT bool ShCompile(
     size_t numStrings,
     int compileOptions);
 
+// A single compile of a batch passed to ShCompileBatch. The shader strings
+// must stay valid until ShCompileBatch returns.
+typedef struct
+{
+    ShHandle handle;
+    const char * const *shaderStrings;
+    size_t numStrings;
+    int compileOptions;
+
+    // Set to the value ShCompile would have returned for this job.
+    bool success;
+} ShCompileJob;
+
+//
+// Compiles several shaders at once on a pool of worker threads, including the
+// calling thread. Each job behaves as if ShCompile was called with its
+// parameters, and its results are queried from its handle afterwards.
+// Concurrent ShCompileBatch calls are serialized.
+// Returns true if every job compiled successfully, else false. Nothing is
+// compiled and false is returned if a handle appears in more than one job.
+// Parameters:
+// jobs: Specifies an array of numJobs compiles. Each job uses its own handle.
+// numJobs: Specifies the number of elements in the jobs array.
+// maxThreads: Specifies the maximum number of threads that compile at once.
+//             0 uses one thread per hardware thread.
+//
+COMPILER_EXPORT bool ShCompileBatch(
+    ShCompileJob *jobs,
+    size_t numJobs,
+    size_t maxThreads);
+
+// Sets the file used to cache translation results across ShCompile calls and
+// process runs. Results are keyed by the shader strings, the compiler type,
+// spec and output, the built-in resources and the compile options. Compiles
+// using a name hashing function are not cached.
+// The cache file is only tied to ANGLE_SH_VERSION, so embedders should use a
+// different file for each build of the translator.
+// Must not be called while other threads are compiling.
+// Parameters:
+// fileName: Path of the cache file, created if it does not exist. NULL
+//           disables the cache.
+// If the function succeeds, the return value is true, else false.
+COMPILER_EXPORT bool ShSetTranslationCacheFile(const char *fileName);
+
+// Returns the number of ShCompile calls that were served from or missed the
+// translation cache since it was set.
+COMPILER_EXPORT void ShGetTranslationCacheStatistics(size_t *hitCount,
+                                                     size_t *missCount);
+
+// Compilers allocate from memory pools. The blocks of memory a pool is done
+// with go to a process-wide cache, and later compiles on any compiler and
+// thread take their blocks from it before asking the OS. ShFinalize frees
+// the cached blocks.
+// Returns the number of blocks taken from the cache (hits) and from the OS
+// (misses) since the process started, and the bytes the cache holds now.
+COMPILER_EXPORT void ShGetPoolPageCacheStatistics(size_t *hitCount,
+                                                  size_t *missCount,
+                                                  size_t *cachedBytes);
+
+// Maps pool blocks of 2MB and more, which hold the trees of very large
+// shaders, as huge pages where the OS allows it. Off by default.
+COMPILER_EXPORT void ShSetPoolHugePagesEnabled(bool enabled);
+
+// Buckets of compile time, each charged with the steps listed for it
+// wherever in the compile they run; the buckets are not in the order the
+// steps run. A walk of the tree shared by several passes is split between
+// their buckets in proportion to the visits each pass makes. Steps that only
+// apply to some compile options or shader types are skipped when they do
+// not apply.
+typedef enum {
+  // Preprocessing and parsing into the intermediate tree.
+  SH_COMPILE_PHASE_PARSE,
+  SH_COMPILE_PHASE_POST_PROCESS,
+  // Validation of the tree.
+  SH_COMPILE_PHASE_LIMIT_EXPRESSION_COMPLEXITY,
+  SH_COMPILE_PHASE_DETECT_CALL_DEPTH,
+  SH_COMPILE_PHASE_VALIDATE_OUTPUTS,
+  SH_COMPILE_PHASE_VALIDATE_LIMITATIONS,
+  SH_COMPILE_PHASE_TIMING_RESTRICTIONS,
+  // Marking of the loops to unroll, and the check for float loop indices
+  // into sampler arrays.
+  SH_COMPILE_PHASE_UNROLL_FOR_LOOPS,
+  // Marking of the built-in calls to emulate and the array indices to clamp.
+  SH_COMPILE_PHASE_EMULATE_BUILT_IN_FUNCTIONS,
+  SH_COMPILE_PHASE_CLAMP_ARRAY_BOUNDS,
+  // CSS shader rewriting, which runs before the loops are marked,
+  // gl_Position initialization and short circuit unfolding, which run
+  // after, and constructor scalarization and struct renaming, which run
+  // after the variables are collected.
+  SH_COMPILE_PHASE_REWRITE_TREE,
+  SH_COMPILE_PHASE_OPTIMIZE,
+  // Variable collection, uniform packing checks and varying initialization.
+  SH_COMPILE_PHASE_COLLECT_VARIABLES,
+  // Output of the intermediate tree and of the object code.
+  SH_COMPILE_PHASE_TRANSLATE,
+
+  SH_COMPILE_PHASE_COUNT
+} ShCompilePhase;
+
+// Statistics about the last ShCompile call on a compiler, to help find
+// shaders that are slow or expensive to translate. All values are 0 when the
+// results came from the translation cache.
+typedef struct
+{
+    // Wall-clock time of each phase, and of the whole compile, in
+    // microseconds. A skipped phase only accounts for the time it takes to
+    // decide to skip it.
+    double phaseMicroseconds[SH_COMPILE_PHASE_COUNT];
+    double totalMicroseconds;
+
+    // Allocations made from the compiler's pool, the bytes they requested,
+    // and the peak memory the pool held for them.
+    size_t poolAllocationCount;
+    size_t poolAllocatedBytes;
+    size_t poolPeakBytes;
+
+    // Pages the pool took, and how many of those it re-used from earlier
+    // compiles rather than obtained from the OS.
+    size_t poolPageCount;
+    size_t poolReusedPageCount;
+
+    // Nodes in the intermediate tree at the end of the compile.
+    size_t astNodeCount;
+
+    // Symbol table lookups, and hash table entries they visited.
+    size_t symbolLookupCount;
+    size_t symbolProbeCount;
+
+    // Macros expanded by the preprocessor, and how many of those expansions
+    // reused the cached expansion of an object-like macro.
+    size_t macroExpansionCount;
+    size_t macroExpansionCacheHitCount;
+
+    // Walks of the tree made by the validation, marking and variable
+    // collection passes, which share walks where they can.
+    size_t analysisWalkCount;
+} ShCompileStatistics;
+
+// Returns the statistics of the last compile.
+// Parameters:
+// handle: Specifies the compiler
+// statistics: Receives the statistics.
+// If the function succeeds, the return value is true, else false.
+COMPILER_EXPORT bool ShGetCompileStatistics(const ShHandle handle,
+                                            ShCompileStatistics *statistics);
+
+// Returns a short, human-readable name for a compile phase, or NULL if the
+// phase is not valid.
+COMPILER_EXPORT const char *ShGetCompilePhaseName(ShCompilePhase phase);
+
 // Return the version of the shader language.
 COMPILER_EXPORT int ShGetShaderVersion(const ShHandle handle);
 
@@ -29,6 +29,7 @@ static sh::GLenum FindShaderType(const char* fileName);
 static bool CompileFile(char* fileName, ShHandle compiler, int compileOptions);
 static void LogMsg(const char* msg, const char* name, const int num, const char* logName);
 static void PrintActiveVariables(ShHandle compiler, ShShaderInfo varType);
+static void PrintCompileStatistics(ShHandle compiler);
 
 // If NUM_SOURCE_STRINGS is set to a value > 1, the input file data is
 // broken into that many chunks.
@@ -62,6 +63,7 @@ int main(int argc, char* argv[])
     TFailCode failCode = ESuccess;
 
     int compileOptions = 0;
+    bool printStatistics = false;
     int numCompiles = 0;
     ShHandle vertexCompiler = 0;
     ShHandle fragmentCompiler = 0;
@@ -82,11 +84,13 @@ int main(int argc, char* argv[])
             switch (argv[0][1]) {
             case 'i': compileOptions |= SH_INTERMEDIATE_TREE; break;
             case 'o': compileOptions |= SH_OBJECT_CODE; break;
+            case 'O': compileOptions |= SH_OPTIMIZE; break;
             case 'u': compileOptions |= SH_VARIABLES; break;
             case 'l': compileOptions |= SH_UNROLL_FOR_LOOP_WITH_INTEGER_INDEX; break;
             case 'e': compileOptions |= SH_EMULATE_BUILT_IN_FUNCTIONS; break;
             case 'd': compileOptions |= SH_DEPENDENCY_GRAPH; break;
             case 't': compileOptions |= SH_TIMING_RESTRICTIONS; break;
+            case 'p': printStatistics = true; break;
             case 's':
                 if (argv[0][2] == '=') {
                     switch (argv[0][3]) {
@@ -183,6 +187,12 @@ int main(int argc, char* argv[])
                   LogMsg("END", "COMPILER", numCompiles, "ACTIVE UNIFORMS");
                   printf("\n\n");
               }
+              if (printStatistics) {
+                  LogMsg("BEGIN", "COMPILER", numCompiles, "STATISTICS");
+                  PrintCompileStatistics(compiler);
+                  LogMsg("END", "COMPILER", numCompiles, "STATISTICS");
+                  printf("\n\n");
+              }
               if (!compiled)
                   failCode = EFailCompile;
               ++numCompiles;
@@ -213,16 +223,18 @@ int main(int argc, char* argv[])
 //
 void usage()
 {
-    printf("Usage: translate [-i -m -o -u -l -e -b=e -b=g -b=h -x=i -x=d] file1 file2 ...\n"
+    printf("Usage: translate [-i -m -o -O -u -l -e -p -b=e -b=g -b=h -x=i -x=d] file1 file2 ...\n"
         "Where: filename : filename ending in .frag or .vert\n"
         "       -i       : print intermediate tree\n"
         "       -m       : map long variable names\n"
         "       -o       : print translated code\n"
+        "       -O       : optimize translated code\n"
         "       -u       : print active attribs and uniforms\n"
         "       -l       : unroll for-loops with integer indices\n"
         "       -e       : emulate certain built-in functions (workaround for driver bugs)\n"
         "       -t       : enforce experimental timing restrictions\n"
         "       -d       : print dependency graph used to enforce timing restrictions\n"
+        "       -p       : print phase timings, memory use and tree size of each compile\n"
         "       -s=e     : use GLES2 spec (this is by default)\n"
         "       -s=w     : use WebGL spec\n"
         "       -s=c     : use CSS Shaders spec\n"
@@ -386,3 +398,21 @@ static void FreeShaderSource(ShaderSource& source) {
     source.clear();
 }
 
+void PrintCompileStatistics(ShHandle compiler)
+{
+    ShCompileStatistics statistics;
+    if (!ShGetCompileStatistics(compiler, &statistics))
+        return;
+
+    for (int phase = 0; phase < SH_COMPILE_PHASE_COUNT; ++phase) {
+        printf("%-28s: %10.1f us\n", ShGetCompilePhaseName(static_cast<ShCompilePhase>(phase)),
+               statistics.phaseMicroseconds[phase]);
+    }
+    printf("%-28s: %10.1f us\n", "total", statistics.totalMicroseconds);
+    printf("%-28s: %10u\n", "pool allocations", static_cast<unsigned int>(statistics.poolAllocationCount));
+    printf("%-28s: %10u bytes\n", "pool allocated", static_cast<unsigned int>(statistics.poolAllocatedBytes));
+    printf("%-28s: %10u bytes\n", "pool peak", static_cast<unsigned int>(statistics.poolPeakBytes));
+    printf("%-28s: %10u\n", "tree nodes", static_cast<unsigned int>(statistics.astNodeCount));
+    printf("%-28s: %10u\n", "symbol lookups", static_cast<unsigned int>(statistics.symbolLookupCount));
+    printf("%-28s: %10u\n", "symbol table probes", static_cast<unsigned int>(statistics.symbolProbeCount));
+}
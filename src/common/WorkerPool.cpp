@@ -0,0 +1,142 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// WorkerPool.cpp: Implements the gl::WorkerPool class.
+
+#include "common/WorkerPool.h"
+#include "common/debug.h"
+
+#include <algorithm>
+
+namespace gl
+{
+
+WorkerPool::WorkerPool(size_t threadCount)
+    : mTerminate(false),
+      mTask(NULL),
+      mUserData(NULL),
+      mCount(0),
+      mRangeCount(0),
+      mNextRange(0),
+      mPendingRanges(0)
+{
+    ASSERT(threadCount > 0);
+
+    for (size_t i = 1; i < threadCount; i++)
+    {
+        mWorkers.push_back(std::thread(&WorkerPool::workerMain, this));
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mTerminate = true;
+    }
+    mWorkAvailable.notify_all();
+
+    for (size_t i = 0; i < mWorkers.size(); i++)
+    {
+        mWorkers[i].join();
+    }
+}
+
+size_t WorkerPool::getThreadCount() const
+{
+    return mWorkers.size() + 1;
+}
+
+void WorkerPool::parallelFor(size_t count, size_t minRangeSize, ParallelTaskFunction task, void *userData)
+{
+    minRangeSize = std::max<size_t>(minRangeSize, 1);
+
+    // Ranges are spread evenly, which keeps every one of them at or above minRangeSize
+    size_t rangeCount = std::min(getThreadCount(), count / minRangeSize);
+
+    if (rangeCount <= 1)
+    {
+        if (count > 0)
+        {
+            task(0, count, userData);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> submitLock(mSubmitMutex);
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    ASSERT(mPendingRanges == 0);
+    mTask = task;
+    mUserData = userData;
+    mCount = count;
+    mRangeCount = rangeCount;
+    mNextRange = 0;
+    mPendingRanges = rangeCount;
+
+    mWorkAvailable.notify_all();
+
+    runPendingRanges(&lock);
+
+    while (mPendingRanges > 0)
+    {
+        mWorkDone.wait(lock);
+    }
+
+    // Stop workers that wake up late from picking the finished job up again
+    mRangeCount = 0;
+    mNextRange = 0;
+}
+
+size_t WorkerPool::GetHardwareThreadCount()
+{
+    return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+void WorkerPool::workerMain()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    while (true)
+    {
+        while (!mTerminate && mNextRange >= mRangeCount)
+        {
+            mWorkAvailable.wait(lock);
+        }
+
+        if (mTerminate)
+        {
+            return;
+        }
+
+        runPendingRanges(&lock);
+    }
+}
+
+void WorkerPool::runPendingRanges(std::unique_lock<std::mutex> *lock)
+{
+    while (mNextRange < mRangeCount)
+    {
+        size_t begin = mNextRange * mCount / mRangeCount;
+        size_t end = (mNextRange + 1) * mCount / mRangeCount;
+        ParallelTaskFunction task = mTask;
+        void *userData = mUserData;
+        mNextRange++;
+
+        lock->unlock();
+        task(begin, end, userData);
+        lock->lock();
+
+        ASSERT(mPendingRanges > 0);
+        mPendingRanges--;
+        if (mPendingRanges == 0)
+        {
+            mWorkDone.notify_all();
+        }
+    }
+}
+
+}
@@ -0,0 +1,69 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// WorkerPool.h: Defines the gl::WorkerPool class, a small fixed set of threads
+// used to split data-parallel work (image loads, pixel copies, mip generation)
+// into contiguous ranges that run alongside the calling thread.
+
+#ifndef COMMON_WORKERPOOL_H_
+#define COMMON_WORKERPOOL_H_
+
+#include "common/angleutils.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gl
+{
+
+// Processes the items [begin, end) of a parallelFor call.
+typedef void (*ParallelTaskFunction)(size_t begin, size_t end, void *userData);
+
+class WorkerPool
+{
+  public:
+    // threadCount includes the calling thread, so a pool of one thread runs all work inline.
+    explicit WorkerPool(size_t threadCount);
+    ~WorkerPool();
+
+    size_t getThreadCount() const;
+
+    // Splits [0, count) into at most getThreadCount() contiguous ranges of at least minRangeSize
+    // items and calls task once per range. The calling thread takes part and the call returns
+    // once every range is done. Tasks must not call back into the same pool.
+    void parallelFor(size_t count, size_t minRangeSize, ParallelTaskFunction task, void *userData);
+
+    static size_t GetHardwareThreadCount();
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(WorkerPool);
+
+    void workerMain();
+    void runPendingRanges(std::unique_lock<std::mutex> *lock);
+
+    std::vector<std::thread> mWorkers;
+
+    // Serializes parallelFor calls coming from contexts on different threads
+    std::mutex mSubmitMutex;
+
+    std::mutex mMutex;
+    std::condition_variable mWorkAvailable;
+    std::condition_variable mWorkDone;
+    bool mTerminate;
+
+    ParallelTaskFunction mTask;
+    void *mUserData;
+    size_t mCount;
+    size_t mRangeCount;
+    size_t mNextRange;
+    size_t mPendingRanges;
+};
+
+}
+
+#endif // COMMON_WORKERPOOL_H_
@@ -33,3 +33,10 @@
 #if !defined(ANGLE_SHADER_DEBUG_INFO)
 #define ANGLE_SHADER_DEBUG_INFO ANGLE_DISABLED
 #endif
+
+// Parallel image processing
+// ENABLED splits large texture uploads, pixel readbacks and mipmap generation
+// across a pool of worker threads owned by the renderer.
+#if !defined(ANGLE_PARALLEL_IMAGE_PROCESSING)
+#define ANGLE_PARALLEL_IMAGE_PROCESSING ANGLE_DISABLED
+#endif
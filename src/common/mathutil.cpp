@@ -35,6 +35,12 @@ static const float g_sharedexp_max = ((pow(2.0f, g_sharedexp_mantissabits) - 1)
                                        pow(2.0f, g_sharedexp_mantissabits)) *
                                      pow(2.0f, g_sharedexp_maxexponent - g_sharedexp_bias);
 
+// The exponent convertRGBFloatsTo999E5 derives from the largest component, before clamping
+static float sharedExponentLog(float maxComponent)
+{
+    return floor(log(maxComponent));
+}
+
 unsigned int convertRGBFloatsTo999E5(float red, float green, float blue)
 {
     const float red_c = std::max<float>(0, std::min(g_sharedexp_max, red));
@@ -42,7 +48,7 @@ unsigned int convertRGBFloatsTo999E5(float red, float green, float blue)
     const float blue_c = std::max<float>(0, std::min(g_sharedexp_max, blue));
 
     const float max_c = std::max<float>(std::max<float>(red_c, green_c), blue_c);
-    const float exp_p = std::max<float>(-g_sharedexp_bias - 1, floor(log(max_c))) + 1 + g_sharedexp_bias;
+    const float exp_p = std::max<float>(-g_sharedexp_bias - 1, sharedExponentLog(max_c)) + 1 + g_sharedexp_bias;
     const int max_s = floor((max_c / (pow(2.0f, exp_p - g_sharedexp_bias - g_sharedexp_mantissabits))) + 0.5f);
     const int exp_s = (max_s < pow(2.0f, g_sharedexp_mantissabits)) ? exp_p : exp_p + 1;
 
@@ -55,6 +61,29 @@ unsigned int convertRGBFloatsTo999E5(float red, float green, float blue)
     return *reinterpret_cast<unsigned int*>(&output);
 }
 
+float sharedExponentThreshold999E5(int exponent)
+{
+    // The bit patterns of the positive floats sort like their values, so search those between
+    // zero and infinity.
+    unsigned int low = 0;
+    unsigned int high = 0x7F800000;
+
+    while (low < high)
+    {
+        unsigned int middle = low + (high - low) / 2;
+        if (sharedExponentLog(bitCast<float>(middle)) >= exponent)
+        {
+            high = middle;
+        }
+        else
+        {
+            low = middle + 1;
+        }
+    }
+
+    return bitCast<float>(low);
+}
+
 void convert999E5toRGBFloats(unsigned int input, float *red, float *green, float *blue)
 {
     const RGB9E5Data *inputData = reinterpret_cast<const RGB9E5Data*>(&input);
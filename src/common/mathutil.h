@@ -16,6 +16,15 @@
 #include <algorithm>
 #include <string.h>
 
+// The CPUs the supportsSSE* functions can query. Vector code is only built for these.
+#if (ANGLE_PLATFORM_WINDOWS && !defined(_M_ARM)) || defined(__i386__) || defined(__x86_64__)
+#define ANGLE_X86_CPU 1
+#endif
+
+#if defined(ANGLE_X86_CPU) && !ANGLE_PLATFORM_WINDOWS
+#include <cpuid.h>
+#endif
+
 namespace gl
 {
 
@@ -107,9 +116,79 @@ inline unsigned int unorm(float x)
     }
 }
 
+#if defined(ANGLE_X86_CPU)
+
+// Reads the feature flags of CPUID leaf 1, which the supportsSSE* functions test. Returns false
+// when the CPU does not report that leaf.
+inline bool getCPUFeatureFlags(unsigned int *ecx, unsigned int *edx)
+{
+#if ANGLE_PLATFORM_WINDOWS
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 1)
+    {
+        return false;
+    }
+
+    __cpuid(info, 1);
+    *ecx = static_cast<unsigned int>(info[2]);
+    *edx = static_cast<unsigned int>(info[3]);
+    return true;
+#else
+    unsigned int eax = 0;
+    unsigned int ebx = 0;
+    return __get_cpuid(1, &eax, &ebx, ecx, edx) != 0;
+#endif
+}
+
+// Reads the extended feature flags of CPUID leaf 7, which supportsAVX2 tests. Returns false when
+// the CPU does not report that leaf.
+inline bool getCPUExtendedFeatureFlags(unsigned int *ebx)
+{
+#if ANGLE_PLATFORM_WINDOWS
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+    {
+        return false;
+    }
+
+    __cpuidex(info, 7, 0);
+    *ebx = static_cast<unsigned int>(info[1]);
+    return true;
+#else
+    if (__get_cpuid_max(0, NULL) < 7)
+    {
+        return false;
+    }
+
+    unsigned int eax = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+    __cpuid_count(7, 0, eax, *ebx, ecx, edx);
+    return true;
+#endif
+}
+
+// Reads the low half of XCR0, the register state the operating system saves on context switches.
+// Only valid when CPUID reports OSXSAVE.
+inline unsigned int getEnabledRegisterState()
+{
+#if ANGLE_PLATFORM_WINDOWS
+    return static_cast<unsigned int>(_xgetbv(0));
+#else
+    unsigned int eax = 0;
+    unsigned int edx = 0;
+    __asm__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return eax;
+#endif
+}
+
+#endif
+
 inline bool supportsSSE2()
 {
-#if ANGLE_PLATFORM_WINDOWS && !defined(_M_ARM)
+#if defined(ANGLE_X86_CPU)
     static bool checked = false;
     static bool supports = false;
 
@@ -118,14 +197,87 @@ inline bool supportsSSE2()
         return supports;
     }
 
-    int info[4];
-    __cpuid(info, 0);
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+    supports = getCPUFeatureFlags(&ecx, &edx) && ((edx >> 26) & 1);
+
+    checked = true;
 
-    if (info[0] >= 1)
+    return supports;
+#else
+    UNIMPLEMENTED();
+    return false;
+#endif
+}
+
+inline bool supportsSSSE3()
+{
+#if defined(ANGLE_X86_CPU)
+    static bool checked = false;
+    static bool supports = false;
+
+    if (checked)
+    {
+        return supports;
+    }
+
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+    supports = getCPUFeatureFlags(&ecx, &edx) && ((ecx >> 9) & 1);
+
+    checked = true;
+
+    return supports;
+#else
+    UNIMPLEMENTED();
+    return false;
+#endif
+}
+
+inline bool supportsSSE41()
+{
+#if defined(ANGLE_X86_CPU)
+    static bool checked = false;
+    static bool supports = false;
+
+    if (checked)
     {
-        __cpuid(info, 1);
+        return supports;
+    }
+
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+    supports = getCPUFeatureFlags(&ecx, &edx) && ((ecx >> 19) & 1);
+
+    checked = true;
+
+    return supports;
+#else
+    UNIMPLEMENTED();
+    return false;
+#endif
+}
 
-        supports = (info[3] >> 26) & 1;
+inline bool supportsAVX2()
+{
+#if defined(ANGLE_X86_CPU)
+    static bool checked = false;
+    static bool supports = false;
+
+    if (checked)
+    {
+        return supports;
+    }
+
+    // The AVX2 flag only counts when the CPU has AVX and the operating system saves the SSE and
+    // AVX registers (XCR0 bits 1 and 2), which can only be read when OSXSAVE is reported.
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+    if (getCPUFeatureFlags(&ecx, &edx) && ((ecx >> 27) & 1) && ((ecx >> 28) & 1) &&
+        (getEnabledRegisterState() & 0x6) == 0x6)
+    {
+        unsigned int ebx = 0;
+        supports = getCPUExtendedFeatureFlags(&ebx) && ((ebx >> 5) & 1);
     }
 
     checked = true;
@@ -181,6 +333,11 @@ inline unsigned short float32ToFloat16(float fp32)
 float float16ToFloat32(unsigned short h);
 
 unsigned int convertRGBFloatsTo999E5(float red, float green, float blue);
+
+// The smallest value of the largest component for which convertRGBFloatsTo999E5 derives at least
+// the given exponent, before the bias is added. Vector code compares against these rather than
+// take a logarithm per pixel.
+float sharedExponentThreshold999E5(int exponent);
 void convert999E5toRGBFloats(unsigned int input, float *red, float *green, float *blue);
 
 inline unsigned short float32ToFloat11(float fp32)
@@ -131,8 +131,8 @@ bool isMacroNameReserved(const std::string &name)
 bool isMacroPredefined(const std::string &name,
                        const pp::MacroSet &macroSet)
 {
-    pp::MacroSet::const_iterator iter = macroSet.find(name);
-    return iter != macroSet.end() ? iter->second.predefined : false;
+    const pp::Macro *macro = macroSet.find(name);
+    return macro != NULL ? macro->predefined : false;
 }
 
 }  // namespace anonymous
@@ -178,8 +178,8 @@ class DefinedParser : public Lexer
             skipUntilEOD(mLexer, token);
             return;
         }
-        MacroSet::const_iterator iter = mMacroSet->find(token->text);
-        std::string expression = iter != mMacroSet->end() ? "1" : "0";
+        const Macro *macro = mMacroSet->find(token->text);
+        std::string expression = macro != NULL ? "1" : "0";
 
         if (paren)
         {
@@ -397,15 +397,15 @@ void DirectiveParser::parseDefine(Token *token)
     }
 
     // Check for macro redefinition.
-    MacroSet::const_iterator iter = mMacroSet->find(macro.name);
-    if (iter != mMacroSet->end() && !macro.equals(iter->second))
+    const Macro *existing = mMacroSet->find(macro.name);
+    if (existing != NULL && !macro.equals(*existing))
     {
         mDiagnostics->report(Diagnostics::PP_MACRO_REDEFINED,
                              token->location,
                              macro.name);
         return;
     }
-    mMacroSet->insert(std::make_pair(macro.name, macro));
+    mMacroSet->insert(macro);
 }
 
 void DirectiveParser::parseUndef(Token *token)
@@ -420,17 +420,17 @@ void DirectiveParser::parseUndef(Token *token)
         return;
     }
 
-    MacroSet::iterator iter = mMacroSet->find(token->text);
-    if (iter != mMacroSet->end())
+    const Macro *macro = mMacroSet->find(token->text);
+    if (macro != NULL)
     {
-        if (iter->second.predefined)
+        if (macro->predefined)
         {
             mDiagnostics->report(Diagnostics::PP_MACRO_PREDEFINED_UNDEFINED,
                                  token->location, token->text);
         }
         else
         {
-            mMacroSet->erase(iter);
+            mMacroSet->erase(token->text);
         }
     }
 
@@ -943,8 +943,8 @@ int DirectiveParser::parseExpressionIfdef(Token *token)
         return 0;
     }
 
-    MacroSet::const_iterator iter = mMacroSet->find(token->text);
-    int expression = iter != mMacroSet->end() ? 1 : 0;
+    const Macro *macro = mMacroSet->find(token->text);
+    int expression = macro != NULL ? 1 : 0;
 
     // Warn if there are tokens after #ifdef expression.
     mTokenizer->lex(token);
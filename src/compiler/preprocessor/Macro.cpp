@@ -19,5 +19,126 @@ bool Macro::equals(const Macro &other) const
            (replacements == other.replacements);
 }
 
+MacroSet::MacroSet()
+    : mMacroCount(0),
+      mUsedSlotCount(0),
+      mGeneration(0),
+      mExpansionCacheEnabled(true)
+{
+}
+
+MacroSet::~MacroSet()
+{
+    for (std::size_t i = 0; i < mSlots.size(); ++i)
+    {
+        delete mSlots[i].macro;
+    }
+}
+
+size_t MacroSet::Hash(const std::string &name)
+{
+    // FNV-1a
+    size_t hash = 2166136261u;
+    for (std::size_t i = 0; i < name.size(); ++i)
+    {
+        hash = (hash ^ static_cast<unsigned char>(name[i])) * 16777619u;
+    }
+    return hash;
+}
+
+size_t MacroSet::findSlot(const std::string &name, size_t hash) const
+{
+    if (mSlots.empty())
+        return 0;
+
+    const size_t mask = mSlots.size() - 1;
+    for (size_t i = hash & mask; ; i = (i + 1) & mask)
+    {
+        const Slot &slot = mSlots[i];
+        if (slot.macro == NULL && !slot.erased)
+            return mSlots.size();
+        if (slot.macro != NULL && slot.hash == hash && slot.macro->name == name)
+            return i;
+    }
+}
+
+const Macro *MacroSet::find(const std::string &name) const
+{
+    ++mStatistics.lookupCount;
+
+    size_t i = findSlot(name, Hash(name));
+    return i < mSlots.size() ? mSlots[i].macro : NULL;
+}
+
+bool MacroSet::insert(const Macro &macro)
+{
+    size_t hash = Hash(macro.name);
+    if (findSlot(macro.name, hash) < mSlots.size())
+        return false;
+
+    // Keep at least half of the slots empty, not counting tombstones.
+    if ((mUsedSlotCount + 1) * 2 > mSlots.size())
+    {
+        size_t slotCount = 16;
+        while (slotCount < (mMacroCount + 1) * 4)
+            slotCount *= 2;
+        rehash(slotCount);
+    }
+
+    const size_t mask = mSlots.size() - 1;
+    size_t i = hash & mask;
+    while (mSlots[i].macro != NULL)
+        i = (i + 1) & mask;
+
+    Slot &slot = mSlots[i];
+    if (!slot.erased)
+        ++mUsedSlotCount;
+    slot.hash = hash;
+    slot.macro = new Macro(macro);
+    slot.erased = false;
+
+    ++mMacroCount;
+    ++mGeneration;
+    return true;
+}
+
+void MacroSet::erase(const std::string &name)
+{
+    size_t i = findSlot(name, Hash(name));
+    if (i >= mSlots.size())
+        return;
+
+    Slot &slot = mSlots[i];
+    delete slot.macro;
+    slot.macro = NULL;
+    slot.erased = true;
+
+    --mMacroCount;
+    ++mGeneration;
+}
+
+void MacroSet::rehash(size_t slotCount)
+{
+    std::vector<Slot> slots;
+    slots.swap(mSlots);
+
+    Slot emptySlot = { 0, NULL, false };
+    mSlots.assign(slotCount, emptySlot);
+    mUsedSlotCount = 0;
+
+    const size_t mask = slotCount - 1;
+    for (std::size_t j = 0; j < slots.size(); ++j)
+    {
+        if (slots[j].macro == NULL)
+            continue;
+
+        size_t i = slots[j].hash & mask;
+        while (mSlots[i].macro != NULL)
+            i = (i + 1) & mask;
+        mSlots[i] = slots[j];
+        ++mUsedSlotCount;
+    }
+}
+
 }  // namespace pp
 
@@ -7,15 +7,16 @@
 #ifndef COMPILER_PREPROCESSOR_MACRO_H_
 #define COMPILER_PREPROCESSOR_MACRO_H_
 
-#include <map>
+#include <stddef.h>
 #include <string>
 #include <vector>
 
+#include "Token.h"
+#include "pp_utils.h"
+
 namespace pp
 {
 
-struct Token;
-
 struct Macro
 {
     enum Type
@@ -26,10 +27,19 @@ struct Macro
     typedef std::vector<std::string> Parameters;
     typedef std::vector<Token> Replacements;
 
+    enum ExpansionState
+    {
+        kExpansionUnknown,
+        kExpansionCached,
+        kExpansionNotCached
+    };
+
     Macro()
         : predefined(false),
           disabled(false),
-          type(kTypeObj)
+          type(kTypeObj),
+          expansionState(kExpansionUnknown),
+          expansionGeneration(0)
     {
     }
     bool equals(const Macro &other) const;
@@ -41,9 +51,85 @@ struct Macro
     std::string name;
     Parameters parameters;
     Replacements replacements;
+
+    // The full expansion of an object-like macro, computed by the
+    // MacroExpander the first time the macro is expanded and kept until
+    // the generation of the macro set changes. expansionMacros lists the
+    // macros expanded to produce it, which must all be enabled for the
+    // expansion to be reused.
+    mutable ExpansionState expansionState;
+    mutable unsigned int expansionGeneration;
+    mutable Replacements expansion;
+    mutable std::vector<const Macro *> expansionMacros;
+};
+
+struct MacroStatistics
+{
+    MacroStatistics()
+        : lookupCount(0),
+          expansionCount(0),
+          cacheHitCount(0),
+          cacheMissCount(0)
+    {
+    }
+
+    // Identifiers looked up in the macro set.
+    size_t lookupCount;
+    // Macro expansions, including those read from the expansion cache.
+    size_t expansionCount;
+    // Expansions of object-like macros read from the cache, and those
+    // expanded in full to fill it.
+    size_t cacheHitCount;
+    size_t cacheMissCount;
 };
 
-typedef std::map<std::string, Macro> MacroSet;
+// The defined macros, hashed by name. A macro keeps its address until it is
+// undefined, so expansions in progress can refer to it.
+class MacroSet
+{
+  public:
+    MacroSet();
+    ~MacroSet();
+
+    // Returns NULL if no macro with the name is defined.
+    const Macro *find(const std::string &name) const;
+    // Adds the macro unless one with the same name is already defined.
+    // Returns false if it was not added.
+    bool insert(const Macro &macro);
+    void erase(const std::string &name);
+
+    // Changes whenever a macro is defined or undefined, which invalidates
+    // the cached expansions.
+    unsigned int generation() const { return mGeneration; }
+
+    bool expansionCacheEnabled() const { return mExpansionCacheEnabled; }
+    void setExpansionCacheEnabled(bool enable) { mExpansionCacheEnabled = enable; }
+
+    MacroStatistics &statistics() const { return mStatistics; }
+
+  private:
+    PP_DISALLOW_COPY_AND_ASSIGN(MacroSet);
+
+    struct Slot
+    {
+        size_t hash;
+        Macro *macro;
+        bool erased;
+    };
+
+    static size_t Hash(const std::string &name);
+    size_t findSlot(const std::string &name, size_t hash) const;
+    void rehash(size_t slotCount);
+
+    // Open addressing with linear probing. Erased macros leave a tombstone
+    // so that the probe sequences through them stay intact.
+    std::vector<Slot> mSlots;
+    size_t mMacroCount;
+    size_t mUsedSlotCount;
+    unsigned int mGeneration;
+    bool mExpansionCacheEnabled;
+    mutable MacroStatistics mStatistics;
+};
 
 }  // namespace pp
 #endif  // COMPILER_PREPROCESSOR_MACRO_H_
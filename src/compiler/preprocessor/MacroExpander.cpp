@@ -20,38 +20,86 @@ class TokenLexer : public Lexer
  public:
     typedef std::vector<Token> TokenVector;
 
-    TokenLexer(TokenVector *tokens)
+    TokenLexer()
+        : mTokens(0),
+          mIndex(0)
     {
-        tokens->swap(mTokens);
-        mIter = mTokens.begin();
+    }
+
+    // Reads the given tokens, which must outlive the lexing.
+    void reset(const TokenVector *tokens)
+    {
+        mTokens = tokens;
+        mIndex = 0;
     }
 
     virtual void lex(Token *token)
     {
-        if (mIter == mTokens.end())
+        if (mIndex == mTokens->size())
         {
             token->reset();
             token->type = Token::LAST;
         }
         else
         {
-            *token = *mIter++;
+            *token = (*mTokens)[mIndex++];
         }
     }
 
  private:
     PP_DISALLOW_COPY_AND_ASSIGN(TokenLexer);
 
-    TokenVector mTokens;
-    TokenVector::const_iterator mIter;
+    const TokenVector *mTokens;
+    std::size_t mIndex;
 };
 
+namespace
+{
+
+// Starts the next macro argument, reusing the storage of an argument
+// collected for an earlier invocation when there is one.
+std::vector<Token> &BeginMacroArg(std::vector<std::vector<Token> > *args,
+                                  std::size_t *argCount)
+{
+    if (*argCount == args->size())
+    {
+        args->push_back(std::vector<Token>());
+    }
+    std::vector<Token> &arg = args->at((*argCount)++);
+    arg.clear();
+    return arg;
+}
+
+// Remembers that a diagnostic was reported instead of printing it.
+class SilentDiagnostics : public Diagnostics
+{
+  public:
+    SilentDiagnostics()
+        : reported(false)
+    {
+    }
+
+    bool reported;
+
+  protected:
+    virtual void print(ID id, const SourceLocation &loc, const std::string &text)
+    {
+        reported = true;
+    }
+};
+
+}  // namespace anonymous
+
 MacroExpander::MacroExpander(Lexer *lexer,
                              MacroSet *macroSet,
                              Diagnostics *diagnostics)
     : mLexer(lexer),
       mMacroSet(macroSet),
-      mDiagnostics(diagnostics)
+      mDiagnostics(diagnostics),
+      mHasReserveToken(false),
+      mArgLexer(0),
+      mArgExpander(0),
+      mExpansionRecord(0)
 {
 }
 
@@ -61,6 +109,12 @@ MacroExpander::~MacroExpander()
     {
         delete mContextStack[i];
     }
+    for (std::size_t i = 0; i < mFreeContexts.size(); ++i)
+    {
+        delete mFreeContexts[i];
+    }
+    delete mArgExpander;
+    delete mArgLexer;
 }
 
 void MacroExpander::lex(Token *token)
@@ -75,34 +129,34 @@ void MacroExpander::lex(Token *token)
         if (token->expansionDisabled())
             break;
 
-        MacroSet::const_iterator iter = mMacroSet->find(token->text);
-        if (iter == mMacroSet->end())
+        const Macro *macro = mMacroSet->find(token->text);
+        if (macro == NULL)
             break;
 
-        const Macro& macro = iter->second;
-        if (macro.disabled)
+        if (macro->disabled)
         {
             // If a particular token is not expanded, it is never expanded.
             token->setExpansionDisabled(true);
             break;
         }
-        if ((macro.type == Macro::kTypeFunc) && !isNextTokenLeftParen())
+        if ((macro->type == Macro::kTypeFunc) && !isNextTokenLeftParen())
         {
             // If the token immediately after the macro name is not a '(',
             // this macro should not be expanded.
             break;
         }
 
-        pushMacro(macro, *token);
+        if (!pushCachedExpansion(*macro, *token))
+            pushMacro(*macro, *token);
     }
 }
 
 void MacroExpander::getToken(Token *token)
 {
-    if (mReserveToken.get())
+    if (mHasReserveToken)
     {
-        *token = *mReserveToken;
-        mReserveToken.reset();
+        *token = mReserveToken;
+        mHasReserveToken = false;
         return;
     }
 
@@ -114,7 +168,7 @@ void MacroExpander::getToken(Token *token)
 
     if (!mContextStack.empty())
     {
-        *token = mContextStack.back()->get();
+        mContextStack.back()->get(token);
     }
     else
     {
@@ -128,12 +182,14 @@ void MacroExpander::ungetToken(const Token &token)
     {
         MacroContext *context = mContextStack.back();
         context->unget();
-        assert(context->replacements[context->index] == token);
+        assert(context->peek().type == token.type);
+        assert(context->peek().text == token.text);
     }
     else
     {
-        assert(!mReserveToken.get());
-        mReserveToken.reset(new Token(token));
+        assert(!mHasReserveToken);
+        mReserveToken = token;
+        mHasReserveToken = true;
     }
 }
 
@@ -155,20 +211,141 @@ bool MacroExpander::pushMacro(const Macro &macro, const Token &identifier)
     assert(identifier.type == Token::IDENTIFIER);
     assert(identifier.text == macro.name);
 
-    std::vector<Token> replacements;
-    if (!expandMacro(macro, identifier, &replacements))
+    MacroContext *context = allocateContext();
+    if (!expandMacro(macro, identifier, context))
+    {
+        mFreeContexts.push_back(context);
         return false;
+    }
 
     // Macro is disabled for expansion until it is popped off the stack.
     macro.disabled = true;
 
-    MacroContext *context = new MacroContext;
     context->macro = &macro;
-    context->replacements.swap(replacements);
+    context->index = 0;
     mContextStack.push_back(context);
+
+    ++mMacroSet->statistics().expansionCount;
+    if (mExpansionRecord)
+        mExpansionRecord->push_back(&macro);
     return true;
 }
 
+MacroExpander::MacroContext *MacroExpander::allocateContext()
+{
+    if (mFreeContexts.empty())
+        return new MacroContext;
+
+    MacroContext *context = mFreeContexts.back();
+    mFreeContexts.pop_back();
+    return context;
+}
+
+bool MacroExpander::pushCachedExpansion(const Macro &macro,
+                                        const Token &identifier)
+{
+    if (!mMacroSet->expansionCacheEnabled() ||
+        (macro.type != Macro::kTypeObj) || macro.predefined)
+    {
+        return false;
+    }
+
+    MacroStatistics &statistics = mMacroSet->statistics();
+    if ((macro.expansionState == Macro::kExpansionUnknown) ||
+        (macro.expansionGeneration != mMacroSet->generation()))
+    {
+        cacheExpansion(macro, identifier);
+        if (macro.expansionState == Macro::kExpansionCached)
+            ++statistics.cacheMissCount;
+    }
+    else if (macro.expansionState == Macro::kExpansionCached)
+    {
+        ++statistics.cacheHitCount;
+    }
+
+    if (macro.expansionState != Macro::kExpansionCached)
+        return false;
+
+    // The cached tokens are what expanding the macro here gives as long as
+    // every macro expanded to produce them is enabled here too.
+    const std::vector<const Macro *> &expansionMacros = macro.expansionMacros;
+    for (std::size_t i = 0; i < expansionMacros.size(); ++i)
+    {
+        if (expansionMacros[i]->disabled)
+            return false;
+    }
+
+    macro.disabled = true;
+
+    MacroContext *context = allocateContext();
+    context->macro = &macro;
+    context->index = 0;
+    context->replacements = &macro.expansion;
+    context->location = identifier.location;
+    context->atStartOfLine = identifier.atStartOfLine();
+    context->hasLeadingSpace = identifier.hasLeadingSpace();
+    mContextStack.push_back(context);
+
+    ++statistics.expansionCount;
+    if (mExpansionRecord)
+    {
+        mExpansionRecord->insert(mExpansionRecord->end(),
+                                 expansionMacros.begin(),
+                                 expansionMacros.end());
+    }
+    return true;
+}
+
+void MacroExpander::cacheExpansion(const Macro &macro, const Token &identifier)
+{
+    macro.expansionState = Macro::kExpansionNotCached;
+    macro.expansionGeneration = mMacroSet->generation();
+    macro.expansion.clear();
+    macro.expansionMacros.clear();
+
+    // A replacement list that names no macro is read in place already.
+    if (!namesMacro(macro.replacements))
+        return;
+
+    // Expand the macro on its own, with its surroundings replaced by the
+    // end of input. Any diagnostic means the expansion would read past the
+    // replacement list, and that has to happen in place.
+    SilentDiagnostics diagnostics;
+
+    std::vector<Token> input(1, identifier);
+    TokenLexer lexer;
+    lexer.reset(&input);
+    MacroExpander expander(&lexer, mMacroSet, &diagnostics);
+    expander.mExpansionRecord = &macro.expansionMacros;
+
+    Token token;
+    expander.lex(&token);
+    while (token.type != Token::LAST)
+    {
+        macro.expansion.push_back(token);
+        expander.lex(&token);
+    }
+
+    // A macro name left in the expansion was either disabled, or is
+    // function-like and may take its arguments from what follows; both
+    // depend on where the macro is expanded. So do __LINE__ and __FILE__.
+    bool cacheable = !diagnostics.reported && !namesMacro(macro.expansion);
+    for (std::size_t i = 0; cacheable && i < macro.expansionMacros.size(); ++i)
+    {
+        cacheable = !macro.expansionMacros[i]->predefined;
+    }
+
+    if (cacheable)
+    {
+        macro.expansionState = Macro::kExpansionCached;
+    }
+    else
+    {
+        macro.expansion.clear();
+        macro.expansionMacros.clear();
+    }
+}
+
 void MacroExpander::popMacro()
 {
     assert(!mContextStack.empty());
@@ -179,75 +356,73 @@ void MacroExpander::popMacro()
     assert(context->empty());
     assert(context->macro->disabled);
     context->macro->disabled = false;
-    delete context;
+    mFreeContexts.push_back(context);
 }
 
 bool MacroExpander::expandMacro(const Macro &macro,
                                 const Token &identifier,
-                                std::vector<Token> *replacements)
+                                MacroContext *context)
 {
-    replacements->clear();
+    std::vector<Token> &substituted = context->substituted;
+    substituted.clear();
+    context->replacements = &substituted;
+
     if (macro.type == Macro::kTypeObj)
     {
-        replacements->assign(macro.replacements.begin(),
-                             macro.replacements.end());
+        context->replacements = &macro.replacements;
 
         if (macro.predefined)
         {
             const char kLine[] = "__LINE__";
             const char kFile[] = "__FILE__";
 
-            assert(replacements->size() == 1);
-            Token& repl = replacements->front();
+            assert(macro.replacements.size() == 1);
             if (macro.name == kLine)
             {
                 std::ostringstream stream;
                 stream << identifier.location.line;
-                repl.text = stream.str();
+                substituted.push_back(macro.replacements.front());
+                substituted.front().text = stream.str();
+                context->replacements = &substituted;
             }
             else if (macro.name == kFile)
             {
                 std::ostringstream stream;
                 stream << identifier.location.file;
-                repl.text = stream.str();
+                substituted.push_back(macro.replacements.front());
+                substituted.front().text = stream.str();
+                context->replacements = &substituted;
             }
         }
     }
     else
     {
         assert(macro.type == Macro::kTypeFunc);
-        std::vector<MacroArg> args;
-        args.reserve(macro.parameters.size());
-        if (!collectMacroArgs(macro, identifier, &args))
+        std::size_t argCount = 0;
+        if (!collectMacroArgs(macro, identifier, &mArgs, &argCount))
             return false;
 
-        replaceMacroParams(macro, args, replacements);
+        replaceMacroParams(macro, mArgs, &substituted);
     }
 
-    for (std::size_t i = 0; i < replacements->size(); ++i)
-    {
-        Token& repl = replacements->at(i);
-        if (i == 0)
-        {
-            // The first token in the replacement list inherits the padding
-            // properties of the identifier token.
-            repl.setAtStartOfLine(identifier.atStartOfLine());
-            repl.setHasLeadingSpace(identifier.hasLeadingSpace());
-        }
-        repl.location = identifier.location;
-    }
+    context->location = identifier.location;
+    context->atStartOfLine = identifier.atStartOfLine();
+    context->hasLeadingSpace = identifier.hasLeadingSpace();
     return true;
 }
 
 bool MacroExpander::collectMacroArgs(const Macro &macro,
                                      const Token &identifier,
-                                     std::vector<MacroArg> *args)
+                                     std::vector<MacroArg> *args,
+                                     std::size_t *argCount)
 {
     Token token;
     getToken(&token);
     assert(token.type == '(');
 
-    args->push_back(MacroArg());
+    // Arguments past argCount are left over from earlier invocations.
+    *argCount = 0;
+    BeginMacroArg(args, argCount);
     for (int openParens = 1; openParens != 0; )
     {
         getToken(&token);
@@ -277,7 +452,7 @@ bool MacroExpander::collectMacroArgs(const Macro &macro,
             // the comma tokens between matching inner parentheses do not
             // seperate arguments.
             if (openParens == 1)
-                args->push_back(MacroArg());
+                BeginMacroArg(args, argCount);
             isArg = openParens != 1;
             break;
           default:
@@ -286,7 +461,7 @@ bool MacroExpander::collectMacroArgs(const Macro &macro,
         }
         if (isArg)
         {
-            MacroArg &arg = args->back();
+            MacroArg &arg = args->at(*argCount - 1);
             // Initial whitespace is not part of the argument.
             if (arg.empty())
                 token.setHasLeadingSpace(false);
@@ -296,14 +471,14 @@ bool MacroExpander::collectMacroArgs(const Macro &macro,
 
     const Macro::Parameters &params = macro.parameters;
     // If there is only one empty argument, it is equivalent to no argument.
-    if (params.empty() && (args->size() == 1) && args->front().empty())
+    if (params.empty() && (*argCount == 1) && args->front().empty())
     {
-        args->clear();
+        *argCount = 0;
     }
     // Validate the number of arguments.
-    if (args->size() != params.size())
+    if (*argCount != params.size())
     {
-        Diagnostics::ID id = args->size() < macro.parameters.size() ?
+        Diagnostics::ID id = *argCount < macro.parameters.size() ?
             Diagnostics::PP_MACRO_TOO_FEW_ARGS :
             Diagnostics::PP_MACRO_TOO_MANY_ARGS;
         mDiagnostics->report(id, identifier.location, identifier.text);
@@ -313,27 +488,61 @@ bool MacroExpander::collectMacroArgs(const Macro &macro,
     // Pre-expand each argument before substitution.
     // This step expands each argument individually before they are
     // inserted into the macro body.
-    for (std::size_t i = 0; i < args->size(); ++i)
+    for (std::size_t i = 0; i < *argCount; ++i)
     {
         MacroArg &arg = args->at(i);
-        TokenLexer lexer(&arg);
-        MacroExpander expander(&lexer, mMacroSet, mDiagnostics);
+        if (namesMacro(arg))
+            expandMacroArg(&arg);
+    }
+    return true;
+}
 
-        arg.clear();
-        expander.lex(&token);
-        while (token.type != Token::LAST)
+bool MacroExpander::namesMacro(const std::vector<Token> &tokens) const
+{
+    // Tokens that name no macro expand to themselves.
+    for (std::size_t i = 0; i < tokens.size(); ++i)
+    {
+        const Token &token = tokens[i];
+        if ((token.type == Token::IDENTIFIER) &&
+            (mMacroSet->find(token.text) != NULL))
         {
-            arg.push_back(token);
-            expander.lex(&token);
+            return true;
         }
     }
-    return true;
+    return false;
+}
+
+void MacroExpander::expandMacroArg(MacroArg *arg)
+{
+    // The expander for arguments is kept for the next one. It has always
+    // read up to the end of its previous argument, so it holds no state.
+    if (!mArgExpander)
+    {
+        mArgLexer = new TokenLexer;
+        mArgExpander = new MacroExpander(mArgLexer, mMacroSet, mDiagnostics);
+    }
+    mArgExpander->mExpansionRecord = mExpansionRecord;
+    assert(mArgExpander->mContextStack.empty());
+    assert(!mArgExpander->mHasReserveToken);
+
+    mArgLexer->reset(arg);
+    mExpandedArg.clear();
+
+    Token token;
+    mArgExpander->lex(&token);
+    while (token.type != Token::LAST)
+    {
+        mExpandedArg.push_back(token);
+        mArgExpander->lex(&token);
+    }
+    arg->swap(mExpandedArg);
 }
 
 void MacroExpander::replaceMacroParams(const Macro &macro,
                                        const std::vector<MacroArg> &args,
                                        std::vector<Token> *replacements)
 {
+    replacements->reserve(macro.replacements.size());
     for (std::size_t i = 0; i < macro.replacements.size(); ++i)
     {
         const Token &repl = macro.replacements[i];
@@ -8,17 +8,18 @@
 #define COMPILER_PREPROCESSOR_MACRO_EXPANDER_H_
 
 #include <cassert>
-#include <memory>
 #include <vector>
 
 #include "Lexer.h"
 #include "Macro.h"
+#include "Token.h"
 #include "pp_utils.h"
 
 namespace pp
 {
 
 class Diagnostics;
+class TokenLexer;
 
 class MacroExpander : public Lexer
 {
@@ -35,53 +36,100 @@ class MacroExpander : public Lexer
     void ungetToken(const Token &token);
     bool isNextTokenLeftParen();
 
+    struct MacroContext;
+
+    MacroContext *allocateContext();
     bool pushMacro(const Macro &macro, const Token &identifier);
+    bool pushCachedExpansion(const Macro &macro, const Token &identifier);
+    void cacheExpansion(const Macro &macro, const Token &identifier);
     void popMacro();
 
     bool expandMacro(const Macro &macro,
                      const Token &identifier,
-                     std::vector<Token> *replacements);
+                     MacroContext *context);
 
     typedef std::vector<Token> MacroArg;
     bool collectMacroArgs(const Macro &macro,
                           const Token &identifier,
-                          std::vector<MacroArg> *args);
+                          std::vector<MacroArg> *args,
+                          std::size_t *argCount);
+    bool namesMacro(const std::vector<Token> &tokens) const;
+    void expandMacroArg(MacroArg *arg);
     void replaceMacroParams(const Macro &macro,
                             const std::vector<MacroArg> &args,
                             std::vector<Token> *replacements);
 
+    // A macro being expanded. Object-like macros are read straight from
+    // their replacement list, others from the substituted list built when
+    // the macro was pushed. The identifier's location and padding are
+    // applied as the tokens are read, so neither list is copied or patched.
     struct MacroContext
     {
         const Macro *macro;
         std::size_t index;
-        std::vector<Token> replacements;
+        const std::vector<Token> *replacements;
+        std::vector<Token> substituted;
+        SourceLocation location;
+        bool atStartOfLine;
+        bool hasLeadingSpace;
 
         MacroContext()
             : macro(0),
-              index(0)
+              index(0),
+              replacements(0),
+              atStartOfLine(false),
+              hasLeadingSpace(false)
         {
         }
         bool empty() const
         {
-            return index == replacements.size();
+            return index == replacements->size();
         }
-        const Token &get()
+        void get(Token *token)
         {
-            return replacements[index++];
+            *token = (*replacements)[index];
+            if (index == 0)
+            {
+                // The first token in the replacement list inherits the
+                // padding properties of the identifier token.
+                token->setAtStartOfLine(atStartOfLine);
+                token->setHasLeadingSpace(hasLeadingSpace);
+            }
+            token->location = location;
+            ++index;
         }
         void unget()
         {
             assert(index > 0);
             --index;
         }
+        const Token &peek() const
+        {
+            return (*replacements)[index];
+        }
     };
 
     Lexer *mLexer;
     MacroSet *mMacroSet;
     Diagnostics *mDiagnostics;
 
-    std::auto_ptr<Token> mReserveToken;
+    Token mReserveToken;
+    bool mHasReserveToken;
     std::vector<MacroContext *> mContextStack;
+
+    // Storage reused from one expansion to the next, so that once the
+    // buffers have grown to fit, expanding macros does not allocate for
+    // short spellings. Tokens copied into arguments and substitutions still
+    // allocate for spellings too long for the inline buffer of std::string,
+    // and may allocate for any spelling where std::string is copy-on-write.
+    std::vector<MacroContext *> mFreeContexts;
+    std::vector<MacroArg> mArgs;
+    MacroArg mExpandedArg;
+    TokenLexer *mArgLexer;
+    MacroExpander *mArgExpander;
+
+    // While an expansion is being cached, receives every macro expanded.
+    std::vector<const Macro *> *mExpansionRecord;
 };
 
 }  // namespace pp
@@ -78,7 +78,8 @@ void Preprocessor::predefineMacro(const char *name, int value)
     macro.name = name;
     macro.replacements.push_back(token);
 
-    mImpl->macroSet[name] = macro;
+    mImpl->macroSet.erase(name);
+    mImpl->macroSet.insert(macro);
 }
 
 void Preprocessor::lex(Token *token)
@@ -115,4 +116,14 @@ void Preprocessor::setMaxTokenSize(size_t maxTokenSize)
     mImpl->tokenizer.setMaxTokenSize(maxTokenSize);
 }
 
+void Preprocessor::setMacroExpansionCacheEnabled(bool enable)
+{
+    mImpl->macroSet.setExpansionCacheEnabled(enable);
+}
+
+const MacroStatistics &Preprocessor::getMacroStatistics() const
+{
+    return mImpl->macroSet.statistics();
+}
+
 }  // namespace pp
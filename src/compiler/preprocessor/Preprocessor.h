@@ -16,6 +16,7 @@ namespace pp
 
 class Diagnostics;
 class DirectiveHandler;
+struct MacroStatistics;
 struct PreprocessorImpl;
 struct Token;
 
@@ -43,6 +44,11 @@ class Preprocessor
     // Set maximum preprocessor token size
     void setMaxTokenSize(size_t maxTokenSize);
 
+    // Reuse the full expansion of object-like macros while no macro is
+    // defined or undefined. Enabled by default.
+    void setMacroExpansionCacheEnabled(bool enable);
+    const MacroStatistics &getMacroStatistics() const;
+
   private:
     PP_DISALLOW_COPY_AND_ASSIGN(Preprocessor);
 
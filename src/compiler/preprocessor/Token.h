@@ -100,6 +100,9 @@ struct Token
     int type;
     unsigned int flags;
     SourceLocation location;
+    // Assigning to a reused token keeps the capacity of its spelling, but
+    // copying a token allocates unless the spelling fits the inline buffer
+    // of std::string, 15 characters in common implementations.
     std::string text;
 };
 
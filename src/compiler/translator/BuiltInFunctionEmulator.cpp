@@ -382,13 +382,9 @@ BuiltInFunctionEmulator::IdentifyFunction(
     return static_cast<TBuiltInFunction>(function);
 }
 
-void BuiltInFunctionEmulator::MarkBuiltInFunctionsForEmulation(
-    TIntermNode* root)
+TIntermTraverser* BuiltInFunctionEmulator::CreateEmulationMarker()
 {
-    ASSERT(root);
-
-    BuiltInFunctionEmulationMarker marker(*this);
-    root->traverse(&marker);
+    return new BuiltInFunctionEmulationMarker(*this);
 }
 
 void BuiltInFunctionEmulator::Cleanup()
@@ -31,7 +31,9 @@ public:
     // shader source.
     void OutputEmulatedFunctionDefinition(TInfoSinkBase& out, bool withPrecision) const;
 
-    void MarkBuiltInFunctionsForEmulation(TIntermNode* root);
+    // Returns a traverser that marks the built-in function calls that need to
+    // be emulated. It is allocated from the current pool.
+    TIntermTraverser* CreateEmulationMarker();
 
     void Cleanup();
 
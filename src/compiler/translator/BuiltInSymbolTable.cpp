@@ -0,0 +1,138 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// BuiltInSymbolTable.cpp: Builds and caches the shared built-in levels of the symbol table.
+
+#include "compiler/translator/BuiltInSymbolTable.h"
+
+#include "compiler/translator/Initialize.h"
+#include "angle_gl.h"
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+namespace
+{
+
+typedef std::map<std::string, std::shared_ptr<const TBuiltInSymbolTable> > BuiltInSymbolTableMap;
+
+std::mutex builtInTablesMutex;
+BuiltInSymbolTableMap builtInTables;
+TBuiltInSymbolTableStatistics builtInTableStatistics = {};
+
+}
+
+TBuiltInSymbolTable::TBuiltInSymbolTable(sh::GLenum type, ShShaderSpec spec,
+                                         const ShBuiltInResources &resources)
+{
+    mAllocator.push();
+
+    TPoolAllocator *previousAllocator = GetGlobalPoolAllocator();
+    SetGlobalPoolAllocator(&mAllocator);
+
+    mSymbolTable.push();   // COMMON_BUILTINS
+    mSymbolTable.push();   // ESSL1_BUILTINS
+    mSymbolTable.push();   // ESSL3_BUILTINS
+
+    TPublicType integer;
+    integer.type = EbtInt;
+    integer.primarySize = 1;
+    integer.secondarySize = 1;
+    integer.array = false;
+
+    TPublicType floatingPoint;
+    floatingPoint.type = EbtFloat;
+    floatingPoint.primarySize = 1;
+    floatingPoint.secondarySize = 1;
+    floatingPoint.array = false;
+
+    TPublicType sampler;
+    sampler.primarySize = 1;
+    sampler.secondarySize = 1;
+    sampler.array = false;
+
+    switch(type)
+    {
+      case GL_FRAGMENT_SHADER:
+        mSymbolTable.setDefaultPrecision(integer, EbpMedium);
+        break;
+      case GL_VERTEX_SHADER:
+        mSymbolTable.setDefaultPrecision(integer, EbpHigh);
+        mSymbolTable.setDefaultPrecision(floatingPoint, EbpHigh);
+        break;
+      default:
+        assert(false && "Language not supported");
+    }
+    // We set defaults for all the sampler types, even those that are
+    // only available if an extension exists.
+    for (int samplerType = EbtGuardSamplerBegin + 1;
+         samplerType < EbtGuardSamplerEnd; ++samplerType)
+    {
+        sampler.type = static_cast<TBasicType>(samplerType);
+        mSymbolTable.setDefaultPrecision(sampler, EbpLow);
+    }
+
+    InsertBuiltInFunctions(type, spec, resources, mSymbolTable);
+
+    IdentifyBuiltIns(type, spec, resources, mSymbolTable);
+
+    // Compilers only ever read the shared levels from now on
+    mSymbolTable.precomputeTypeData();
+
+    SetGlobalPoolAllocator(previousAllocator);
+}
+
+TBuiltInSymbolTable::~TBuiltInSymbolTable()
+{
+    while (!mSymbolTable.isEmpty())
+        mSymbolTable.pop();
+
+    mAllocator.popAll();
+}
+
+std::shared_ptr<const TBuiltInSymbolTable> TBuiltInSymbolTable::Get(sh::GLenum type, ShShaderSpec spec,
+                                                                  const ShBuiltInResources &resources,
+                                                                  const std::string &resourcesString)
+{
+    std::ostringstream keyStream;
+    keyStream << type << ":" << spec << resourcesString;
+    std::string key = keyStream.str();
+
+    std::lock_guard<std::mutex> lock(builtInTablesMutex);
+
+    BuiltInSymbolTableMap::const_iterator it = builtInTables.find(key);
+    if (it != builtInTables.end())
+    {
+        builtInTableStatistics.reuseCount++;
+        builtInTableStatistics.savedPoolBytes += it->second->mAllocator.getTotalBytes();
+        return it->second;
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::shared_ptr<const TBuiltInSymbolTable> table(new TBuiltInSymbolTable(type, spec, resources));
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    builtInTableStatistics.buildCount++;
+    builtInTableStatistics.buildSeconds += elapsed.count();
+    builtInTableStatistics.poolBytes += table->mAllocator.getTotalBytes();
+
+    builtInTables[key] = table;
+    return table;
+}
+
+void TBuiltInSymbolTable::ReleaseAll()
+{
+    std::lock_guard<std::mutex> lock(builtInTablesMutex);
+    builtInTables.clear();
+}
+
+void TBuiltInSymbolTable::GetStatistics(TBuiltInSymbolTableStatistics *statisticsOut)
+{
+    std::lock_guard<std::mutex> lock(builtInTablesMutex);
+    *statisticsOut = builtInTableStatistics;
+}
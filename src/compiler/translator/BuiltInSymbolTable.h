@@ -0,0 +1,63 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// BuiltInSymbolTable.h: The built-in levels of the symbol table, built once for each shader
+// type, spec and set of resources, and shared read-only by every compiler created with
+// them. The levels live in their own pool, which stays alive as long as a compiler or the
+// process-wide cache refers to them.
+
+#ifndef COMPILER_TRANSLATOR_BUILTINSYMBOLTABLE_H_
+#define COMPILER_TRANSLATOR_BUILTINSYMBOLTABLE_H_
+
+#include "compiler/translator/PoolAlloc.h"
+#include "compiler/translator/SymbolTable.h"
+
+#include <memory>
+#include <string>
+
+struct TBuiltInSymbolTableStatistics
+{
+    // Number of distinct tables built, and of compilers that reused one
+    size_t buildCount;
+    size_t reuseCount;
+
+    // Time spent building tables, and the pool memory they use
+    double buildSeconds;
+    size_t poolBytes;
+
+    // Pool memory that compilers reusing a table did not have to allocate
+    size_t savedPoolBytes;
+};
+
+class TBuiltInSymbolTable
+{
+  public:
+    ~TBuiltInSymbolTable();
+
+    // Returns the table for the given configuration, building it on first use. Safe to
+    // call from several threads.
+    static std::shared_ptr<const TBuiltInSymbolTable> Get(sh::GLenum type, ShShaderSpec spec,
+                                                         const ShBuiltInResources &resources,
+                                                         const std::string &resourcesString);
+
+    // Drops the cached tables. Tables still used by compilers are freed with them.
+    static void ReleaseAll();
+
+    static void GetStatistics(TBuiltInSymbolTableStatistics *statisticsOut);
+
+    const TSymbolTable &getSymbolTable() const { return mSymbolTable; }
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(TBuiltInSymbolTable);
+
+    TBuiltInSymbolTable(sh::GLenum type, ShShaderSpec spec, const ShBuiltInResources &resources);
+
+    // Declared first so it outlives the symbols allocated from it
+    TPoolAllocator mAllocator;
+    TSymbolTable mSymbolTable;
+};
+
+#endif // COMPILER_TRANSLATOR_BUILTINSYMBOLTABLE_H_
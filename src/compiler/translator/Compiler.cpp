@@ -4,17 +4,22 @@
 // found in the LICENSE file.
 //
 
+#include "compiler/preprocessor/Macro.h"
 #include "compiler/translator/BuiltInFunctionEmulator.h"
+#include "compiler/translator/BuiltInSymbolTable.h"
 #include "compiler/translator/Compiler.h"
 #include "compiler/translator/DetectCallDepth.h"
 #include "compiler/translator/ForLoopUnroll.h"
 #include "compiler/translator/Initialize.h"
 #include "compiler/translator/InitializeParseContext.h"
 #include "compiler/translator/InitializeVariables.h"
+#include "compiler/translator/OptimizeTree.h"
 #include "compiler/translator/ParseContext.h"
+#include "compiler/translator/PassManager.h"
 #include "compiler/translator/RegenerateStructNames.h"
 #include "compiler/translator/RenameFunction.h"
 #include "compiler/translator/ScalarizeVecAndMatConstructorArgs.h"
+#include "compiler/translator/TranslationCache.h"
 #include "compiler/translator/UnfoldShortCircuitAST.h"
 #include "compiler/translator/ValidateLimitations.h"
 #include "compiler/translator/ValidateOutputs.h"
@@ -27,6 +32,8 @@
 #include "angle_gl.h"
 #include "common/utilities.h"
 
+#include <chrono>
+
 bool IsWebGLBasedSpec(ShShaderSpec spec)
 {
     return (spec == SH_WEBGL_SPEC ||
@@ -68,6 +75,51 @@ class TScopedPoolAllocator
     TPoolAllocator* mAllocator;
 };
 
+// Adds the wall-clock time since the previous phase ended to the phase that
+// just ended, and the time of the whole compile to the total.
+class TCompilePhaseTimer
+{
+  public:
+    TCompilePhaseTimer(ShCompileStatistics *statistics)
+        : mStatistics(statistics),
+          mCompileStart(Clock::now()),
+          mPhaseStart(mCompileStart)
+    {
+    }
+    ~TCompilePhaseTimer()
+    {
+        mStatistics->totalMicroseconds = Microseconds(Clock::now() - mCompileStart);
+    }
+
+    void endPhase(ShCompilePhase phase)
+    {
+        Clock::time_point now = Clock::now();
+        mStatistics->phaseMicroseconds[phase] += Microseconds(now - mPhaseStart);
+        mPhaseStart = now;
+    }
+
+    // Splits the time since the previous phase ended between the phases of
+    // the passes that shared the walks of |passes|.
+    void endPasses(const TPassManager &passes)
+    {
+        Clock::time_point now = Clock::now();
+        passes.chargePhases(Microseconds(now - mPhaseStart), mStatistics->phaseMicroseconds);
+        mPhaseStart = now;
+    }
+
+  private:
+    typedef std::chrono::steady_clock Clock;
+
+    static double Microseconds(Clock::duration duration)
+    {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    }
+
+    ShCompileStatistics *mStatistics;
+    Clock::time_point mCompileStart;
+    Clock::time_point mPhaseStart;
+};
+
 class TScopedSymbolTableLevel
 {
   public:
@@ -169,6 +221,13 @@ bool TCompiler::compile(const char* const shaderStrings[],
     if (numStrings == 0)
         return true;
 
+    TCompilePhaseTimer phaseTimer(&mStatistics);
+    size_t poolAllocationCount = allocator.getAllocationCount();
+    size_t poolAllocatedBytes = allocator.getTotalBytes();
+    size_t poolInUseBytes = allocator.getInUseBytes();
+    size_t poolPageCount = allocator.getPageCount();
+    size_t poolReusedPageCount = allocator.getReusedPageCount();
+
     // If compiling for WebGL, validate loop and indexing as well.
     if (IsWebGLBasedSpec(shaderSpec))
         compileOptions |= SH_VALIDATE_LOOP_INDEXING;
@@ -192,11 +251,13 @@ bool TCompiler::compile(const char* const shaderStrings[],
     // We preserve symbols at the built-in level from compile-to-compile.
     // Start pushing the user-defined symbols at global level.
     TScopedSymbolTableLevel scopedSymbolLevel(&symbolTable);
+    symbolTable.resetLookupCounts();
 
     // Parse shader.
     bool success =
         (PaParseStrings(numStrings - firstSource, &shaderStrings[firstSource], NULL, &parseContext) == 0) &&
         (parseContext.treeRoot != NULL);
+    phaseTimer.endPhase(SH_COMPILE_PHASE_PARSE);
 
     shaderVersion = parseContext.getShaderVersion();
     if (success && MapSpecToShaderVersion(shaderSpec) < shaderVersion)
@@ -216,65 +277,139 @@ bool TCompiler::compile(const char* const shaderStrings[],
 
         TIntermNode* root = parseContext.treeRoot;
         success = intermediate.postProcess(root);
+        phaseTimer.endPhase(SH_COMPILE_PHASE_POST_PROCESS);
+
+        // The validation passes only read the tree, so they share a walk.
+        // Each reports its result in order, and only if the ones before it
+        // passed, so their messages go to sinks of their own first.
+        TPassManager validationPasses;
+        const bool limitComplexity = (compileOptions & SH_LIMIT_EXPRESSION_COMPLEXITY) != 0;
+        TMaxDepthTraverser maxDepthTraverser(maxExpressionComplexity + 1);
+        if (limitComplexity)
+            validationPasses.addPass(&maxDepthTraverser, SH_COMPILE_PHASE_LIMIT_EXPRESSION_COMPLEXITY);
+
+        DetectCallDepth callDepth(infoSink, (compileOptions & SH_LIMIT_CALL_STACK_DEPTH) != 0, maxCallStackDepth);
+        validationPasses.addPass(&callDepth, SH_COMPILE_PHASE_DETECT_CALL_DEPTH);
+
+        const bool checkOutputs = (shaderVersion == 300 && shaderType == GL_FRAGMENT_SHADER);
+        TInfoSinkBase outputsSink;
+        ValidateOutputs outputs(outputsSink, compileResources.MaxDrawBuffers);
+        if (checkOutputs)
+            validationPasses.addPass(&outputs, SH_COMPILE_PHASE_VALIDATE_OUTPUTS);
+
+        const bool checkLimitations = (compileOptions & SH_VALIDATE_LOOP_INDEXING) != 0;
+        TInfoSinkBase limitationsSink;
+        ValidateLimitations limitations(shaderType, limitationsSink);
+        if (checkLimitations)
+            validationPasses.addPass(&limitations, SH_COMPILE_PHASE_VALIDATE_LIMITATIONS);
+
+        if (success)
+        {
+            validationPasses.run(root);
+            mStatistics.analysisWalkCount += validationPasses.getWalkCount();
+        }
+        phaseTimer.endPasses(validationPasses);
 
         // Disallow expressions deemed too complex.
-        if (success && (compileOptions & SH_LIMIT_EXPRESSION_COMPLEXITY))
-            success = limitExpressionComplexity(root);
+        if (success && limitComplexity)
+            success = limitExpressionComplexity(root, maxDepthTraverser);
+        phaseTimer.endPhase(SH_COMPILE_PHASE_LIMIT_EXPRESSION_COMPLEXITY);
 
         if (success)
-            success = detectCallDepth(root, infoSink, (compileOptions & SH_LIMIT_CALL_STACK_DEPTH) != 0);
+            success = detectCallDepth(&callDepth, infoSink);
+        phaseTimer.endPhase(SH_COMPILE_PHASE_DETECT_CALL_DEPTH);
 
-        if (success && shaderVersion == 300 && shaderType == GL_FRAGMENT_SHADER)
-            success = validateOutputs(root);
+        if (success && checkOutputs)
+        {
+            infoSink.info << outputsSink.str();
+            success = (outputs.numErrors() == 0);
+        }
+        phaseTimer.endPhase(SH_COMPILE_PHASE_VALIDATE_OUTPUTS);
 
-        if (success && (compileOptions & SH_VALIDATE_LOOP_INDEXING))
-            success = validateLimitations(root);
+        if (success && checkLimitations)
+        {
+            infoSink.info << limitationsSink.str();
+            success = (limitations.numErrors() == 0);
+        }
+        phaseTimer.endPhase(SH_COMPILE_PHASE_VALIDATE_LIMITATIONS);
 
         if (success && (compileOptions & SH_TIMING_RESTRICTIONS))
             success = enforceTimingRestrictions(root, (compileOptions & SH_DEPENDENCY_GRAPH) != 0);
+        phaseTimer.endPhase(SH_COMPILE_PHASE_TIMING_RESTRICTIONS);
 
         if (success && shaderSpec == SH_CSS_SHADERS_SPEC)
             rewriteCSSShader(root);
+        phaseTimer.endPhase(SH_COMPILE_PHASE_REWRITE_TREE);
+
+        // The marking passes need a tree that passed validateLimitations, and
+        // only mark nodes, so they share a walk too. So does the collection of
+        // variables, unless the tree is rewritten in between.
+        TPassManager markingPasses;
+        ForLoopUnrollMarker integerIndexMarker(ForLoopUnrollMarker::kIntegerIndex);
+        if (compileOptions & SH_UNROLL_FOR_LOOP_WITH_INTEGER_INDEX)
+            markingPasses.addPass(&integerIndexMarker, SH_COMPILE_PHASE_UNROLL_FOR_LOOPS);
+        ForLoopUnrollMarker samplerArrayIndexMarker(ForLoopUnrollMarker::kSamplerArrayIndex);
+        if (compileOptions & SH_UNROLL_FOR_LOOP_WITH_SAMPLER_ARRAY_INDEX)
+            markingPasses.addPass(&samplerArrayIndexMarker, SH_COMPILE_PHASE_UNROLL_FOR_LOOPS);
+        if (compileOptions & SH_EMULATE_BUILT_IN_FUNCTIONS)
+            markingPasses.addPass(builtInFunctionEmulator.CreateEmulationMarker(), SH_COMPILE_PHASE_EMULATE_BUILT_IN_FUNCTIONS);
+        if (compileOptions & SH_CLAMP_INDIRECT_ARRAY_BOUNDS)
+            markingPasses.addPass(arrayBoundsClamper.CreateClampingMarker(), SH_COMPILE_PHASE_CLAMP_ARRAY_BOUNDS);
+
+        const bool initGLPosition = (shaderType == GL_VERTEX_SHADER && (compileOptions & SH_INIT_GL_POSITION));
+        const bool unfoldShortCircuits = (compileOptions & SH_UNFOLD_SHORT_CIRCUIT) != 0;
+        const bool optimize = (compileOptions & SH_OPTIMIZE) != 0;
+        const bool rewritesTree = initGLPosition || unfoldShortCircuits || optimize;
+        sh::CollectVariables collect(&attributes, &outputVariables, &uniforms, &varyings, &interfaceBlocks,
+                                     hashFunction, symbolTable);
+        if ((compileOptions & SH_VARIABLES) && !rewritesTree)
+            markingPasses.addPass(&collect, SH_COMPILE_PHASE_COLLECT_VARIABLES);
 
-        // Unroll for-loop markup needs to happen after validateLimitations pass.
-        if (success && (compileOptions & SH_UNROLL_FOR_LOOP_WITH_INTEGER_INDEX))
-        {
-            ForLoopUnrollMarker marker(ForLoopUnrollMarker::kIntegerIndex);
-            root->traverse(&marker);
-        }
-        if (success && (compileOptions & SH_UNROLL_FOR_LOOP_WITH_SAMPLER_ARRAY_INDEX))
+        if (success)
         {
-            ForLoopUnrollMarker marker(ForLoopUnrollMarker::kSamplerArrayIndex);
-            root->traverse(&marker);
-            if (marker.samplerArrayIndexIsFloatLoopIndex())
-            {
-                infoSink.info.prefix(EPrefixError);
-                infoSink.info << "sampler array index is float loop index";
-                success = false;
-            }
+            markingPasses.run(root);
+            mStatistics.analysisWalkCount += markingPasses.getWalkCount();
         }
+        phaseTimer.endPasses(markingPasses);
 
-        // Built-in function emulation needs to happen after validateLimitations pass.
-        if (success && (compileOptions & SH_EMULATE_BUILT_IN_FUNCTIONS))
-            builtInFunctionEmulator.MarkBuiltInFunctionsForEmulation(root);
+        if (success && (compileOptions & SH_UNROLL_FOR_LOOP_WITH_SAMPLER_ARRAY_INDEX) &&
+            samplerArrayIndexMarker.samplerArrayIndexIsFloatLoopIndex())
+        {
+            infoSink.info.prefix(EPrefixError);
+            infoSink.info << "sampler array index is float loop index";
+            success = false;
 
-        // Clamping uniform array bounds needs to happen after validateLimitations pass.
-        if (success && (compileOptions & SH_CLAMP_INDIRECT_ARRAY_BOUNDS))
-            arrayBoundsClamper.MarkIndirectArrayBoundsForClamping(root);
+            // The variables were collected in the same walk
+            clearVariables();
+        }
+        phaseTimer.endPhase(SH_COMPILE_PHASE_UNROLL_FOR_LOOPS);
 
-        if (success && shaderType == GL_VERTEX_SHADER && (compileOptions & SH_INIT_GL_POSITION))
+        if (success && initGLPosition)
             initializeGLPosition(root);
 
-        if (success && (compileOptions & SH_UNFOLD_SHORT_CIRCUIT))
+        if (success && unfoldShortCircuits)
         {
             UnfoldShortCircuitAST unfoldShortCircuit;
             root->traverse(&unfoldShortCircuit);
             unfoldShortCircuit.updateTree();
         }
+        phaseTimer.endPhase(SH_COMPILE_PHASE_REWRITE_TREE);
+
+        if (success && optimize)
+            OptimizeTree(root);
+        phaseTimer.endPhase(SH_COMPILE_PHASE_OPTIMIZE);
 
         if (success && (compileOptions & SH_VARIABLES))
         {
-            collectVariables(root);
+            if (rewritesTree)
+            {
+                root->traverse(&collect);
+                mStatistics.analysisWalkCount++;
+            }
+
+            // This is for enforcePackingRestriction().
+            sh::ExpandUniforms(uniforms, &expandedUniforms);
+
             if (compileOptions & SH_ENFORCE_PACKING_RESTRICTIONS)
             {
                 success = enforcePackingRestrictions();
@@ -288,6 +423,7 @@ bool TCompiler::compile(const char* const shaderStrings[],
                 (compileOptions & SH_INIT_VARYINGS_WITHOUT_STATIC_USE))
                 initializeVaryingsWithoutStaticUse(root);
         }
+        phaseTimer.endPhase(SH_COMPILE_PHASE_COLLECT_VARIABLES);
 
         if (success && (compileOptions & SH_SCALARIZE_VEC_AND_MAT_CONSTRUCTOR_ARGS))
         {
@@ -301,17 +437,32 @@ bool TCompiler::compile(const char* const shaderStrings[],
             RegenerateStructNames gen(symbolTable, shaderVersion);
             root->traverse(&gen);
         }
+        phaseTimer.endPhase(SH_COMPILE_PHASE_REWRITE_TREE);
 
         if (success && (compileOptions & SH_INTERMEDIATE_TREE))
             intermediate.outputTree(root);
 
         if (success && (compileOptions & SH_OBJECT_CODE))
             translate(root);
+        phaseTimer.endPhase(SH_COMPILE_PHASE_TRANSLATE);
     }
 
     // Cleanup memory.
-    intermediate.remove(parseContext.treeRoot);
+    mStatistics.astNodeCount = intermediate.remove(parseContext.treeRoot);
     SetGlobalParseContext(NULL);
+
+    // Nothing is freed from the pool before the compile ends, so the memory it
+    // holds now is the peak.
+    mStatistics.poolAllocationCount = allocator.getAllocationCount() - poolAllocationCount;
+    mStatistics.poolAllocatedBytes = allocator.getTotalBytes() - poolAllocatedBytes;
+    mStatistics.poolPeakBytes = allocator.getInUseBytes() - poolInUseBytes;
+    mStatistics.poolPageCount = allocator.getPageCount() - poolPageCount;
+    mStatistics.poolReusedPageCount = allocator.getReusedPageCount() - poolReusedPageCount;
+    mStatistics.symbolLookupCount = symbolTable.getLookupCount();
+    mStatistics.symbolProbeCount = symbolTable.getProbeCount();
+    const pp::MacroStatistics &macroStatistics = parseContext.preprocessor.getMacroStatistics();
+    mStatistics.macroExpansionCount = macroStatistics.expansionCount;
+    mStatistics.macroExpansionCacheHitCount = macroStatistics.cacheHitCount;
     return success;
 }
 
@@ -320,52 +471,11 @@ bool TCompiler::InitBuiltInSymbolTable(const ShBuiltInResources &resources)
     compileResources = resources;
     setResourceString();
 
-    assert(symbolTable.isEmpty());
-    symbolTable.push();   // COMMON_BUILTINS
-    symbolTable.push();   // ESSL1_BUILTINS
-    symbolTable.push();   // ESSL3_BUILTINS
-
-    TPublicType integer;
-    integer.type = EbtInt;
-    integer.primarySize = 1;
-    integer.secondarySize = 1;
-    integer.array = false;
-
-    TPublicType floatingPoint;
-    floatingPoint.type = EbtFloat;
-    floatingPoint.primarySize = 1;
-    floatingPoint.secondarySize = 1;
-    floatingPoint.array = false;
-
-    TPublicType sampler;
-    sampler.primarySize = 1;
-    sampler.secondarySize = 1;
-    sampler.array = false;
-
-    switch(shaderType)
-    {
-      case GL_FRAGMENT_SHADER:
-        symbolTable.setDefaultPrecision(integer, EbpMedium);
-        break;
-      case GL_VERTEX_SHADER:
-        symbolTable.setDefaultPrecision(integer, EbpHigh);
-        symbolTable.setDefaultPrecision(floatingPoint, EbpHigh);
-        break;
-      default:
-        assert(false && "Language not supported");
-    }
-    // We set defaults for all the sampler types, even those that are
-    // only available if an extension exists.
-    for (int samplerType = EbtGuardSamplerBegin + 1;
-         samplerType < EbtGuardSamplerEnd; ++samplerType)
-    {
-        sampler.type = static_cast<TBasicType>(samplerType);
-        symbolTable.setDefaultPrecision(sampler, EbpLow);
-    }
-
-    InsertBuiltInFunctions(shaderType, shaderSpec, resources, symbolTable);
+    // The built-in levels are shared by every compiler with the same configuration
+    builtInSymbolTable = TBuiltInSymbolTable::Get(shaderType, shaderSpec, resources, builtInResourcesString);
 
-    IdentifyBuiltIns(shaderType, shaderSpec, resources, symbolTable);
+    assert(symbolTable.isEmpty());
+    symbolTable.pushSharedBuiltIns(builtInSymbolTable->getSymbolTable());
 
     return true;
 }
@@ -401,28 +511,72 @@ void TCompiler::setResourceString()
 
 void TCompiler::clearResults()
 {
+    mStatistics = ShCompileStatistics();
     arrayBoundsClamper.Cleanup();
     infoSink.info.erase();
     infoSink.obj.erase();
     infoSink.debug.erase();
 
+    clearVariables();
+
+    builtInFunctionEmulator.Cleanup();
+
+    nameMap.clear();
+}
+
+void TCompiler::clearVariables()
+{
     attributes.clear();
     outputVariables.clear();
     uniforms.clear();
     expandedUniforms.clear();
     varyings.clear();
     interfaceBlocks.clear();
+}
 
-    builtInFunctionEmulator.Cleanup();
+void TCompiler::saveResults(TCacheOutputStream *stream) const
+{
+    stream->writeInt(shaderVersion);
+    stream->writeString(infoSink.info.str());
+    stream->writeString(infoSink.obj.str());
 
-    nameMap.clear();
+    stream->writeVariables(attributes);
+    stream->writeVariables(outputVariables);
+    stream->writeVariables(uniforms);
+    stream->writeVariables(expandedUniforms);
+    stream->writeVariables(varyings);
+    stream->writeVariables(interfaceBlocks);
 }
 
-bool TCompiler::detectCallDepth(TIntermNode* root, TInfoSink& infoSink, bool limitCallStackDepth)
+bool TCompiler::loadResults(TCacheInputStream *stream)
 {
-    DetectCallDepth detect(infoSink, limitCallStackDepth, maxCallStackDepth);
-    root->traverse(&detect);
-    switch (detect.detectCallDepth())
+    clearResults();
+
+    unsigned int version = 0;
+    std::string infoLog;
+    std::string objectCode;
+    if (!stream->readInt(&version) ||
+        !stream->readString(&infoLog) ||
+        !stream->readString(&objectCode))
+    {
+        return false;
+    }
+
+    shaderVersion = static_cast<int>(version);
+    infoSink.info << infoLog;
+    infoSink.obj << objectCode;
+
+    return stream->readVariables(&attributes) &&
+           stream->readVariables(&outputVariables) &&
+           stream->readVariables(&uniforms) &&
+           stream->readVariables(&expandedUniforms) &&
+           stream->readVariables(&varyings) &&
+           stream->readVariables(&interfaceBlocks);
+}
+
+bool TCompiler::detectCallDepth(DetectCallDepth *detect, TInfoSink& infoSink)
+{
+    switch (detect->detectCallDepth())
     {
       case DetectCallDepth::kErrorNone:
         return true;
@@ -444,26 +598,12 @@ bool TCompiler::detectCallDepth(TIntermNode* root, TInfoSink& infoSink, bool lim
     }
 }
 
-bool TCompiler::validateOutputs(TIntermNode* root)
-{
-    ValidateOutputs validateOutputs(infoSink.info, compileResources.MaxDrawBuffers);
-    root->traverse(&validateOutputs);
-    return (validateOutputs.numErrors() == 0);
-}
-
 void TCompiler::rewriteCSSShader(TIntermNode* root)
 {
     RenameFunction renamer("main(", "css_main(");
     root->traverse(&renamer);
 }
 
-bool TCompiler::validateLimitations(TIntermNode* root)
-{
-    ValidateLimitations validate(shaderType, infoSink.info);
-    root->traverse(&validate);
-    return validate.numErrors() == 0;
-}
-
 bool TCompiler::enforceTimingRestrictions(TIntermNode* root, bool outputGraph)
 {
     if (shaderSpec != SH_WEBGL_SPEC)
@@ -494,11 +634,8 @@ bool TCompiler::enforceTimingRestrictions(TIntermNode* root, bool outputGraph)
     }
 }
 
-bool TCompiler::limitExpressionComplexity(TIntermNode* root)
+bool TCompiler::limitExpressionComplexity(TIntermNode* root, const TMaxDepthTraverser& traverser)
 {
-    TMaxDepthTraverser traverser(maxExpressionComplexity+1);
-    root->traverse(&traverser);
-
     if (traverser.getMaxDepth() > maxExpressionComplexity)
     {
         infoSink.info << "Expression too complex.";
@@ -533,21 +670,6 @@ bool TCompiler::enforceVertexShaderTimingRestrictions(TIntermNode* root)
     return restrictor.numErrors() == 0;
 }
 
-void TCompiler::collectVariables(TIntermNode* root)
-{
-    sh::CollectVariables collect(&attributes,
-                                 &outputVariables,
-                                 &uniforms,
-                                 &varyings,
-                                 &interfaceBlocks,
-                                 hashFunction,
-                                 symbolTable);
-    root->traverse(&collect);
-
-    // This is for enforcePackingRestriction().
-    sh::ExpandUniforms(uniforms, &expandedUniforms);
-}
-
 bool TCompiler::enforcePackingRestrictions()
 {
     VariablePacker packer;
@@ -23,8 +23,14 @@
 #include "compiler/translator/VariableInfo.h"
 #include "third_party/compiler/ArrayBoundsClamper.h"
 
+#include <memory>
+
+class TBuiltInSymbolTable;
+class TCacheInputStream;
+class TCacheOutputStream;
 class TCompiler;
 class TDependencyGraph;
+class DetectCallDepth;
 class TranslatorHLSL;
 
 //
@@ -72,6 +78,7 @@ class TCompiler : public TShHandleBase
     const std::vector<sh::Attribute> &getAttributes() const { return attributes; }
     const std::vector<sh::Attribute> &getOutputVariables() const { return outputVariables; }
     const std::vector<sh::Uniform> &getUniforms() const { return uniforms; }
+    const std::vector<sh::ShaderVariable> &getExpandedUniforms() const { return expandedUniforms; }
     const std::vector<sh::Varying> &getVaryings() const { return varyings; }
     const std::vector<sh::InterfaceBlock> &getInterfaceBlocks() const { return interfaceBlocks; }
 
@@ -82,28 +89,32 @@ class TCompiler : public TShHandleBase
     ShShaderOutput getOutputType() const { return outputType; }
     const std::string &getBuiltInResourcesString() const { return builtInResourcesString; }
 
+    sh::GLenum getShaderType() const { return shaderType; }
+
     // Get the resources set by InitBuiltInSymbolTable
     const ShBuiltInResources& getResources() const;
 
+    // Get the phase timings and memory use of the last compilation.
+    const ShCompileStatistics &getStatistics() const { return mStatistics; }
+
+    // Serialize the results of the last compilation for the translation cache.
+    virtual void saveResults(TCacheOutputStream *stream) const;
+    // Replace the results with ones read back from the translation cache.
+    virtual bool loadResults(TCacheInputStream *stream);
+
   protected:
-    sh::GLenum getShaderType() const { return shaderType; }
     // Initialize symbol-table with built-in symbols.
     bool InitBuiltInSymbolTable(const ShBuiltInResources& resources);
     // Compute the string representation of the built-in resources
     void setResourceString();
     // Clears the results from the previous compilation.
     void clearResults();
+    // Clears the collected variables.
+    void clearVariables();
     // Return true if function recursion is detected or call depth exceeded.
-    bool detectCallDepth(TIntermNode* root, TInfoSink& infoSink, bool limitCallStackDepth);
-    // Returns true if a program has no conflicting or missing fragment outputs
-    bool validateOutputs(TIntermNode* root);
+    bool detectCallDepth(DetectCallDepth* detect, TInfoSink& infoSink);
     // Rewrites a shader's intermediate tree according to the CSS Shaders spec.
     void rewriteCSSShader(TIntermNode* root);
-    // Returns true if the given shader does not exceed the minimum
-    // functionality mandated in GLSL 1.0 spec Appendix A.
-    bool validateLimitations(TIntermNode* root);
-    // Collect info for all attribs, uniforms, varyings.
-    void collectVariables(TIntermNode* root);
     // Translate to object code.
     virtual void translate(TIntermNode* root) = 0;
     // Returns true if, after applying the packing rules in the GLSL 1.017 spec
@@ -126,8 +137,9 @@ class TCompiler : public TShHandleBase
     // Returns true if the shader does not use sampler dependent values to affect control
     // flow or in operations whose time can depend on the input values.
     bool enforceFragmentShaderTimingRestrictions(const TDependencyGraph& graph);
-    // Return true if the maximum expression complexity is below the limit.
-    bool limitExpressionComplexity(TIntermNode* root);
+    // Return true if the maximum expression complexity the traverser found
+    // is below the limit.
+    bool limitExpressionComplexity(TIntermNode* root, const TMaxDepthTraverser& traverser);
     // Get built-in extensions with default behavior.
     const TExtensionBehavior& getExtensionBehavior() const;
     const TPragma& getPragma() const { return mPragma; }
@@ -156,7 +168,10 @@ class TCompiler : public TShHandleBase
     ShBuiltInResources compileResources;
     std::string builtInResourcesString;
 
-    // Built-in symbol table for the given language, spec, and resources.
+    // Built-in levels shared with other compilers for the same language, spec
+    // and resources. Declared before symbolTable, which refers to them.
+    std::shared_ptr<const TBuiltInSymbolTable> builtInSymbolTable;
+    // Symbol table layered on the built-ins.
     // It is preserved from compile-to-compile.
     TSymbolTable symbolTable;
     // Built-in extensions with default behavior.
@@ -176,6 +191,8 @@ class TCompiler : public TShHandleBase
     NameMap nameMap;
 
     TPragma mPragma;
+
+    ShCompileStatistics mStatistics;
 };
 
 //
@@ -5,6 +5,7 @@
 //
 
 #include "compiler/translator/InitializeDll.h"
+#include "compiler/translator/BuiltInSymbolTable.h"
 #include "compiler/translator/InitializeGlobals.h"
 #include "compiler/translator/InitializeParseContext.h"
 
@@ -29,6 +30,7 @@ bool InitProcess()
 
 void DetachProcess()
 {
+    TBuiltInSymbolTable::ReleaseAll();
     FreeParseContextIndex();
     FreePoolIndex();
 }
@@ -199,6 +199,7 @@ class TIntermSelection;
 class TIntermTyped;
 class TIntermSymbol;
 class TIntermLoop;
+class TIntermBranch;
 class TInfoSink;
 class TIntermRaw;
 
@@ -230,6 +231,7 @@ class TIntermNode
     virtual TIntermSelection *getAsSelectionNode() { return 0; }
     virtual TIntermSymbol *getAsSymbolNode() { return 0; }
     virtual TIntermLoop *getAsLoopNode() { return 0; }
+    virtual TIntermBranch *getAsBranchNode() { return 0; }
     virtual TIntermRaw *getAsRawNode() { return 0; }
 
     // Replace a child node. Return true if |original| is a child
@@ -353,6 +355,7 @@ class TIntermBranch : public TIntermNode
         : mFlowOp(op),
           mExpression(e) { }
 
+    virtual TIntermBranch *getAsBranchNode() { return this; }
     virtual void traverse(TIntermTraverser *);
     virtual bool replaceChildNode(
         TIntermNode *original, TIntermNode *replacement);
@@ -687,17 +690,24 @@ enum Visit
 // When using this, just fill in the methods for nodes you want visited.
 // Return false from a pre-visit to skip visiting that node's subtree.
 //
+// Iterative traversers recurse only down to kIterativeTraversalDepth, and
+// hand deeper subtrees to traverseIteratively(), which keeps the nodes
+// still to be visited on an explicit stack instead of the C++ call stack.
+// This keeps very deep trees from overflowing the stack while shallow ones
+// keep the speed of recursion. The visit order is the same either way.
+//
 class TIntermTraverser
 {
   public:
     POOL_ALLOCATOR_NEW_DELETE();
     // TODO(zmo): remove default values.
     TIntermTraverser(bool preVisit = true, bool inVisit = false, bool postVisit = false,
-                     bool rightToLeft = false)
+                     bool rightToLeft = false, bool iterative = true)
         : preVisit(preVisit),
           inVisit(inVisit),
           postVisit(postVisit),
           rightToLeft(rightToLeft),
+          iterative(iterative),
           mDepth(0),
           mMaxDepth(0) {}
     virtual ~TIntermTraverser() {}
@@ -736,10 +746,23 @@ class TIntermTraverser
     // otherwise return the hashed name.
     static TString hash(const TString& name, ShHashFunction64 hashFunction);
 
+    // Traverses the subtree rooted at |root| without recursing.
+    void traverseIteratively(TIntermNode *root);
+
+    // Whether the traverse() of a node with children should hand it to
+    // traverseIteratively() instead of recursing further.
+    bool shouldTraverseIteratively() const
+    {
+        return iterative && mDepth >= kIterativeTraversalDepth;
+    }
+
+    static const int kIterativeTraversalDepth = 256;
+
     const bool preVisit;
     const bool inVisit;
     const bool postVisit;
     const bool rightToLeft;
+    const bool iterative;
 
   protected:
     int mDepth;
@@ -747,6 +770,32 @@ class TIntermTraverser
 
     // All the nodes from root to the current node's parent during traversing.
     TVector<TIntermNode *> mPath;
+
+  private:
+    enum FrameType
+    {
+        FrameBinary,
+        FrameUnary,
+        FrameAggregate,
+        FrameSelection,
+        FrameLoop,
+        FrameBranch
+    };
+
+    // A node whose children are being traversed iteratively.
+    struct TraversalFrame
+    {
+        TIntermNode *node;
+        FrameType type;
+        size_t nextChild;
+        bool visit;
+    };
+
+    void beginNode(TIntermNode *node);
+    bool visitFrame(Visit visit, const TraversalFrame &frame);
+    bool nextChild(size_t frameIndex, TIntermNode **child);
+
+    TVector<TraversalFrame> mTraversalStack;
 };
 
 //
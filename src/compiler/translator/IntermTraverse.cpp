@@ -19,6 +19,11 @@
 // preVisit, postVisit, and rightToLeft control what order
 // nodes are visited in.
 //
+// Traversers with iterative set hand subtrees below a fixed depth to
+// TIntermTraverser::traverseIteratively, which visits the nodes in
+// the same order but keeps its position in each node on an explicit
+// stack.
+//
 
 //
 // Traversal functions for terminals are straighforward....
@@ -38,6 +43,12 @@ void TIntermConstantUnion::traverse(TIntermTraverser *it)
 //
 void TIntermBinary::traverse(TIntermTraverser *it)
 {
+    if (it->shouldTraverseIteratively())
+    {
+        it->traverseIteratively(this);
+        return;
+    }
+
     bool visit = true;
 
     //
@@ -92,6 +103,12 @@ void TIntermBinary::traverse(TIntermTraverser *it)
 //
 void TIntermUnary::traverse(TIntermTraverser *it)
 {
+    if (it->shouldTraverseIteratively())
+    {
+        it->traverseIteratively(this);
+        return;
+    }
+
     bool visit = true;
 
     if (it->preVisit)
@@ -112,6 +129,12 @@ void TIntermUnary::traverse(TIntermTraverser *it)
 //
 void TIntermAggregate::traverse(TIntermTraverser *it)
 {
+    if (it->shouldTraverseIteratively())
+    {
+        it->traverseIteratively(this);
+        return;
+    }
+
     bool visit = true;
 
     if (it->preVisit)
@@ -162,6 +185,12 @@ void TIntermAggregate::traverse(TIntermTraverser *it)
 //
 void TIntermSelection::traverse(TIntermTraverser *it)
 {
+    if (it->shouldTraverseIteratively())
+    {
+        it->traverseIteratively(this);
+        return;
+    }
+
     bool visit = true;
 
     if (it->preVisit)
@@ -198,6 +227,12 @@ void TIntermSelection::traverse(TIntermTraverser *it)
 //
 void TIntermLoop::traverse(TIntermTraverser *it)
 {
+    if (it->shouldTraverseIteratively())
+    {
+        it->traverseIteratively(this);
+        return;
+    }
+
     bool visit = true;
 
     if (it->preVisit)
@@ -248,6 +283,12 @@ void TIntermLoop::traverse(TIntermTraverser *it)
 //
 void TIntermBranch::traverse(TIntermTraverser *it)
 {
+    if (it->shouldTraverseIteratively())
+    {
+        it->traverseIteratively(this);
+        return;
+    }
+
     bool visit = true;
 
     if (it->preVisit)
@@ -267,3 +308,224 @@ void TIntermRaw::traverse(TIntermTraverser *it)
 {
     it->visitRaw(this);
 }
+
+namespace
+{
+
+// Fills |children| with the children of a node with a fixed number of
+// child slots, in the order the recursive traversal visits them. Empty
+// slots are NULL.
+size_t GetFixedChildren(TIntermNode *node, bool rightToLeft, TIntermNode **children)
+{
+    size_t count = 0;
+    if (TIntermUnary *unary = node->getAsUnaryNode())
+    {
+        children[count++] = unary->getOperand();
+    }
+    else if (TIntermSelection *selection = node->getAsSelectionNode())
+    {
+        children[count++] = selection->getCondition();
+        children[count++] = selection->getTrueBlock();
+        children[count++] = selection->getFalseBlock();
+    }
+    else if (TIntermLoop *loop = node->getAsLoopNode())
+    {
+        children[count++] = loop->getInit();
+        children[count++] = loop->getCondition();
+        children[count++] = loop->getBody();
+        children[count++] = loop->getExpression();
+    }
+    else if (TIntermBranch *branch = node->getAsBranchNode())
+    {
+        children[count++] = branch->getExpression();
+    }
+
+    if (rightToLeft)
+    {
+        std::reverse(children, children + count);
+    }
+    return count;
+}
+
+}  // namespace anonymous
+
+void TIntermTraverser::traverseIteratively(TIntermNode *root)
+{
+    // Visitors may start a nested traversal of a subtree, which shares
+    // the stack above the frames of the outer one.
+    const size_t baseSize = mTraversalStack.size();
+    beginNode(root);
+
+    while (mTraversalStack.size() > baseSize)
+    {
+        const size_t frameIndex = mTraversalStack.size() - 1;
+        TIntermNode *child = NULL;
+        if (nextChild(frameIndex, &child))
+        {
+            if (child)
+                beginNode(child);
+        }
+        else
+        {
+            TraversalFrame frame = mTraversalStack.back();
+            mTraversalStack.pop_back();
+            decrementDepth();
+
+            if (frame.visit && postVisit)
+                visitFrame(PostVisit, frame);
+        }
+    }
+}
+
+//
+// Visits a node before its children, and pushes its frame if its children
+// are to be traversed.
+//
+void TIntermTraverser::beginNode(TIntermNode *node)
+{
+    TraversalFrame frame;
+    frame.node = node;
+    frame.nextChild = 0;
+    frame.visit = true;
+
+    // Most common node types first
+    if (node->getAsBinaryNode())
+        frame.type = FrameBinary;
+    else if (TIntermSymbol *symbol = node->getAsSymbolNode())
+    {
+        visitSymbol(symbol);
+        return;
+    }
+    else if (TIntermConstantUnion *constant = node->getAsConstantUnion())
+    {
+        visitConstantUnion(constant);
+        return;
+    }
+    else if (node->getAsAggregate())
+        frame.type = FrameAggregate;
+    else if (node->getAsUnaryNode())
+        frame.type = FrameUnary;
+    else if (node->getAsSelectionNode())
+        frame.type = FrameSelection;
+    else if (node->getAsLoopNode())
+        frame.type = FrameLoop;
+    else if (TIntermBranch *branch = node->getAsBranchNode())
+    {
+        frame.type = FrameBranch;
+
+        // A branch without an expression is visited without entering it
+        if (!branch->getExpression())
+        {
+            if ((!preVisit || visitBranch(PreVisit, branch)) && postVisit)
+                visitBranch(PostVisit, branch);
+            return;
+        }
+    }
+    else
+    {
+        node->traverse(this);
+        return;
+    }
+
+    if (preVisit)
+        frame.visit = visitFrame(PreVisit, frame);
+
+    if (frame.visit)
+    {
+        incrementDepth(node);
+        mTraversalStack.push_back(frame);
+    }
+}
+
+bool TIntermTraverser::visitFrame(Visit visit, const TraversalFrame &frame)
+{
+    switch (frame.type)
+    {
+      case FrameBinary:
+        return visitBinary(visit, static_cast<TIntermBinary *>(frame.node));
+      case FrameUnary:
+        return visitUnary(visit, static_cast<TIntermUnary *>(frame.node));
+      case FrameAggregate:
+        return visitAggregate(visit, static_cast<TIntermAggregate *>(frame.node));
+      case FrameSelection:
+        return visitSelection(visit, static_cast<TIntermSelection *>(frame.node));
+      case FrameLoop:
+        return visitLoop(visit, static_cast<TIntermLoop *>(frame.node));
+      case FrameBranch:
+        return visitBranch(visit, static_cast<TIntermBranch *>(frame.node));
+      default:
+        UNREACHABLE();
+        return false;
+    }
+}
+
+//
+// Makes the in-visits due before the next child of the frame at
+// |frameIndex|, and returns false once all its children are done.
+// The frame is looked up again after each visit, since a visitor
+// may push frames of its own.
+//
+bool TIntermTraverser::nextChild(size_t frameIndex, TIntermNode **child)
+{
+    TIntermNode *node = mTraversalStack[frameIndex].node;
+    const size_t index = mTraversalStack[frameIndex].nextChild;
+
+    switch (mTraversalStack[frameIndex].type)
+    {
+      case FrameBinary:
+        {
+            TIntermBinary *binary = static_cast<TIntermBinary *>(node);
+            if (index == 0)
+            {
+                *child = rightToLeft ? binary->getRight() : binary->getLeft();
+            }
+            else if (index == 1)
+            {
+                if (inVisit)
+                    mTraversalStack[frameIndex].visit = visitBinary(InVisit, binary);
+
+                if (mTraversalStack[frameIndex].visit)
+                    *child = rightToLeft ? binary->getLeft() : binary->getRight();
+            }
+            else
+            {
+                return false;
+            }
+        }
+        break;
+
+      case FrameAggregate:
+        {
+            TIntermAggregate *aggregate = static_cast<TIntermAggregate *>(node);
+            TIntermSequence *sequence = aggregate->getSequence();
+            const size_t size = sequence->size();
+
+            // The in-visit follows every child but the last
+            if (index > 0 && index <= size && inVisit && mTraversalStack[frameIndex].visit)
+            {
+                TIntermNode *previous = rightToLeft ? (*sequence)[size - index] : (*sequence)[index - 1];
+                if (previous != (rightToLeft ? sequence->front() : sequence->back()))
+                    mTraversalStack[frameIndex].visit = visitAggregate(InVisit, aggregate);
+            }
+
+            if (index >= sequence->size())
+                return false;
+
+            *child = rightToLeft ? (*sequence)[sequence->size() - 1 - index] : (*sequence)[index];
+        }
+        break;
+
+      default:
+        {
+            TIntermNode *children[4];
+            if (index >= GetFixedChildren(node, rightToLeft, children))
+                return false;
+
+            *child = children[index];
+        }
+        break;
+    }
+
+    mTraversalStack[frameIndex].nextChild = index + 1;
+    return true;
+}
@@ -514,8 +514,9 @@ bool TIntermediate::postProcess(TIntermNode *root)
 //
 // This deletes the tree.
 //
-void TIntermediate::remove(TIntermNode *root)
+size_t TIntermediate::remove(TIntermNode *root)
 {
     if (root)
-        RemoveAllTreeNodes(root);
+        return RemoveAllTreeNodes(root);
+    return 0;
 }
@@ -55,7 +55,8 @@ class TIntermediate
     TIntermBranch *addBranch(TOperator, TIntermTyped *, const TSourceLoc &);
     TIntermTyped *addSwizzle(TVectorFields &, const TSourceLoc &);
     bool postProcess(TIntermNode *);
-    void remove(TIntermNode *);
+    // Returns the number of nodes that were removed.
+    size_t remove(TIntermNode *);
     void outputTree(TIntermNode *);
 
   private:
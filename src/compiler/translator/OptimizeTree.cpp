@@ -0,0 +1,673 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// OptimizeTree.cpp: Shrinks the intermediate tree before it is translated,
+// so that the driver or D3D compiler has less source to compile.
+//
+
+#include "compiler/translator/OptimizeTree.h"
+
+#include "compiler/translator/InfoSink.h"
+#include "compiler/translator/IntermNode.h"
+
+#include <algorithm>
+#include <map>
+#include <set>
+
+namespace
+{
+
+typedef std::map<TString, TIntermAggregate *> FunctionDefinitionMap;
+
+// The children of a sequence, which is either a block or the global scope,
+// are statements of their own.
+bool IsStatement(TIntermNode *parent)
+{
+    TIntermAggregate *aggregate = parent ? parent->getAsAggregate() : NULL;
+    return aggregate && aggregate->getOp() == EOpSequence;
+}
+
+// Function parameters, built-ins and the variables of the shader's
+// interface are left alone.
+bool IsOptimizableVariable(TIntermTyped *node)
+{
+    return node->getQualifier() == EvqTemporary || node->getQualifier() == EvqGlobal;
+}
+
+// Returns the variable an l-value writes, through any indexing, swizzles
+// and struct fields.
+TIntermSymbol *GetWrittenVariable(TIntermTyped *lvalue)
+{
+    while (TIntermBinary *binary = lvalue->getAsBinaryNode())
+    {
+        lvalue = binary->getLeft();
+    }
+
+    TIntermSymbol *symbol = lvalue->getAsSymbolNode();
+    return (symbol && IsOptimizableVariable(symbol)) ? symbol : NULL;
+}
+
+// A declarator is either the symbol it declares, or the initialization of it.
+TIntermSymbol *GetDeclaredVariable(TIntermNode *declarator)
+{
+    if (TIntermBinary *initialization = declarator->getAsBinaryNode())
+    {
+        return initialization->getLeft()->getAsSymbolNode();
+    }
+    return declarator->getAsSymbolNode();
+}
+
+// TIntermAggregate::hasSideEffects() takes all aggregates to have them. Only
+// the calls to user-defined functions can: built-in functions and
+// constructors have none of their own.
+bool HasSideEffects(TIntermNode *node)
+{
+    if (TIntermAggregate *aggregate = node->getAsAggregate())
+    {
+        if (aggregate->getOp() == EOpFunctionCall && aggregate->isUserDefined())
+            return true;
+
+        TIntermSequence *arguments = aggregate->getSequence();
+        for (size_t index = 0; index < arguments->size(); index++)
+        {
+            if (HasSideEffects((*arguments)[index]))
+                return true;
+        }
+        return false;
+    }
+    if (TIntermBinary *binary = node->getAsBinaryNode())
+    {
+        return binary->isAssignment() || HasSideEffects(binary->getLeft()) ||
+               HasSideEffects(binary->getRight());
+    }
+    if (TIntermUnary *unary = node->getAsUnaryNode())
+    {
+        return unary->isAssignment() || HasSideEffects(unary->getOperand());
+    }
+    if (TIntermSelection *selection = node->getAsSelectionNode())
+    {
+        return HasSideEffects(selection->getCondition()) ||
+               (selection->getTrueBlock() && HasSideEffects(selection->getTrueBlock())) ||
+               (selection->getFalseBlock() && HasSideEffects(selection->getFalseBlock()));
+    }
+
+    TIntermTyped *typed = node->getAsTyped();
+    return !typed || typed->hasSideEffects();
+}
+
+bool IsFoldableOperator(TOperator op)
+{
+    switch (op)
+    {
+      case EOpNegative:
+      case EOpPositive:
+      case EOpLogicalNot:
+      case EOpAdd:
+      case EOpSub:
+      case EOpMul:
+      case EOpDiv:
+      case EOpVectorTimesScalar:
+      case EOpVectorTimesMatrix:
+      case EOpMatrixTimesVector:
+      case EOpMatrixTimesScalar:
+      case EOpMatrixTimesMatrix:
+      case EOpEqual:
+      case EOpNotEqual:
+      case EOpLessThan:
+      case EOpGreaterThan:
+      case EOpLessThanEqual:
+      case EOpGreaterThanEqual:
+      case EOpLogicalAnd:
+      case EOpLogicalOr:
+      case EOpLogicalXor:
+        return true;
+      default:
+        return false;
+    }
+}
+
+//
+// Finds the function definitions, and the user-defined functions each of
+// them calls.
+//
+class CallGraphTraverser : public TIntermTraverser
+{
+  public:
+    CallGraphTraverser()
+        : TIntermTraverser(true, false, true)
+    {
+    }
+
+    virtual bool visitAggregate(Visit visit, TIntermAggregate *node)
+    {
+        switch (node->getOp())
+        {
+          case EOpFunction:
+            if (visit == PreVisit)
+            {
+                mCurrentFunction = node->getName();
+                mDefinitions[node->getName()] = node;
+            }
+            else
+            {
+                mCurrentFunction.clear();
+            }
+            break;
+
+          case EOpFunctionCall:
+            if (visit == PreVisit && node->isUserDefined())
+                mCallees[mCurrentFunction].insert(node->getName());
+            break;
+
+          default:
+            break;
+        }
+        return true;
+    }
+
+    const FunctionDefinitionMap &getDefinitions() const { return mDefinitions; }
+
+    // Returns the mangled names of main() and of the functions it reaches.
+    // Calls made outside of any function are counted as reachable too.
+    std::set<TString> getReachableFunctions() const
+    {
+        std::set<TString> reachable;
+        std::vector<TString> pending;
+        pending.push_back("main(");
+        pending.push_back("");
+        while (!pending.empty())
+        {
+            TString name = pending.back();
+            pending.pop_back();
+            if (!reachable.insert(name).second)
+                continue;
+
+            CalleeMap::const_iterator callees = mCallees.find(name);
+            if (callees != mCallees.end())
+                pending.insert(pending.end(), callees->second.begin(), callees->second.end());
+        }
+        return reachable;
+    }
+
+  private:
+    typedef std::map<TString, std::set<TString> > CalleeMap;
+
+    TString mCurrentFunction;
+    FunctionDefinitionMap mDefinitions;
+    CalleeMap mCallees;
+};
+
+void RemoveUnreachableFunctions(TIntermAggregate *globals, const std::set<TString> &reachable)
+{
+    // Prototypes only have the unmangled name, so a prototype goes only if
+    // no overload of the same name is reachable.
+    std::set<TString> reachableNames;
+    for (std::set<TString>::const_iterator name = reachable.begin(); name != reachable.end(); ++name)
+    {
+        reachableNames.insert(name->substr(0, name->find('(')));
+    }
+
+    TIntermSequence *sequence = globals->getSequence();
+    size_t keptCount = 0;
+    for (size_t index = 0; index < sequence->size(); index++)
+    {
+        TIntermAggregate *aggregate = (*sequence)[index]->getAsAggregate();
+        if (aggregate && aggregate->getOp() == EOpFunction && reachable.count(aggregate->getName()) == 0)
+            continue;
+        if (aggregate && aggregate->getOp() == EOpPrototype && reachableNames.count(aggregate->getName()) == 0)
+            continue;
+
+        (*sequence)[keptCount++] = (*sequence)[index];
+    }
+    sequence->resize(keptCount);
+}
+
+struct VariableUse
+{
+    VariableUse()
+        : declarationCount(0),
+          writeCount(0),
+          readCount(0),
+          removable(true)
+    {
+    }
+
+    int declarationCount;
+
+    // Writes other than the initialization.
+    int writeCount;
+    int readCount;
+
+    // Whether the declaration and all the writes are statements of their
+    // own that have no other side effects.
+    bool removable;
+};
+
+typedef std::map<int, VariableUse> VariableUseMap;
+
+//
+// Counts the declarations, writes and reads of every variable.
+//
+class VariableUseTraverser : public TIntermTraverser
+{
+  public:
+    VariableUseTraverser(const FunctionDefinitionMap &definitions)
+        : TIntermTraverser(true, false, false),
+          mDefinitions(definitions)
+    {
+    }
+
+    virtual void visitSymbol(TIntermSymbol *node)
+    {
+        if (IsOptimizableVariable(node))
+            mUses[node->getId()].readCount++;
+    }
+
+    virtual bool visitBinary(Visit, TIntermBinary *node)
+    {
+        if (!node->isAssignment())
+            return true;
+
+        TIntermSymbol *variable = node->getLeft()->getAsSymbolNode();
+        if (!variable || !IsOptimizableVariable(variable))
+        {
+            // Writing part of a variable reads the rest of it
+            if (TIntermSymbol *written = GetWrittenVariable(node->getLeft()))
+                mUses[written->getId()].writeCount++;
+            return true;
+        }
+
+        VariableUse &use = mUses[variable->getId()];
+        use.writeCount++;
+        if (!IsStatement(getParentNode()) || HasSideEffects(node->getRight()))
+            use.removable = false;
+
+        traverseChild(node, node->getRight());
+        return false;
+    }
+
+    virtual bool visitUnary(Visit, TIntermUnary *node)
+    {
+        if (!node->isAssignment())
+            return true;
+
+        TIntermSymbol *variable = node->getOperand()->getAsSymbolNode();
+        if (!variable || !IsOptimizableVariable(variable))
+        {
+            if (TIntermSymbol *written = GetWrittenVariable(node->getOperand()))
+                mUses[written->getId()].writeCount++;
+            return true;
+        }
+
+        VariableUse &use = mUses[variable->getId()];
+        use.writeCount++;
+        if (!IsStatement(getParentNode()))
+            use.removable = false;
+        return false;
+    }
+
+    virtual bool visitAggregate(Visit, TIntermAggregate *node)
+    {
+        switch (node->getOp())
+        {
+          case EOpDeclaration:
+            {
+                const bool statement = IsStatement(getParentNode());
+                TIntermSequence *declarators = node->getSequence();
+                for (size_t index = 0; index < declarators->size(); index++)
+                {
+                    TIntermNode *declarator = (*declarators)[index];
+                    TIntermSymbol *variable = GetDeclaredVariable(declarator);
+                    TIntermBinary *initialization = declarator->getAsBinaryNode();
+
+                    if (variable && IsOptimizableVariable(variable))
+                    {
+                        VariableUse &use = mUses[variable->getId()];
+                        use.declarationCount++;
+
+                        // Removing a struct variable could remove the
+                        // definition of its struct with it
+                        if (!statement || variable->getBasicType() == EbtStruct ||
+                            (initialization && HasSideEffects(initialization->getRight())))
+                        {
+                            use.removable = false;
+                        }
+                    }
+
+                    if (initialization)
+                        traverseChild(initialization, initialization->getRight());
+                }
+            }
+            return false;
+
+          case EOpFunctionCall:
+            if (node->isUserDefined())
+                countOutArguments(node);
+            return true;
+
+          default:
+            return true;
+        }
+    }
+
+    const VariableUseMap &getUses() const { return mUses; }
+
+  private:
+    void traverseChild(TIntermNode *parent, TIntermNode *child)
+    {
+        incrementDepth(parent);
+        child->traverse(this);
+        decrementDepth();
+    }
+
+    // The out and inout arguments of a call are written. All the arguments
+    // of a function that is not defined are taken to be.
+    void countOutArguments(TIntermAggregate *call)
+    {
+        TIntermSequence *parameters = NULL;
+        FunctionDefinitionMap::const_iterator definition = mDefinitions.find(call->getName());
+        if (definition != mDefinitions.end())
+        {
+            TIntermAggregate *parameterList = (*definition->second->getSequence())[0]->getAsAggregate();
+            ASSERT(parameterList && parameterList->getOp() == EOpParameters);
+            parameters = parameterList->getSequence();
+        }
+
+        TIntermSequence *arguments = call->getSequence();
+        for (size_t index = 0; index < arguments->size(); index++)
+        {
+            if (parameters && index < parameters->size())
+            {
+                TQualifier qualifier = (*parameters)[index]->getAsTyped()->getQualifier();
+                if (qualifier != EvqOut && qualifier != EvqInOut)
+                    continue;
+            }
+
+            TIntermTyped *argument = (*arguments)[index]->getAsTyped();
+            if (TIntermSymbol *written = argument ? GetWrittenVariable(argument) : NULL)
+                mUses[written->getId()].writeCount++;
+        }
+    }
+
+    const FunctionDefinitionMap &mDefinitions;
+    VariableUseMap mUses;
+};
+
+//
+// Replaces the reads of variables that are initialized with a constant, and
+// never written after, with the constant, and folds operations, if statements
+// and ternary operators on constants. Variables are always declared before
+// they are read, so a variable found to be constant in a declaration is
+// replaced in the rest of the tree in the same walk.
+//
+class ConstantFolder : public TIntermTraverser
+{
+  public:
+    ConstantFolder(const VariableUseMap &uses)
+        : TIntermTraverser(true, false, true),
+          mUses(uses)
+    {
+    }
+
+    virtual void visitSymbol(TIntermSymbol *node)
+    {
+        ConstantMap::const_iterator constant = mConstants.find(node->getId());
+        if (constant == mConstants.end())
+            return;
+
+        TType type = node->getType();
+        type.setQualifier(EvqConst);
+        TIntermConstantUnion *replacement =
+            new TIntermConstantUnion(constant->second->getUnionArrayPointer(), type);
+        replacement->setLine(node->getLine());
+        getParentNode()->replaceChildNode(node, replacement);
+    }
+
+    virtual bool visitBinary(Visit visit, TIntermBinary *node)
+    {
+        if (visit != PostVisit || !IsFoldableOperator(node->getOp()))
+            return true;
+
+        TIntermConstantUnion *left = node->getLeft()->getAsConstantUnion();
+        TIntermConstantUnion *right = node->getRight()->getAsConstantUnion();
+        if (!left || !right)
+            return true;
+
+        // fold() gets != wrong for vectors that have some equal components
+        if (node->getOp() == EOpNotEqual && left->getType().getObjectSize() > 1)
+            return true;
+
+        replaceWithFolded(node, left->fold(node->getOp(), right, mFoldInfoSink));
+        return true;
+    }
+
+    virtual bool visitUnary(Visit visit, TIntermUnary *node)
+    {
+        if (visit != PostVisit || !IsFoldableOperator(node->getOp()))
+            return true;
+
+        if (TIntermConstantUnion *operand = node->getOperand()->getAsConstantUnion())
+            replaceWithFolded(node, operand->fold(node->getOp(), NULL, mFoldInfoSink));
+        return true;
+    }
+
+    virtual bool visitSelection(Visit visit, TIntermSelection *node)
+    {
+        if (visit != PostVisit)
+            return true;
+
+        TIntermConstantUnion *condition = node->getCondition()->getAsConstantUnion();
+        if (!condition)
+            return true;
+
+        TIntermNode *parent = getParentNode();
+        TIntermNode *taken = condition->getBConst(0) ? node->getTrueBlock() : node->getFalseBlock();
+        if (node->usesTernaryOperator())
+        {
+            parent->replaceChildNode(node, taken);
+        }
+        else if (IsStatement(parent))
+        {
+            if (taken == NULL)
+            {
+                mRemovedStatements.push_back(std::make_pair(parent->getAsAggregate(), node));
+            }
+            else
+            {
+                // Keep the scope of a single statement that declares a variable
+                TIntermAggregate *block = taken->getAsAggregate();
+                if (!block || block->getOp() != EOpSequence)
+                {
+                    block = new TIntermAggregate(EOpSequence);
+                    block->setLine(taken->getLine());
+                    block->getSequence()->push_back(taken);
+                }
+                parent->replaceChildNode(node, block);
+            }
+        }
+        return true;
+    }
+
+    virtual bool visitAggregate(Visit, TIntermAggregate *node)
+    {
+        if (node->getOp() != EOpDeclaration)
+            return true;
+
+        TIntermSequence *declarators = node->getSequence();
+        for (size_t index = 0; index < declarators->size(); index++)
+        {
+            TIntermBinary *initialization = (*declarators)[index]->getAsBinaryNode();
+            if (!initialization)
+                continue;
+
+            incrementDepth(initialization);
+            initialization->getRight()->traverse(this);
+            decrementDepth();
+
+            TIntermSymbol *variable = initialization->getLeft()->getAsSymbolNode();
+            TIntermConstantUnion *constant = initialization->getRight()->getAsConstantUnion();
+            if (variable && constant && isConstantVariable(variable, constant))
+                mConstants[variable->getId()] = constant;
+        }
+        return false;
+    }
+
+    // Removes the if statements that have nothing to run.
+    void removeStatements()
+    {
+        for (size_t index = 0; index < mRemovedStatements.size(); index++)
+        {
+            TIntermSequence *sequence = mRemovedStatements[index].first->getSequence();
+            TIntermSequence::iterator statement =
+                std::find(sequence->begin(), sequence->end(), mRemovedStatements[index].second);
+            ASSERT(statement != sequence->end());
+            sequence->erase(statement);
+        }
+    }
+
+  private:
+    typedef std::map<int, TIntermConstantUnion *> ConstantMap;
+
+    bool isConstantVariable(TIntermSymbol *variable, TIntermConstantUnion *constant) const
+    {
+        if (!IsOptimizableVariable(variable) || variable->isArray() || variable->isMatrix() ||
+            variable->getBasicType() == EbtStruct ||
+            constant->getType().getObjectSize() != variable->getType().getObjectSize())
+        {
+            return false;
+        }
+
+        VariableUseMap::const_iterator use = mUses.find(variable->getId());
+        return use != mUses.end() && use->second.declarationCount == 1 && use->second.writeCount == 0;
+    }
+
+    // fold() reports what it cannot fold, or folds with a different result
+    // than the GPU would, such as a division by zero. Only the results it has
+    // nothing to say about are used.
+    void replaceWithFolded(TIntermTyped *node, TIntermTyped *folded)
+    {
+        if (folded && mFoldInfoSink.info.size() == 0)
+            getParentNode()->replaceChildNode(node, folded);
+        mFoldInfoSink.info.erase();
+    }
+
+    const VariableUseMap &mUses;
+    ConstantMap mConstants;
+    TInfoSink mFoldInfoSink;
+    std::vector<std::pair<TIntermAggregate *, TIntermNode *> > mRemovedStatements;
+};
+
+//
+// Removes the declarations of the variables that are never read, and the
+// assignments to them.
+//
+class DeadStoreRemover : public TIntermTraverser
+{
+  public:
+    DeadStoreRemover(const VariableUseMap &uses)
+        : TIntermTraverser(true, false, false),
+          mUses(uses),
+          mRemovedCount(0)
+    {
+    }
+
+    virtual bool visitAggregate(Visit, TIntermAggregate *node)
+    {
+        if (node->getOp() != EOpSequence)
+            return true;
+
+        TIntermSequence *sequence = node->getSequence();
+        size_t keptCount = 0;
+        for (size_t index = 0; index < sequence->size(); index++)
+        {
+            if (!removeDeadStores((*sequence)[index]))
+                (*sequence)[keptCount++] = (*sequence)[index];
+        }
+        sequence->resize(keptCount);
+        return true;
+    }
+
+    // Returns the number of declarators and statements removed.
+    size_t getRemovedCount() const { return mRemovedCount; }
+
+  private:
+    bool isDead(TIntermNode *node) const
+    {
+        TIntermSymbol *variable = node ? node->getAsSymbolNode() : NULL;
+        if (!variable || !IsOptimizableVariable(variable))
+            return false;
+
+        VariableUseMap::const_iterator use = mUses.find(variable->getId());
+        return use != mUses.end() && use->second.declarationCount > 0 &&
+               use->second.readCount == 0 && use->second.removable;
+    }
+
+    // Removes the dead parts of a statement, and returns whether nothing is
+    // left of it.
+    bool removeDeadStores(TIntermNode *statement)
+    {
+        if (TIntermAggregate *declaration = statement->getAsAggregate())
+        {
+            if (declaration->getOp() != EOpDeclaration)
+                return false;
+
+            TIntermSequence *declarators = declaration->getSequence();
+            size_t keptCount = 0;
+            for (size_t index = 0; index < declarators->size(); index++)
+            {
+                if (!isDead(GetDeclaredVariable((*declarators)[index])))
+                    (*declarators)[keptCount++] = (*declarators)[index];
+            }
+            mRemovedCount += declarators->size() - keptCount;
+            declarators->resize(keptCount);
+            return keptCount == 0;
+        }
+
+        bool dead = false;
+        if (TIntermBinary *binary = statement->getAsBinaryNode())
+            dead = binary->isAssignment() && isDead(binary->getLeft());
+        else if (TIntermUnary *unary = statement->getAsUnaryNode())
+            dead = unary->isAssignment() && isDead(unary->getOperand());
+
+        if (dead)
+            mRemovedCount++;
+        return dead;
+    }
+
+    const VariableUseMap &mUses;
+    size_t mRemovedCount;
+};
+
+}  // namespace anonymous
+
+void OptimizeTree(TIntermNode *root)
+{
+    CallGraphTraverser callGraph;
+    root->traverse(&callGraph);
+
+    VariableUseTraverser uses(callGraph.getDefinitions());
+    root->traverse(&uses);
+    ConstantFolder folder(uses.getUses());
+    root->traverse(&folder);
+    folder.removeStatements();
+
+    // The branches removed by folding can hold the only calls to a function
+    CallGraphTraverser foldedCallGraph;
+    root->traverse(&foldedCallGraph);
+    TIntermAggregate *globals = root->getAsAggregate();
+    if (globals && globals->getOp() == EOpSequence)
+        RemoveUnreachableFunctions(globals, foldedCallGraph.getReachableFunctions());
+
+    // The stores removed from one variable can be the only reads of another
+    size_t removedCount = 0;
+    do
+    {
+        VariableUseTraverser remainingUses(foldedCallGraph.getDefinitions());
+        root->traverse(&remainingUses);
+        DeadStoreRemover remover(remainingUses.getUses());
+        root->traverse(&remover);
+        removedCount = remover.getRemovedCount();
+    } while (removedCount > 0);
+}
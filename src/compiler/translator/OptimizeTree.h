@@ -0,0 +1,29 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// OptimizeTree.h: Shrinks the intermediate tree before it is translated,
+// so that the driver or D3D compiler has less source to compile.
+//
+
+#ifndef COMPILER_TRANSLATOR_OPTIMIZETREE_H_
+#define COMPILER_TRANSLATOR_OPTIMIZETREE_H_
+
+class TIntermNode;
+
+//
+// Runs the passes SH_OPTIMIZE asks for, in this order:
+// - Replaces the reads of scalar and vector variables that are initialized
+//   with a constant, and never written after, with that constant. Folds the
+//   operations on constants this leaves, and the if statements and ternary
+//   operators with constant conditions.
+// - Removes the functions main() does not call, directly or through other
+//   functions, along with their prototypes.
+// - Removes the declarations of local and global variables that are never
+//   read, and the statements that only write them, as long as none of them
+//   has side effects.
+//
+void OptimizeTree(TIntermNode *root);
+
+#endif  // COMPILER_TRANSLATOR_OPTIMIZETREE_H_
@@ -2520,7 +2520,7 @@ TPublicType TParseContext::addStructure(const TSourceLoc& structLine, const TSou
     TStructure* structure = new TStructure(structName, fieldList);
     TType* structureType = new TType(structure);
 
-    structure->setUniqueId(TSymbolTable::nextUniqueId());
+    structure->setUniqueId(symbolTable.nextUniqueId());
 
     if (!structName->empty())
     {
@@ -0,0 +1,296 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PassManager.cpp: Runs the traversers of several passes over the
+// intermediate tree in as few walks as possible.
+//
+
+#include "compiler/translator/PassManager.h"
+
+namespace
+{
+
+typedef unsigned int PassMask;
+
+const size_t kMaxFusedPasses = sizeof(PassMask) * 8;
+
+//
+// Walks the tree on behalf of several traversers. For each node it keeps
+// the passes that entered it, the passes that still want its in- and
+// post-visits, and the passes its remaining children are visited for.
+//
+class FusedTraverser : public TIntermTraverser
+{
+  public:
+    FusedTraverser(TIntermTraverser *const *passes, size_t *visitCounts, size_t passCount, bool inVisit,
+                   bool rightToLeft)
+        : TIntermTraverser(true, inVisit, true, rightToLeft),
+          mPasses(passes),
+          mVisitCounts(visitCounts),
+          mPassCount(passCount),
+          mAllPasses(passCount == kMaxFusedPasses ? ~0u : (1u << passCount) - 1)
+    {
+    }
+
+    virtual void visitSymbol(TIntermSymbol *node)
+    {
+        PassMask passes = childPasses();
+        for (size_t pass = 0; pass < mPassCount; pass++)
+        {
+            if (passes & (1u << pass))
+            {
+                mPasses[pass]->visitSymbol(node);
+                mVisitCounts[pass]++;
+            }
+        }
+    }
+
+    virtual void visitConstantUnion(TIntermConstantUnion *node)
+    {
+        PassMask passes = childPasses();
+        for (size_t pass = 0; pass < mPassCount; pass++)
+        {
+            if (passes & (1u << pass))
+            {
+                mPasses[pass]->visitConstantUnion(node);
+                mVisitCounts[pass]++;
+            }
+        }
+    }
+
+    virtual void visitRaw(TIntermRaw *node)
+    {
+        PassMask passes = childPasses();
+        for (size_t pass = 0; pass < mPassCount; pass++)
+        {
+            if (passes & (1u << pass))
+            {
+                mPasses[pass]->visitRaw(node);
+                mVisitCounts[pass]++;
+            }
+        }
+    }
+
+    virtual bool visitBinary(Visit visit, TIntermBinary *node)
+    {
+        // A failed in-visit of a binary node skips its second child
+        return visitNode(visit, node, &TIntermTraverser::visitBinary, true, true);
+    }
+
+    virtual bool visitUnary(Visit visit, TIntermUnary *node)
+    {
+        return visitNode(visit, node, &TIntermTraverser::visitUnary, true, false);
+    }
+
+    virtual bool visitSelection(Visit visit, TIntermSelection *node)
+    {
+        return visitNode(visit, node, &TIntermTraverser::visitSelection, true, false);
+    }
+
+    virtual bool visitAggregate(Visit visit, TIntermAggregate *node)
+    {
+        return visitNode(visit, node, &TIntermTraverser::visitAggregate, true, false);
+    }
+
+    virtual bool visitLoop(Visit visit, TIntermLoop *node)
+    {
+        return visitNode(visit, node, &TIntermTraverser::visitLoop, true, false);
+    }
+
+    virtual bool visitBranch(Visit visit, TIntermBranch *node)
+    {
+        // Traversals only go down into branches that return a value
+        return visitNode(visit, node, &TIntermTraverser::visitBranch, node->getExpression() != NULL, false);
+    }
+
+  private:
+    struct NodePasses
+    {
+        PassMask entered;
+        PassMask visiting;
+        PassMask children;
+    };
+
+    PassMask childPasses() const
+    {
+        return mNodePasses.empty() ? mAllPasses : mNodePasses.back().children;
+    }
+
+    template <typename T>
+    bool visitNode(Visit visit, T *node, bool (TIntermTraverser::*visitFunction)(Visit, T *),
+                   bool entersNode, bool inVisitSkipsChildren)
+    {
+        switch (visit)
+        {
+          case PreVisit:
+            {
+                PassMask passes = childPasses();
+                PassMask entered = 0;
+                for (size_t pass = 0; pass < mPassCount; pass++)
+                {
+                    if (!(passes & (1u << pass)))
+                        continue;
+
+                    TIntermTraverser *traverser = mPasses[pass];
+                    bool visitChildren = true;
+                    if (traverser->preVisit)
+                    {
+                        visitChildren = (traverser->*visitFunction)(PreVisit, node);
+                        mVisitCounts[pass]++;
+                    }
+
+                    if (visitChildren)
+                    {
+                        entered |= (1u << pass);
+                        if (entersNode)
+                            traverser->incrementDepth(node);
+                    }
+                }
+
+                // Skip the subtree if no pass wants it
+                if (entered == 0)
+                    return false;
+
+                NodePasses nodePasses = { entered, entered, entered };
+                mNodePasses.push_back(nodePasses);
+            }
+            return true;
+
+          case InVisit:
+            {
+                NodePasses &nodePasses = mNodePasses.back();
+                for (size_t pass = 0; pass < mPassCount; pass++)
+                {
+                    TIntermTraverser *traverser = mPasses[pass];
+                    if ((nodePasses.visiting & (1u << pass)) && traverser->inVisit)
+                    {
+                        mVisitCounts[pass]++;
+                        if (!(traverser->*visitFunction)(InVisit, node))
+                        {
+                            nodePasses.visiting &= ~(1u << pass);
+                            if (inVisitSkipsChildren)
+                                nodePasses.children &= ~(1u << pass);
+                        }
+                    }
+                }
+            }
+            return true;
+
+          case PostVisit:
+            {
+                NodePasses nodePasses = mNodePasses.back();
+                mNodePasses.pop_back();
+                for (size_t pass = 0; pass < mPassCount; pass++)
+                {
+                    if (!(nodePasses.entered & (1u << pass)))
+                        continue;
+
+                    TIntermTraverser *traverser = mPasses[pass];
+                    if (entersNode)
+                        traverser->decrementDepth();
+
+                    if ((nodePasses.visiting & (1u << pass)) && traverser->postVisit)
+                    {
+                        (traverser->*visitFunction)(PostVisit, node);
+                        mVisitCounts[pass]++;
+                    }
+                }
+            }
+            return true;
+
+          default:
+            UNREACHABLE();
+            return false;
+        }
+    }
+
+    TIntermTraverser *const *mPasses;
+    size_t *mVisitCounts;
+    size_t mPassCount;
+    PassMask mAllPasses;
+
+    // The passes of every node from the root to the current one.
+    TVector<NodePasses> mNodePasses;
+};
+
+}  // namespace anonymous
+
+TPassManager::TPassManager()
+    : mWalkCount(0)
+{
+}
+
+void TPassManager::addPass(TIntermTraverser *traverser, ShCompilePhase phase)
+{
+    Pass pass = { traverser, phase, 0 };
+    mPasses.push_back(pass);
+}
+
+void TPassManager::run(TIntermNode *root)
+{
+    // One walk for the passes in each direction, unless there are too many
+    // of them to keep track of at once.
+    for (int rightToLeft = 0; rightToLeft < 2; rightToLeft++)
+    {
+        std::vector<size_t> passIndices;
+        for (size_t passIndex = 0; passIndex < mPasses.size(); passIndex++)
+        {
+            if (mPasses[passIndex].traverser->rightToLeft == (rightToLeft != 0))
+            {
+                passIndices.push_back(passIndex);
+                if (passIndices.size() == kMaxFusedPasses)
+                {
+                    walk(root, passIndices);
+                    passIndices.clear();
+                }
+            }
+        }
+
+        if (!passIndices.empty())
+            walk(root, passIndices);
+    }
+}
+
+void TPassManager::walk(TIntermNode *root, const std::vector<size_t> &passIndices)
+{
+    TIntermTraverser *traversers[kMaxFusedPasses];
+    size_t visitCounts[kMaxFusedPasses] = { 0 };
+    bool inVisit = false;
+    for (size_t pass = 0; pass < passIndices.size(); pass++)
+    {
+        traversers[pass] = mPasses[passIndices[pass]].traverser;
+        inVisit = inVisit || traversers[pass]->inVisit;
+    }
+
+    FusedTraverser fused(traversers, visitCounts, passIndices.size(), inVisit,
+                         traversers[0]->rightToLeft);
+    root->traverse(&fused);
+    mWalkCount++;
+
+    for (size_t pass = 0; pass < passIndices.size(); pass++)
+    {
+        mPasses[passIndices[pass]].visitCount += visitCounts[pass];
+    }
+}
+
+void TPassManager::chargePhases(double microseconds, double *phaseMicroseconds) const
+{
+    if (mPasses.empty())
+        return;
+
+    size_t totalVisitCount = 0;
+    for (size_t passIndex = 0; passIndex < mPasses.size(); passIndex++)
+    {
+        totalVisitCount += mPasses[passIndex].visitCount;
+    }
+
+    for (size_t passIndex = 0; passIndex < mPasses.size(); passIndex++)
+    {
+        const Pass &pass = mPasses[passIndex];
+        double share = totalVisitCount > 0 ? static_cast<double>(pass.visitCount) / totalVisitCount
+                                           : 1.0 / mPasses.size();
+        phaseMicroseconds[pass.phase] += microseconds * share;
+    }
+}
@@ -0,0 +1,56 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PassManager.h: Runs the traversers of several passes over the
+// intermediate tree in as few walks as possible.
+//
+
+#ifndef COMPILER_TRANSLATOR_PASSMANAGER_H_
+#define COMPILER_TRANSLATOR_PASSMANAGER_H_
+
+#include "compiler/translator/IntermNode.h"
+
+#include <vector>
+
+//
+// The passes given to a pass manager must only read the tree, or mark its
+// nodes, and must not depend on each other's results. Passes that traverse
+// in the same direction share one walk. Each still gets the visits its own
+// preVisit, inVisit and postVisit flags ask for, at its own depths, and
+// cutting off a subtree from a visit only cuts it off for that pass.
+//
+class TPassManager
+{
+  public:
+    TPassManager();
+
+    // Adds a pass to the next run. Its share of the walk is charged to |phase|.
+    void addPass(TIntermTraverser *traverser, ShCompilePhase phase);
+
+    // Walks the tree for all the passes added.
+    void run(TIntermNode *root);
+
+    // Returns the number of walks the run made.
+    size_t getWalkCount() const { return mWalkCount; }
+
+    // Splits the time of the run between the phases of its passes, in
+    // proportion to the visits each pass made.
+    void chargePhases(double microseconds, double *phaseMicroseconds) const;
+
+  private:
+    struct Pass
+    {
+        TIntermTraverser *traverser;
+        ShCompilePhase phase;
+        size_t visitCount;
+    };
+
+    void walk(TIntermNode *root, const std::vector<size_t> &passIndices);
+
+    std::vector<Pass> mPasses;
+    size_t mWalkCount;
+};
+
+#endif  // COMPILER_TRANSLATOR_PASSMANAGER_H_
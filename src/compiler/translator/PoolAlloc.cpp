@@ -16,6 +16,12 @@
 #include <stdio.h>
 #include <assert.h>
 
+#include <atomic>
+
+#if defined(ANGLE_PLATFORM_POSIX)
+#include <sys/mman.h>
+#endif
+
 TLSIndex PoolIndex = TLS_INVALID_INDEX;
 
 bool InitializePoolIndex()
@@ -46,6 +52,168 @@ void SetGlobalPoolAllocator(TPoolAllocator* poolAllocator)
     SetTLSValue(PoolIndex, poolAllocator);
 }
 
+namespace {
+
+// Cached blocks are kMinClassSize << sizeClass bytes, for sizeClass below
+// kClassCount, with up to kSlotCount blocks of each size.
+const size_t kMinClassSize = 4 * 1024;
+const int kClassCount = 7;
+const int kSlotCount = 32;
+
+const size_t kHugePageSize = 2 * 1024 * 1024;
+
+std::atomic<void*> cachedBlocks[kClassCount][kSlotCount];
+std::atomic<bool> cacheEnabled(true);
+std::atomic<bool> hugePagesEnabled(false);
+
+std::atomic<size_t> cacheHitCount(0);
+std::atomic<size_t> cacheMissCount(0);
+std::atomic<size_t> cachedBytes(0);
+
+int GetSizeClass(size_t size)
+{
+    size_t classSize = kMinClassSize;
+    for (int sizeClass = 0; sizeClass < kClassCount; sizeClass++, classSize <<= 1) {
+        if (size <= classSize)
+            return sizeClass;
+    }
+    return -1;
+}
+
+void* AllocateHugePages(size_t size)
+{
+#if defined(ANGLE_PLATFORM_WINDOWS) && !defined(ANGLE_ENABLE_WINDOWS_STORE)
+    SIZE_T largePageSize = GetLargePageMinimum();
+    if (largePageSize != 0 && size % largePageSize == 0) {
+        void* memory = VirtualAlloc(NULL, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+        if (memory)
+            return memory;
+    }
+    // Large pages need the lock pages in memory privilege, which most
+    // processes do not hold.
+    return NULL;
+#elif defined(ANGLE_PLATFORM_LINUX) && defined(MADV_HUGEPAGE)
+    void* memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED)
+        return NULL;
+    // Transparent huge pages back the mapping once the kernel finds them.
+    madvise(memory, size, MADV_HUGEPAGE);
+    return memory;
+#else
+    return NULL;
+#endif
+}
+
+void FreeHugePages(void* memory, size_t size)
+{
+#if defined(ANGLE_PLATFORM_WINDOWS) && !defined(ANGLE_ENABLE_WINDOWS_STORE)
+    VirtualFree(memory, 0, MEM_RELEASE);
+#elif defined(ANGLE_PLATFORM_LINUX) && defined(MADV_HUGEPAGE)
+    munmap(memory, size);
+#else
+    assert(0 && "PoolAlloc: No huge pages on this platform");
+#endif
+}
+
+}
+
+//
+// Implement the functionality of the TPoolPageCache class, which
+// is documented in PoolAlloc.h.
+//
+TPoolBlock TPoolPageCache::Allocate(size_t size)
+{
+    TPoolBlock block = { 0, size, false, false };
+
+    int sizeClass = GetSizeClass(size);
+    if (sizeClass >= 0) {
+        block.size = kMinClassSize << sizeClass;
+        if (cacheEnabled.load(std::memory_order_relaxed)) {
+            for (int slot = 0; slot < kSlotCount; slot++) {
+                std::atomic<void*>& entry = cachedBlocks[sizeClass][slot];
+                if (entry.load(std::memory_order_relaxed) == 0)
+                    continue;
+
+                block.memory = entry.exchange(0, std::memory_order_acquire);
+                if (block.memory) {
+                    block.reused = true;
+                    cachedBytes -= block.size;
+                    ++cacheHitCount;
+                    return block;
+                }
+            }
+        }
+        ++cacheMissCount;
+    } else if (size >= kHugePageSize && hugePagesEnabled.load(std::memory_order_relaxed)) {
+        size_t hugeSize = (size + kHugePageSize - 1) & ~(kHugePageSize - 1);
+        block.memory = AllocateHugePages(hugeSize);
+        if (block.memory) {
+            block.size = hugeSize;
+            block.hugePages = true;
+            return block;
+        }
+    }
+
+    block.memory = ::new char[block.size];
+    return block;
+}
+
+void TPoolPageCache::Free(void* memory, size_t size, bool hugePages)
+{
+    if (hugePages) {
+        FreeHugePages(memory, size);
+        return;
+    }
+
+    int sizeClass = GetSizeClass(size);
+    if (sizeClass >= 0 && (kMinClassSize << sizeClass) == size && cacheEnabled.load(std::memory_order_relaxed)) {
+        for (int slot = 0; slot < kSlotCount; slot++) {
+            std::atomic<void*>& entry = cachedBlocks[sizeClass][slot];
+            void* empty = 0;
+            if (entry.load(std::memory_order_relaxed) == 0 &&
+                entry.compare_exchange_strong(empty, memory, std::memory_order_release)) {
+                cachedBytes += size;
+                return;
+            }
+        }
+    }
+
+    // The cache is full, disabled, or does not hold blocks of this size
+    delete [] static_cast<char*>(memory);
+}
+
+void TPoolPageCache::Trim()
+{
+    for (int sizeClass = 0; sizeClass < kClassCount; sizeClass++) {
+        for (int slot = 0; slot < kSlotCount; slot++) {
+            void* memory = cachedBlocks[sizeClass][slot].exchange(0, std::memory_order_acquire);
+            if (memory) {
+                cachedBytes -= kMinClassSize << sizeClass;
+                delete [] static_cast<char*>(memory);
+            }
+        }
+    }
+}
+
+void TPoolPageCache::SetEnabled(bool enabled)
+{
+    cacheEnabled = enabled;
+}
+
+void TPoolPageCache::SetHugePagesEnabled(bool enabled)
+{
+    hugePagesEnabled = enabled;
+}
+
+TPoolPageCacheStatistics TPoolPageCache::GetStatistics()
+{
+    TPoolPageCacheStatistics statistics;
+    statistics.hitCount = cacheHitCount;
+    statistics.missCount = cacheMissCount;
+    statistics.cachedBytes = cachedBytes;
+    return statistics;
+}
+
 //
 // Implement the functionality of the TPoolAllocator class, which
 // is documented in PoolAlloc.h.
@@ -56,7 +224,10 @@ TPoolAllocator::TPoolAllocator(int growthIncrement, int allocationAlignment) :
     freeList(0),
     inUseList(0),
     numCalls(0),
-    totalBytes(0)
+    totalBytes(0),
+    inUseBytes(0),
+    pageCount(0),
+    reusedPageCount(0)
 {
     //
     // Don't allow page sizes we know are smaller than all common
@@ -98,8 +269,10 @@ TPoolAllocator::~TPoolAllocator()
 {
     while (inUseList) {
         tHeader* next = inUseList->nextPage;
+        size_t blockSize = inUseList->blockSize;
+        bool hugePages = inUseList->hugePages;
         inUseList->~tHeader();
-        delete [] reinterpret_cast<char*>(inUseList);
+        TPoolPageCache::Free(inUseList, blockSize, hugePages);
         inUseList = next;
     }
 
@@ -109,7 +282,7 @@ TPoolAllocator::~TPoolAllocator()
     //
     while (freeList) {
         tHeader* next = freeList->nextPage;
-        delete [] reinterpret_cast<char*>(freeList);
+        TPoolPageCache::Free(freeList, freeList->blockSize, freeList->hugePages);
         freeList = next;
     }
 }
@@ -182,8 +355,9 @@ void TPoolAllocator::pop()
         inUseList->~tHeader();
         
         tHeader* nextInUse = inUseList->nextPage;
+        inUseBytes -= inUseList->pageCount * pageSize;
         if (inUseList->pageCount > 1)
-            delete [] reinterpret_cast<char*>(inUseList);
+            TPoolPageCache::Free(inUseList, inUseList->blockSize, inUseList->hugePages);
         else {
             inUseList->nextPage = freeList;
             freeList = inUseList;
@@ -247,13 +421,18 @@ void* TPoolAllocator::allocate(size_t numBytes)
         if (numBytesToAlloc < allocationSize)
             return 0;
 
-        tHeader* memory = reinterpret_cast<tHeader*>(::new char[numBytesToAlloc]);
+        TPoolBlock block = TPoolPageCache::Allocate(numBytesToAlloc);
+        tHeader* memory = reinterpret_cast<tHeader*>(block.memory);
         if (memory == 0)
             return 0;
 
         // Use placement-new to initialize header
-        new(memory) tHeader(inUseList, (numBytesToAlloc + pageSize - 1) / pageSize);
+        new(memory) tHeader(inUseList, (numBytesToAlloc + pageSize - 1) / pageSize, block.size, block.hugePages);
         inUseList = memory;
+        inUseBytes += memory->pageCount * pageSize;
+        pageCount += memory->pageCount;
+        if (block.reused)
+            reusedPageCount += memory->pageCount;
 
         currentPageOffset = pageSize;  // make next allocation come from a new page
 
@@ -265,18 +444,27 @@ void* TPoolAllocator::allocate(size_t numBytes)
     // Need a simple page to allocate from.
     //
     tHeader* memory;
+    TPoolBlock block;
     if (freeList) {
         memory = freeList;
         freeList = freeList->nextPage;
+        block.size = memory->blockSize;
+        block.hugePages = memory->hugePages;
+        block.reused = true;
     } else {
-        memory = reinterpret_cast<tHeader*>(::new char[pageSize]);
+        block = TPoolPageCache::Allocate(pageSize);
+        memory = reinterpret_cast<tHeader*>(block.memory);
         if (memory == 0)
             return 0;
     }
 
     // Use placement-new to initialize header
-    new(memory) tHeader(inUseList, 1);
+    new(memory) tHeader(inUseList, 1, block.size, block.hugePages);
     inUseList = memory;
+    inUseBytes += pageSize;
+    ++pageCount;
+    if (block.reused)
+        ++reusedPageCount;
     
     unsigned char* ret = reinterpret_cast<unsigned char *>(inUseList) + headerSkip;
     currentPageOffset = (headerSkip + allocationSize + alignmentMask) & ~alignmentMask;
@@ -99,6 +99,55 @@ private:
 #endif
 };
 
+//
+// Process-wide cache of the blocks of memory that pools obtain from the OS.
+// A pool that is done with a block gives it to the cache rather than freeing
+// it, and a pool that needs one takes it from the cache first, so compiles on
+// new compilers or on other threads reuse the memory of earlier ones.
+//
+// Cached blocks are sorted into power of 2 size classes from 4KB to 256KB,
+// and each class is a fixed array of slots that blocks are exchanged in and
+// out of atomically, so the cache needs no lock.  Blocks larger than the
+// largest class are not cached, and can instead be backed by huge pages.
+//
+struct TPoolBlock {
+    void* memory;
+    size_t size;            // size of the block, rounded up to its size class
+    bool hugePages;         // mapped from the OS as huge pages
+    bool reused;            // taken from the cache rather than the OS
+};
+
+struct TPoolPageCacheStatistics {
+    size_t hitCount;        // blocks taken from the cache
+    size_t missCount;       // blocks of a cached size obtained from the OS
+    size_t cachedBytes;     // bytes currently held by the cache
+};
+
+class TPoolPageCache {
+public:
+    static TPoolBlock Allocate(size_t size);
+    static void Free(void* memory, size_t size, bool hugePages);
+
+    //
+    // Frees every cached block.
+    //
+    static void Trim();
+
+    //
+    // The cache is enabled by default.  Disabling it does not free the
+    // blocks already cached.
+    //
+    static void SetEnabled(bool enabled);
+
+    //
+    // Blocks of 2MB and more are mapped as huge pages where the OS allows it,
+    // which cuts the TLB misses of walking very large trees.  Off by default.
+    //
+    static void SetHugePagesEnabled(bool enabled);
+
+    static TPoolPageCacheStatistics GetStatistics();
+};
+
 //
 // There are several stacks.  One is to track the pushing and popping
 // of the user, and not yet implemented.  The others are simply a 
@@ -106,8 +155,8 @@ private:
 //
 // Page stacks are linked together with a simple header at the beginning
 // of each allocation obtained from the underlying OS.  Multi-page allocations
-// are returned to the OS.  Individual page allocations are kept for future
-// re-use.
+// are returned to the page cache.  Individual page allocations are kept for
+// future re-use, and returned to the page cache when the pool is destroyed.
 //
 // The "page size" used is not, nor must it match, the underlying OS
 // page size.  But, having it be about that size or equal to a set of 
@@ -145,6 +194,30 @@ public:
     //
     void* allocate(size_t numBytes);
 
+    //
+    // Number of bytes handed out by allocate() over the life of the pool.
+    //
+    size_t getTotalBytes() const { return totalBytes; }
+
+    //
+    // Number of allocate() calls over the life of the pool.
+    //
+    size_t getAllocationCount() const { return numCalls; }
+
+    //
+    // Bytes of memory obtained from the OS that currently hold allocations.
+    // Pages kept for re-use after a pop() are not counted.
+    //
+    size_t getInUseBytes() const { return inUseBytes; }
+
+    //
+    // Pages taken for allocations over the life of the pool, and how many of
+    // them were re-used from the pool's free list or the page cache rather
+    // than obtained from the OS.
+    //
+    size_t getPageCount() const { return pageCount; }
+    size_t getReusedPageCount() const { return reusedPageCount; }
+
     //
     // There is no deallocate.  The point of this class is that
     // deallocation can be skipped by the user of it, as the model
@@ -156,9 +229,11 @@ protected:
     friend struct tHeader;
     
     struct tHeader {
-        tHeader(tHeader* nextPage, size_t pageCount) :
+        tHeader(tHeader* nextPage, size_t pageCount, size_t blockSize, bool hugePages) :
             nextPage(nextPage),
-            pageCount(pageCount)
+            pageCount(pageCount),
+            blockSize(blockSize),
+            hugePages(hugePages)
 #ifdef GUARD_BLOCKS
           , lastAllocation(0)
 #endif
@@ -173,6 +248,8 @@ protected:
 
         tHeader* nextPage;
         size_t pageCount;
+        size_t blockSize;   // size of the block from the page cache
+        bool hugePages;
 #ifdef GUARD_BLOCKS
         TAllocation* lastAllocation;
 #endif
@@ -208,6 +285,9 @@ protected:
 
     int numCalls;           // just an interesting statistic
     size_t totalBytes;      // just an interesting statistic
+    size_t inUseBytes;      // size of the pages in inUseList
+    size_t pageCount;       // just an interesting statistic
+    size_t reusedPageCount; // just an interesting statistic
 private:
     TPoolAllocator& operator=(const TPoolAllocator&);  // dont allow assignment operator
     TPoolAllocator(const TPoolAllocator&);  // dont allow default copy constructor
@@ -260,6 +340,14 @@ public:
     template<class Other>
     pool_allocator(const pool_allocator<Other>& p) : allocator(&p.getAllocator()) { }
 
+    // Copies of a container allocate from the current global pool rather than
+    // from the pool of the original, so copying from a long-lived pool such as
+    // the shared built-in symbol table does not grow it.
+    pool_allocator<T> select_on_container_copy_construction() const {
+        TPoolAllocator* globalAllocator = GetGlobalPoolAllocator();
+        return globalAllocator ? pool_allocator<T>(*globalAllocator) : *this;
+    }
+
 #if defined(__SUNPRO_CC) && !defined(_RWSTD_ALLOCATOR)
     // libCStd on some platforms have a different allocate/deallocate interface.
     // Caller pre-bakes sizeof(T) into 'n' which is the number of bytes to be
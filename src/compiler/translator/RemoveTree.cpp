@@ -10,9 +10,10 @@
 //
 // Code to delete the intermediate tree.
 //
-void RemoveAllTreeNodes(TIntermNode* root)
+size_t RemoveAllTreeNodes(TIntermNode* root)
 {
     std::queue<TIntermNode*> nodeQueue;
+    size_t nodeCount = 0;
 
     nodeQueue.push(root);
 
@@ -24,6 +25,9 @@ void RemoveAllTreeNodes(TIntermNode* root)
         node->enqueueChildren(&nodeQueue);
 
         delete node;
+        nodeCount++;
     }
+
+    return nodeCount;
 }
 
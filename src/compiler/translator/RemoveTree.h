@@ -4,4 +4,5 @@
 // found in the LICENSE file.
 //
 
-void RemoveAllTreeNodes(TIntermNode*);
+// Deletes every node of the tree and returns how many there were.
+size_t RemoveAllTreeNodes(TIntermNode*);
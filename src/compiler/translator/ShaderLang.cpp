@@ -14,10 +14,16 @@
 #include "compiler/translator/Compiler.h"
 #include "compiler/translator/InitializeDll.h"
 #include "compiler/translator/length_limits.h"
+#include "compiler/translator/TranslationCache.h"
 #include "compiler/translator/TranslatorHLSL.h"
 #include "compiler/translator/VariablePacker.h"
+#include "common/WorkerPool.h"
 #include "angle_gl.h"
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
 namespace
 {
 
@@ -32,6 +38,37 @@ enum ShaderVariableType
     
 bool isInitialized = false;
 
+TranslationCache *translationCache = NULL;
+
+// Threads used by ShCompileBatch, created by the first batch
+gl::WorkerPool *compileWorkerPool = NULL;
+std::mutex compileWorkerPoolMutex;
+
+struct CompileBatch
+{
+    ShCompileJob *jobs;
+    size_t numJobs;
+
+    // Jobs are handed out one at a time since compile times vary a lot
+    std::atomic<size_t> nextJob;
+    std::atomic<bool> allSucceeded;
+};
+
+void CompileBatchJobs(size_t, size_t, void *userData)
+{
+    CompileBatch *batch = static_cast<CompileBatch *>(userData);
+
+    for (size_t jobIndex = batch->nextJob++; jobIndex < batch->numJobs; jobIndex = batch->nextJob++)
+    {
+        ShCompileJob &job = batch->jobs[jobIndex];
+        job.success = ShCompile(job.handle, job.shaderStrings, job.numStrings, job.compileOptions);
+        if (!job.success)
+        {
+            batch->allSucceeded = false;
+        }
+    }
+}
+
 //
 // This is the platform independent interface between an OGL driver
 // and the shading language compiler.
@@ -125,6 +162,13 @@ bool ShFinalize()
         DetachProcess();
         isInitialized = false;
     }
+
+    SafeDelete(translationCache);
+
+    std::lock_guard<std::mutex> lock(compileWorkerPoolMutex);
+    SafeDelete(compileWorkerPool);
+
+    TPoolPageCache::Trim();
     return true;
 }
 
@@ -229,7 +273,141 @@ bool ShCompile(
     TCompiler *compiler = GetCompilerFromHandle(handle);
     ASSERT(compiler);
 
-    return compiler->compile(shaderStrings, numStrings, compileOptions);
+    TranslationCacheKey key;
+    if (translationCache == NULL ||
+        !TranslationCache::ComputeKey(compiler, shaderStrings, numStrings, compileOptions, &key))
+    {
+        return compiler->compile(shaderStrings, numStrings, compileOptions);
+    }
+
+    bool success = false;
+    if (translationCache->load(key, compiler, &success))
+    {
+        return success;
+    }
+
+    success = compiler->compile(shaderStrings, numStrings, compileOptions);
+    translationCache->store(key, compiler, success);
+    return success;
+}
+
+bool ShCompileBatch(
+    ShCompileJob *jobs,
+    size_t numJobs,
+    size_t maxThreads)
+{
+    ASSERT(jobs || numJobs == 0);
+
+    // Each compiler keeps its results, so two jobs cannot share one
+    std::vector<ShHandle> handles(numJobs);
+    for (size_t jobIndex = 0; jobIndex < numJobs; jobIndex++)
+    {
+        handles[jobIndex] = jobs[jobIndex].handle;
+        jobs[jobIndex].success = false;
+    }
+    std::sort(handles.begin(), handles.end());
+    if (std::adjacent_find(handles.begin(), handles.end()) != handles.end())
+    {
+        return false;
+    }
+
+    CompileBatch batch;
+    batch.jobs = jobs;
+    batch.numJobs = numJobs;
+    batch.nextJob = 0;
+    batch.allSucceeded = true;
+
+    size_t threadCount = (maxThreads > 0 ? maxThreads : gl::WorkerPool::GetHardwareThreadCount());
+    threadCount = std::min(threadCount, numJobs);
+    if (threadCount <= 1)
+    {
+        CompileBatchJobs(0, 1, &batch);
+        return batch.allSucceeded;
+    }
+
+    std::lock_guard<std::mutex> lock(compileWorkerPoolMutex);
+    if (compileWorkerPool == NULL)
+    {
+        compileWorkerPool = new gl::WorkerPool(gl::WorkerPool::GetHardwareThreadCount());
+    }
+
+    // One range per thread, each of which keeps taking jobs until none are left
+    compileWorkerPool->parallelFor(threadCount, 1, CompileBatchJobs, &batch);
+    return batch.allSucceeded;
+}
+
+bool ShSetTranslationCacheFile(const char *fileName)
+{
+    SafeDelete(translationCache);
+
+    if (fileName == NULL)
+    {
+        return true;
+    }
+
+    translationCache = new TranslationCache();
+    if (!translationCache->open(fileName))
+    {
+        SafeDelete(translationCache);
+        return false;
+    }
+
+    return true;
+}
+
+void ShGetTranslationCacheStatistics(size_t *hitCount, size_t *missCount)
+{
+    ASSERT(hitCount && missCount);
+
+    *hitCount = (translationCache ? translationCache->getHitCount() : 0);
+    *missCount = (translationCache ? translationCache->getMissCount() : 0);
+}
+
+void ShGetPoolPageCacheStatistics(size_t *hitCount, size_t *missCount, size_t *cachedBytes)
+{
+    ASSERT(hitCount && missCount && cachedBytes);
+
+    TPoolPageCacheStatistics statistics = TPoolPageCache::GetStatistics();
+    *hitCount = statistics.hitCount;
+    *missCount = statistics.missCount;
+    *cachedBytes = statistics.cachedBytes;
+}
+
+void ShSetPoolHugePagesEnabled(bool enabled)
+{
+    TPoolPageCache::SetHugePagesEnabled(enabled);
+}
+
+bool ShGetCompileStatistics(const ShHandle handle, ShCompileStatistics *statistics)
+{
+    TCompiler *compiler = GetCompilerFromHandle(handle);
+    if (!compiler || !statistics)
+        return false;
+
+    *statistics = compiler->getStatistics();
+    return true;
+}
+
+const char *ShGetCompilePhaseName(ShCompilePhase phase)
+{
+    switch (phase)
+    {
+      case SH_COMPILE_PHASE_PARSE:                        return "parse";
+      case SH_COMPILE_PHASE_POST_PROCESS:                 return "post process";
+      case SH_COMPILE_PHASE_LIMIT_EXPRESSION_COMPLEXITY:  return "limit expression complexity";
+      case SH_COMPILE_PHASE_DETECT_CALL_DEPTH:            return "detect call depth";
+      case SH_COMPILE_PHASE_VALIDATE_OUTPUTS:             return "validate outputs";
+      case SH_COMPILE_PHASE_VALIDATE_LIMITATIONS:         return "validate limitations";
+      case SH_COMPILE_PHASE_TIMING_RESTRICTIONS:          return "timing restrictions";
+      case SH_COMPILE_PHASE_UNROLL_FOR_LOOPS:             return "unroll for loops";
+      case SH_COMPILE_PHASE_EMULATE_BUILT_IN_FUNCTIONS:   return "emulate built-in functions";
+      case SH_COMPILE_PHASE_CLAMP_ARRAY_BOUNDS:           return "clamp array bounds";
+      case SH_COMPILE_PHASE_REWRITE_TREE:                 return "rewrite tree";
+      case SH_COMPILE_PHASE_OPTIMIZE:                     return "optimize";
+      case SH_COMPILE_PHASE_COLLECT_VARIABLES:            return "collect variables";
+      case SH_COMPILE_PHASE_TRANSLATE:                    return "translate";
+      default:                                            return NULL;
+    }
 }
 
 int ShGetShaderVersion(const ShHandle handle)
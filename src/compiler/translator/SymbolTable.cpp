@@ -15,11 +15,10 @@
 
 #include "compiler/translator/SymbolTable.h"
 
+#include <stdint.h>
 #include <stdio.h>
 #include <algorithm>
 
-int TSymbolTable::uniqueIdCounter = 0;
-
 //
 // Functions have buried pointers to delete.
 //
@@ -29,32 +28,167 @@ TFunction::~TFunction()
         delete (*i).type;
 }
 
+namespace
+{
+
+// Starting capacity of the hash tables, which are kept at most half full.
+const size_t kInitialTableSize = 16;
+
+size_t HashAtom(const TString *atom)
+{
+    // Pool allocations are aligned, so the low bits carry no information
+    size_t value = static_cast<size_t>(reinterpret_cast<uintptr_t>(atom) >> 4);
+    value ^= value >> 15;
+    value *= 0x2c1b3c6dU;
+    value ^= value >> 12;
+    return value;
+}
+
+}
+
+size_t TAtomTable::Hash(const TString &name)
+{
+    // FNV-1a
+    size_t hash = 2166136261U;
+    for (size_t index = 0; index < name.size(); index++)
+    {
+        hash ^= static_cast<unsigned char>(name[index]);
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+const TString *TAtomTable::find(const TString &name, size_t hash, size_t *probeCount) const
+{
+    if (mEntries.empty())
+        return NULL;
+
+    size_t mask = mEntries.size() - 1;
+    for (size_t index = hash & mask; ; index = (index + 1) & mask)
+    {
+        (*probeCount)++;
+        const Entry &entry = mEntries[index];
+        if (entry.atom == NULL)
+            return NULL;
+        if (entry.hash == hash && *entry.atom == name)
+            return entry.atom;
+    }
+}
+
+const TString *TAtomTable::insert(const TString &name, size_t hash)
+{
+    if ((mCount + 1) * 2 > mEntries.size())
+        grow();
+
+    size_t mask = mEntries.size() - 1;
+    size_t index = hash & mask;
+    while (mEntries[index].atom != NULL)
+    {
+        assert(mEntries[index].hash != hash || *mEntries[index].atom != name);
+        index = (index + 1) & mask;
+    }
+
+    mEntries[index].hash = hash;
+    mEntries[index].atom = NewPoolTString(name.c_str());
+    mCount++;
+    return mEntries[index].atom;
+}
+
+void TAtomTable::clear()
+{
+    mEntries.clear();
+    mCount = 0;
+}
+
+void TAtomTable::grow()
+{
+    std::vector<Entry> entries(mEntries.empty() ? kInitialTableSize : mEntries.size() * 2);
+    Entry empty = { 0, NULL };
+    std::fill(entries.begin(), entries.end(), empty);
+
+    size_t mask = entries.size() - 1;
+    for (size_t oldIndex = 0; oldIndex < mEntries.size(); oldIndex++)
+    {
+        const Entry &entry = mEntries[oldIndex];
+        if (entry.atom == NULL)
+            continue;
+
+        size_t index = entry.hash & mask;
+        while (entries[index].atom != NULL)
+            index = (index + 1) & mask;
+        entries[index] = entry;
+    }
+
+    mEntries.swap(entries);
+}
+
 //
-// Symbol table levels are a map of pointers to symbols that have to be deleted.
+// Symbol table levels are a hash table of pointers to symbols that have to be deleted.
 //
 TSymbolTableLevel::~TSymbolTableLevel()
 {
-    for (tLevel::iterator it = level.begin(); it != level.end(); ++it)
-        delete (*it).second;
+    for (size_t index = 0; index < mEntries.size(); index++)
+        delete mEntries[index].symbol;
 }
 
-bool TSymbolTableLevel::insert(TSymbol *symbol)
+bool TSymbolTableLevel::insert(const TString *atom, TSymbol *symbol)
 {
-    symbol->setUniqueId(TSymbolTable::nextUniqueId());
+    if ((mCount + 1) * 2 > mEntries.size())
+        grow();
 
-    // returning true means symbol was added to the table
-    tInsertResult result = level.insert(tLevelPair(symbol->getMangledName(), symbol));
+    size_t mask = mEntries.size() - 1;
+    size_t index = HashAtom(atom) & mask;
+    while (mEntries[index].atom != NULL)
+    {
+        // returning true means symbol was added to the table
+        if (mEntries[index].atom == atom)
+            return false;
+        index = (index + 1) & mask;
+    }
 
-    return result.second;
+    mEntries[index].atom = atom;
+    mEntries[index].symbol = symbol;
+    mCount++;
+    return true;
 }
 
-TSymbol *TSymbolTableLevel::find(const TString &name) const
+TSymbol *TSymbolTableLevel::find(const TString *atom, size_t *probeCount) const
 {
-    tLevel::const_iterator it = level.find(name);
-    if (it == level.end())
+    if (mCount == 0)
         return 0;
-    else
-        return (*it).second;
+
+    size_t mask = mEntries.size() - 1;
+    for (size_t index = HashAtom(atom) & mask; ; index = (index + 1) & mask)
+    {
+        (*probeCount)++;
+        const Entry &entry = mEntries[index];
+        if (entry.atom == atom)
+            return entry.symbol;
+        if (entry.atom == NULL)
+            return 0;
+    }
+}
+
+void TSymbolTableLevel::grow()
+{
+    std::vector<Entry> entries(mEntries.empty() ? kInitialTableSize : mEntries.size() * 2);
+    Entry empty = { NULL, NULL };
+    std::fill(entries.begin(), entries.end(), empty);
+
+    size_t mask = entries.size() - 1;
+    for (size_t oldIndex = 0; oldIndex < mEntries.size(); oldIndex++)
+    {
+        const Entry &entry = mEntries[oldIndex];
+        if (entry.atom == NULL)
+            continue;
+
+        size_t index = HashAtom(entry.atom) & mask;
+        while (entries[index].atom != NULL)
+            index = (index + 1) & mask;
+        entries[index] = entry;
+    }
+
+    mEntries.swap(entries);
 }
 
 //
@@ -65,11 +199,12 @@ TSymbol *TSymbolTableLevel::find(const TString &name) const
 //
 void TSymbolTableLevel::relateToOperator(const char *name, TOperator op)
 {
-    for (tLevel::iterator it = level.begin(); it != level.end(); ++it)
+    for (size_t index = 0; index < mEntries.size(); index++)
     {
-        if ((*it).second->isFunction())
+        TSymbol *symbol = mEntries[index].symbol;
+        if (symbol && symbol->isFunction())
         {
-            TFunction *function = static_cast<TFunction*>((*it).second);
+            TFunction *function = static_cast<TFunction*>(symbol);
             if (function->getName() == name)
                 function->relateToOperator(op);
         }
@@ -84,36 +219,82 @@ void TSymbolTableLevel::relateToOperator(const char *name, TOperator op)
 //
 void TSymbolTableLevel::relateToExtension(const char *name, const TString &ext)
 {
-    for (tLevel::iterator it = level.begin(); it != level.end(); ++it)
+    for (size_t index = 0; index < mEntries.size(); index++)
     {
-        TSymbol *symbol = it->second;
-        if (symbol->getName() == name)
+        TSymbol *symbol = mEntries[index].symbol;
+        if (symbol && symbol->getName() == name)
             symbol->relateToExtension(ext);
     }
 }
 
+void TSymbolTableLevel::precomputeTypeData()
+{
+    for (size_t index = 0; index < mEntries.size(); index++)
+    {
+        TSymbol *symbol = mEntries[index].symbol;
+        if (symbol && symbol->isVariable())
+        {
+            TType &type = static_cast<TVariable*>(symbol)->getType();
+            type.getMangledName();
+            type.getObjectSize();
+            if (type.getStruct())
+                type.getStruct()->deepestNesting();
+        }
+    }
+}
+
 TSymbol::TSymbol(const TSymbol &copyOf)
 {
     name = NewPoolTString(copyOf.name->c_str());
     uniqueId = copyOf.uniqueId;
 }
 
+const TString *TSymbolTable::findAtom(const TString &name, size_t hash) const
+{
+    const TAtomTable &builtInAtoms = mSharedBuiltInAtoms ? *mSharedBuiltInAtoms : mBuiltInAtoms;
+    const TString *atom = builtInAtoms.find(name, hash, &mProbeCount);
+    if (atom == NULL)
+        atom = mUserAtoms.find(name, hash, &mProbeCount);
+    return atom;
+}
+
+const TString *TSymbolTable::internAtom(const TString &name, ESymbolLevel level)
+{
+    size_t hash = TAtomTable::Hash(name);
+    const TString *atom = findAtom(name, hash);
+    if (atom)
+        return atom;
+
+    return (level <= LAST_BUILTIN_LEVEL ? mBuiltInAtoms : mUserAtoms).insert(name, hash);
+}
+
 TSymbol *TSymbolTable::find(const TString &name, int shaderVersion,
                             bool *builtIn, bool *sameScope) const
 {
+    mLookupCount++;
+
+    // A name that was never interned cannot name a symbol
+    const TString *atom = findAtom(name, TAtomTable::Hash(name));
     int level = currentLevel();
-    TSymbol *symbol;
+    TSymbol *symbol = 0;
 
-    do
+    if (atom)
     {
-        if (level == ESSL3_BUILTINS && shaderVersion != 300)
-            level--;
-        if (level == ESSL1_BUILTINS && shaderVersion != 100)
-            level--;
+        do
+        {
+            if (level == ESSL3_BUILTINS && shaderVersion != 300)
+                level--;
+            if (level == ESSL1_BUILTINS && shaderVersion != 100)
+                level--;
 
-        symbol = table[level]->find(name);
+            symbol = table[level]->find(atom, &mProbeCount);
+        }
+        while (symbol == 0 && --level >= 0);
+    }
+    else
+    {
+        level = -1;
     }
-    while (symbol == 0 && --level >= 0);
 
     if (builtIn)
         *builtIn = (level <= LAST_BUILTIN_LEVEL);
@@ -126,6 +307,12 @@ TSymbol *TSymbolTable::find(const TString &name, int shaderVersion,
 TSymbol *TSymbolTable::findBuiltIn(
     const TString &name, int shaderVersion) const
 {
+    mLookupCount++;
+
+    const TString *atom = findAtom(name, TAtomTable::Hash(name));
+    if (atom == NULL)
+        return 0;
+
     for (int level = LAST_BUILTIN_LEVEL; level >= 0; level--)
     {
         if (level == ESSL3_BUILTINS && shaderVersion != 300)
@@ -133,7 +320,7 @@ TSymbol *TSymbolTable::findBuiltIn(
         if (level == ESSL1_BUILTINS && shaderVersion != 100)
             level--;
 
-        TSymbol *symbol = table[level]->find(name);
+        TSymbol *symbol = table[level]->find(atom, &mProbeCount);
 
         if (symbol)
             return symbol;
@@ -148,6 +335,27 @@ TSymbolTable::~TSymbolTable()
         pop();
 }
 
+void TSymbolTable::pushSharedBuiltIns(const TSymbolTable &builtIns)
+{
+    assert(isEmpty());
+    assert(builtIns.currentLevel() == LAST_BUILTIN_LEVEL);
+
+    for (int level = 0; level <= LAST_BUILTIN_LEVEL; level++)
+    {
+        table.push_back(builtIns.table[level]);
+        precisionStack.push_back(new PrecisionStackLevel(*builtIns.precisionStack[level]));
+    }
+    mSharedLevelCount = LAST_BUILTIN_LEVEL + 1;
+    mSharedBuiltInAtoms = &builtIns.mBuiltInAtoms;
+    mUniqueIdCounter = builtIns.mUniqueIdCounter;
+}
+
+void TSymbolTable::precomputeTypeData()
+{
+    for (size_t level = 0; level < table.size(); level++)
+        table[level]->precomputeTypeData();
+}
+
 void TSymbolTable::insertBuiltIn(
     ESymbolLevel level, TType *rvalue, const char *name,
     TType *ptype1, TType *ptype2, TType *ptype3, TType *ptype4, TType *ptype5)
@@ -276,28 +276,73 @@ class TInterfaceBlockName : public TSymbol
     }
 };
 
-class TSymbolTableLevel
+// Interns symbol names, so that each distinct name is represented by a single
+// pool-allocated string and symbol levels can compare names by pointer.
+class TAtomTable
 {
   public:
-    typedef TMap<TString, TSymbol *> tLevel;
-    typedef tLevel::const_iterator const_iterator;
-    typedef const tLevel::value_type tLevelPair;
-    typedef std::pair<tLevel::iterator, bool> tInsertResult;
+    TAtomTable()
+        : mCount(0)
+    {
+    }
+
+    static size_t Hash(const TString &name);
+
+    // Returns the atom for the name, or NULL if the name was never interned.
+    const TString *find(const TString &name, size_t hash, size_t *probeCount) const;
+    // Adds a name that is not in the table yet, copying it into the current pool.
+    const TString *insert(const TString &name, size_t hash);
+
+    void clear();
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(TAtomTable);
 
+    struct Entry
+    {
+        size_t hash;
+        const TString *atom;
+    };
+
+    void grow();
+
+    std::vector<Entry> mEntries;
+    size_t mCount;
+};
+
+// A single scope of the symbol table. Symbols are keyed by the atom of their
+// mangled name in an open-addressing hash table.
+class TSymbolTableLevel
+{
+  public:
     TSymbolTableLevel()
+        : mCount(0)
     {
     }
     ~TSymbolTableLevel();
 
-    bool insert(TSymbol *symbol);
+    bool insert(const TString *atom, TSymbol *symbol);
 
-    TSymbol *find(const TString &name) const;
+    TSymbol *find(const TString *atom, size_t *probeCount) const;
 
     void relateToOperator(const char *name, TOperator op);
     void relateToExtension(const char *name, const TString &ext);
 
+    // Evaluates the lazily computed parts of the symbols' types up front, so
+    // that later lookups from any compiler or thread leave the level unchanged.
+    void precomputeTypeData();
+
   protected:
-    tLevel level;
+    struct Entry
+    {
+        const TString *atom;
+        TSymbol *symbol;
+    };
+
+    void grow();
+
+    std::vector<Entry> mEntries;
+    size_t mCount;
 };
 
 // Define ESymbolLevel as int rather than an enum since level can go
@@ -314,7 +359,13 @@ class TSymbolTable
 {
   public:
     TSymbolTable()
-        : mGlobalInvariant(false)
+        : mGlobalInvariant(false),
+          mSharedLevelCount(0),
+          mSharedBuiltInAtoms(NULL),
+          mLookupCount(0),
+          mProbeCount(0),
+          mUniqueIdCounter(0),
+          mBuiltInUniqueIdCount(0)
     {
         // The symbol table cannot be used until push() is called, but
         // the lack of an initial call to push() can be used to detect
@@ -340,17 +391,34 @@ class TSymbolTable
     }
     void push()
     {
+        if (currentLevel() == LAST_BUILTIN_LEVEL)
+            mBuiltInUniqueIdCount = mUniqueIdCounter;
+
         table.push_back(new TSymbolTableLevel);
         precisionStack.push_back(new PrecisionStackLevel);
     }
 
+    // Layers this table on top of the built-in levels of another table, which
+    // must outlive it. The shared levels are never modified through this table.
+    void pushSharedBuiltIns(const TSymbolTable &builtIns);
+
     void pop()
     {
-        delete table.back();
+        if (currentLevel() >= mSharedLevelCount)
+            delete table.back();
         table.pop_back();
 
         delete precisionStack.back();
         precisionStack.pop_back();
+
+        // The names of user symbols live in the pool of the compile, and
+        // restarting their ids keeps the output of a compile independent of
+        // earlier compiles
+        if (currentLevel() == LAST_BUILTIN_LEVEL)
+        {
+            mUserAtoms.clear();
+            mUniqueIdCounter = mBuiltInUniqueIdCount;
+        }
     }
 
     bool declare(TSymbol *symbol)
@@ -360,7 +428,9 @@ class TSymbolTable
 
     bool insert(ESymbolLevel level, TSymbol *symbol)
     {
-        return table[level]->insert(symbol);
+        assert(level >= mSharedLevelCount);
+        symbol->setUniqueId(nextUniqueId());
+        return table[level]->insert(internAtom(symbol->getMangledName(), level), symbol);
     }
 
     bool insertConstInt(ESymbolLevel level, const char *name, int value)
@@ -379,20 +449,23 @@ class TSymbolTable
                   bool *builtIn = NULL, bool *sameScope = NULL) const;
     TSymbol *findBuiltIn(const TString &name, int shaderVersion) const;
     
-    TSymbolTableLevel *getOuterLevel()
+    ESymbolLevel getOuterLevel() const
     {
         assert(currentLevel() >= 1);
-        return table[currentLevel() - 1];
+        return currentLevel() - 1;
     }
 
     void relateToOperator(ESymbolLevel level, const char *name, TOperator op)
     {
+        assert(level >= mSharedLevelCount);
         table[level]->relateToOperator(name, op);
     }
     void relateToExtension(ESymbolLevel level, const char *name, const TString &ext)
     {
+        assert(level >= mSharedLevelCount);
         table[level]->relateToExtension(name, ext);
     }
+    void precomputeTypeData();
     void dump(TInfoSink &infoSink) const;
 
     bool setDefaultPrecision(const TPublicType &type, TPrecision prec)
@@ -430,9 +503,20 @@ class TSymbolTable
     void setGlobalInvariant() { mGlobalInvariant = true; }
     bool getGlobalInvariant() const { return mGlobalInvariant; }
 
-    static int nextUniqueId()
+    // Ids are unique among the built-ins and the symbols of one compile
+    int nextUniqueId()
     {
-        return ++uniqueIdCounter;
+        return ++mUniqueIdCounter;
+    }
+
+    // Number of find() and findBuiltIn() calls, and of hash table entries
+    // they visited, since the last reset.
+    size_t getLookupCount() const { return mLookupCount; }
+    size_t getProbeCount() const { return mProbeCount; }
+    void resetLookupCounts()
+    {
+        mLookupCount = 0;
+        mProbeCount = 0;
     }
 
   private:
@@ -448,7 +532,23 @@ class TSymbolTable
     std::set<TString> mInvariantVaryings;
     bool mGlobalInvariant;
 
-    static int uniqueIdCounter;
+    // Number of levels at the bottom of the table that belong to another table
+    int mSharedLevelCount;
+
+    const TString *findAtom(const TString &name, size_t hash) const;
+    const TString *internAtom(const TString &name, ESymbolLevel level);
+
+    // Names of the built-in symbols, either inserted into this table or owned
+    // by the table whose built-in levels are shared, and names of user symbols.
+    TAtomTable mBuiltInAtoms;
+    const TAtomTable *mSharedBuiltInAtoms;
+    TAtomTable mUserAtoms;
+
+    mutable size_t mLookupCount;
+    mutable size_t mProbeCount;
+
+    int mUniqueIdCounter;
+    int mBuiltInUniqueIdCount;
 };
 
 #endif // _SYMBOL_TABLE_INCLUDED_
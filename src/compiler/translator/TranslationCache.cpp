@@ -0,0 +1,604 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// TranslationCache.cpp: Implements the persistent cache of translation results.
+
+#include "compiler/translator/TranslationCache.h"
+
+#include "compiler/translator/Compiler.h"
+#include "third_party/murmurhash/MurmurHash3.h"
+
+#include <string.h>
+
+#if defined(ANGLE_PLATFORM_POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+// Bump when the layout of the file or of the serialized results changes
+const unsigned int CacheFileMagic = 0x43544E41; // "ANTC"
+const unsigned int CacheFileVersion = 2;
+const size_t CacheFileHeaderSize = 4 * sizeof(unsigned int);
+
+// Each entry is its key, the size and checksum of its results, then the results
+const size_t CacheEntryHeaderSize = sizeof(TranslationCacheKey) + 2 * sizeof(unsigned int);
+
+void WriteInt(uint8_t *dest, unsigned int value)
+{
+    dest[0] = static_cast<uint8_t>(value);
+    dest[1] = static_cast<uint8_t>(value >> 8);
+    dest[2] = static_cast<uint8_t>(value >> 16);
+    dest[3] = static_cast<uint8_t>(value >> 24);
+}
+
+unsigned int ReadInt(const uint8_t *source)
+{
+    return source[0] | (source[1] << 8) | (source[2] << 16) | (static_cast<unsigned int>(source[3]) << 24);
+}
+
+void WriteFileHeader(uint8_t *dest)
+{
+    WriteInt(dest, CacheFileMagic);
+    WriteInt(dest + 4, CacheFileVersion);
+    WriteInt(dest + 8, ANGLE_SH_VERSION);
+    WriteInt(dest + 12, 0);
+}
+
+unsigned int ComputeChecksum(const uint8_t *data, size_t size)
+{
+    uint32_t checksum = 0;
+    MurmurHash3_x86_32(data, static_cast<int>(size), 0, &checksum);
+    return checksum;
+}
+
+void AppendInt(std::string *keyData, unsigned int value)
+{
+    uint8_t bytes[4];
+    WriteInt(bytes, value);
+    keyData->append(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+}
+
+}
+
+void TCacheOutputStream::writeInt(unsigned int value)
+{
+    size_t offset = mData.size();
+    mData.resize(offset + sizeof(unsigned int));
+    WriteInt(&mData[offset], value);
+}
+
+void TCacheOutputStream::writeString(const std::string &value)
+{
+    writeInt(static_cast<unsigned int>(value.size()));
+    mData.insert(mData.end(), value.begin(), value.end());
+}
+
+void TCacheOutputStream::writeRegisterMap(const std::map<std::string, unsigned int> &registers)
+{
+    writeInt(static_cast<unsigned int>(registers.size()));
+    for (std::map<std::string, unsigned int>::const_iterator it = registers.begin(); it != registers.end(); ++it)
+    {
+        writeString(it->first);
+        writeInt(it->second);
+    }
+}
+
+void TCacheOutputStream::writeVariable(const sh::ShaderVariable &variable)
+{
+    writeInt(variable.type);
+    writeInt(variable.precision);
+    writeString(variable.name);
+    writeString(variable.mappedName);
+    writeInt(variable.arraySize);
+    writeInt(variable.staticUse);
+    writeVariables(variable.fields);
+    writeString(variable.structName);
+}
+
+void TCacheOutputStream::writeVariable(const sh::Attribute &variable)
+{
+    writeVariable(static_cast<const sh::ShaderVariable&>(variable));
+    writeInt(static_cast<unsigned int>(variable.location));
+}
+
+void TCacheOutputStream::writeVariable(const sh::Uniform &variable)
+{
+    writeVariable(static_cast<const sh::ShaderVariable&>(variable));
+}
+
+void TCacheOutputStream::writeVariable(const sh::Varying &variable)
+{
+    writeVariable(static_cast<const sh::ShaderVariable&>(variable));
+    writeInt(variable.interpolation);
+    writeInt(variable.isInvariant);
+}
+
+void TCacheOutputStream::writeVariable(const sh::InterfaceBlockField &variable)
+{
+    writeVariable(static_cast<const sh::ShaderVariable&>(variable));
+    writeInt(variable.isRowMajorLayout);
+}
+
+void TCacheOutputStream::writeVariable(const sh::InterfaceBlock &block)
+{
+    writeString(block.name);
+    writeString(block.mappedName);
+    writeString(block.instanceName);
+    writeInt(block.arraySize);
+    writeInt(block.layout);
+    writeInt(block.isRowMajorLayout);
+    writeInt(block.staticUse);
+    writeVariables(block.fields);
+}
+
+TCacheInputStream::TCacheInputStream(const uint8_t *data, size_t size)
+    : mData(data),
+      mSize(size),
+      mOffset(0),
+      mError(false)
+{
+}
+
+bool TCacheInputStream::fail()
+{
+    mError = true;
+    return false;
+}
+
+bool TCacheInputStream::readInt(unsigned int *value)
+{
+    if (mError || remaining() < sizeof(unsigned int))
+    {
+        return fail();
+    }
+
+    *value = ReadInt(mData + mOffset);
+    mOffset += sizeof(unsigned int);
+    return true;
+}
+
+bool TCacheInputStream::readString(std::string *value)
+{
+    unsigned int length = 0;
+    if (!readInt(&length) || length > remaining())
+    {
+        return fail();
+    }
+
+    value->assign(reinterpret_cast<const char*>(mData + mOffset), length);
+    mOffset += length;
+    return true;
+}
+
+bool TCacheInputStream::readRegisterMap(std::map<std::string, unsigned int> *registers)
+{
+    unsigned int count = 0;
+    if (!readInt(&count))
+    {
+        return false;
+    }
+
+    registers->clear();
+    for (unsigned int index = 0; index < count; index++)
+    {
+        std::string name;
+        unsigned int registerIndex = 0;
+        if (!readString(&name) || !readInt(&registerIndex))
+        {
+            return false;
+        }
+        (*registers)[name] = registerIndex;
+    }
+    return true;
+}
+
+bool TCacheInputStream::readVariable(sh::ShaderVariable *variable)
+{
+    unsigned int type = 0;
+    unsigned int precision = 0;
+    unsigned int staticUse = 0;
+    bool result = readInt(&type) &&
+                  readInt(&precision) &&
+                  readString(&variable->name) &&
+                  readString(&variable->mappedName) &&
+                  readInt(&variable->arraySize) &&
+                  readInt(&staticUse) &&
+                  readVariables(&variable->fields) &&
+                  readString(&variable->structName);
+
+    variable->type = type;
+    variable->precision = precision;
+    variable->staticUse = (staticUse != 0);
+    return result;
+}
+
+bool TCacheInputStream::readVariable(sh::Attribute *variable)
+{
+    unsigned int location = 0;
+    bool result = readVariable(static_cast<sh::ShaderVariable*>(variable)) &&
+                  readInt(&location);
+
+    variable->location = static_cast<int>(location);
+    return result;
+}
+
+bool TCacheInputStream::readVariable(sh::Uniform *variable)
+{
+    return readVariable(static_cast<sh::ShaderVariable*>(variable));
+}
+
+bool TCacheInputStream::readVariable(sh::Varying *variable)
+{
+    unsigned int interpolation = 0;
+    unsigned int isInvariant = 0;
+    bool result = readVariable(static_cast<sh::ShaderVariable*>(variable)) &&
+                  readInt(&interpolation) &&
+                  readInt(&isInvariant);
+
+    variable->interpolation = static_cast<sh::InterpolationType>(interpolation);
+    variable->isInvariant = (isInvariant != 0);
+    return result;
+}
+
+bool TCacheInputStream::readVariable(sh::InterfaceBlockField *variable)
+{
+    unsigned int isRowMajorLayout = 0;
+    bool result = readVariable(static_cast<sh::ShaderVariable*>(variable)) &&
+                  readInt(&isRowMajorLayout);
+
+    variable->isRowMajorLayout = (isRowMajorLayout != 0);
+    return result;
+}
+
+bool TCacheInputStream::readVariable(sh::InterfaceBlock *block)
+{
+    unsigned int layout = 0;
+    unsigned int isRowMajorLayout = 0;
+    unsigned int staticUse = 0;
+    bool result = readString(&block->name) &&
+                  readString(&block->mappedName) &&
+                  readString(&block->instanceName) &&
+                  readInt(&block->arraySize) &&
+                  readInt(&layout) &&
+                  readInt(&isRowMajorLayout) &&
+                  readInt(&staticUse) &&
+                  readVariables(&block->fields);
+
+    block->layout = static_cast<sh::BlockLayoutType>(layout);
+    block->isRowMajorLayout = (isRowMajorLayout != 0);
+    block->staticUse = (staticUse != 0);
+    return result;
+}
+
+TranslationCache::TranslationCache()
+    : mAppendFile(NULL),
+      mMappedData(NULL),
+      mMappedSize(0),
+#if defined(ANGLE_PLATFORM_WINDOWS) && !defined(ANGLE_ENABLE_WINDOWS_STORE)
+      mFile(INVALID_HANDLE_VALUE),
+      mFileMapping(NULL),
+#endif
+      mHitCount(0),
+      mMissCount(0)
+{
+}
+
+TranslationCache::~TranslationCache()
+{
+    close();
+}
+
+bool TranslationCache::open(const std::string &fileName)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    close();
+
+    if (mapFile(fileName) && mMappedSize >= CacheFileHeaderSize)
+    {
+        uint8_t expectedHeader[CacheFileHeaderSize];
+        WriteFileHeader(expectedHeader);
+
+        if (memcmp(mMappedData, expectedHeader, CacheFileHeaderSize) == 0)
+        {
+            readEntries();
+
+            if (mMappedData != NULL)
+            {
+                mAppendFile = fopen(fileName.c_str(), "ab");
+                return (mAppendFile != NULL);
+            }
+
+            // The file ended with a partially written entry. Rewrite it with only the
+            // complete entries, which readEntries kept in mFileContents.
+            mAppendFile = fopen(fileName.c_str(), "wb");
+            if (mAppendFile == NULL)
+            {
+                return false;
+            }
+
+            fwrite(&mFileContents[0], 1, mFileContents.size(), mAppendFile);
+            fflush(mAppendFile);
+            return true;
+        }
+    }
+
+    // Start a new file if it did not exist or was written by a different version
+    close();
+
+    mAppendFile = fopen(fileName.c_str(), "wb");
+    if (mAppendFile == NULL)
+    {
+        return false;
+    }
+
+    uint8_t header[CacheFileHeaderSize];
+    WriteFileHeader(header);
+    fwrite(header, 1, sizeof(header), mAppendFile);
+    fflush(mAppendFile);
+
+    return true;
+}
+
+void TranslationCache::close()
+{
+    if (mAppendFile != NULL)
+    {
+        fclose(mAppendFile);
+        mAppendFile = NULL;
+    }
+
+    mEntries.clear();
+    mAddedEntries.clear();
+    unmapFile();
+    mFileContents.clear();
+}
+
+bool TranslationCache::mapFile(const std::string &fileName)
+{
+#if defined(ANGLE_PLATFORM_WINDOWS) && !defined(ANGLE_ENABLE_WINDOWS_STORE)
+    mFile = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (mFile == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(mFile, &fileSize) || fileSize.QuadPart == 0)
+    {
+        unmapFile();
+        return false;
+    }
+
+    mFileMapping = CreateFileMappingA(mFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mFileMapping == NULL)
+    {
+        unmapFile();
+        return false;
+    }
+
+    mMappedData = static_cast<const uint8_t*>(MapViewOfFile(mFileMapping, FILE_MAP_READ, 0, 0, 0));
+    if (mMappedData == NULL)
+    {
+        unmapFile();
+        return false;
+    }
+
+    mMappedSize = static_cast<size_t>(fileSize.QuadPart);
+    return true;
+#elif defined(ANGLE_PLATFORM_POSIX)
+    int file = ::open(fileName.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+        ::close(file);
+        return false;
+    }
+
+    void *mapping = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    ::close(file);
+    if (mapping == MAP_FAILED)
+    {
+        return false;
+    }
+
+    mMappedData = static_cast<const uint8_t*>(mapping);
+    mMappedSize = static_cast<size_t>(fileStat.st_size);
+    return true;
+#else
+    // Read the whole file where memory-mapped files are not available
+    FILE *file = fopen(fileName.c_str(), "rb");
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    uint8_t buffer[4096];
+    size_t readSize = 0;
+    while ((readSize = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        mFileContents.insert(mFileContents.end(), buffer, buffer + readSize);
+    }
+    fclose(file);
+
+    if (mFileContents.empty())
+    {
+        return false;
+    }
+
+    mMappedData = &mFileContents[0];
+    mMappedSize = mFileContents.size();
+    return true;
+#endif
+}
+
+void TranslationCache::unmapFile()
+{
+#if defined(ANGLE_PLATFORM_WINDOWS) && !defined(ANGLE_ENABLE_WINDOWS_STORE)
+    if (mMappedData != NULL)
+    {
+        UnmapViewOfFile(mMappedData);
+    }
+    if (mFileMapping != NULL)
+    {
+        CloseHandle(mFileMapping);
+        mFileMapping = NULL;
+    }
+    if (mFile != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(mFile);
+        mFile = INVALID_HANDLE_VALUE;
+    }
+#elif defined(ANGLE_PLATFORM_POSIX)
+    if (mMappedData != NULL)
+    {
+        munmap(const_cast<uint8_t*>(mMappedData), mMappedSize);
+    }
+#endif
+
+    mMappedData = NULL;
+    mMappedSize = 0;
+}
+
+void TranslationCache::readEntries()
+{
+    size_t offset = CacheFileHeaderSize;
+    while (offset < mMappedSize)
+    {
+        if (mMappedSize - offset < CacheEntryHeaderSize)
+        {
+            break;
+        }
+
+        const uint8_t *entryHeader = mMappedData + offset;
+        size_t size = ReadInt(entryHeader + sizeof(TranslationCacheKey));
+        unsigned int checksum = ReadInt(entryHeader + sizeof(TranslationCacheKey) + sizeof(unsigned int));
+
+        const uint8_t *data = entryHeader + CacheEntryHeaderSize;
+        if (mMappedSize - offset - CacheEntryHeaderSize < size || ComputeChecksum(data, size) != checksum)
+        {
+            break;
+        }
+
+        TranslationCacheKey key;
+        memcpy(&key, entryHeader, sizeof(key));
+
+        Entry entry = { data, size };
+        mEntries[key] = entry;
+
+        offset += CacheEntryHeaderSize + size;
+    }
+
+    if (offset < mMappedSize)
+    {
+        // Keep only the complete entries so the file can be rewritten without the damaged
+        // tail. Clearing the mapping tells open() to rewrite the file from mFileContents.
+        if (mFileContents.empty())
+        {
+            mFileContents.assign(mMappedData, mMappedData + offset);
+            for (std::map<TranslationCacheKey, Entry>::iterator it = mEntries.begin(); it != mEntries.end(); ++it)
+            {
+                it->second.data = &mFileContents[0] + (it->second.data - mMappedData);
+            }
+        }
+        else
+        {
+            mFileContents.resize(offset);
+        }
+        unmapFile();
+    }
+}
+
+bool TranslationCache::ComputeKey(const TCompiler *compiler, const char *const shaderStrings[],
+                                  size_t numStrings, int compileOptions, TranslationCacheKey *keyOut)
+{
+    // The output of a hash function given by the application cannot be reproduced from a key
+    if (compiler->getHashFunction() != NULL || numStrings == 0)
+    {
+        return false;
+    }
+
+    std::string keyData;
+    AppendInt(&keyData, compiler->getShaderType());
+    AppendInt(&keyData, compiler->getShaderSpec());
+    AppendInt(&keyData, compiler->getOutputType());
+    AppendInt(&keyData, compileOptions);
+    AppendInt(&keyData, compiler->getResources().ArrayIndexClampingStrategy);
+    keyData += compiler->getBuiltInResourcesString();
+
+    AppendInt(&keyData, static_cast<unsigned int>(numStrings));
+    for (size_t index = 0; index < numStrings; index++)
+    {
+        size_t length = strlen(shaderStrings[index]);
+        AppendInt(&keyData, static_cast<unsigned int>(length));
+        keyData.append(shaderStrings[index], length);
+    }
+
+    MurmurHash3_x64_128(keyData.data(), static_cast<int>(keyData.size()), CacheFileVersion, keyOut->hash);
+    return true;
+}
+
+bool TranslationCache::load(const TranslationCacheKey &key, TCompiler *compiler, bool *successOut)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    std::map<TranslationCacheKey, Entry>::const_iterator it = mEntries.find(key);
+    if (it != mEntries.end())
+    {
+        TCacheInputStream stream(it->second.data, it->second.size);
+
+        unsigned int success = 0;
+        if (stream.readInt(&success) && compiler->loadResults(&stream) && stream.endOfStream())
+        {
+            mHitCount++;
+            *successOut = (success != 0);
+            return true;
+        }
+    }
+
+    mMissCount++;
+    return false;
+}
+
+void TranslationCache::store(const TranslationCacheKey &key, const TCompiler *compiler, bool success)
+{
+    TCacheOutputStream stream;
+    stream.writeInt(success);
+    compiler->saveResults(&stream);
+    const std::vector<uint8_t> &results = stream.getData();
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    if (mAppendFile == NULL || mEntries.count(key) > 0)
+    {
+        return;
+    }
+
+    mAddedEntries.push_back(std::vector<uint8_t>(CacheEntryHeaderSize + results.size()));
+    std::vector<uint8_t> &entryData = mAddedEntries.back();
+
+    memcpy(&entryData[0], &key, sizeof(key));
+    WriteInt(&entryData[sizeof(key)], static_cast<unsigned int>(results.size()));
+    WriteInt(&entryData[sizeof(key) + sizeof(unsigned int)], ComputeChecksum(results.data(), results.size()));
+    memcpy(&entryData[CacheEntryHeaderSize], results.data(), results.size());
+
+    Entry entry = { &entryData[CacheEntryHeaderSize], results.size() };
+    mEntries[key] = entry;
+
+    fwrite(&entryData[0], 1, entryData.size(), mAppendFile);
+    fflush(mAppendFile);
+}
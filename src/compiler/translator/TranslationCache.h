@@ -0,0 +1,181 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// TranslationCache.h: A persistent cache of translation results. Entries are keyed by a
+// hash of the shader strings and everything else that affects the output of
+// TCompiler::compile, and hold the object code, info log and collected variables in a
+// compact binary form. The cache file is memory-mapped when it is opened, and new
+// entries are appended to it.
+
+#ifndef COMPILER_TRANSLATOR_TRANSLATIONCACHE_H_
+#define COMPILER_TRANSLATOR_TRANSLATIONCACHE_H_
+
+#include "GLSLANG/ShaderLang.h"
+
+#include "common/angleutils.h"
+#include "common/platform.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class TCompiler;
+
+// Serializes the results of a compile for the translation cache.
+class TCacheOutputStream
+{
+  public:
+    void writeInt(unsigned int value);
+    void writeString(const std::string &value);
+
+    template <typename VarT>
+    void writeVariables(const std::vector<VarT> &variables)
+    {
+        writeInt(static_cast<unsigned int>(variables.size()));
+        for (size_t index = 0; index < variables.size(); index++)
+        {
+            writeVariable(variables[index]);
+        }
+    }
+
+    void writeRegisterMap(const std::map<std::string, unsigned int> &registers);
+
+    const std::vector<uint8_t> &getData() const { return mData; }
+
+  private:
+    void writeVariable(const sh::ShaderVariable &variable);
+    void writeVariable(const sh::Attribute &variable);
+    void writeVariable(const sh::Uniform &variable);
+    void writeVariable(const sh::Varying &variable);
+    void writeVariable(const sh::InterfaceBlockField &variable);
+    void writeVariable(const sh::InterfaceBlock &block);
+
+    std::vector<uint8_t> mData;
+};
+
+// Reads back data written by TCacheOutputStream. Every read is bounds checked, and once a
+// read fails all further reads fail too.
+class TCacheInputStream
+{
+  public:
+    TCacheInputStream(const uint8_t *data, size_t size);
+
+    bool readInt(unsigned int *value);
+    bool readString(std::string *value);
+
+    template <typename VarT>
+    bool readVariables(std::vector<VarT> *variables)
+    {
+        unsigned int count = 0;
+        if (!readInt(&count) || count > remaining())
+        {
+            return fail();
+        }
+
+        variables->resize(count);
+        for (size_t index = 0; index < count; index++)
+        {
+            if (!readVariable(&(*variables)[index]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool readRegisterMap(std::map<std::string, unsigned int> *registers);
+
+    bool error() const { return mError; }
+    bool endOfStream() const { return mOffset == mSize; }
+
+  private:
+    size_t remaining() const { return mSize - mOffset; }
+    bool fail();
+
+    bool readVariable(sh::ShaderVariable *variable);
+    bool readVariable(sh::Attribute *variable);
+    bool readVariable(sh::Uniform *variable);
+    bool readVariable(sh::Varying *variable);
+    bool readVariable(sh::InterfaceBlockField *variable);
+    bool readVariable(sh::InterfaceBlock *block);
+
+    const uint8_t *mData;
+    size_t mSize;
+    size_t mOffset;
+    bool mError;
+};
+
+struct TranslationCacheKey
+{
+    uint64_t hash[2];
+
+    bool operator<(const TranslationCacheKey &other) const
+    {
+        return (hash[0] != other.hash[0]) ? (hash[0] < other.hash[0]) : (hash[1] < other.hash[1]);
+    }
+};
+
+class TranslationCache
+{
+  public:
+    TranslationCache();
+    ~TranslationCache();
+
+    // Maps the entries of an existing cache file, creating the file if needed. Files written
+    // by a different cache format or ANGLE_SH_VERSION are discarded.
+    bool open(const std::string &fileName);
+
+    // Returns false for compiles that cannot be cached, such as those using name hashing.
+    static bool ComputeKey(const TCompiler *compiler, const char *const shaderStrings[],
+                           size_t numStrings, int compileOptions, TranslationCacheKey *keyOut);
+
+    // On a hit, replaces the results of the compiler with the cached ones.
+    bool load(const TranslationCacheKey &key, TCompiler *compiler, bool *successOut);
+    void store(const TranslationCacheKey &key, const TCompiler *compiler, bool success);
+
+    size_t getHitCount() const { return mHitCount; }
+    size_t getMissCount() const { return mMissCount; }
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(TranslationCache);
+
+    void close();
+    bool mapFile(const std::string &fileName);
+    void unmapFile();
+    void readEntries();
+
+    struct Entry
+    {
+        const uint8_t *data;
+        size_t size;
+    };
+
+    std::mutex mMutex;
+    std::map<TranslationCacheKey, Entry> mEntries;
+
+    // Entries added since the file was mapped
+    std::list<std::vector<uint8_t> > mAddedEntries;
+
+    FILE *mAppendFile;
+
+    const uint8_t *mMappedData;
+    size_t mMappedSize;
+#if defined(ANGLE_PLATFORM_WINDOWS) && !defined(ANGLE_ENABLE_WINDOWS_STORE)
+    HANDLE mFile;
+    HANDLE mFileMapping;
+#endif
+    std::vector<uint8_t> mFileContents;
+
+    size_t mHitCount;
+    size_t mMissCount;
+};
+
+#endif // COMPILER_TRANSLATOR_TRANSLATIONCACHE_H_
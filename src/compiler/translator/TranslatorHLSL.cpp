@@ -8,6 +8,7 @@
 
 #include "compiler/translator/InitializeParseContext.h"
 #include "compiler/translator/OutputHLSL.h"
+#include "compiler/translator/TranslationCache.h"
 
 TranslatorHLSL::TranslatorHLSL(sh::GLenum type, ShShaderSpec spec, ShShaderOutput output)
     : TCompiler(type, spec, output)
@@ -25,6 +26,21 @@ void TranslatorHLSL::translate(TIntermNode *root)
     mUniformRegisterMap = outputHLSL.getUniformRegisterMap();
 }
 
+void TranslatorHLSL::saveResults(TCacheOutputStream *stream) const
+{
+    TCompiler::saveResults(stream);
+
+    stream->writeRegisterMap(mInterfaceBlockRegisterMap);
+    stream->writeRegisterMap(mUniformRegisterMap);
+}
+
+bool TranslatorHLSL::loadResults(TCacheInputStream *stream)
+{
+    return TCompiler::loadResults(stream) &&
+           stream->readRegisterMap(&mInterfaceBlockRegisterMap) &&
+           stream->readRegisterMap(&mUniformRegisterMap);
+}
+
 bool TranslatorHLSL::hasInterfaceBlock(const std::string &interfaceBlockName) const
 {
     return (mInterfaceBlockRegisterMap.count(interfaceBlockName) > 0);
@@ -21,6 +21,9 @@ class TranslatorHLSL : public TCompiler
     bool hasUniform(const std::string &uniformName) const;
     unsigned int getUniformRegister(const std::string &uniformName) const;
 
+    virtual void saveResults(TCacheOutputStream *stream) const;
+    virtual bool loadResults(TCacheInputStream *stream);
+
   protected:
     virtual void translate(TIntermNode* root);
 
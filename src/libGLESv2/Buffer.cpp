@@ -15,6 +15,8 @@
 namespace gl
 {
 
+unsigned int Buffer::mStorageSerial = 1;
+
 Buffer::Buffer(rx::BufferImpl *impl, GLuint id)
     : RefCountObject(id),
       mBuffer(impl),
@@ -44,6 +46,7 @@ Error Buffer::bufferData(const void *data, GLsizeiptr size, GLenum usage)
     mIndexRangeCache.clear();
     mUsage = usage;
     mSize = size;
+    mStorageSerial++;
 
     return error;
 }
@@ -90,6 +93,7 @@ Error Buffer::mapRange(GLintptr offset, GLsizeiptr length, GLbitfield access)
     mMapOffset = static_cast<GLint64>(offset);
     mMapLength = static_cast<GLint64>(length);
     mAccessFlags = static_cast<GLint>(access);
+    mStorageSerial++;
 
     if ((access & GL_MAP_WRITE_BIT) > 0)
     {
@@ -114,6 +118,7 @@ Error Buffer::unmap()
     mMapOffset = 0;
     mMapLength = 0;
     mAccessFlags = 0;
+    mStorageSerial++;
 
     return error;
 }
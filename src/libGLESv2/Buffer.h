@@ -54,9 +54,14 @@ class Buffer : public RefCountObject
     rx::IndexRangeCache *getIndexRangeCache() { return &mIndexRangeCache; }
     const rx::IndexRangeCache *getIndexRangeCache() const { return &mIndexRangeCache; }
 
+    // Changes whenever the size of any buffer changes, or any buffer is mapped or unmapped
+    static unsigned int getStorageSerial() { return mStorageSerial; }
+
   private:
     DISALLOW_COPY_AND_ASSIGN(Buffer);
 
+    static unsigned int mStorageSerial;
+
     rx::BufferImpl *mBuffer;
 
     GLenum mUsage;
@@ -5,6 +5,7 @@
 //
 
 #include "libGLESv2/Caps.h"
+#include "libGLESv2/formatutils.h"
 #include "common/debug.h"
 #include "common/angleutils.h"
 
@@ -50,7 +51,20 @@ GLuint TextureCaps::getNearestSamples(GLuint requestedSamples) const
 
 void TextureCapsMap::insert(GLenum internalFormat, const TextureCaps &caps)
 {
-    mCapsMap.insert(std::make_pair(internalFormat, caps));
+    if (!mCapsMap.insert(std::make_pair(internalFormat, caps)).second)
+    {
+        return;
+    }
+
+    size_t formatIndex = GetInternalFormatIndex(internalFormat);
+    if (formatIndex != 0)
+    {
+        if (formatIndex >= mCapsByFormatIndex.size())
+        {
+            mCapsByFormatIndex.resize(formatIndex + 1);
+        }
+        mCapsByFormatIndex[formatIndex] = caps;
+    }
 }
 
 void TextureCapsMap::remove(GLenum internalFormat)
@@ -59,12 +73,25 @@ void TextureCapsMap::remove(GLenum internalFormat)
     if (i != mCapsMap.end())
     {
         mCapsMap.erase(i);
+
+        size_t formatIndex = GetInternalFormatIndex(internalFormat);
+        if (formatIndex != 0 && formatIndex < mCapsByFormatIndex.size())
+        {
+            mCapsByFormatIndex[formatIndex] = TextureCaps();
+        }
     }
 }
 
 const TextureCaps &TextureCapsMap::get(GLenum internalFormat) const
 {
     static TextureCaps defaultUnsupportedTexture;
+
+    size_t formatIndex = GetInternalFormatIndex(internalFormat);
+    if (formatIndex != 0)
+    {
+        return (formatIndex < mCapsByFormatIndex.size()) ? mCapsByFormatIndex[formatIndex] : defaultUnsupportedTexture;
+    }
+
     InternalFormatToCapsMap::const_iterator iter = mCapsMap.find(internalFormat);
     return (iter != mCapsMap.end()) ? iter->second : defaultUnsupportedTexture;
 }
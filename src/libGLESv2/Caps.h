@@ -60,6 +60,9 @@ class TextureCapsMap
   private:
     typedef std::unordered_map<GLenum, TextureCaps> InternalFormatToCapsMap;
     InternalFormatToCapsMap mCapsMap;
+
+    // The caps of the known formats again, indexed by GetInternalFormatIndex for the lookups
+    std::vector<TextureCaps> mCapsByFormatIndex;
 };
 
 struct Extensions
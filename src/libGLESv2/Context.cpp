@@ -34,6 +34,7 @@
 
 #include <sstream>
 #include <iterator>
+#include <limits>
 
 namespace gl
 {
@@ -119,6 +120,23 @@ Context::Context(int clientVersion, const gl::Context *shareContext, rx::Rendere
     mResetStatus = GL_NO_ERROR;
     mResetStrategy = (notifyResets ? GL_LOSE_CONTEXT_ON_RESET_EXT : GL_NO_RESET_NOTIFICATION_EXT);
     mRobustAccess = robustAccess;
+
+    mViewportDirty = true;
+    mAppliedViewportDrawMode = GL_NONE;
+    mAppliedIgnoreViewport = false;
+    mViewportStateSerial = 0;
+    mRenderStateDirty = true;
+    mAppliedPointDrawMode = false;
+    mRenderStateSerial = 0;
+    mInputLayoutDirty = true;
+    mInputLayoutProgramSerial = 0;
+    mVertexAttribLimitsDirty = true;
+    mVertexAttribLimitsProgramSerial = 0;
+    mVertexAttribLimitsStorageSerial = 0;
+    mSamplerTexturesDirty = true;
+    mSamplerTexturesProgramSerial = 0;
+    mSamplerTexturesMappingSerial = 0;
+    mSamplerTexturesFramebufferSerialCount = 0;
 }
 
 Context::~Context()
@@ -200,6 +218,9 @@ void Context::makeCurrent(egl::Surface *surface)
 
     // Store the current client version in the renderer
     mRenderer->setCurrentClientVersion(mClientVersion);
+
+    // The renderer may have applied the state of another context since this one was last current
+    mState.setDirtyBits(State::DIRTY_BIT_ALL);
 }
 
 // NOTE: this function should not assume that this context is current!
@@ -255,7 +276,7 @@ GLuint Context::createVertexArray()
     // we create it immediately. The resulting behaviour is transparent to the application,
     // since it's not currently possible to access the state until the object is bound.
     VertexArray *vertexArray = new VertexArray(mRenderer->createVertexArray(), handle, MAX_VERTEX_ATTRIBS);
-    mVertexArrayMap[handle] = vertexArray;
+    mVertexArrayMap.assign(handle, vertexArray);
     return handle;
 }
 
@@ -269,7 +290,7 @@ GLuint Context::createTransformFeedback()
     GLuint handle = mTransformFeedbackAllocator.allocate();
     TransformFeedback *transformFeedback = new TransformFeedback(mRenderer->createTransformFeedback(), handle);
     transformFeedback->addRef();
-    mTransformFeedbackMap[handle] = transformFeedback;
+    mTransformFeedbackMap.assign(handle, transformFeedback);
     return handle;
 }
 
@@ -278,7 +299,7 @@ GLuint Context::createFramebuffer()
 {
     GLuint handle = mFramebufferHandleAllocator.allocate();
 
-    mFramebufferMap[handle] = NULL;
+    mFramebufferMap.assign(handle, NULL);
 
     return handle;
 }
@@ -287,7 +308,7 @@ GLuint Context::createFenceNV()
 {
     GLuint handle = mFenceNVHandleAllocator.allocate();
 
-    mFenceNVMap[handle] = new FenceNV(mRenderer->createFenceNV());
+    mFenceNVMap.assign(handle, new FenceNV(mRenderer->createFenceNV()));
 
     return handle;
 }
@@ -297,7 +318,7 @@ GLuint Context::createQuery()
 {
     GLuint handle = mQueryHandleAllocator.allocate();
 
-    mQueryMap[handle] = NULL;
+    mQueryMap.assign(handle, NULL);
 
     return handle;
 }
@@ -353,15 +374,15 @@ void Context::deleteFenceSync(GLsync fenceSync)
 
 void Context::deleteVertexArray(GLuint vertexArray)
 {
-    auto vertexArrayObject = mVertexArrayMap.find(vertexArray);
+    VertexArray *vertexArrayObject = mVertexArrayMap.query(vertexArray);
 
-    if (vertexArrayObject != mVertexArrayMap.end())
+    if (vertexArrayObject)
     {
         detachVertexArray(vertexArray);
 
-        mVertexArrayHandleAllocator.release(vertexArrayObject->first);
-        delete vertexArrayObject->second;
-        mVertexArrayMap.erase(vertexArrayObject);
+        mVertexArrayHandleAllocator.release(vertexArray);
+        delete vertexArrayObject;
+        mVertexArrayMap.erase(vertexArray);
     }
 }
 
@@ -377,53 +398,51 @@ void Context::deleteSampler(GLuint sampler)
 
 void Context::deleteTransformFeedback(GLuint transformFeedback)
 {
-    TransformFeedbackMap::const_iterator iter = mTransformFeedbackMap.find(transformFeedback);
-    if (iter != mTransformFeedbackMap.end())
+    TransformFeedback *transformFeedbackObject = mTransformFeedbackMap.query(transformFeedback);
+    if (transformFeedbackObject)
     {
         detachTransformFeedback(transformFeedback);
         mTransformFeedbackAllocator.release(transformFeedback);
-        iter->second->release();
-        mTransformFeedbackMap.erase(iter);
+        transformFeedbackObject->release();
+        mTransformFeedbackMap.erase(transformFeedback);
     }
 }
 
 void Context::deleteFramebuffer(GLuint framebuffer)
 {
-    FramebufferMap::iterator framebufferObject = mFramebufferMap.find(framebuffer);
-
-    if (framebufferObject != mFramebufferMap.end())
+    if (mFramebufferMap.contains(framebuffer))
     {
         detachFramebuffer(framebuffer);
 
-        mFramebufferHandleAllocator.release(framebufferObject->first);
-        delete framebufferObject->second;
-        mFramebufferMap.erase(framebufferObject);
+        mFramebufferHandleAllocator.release(framebuffer);
+        delete mFramebufferMap.query(framebuffer);
+        mFramebufferMap.erase(framebuffer);
     }
 }
 
 void Context::deleteFenceNV(GLuint fence)
 {
-    FenceNVMap::iterator fenceObject = mFenceNVMap.find(fence);
+    FenceNV *fenceObject = mFenceNVMap.query(fence);
 
-    if (fenceObject != mFenceNVMap.end())
+    if (fenceObject)
     {
-        mFenceNVHandleAllocator.release(fenceObject->first);
-        delete fenceObject->second;
-        mFenceNVMap.erase(fenceObject);
+        mFenceNVHandleAllocator.release(fence);
+        delete fenceObject;
+        mFenceNVMap.erase(fence);
     }
 }
 
 void Context::deleteQuery(GLuint query)
 {
-    QueryMap::iterator queryObject = mQueryMap.find(query);
-    if (queryObject != mQueryMap.end())
+    if (mQueryMap.contains(query))
     {
-        mQueryHandleAllocator.release(queryObject->first);
-        if (queryObject->second)
+        Query *queryObject = mQueryMap.query(query);
+        mQueryHandleAllocator.release(query);
+        if (queryObject)
         {
-            queryObject->second->release();
+            queryObject->release();
         }
-        mQueryMap.erase(queryObject);
+        mQueryMap.erase(query);
     }
 }
 
@@ -459,16 +478,7 @@ FenceSync *Context::getFenceSync(GLsync handle) const
 
 VertexArray *Context::getVertexArray(GLuint handle) const
 {
-    auto vertexArray = mVertexArrayMap.find(handle);
-
-    if (vertexArray == mVertexArrayMap.end())
-    {
-        return NULL;
-    }
-    else
-    {
-        return vertexArray->second;
-    }
+    return mVertexArrayMap.query(handle);
 }
 
 Sampler *Context::getSampler(GLuint handle) const
@@ -484,8 +494,7 @@ TransformFeedback *Context::getTransformFeedback(GLuint handle) const
     }
     else
     {
-        TransformFeedbackMap::const_iterator iter = mTransformFeedbackMap.find(handle);
-        return (iter != mTransformFeedbackMap.end()) ? iter->second : NULL;
+        return mTransformFeedbackMap.query(handle);
     }
 }
 
@@ -505,7 +514,7 @@ void Context::bindElementArrayBuffer(unsigned int buffer)
 {
     mResourceManager->checkBufferAllocation(buffer);
 
-    mState.getVertexArray()->setElementArrayBuffer(getBuffer(buffer));
+    mState.setElementArrayBufferBinding(getBuffer(buffer));
 }
 
 void Context::bindTexture(GLenum target, GLuint texture)
@@ -519,7 +528,7 @@ void Context::bindReadFramebuffer(GLuint framebuffer)
 {
     if (!getFramebuffer(framebuffer))
     {
-        mFramebufferMap[framebuffer] = new Framebuffer(mRenderer, framebuffer);
+        mFramebufferMap.assign(framebuffer, new Framebuffer(mRenderer, framebuffer));
     }
 
     mState.setReadFramebufferBinding(getFramebuffer(framebuffer));
@@ -529,7 +538,7 @@ void Context::bindDrawFramebuffer(GLuint framebuffer)
 {
     if (!getFramebuffer(framebuffer))
     {
-        mFramebufferMap[framebuffer] = new Framebuffer(mRenderer, framebuffer);
+        mFramebufferMap.assign(framebuffer, new Framebuffer(mRenderer, framebuffer));
     }
 
     mState.setDrawFramebufferBinding(getFramebuffer(framebuffer));
@@ -547,7 +556,7 @@ void Context::bindVertexArray(GLuint vertexArray)
     if (!getVertexArray(vertexArray))
     {
         VertexArray *vertexArrayObject = new VertexArray(mRenderer->createVertexArray(), vertexArray, MAX_VERTEX_ATTRIBS);
-        mVertexArrayMap[vertexArray] = vertexArrayObject;
+        mVertexArrayMap.assign(vertexArray, vertexArrayObject);
     }
 
     mState.setVertexArrayBinding(getVertexArray(vertexArray));
@@ -724,8 +733,8 @@ void Context::setFramebufferZero(Framebuffer *buffer)
 		mState.setReadFramebufferBinding(buffer);
 	}
 
-    delete mFramebufferMap[0];
-    mFramebufferMap[0] = buffer;
+    delete mFramebufferMap.query(0);
+    mFramebufferMap.assign(0, buffer);
 }
 
 void Context::setRenderbufferStorage(GLsizei width, GLsizei height, GLenum internalformat, GLsizei samples)
@@ -757,48 +766,30 @@ void Context::setRenderbufferStorage(GLsizei width, GLsizei height, GLenum inter
 
 Framebuffer *Context::getFramebuffer(unsigned int handle) const
 {
-    FramebufferMap::const_iterator framebuffer = mFramebufferMap.find(handle);
-
-    if (framebuffer == mFramebufferMap.end())
-    {
-        return NULL;
-    }
-    else
-    {
-        return framebuffer->second;
-    }
+    return mFramebufferMap.query(handle);
 }
 
 FenceNV *Context::getFenceNV(unsigned int handle)
 {
-    FenceNVMap::iterator fence = mFenceNVMap.find(handle);
-
-    if (fence == mFenceNVMap.end())
-    {
-        return NULL;
-    }
-    else
-    {
-        return fence->second;
-    }
+    return mFenceNVMap.query(handle);
 }
 
 Query *Context::getQuery(unsigned int handle, bool create, GLenum type)
 {
-    QueryMap::iterator query = mQueryMap.find(handle);
-
-    if (query == mQueryMap.end())
+    if (!mQueryMap.contains(handle))
     {
         return NULL;
     }
     else
     {
-        if (!query->second && create)
+        Query *queryObject = mQueryMap.query(handle);
+        if (!queryObject && create)
         {
-            query->second = new Query(mRenderer->createQuery(type), handle);
-            query->second->addRef();
+            queryObject = new Query(mRenderer->createQuery(type), handle);
+            queryObject->addRef();
+            mQueryMap.assign(handle, queryObject);
         }
-        return query->second;
+        return queryObject;
     }
 }
 
@@ -1313,6 +1304,115 @@ bool Context::getIndexedQueryParameterInfo(GLenum target, GLenum *type, unsigned
     return false;
 }
 
+// Moves the dirty bits of the State to the draw steps that depend on them
+void Context::syncDirtyBits()
+{
+    State::DirtyBits dirtyBits = mState.getDirtyBits();
+    if (dirtyBits == 0)
+    {
+        return;
+    }
+
+    const State::DirtyBits viewportBits = State::DIRTY_BIT_VIEWPORT | State::DIRTY_BIT_SCISSOR |
+                                          State::DIRTY_BIT_RASTERIZER_STATE | State::DIRTY_BIT_DRAW_FRAMEBUFFER_BINDING;
+    const State::DirtyBits renderStateBits = State::DIRTY_BIT_RASTERIZER_STATE | State::DIRTY_BIT_BLEND_STATE |
+                                             State::DIRTY_BIT_DEPTH_STENCIL_STATE | State::DIRTY_BIT_DRAW_FRAMEBUFFER_BINDING;
+    const State::DirtyBits inputLayoutBits = State::DIRTY_BIT_PROGRAM_BINDING | State::DIRTY_BIT_VERTEX_ARRAY_BINDING |
+                                             State::DIRTY_BIT_VERTEX_ATTRIB_FORMATS;
+    const State::DirtyBits vertexAttribLimitsBits = inputLayoutBits | State::DIRTY_BIT_VERTEX_ATTRIB_BINDINGS;
+    const State::DirtyBits samplerTexturesBits = State::DIRTY_BIT_TEXTURE_BINDINGS | State::DIRTY_BIT_SAMPLER_BINDINGS;
+
+    mViewportDirty = mViewportDirty || (dirtyBits & viewportBits) != 0;
+    mRenderStateDirty = mRenderStateDirty || (dirtyBits & renderStateBits) != 0;
+    mInputLayoutDirty = mInputLayoutDirty || (dirtyBits & inputLayoutBits) != 0;
+    mVertexAttribLimitsDirty = mVertexAttribLimitsDirty || (dirtyBits & vertexAttribLimitsBits) != 0;
+    mSamplerTexturesDirty = mSamplerTexturesDirty || (dirtyBits & samplerTexturesBits) != 0;
+
+    mState.clearDirtyBits(dirtyBits);
+}
+
+// Returns the limits the vertex attributes put on draw calls, computing them again only when the
+// vertex array, the program or the size or mapping of a buffer changed
+const VertexAttribLimits &Context::getVertexAttribLimits()
+{
+    ProgramBinary *programBinary = mState.getCurrentProgramBinary();
+    unsigned int programSerial = (programBinary ? programBinary->getSerial() : 0);
+
+    syncDirtyBits();
+
+    if (!mVertexAttribLimitsDirty && programSerial == mVertexAttribLimitsProgramSerial &&
+        Buffer::getStorageSerial() == mVertexAttribLimitsStorageSerial)
+    {
+        return mVertexAttribLimits;
+    }
+
+    VertexAttribLimits limits;
+    limits.mappedArrayBuffer = false;
+    limits.missingVertexData = false;
+    limits.activeNonInstancedAttribute = false;
+    limits.maxVertexCount = std::numeric_limits<GLint64>::max();
+    limits.maxInstanceCount = std::numeric_limits<GLint64>::max();
+
+    const VertexArray *vao = mState.getVertexArray();
+    for (int attributeIndex = 0; attributeIndex < MAX_VERTEX_ATTRIBS; attributeIndex++)
+    {
+        const VertexAttribute &attrib = vao->getVertexAttribute(attributeIndex);
+        bool attribActive = (programBinary && programBinary->getSemanticIndex(attributeIndex) != -1);
+        Buffer *buffer = attrib.buffer.get();
+
+        if (attribActive && attrib.divisor == 0)
+        {
+            limits.activeNonInstancedAttribute = true;
+        }
+
+        if (!attrib.enabled)
+        {
+            continue;
+        }
+
+        if (buffer && buffer->isMapped())
+        {
+            limits.mappedArrayBuffer = true;
+        }
+
+        if (!attribActive)
+        {
+            continue;
+        }
+
+        if (buffer)
+        {
+            GLint64 attribStride = static_cast<GLint64>(ComputeVertexAttributeStride(attrib));
+            GLint64 elementCount = buffer->getSize() / attribStride;
+
+            if (attrib.divisor > 0)
+            {
+                // An instance count reads (instanceCount / divisor) elements
+                GLint64 divisor = static_cast<GLint64>(attrib.divisor);
+                if (elementCount + 1 <= std::numeric_limits<GLint64>::max() / divisor)
+                {
+                    limits.maxInstanceCount = std::min(limits.maxInstanceCount, (elementCount + 1) * divisor - 1);
+                }
+            }
+            else
+            {
+                limits.maxVertexCount = std::min(limits.maxVertexCount, elementCount);
+            }
+        }
+        else if (attrib.pointer == NULL)
+        {
+            limits.missingVertexData = true;
+        }
+    }
+
+    mVertexAttribLimits = limits;
+    mVertexAttribLimitsDirty = false;
+    mVertexAttribLimitsProgramSerial = programSerial;
+    mVertexAttribLimitsStorageSerial = Buffer::getStorageSerial();
+
+    return mVertexAttribLimits;
+}
+
 // Applies the render target surface, depth stencil surface, viewport rectangle and
 // scissor rectangle to the renderer
 Error Context::applyRenderTarget(GLenum drawMode, bool ignoreViewport)
@@ -1326,6 +1426,16 @@ Error Context::applyRenderTarget(GLenum drawMode, bool ignoreViewport)
         return error;
     }
 
+    syncDirtyBits();
+
+    // Changing the render target makes the renderer apply the viewport and scissor rectangle again
+    unsigned int appliedStateSerial = mRenderer->getAppliedStateSerial();
+    if (!mViewportDirty && drawMode == mAppliedViewportDrawMode && ignoreViewport == mAppliedIgnoreViewport &&
+        appliedStateSerial == mViewportStateSerial)
+    {
+        return gl::Error(GL_NO_ERROR);
+    }
+
     float nearZ, farZ;
     mState.getDepthRange(&nearZ, &farZ);
     mRenderer->setViewport(mState.getViewport(), nearZ, farZ, drawMode, mState.getRasterizerState().frontFace,
@@ -1333,17 +1443,32 @@ Error Context::applyRenderTarget(GLenum drawMode, bool ignoreViewport)
 
     mRenderer->setScissorRectangle(mState.getScissor(), mState.isScissorTestEnabled());
 
+    // Read the serial again, as enabling or disabling the scissor test can invalidate the rasterizer state
+    mViewportDirty = false;
+    mAppliedViewportDrawMode = drawMode;
+    mAppliedIgnoreViewport = ignoreViewport;
+    mViewportStateSerial = mRenderer->getAppliedStateSerial();
+
     return gl::Error(GL_NO_ERROR);
 }
 
 // Applies the fixed-function state (culling, depth test, alpha blending, stenciling, etc) to the Direct3D 9 device
 Error Context::applyState(GLenum drawMode)
 {
+    syncDirtyBits();
+
+    bool pointDrawMode = (drawMode == GL_POINTS);
+    if (!mRenderStateDirty && pointDrawMode == mAppliedPointDrawMode &&
+        mRenderer->getAppliedStateSerial() == mRenderStateSerial)
+    {
+        return Error(GL_NO_ERROR);
+    }
+
     Framebuffer *framebufferObject = mState.getDrawFramebuffer();
     int samples = framebufferObject->getSamples();
 
     RasterizerState rasterizer = mState.getRasterizerState();
-    rasterizer.pointDrawMode = (drawMode == GL_POINTS);
+    rasterizer.pointDrawMode = pointDrawMode;
     rasterizer.multiSample = (samples != 0);
     rasterizer.reverseCullMode = mRenderer->isCurrentlyRenderingToBackBuffer();
 
@@ -1397,18 +1522,29 @@ Error Context::applyState(GLenum drawMode)
         return error;
     }
 
+    mRenderStateDirty = false;
+    mAppliedPointDrawMode = pointDrawMode;
+    mRenderStateSerial = mRenderer->getAppliedStateSerial();
+
     return Error(GL_NO_ERROR);
 }
 
 // Applies the shaders and shader constants to the Direct3D 9 device
 Error Context::applyShaders(ProgramBinary *programBinary, bool transformFeedbackActive)
 {
-    VertexFormat inputLayout[MAX_VERTEX_ATTRIBS];
-    VertexFormat::GetInputLayout(inputLayout, programBinary, mState);
+    syncDirtyBits();
+
+    // The input layout only changes with the program and the formats of the vertex attributes
+    if (mInputLayoutDirty || programBinary->getSerial() != mInputLayoutProgramSerial)
+    {
+        VertexFormat::GetInputLayout(mInputLayout, programBinary, mState);
+        mInputLayoutDirty = false;
+        mInputLayoutProgramSerial = programBinary->getSerial();
+    }
 
     const Framebuffer *fbo = mState.getDrawFramebuffer();
 
-    Error error = mRenderer->applyShaders(programBinary, inputLayout, fbo, mState.getRasterizerState().rasterizerDiscard, transformFeedbackActive);
+    Error error = mRenderer->applyShaders(programBinary, mInputLayout, fbo, mState.getRasterizerState().rasterizerDiscard, transformFeedbackActive);
     if (error.isError())
     {
         return error;
@@ -1460,32 +1596,60 @@ Error Context::generateSwizzles(ProgramBinary *programBinary)
 }
 
 // For each Direct3D sampler of either the pixel or vertex stage,
-// looks up the corresponding OpenGL texture image unit and texture type,
-// and sets the texture and its addressing/filtering state (or NULL when inactive).
-Error Context::applyTextures(ProgramBinary *programBinary, SamplerType shaderType,
-                             const FramebufferTextureSerialArray &framebufferSerials, size_t framebufferSerialCount)
+// looks up the corresponding OpenGL texture image unit, texture type and texture.
+void Context::updateSamplerTextures(ProgramBinary *programBinary, SamplerType shaderType,
+                                    const FramebufferTextureSerialArray &framebufferSerials, size_t framebufferSerialCount)
 {
-    size_t samplerRange = programBinary->getUsedSamplerRange(shaderType);
-    for (size_t samplerIndex = 0; samplerIndex < samplerRange; samplerIndex++)
+    SamplerTextureArray &samplerTextures = (shaderType == SAMPLER_PIXEL) ? mPixelSamplerTextures : mVertexSamplerTextures;
+    samplerTextures.resize(programBinary->getUsedSamplerRange(shaderType));
+
+    for (size_t samplerIndex = 0; samplerIndex < samplerTextures.size(); samplerIndex++)
     {
-        GLenum textureType = programBinary->getSamplerTextureType(shaderType, samplerIndex);
+        SamplerTexture &samplerTexture = samplerTextures[samplerIndex];
+
+        samplerTexture.textureType = programBinary->getSamplerTextureType(shaderType, samplerIndex);
+        samplerTexture.texture = NULL;
+        samplerTexture.samplerObject = NULL;
+        samplerTexture.boundToFramebuffer = false;
+
         GLint textureUnit = programBinary->getSamplerMapping(shaderType, samplerIndex, getCaps());
         if (textureUnit != -1)
         {
-            Texture *texture = getSamplerTexture(textureUnit, textureType);
-            SamplerState sampler = texture->getSamplerState();
+            samplerTexture.texture = getSamplerTexture(textureUnit, samplerTexture.textureType);
+            samplerTexture.samplerObject = mState.getSampler(textureUnit);
+
+            // TODO: std::binary_search may become unavailable using older versions of GCC
+            samplerTexture.boundToFramebuffer = std::binary_search(framebufferSerials.begin(), framebufferSerials.begin() + framebufferSerialCount,
+                                                                   samplerTexture.texture->getTextureSerial());
+        }
+    }
+}
+
+// For each Direct3D sampler of either the pixel or vertex stage, sets the texture found by
+// updateSamplerTextures and its addressing/filtering state (or NULL when inactive).
+Error Context::applyTextures(SamplerType shaderType)
+{
+    const SamplerTextureArray &samplerTextures = (shaderType == SAMPLER_PIXEL) ? mPixelSamplerTextures : mVertexSamplerTextures;
+    for (size_t samplerIndex = 0; samplerIndex < samplerTextures.size(); samplerIndex++)
+    {
+        const SamplerTexture &samplerTexture = samplerTextures[samplerIndex];
+        Texture *texture = samplerTexture.texture;
+        if (texture)
+        {
+            const SamplerState *sampler = &texture->getSamplerState();
 
-            Sampler *samplerObject = mState.getSampler(textureUnit);
-            if (samplerObject)
+            SamplerState samplerObjectState;
+            if (samplerTexture.samplerObject)
             {
-                samplerObject->getState(&sampler);
+                samplerObjectState = *sampler;
+                samplerTexture.samplerObject->getState(&samplerObjectState);
+                sampler = &samplerObjectState;
             }
 
-            // TODO: std::binary_search may become unavailable using older versions of GCC
-            if (texture->isSamplerComplete(sampler, mTextureCaps, mExtensions, mClientVersion) &&
-                !std::binary_search(framebufferSerials.begin(), framebufferSerials.begin() + framebufferSerialCount, texture->getTextureSerial()))
+            if (!samplerTexture.boundToFramebuffer &&
+                texture->isSamplerComplete(*sampler, mTextureCaps, mExtensions, mClientVersion))
             {
-                Error error = mRenderer->setSamplerState(shaderType, samplerIndex, texture, sampler);
+                Error error = mRenderer->setSamplerState(shaderType, samplerIndex, texture, *sampler);
                 if (error.isError())
                 {
                     return error;
@@ -1500,7 +1664,7 @@ Error Context::applyTextures(ProgramBinary *programBinary, SamplerType shaderTyp
             else
             {
                 // Texture is not sampler complete or it is in use by the framebuffer.  Bind the incomplete texture.
-                Texture *incompleteTexture = getIncompleteTexture(textureType);
+                Texture *incompleteTexture = getIncompleteTexture(samplerTexture.textureType);
                 gl::Error error = mRenderer->setTexture(shaderType, samplerIndex, incompleteTexture);
                 if (error.isError())
                 {
@@ -1522,7 +1686,7 @@ Error Context::applyTextures(ProgramBinary *programBinary, SamplerType shaderTyp
     // Set all the remaining textures to NULL
     size_t samplerCount = (shaderType == SAMPLER_PIXEL) ? mCaps.maxTextureImageUnits
                                                         : mCaps.maxVertexTextureImageUnits;
-    for (size_t samplerIndex = samplerRange; samplerIndex < samplerCount; samplerIndex++)
+    for (size_t samplerIndex = samplerTextures.size(); samplerIndex < samplerCount; samplerIndex++)
     {
         Error error = mRenderer->setTexture(shaderType, samplerIndex, NULL);
         if (error.isError())
@@ -1536,16 +1700,37 @@ Error Context::applyTextures(ProgramBinary *programBinary, SamplerType shaderTyp
 
 Error Context::applyTextures(ProgramBinary *programBinary)
 {
+    syncDirtyBits();
+
     FramebufferTextureSerialArray framebufferSerials;
     size_t framebufferSerialCount = getBoundFramebufferTextureSerials(&framebufferSerials);
 
-    Error error = applyTextures(programBinary, SAMPLER_VERTEX, framebufferSerials, framebufferSerialCount);
+    // The textures are applied on every draw regardless, as their images and sampler states may
+    // have changed since, and the renderer skips those that are already current
+    if (mSamplerTexturesDirty ||
+        programBinary->getSerial() != mSamplerTexturesProgramSerial ||
+        programBinary->getSamplerMappingSerial() != mSamplerTexturesMappingSerial ||
+        framebufferSerialCount != mSamplerTexturesFramebufferSerialCount ||
+        !std::equal(framebufferSerials.begin(), framebufferSerials.begin() + framebufferSerialCount,
+                    mSamplerTexturesFramebufferSerials.begin()))
+    {
+        updateSamplerTextures(programBinary, SAMPLER_VERTEX, framebufferSerials, framebufferSerialCount);
+        updateSamplerTextures(programBinary, SAMPLER_PIXEL, framebufferSerials, framebufferSerialCount);
+
+        mSamplerTexturesDirty = false;
+        mSamplerTexturesProgramSerial = programBinary->getSerial();
+        mSamplerTexturesMappingSerial = programBinary->getSamplerMappingSerial();
+        mSamplerTexturesFramebufferSerials = framebufferSerials;
+        mSamplerTexturesFramebufferSerialCount = framebufferSerialCount;
+    }
+
+    Error error = applyTextures(SAMPLER_VERTEX);
     if (error.isError())
     {
         return error;
     }
 
-    error = applyTextures(programBinary, SAMPLER_PIXEL, framebufferSerials, framebufferSerialCount);
+    error = applyTextures(SAMPLER_PIXEL);
     if (error.isError())
     {
         return error;
@@ -2032,6 +2217,7 @@ void Context::detachBuffer(GLuint buffer)
     {
         vaoIt->second->detachBuffer(buffer);
     }
+    mState.setDirtyBits(State::DIRTY_BIT_VERTEX_ATTRIB_BINDINGS);
 }
 
 void Context::detachFramebuffer(GLuint framebuffer)
@@ -2176,7 +2362,7 @@ bool Context::skipDraw(GLenum drawMode)
 
 void Context::setVertexAttribDivisor(GLuint index, GLuint divisor)
 {
-    mState.getVertexArray()->setVertexAttribDivisor(index, divisor);
+    mState.setVertexAttribDivisor(index, divisor);
 }
 
 void Context::samplerParameteri(GLuint sampler, GLenum pname, GLint param)
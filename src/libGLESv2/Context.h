@@ -15,6 +15,7 @@
 #include "libGLESv2/Caps.h"
 #include "libGLESv2/Error.h"
 #include "libGLESv2/HandleAllocator.h"
+#include "libGLESv2/ResourceMap.h"
 #include "libGLESv2/angletypes.h"
 #include "libGLESv2/Constants.h"
 #include "libGLESv2/VertexAttribute.h"
@@ -25,7 +26,6 @@
 #include <string>
 #include <set>
 #include <map>
-#include <unordered_map>
 #include <array>
 
 namespace rx
@@ -65,6 +65,24 @@ class VertexArray;
 class Sampler;
 class TransformFeedback;
 
+// What the vertex attributes of the current vertex array and program allow draw calls to do,
+// for draw call validation
+struct VertexAttribLimits
+{
+    // An enabled attribute reads from a mapped buffer
+    bool mappedArrayBuffer;
+
+    // An enabled attribute used by the program has neither a buffer nor a client pointer
+    bool missingVertexData;
+
+    // An attribute used by the program has a divisor of zero
+    bool activeNonInstancedAttribute;
+
+    // The largest maximum vertex and instance count the bound buffers hold enough data for
+    GLint64 maxVertexCount;
+    GLint64 maxInstanceCount;
+};
+
 class Context
 {
   public:
@@ -223,6 +241,8 @@ class Context
     State &getState() { return mState; }
     const State &getState() const { return mState; }
 
+    const VertexAttribLimits &getVertexAttribLimits();
+
     void releaseShaderCompiler();
 
   private:
@@ -231,11 +251,13 @@ class Context
     // TODO: std::array may become unavailable using older versions of GCC
     typedef std::array<unsigned int, IMPLEMENTATION_MAX_FRAMEBUFFER_ATTACHMENTS> FramebufferTextureSerialArray;
 
+    void syncDirtyBits();
     Error applyRenderTarget(GLenum drawMode, bool ignoreViewport);
     Error applyState(GLenum drawMode);
     Error applyShaders(ProgramBinary *programBinary, bool transformFeedbackActive);
-    Error applyTextures(ProgramBinary *programBinary, SamplerType shaderType, const FramebufferTextureSerialArray &framebufferSerials,
-                        size_t framebufferSerialCount);
+    void updateSamplerTextures(ProgramBinary *programBinary, SamplerType shaderType, const FramebufferTextureSerialArray &framebufferSerials,
+                               size_t framebufferSerialCount);
+    Error applyTextures(SamplerType shaderType);
     Error applyTextures(ProgramBinary *programBinary);
     Error applyUniformBuffers();
     bool applyTransformFeedbackBuffers();
@@ -277,24 +299,24 @@ class Context
     TextureMap mZeroTextures;
     TextureMap mIncompleteTextures;
 
-    typedef std::unordered_map<GLuint, Framebuffer*> FramebufferMap;
+    typedef ResourceMap<Framebuffer> FramebufferMap;
     FramebufferMap mFramebufferMap;
     HandleAllocator mFramebufferHandleAllocator;
 
-    typedef std::unordered_map<GLuint, FenceNV*> FenceNVMap;
+    typedef ResourceMap<FenceNV> FenceNVMap;
     FenceNVMap mFenceNVMap;
     HandleAllocator mFenceNVHandleAllocator;
 
-    typedef std::unordered_map<GLuint, Query*> QueryMap;
+    typedef ResourceMap<Query> QueryMap;
     QueryMap mQueryMap;
     HandleAllocator mQueryHandleAllocator;
 
-    typedef std::unordered_map<GLuint, VertexArray*> VertexArrayMap;
+    typedef ResourceMap<VertexArray> VertexArrayMap;
     VertexArrayMap mVertexArrayMap;
     HandleAllocator mVertexArrayHandleAllocator;
 
     BindingPointer<TransformFeedback> mTransformFeedbackZero;
-    typedef std::unordered_map<GLuint, TransformFeedback*> TransformFeedbackMap;
+    typedef ResourceMap<TransformFeedback> TransformFeedbackMap;
     TransformFeedbackMap mTransformFeedbackMap;
     HandleAllocator mTransformFeedbackAllocator;
 
@@ -302,6 +324,45 @@ class Context
     std::string mExtensionString;
     std::vector<std::string> mExtensionStrings;
 
+    // State applied by the last draw, which the next draw can skip applying while the dirty bits
+    // of the State and the applied state serial of the renderer say it is still current
+    bool mViewportDirty;
+    GLenum mAppliedViewportDrawMode;
+    bool mAppliedIgnoreViewport;
+    unsigned int mViewportStateSerial;
+
+    bool mRenderStateDirty;
+    bool mAppliedPointDrawMode;
+    unsigned int mRenderStateSerial;
+
+    bool mInputLayoutDirty;
+    unsigned int mInputLayoutProgramSerial;
+    VertexFormat mInputLayout[MAX_VERTEX_ATTRIBS];
+
+    bool mVertexAttribLimitsDirty;
+    unsigned int mVertexAttribLimitsProgramSerial;
+    unsigned int mVertexAttribLimitsStorageSerial;
+    VertexAttribLimits mVertexAttribLimits;
+
+    // The textures bound to each sampler of the program, looked up again only when the program, its sampler
+    // mapping, the texture or sampler bindings, or the textures attached to the draw framebuffer change
+    struct SamplerTexture
+    {
+        GLenum textureType;
+        Texture *texture;           // NULL when the sampler is not mapped to a texture unit
+        Sampler *samplerObject;
+        bool boundToFramebuffer;
+    };
+    typedef std::vector<SamplerTexture> SamplerTextureArray;
+
+    bool mSamplerTexturesDirty;
+    unsigned int mSamplerTexturesProgramSerial;
+    unsigned int mSamplerTexturesMappingSerial;
+    FramebufferTextureSerialArray mSamplerTexturesFramebufferSerials;
+    size_t mSamplerTexturesFramebufferSerialCount;
+    SamplerTextureArray mVertexSamplerTextures;
+    SamplerTextureArray mPixelSamplerTextures;
+
     // Recorded errors
     typedef std::set<GLenum> ErrorSet;
     ErrorSet mErrors;
@@ -75,7 +75,9 @@ Framebuffer::Framebuffer(rx::Renderer *renderer, GLuint id)
       mId(id),
       mReadBufferState(GL_COLOR_ATTACHMENT0_EXT),
       mDepthbuffer(NULL),
-      mStencilbuffer(NULL)
+      mStencilbuffer(NULL),
+      mCompleteness(GL_NONE),
+      mCompletenessClientVersion(0)
 {
     for (unsigned int colorAttachment = 0; colorAttachment < IMPLEMENTATION_MAX_DRAW_BUFFERS; colorAttachment++)
     {
@@ -177,6 +179,8 @@ FramebufferAttachment *Framebuffer::createAttachment(GLenum binding, GLenum type
 
 void Framebuffer::setColorbuffer(unsigned int colorAttachment, GLenum type, GLuint colorbuffer, GLint level, GLint layer)
 {
+    mCompleteness = GL_NONE;
+
     ASSERT(colorAttachment < IMPLEMENTATION_MAX_DRAW_BUFFERS);
     SafeDelete(mColorbuffers[colorAttachment]);
     GLenum binding = colorAttachment + GL_COLOR_ATTACHMENT0;
@@ -185,18 +189,24 @@ void Framebuffer::setColorbuffer(unsigned int colorAttachment, GLenum type, GLui
 
 void Framebuffer::setDepthbuffer(GLenum type, GLuint depthbuffer, GLint level, GLint layer)
 {
+    mCompleteness = GL_NONE;
+
     SafeDelete(mDepthbuffer);
     mDepthbuffer = createAttachment(GL_DEPTH_ATTACHMENT, type, depthbuffer, level, layer);
 }
 
 void Framebuffer::setStencilbuffer(GLenum type, GLuint stencilbuffer, GLint level, GLint layer)
 {
+    mCompleteness = GL_NONE;
+
     SafeDelete(mStencilbuffer);
     mStencilbuffer = createAttachment(GL_STENCIL_ATTACHMENT, type, stencilbuffer, level, layer);
 }
 
 void Framebuffer::setDepthStencilBuffer(GLenum type, GLuint depthStencilBuffer, GLint level, GLint layer)
 {
+    mCompleteness = GL_NONE;
+
     FramebufferAttachment *attachment = createAttachment(GL_DEPTH_STENCIL_ATTACHMENT, type, depthStencilBuffer, level, layer);
 
     SafeDelete(mDepthbuffer);
@@ -215,6 +225,8 @@ void Framebuffer::setDepthStencilBuffer(GLenum type, GLuint depthStencilBuffer,
 
 void Framebuffer::detachTexture(GLuint textureId)
 {
+    mCompleteness = GL_NONE;
+
     for (unsigned int colorAttachment = 0; colorAttachment < IMPLEMENTATION_MAX_DRAW_BUFFERS; colorAttachment++)
     {
         FramebufferAttachment *attachment = mColorbuffers[colorAttachment];
@@ -238,6 +250,8 @@ void Framebuffer::detachTexture(GLuint textureId)
 
 void Framebuffer::detachRenderbuffer(GLuint renderbufferId)
 {
+    mCompleteness = GL_NONE;
+
     for (unsigned int colorAttachment = 0; colorAttachment < IMPLEMENTATION_MAX_DRAW_BUFFERS; colorAttachment++)
     {
         FramebufferAttachment *attachment = mColorbuffers[colorAttachment];
@@ -387,6 +401,30 @@ bool Framebuffer::usingExtendedDrawBuffers() const
 }
 
 GLenum Framebuffer::completeness() const
+{
+    unsigned int definitionSerials[IMPLEMENTATION_MAX_DRAW_BUFFERS + 2];
+    for (unsigned int colorAttachment = 0; colorAttachment < IMPLEMENTATION_MAX_DRAW_BUFFERS; colorAttachment++)
+    {
+        const FramebufferAttachment *colorbuffer = mColorbuffers[colorAttachment];
+        definitionSerials[colorAttachment] = (colorbuffer ? colorbuffer->getDefinitionSerial() : 0);
+    }
+    definitionSerials[IMPLEMENTATION_MAX_DRAW_BUFFERS] = (mDepthbuffer ? mDepthbuffer->getDefinitionSerial() : 0);
+    definitionSerials[IMPLEMENTATION_MAX_DRAW_BUFFERS + 1] = (mStencilbuffer ? mStencilbuffer->getDefinitionSerial() : 0);
+
+    GLuint clientVersion = mRenderer->getCurrentClientVersion();
+
+    if (mCompleteness == GL_NONE || clientVersion != mCompletenessClientVersion ||
+        memcmp(definitionSerials, mCompletenessDefinitionSerials, sizeof(definitionSerials)) != 0)
+    {
+        mCompleteness = checkCompleteness();
+        mCompletenessClientVersion = clientVersion;
+        memcpy(mCompletenessDefinitionSerials, definitionSerials, sizeof(definitionSerials));
+    }
+
+    return mCompleteness;
+}
+
+GLenum Framebuffer::checkCompleteness() const
 {
     int width = 0;
     int height = 0;
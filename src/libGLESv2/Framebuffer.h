@@ -98,6 +98,13 @@ class Framebuffer
     DISALLOW_COPY_AND_ASSIGN(Framebuffer);
 
     FramebufferAttachment *createAttachment(GLenum binding, GLenum type, GLuint handle, GLint level, GLint layer) const;
+    GLenum checkCompleteness() const;
+
+    // Every draw call checks the completeness, so it is only checked again after the attachments
+    // changed or one of the attached images was redefined. GL_NONE when it must be checked again.
+    mutable GLenum mCompleteness;
+    mutable GLuint mCompletenessClientVersion;
+    mutable unsigned int mCompletenessDefinitionSerials[IMPLEMENTATION_MAX_DRAW_BUFFERS + 2];
 };
 
 class DefaultFramebuffer : public Framebuffer
@@ -95,6 +95,11 @@ GLsizei TextureAttachment::getSamples() const
     return 0;
 }
 
+unsigned int TextureAttachment::getDefinitionSerial() const
+{
+    return mTexture->getDefinitionSerial();
+}
+
 GLuint TextureAttachment::id() const
 {
     return mTexture->id();
@@ -190,6 +195,11 @@ GLsizei RenderbufferAttachment::getSamples() const
     return mRenderbuffer->getStorage()->getSamples();
 }
 
+unsigned int RenderbufferAttachment::getDefinitionSerial() const
+{
+    return mRenderbuffer->getStorageSerial();
+}
+
 GLuint RenderbufferAttachment::id() const
 {
     return mRenderbuffer->id();
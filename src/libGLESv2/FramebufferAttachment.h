@@ -62,6 +62,9 @@ class FramebufferAttachment
     virtual GLenum getActualFormat() const = 0;
     virtual GLsizei getSamples() const = 0;
 
+    // Changes whenever the size or format of the attached image may have changed
+    virtual unsigned int getDefinitionSerial() const = 0;
+
     virtual GLuint id() const = 0;
     virtual GLenum type() const = 0;
     virtual GLint mipLevel() const = 0;
@@ -84,6 +87,7 @@ class TextureAttachment : public FramebufferAttachment
     virtual ~TextureAttachment();
 
     virtual GLsizei getSamples() const;
+    virtual unsigned int getDefinitionSerial() const;
     virtual GLuint id() const;
 
     virtual GLsizei getWidth() const;
@@ -118,6 +122,7 @@ class RenderbufferAttachment : public FramebufferAttachment
     virtual GLenum getInternalFormat() const;
     virtual GLenum getActualFormat() const;
     virtual GLsizei getSamples() const;
+    virtual unsigned int getDefinitionSerial() const;
 
     virtual GLuint id() const;
     virtual GLenum type() const;
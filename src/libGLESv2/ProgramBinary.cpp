@@ -80,6 +80,7 @@ ProgramBinary::ProgramBinary(rx::ProgramImpl *impl)
     : RefCountObject(0),
       mProgram(impl),
       mValidated(false),
+      mBinaryCacheRevision(0),
       mSerial(issueSerial())
 {
     ASSERT(impl);
@@ -112,7 +113,7 @@ GLuint ProgramBinary::getAttributeLocation(const char *name)
     {
         for (int index = 0; index < MAX_VERTEX_ATTRIBS; index++)
         {
-            if (mLinkedAttribute[index].name == std::string(name))
+            if (mLinkedAttribute[index].name == name)
             {
                 return index;
             }
@@ -150,17 +151,17 @@ GLenum ProgramBinary::getSamplerTextureType(SamplerType type, unsigned int sampl
     return mProgram->getSamplerTextureType(type, samplerIndex);
 }
 
-GLint ProgramBinary::getUniformLocation(std::string name)
+GLint ProgramBinary::getUniformLocation(const char *name)
 {
     return mProgram->getUniformLocation(name);
 }
 
-GLuint ProgramBinary::getUniformIndex(std::string name)
+GLuint ProgramBinary::getUniformIndex(const char *name)
 {
     return mProgram->getUniformIndex(name);
 }
 
-GLuint ProgramBinary::getUniformBlockIndex(std::string name)
+GLuint ProgramBinary::getUniformBlockIndex(const char *name)
 {
     return mProgram->getUniformBlockIndex(name);
 }
@@ -305,6 +306,12 @@ void ProgramBinary::updateSamplerMapping()
     return mProgram->updateSamplerMapping();
 }
 
+// Changes whenever updateSamplerMapping assigns the samplers to different texture units
+unsigned int ProgramBinary::getSamplerMappingSerial() const
+{
+    return mProgram->getSamplerMappingSerial();
+}
+
 // Applies all the uniforms set for this program object to the renderer
 Error ProgramBinary::applyUniforms()
 {
@@ -419,15 +426,25 @@ LinkResult ProgramBinary::load(InfoLog &infoLog, GLenum binaryFormat, const void
         return result;
     }
 
+    mProgram->indexNames();
+
+    // Saving the program again would write back exactly what was loaded
+    if (stream.endOfStream())
+    {
+        const unsigned char *bytes = static_cast<const unsigned char*>(binary);
+        mBinaryCache.assign(bytes, bytes + length);
+        mBinaryCacheRevision = mProgram->getBinaryRevision();
+    }
+
     return LinkResult(true, Error(GL_NO_ERROR));
 #endif // #if ANGLE_PROGRAM_BINARY_LOAD == ANGLE_ENABLED
 }
 
-Error ProgramBinary::save(GLenum *binaryFormat, void *binary, GLsizei bufSize, GLsizei *length)
+void ProgramBinary::updateBinaryCache()
 {
-    if (binaryFormat)
+    if (!mBinaryCache.empty() && mBinaryCacheRevision == mProgram->getBinaryRevision())
     {
-        *binaryFormat = mProgram->getBinaryFormat();
+        return;
     }
 
     BinaryOutputStream stream;
@@ -449,8 +466,21 @@ Error ProgramBinary::save(GLenum *binaryFormat, void *binary, GLsizei bufSize, G
 
     mProgram->save(&stream);
 
-    GLsizei streamLength = stream.length();
-    const void *streamData = stream.data();
+    const unsigned char *streamData = static_cast<const unsigned char*>(stream.data());
+    mBinaryCache.assign(streamData, streamData + stream.length());
+    mBinaryCacheRevision = mProgram->getBinaryRevision();
+}
+
+Error ProgramBinary::save(GLenum *binaryFormat, void *binary, GLsizei bufSize, GLsizei *length)
+{
+    if (binaryFormat)
+    {
+        *binaryFormat = mProgram->getBinaryFormat();
+    }
+
+    updateBinaryCache();
+
+    GLsizei streamLength = mBinaryCache.size();
 
     if (streamLength > bufSize)
     {
@@ -459,20 +489,14 @@ Error ProgramBinary::save(GLenum *binaryFormat, void *binary, GLsizei bufSize, G
             *length = 0;
         }
 
-        // TODO: This should be moved to the validation layer but computing the size of the binary before saving
-        // it causes the save to happen twice.  It may be possible to write the binary to a separate buffer, validate
-        // sizes and then copy it.
+        // TODO: This should be moved to the validation layer, which can now query the length
+        // without serializing the program again.
         return Error(GL_INVALID_OPERATION);
     }
 
-    if (binary)
+    if (binary && streamLength > 0)
     {
-        char *ptr = (char*) binary;
-
-        memcpy(ptr, streamData, streamLength);
-        ptr += streamLength;
-
-        ASSERT(ptr - streamLength == binary);
+        memcpy(binary, &mBinaryCache[0], streamLength);
     }
 
     if (length)
@@ -485,14 +509,8 @@ Error ProgramBinary::save(GLenum *binaryFormat, void *binary, GLsizei bufSize, G
 
 GLint ProgramBinary::getLength()
 {
-    GLint length;
-    Error error = save(NULL, NULL, INT_MAX, &length);
-    if (error.isError())
-    {
-        return 0;
-    }
-
-    return length;
+    updateBinaryCache();
+    return mBinaryCache.size();
 }
 
 LinkResult ProgramBinary::link(InfoLog &infoLog, const AttributeBindings &attributeBindings, Shader *fragmentShader, Shader *vertexShader,
@@ -552,6 +570,8 @@ LinkResult ProgramBinary::link(InfoLog &infoLog, const AttributeBindings &attrib
         return result;
     }
 
+    mProgram->indexNames();
+
     return LinkResult(true, Error(GL_NO_ERROR));
 }
 
@@ -1222,6 +1242,7 @@ void ProgramBinary::sortAttributesByLayout(rx::TranslatedAttribute attributes[MA
 void ProgramBinary::reset()
 {
     mOutputVariables.clear();
+    mBinaryCache.clear();
 
     mProgram->reset();
 
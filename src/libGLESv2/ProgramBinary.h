@@ -110,11 +110,12 @@ class ProgramBinary : public RefCountObject
     GLint getSamplerMapping(SamplerType type, unsigned int samplerIndex, const Caps &caps);
     GLenum getSamplerTextureType(SamplerType type, unsigned int samplerIndex);
     GLint getUsedSamplerRange(SamplerType type);
+    unsigned int getSamplerMappingSerial() const;
     bool usesPointSize() const;
 
-    GLint getUniformLocation(std::string name);
-    GLuint getUniformIndex(std::string name);
-    GLuint getUniformBlockIndex(std::string name);
+    GLint getUniformLocation(const char *name);
+    GLuint getUniformIndex(const char *name);
+    GLuint getUniformBlockIndex(const char *name);
     void setUniform1fv(GLint location, GLsizei count, const GLfloat *v);
     void setUniform2fv(GLint location, GLsizei count, const GLfloat *v);
     void setUniform3fv(GLint location, GLsizei count, const GLfloat *v);
@@ -214,6 +215,7 @@ class ProgramBinary : public RefCountObject
                                                const Caps &caps) const;
     bool assignUniformBlockRegister(InfoLog &infoLog, UniformBlock *uniformBlock, GLenum shader, unsigned int registerIndex, const Caps &caps);
     void defineOutputVariables(Shader *fragmentShader);
+    void updateBinaryCache();
 
     rx::ProgramImpl *mProgram;
 
@@ -225,6 +227,11 @@ class ProgramBinary : public RefCountObject
 
     bool mValidated;
 
+    // The serialized program, reused by save and getLength until the implementation's binary
+    // revision changes. Empty when it has not been serialized since the last link or load.
+    std::vector<unsigned char> mBinaryCache;
+    unsigned int mBinaryCacheRevision;
+
     const unsigned int mSerial;
 
     static unsigned int issueSerial();
@@ -47,6 +47,12 @@ RenderbufferStorage *Renderbuffer::getStorage()
     return mStorage;
 }
 
+unsigned int Renderbuffer::getStorageSerial() const
+{
+    ASSERT(mStorage);
+    return mStorage->getSerial();
+}
+
 GLsizei Renderbuffer::getWidth() const
 {
     ASSERT(mStorage);
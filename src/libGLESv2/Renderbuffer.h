@@ -43,6 +43,7 @@ class Renderbuffer : public RefCountObject
 
     void setStorage(RenderbufferStorage *newStorage);
     RenderbufferStorage *getStorage();
+    unsigned int getStorageSerial() const;
 
     GLsizei getWidth() const;
     GLsizei getHeight() const;
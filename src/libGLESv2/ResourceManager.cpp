@@ -82,7 +82,7 @@ GLuint ResourceManager::createBuffer()
 {
     GLuint handle = mBufferHandleAllocator.allocate();
 
-    mBufferMap[handle] = NULL;
+    mBufferMap.assign(handle, NULL);
 
     return handle;
 }
@@ -94,7 +94,7 @@ GLuint ResourceManager::createShader(GLenum type)
 
     if (type == GL_VERTEX_SHADER || type == GL_FRAGMENT_SHADER)
     {
-        mShaderMap[handle] = new Shader(this, mRenderer->createShader(type), type, handle);
+        mShaderMap.assign(handle, new Shader(this, mRenderer->createShader(type), type, handle));
     }
     else UNREACHABLE();
 
@@ -106,7 +106,7 @@ GLuint ResourceManager::createProgram()
 {
     GLuint handle = mProgramShaderHandleAllocator.allocate();
 
-    mProgramMap[handle] = new Program(mRenderer, this, handle);
+    mProgramMap.assign(handle, new Program(mRenderer, this, handle));
 
     return handle;
 }
@@ -116,7 +116,7 @@ GLuint ResourceManager::createTexture()
 {
     GLuint handle = mTextureHandleAllocator.allocate();
 
-    mTextureMap[handle] = NULL;
+    mTextureMap.assign(handle, NULL);
 
     return handle;
 }
@@ -126,7 +126,7 @@ GLuint ResourceManager::createRenderbuffer()
 {
     GLuint handle = mRenderbufferHandleAllocator.allocate();
 
-    mRenderbufferMap[handle] = NULL;
+    mRenderbufferMap.assign(handle, NULL);
 
     return handle;
 }
@@ -136,7 +136,7 @@ GLuint ResourceManager::createSampler()
 {
     GLuint handle = mSamplerHandleAllocator.allocate();
 
-    mSamplerMap[handle] = NULL;
+    mSamplerMap.assign(handle, NULL);
 
     return handle;
 }
@@ -148,212 +148,144 @@ GLuint ResourceManager::createFenceSync()
 
     FenceSync *fenceSync = new FenceSync(mRenderer->createFenceSync(), handle);
     fenceSync->addRef();
-    mFenceSyncMap[handle] = fenceSync;
+    mFenceSyncMap.assign(handle, fenceSync);
 
     return handle;
 }
 
 void ResourceManager::deleteBuffer(GLuint buffer)
 {
-    BufferMap::iterator bufferObject = mBufferMap.find(buffer);
-
-    if (bufferObject != mBufferMap.end())
+    if (mBufferMap.contains(buffer))
     {
-        mBufferHandleAllocator.release(bufferObject->first);
-        if (bufferObject->second) bufferObject->second->release();
-        mBufferMap.erase(bufferObject);
+        Buffer *bufferObject = mBufferMap.query(buffer);
+        mBufferHandleAllocator.release(buffer);
+        if (bufferObject) bufferObject->release();
+        mBufferMap.erase(buffer);
     }
 }
 
 void ResourceManager::deleteShader(GLuint shader)
 {
-    ShaderMap::iterator shaderObject = mShaderMap.find(shader);
+    Shader *shaderObject = mShaderMap.query(shader);
 
-    if (shaderObject != mShaderMap.end())
+    if (shaderObject)
     {
-        if (shaderObject->second->getRefCount() == 0)
+        if (shaderObject->getRefCount() == 0)
         {
-            mProgramShaderHandleAllocator.release(shaderObject->first);
-            delete shaderObject->second;
-            mShaderMap.erase(shaderObject);
+            mProgramShaderHandleAllocator.release(shader);
+            delete shaderObject;
+            mShaderMap.erase(shader);
         }
         else
         {
-            shaderObject->second->flagForDeletion();
+            shaderObject->flagForDeletion();
         }
     }
 }
 
 void ResourceManager::deleteProgram(GLuint program)
 {
-    ProgramMap::iterator programObject = mProgramMap.find(program);
+    Program *programObject = mProgramMap.query(program);
 
-    if (programObject != mProgramMap.end())
+    if (programObject)
     {
-        if (programObject->second->getRefCount() == 0)
+        if (programObject->getRefCount() == 0)
         {
-            mProgramShaderHandleAllocator.release(programObject->first);
-            delete programObject->second;
-            mProgramMap.erase(programObject);
+            mProgramShaderHandleAllocator.release(program);
+            delete programObject;
+            mProgramMap.erase(program);
         }
         else
         { 
-            programObject->second->flagForDeletion();
+            programObject->flagForDeletion();
         }
     }
 }
 
 void ResourceManager::deleteTexture(GLuint texture)
 {
-    TextureMap::iterator textureObject = mTextureMap.find(texture);
-
-    if (textureObject != mTextureMap.end())
+    if (mTextureMap.contains(texture))
     {
-        mTextureHandleAllocator.release(textureObject->first);
-        if (textureObject->second) textureObject->second->release();
-        mTextureMap.erase(textureObject);
+        Texture *textureObject = mTextureMap.query(texture);
+        mTextureHandleAllocator.release(texture);
+        if (textureObject) textureObject->release();
+        mTextureMap.erase(texture);
     }
 }
 
 void ResourceManager::deleteRenderbuffer(GLuint renderbuffer)
 {
-    RenderbufferMap::iterator renderbufferObject = mRenderbufferMap.find(renderbuffer);
-
-    if (renderbufferObject != mRenderbufferMap.end())
+    if (mRenderbufferMap.contains(renderbuffer))
     {
-        mRenderbufferHandleAllocator.release(renderbufferObject->first);
-        if (renderbufferObject->second) renderbufferObject->second->release();
-        mRenderbufferMap.erase(renderbufferObject);
+        Renderbuffer *renderbufferObject = mRenderbufferMap.query(renderbuffer);
+        mRenderbufferHandleAllocator.release(renderbuffer);
+        if (renderbufferObject) renderbufferObject->release();
+        mRenderbufferMap.erase(renderbuffer);
     }
 }
 
 void ResourceManager::deleteSampler(GLuint sampler)
 {
-    auto samplerObject = mSamplerMap.find(sampler);
-
-    if (samplerObject != mSamplerMap.end())
+    if (mSamplerMap.contains(sampler))
     {
-        mSamplerHandleAllocator.release(samplerObject->first);
-        if (samplerObject->second) samplerObject->second->release();
-        mSamplerMap.erase(samplerObject);
+        Sampler *samplerObject = mSamplerMap.query(sampler);
+        mSamplerHandleAllocator.release(sampler);
+        if (samplerObject) samplerObject->release();
+        mSamplerMap.erase(sampler);
     }
 }
 
 void ResourceManager::deleteFenceSync(GLuint fenceSync)
 {
-    auto fenceObjectIt = mFenceSyncMap.find(fenceSync);
-
-    if (fenceObjectIt != mFenceSyncMap.end())
+    if (mFenceSyncMap.contains(fenceSync))
     {
-        mFenceSyncHandleAllocator.release(fenceObjectIt->first);
-        if (fenceObjectIt->second) fenceObjectIt->second->release();
-        mFenceSyncMap.erase(fenceObjectIt);
+        FenceSync *fenceObject = mFenceSyncMap.query(fenceSync);
+        mFenceSyncHandleAllocator.release(fenceSync);
+        if (fenceObject) fenceObject->release();
+        mFenceSyncMap.erase(fenceSync);
     }
 }
 
 Buffer *ResourceManager::getBuffer(unsigned int handle)
 {
-    BufferMap::iterator buffer = mBufferMap.find(handle);
-
-    if (buffer == mBufferMap.end())
-    {
-        return NULL;
-    }
-    else
-    {
-        return buffer->second;
-    }
+    return mBufferMap.query(handle);
 }
 
 Shader *ResourceManager::getShader(unsigned int handle)
 {
-    ShaderMap::iterator shader = mShaderMap.find(handle);
-
-    if (shader == mShaderMap.end())
-    {
-        return NULL;
-    }
-    else
-    {
-        return shader->second;
-    }
+    return mShaderMap.query(handle);
 }
 
 Texture *ResourceManager::getTexture(unsigned int handle)
 {
     if (handle == 0) return NULL;
 
-    TextureMap::iterator texture = mTextureMap.find(handle);
-
-    if (texture == mTextureMap.end())
-    {
-        return NULL;
-    }
-    else
-    {
-        return texture->second;
-    }
+    return mTextureMap.query(handle);
 }
 
 Program *ResourceManager::getProgram(unsigned int handle)
 {
-    ProgramMap::iterator program = mProgramMap.find(handle);
-
-    if (program == mProgramMap.end())
-    {
-        return NULL;
-    }
-    else
-    {
-        return program->second;
-    }
+    return mProgramMap.query(handle);
 }
 
 Renderbuffer *ResourceManager::getRenderbuffer(unsigned int handle)
 {
-    RenderbufferMap::iterator renderbuffer = mRenderbufferMap.find(handle);
-
-    if (renderbuffer == mRenderbufferMap.end())
-    {
-        return NULL;
-    }
-    else
-    {
-        return renderbuffer->second;
-    }
+    return mRenderbufferMap.query(handle);
 }
 
 Sampler *ResourceManager::getSampler(unsigned int handle)
 {
-    auto sampler = mSamplerMap.find(handle);
-
-    if (sampler == mSamplerMap.end())
-    {
-        return NULL;
-    }
-    else
-    {
-        return sampler->second;
-    }
+    return mSamplerMap.query(handle);
 }
 
 FenceSync *ResourceManager::getFenceSync(unsigned int handle)
 {
-    auto fenceObjectIt = mFenceSyncMap.find(handle);
-
-    if (fenceObjectIt == mFenceSyncMap.end())
-    {
-        return NULL;
-    }
-    else
-    {
-        return fenceObjectIt->second;
-    }
+    return mFenceSyncMap.query(handle);
 }
 
 void ResourceManager::setRenderbuffer(GLuint handle, Renderbuffer *buffer)
 {
-    mRenderbufferMap[handle] = buffer;
+    mRenderbufferMap.assign(handle, buffer);
 }
 
 void ResourceManager::checkBufferAllocation(unsigned int buffer)
@@ -361,7 +293,7 @@ void ResourceManager::checkBufferAllocation(unsigned int buffer)
     if (buffer != 0 && !getBuffer(buffer))
     {
         Buffer *bufferObject = new Buffer(mRenderer->createBuffer(), buffer);
-        mBufferMap[buffer] = bufferObject;
+        mBufferMap.assign(buffer, bufferObject);
         bufferObject->addRef();
     }
 }
@@ -394,7 +326,7 @@ void ResourceManager::checkTextureAllocation(GLuint texture, GLenum type)
             return;
         }
 
-        mTextureMap[texture] = textureObject;
+        mTextureMap.assign(texture, textureObject);
         textureObject->addRef();
     }
 }
@@ -404,7 +336,7 @@ void ResourceManager::checkRenderbufferAllocation(GLuint renderbuffer)
     if (renderbuffer != 0 && !getRenderbuffer(renderbuffer))
     {
         Renderbuffer *renderbufferObject = new Renderbuffer(renderbuffer, new Colorbuffer(mRenderer, 0, 0, GL_RGBA4, 0));
-        mRenderbufferMap[renderbuffer] = renderbufferObject;
+        mRenderbufferMap.assign(renderbuffer, renderbufferObject);
         renderbufferObject->addRef();
     }
 }
@@ -414,14 +346,14 @@ void ResourceManager::checkSamplerAllocation(GLuint sampler)
     if (sampler != 0 && !getSampler(sampler))
     {
         Sampler *samplerObject = new Sampler(sampler);
-        mSamplerMap[sampler] = samplerObject;
+        mSamplerMap.assign(sampler, samplerObject);
         samplerObject->addRef();
     }
 }
 
 bool ResourceManager::isSampler(GLuint sampler)
 {
-    return mSamplerMap.find(sampler) != mSamplerMap.end();
+    return mSamplerMap.contains(sampler);
 }
 
 }
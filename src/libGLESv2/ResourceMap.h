@@ -0,0 +1,237 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// ResourceMap.h: Defines the gl::ResourceMap class template, which maps GL handles to the
+// objects they name.
+
+#ifndef LIBGLESV2_RESOURCEMAP_H_
+#define LIBGLESV2_RESOURCEMAP_H_
+
+#include "common/angleutils.h"
+
+#include "angle_gl.h"
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace gl
+{
+
+// Handles from a HandleAllocator are small and dense, so their objects are kept in a vector
+// indexed by the handle. The names an application chooses itself (by binding a name it did not
+// generate) can be anything, and those above the size of the vector are hashed instead.
+// A handle can be in the map without an object, between its generation and its first bind.
+template <typename ResourceType>
+class ResourceMap
+{
+  private:
+    struct FlatEntry
+    {
+        FlatEntry() : present(false), object(NULL) {}
+
+        bool present;
+        ResourceType *object;
+    };
+
+    typedef std::vector<FlatEntry> FlatTable;
+    typedef std::unordered_map<GLuint, ResourceType*> HashTable;
+
+  public:
+    typedef std::pair<GLuint, ResourceType*> value_type;
+
+    // Visits the handles of the vector in order, then the hashed ones. Any change to the map
+    // invalidates it.
+    class const_iterator
+    {
+      public:
+        const value_type &operator*() const { return mValue; }
+        const value_type *operator->() const { return &mValue; }
+
+        const_iterator &operator++()
+        {
+            if (mFlatIndex < mMap->mFlatResources.size())
+            {
+                mFlatIndex++;
+            }
+            else
+            {
+                mHashIterator++;
+            }
+            skipAbsent();
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator previous = *this;
+            ++(*this);
+            return previous;
+        }
+
+        bool operator==(const const_iterator &other) const
+        {
+            return mFlatIndex == other.mFlatIndex && mHashIterator == other.mHashIterator;
+        }
+
+        bool operator!=(const const_iterator &other) const
+        {
+            return !(*this == other);
+        }
+
+      private:
+        friend class ResourceMap;
+
+        const_iterator(const ResourceMap *map, size_t flatIndex, typename HashTable::const_iterator hashIterator)
+            : mMap(map),
+              mFlatIndex(flatIndex),
+              mHashIterator(hashIterator),
+              mValue(0, NULL)
+        {
+            skipAbsent();
+        }
+
+        void skipAbsent()
+        {
+            const FlatTable &flatResources = mMap->mFlatResources;
+            while (mFlatIndex < flatResources.size() && !flatResources[mFlatIndex].present)
+            {
+                mFlatIndex++;
+            }
+
+            if (mFlatIndex < flatResources.size())
+            {
+                mValue = value_type(static_cast<GLuint>(mFlatIndex), flatResources[mFlatIndex].object);
+            }
+            else if (mHashIterator != mMap->mHashedResources.end())
+            {
+                mValue = *mHashIterator;
+            }
+        }
+
+        const ResourceMap *mMap;
+        size_t mFlatIndex;
+        typename HashTable::const_iterator mHashIterator;
+        value_type mValue;
+    };
+
+    ResourceMap()
+        : mFlatCount(0),
+          mFlatBegin(0)
+    {
+    }
+
+    bool contains(GLuint handle) const
+    {
+        if (handle < mFlatResources.size())
+        {
+            return mFlatResources[handle].present;
+        }
+        return mHashedResources.find(handle) != mHashedResources.end();
+    }
+
+    // Returns NULL for handles without an object as well as for those not in the map
+    ResourceType *query(GLuint handle) const
+    {
+        if (handle < mFlatResources.size())
+        {
+            return mFlatResources[handle].object;
+        }
+
+        typename HashTable::const_iterator iter = mHashedResources.find(handle);
+        return (iter != mHashedResources.end()) ? iter->second : NULL;
+    }
+
+    // Adds the handle to the map, or replaces its object
+    void assign(GLuint handle, ResourceType *object)
+    {
+        if (handle < FlatLimit)
+        {
+            if (handle >= mFlatResources.size())
+            {
+                mFlatResources.resize(handle + 1);
+            }
+
+            FlatEntry &entry = mFlatResources[handle];
+            if (!entry.present)
+            {
+                entry.present = true;
+                mFlatCount++;
+                if (handle < mFlatBegin)
+                {
+                    mFlatBegin = handle;
+                }
+            }
+            entry.object = object;
+        }
+        else
+        {
+            mHashedResources[handle] = object;
+        }
+    }
+
+    void erase(GLuint handle)
+    {
+        if (handle < mFlatResources.size())
+        {
+            FlatEntry &entry = mFlatResources[handle];
+            if (entry.present)
+            {
+                entry.present = false;
+                entry.object = NULL;
+                mFlatCount--;
+            }
+        }
+        else
+        {
+            mHashedResources.erase(handle);
+        }
+    }
+
+    bool empty() const
+    {
+        return mFlatCount == 0 && mHashedResources.empty();
+    }
+
+    size_t size() const
+    {
+        return mFlatCount + mHashedResources.size();
+    }
+
+    const_iterator begin() const
+    {
+        // Deleting every object of the map by deleting the first one until it is empty would
+        // otherwise scan the vector from the start for each of them
+        while (mFlatBegin < mFlatResources.size() && !mFlatResources[mFlatBegin].present)
+        {
+            mFlatBegin++;
+        }
+        return const_iterator(this, mFlatBegin, mHashedResources.begin());
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(this, mFlatResources.size(), mHashedResources.end());
+    }
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(ResourceMap);
+
+    // Handles below this are kept in the vector, which never grows larger
+    static const GLuint FlatLimit = 0x4000;
+
+    FlatTable mFlatResources;
+    size_t mFlatCount;
+
+    // None of the handles of the vector below this is in the map
+    mutable size_t mFlatBegin;
+
+    HashTable mHashedResources;
+};
+
+}
+
+#endif // LIBGLESV2_RESOURCEMAP_H_
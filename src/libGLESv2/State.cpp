@@ -24,6 +24,7 @@ State::State()
 {
     mMaxDrawBuffers = 0;
     mMaxCombinedTextureImageUnits = 0;
+    mDirtyBits = DIRTY_BIT_ALL;
 }
 
 State::~State()
@@ -189,6 +190,21 @@ void State::reset()
     mUnpack.pixelBuffer.set(NULL);
 }
 
+State::DirtyBits State::getDirtyBits() const
+{
+    return mDirtyBits;
+}
+
+void State::setDirtyBits(DirtyBits dirtyBits)
+{
+    mDirtyBits |= dirtyBits;
+}
+
+void State::clearDirtyBits(DirtyBits dirtyBits)
+{
+    mDirtyBits &= ~dirtyBits;
+}
+
 const RasterizerState &State::getRasterizerState() const
 {
     return mRasterizer;
@@ -284,11 +300,13 @@ void State::setColorMask(bool red, bool green, bool blue, bool alpha)
     mBlend.colorMaskGreen = green;
     mBlend.colorMaskBlue = blue;
     mBlend.colorMaskAlpha = alpha;
+    mDirtyBits |= DIRTY_BIT_BLEND_STATE;
 }
 
 void State::setDepthMask(bool mask)
 {
     mDepthStencil.depthMask = mask;
+    mDirtyBits |= DIRTY_BIT_DEPTH_STENCIL_STATE;
 }
 
 bool State::isRasterizerDiscardEnabled() const
@@ -299,6 +317,7 @@ bool State::isRasterizerDiscardEnabled() const
 void State::setRasterizerDiscard(bool enabled)
 {
     mRasterizer.rasterizerDiscard = enabled;
+    mDirtyBits |= DIRTY_BIT_RASTERIZER_STATE;
 }
 
 bool State::isCullFaceEnabled() const
@@ -309,16 +328,19 @@ bool State::isCullFaceEnabled() const
 void State::setCullFace(bool enabled)
 {
     mRasterizer.cullFace = enabled;
+    mDirtyBits |= DIRTY_BIT_RASTERIZER_STATE;
 }
 
 void State::setCullMode(GLenum mode)
 {
     mRasterizer.cullMode = mode;
+    mDirtyBits |= DIRTY_BIT_RASTERIZER_STATE;
 }
 
 void State::setFrontFace(GLenum front)
 {
     mRasterizer.frontFace = front;
+    mDirtyBits |= DIRTY_BIT_RASTERIZER_STATE;
 }
 
 bool State::isDepthTestEnabled() const
@@ -329,17 +351,20 @@ bool State::isDepthTestEnabled() const
 void State::setDepthTest(bool enabled)
 {
     mDepthStencil.depthTest = enabled;
+    mDirtyBits |= DIRTY_BIT_DEPTH_STENCIL_STATE;
 }
 
 void State::setDepthFunc(GLenum depthFunc)
 {
      mDepthStencil.depthFunc = depthFunc;
+    mDirtyBits |= DIRTY_BIT_DEPTH_STENCIL_STATE;
 }
 
 void State::setDepthRange(float zNear, float zFar)
 {
     mNearZ = zNear;
     mFarZ = zFar;
+    mDirtyBits |= DIRTY_BIT_VIEWPORT;
 }
 
 void State::getDepthRange(float *zNear, float *zFar) const
@@ -356,6 +381,7 @@ bool State::isBlendEnabled() const
 void State::setBlend(bool enabled)
 {
     mBlend.blend = enabled;
+    mDirtyBits |= DIRTY_BIT_BLEND_STATE;
 }
 
 void State::setBlendFactors(GLenum sourceRGB, GLenum destRGB, GLenum sourceAlpha, GLenum destAlpha)
@@ -364,6 +390,7 @@ void State::setBlendFactors(GLenum sourceRGB, GLenum destRGB, GLenum sourceAlpha
     mBlend.destBlendRGB = destRGB;
     mBlend.sourceBlendAlpha = sourceAlpha;
     mBlend.destBlendAlpha = destAlpha;
+    mDirtyBits |= DIRTY_BIT_BLEND_STATE;
 }
 
 void State::setBlendColor(float red, float green, float blue, float alpha)
@@ -372,12 +399,14 @@ void State::setBlendColor(float red, float green, float blue, float alpha)
     mBlendColor.green = green;
     mBlendColor.blue = blue;
     mBlendColor.alpha = alpha;
+    mDirtyBits |= DIRTY_BIT_BLEND_STATE;
 }
 
 void State::setBlendEquation(GLenum rgbEquation, GLenum alphaEquation)
 {
     mBlend.blendEquationRGB = rgbEquation;
     mBlend.blendEquationAlpha = alphaEquation;
+    mDirtyBits |= DIRTY_BIT_BLEND_STATE;
 }
 
 const ColorF &State::getBlendColor() const
@@ -393,6 +422,7 @@ bool State::isStencilTestEnabled() const
 void State::setStencilTest(bool enabled)
 {
     mDepthStencil.stencilTest = enabled;
+    mDirtyBits |= DIRTY_BIT_DEPTH_STENCIL_STATE;
 }
 
 void State::setStencilParams(GLenum stencilFunc, GLint stencilRef, GLuint stencilMask)
@@ -400,6 +430,7 @@ void State::setStencilParams(GLenum stencilFunc, GLint stencilRef, GLuint stenci
     mDepthStencil.stencilFunc = stencilFunc;
     mStencilRef = (stencilRef > 0) ? stencilRef : 0;
     mDepthStencil.stencilMask = stencilMask;
+    mDirtyBits |= DIRTY_BIT_DEPTH_STENCIL_STATE;
 }
 
 void State::setStencilBackParams(GLenum stencilBackFunc, GLint stencilBackRef, GLuint stencilBackMask)
@@ -407,16 +438,19 @@ void State::setStencilBackParams(GLenum stencilBackFunc, GLint stencilBackRef, G
     mDepthStencil.stencilBackFunc = stencilBackFunc;
     mStencilBackRef = (stencilBackRef > 0) ? stencilBackRef : 0;
     mDepthStencil.stencilBackMask = stencilBackMask;
+    mDirtyBits |= DIRTY_BIT_DEPTH_STENCIL_STATE;
 }
 
 void State::setStencilWritemask(GLuint stencilWritemask)
 {
     mDepthStencil.stencilWritemask = stencilWritemask;
+    mDirtyBits |= DIRTY_BIT_DEPTH_STENCIL_STATE;
 }
 
 void State::setStencilBackWritemask(GLuint stencilBackWritemask)
 {
     mDepthStencil.stencilBackWritemask = stencilBackWritemask;
+    mDirtyBits |= DIRTY_BIT_DEPTH_STENCIL_STATE;
 }
 
 void State::setStencilOperations(GLenum stencilFail, GLenum stencilPassDepthFail, GLenum stencilPassDepthPass)
@@ -424,6 +458,7 @@ void State::setStencilOperations(GLenum stencilFail, GLenum stencilPassDepthFail
     mDepthStencil.stencilFail = stencilFail;
     mDepthStencil.stencilPassDepthFail = stencilPassDepthFail;
     mDepthStencil.stencilPassDepthPass = stencilPassDepthPass;
+    mDirtyBits |= DIRTY_BIT_DEPTH_STENCIL_STATE;
 }
 
 void State::setStencilBackOperations(GLenum stencilBackFail, GLenum stencilBackPassDepthFail, GLenum stencilBackPassDepthPass)
@@ -431,6 +466,7 @@ void State::setStencilBackOperations(GLenum stencilBackFail, GLenum stencilBackP
     mDepthStencil.stencilBackFail = stencilBackFail;
     mDepthStencil.stencilBackPassDepthFail = stencilBackPassDepthFail;
     mDepthStencil.stencilBackPassDepthPass = stencilBackPassDepthPass;
+    mDirtyBits |= DIRTY_BIT_DEPTH_STENCIL_STATE;
 }
 
 GLint State::getStencilRef() const
@@ -451,6 +487,7 @@ bool State::isPolygonOffsetFillEnabled() const
 void State::setPolygonOffsetFill(bool enabled)
 {
      mRasterizer.polygonOffsetFill = enabled;
+    mDirtyBits |= DIRTY_BIT_RASTERIZER_STATE;
 }
 
 void State::setPolygonOffsetParams(GLfloat factor, GLfloat units)
@@ -458,6 +495,7 @@ void State::setPolygonOffsetParams(GLfloat factor, GLfloat units)
     // An application can pass NaN values here, so handle this gracefully
     mRasterizer.polygonOffsetFactor = factor != factor ? 0.0f : factor;
     mRasterizer.polygonOffsetUnits = units != units ? 0.0f : units;
+    mDirtyBits |= DIRTY_BIT_RASTERIZER_STATE;
 }
 
 bool State::isSampleAlphaToCoverageEnabled() const
@@ -468,6 +506,7 @@ bool State::isSampleAlphaToCoverageEnabled() const
 void State::setSampleAlphaToCoverage(bool enabled)
 {
     mBlend.sampleAlphaToCoverage = enabled;
+    mDirtyBits |= DIRTY_BIT_BLEND_STATE;
 }
 
 bool State::isSampleCoverageEnabled() const
@@ -478,12 +517,14 @@ bool State::isSampleCoverageEnabled() const
 void State::setSampleCoverage(bool enabled)
 {
     mSampleCoverage = enabled;
+    mDirtyBits |= DIRTY_BIT_BLEND_STATE;
 }
 
 void State::setSampleCoverageParams(GLclampf value, bool invert)
 {
     mSampleCoverageValue = value;
     mSampleCoverageInvert = invert;
+    mDirtyBits |= DIRTY_BIT_BLEND_STATE;
 }
 
 void State::getSampleCoverageParams(GLclampf *value, bool *invert)
@@ -502,6 +543,7 @@ bool State::isScissorTestEnabled() const
 void State::setScissorTest(bool enabled)
 {
     mScissorTest = enabled;
+    mDirtyBits |= DIRTY_BIT_SCISSOR;
 }
 
 void State::setScissorParams(GLint x, GLint y, GLsizei width, GLsizei height)
@@ -510,6 +552,7 @@ void State::setScissorParams(GLint x, GLint y, GLsizei width, GLsizei height)
     mScissor.y = y;
     mScissor.width = width;
     mScissor.height = height;
+    mDirtyBits |= DIRTY_BIT_SCISSOR;
 }
 
 const Rectangle &State::getScissor() const
@@ -525,6 +568,7 @@ bool State::isDitherEnabled() const
 void State::setDither(bool enabled)
 {
     mBlend.dither = enabled;
+    mDirtyBits |= DIRTY_BIT_BLEND_STATE;
 }
 
 void State::setEnableFeature(GLenum feature, bool enabled)
@@ -589,6 +633,7 @@ void State::setViewportParams(GLint x, GLint y, GLsizei width, GLsizei height)
     mViewport.y = y;
     mViewport.width = width;
     mViewport.height = height;
+    mDirtyBits |= DIRTY_BIT_VIEWPORT;
 }
 
 const Rectangle &State::getViewport() const
@@ -609,6 +654,7 @@ unsigned int State::getActiveSampler() const
 void State::setSamplerTexture(GLenum type, Texture *texture)
 {
     mSamplerTextures[type][mActiveSampler].set(texture);
+    mDirtyBits |= DIRTY_BIT_TEXTURE_BINDINGS;
 }
 
 Texture *State::getSamplerTexture(unsigned int sampler, GLenum type) const
@@ -648,6 +694,7 @@ void State::detachTexture(GLuint texture)
             if (binding.id() == texture)
             {
                 binding.set(NULL);
+                mDirtyBits |= DIRTY_BIT_TEXTURE_BINDINGS;
             }
         }
     }
@@ -671,6 +718,7 @@ void State::detachTexture(GLuint texture)
 void State::setSamplerBinding(GLuint textureUnit, Sampler *sampler)
 {
     mSamplers[textureUnit].set(sampler);
+    mDirtyBits |= DIRTY_BIT_SAMPLER_BINDINGS;
 }
 
 GLuint State::getSamplerId(GLuint textureUnit) const
@@ -696,6 +744,7 @@ void State::detachSampler(GLuint sampler)
         if (samplerBinding.id() == sampler)
         {
             samplerBinding.set(NULL);
+            mDirtyBits |= DIRTY_BIT_SAMPLER_BINDINGS;
         }
     }
 }
@@ -754,6 +803,7 @@ void State::setReadFramebufferBinding(Framebuffer *framebuffer)
 void State::setDrawFramebufferBinding(Framebuffer *framebuffer)
 {
     mDrawFramebuffer = framebuffer;
+    mDirtyBits |= DIRTY_BIT_DRAW_FRAMEBUFFER_BINDING;
 }
 
 Framebuffer *State::getTargetFramebuffer(GLenum target) const
@@ -803,6 +853,7 @@ bool State::removeDrawFramebufferBinding(GLuint framebuffer)
     if (mDrawFramebuffer->id() == framebuffer)
     {
         mDrawFramebuffer = NULL;
+        mDirtyBits |= DIRTY_BIT_DRAW_FRAMEBUFFER_BINDING;
         return true;
     }
 
@@ -812,6 +863,7 @@ bool State::removeDrawFramebufferBinding(GLuint framebuffer)
 void State::setVertexArrayBinding(VertexArray *vertexArray)
 {
     mVertexArray = vertexArray;
+    mDirtyBits |= DIRTY_BIT_VERTEX_ARRAY_BINDING;
 }
 
 GLuint State::getVertexArrayId() const
@@ -831,6 +883,7 @@ bool State::removeVertexArrayBinding(GLuint vertexArray)
     if (mVertexArray->id() == vertexArray)
     {
         mVertexArray = NULL;
+        mDirtyBits |= DIRTY_BIT_VERTEX_ARRAY_BINDING;
         return true;
     }
 
@@ -847,11 +900,14 @@ void State::setCurrentProgram(GLuint programId, Program *newProgram)
         newProgram->addRef();
         mCurrentProgramBinary.set(newProgram->getProgramBinary());
     }
+
+    mDirtyBits |= DIRTY_BIT_PROGRAM_BINDING;
 }
 
 void State::setCurrentProgramBinary(ProgramBinary *binary)
 {
     mCurrentProgramBinary.set(binary);
+    mDirtyBits |= DIRTY_BIT_PROGRAM_BINDING;
 }
 
 GLuint State::getCurrentProgramId() const
@@ -1035,30 +1091,66 @@ Buffer *State::getTargetBuffer(GLenum target) const
 void State::setEnableVertexAttribArray(unsigned int attribNum, bool enabled)
 {
     getVertexArray()->enableAttribute(attribNum, enabled);
+    mDirtyBits |= DIRTY_BIT_VERTEX_ATTRIB_FORMATS;
 }
 
 void State::setVertexAttribf(GLuint index, const GLfloat values[4])
 {
     ASSERT(static_cast<size_t>(index) < mVertexAttribCurrentValues.size());
+    GLenum previousType = mVertexAttribCurrentValues[index].Type;
     mVertexAttribCurrentValues[index].setFloatValues(values);
+    markVertexAttribCurrentValueDirty(index, previousType);
 }
 
 void State::setVertexAttribu(GLuint index, const GLuint values[4])
 {
     ASSERT(static_cast<size_t>(index) < mVertexAttribCurrentValues.size());
+    GLenum previousType = mVertexAttribCurrentValues[index].Type;
     mVertexAttribCurrentValues[index].setUnsignedIntValues(values);
+    markVertexAttribCurrentValueDirty(index, previousType);
 }
 
 void State::setVertexAttribi(GLuint index, const GLint values[4])
 {
     ASSERT(static_cast<size_t>(index) < mVertexAttribCurrentValues.size());
+    GLenum previousType = mVertexAttribCurrentValues[index].Type;
     mVertexAttribCurrentValues[index].setIntValues(values);
+    markVertexAttribCurrentValueDirty(index, previousType);
+}
+
+void State::markVertexAttribCurrentValueDirty(GLuint index, GLenum previousType)
+{
+    // The type of the current value is the format of a disabled attribute. The values
+    // themselves are applied on every draw.
+    if (mVertexAttribCurrentValues[index].Type != previousType)
+    {
+        mDirtyBits |= DIRTY_BIT_VERTEX_ATTRIB_FORMATS;
+    }
 }
 
 void State::setVertexAttribState(unsigned int attribNum, Buffer *boundBuffer, GLint size, GLenum type, bool normalized,
     bool pureInteger, GLsizei stride, const void *pointer)
 {
+    const VertexAttribute &attrib = getVertexArray()->getVertexAttribute(attribNum);
+    if (attrib.size != size || attrib.type != type || attrib.normalized != normalized || attrib.pureInteger != pureInteger)
+    {
+        mDirtyBits |= DIRTY_BIT_VERTEX_ATTRIB_FORMATS;
+    }
+
     getVertexArray()->setAttributeState(attribNum, boundBuffer, size, type, normalized, pureInteger, stride, pointer);
+    mDirtyBits |= DIRTY_BIT_VERTEX_ATTRIB_BINDINGS;
+}
+
+void State::setVertexAttribDivisor(GLuint index, GLuint divisor)
+{
+    getVertexArray()->setVertexAttribDivisor(index, divisor);
+    mDirtyBits |= DIRTY_BIT_VERTEX_ATTRIB_BINDINGS;
+}
+
+void State::setElementArrayBufferBinding(Buffer *buffer)
+{
+    getVertexArray()->setElementArrayBuffer(buffer);
+    mDirtyBits |= DIRTY_BIT_VERTEX_ATTRIB_BINDINGS;
 }
 
 const VertexAttribute &State::getVertexAttribState(unsigned int attribNum) const
@@ -35,6 +35,32 @@ class State
     void initialize(const Caps& caps, GLuint clientVersion);
     void reset();
 
+    // Groups of the state that draw calls apply. Each setter marks the groups
+    // it changes, and the Context clears them once it has applied them. State
+    // applied on every draw, such as the current vertex attribute values and
+    // the uniform buffer bindings, has no bit.
+    enum DirtyBitType
+    {
+        DIRTY_BIT_RASTERIZER_STATE             = 0x0001,
+        DIRTY_BIT_BLEND_STATE                  = 0x0002,   // Includes the blend color and sample coverage
+        DIRTY_BIT_DEPTH_STENCIL_STATE          = 0x0004,   // Includes the stencil reference values
+        DIRTY_BIT_VIEWPORT                     = 0x0008,   // Includes the depth range
+        DIRTY_BIT_SCISSOR                      = 0x0010,
+        DIRTY_BIT_DRAW_FRAMEBUFFER_BINDING     = 0x0020,
+        DIRTY_BIT_PROGRAM_BINDING              = 0x0040,
+        DIRTY_BIT_VERTEX_ARRAY_BINDING         = 0x0080,
+        DIRTY_BIT_VERTEX_ATTRIB_FORMATS        = 0x0100,   // Size, type, normalization and enable state
+        DIRTY_BIT_VERTEX_ATTRIB_BINDINGS       = 0x0200,   // Buffers, offsets, strides and divisors
+        DIRTY_BIT_TEXTURE_BINDINGS             = 0x0400,
+        DIRTY_BIT_SAMPLER_BINDINGS             = 0x0800,
+        DIRTY_BIT_ALL                          = 0x0FFF
+    };
+    typedef unsigned int DirtyBits;
+
+    DirtyBits getDirtyBits() const;
+    void setDirtyBits(DirtyBits dirtyBits);
+    void clearDirtyBits(DirtyBits dirtyBits);
+
     // State chunk getters
     const RasterizerState &getRasterizerState() const;
     const BlendState &getBlendState() const;
@@ -217,6 +243,8 @@ class State
     void setVertexAttribi(GLuint index, const GLint values[4]);
     void setVertexAttribState(unsigned int attribNum, Buffer *boundBuffer, GLint size, GLenum type,
                               bool normalized, bool pureInteger, GLsizei stride, const void *pointer);
+    void setVertexAttribDivisor(GLuint index, GLuint divisor);
+    void setElementArrayBufferBinding(Buffer *buffer);
     const VertexAttribute &getVertexAttribState(unsigned int attribNum) const;
     const VertexAttribCurrentValueData &getVertexAttribCurrentValue(unsigned int attribNum) const;
     const void *getVertexAttribPointer(unsigned int attribNum) const;
@@ -245,10 +273,14 @@ class State
   private:
     DISALLOW_COPY_AND_ASSIGN(State);
 
+    void markVertexAttribCurrentValueDirty(GLuint index, GLenum previousType);
+
     // Cached values from Context's caps
     GLuint mMaxDrawBuffers;
     GLuint mMaxCombinedTextureImageUnits;
 
+    DirtyBits mDirtyBits;
+
     ColorF mColorClearValue;
     GLclampf mDepthClearValue;
     int mStencilClearValue;
@@ -53,9 +53,16 @@ Texture::Texture(rx::TextureImpl *impl, GLuint id, GLenum target)
     : RefCountObject(id),
       mTexture(impl),
       mTextureSerial(issueTextureSerial()),
+      mDefinitionSerial(0),
       mUsage(GL_NONE),
       mImmutableLevelCount(0),
-      mTarget(target)
+      mTarget(target),
+      mSamplerCompletenessCached(false),
+      mSamplerComplete(false),
+      mCompletenessDefinitionSerial(0),
+      mCompletenessTextureCaps(NULL),
+      mCompletenessExtensions(NULL),
+      mCompletenessClientVersion(0)
 {
 }
 
@@ -131,8 +138,31 @@ GLenum Texture::getActualFormat(const ImageIndex &index) const
     return image->getActualFormat();
 }
 
+bool Texture::isSamplerComplete(const SamplerState &samplerState, const TextureCapsMap &textureCaps, const Extensions &extensions, int clientVersion) const
+{
+    // Checking mipmap completeness looks at every level, while the state it depends on rarely changes between draws
+    if (!mSamplerCompletenessCached || mCompletenessDefinitionSerial != mDefinitionSerial ||
+        mCompletenessTextureCaps != &textureCaps || mCompletenessExtensions != &extensions ||
+        mCompletenessClientVersion != clientVersion ||
+        memcmp(&mCompletenessSamplerState, &samplerState, sizeof(SamplerState)) != 0)
+    {
+        mSamplerComplete = checkSamplerCompleteness(samplerState, textureCaps, extensions, clientVersion);
+
+        mSamplerCompletenessCached = true;
+        mCompletenessSamplerState = samplerState;
+        mCompletenessDefinitionSerial = mDefinitionSerial;
+        mCompletenessTextureCaps = &textureCaps;
+        mCompletenessExtensions = &extensions;
+        mCompletenessClientVersion = clientVersion;
+    }
+
+    return mSamplerComplete;
+}
+
 Error Texture::generateMipmaps()
 {
+    mDefinitionSerial++;
+
     return getImplementation()->generateMipmaps();
 }
 
@@ -221,6 +251,8 @@ GLenum Texture2D::getActualFormat(GLint level) const
 
 Error Texture2D::setImage(GLint level, GLsizei width, GLsizei height, GLenum internalFormat, GLenum format, GLenum type, const PixelUnpackState &unpack, const void *pixels)
 {
+    mDefinitionSerial++;
+
     releaseTexImage();
 
     return mTexture->setImage(GL_TEXTURE_2D, level, width, height, 1, internalFormat, format, type, unpack, pixels);
@@ -228,6 +260,8 @@ Error Texture2D::setImage(GLint level, GLsizei width, GLsizei height, GLenum int
 
 void Texture2D::bindTexImage(egl::Surface *surface)
 {
+    mDefinitionSerial++;
+
     releaseTexImage();
 
     mTexture->bindTexImage(surface);
@@ -244,12 +278,15 @@ void Texture2D::releaseTexImage()
         mSurface = NULL;
 
         mTexture->releaseTexImage();
+        mDefinitionSerial++;
     }
 }
 
 Error Texture2D::setCompressedImage(GLint level, GLenum format, GLsizei width, GLsizei height, GLsizei imageSize,
                                     const PixelUnpackState &unpack, const void *pixels)
 {
+    mDefinitionSerial++;
+
     releaseTexImage();
 
     return mTexture->setCompressedImage(GL_TEXTURE_2D, level, format, width, height, 1, imageSize, unpack, pixels);
@@ -269,6 +306,8 @@ Error Texture2D::subImageCompressed(GLint level, GLint xoffset, GLint yoffset, G
 Error Texture2D::copyImage(GLint level, GLenum format, GLint x, GLint y, GLsizei width, GLsizei height,
                            Framebuffer *source)
 {
+    mDefinitionSerial++;
+
     releaseTexImage();
 
     return mTexture->copyImage(GL_TEXTURE_2D, level, format, x, y, width, height, source);
@@ -276,6 +315,8 @@ Error Texture2D::copyImage(GLint level, GLenum format, GLint x, GLint y, GLsizei
 
 Error Texture2D::storage(GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height)
 {
+    mDefinitionSerial++;
+
     Error error = mTexture->storage(GL_TEXTURE_2D, levels, internalformat, width, height, 1);
     if (error.isError())
     {
@@ -288,7 +329,7 @@ Error Texture2D::storage(GLsizei levels, GLenum internalformat, GLsizei width, G
 }
 
 // Tests for 2D texture sampling completeness. [OpenGL ES 2.0.24] section 3.8.2 page 85.
-bool Texture2D::isSamplerComplete(const SamplerState &samplerState, const TextureCapsMap &textureCaps, const Extensions &extensions, int clientVersion) const
+bool Texture2D::checkSamplerCompleteness(const SamplerState &samplerState, const TextureCapsMap &textureCaps, const Extensions &extensions, int clientVersion) const
 {
     GLsizei width = getBaseLevelWidth();
     GLsizei height = getBaseLevelHeight();
@@ -363,6 +404,8 @@ bool Texture2D::isDepth(GLint level) const
 
 Error Texture2D::generateMipmaps()
 {
+    mDefinitionSerial++;
+
     releaseTexImage();
 
     return mTexture->generateMipmaps();
@@ -471,12 +514,16 @@ GLenum TextureCubeMap::getActualFormat(GLenum target, GLint level) const
 
 Error TextureCubeMap::setImage(GLenum target, GLint level, GLsizei width, GLsizei height, GLenum internalFormat, GLenum format, GLenum type, const PixelUnpackState &unpack, const void *pixels)
 {
+    mDefinitionSerial++;
+
     return mTexture->setImage(target, level, width, height, 1, internalFormat, format, type, unpack, pixels);
 }
 
 Error TextureCubeMap::setCompressedImage(GLenum target, GLint level, GLenum format, GLsizei width, GLsizei height,
                                          GLsizei imageSize, const PixelUnpackState &unpack, const void *pixels)
 {
+    mDefinitionSerial++;
+
     return mTexture->setCompressedImage(target, level, format, width, height, 1, imageSize, unpack, pixels);
 }
 
@@ -532,11 +579,15 @@ bool TextureCubeMap::isDepth(GLenum target, GLint level) const
 Error TextureCubeMap::copyImage(GLenum target, GLint level, GLenum format, GLint x, GLint y,
                                 GLsizei width, GLsizei height, Framebuffer *source)
 {
+    mDefinitionSerial++;
+
     return mTexture->copyImage(target, level, format, x, y, width, height, source);
 }
 
 Error TextureCubeMap::storage(GLsizei levels, GLenum internalformat, GLsizei size)
 {
+    mDefinitionSerial++;
+
     Error error = mTexture->storage(GL_TEXTURE_CUBE_MAP, levels, internalformat, size, size, 1);
     if (error.isError())
     {
@@ -549,7 +600,7 @@ Error TextureCubeMap::storage(GLsizei levels, GLenum internalformat, GLsizei siz
 }
 
 // Tests for texture sampling completeness
-bool TextureCubeMap::isSamplerComplete(const SamplerState &samplerState, const TextureCapsMap &textureCaps, const Extensions &extensions, int clientVersion) const
+bool TextureCubeMap::checkSamplerCompleteness(const SamplerState &samplerState, const TextureCapsMap &textureCaps, const Extensions &extensions, int clientVersion) const
 {
     int size = getBaseLevelWidth();
 
@@ -723,12 +774,16 @@ bool Texture3D::isDepth(GLint level) const
 
 Error Texture3D::setImage(GLint level, GLsizei width, GLsizei height, GLsizei depth, GLenum internalFormat, GLenum format, GLenum type, const PixelUnpackState &unpack, const void *pixels)
 {
+    mDefinitionSerial++;
+
     return mTexture->setImage(GL_TEXTURE_3D, level, width, height, depth, internalFormat, format, type, unpack, pixels);
 }
 
 Error Texture3D::setCompressedImage(GLint level, GLenum format, GLsizei width, GLsizei height, GLsizei depth,
                                     GLsizei imageSize, const PixelUnpackState &unpack, const void *pixels)
 {
+    mDefinitionSerial++;
+
     return mTexture->setCompressedImage(GL_TEXTURE_3D, level, format, width, height, depth, imageSize, unpack, pixels);
 }
 
@@ -746,6 +801,8 @@ Error Texture3D::subImageCompressed(GLint level, GLint xoffset, GLint yoffset, G
 
 Error Texture3D::storage(GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth)
 {
+    mDefinitionSerial++;
+
     Error error = mTexture->storage(GL_TEXTURE_3D, levels, internalformat, width, height, depth);
     if (error.isError())
     {
@@ -757,7 +814,7 @@ Error Texture3D::storage(GLsizei levels, GLenum internalformat, GLsizei width, G
     return Error(GL_NO_ERROR);
 }
 
-bool Texture3D::isSamplerComplete(const SamplerState &samplerState, const TextureCapsMap &textureCaps, const Extensions &extensions, int clientVersion) const
+bool Texture3D::checkSamplerCompleteness(const SamplerState &samplerState, const TextureCapsMap &textureCaps, const Extensions &extensions, int clientVersion) const
 {
     GLsizei width = getBaseLevelWidth();
     GLsizei height = getBaseLevelHeight();
@@ -890,12 +947,16 @@ bool Texture2DArray::isDepth(GLint level) const
 
 Error Texture2DArray::setImage(GLint level, GLsizei width, GLsizei height, GLsizei depth, GLenum internalFormat, GLenum format, GLenum type, const PixelUnpackState &unpack, const void *pixels)
 {
+    mDefinitionSerial++;
+
     return mTexture->setImage(GL_TEXTURE_2D_ARRAY, level, width, height, depth, internalFormat, format, type, unpack, pixels);
 }
 
 Error Texture2DArray::setCompressedImage(GLint level, GLenum format, GLsizei width, GLsizei height, GLsizei depth,
                                          GLsizei imageSize, const PixelUnpackState &unpack, const void *pixels)
 {
+    mDefinitionSerial++;
+
     return mTexture->setCompressedImage(GL_TEXTURE_2D_ARRAY, level, format, width, height, depth, imageSize, unpack, pixels);
 }
 
@@ -913,6 +974,8 @@ Error Texture2DArray::subImageCompressed(GLint level, GLint xoffset, GLint yoffs
 
 Error Texture2DArray::storage(GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth)
 {
+    mDefinitionSerial++;
+
     Error error = mTexture->storage(GL_TEXTURE_2D_ARRAY, levels, internalformat, width, height, depth);
     if (error.isError())
     {
@@ -924,7 +987,7 @@ Error Texture2DArray::storage(GLsizei levels, GLenum internalformat, GLsizei wid
     return Error(GL_NO_ERROR);
 }
 
-bool Texture2DArray::isSamplerComplete(const SamplerState &samplerState, const TextureCapsMap &textureCaps, const Extensions &extensions, int clientVersion) const
+bool Texture2DArray::checkSamplerCompleteness(const SamplerState &samplerState, const TextureCapsMap &textureCaps, const Extensions &extensions, int clientVersion) const
 {
     GLsizei width = getBaseLevelWidth();
     GLsizei height = getBaseLevelHeight();
@@ -66,7 +66,8 @@ class Texture : public RefCountObject
     GLenum getInternalFormat(const ImageIndex &index) const;
     GLenum getActualFormat(const ImageIndex &index) const;
 
-    virtual bool isSamplerComplete(const SamplerState &samplerState, const TextureCapsMap &textureCaps, const Extensions &extensions, int clientVersion) const = 0;
+    // The result is cached until the sampler state, caps or definition of the texture change
+    bool isSamplerComplete(const SamplerState &samplerState, const TextureCapsMap &textureCaps, const Extensions &extensions, int clientVersion) const;
 
     virtual Error generateMipmaps();
 
@@ -76,6 +77,9 @@ class Texture : public RefCountObject
     // "id" is not good enough, as Textures can be deleted, then re-allocated with the same id.
     unsigned int getTextureSerial() const;
 
+    // Changes whenever the size or format of any image of the texture may have changed
+    unsigned int getDefinitionSerial() const { return mDefinitionSerial; }
+
     bool isImmutable() const;
     GLsizei immutableLevelCount();
 
@@ -85,6 +89,8 @@ class Texture : public RefCountObject
     static const GLuint INCOMPLETE_TEXTURE_ID = static_cast<GLuint>(-1);   // Every texture takes an id at creation time. The value is arbitrary because it is never registered with the resource manager.
 
   protected:
+    virtual bool checkSamplerCompleteness(const SamplerState &samplerState, const TextureCapsMap &textureCaps, const Extensions &extensions, int clientVersion) const = 0;
+
     int mipLevels() const;
     const rx::Image *getBaseLevelImage() const;
     static unsigned int issueTextureSerial();
@@ -101,8 +107,19 @@ class Texture : public RefCountObject
     const unsigned int mTextureSerial;
     static unsigned int mCurrentTextureSerial;
 
+    unsigned int mDefinitionSerial;
+
   private:
     DISALLOW_COPY_AND_ASSIGN(Texture);
+
+    // Key and result of the last sampler completeness check
+    mutable bool mSamplerCompletenessCached;
+    mutable bool mSamplerComplete;
+    mutable SamplerState mCompletenessSamplerState;
+    mutable unsigned int mCompletenessDefinitionSerial;
+    mutable const TextureCapsMap *mCompletenessTextureCaps;
+    mutable const Extensions *mCompletenessExtensions;
+    mutable int mCompletenessClientVersion;
 };
 
 class Texture2D : public Texture
@@ -126,7 +143,6 @@ class Texture2D : public Texture
     Error copyImage(GLint level, GLenum format, GLint x, GLint y, GLsizei width, GLsizei height, Framebuffer *source);
     Error storage(GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height);
 
-    virtual bool isSamplerComplete(const SamplerState &samplerState, const TextureCapsMap &textureCaps, const Extensions &extensions, int clientVersion) const;
     virtual void bindTexImage(egl::Surface *surface);
     virtual void releaseTexImage();
 
@@ -135,6 +151,8 @@ class Texture2D : public Texture
   private:
     DISALLOW_COPY_AND_ASSIGN(Texture2D);
 
+    virtual bool checkSamplerCompleteness(const SamplerState &samplerState, const TextureCapsMap &textureCaps, const Extensions &extensions, int clientVersion) const;
+
     bool isMipmapComplete() const;
     bool isLevelComplete(int level) const;
 
@@ -162,8 +180,6 @@ class TextureCubeMap : public Texture
     Error copyImage(GLenum target, GLint level, GLenum format, GLint x, GLint y, GLsizei width, GLsizei height, Framebuffer *source);
     Error storage(GLsizei levels, GLenum internalformat, GLsizei size);
 
-    virtual bool isSamplerComplete(const SamplerState &samplerState, const TextureCapsMap &textureCaps, const Extensions &extensions, int clientVersion) const;
-
     bool isCubeComplete() const;
 
     static int targetToLayerIndex(GLenum target);
@@ -172,6 +188,8 @@ class TextureCubeMap : public Texture
   private:
     DISALLOW_COPY_AND_ASSIGN(TextureCubeMap);
 
+    virtual bool checkSamplerCompleteness(const SamplerState &samplerState, const TextureCapsMap &textureCaps, const Extensions &extensions, int clientVersion) const;
+
     bool isMipmapComplete() const;
     bool isFaceLevelComplete(int faceIndex, int level) const;
 };
@@ -197,11 +215,11 @@ class Texture3D : public Texture
     Error subImageCompressed(GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, const PixelUnpackState &unpack, const void *pixels);
     Error storage(GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth);
 
-    virtual bool isSamplerComplete(const SamplerState &samplerState, const TextureCapsMap &textureCaps, const Extensions &extensions, int clientVersion) const;
-
   private:
     DISALLOW_COPY_AND_ASSIGN(Texture3D);
 
+    virtual bool checkSamplerCompleteness(const SamplerState &samplerState, const TextureCapsMap &textureCaps, const Extensions &extensions, int clientVersion) const;
+
     bool isMipmapComplete() const;
     bool isLevelComplete(int level) const;
 };
@@ -227,11 +245,11 @@ class Texture2DArray : public Texture
     Error subImageCompressed(GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, const PixelUnpackState &unpack, const void *pixels);
     Error storage(GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth);
 
-    virtual bool isSamplerComplete(const SamplerState &samplerState, const TextureCapsMap &textureCaps, const Extensions &extensions, int clientVersion) const;
-
   private:
     DISALLOW_COPY_AND_ASSIGN(Texture2DArray);
 
+    virtual bool checkSamplerCompleteness(const SamplerState &samplerState, const TextureCapsMap &textureCaps, const Extensions &extensions, int clientVersion) const;
+
     bool isMipmapComplete() const;
     bool isLevelComplete(int level) const;
 };
@@ -8,6 +8,9 @@
 
 #include "common/utilities.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace gl
 {
 
@@ -35,6 +38,8 @@ LinkedUniform::LinkedUniform(GLenum type, GLenum precision, const std::string &n
         memset(data, 0, bytes);
         registerCount = VariableRowCount(type) * elementCount();
     }
+
+    markAllRowsDirty();
 }
 
 LinkedUniform::~LinkedUniform()
@@ -78,6 +83,105 @@ bool LinkedUniform::isSampler() const
     return IsSampler(type);
 }
 
+unsigned int LinkedUniform::rowCount() const
+{
+    return data ? static_cast<unsigned int>(dataSize() / RowSize) : 0;
+}
+
+bool LinkedUniform::writeRows(unsigned int firstRow, const void *rows, unsigned int count)
+{
+    ASSERT(data != NULL);
+    ASSERT(firstRow + count <= rowCount());
+
+    unsigned char *dest = data + firstRow * RowSize;
+    const unsigned char *source = static_cast<const unsigned char*>(rows);
+
+    // Values that are set again without changing, common for uniforms updated every frame,
+    // cost a single compare
+    if (memcmp(dest, source, count * RowSize) == 0)
+    {
+        return false;
+    }
+
+    unsigned int spanStart = 0;
+    bool inSpan = false;
+    for (unsigned int row = 0; row < count; row++)
+    {
+        unsigned char *destRow = dest + row * RowSize;
+        const unsigned char *sourceRow = source + row * RowSize;
+
+        if (memcmp(destRow, sourceRow, RowSize) != 0)
+        {
+            memcpy(destRow, sourceRow, RowSize);
+            if (!inSpan)
+            {
+                spanStart = row;
+                inSpan = true;
+            }
+        }
+        else if (inSpan)
+        {
+            markRowsDirty(firstRow + spanStart, firstRow + row);
+            inSpan = false;
+        }
+    }
+
+    if (inSpan)
+    {
+        markRowsDirty(firstRow + spanStart, firstRow + count);
+    }
+
+    return true;
+}
+
+void LinkedUniform::markRowsDirty(unsigned int firstRow, unsigned int endRow)
+{
+    ASSERT(firstRow < endRow);
+    dirty = true;
+
+    // Skip the spans that end before this one starts, without touching it
+    std::vector<rx::RangeUI>::iterator span = dirtyRows.begin();
+    while (span != dirtyRows.end() && span->end < firstRow)
+    {
+        span++;
+    }
+
+    if (span == dirtyRows.end() || span->start > endRow)
+    {
+        dirtyRows.insert(span, rx::RangeUI(firstRow, endRow));
+        return;
+    }
+
+    // Merge with every span that overlaps or touches the new rows
+    span->start = std::min(span->start, firstRow);
+    span->end = std::max(span->end, endRow);
+
+    std::vector<rx::RangeUI>::iterator next = span + 1;
+    while (next != dirtyRows.end() && next->start <= span->end)
+    {
+        span->end = std::max(span->end, next->end);
+        next = dirtyRows.erase(next);
+    }
+}
+
+void LinkedUniform::markAllRowsDirty()
+{
+    dirty = true;
+    dirtyRows.clear();
+
+    unsigned int rows = rowCount();
+    if (rows > 0)
+    {
+        dirtyRows.push_back(rx::RangeUI(0, rows));
+    }
+}
+
+void LinkedUniform::clearDirtyRows()
+{
+    dirty = false;
+    dirtyRows.clear();
+}
+
 UniformBlock::UniformBlock(const std::string &name, unsigned int elementIndex, unsigned int dataSize)
     : name(name),
       elementIndex(elementIndex),
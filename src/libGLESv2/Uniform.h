@@ -9,6 +9,7 @@
 
 #include "common/debug.h"
 #include "common/blocklayout.h"
+#include "common/mathutil.h"
 
 #include "libGLESv2/angletypes.h"
 
@@ -35,6 +36,18 @@ struct LinkedUniform
     size_t dataSize() const;
     bool isSampler() const;
 
+    // Default block uniforms store their data as rows of four components, one row per register.
+    static const unsigned int RowSize = 16;
+    unsigned int rowCount() const;
+
+    // Writes count rows to data starting at firstRow, comparing and copying whole rows, and
+    // records the rows that changed. Returns whether any of them did.
+    bool writeRows(unsigned int firstRow, const void *rows, unsigned int count);
+
+    void markRowsDirty(unsigned int firstRow, unsigned int endRow);
+    void markAllRowsDirty();
+    void clearDirtyRows();
+
     const GLenum type;
     const GLenum precision;
     const std::string name;
@@ -45,6 +58,10 @@ struct LinkedUniform
     unsigned char *data;
     bool dirty;
 
+    // Rows written since the uniform was last applied, as sorted spans that neither overlap nor
+    // touch. Set whenever dirty is.
+    std::vector<rx::RangeUI> dirtyRows;
+
     unsigned int psRegisterIndex;
     unsigned int vsRegisterIndex;
     unsigned int registerCount;
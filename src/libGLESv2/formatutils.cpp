@@ -29,7 +29,7 @@ FormatType::FormatType()
 
 typedef std::pair<GLenum, GLenum> FormatTypePair;
 typedef std::pair<FormatTypePair, FormatType> FormatPair;
-typedef std::map<FormatTypePair, FormatType> FormatMap;
+using priv::FormatMap;
 
 // A helper function to insert data into the format map with fewer characters.
 static inline void InsertFormatMapping(FormatMap *map, GLenum format, GLenum type, GLenum internalFormat, ColorWriteFunction writeFunc)
@@ -40,7 +40,7 @@ static inline void InsertFormatMapping(FormatMap *map, GLenum format, GLenum typ
     map->insert(FormatPair(FormatTypePair(format, type), info));
 }
 
-FormatMap BuildFormatMap()
+FormatMap priv::BuildFormatMap()
 {
     FormatMap map;
 
@@ -151,7 +151,7 @@ Type::Type()
 
 // Map of sizes of input types
 typedef std::pair<GLenum, Type> TypeInfoPair;
-typedef std::map<GLenum, Type> TypeInfoMap;
+using priv::TypeInfoMap;
 
 static inline void InsertTypeInfo(TypeInfoMap *map, GLenum type, GLuint bytes, bool specialInterpretation)
 {
@@ -167,7 +167,7 @@ bool operator<(const Type& a, const Type& b)
     return memcmp(&a, &b, sizeof(Type)) < 0;
 }
 
-static TypeInfoMap BuildTypeInfoMap()
+TypeInfoMap priv::BuildTypeInfoMap()
 {
     TypeInfoMap map;
 
@@ -378,9 +378,9 @@ static InternalFormat CompressedFormat(GLuint compressedBlockWidth, GLuint compr
 }
 
 typedef std::pair<GLenum, InternalFormat> InternalFormatInfoPair;
-typedef std::map<GLenum, InternalFormat> InternalFormatInfoMap;
+using priv::InternalFormatInfoMap;
 
-static InternalFormatInfoMap BuildInternalFormatInfoMap()
+InternalFormatInfoMap priv::BuildInternalFormatInfoMap()
 {
     InternalFormatInfoMap map;
 
@@ -514,71 +514,175 @@ static InternalFormatInfoMap BuildInternalFormatInfoMap()
     return map;
 }
 
-static const InternalFormatInfoMap &GetInternalFormatMap()
+// Maps the GLenums of a table to dense indices in two steps, through the high and the low byte
+// of the enum, rather than searching a map on every lookup. All the enums of the tables are
+// below 0x10000. Index 0 stands for the enums that are not in the table.
+class EnumIndex
 {
-    static const InternalFormatInfoMap formatMap = BuildInternalFormatInfoMap();
-    return formatMap;
-}
+  public:
+    EnumIndex()
+        : mPages(PageSize, 0)
+    {
+        // Page 0 is left empty for the unused pages
+        memset(mPageIndices, 0, sizeof(mPageIndices));
+    }
 
-static FormatSet BuildAllSizedInternalFormatSet()
-{
-    FormatSet result;
+    void insert(GLenum value, size_t index)
+    {
+        ASSERT(value <= 0xFFFF);
+        ASSERT(index > 0 && index <= 0xFFFF);
 
-    const InternalFormatInfoMap &formats = GetInternalFormatMap();
-    for (InternalFormatInfoMap::const_iterator i = formats.begin(); i != formats.end(); i++)
+        size_t page = value >> 8;
+        if (mPageIndices[page] == 0)
+        {
+            ASSERT(mPages.size() / PageSize < PageSize);
+            mPageIndices[page] = static_cast<uint8_t>(mPages.size() / PageSize);
+            mPages.resize(mPages.size() + PageSize, 0);
+        }
+
+        mPages[mPageIndices[page] * PageSize + (value & 0xFF)] = static_cast<uint16_t>(index);
+    }
+
+    size_t get(GLenum value) const
     {
-        if (i->second.pixelBytes > 0)
+        if (value > 0xFFFF)
         {
-            result.insert(i->first);
+            return 0;
         }
+
+        return mPages[mPageIndices[value >> 8] * PageSize + (value & 0xFF)];
     }
 
-    return result;
-}
+  private:
+    static const size_t PageSize = 256;
 
-const FormatType &GetFormatTypeInfo(GLenum format, GLenum type)
+    uint8_t mPageIndices[PageSize];
+    std::vector<uint16_t> mPages;
+};
+
+// Format and type pairs are looked up in a table indexed by both, where the first
+// row and column hold the default for unknown formats and types.
+struct FormatTypeTable
+{
+    EnumIndex formatIndices;
+    EnumIndex typeIndices;
+    size_t typeCount;
+    std::vector<FormatType> formatTypes;
+};
+
+static FormatTypeTable BuildFormatTypeTable()
 {
-    static const FormatMap formatMap = BuildFormatMap();
-    FormatMap::const_iterator iter = formatMap.find(FormatTypePair(format, type));
-    if (iter != formatMap.end())
+    FormatTypeTable table;
+
+    const FormatMap map = priv::BuildFormatMap();
+
+    size_t formatCount = 1;
+    table.typeCount = 1;
+    for (FormatMap::const_iterator i = map.begin(); i != map.end(); i++)
     {
-        return iter->second;
+        GLenum format = i->first.first;
+        GLenum type = i->first.second;
+
+        if (table.formatIndices.get(format) == 0)
+        {
+            table.formatIndices.insert(format, formatCount++);
+        }
+        if (table.typeIndices.get(type) == 0)
+        {
+            table.typeIndices.insert(type, table.typeCount++);
+        }
     }
-    else
+
+    table.formatTypes.resize(formatCount * table.typeCount);
+    for (FormatMap::const_iterator i = map.begin(); i != map.end(); i++)
     {
-        static const FormatType defaultInfo;
-        return defaultInfo;
+        size_t formatIndex = table.formatIndices.get(i->first.first);
+        size_t typeIndex = table.typeIndices.get(i->first.second);
+        table.formatTypes[formatIndex * table.typeCount + typeIndex] = i->second;
     }
+
+    return table;
 }
 
-const Type &GetTypeInfo(GLenum type)
+struct TypeTable
+{
+    EnumIndex indices;
+    std::vector<Type> types;
+};
+
+static TypeTable BuildTypeTable()
 {
-    static const TypeInfoMap infoMap = BuildTypeInfoMap();
-    TypeInfoMap::const_iterator iter = infoMap.find(type);
-    if (iter != infoMap.end())
+    TypeTable table;
+
+    const TypeInfoMap map = priv::BuildTypeInfoMap();
+
+    table.types.push_back(Type());
+    for (TypeInfoMap::const_iterator i = map.begin(); i != map.end(); i++)
     {
-        return iter->second;
+        table.indices.insert(i->first, table.types.size());
+        table.types.push_back(i->second);
     }
-    else
+
+    return table;
+}
+
+struct InternalFormatTable
+{
+    EnumIndex indices;
+    std::vector<InternalFormat> formats;
+    FormatSet sizedFormats;
+};
+
+static InternalFormatTable BuildInternalFormatTable()
+{
+    InternalFormatTable table;
+
+    const InternalFormatInfoMap map = priv::BuildInternalFormatInfoMap();
+
+    table.formats.push_back(InternalFormat());
+    for (InternalFormatInfoMap::const_iterator i = map.begin(); i != map.end(); i++)
     {
-        static const Type defaultInfo;
-        return defaultInfo;
+        table.indices.insert(i->first, table.formats.size());
+        table.formats.push_back(i->second);
+
+        if (i->second.pixelBytes > 0)
+        {
+            table.sizedFormats.insert(i->first);
+        }
     }
+
+    return table;
+}
+
+static const InternalFormatTable &GetInternalFormatTable()
+{
+    static const InternalFormatTable table = BuildInternalFormatTable();
+    return table;
+}
+
+const FormatType &GetFormatTypeInfo(GLenum format, GLenum type)
+{
+    static const FormatTypeTable table = BuildFormatTypeTable();
+    size_t formatIndex = table.formatIndices.get(format);
+    size_t typeIndex = table.typeIndices.get(type);
+    return table.formatTypes[formatIndex * table.typeCount + typeIndex];
+}
+
+const Type &GetTypeInfo(GLenum type)
+{
+    static const TypeTable table = BuildTypeTable();
+    return table.types[table.indices.get(type)];
 }
 
 const InternalFormat &GetInternalFormatInfo(GLenum internalFormat)
 {
-    const InternalFormatInfoMap &formatMap = GetInternalFormatMap();
-    InternalFormatInfoMap::const_iterator iter = formatMap.find(internalFormat);
-    if (iter != formatMap.end())
-    {
-        return iter->second;
-    }
-    else
-    {
-        static const InternalFormat defaultInternalFormat;
-        return defaultInternalFormat;
-    }
+    const InternalFormatTable &table = GetInternalFormatTable();
+    return table.formats[table.indices.get(internalFormat)];
+}
+
+size_t GetInternalFormatIndex(GLenum internalFormat)
+{
+    return GetInternalFormatTable().indices.get(internalFormat);
 }
 
 GLuint InternalFormat::computeRowPitch(GLenum type, GLsizei width, GLint alignment) const
@@ -622,8 +726,7 @@ GLenum GetSizedInternalFormat(GLenum internalFormat, GLenum type)
 
 const FormatSet &GetAllSizedInternalFormats()
 {
-    static FormatSet formatSet = BuildAllSizedInternalFormatSet();
-    return formatSet;
+    return GetInternalFormatTable().sizedFormats;
 }
 
 }
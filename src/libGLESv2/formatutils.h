@@ -16,6 +16,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <map>
 
 typedef void (*MipGenerationFunction)(size_t sourceWidth, size_t sourceHeight, size_t sourceDepth,
                                       const uint8_t *sourceData, size_t sourceRowPitch, size_t sourceDepthPitch,
@@ -96,11 +97,29 @@ struct InternalFormat
 };
 const InternalFormat &GetInternalFormatInfo(GLenum internalFormat);
 
+// A dense index of the internal format, for tables of per format data, or 0 for unknown formats
+size_t GetInternalFormatIndex(GLenum internalFormat);
+
 GLenum GetSizedInternalFormat(GLenum internalFormat, GLenum type);
 
 typedef std::set<GLenum> FormatSet;
 const FormatSet &GetAllSizedInternalFormats();
 
+namespace priv
+{
+
+// The descriptions of the formats and types, from which the lookup tables are built at first use.
+// Exposed for testing.
+typedef std::map<std::pair<GLenum, GLenum>, FormatType> FormatMap;
+typedef std::map<GLenum, Type> TypeInfoMap;
+typedef std::map<GLenum, InternalFormat> InternalFormatInfoMap;
+
+FormatMap BuildFormatMap();
+TypeInfoMap BuildTypeInfoMap();
+InternalFormatInfoMap BuildInternalFormatInfoMap();
+
+}
+
 }
 
 #endif // LIBGLESV2_FORMATUTILS_H_
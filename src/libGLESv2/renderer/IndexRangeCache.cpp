@@ -17,37 +17,107 @@
 namespace rx
 {
 
-template <class IndexType>
+template <class IndexType, bool PrimitiveRestart>
 static RangeUI ComputeTypedRange(const IndexType *indices, GLsizei count)
 {
-    unsigned int minIndex = indices[0];
-    unsigned int maxIndex = indices[0];
+    const unsigned int restartIndex = std::numeric_limits<IndexType>::max();
 
-    for (GLsizei i = 1; i < count; i++)
+    unsigned int minIndex = restartIndex;
+    unsigned int maxIndex = 0;
+
+    for (GLsizei i = 0; i < count; i++)
     {
+        if (PrimitiveRestart && indices[i] == restartIndex) continue;
         if (minIndex > indices[i]) minIndex = indices[i];
         if (maxIndex < indices[i]) maxIndex = indices[i];
     }
 
+    // Only reachable when every index was a restart index
+    if (minIndex > maxIndex)
+    {
+        return RangeUI(0, 0);
+    }
+
     return RangeUI(minIndex, maxIndex);
 }
 
-RangeUI IndexRangeCache::ComputeRange(GLenum type, const GLvoid *indices, GLsizei count)
+template <bool PrimitiveRestart>
+static RangeUI ComputeIndexRange(GLenum type, const GLvoid *indices, GLsizei count)
 {
+    // Short index lists don't amortize the vector setup and reduction
+    const GLsizei minimumSIMDCount = 64;
+
+    if (count >= minimumSIMDCount)
+    {
+        if (gl::supportsSSE41())
+        {
+            return ComputeIndexRange_SSE41(type, indices, count, PrimitiveRestart);
+        }
+        else if (gl::supportsSSE2())
+        {
+            return ComputeIndexRange_SSE2(type, indices, count, PrimitiveRestart);
+        }
+    }
+
     switch (type)
     {
       case GL_UNSIGNED_BYTE:
-        return ComputeTypedRange(static_cast<const GLubyte*>(indices), count);
+        return ComputeTypedRange<GLubyte, PrimitiveRestart>(static_cast<const GLubyte*>(indices), count);
       case GL_UNSIGNED_INT:
-        return ComputeTypedRange(static_cast<const GLuint*>(indices), count);
+        return ComputeTypedRange<GLuint, PrimitiveRestart>(static_cast<const GLuint*>(indices), count);
       case GL_UNSIGNED_SHORT:
-        return ComputeTypedRange(static_cast<const GLushort*>(indices), count);
+        return ComputeTypedRange<GLushort, PrimitiveRestart>(static_cast<const GLushort*>(indices), count);
       default:
         UNREACHABLE();
         return RangeUI();
     }
 }
 
+RangeUI IndexRangeCache::ComputeRange(GLenum type, const GLvoid *indices, GLsizei count)
+{
+    return ComputeIndexRange<false>(type, indices, count);
+}
+
+RangeUI IndexRangeCache::ComputeRangeWithPrimitiveRestart(GLenum type, const GLvoid *indices, GLsizei count)
+{
+    return ComputeIndexRange<true>(type, indices, count);
+}
+
+static void ExtendRange(GLenum type, const uint8_t *indices, size_t count,
+                        unsigned int *minIndex, unsigned int *maxIndex)
+{
+    if (count > 0)
+    {
+        RangeUI range = IndexRangeCache::ComputeRange(type, indices, static_cast<GLsizei>(count));
+        *minIndex = std::min(*minIndex, range.start);
+        *maxIndex = std::max(*maxIndex, range.end);
+    }
+}
+
+RangeUI IndexRangeCache::computeRange(GLenum type, const uint8_t *data, size_t dataSize, unsigned int offset,
+                                      GLsizei count)
+{
+    const gl::Type &typeInfo = gl::GetTypeInfo(type);
+    ASSERT(offset + typeInfo.bytes * static_cast<size_t>(count) <= dataSize);
+
+    // Short or misaligned ranges are cheaper to scan directly than to route through the block summary
+    if (static_cast<size_t>(count) < IndexBlockTree::BlockSize * 2 || offset % typeInfo.bytes != 0)
+    {
+        return ComputeRange(type, data + offset, count);
+    }
+
+    size_t indexCount = dataSize / typeInfo.bytes;
+
+    IndexBlockTreeMap::iterator tree = mIndexBlockTrees.find(type);
+    if (tree == mIndexBlockTrees.end() || tree->second.getIndexCount() != indexCount)
+    {
+        mIndexBlockTrees[type] = IndexBlockTree(type, indexCount);
+        tree = mIndexBlockTrees.find(type);
+    }
+
+    return tree->second.query(data, offset / typeInfo.bytes, count);
+}
+
 void IndexRangeCache::addRange(GLenum type, unsigned int offset, GLsizei count, const RangeUI &range,
                                unsigned int streamOffset)
 {
@@ -74,6 +144,15 @@ void IndexRangeCache::invalidateRange(unsigned int offset, unsigned int size)
             i = mIndexRangeCache.erase(i);
         }
     }
+
+    if (size > 0)
+    {
+        for (IndexBlockTreeMap::iterator tree = mIndexBlockTrees.begin(); tree != mIndexBlockTrees.end(); tree++)
+        {
+            unsigned int typeBytes = gl::GetTypeInfo(tree->first).bytes;
+            tree->second.invalidateIndices(invalidateStart / typeBytes, (invalidateEnd - 1) / typeBytes);
+        }
+    }
 }
 
 bool IndexRangeCache::findRange(GLenum type, unsigned int offset, GLsizei count,
@@ -97,6 +176,7 @@ bool IndexRangeCache::findRange(GLenum type, unsigned int offset, GLsizei count,
 void IndexRangeCache::clear()
 {
     mIndexRangeCache.clear();
+    mIndexBlockTrees.clear();
 }
 
 IndexRangeCache::IndexRange::IndexRange()
@@ -125,4 +205,130 @@ IndexRangeCache::IndexBounds::IndexBounds(const RangeUI &rangeIn, unsigned int o
 {
 }
 
+const size_t IndexRangeCache::IndexBlockTree::BlockSize;
+
+IndexRangeCache::IndexBlockTree::IndexBlockTree()
+    : mType(GL_NONE),
+      mTypeBytes(0),
+      mIndexCount(0),
+      mLeafCount(0)
+{
+}
+
+IndexRangeCache::IndexBlockTree::IndexBlockTree(GLenum type, size_t indexCount)
+    : mType(type),
+      mTypeBytes(gl::GetTypeInfo(type).bytes),
+      mIndexCount(indexCount),
+      mLeafCount(1)
+{
+    size_t blockCount = (indexCount + BlockSize - 1) / BlockSize;
+    while (mLeafCount < blockCount)
+    {
+        mLeafCount <<= 1;
+    }
+
+    // Node 1 is the root, node n has children 2n and 2n + 1 and the leaves start at mLeafCount.
+    // Every node starts out invalid and is filled in by the first query that touches it.
+    mMin.resize(mLeafCount * 2, std::numeric_limits<unsigned int>::max());
+    mMax.resize(mLeafCount * 2, 0);
+    mValid.resize(mLeafCount * 2, false);
+}
+
+void IndexRangeCache::IndexBlockTree::invalidateIndices(size_t firstIndex, size_t lastIndex)
+{
+    if (firstIndex >= mIndexCount)
+    {
+        return;
+    }
+
+    lastIndex = std::min(lastIndex, mIndexCount - 1);
+
+    // A valid node only ever has valid descendants, so the walk up can stop at the first node
+    // that is already invalid.
+    for (size_t block = firstIndex / BlockSize; block <= lastIndex / BlockSize; block++)
+    {
+        for (size_t node = mLeafCount + block; node > 0 && mValid[node]; node >>= 1)
+        {
+            mValid[node] = false;
+        }
+    }
+}
+
+RangeUI IndexRangeCache::IndexBlockTree::query(const uint8_t *data, size_t firstIndex, size_t count)
+{
+    ASSERT(firstIndex + count <= mIndexCount);
+
+    unsigned int minIndex = std::numeric_limits<unsigned int>::max();
+    unsigned int maxIndex = 0;
+
+    size_t lastIndex = firstIndex + count;
+    size_t firstBlock = (firstIndex + BlockSize - 1) / BlockSize;
+    size_t lastBlock = lastIndex / BlockSize;
+
+    if (firstBlock >= lastBlock)
+    {
+        ExtendRange(mType, data + firstIndex * mTypeBytes, count, &minIndex, &maxIndex);
+        return RangeUI(minIndex, maxIndex);
+    }
+
+    // Scan the partial blocks at either end directly
+    ExtendRange(mType, data + firstIndex * mTypeBytes, firstBlock * BlockSize - firstIndex, &minIndex, &maxIndex);
+    ExtendRange(mType, data + lastBlock * BlockSize * mTypeBytes, lastIndex - lastBlock * BlockSize, &minIndex, &maxIndex);
+
+    // Combine the O(log n) nodes that exactly cover the whole blocks in between
+    for (size_t left = mLeafCount + firstBlock, right = mLeafCount + lastBlock; left < right; left >>= 1, right >>= 1)
+    {
+        if (left & 1)
+        {
+            validateNode(data, left);
+            minIndex = std::min(minIndex, mMin[left]);
+            maxIndex = std::max(maxIndex, mMax[left]);
+            left++;
+        }
+
+        if (right & 1)
+        {
+            right--;
+            validateNode(data, right);
+            minIndex = std::min(minIndex, mMin[right]);
+            maxIndex = std::max(maxIndex, mMax[right]);
+        }
+    }
+
+    return RangeUI(minIndex, maxIndex);
+}
+
+void IndexRangeCache::IndexBlockTree::validateNode(const uint8_t *data, size_t node)
+{
+    if (mValid[node])
+    {
+        return;
+    }
+
+    if (node >= mLeafCount)
+    {
+        size_t blockStart = (node - mLeafCount) * BlockSize;
+
+        mMin[node] = std::numeric_limits<unsigned int>::max();
+        mMax[node] = 0;
+
+        // Padding leaves past the end of the buffer keep an empty range
+        if (blockStart < mIndexCount)
+        {
+            ExtendRange(mType, data + blockStart * mTypeBytes, std::min(BlockSize, mIndexCount - blockStart),
+                        &mMin[node], &mMax[node]);
+        }
+    }
+    else
+    {
+        validateNode(data, node * 2);
+        validateNode(data, node * 2 + 1);
+
+        mMin[node] = std::min(mMin[node * 2], mMin[node * 2 + 1]);
+        mMax[node] = std::max(mMax[node * 2], mMax[node * 2 + 1]);
+    }
+
+    mValid[node] = true;
+}
+
 }
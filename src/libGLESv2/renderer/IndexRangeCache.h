@@ -16,6 +16,7 @@
 #include "angle_gl.h"
 
 #include <map>
+#include <vector>
 
 namespace rx
 {
@@ -28,12 +29,51 @@ class IndexRangeCache
     bool findRange(GLenum type, unsigned int offset, GLsizei count, RangeUI *rangeOut,
                    unsigned int *outStreamOffset) const;
 
+    // Computes the range of count indices of the given type starting at byte offset in the buffer
+    // contents data. Large queries are answered from a per-block min/max summary of the buffer so
+    // arbitrary sub-ranges cost O(log n) once the summary is built.
+    RangeUI computeRange(GLenum type, const uint8_t *data, size_t dataSize, unsigned int offset,
+                         GLsizei count);
+
     void invalidateRange(unsigned int offset, unsigned int size);
     void clear();
 
     static RangeUI ComputeRange(GLenum type, const GLvoid *indices, GLsizei count);
 
+    // Same as ComputeRange, but skips the fixed primitive restart index of the index type
+    static RangeUI ComputeRangeWithPrimitiveRestart(GLenum type, const GLvoid *indices, GLsizei count);
+
   private:
+    // Hierarchical min/max summary of all the indices of one type in a buffer. Leaves hold the
+    // range of a block of BlockSize indices, inner nodes the union of their children, so the
+    // fourth level above the leaves covers 4096 indices. Invalidated blocks are only rescanned
+    // the next time a query touches them.
+    class IndexBlockTree
+    {
+      public:
+        IndexBlockTree();
+        IndexBlockTree(GLenum type, size_t indexCount);
+
+        size_t getIndexCount() const { return mIndexCount; }
+
+        void invalidateIndices(size_t firstIndex, size_t lastIndex);
+        RangeUI query(const uint8_t *data, size_t firstIndex, size_t count);
+
+        static const size_t BlockSize = 256;
+
+      private:
+        void validateNode(const uint8_t *data, size_t node);
+
+        GLenum mType;
+        size_t mTypeBytes;
+        size_t mIndexCount;
+        size_t mLeafCount;
+
+        std::vector<unsigned int> mMin;
+        std::vector<unsigned int> mMax;
+        std::vector<bool> mValid;
+    };
+
     struct IndexRange
     {
         GLenum type;
@@ -57,8 +97,16 @@ class IndexRangeCache
 
     typedef std::map<IndexRange, IndexBounds> IndexRangeMap;
     IndexRangeMap mIndexRangeCache;
+
+    typedef std::map<GLenum, IndexBlockTree> IndexBlockTreeMap;
+    IndexBlockTreeMap mIndexBlockTrees;
 };
 
+// Vectorized implementations of IndexRangeCache::ComputeRange, defined in IndexRangeCacheSSE2.cpp
+// and IndexRangeCacheSSE41.cpp
+RangeUI ComputeIndexRange_SSE2(GLenum type, const GLvoid *indices, GLsizei count, bool primitiveRestart);
+RangeUI ComputeIndexRange_SSE41(GLenum type, const GLvoid *indices, GLsizei count, bool primitiveRestart);
+
 }
 
 #endif // LIBGLESV2_RENDERER_INDEXRANGECACHE_H
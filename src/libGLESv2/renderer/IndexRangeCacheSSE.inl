@@ -0,0 +1,154 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// IndexRangeCacheSSE.inl: Defines the vectorized index range reduction and its SSE2 operations,
+// shared by the SSE2 and SSE4.1 kernels of rx::IndexRangeCache. Both files are built with
+// different instruction set flags, so everything here has internal linkage: the linker must not
+// merge an SSE4.1 build of a function into the SSE2 kernels.
+
+#include <emmintrin.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace rx
+{
+
+namespace
+{
+
+struct UByteSSE2
+{
+    typedef GLubyte IndexType;
+
+    static __m128i Min(__m128i a, __m128i b) { return _mm_min_epu8(a, b); }
+    static __m128i Max(__m128i a, __m128i b) { return _mm_max_epu8(a, b); }
+    static __m128i RestartMask(__m128i v) { return _mm_cmpeq_epi8(v, _mm_set1_epi32(-1)); }
+};
+
+struct UShortSSE2
+{
+    typedef GLushort IndexType;
+
+    // SSE2 only has signed 16-bit min/max, so flip the sign bit around the comparison
+    static __m128i Min(__m128i a, __m128i b)
+    {
+        const __m128i bias = _mm_set1_epi16(static_cast<short>(0x8000));
+        return _mm_xor_si128(_mm_min_epi16(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias)), bias);
+    }
+
+    static __m128i Max(__m128i a, __m128i b)
+    {
+        const __m128i bias = _mm_set1_epi16(static_cast<short>(0x8000));
+        return _mm_xor_si128(_mm_max_epi16(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias)), bias);
+    }
+
+    static __m128i RestartMask(__m128i v) { return _mm_cmpeq_epi16(v, _mm_set1_epi32(-1)); }
+};
+
+struct UIntSSE2
+{
+    typedef GLuint IndexType;
+
+    // SSE2 has no 32-bit min/max at all, select with a signed compare of the sign-flipped values
+    static __m128i Greater(__m128i a, __m128i b)
+    {
+        const __m128i bias = _mm_set1_epi32(static_cast<int>(0x80000000));
+        return _mm_cmpgt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+    }
+
+    static __m128i Min(__m128i a, __m128i b)
+    {
+        __m128i aGreater = Greater(a, b);
+        return _mm_or_si128(_mm_and_si128(aGreater, b), _mm_andnot_si128(aGreater, a));
+    }
+
+    static __m128i Max(__m128i a, __m128i b)
+    {
+        __m128i aGreater = Greater(a, b);
+        return _mm_or_si128(_mm_and_si128(aGreater, a), _mm_andnot_si128(aGreater, b));
+    }
+
+    static __m128i RestartMask(__m128i v) { return _mm_cmpeq_epi32(v, _mm_set1_epi32(-1)); }
+};
+
+template <class Ops, bool PrimitiveRestart>
+RangeUI ComputeTypedRangeSIMD(const typename Ops::IndexType *indices, size_t count)
+{
+    typedef typename Ops::IndexType IndexType;
+    static const size_t lanes = sizeof(__m128i) / sizeof(IndexType);
+
+    // The fixed primitive restart index has all bits set, so it never lowers the minimum and
+    // only needs to be masked out of the maximum.
+    const unsigned int restartIndex = std::numeric_limits<IndexType>::max();
+
+    __m128i minVector = _mm_set1_epi32(-1);
+    __m128i maxVector = _mm_setzero_si128();
+
+    size_t i = 0;
+    for (; i + lanes <= count; i += lanes)
+    {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&indices[i]));
+        minVector = Ops::Min(minVector, data);
+
+        if (PrimitiveRestart)
+        {
+            data = _mm_andnot_si128(Ops::RestartMask(data), data);
+        }
+        maxVector = Ops::Max(maxVector, data);
+    }
+
+    IndexType minLanes[lanes];
+    IndexType maxLanes[lanes];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(minLanes), minVector);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(maxLanes), maxVector);
+
+    unsigned int minIndex = restartIndex;
+    unsigned int maxIndex = 0;
+
+    for (size_t lane = 0; lane < lanes; lane++)
+    {
+        minIndex = std::min<unsigned int>(minIndex, minLanes[lane]);
+        maxIndex = std::max<unsigned int>(maxIndex, maxLanes[lane]);
+    }
+
+    // Handle the remainder
+    for (; i < count; i++)
+    {
+        minIndex = std::min<unsigned int>(minIndex, indices[i]);
+        if (!PrimitiveRestart || indices[i] != restartIndex)
+        {
+            maxIndex = std::max<unsigned int>(maxIndex, indices[i]);
+        }
+    }
+
+    // Only reachable when every index was a restart index
+    if (minIndex > maxIndex)
+    {
+        return RangeUI(0, 0);
+    }
+
+    return RangeUI(minIndex, maxIndex);
+}
+
+template <class Ops>
+RangeUI ComputeTypedRangeSIMD(const GLvoid *indices, GLsizei count, bool primitiveRestart)
+{
+    const typename Ops::IndexType *typedIndices = static_cast<const typename Ops::IndexType*>(indices);
+
+    if (primitiveRestart)
+    {
+        return ComputeTypedRangeSIMD<Ops, true>(typedIndices, count);
+    }
+    else
+    {
+        return ComputeTypedRangeSIMD<Ops, false>(typedIndices, count);
+    }
+}
+
+}
+
+}
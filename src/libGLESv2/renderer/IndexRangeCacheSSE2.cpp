@@ -0,0 +1,38 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// IndexRangeCacheSSE2.cpp: Defines the SSE2 index range kernels used by rx::IndexRangeCache.
+// It's in a separated file for GCC, which can enable SSE usage only per-file, not for code
+// blocks that use SSE explicitly.
+
+#include "libGLESv2/renderer/IndexRangeCache.h"
+
+#if !defined(_M_ARM)
+#include "libGLESv2/renderer/IndexRangeCacheSSE.inl"
+#endif
+
+namespace rx
+{
+
+RangeUI ComputeIndexRange_SSE2(GLenum type, const GLvoid *indices, GLsizei count, bool primitiveRestart)
+{
+#if defined(_M_ARM)
+    // Ensure that this function is reported as not implemented for ARM builds because
+    // the instructions below are not present for that architecture.
+    UNIMPLEMENTED();
+    return RangeUI();
+#else
+    switch (type)
+    {
+      case GL_UNSIGNED_BYTE:  return ComputeTypedRangeSIMD<UByteSSE2>(indices, count, primitiveRestart);
+      case GL_UNSIGNED_SHORT: return ComputeTypedRangeSIMD<UShortSSE2>(indices, count, primitiveRestart);
+      case GL_UNSIGNED_INT:   return ComputeTypedRangeSIMD<UIntSSE2>(indices, count, primitiveRestart);
+      default: UNREACHABLE(); return RangeUI();
+    }
+#endif
+}
+
+}
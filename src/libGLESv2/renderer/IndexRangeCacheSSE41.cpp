@@ -0,0 +1,61 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// IndexRangeCacheSSE41.cpp: Defines the SSE4.1 index range kernels used by rx::IndexRangeCache.
+// It's in a separated file for GCC, which builds it alone with -msse4.1 so that none of the
+// other code can use SSE4.1 instructions on processors without them.
+
+#include "libGLESv2/renderer/IndexRangeCache.h"
+
+#if !defined(_M_ARM)
+#include "libGLESv2/renderer/IndexRangeCacheSSE.inl"
+
+#include <smmintrin.h>
+#endif
+
+namespace rx
+{
+
+#if !defined(_M_ARM)
+
+namespace
+{
+
+struct UShortSSE41 : public UShortSSE2
+{
+    static __m128i Min(__m128i a, __m128i b) { return _mm_min_epu16(a, b); }
+    static __m128i Max(__m128i a, __m128i b) { return _mm_max_epu16(a, b); }
+};
+
+struct UIntSSE41 : public UIntSSE2
+{
+    static __m128i Min(__m128i a, __m128i b) { return _mm_min_epu32(a, b); }
+    static __m128i Max(__m128i a, __m128i b) { return _mm_max_epu32(a, b); }
+};
+
+}
+
+#endif
+
+RangeUI ComputeIndexRange_SSE41(GLenum type, const GLvoid *indices, GLsizei count, bool primitiveRestart)
+{
+#if defined(_M_ARM)
+    // Ensure that this function is reported as not implemented for ARM builds because
+    // the instructions below are not present for that architecture.
+    UNIMPLEMENTED();
+    return RangeUI();
+#else
+    switch (type)
+    {
+      case GL_UNSIGNED_BYTE:  return ComputeTypedRangeSIMD<UByteSSE2>(indices, count, primitiveRestart);
+      case GL_UNSIGNED_SHORT: return ComputeTypedRangeSIMD<UShortSSE41>(indices, count, primitiveRestart);
+      case GL_UNSIGNED_INT:   return ComputeTypedRangeSIMD<UIntSSE41>(indices, count, primitiveRestart);
+      default: UNREACHABLE(); return RangeUI();
+    }
+#endif
+}
+
+}
@@ -14,27 +14,6 @@
 namespace rx
 {
 
-namespace
-{
-
-unsigned int ParseAndStripArrayIndex(std::string* name)
-{
-    unsigned int subscript = GL_INVALID_INDEX;
-
-    // Strip any trailing array operator and retrieve the subscript
-    size_t open = name->find_last_of('[');
-    size_t close = name->find_last_of(']');
-    if (open != std::string::npos && close == name->length() - 1)
-    {
-        subscript = atoi(name->substr(open + 1).c_str());
-        name->erase(open);
-    }
-
-    return subscript;
-}
-
-}
-
 ProgramImpl::~ProgramImpl()
 {
     // Ensure that reset was called by the inherited class during destruction
@@ -66,69 +45,33 @@ gl::UniformBlock *ProgramImpl::getUniformBlockByIndex(GLuint blockIndex) const
     return mUniformBlocks[blockIndex];
 }
 
-GLint ProgramImpl::getUniformLocation(std::string name)
+GLint ProgramImpl::getUniformLocation(const char *name) const
 {
-    unsigned int subscript = ParseAndStripArrayIndex(&name);
-
-    unsigned int numUniforms = mUniformIndex.size();
-    for (unsigned int location = 0; location < numUniforms; location++)
-    {
-        if (mUniformIndex[location].name == name)
-        {
-            const int index = mUniformIndex[location].index;
-            const bool isArray = mUniforms[index]->isArray();
-
-            if ((isArray && mUniformIndex[location].element == subscript) ||
-                (subscript == GL_INVALID_INDEX))
-            {
-                return location;
-            }
-        }
-    }
-
-    return -1;
+    return mNameIndex.getUniformLocation(name);
 }
 
-GLuint ProgramImpl::getUniformIndex(std::string name)
+GLuint ProgramImpl::getUniformIndex(const char *name) const
 {
-    unsigned int subscript = ParseAndStripArrayIndex(&name);
-
-    // The app is not allowed to specify array indices other than 0 for arrays of basic types
-    if (subscript != 0 && subscript != GL_INVALID_INDEX)
-    {
-        return GL_INVALID_INDEX;
-    }
-
-    unsigned int numUniforms = mUniforms.size();
-    for (unsigned int index = 0; index < numUniforms; index++)
-    {
-        if (mUniforms[index]->name == name)
-        {
-            if (mUniforms[index]->isArray() || subscript == GL_INVALID_INDEX)
-            {
-                return index;
-            }
-        }
-    }
+    return mNameIndex.getUniformIndex(name);
+}
 
-    return GL_INVALID_INDEX;
+GLuint ProgramImpl::getUniformBlockIndex(const char *name) const
+{
+    return mNameIndex.getUniformBlockIndex(name);
 }
 
-GLuint ProgramImpl::getUniformBlockIndex(std::string name) const
+void ProgramImpl::indexNames()
 {
-    unsigned int subscript = ParseAndStripArrayIndex(&name);
+    mNameIndex.build(mUniforms, mUniformIndex, mUniformBlocks);
+}
 
-    unsigned int numUniformBlocks = mUniformBlocks.size();
-    for (unsigned int blockIndex = 0; blockIndex < numUniformBlocks; blockIndex++)
+GLuint ProgramImpl::findUniformBlockIndex(const std::string &name) const
+{
+    for (size_t blockIndex = 0; blockIndex < mUniformBlocks.size(); blockIndex++)
     {
-        const gl::UniformBlock &uniformBlock = *mUniformBlocks[blockIndex];
-        if (uniformBlock.name == name)
+        if (mUniformBlocks[blockIndex]->name == name)
         {
-            const bool arrayElementZero = (subscript == GL_INVALID_INDEX && uniformBlock.elementIndex == 0);
-            if (subscript == uniformBlock.elementIndex || arrayElementZero)
-            {
-                return blockIndex;
-            }
+            return blockIndex;
         }
     }
 
@@ -141,6 +84,7 @@ void ProgramImpl::reset()
     mUniformIndex.clear();
     SafeDeleteContainer(mUniformBlocks);
     mTransformFeedbackLinkedVaryings.clear();
+    mNameIndex.clear();
 }
 
 }
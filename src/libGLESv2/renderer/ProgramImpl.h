@@ -14,6 +14,7 @@
 #include "libGLESv2/Constants.h"
 #include "libGLESv2/ProgramBinary.h"
 #include "libGLESv2/Shader.h"
+#include "libGLESv2/renderer/ProgramNameIndex.h"
 #include "libGLESv2/renderer/Renderer.h"
 
 #include <map>
@@ -26,7 +27,7 @@ class Renderer;
 class ProgramImpl
 {
   public:
-    ProgramImpl() { }
+    ProgramImpl() : mBinaryRevision(0) { }
     virtual ~ProgramImpl();
 
     const std::vector<gl::LinkedUniform*> &getUniforms() const { return mUniforms; }
@@ -45,14 +46,21 @@ class ProgramImpl
     gl::LinkedUniform *getUniformByName(const std::string &name) const;
     gl::UniformBlock *getUniformBlockByIndex(GLuint blockIndex) const;
 
-    GLint getUniformLocation(std::string name);
-    GLuint getUniformIndex(std::string name);
-    GLuint getUniformBlockIndex(std::string name) const;
+    GLint getUniformLocation(const char *name) const;
+    GLuint getUniformIndex(const char *name) const;
+    GLuint getUniformBlockIndex(const char *name) const;
+
+    // Builds the name index used by the queries above, once linking or loading has succeeded
+    void indexNames();
 
     virtual bool usesPointSize() const = 0;
     virtual int getShaderVersion() const = 0;
     virtual GLenum getTransformFeedbackBufferMode() const = 0;
 
+    // Changes whenever the data written by save changes, e.g. when executables are added after
+    // linking, so that a saved binary can be reused until then.
+    unsigned int getBinaryRevision() const { return mBinaryRevision; }
+
     virtual GLenum getBinaryFormat() = 0;
     virtual gl::LinkResult load(gl::InfoLog &infoLog, gl::BinaryInputStream *stream) = 0;
     virtual gl::Error save(gl::BinaryOutputStream *stream) = 0;
@@ -96,6 +104,7 @@ class ProgramImpl
     virtual GLenum getSamplerTextureType(gl::SamplerType type, unsigned int samplerIndex) const = 0;
     virtual GLint getUsedSamplerRange(gl::SamplerType type) const = 0;
     virtual void updateSamplerMapping() = 0;
+    virtual unsigned int getSamplerMappingSerial() const = 0;
     virtual bool validateSamplers(gl::InfoLog *infoLog, const gl::Caps &caps) = 0;
 
     virtual gl::LinkResult compileProgramExecutables(gl::InfoLog &infoLog, gl::Shader *fragmentShader, gl::Shader *vertexShader,
@@ -114,11 +123,18 @@ class ProgramImpl
   protected:
     DISALLOW_COPY_AND_ASSIGN(ProgramImpl);
 
+    // Linear search used while linking, before the name index exists
+    GLuint findUniformBlockIndex(const std::string &name) const;
+
     std::vector<gl::LinkedUniform*> mUniforms;
     std::vector<gl::VariableLocation> mUniformIndex;
     std::vector<gl::UniformBlock*> mUniformBlocks;
     std::vector<gl::LinkedVarying> mTransformFeedbackLinkedVaryings;
 
+    ProgramNameIndex mNameIndex;
+
+    unsigned int mBinaryRevision;
+
     sh::Attribute mShaderAttributes[gl::MAX_VERTEX_ATTRIBS];
 };
 
@@ -0,0 +1,276 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// ProgramNameIndex.cpp: Implements the rx::ProgramNameIndex class.
+
+#include "libGLESv2/renderer/ProgramNameIndex.h"
+
+#include "libGLESv2/ProgramBinary.h"
+#include "libGLESv2/Uniform.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace rx
+{
+
+namespace
+{
+
+// Returns the length of the name without a trailing array operator, and the subscript of that
+// operator or GL_INVALID_INDEX if there is none. The subscript is parsed with atoi like the
+// name queries have always done.
+size_t ParseArrayIndex(const char *name, unsigned int *subscriptOut)
+{
+    size_t length = strlen(name);
+    *subscriptOut = GL_INVALID_INDEX;
+
+    if (length > 0 && name[length - 1] == ']')
+    {
+        for (size_t open = length - 1; open-- > 0;)
+        {
+            if (name[open] == '[')
+            {
+                *subscriptOut = atoi(name + open + 1);
+                return open;
+            }
+        }
+    }
+
+    return length;
+}
+
+}
+
+ProgramNameIndex::NameTable::NameTable()
+    : mMask(0)
+{
+}
+
+void ProgramNameIndex::NameTable::clear()
+{
+    mSlots.clear();
+    mNames.clear();
+    mMask = 0;
+}
+
+void ProgramNameIndex::NameTable::reserve(size_t count)
+{
+    // Keep the load factor at or below one half
+    size_t slotCount = 8;
+    while (slotCount < count * 2)
+    {
+        slotCount *= 2;
+    }
+
+    Slot emptySlot = { 0, 0, 0, EmptySlot };
+    mSlots.assign(slotCount, emptySlot);
+    mNames.clear();
+    mMask = slotCount - 1;
+}
+
+size_t ProgramNameIndex::NameTable::Hash(const char *name, size_t length)
+{
+    // FNV-1a
+    size_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash = (hash ^ static_cast<unsigned char>(name[i])) * 16777619u;
+    }
+    return hash;
+}
+
+bool ProgramNameIndex::NameTable::matches(const Slot &slot, size_t hash, const char *name, size_t length) const
+{
+    return slot.hash == hash && slot.nameLength == length &&
+           (length == 0 || memcmp(&mNames[slot.nameOffset], name, length) == 0);
+}
+
+void ProgramNameIndex::NameTable::insert(const std::string &name, unsigned int value)
+{
+    ASSERT(value != EmptySlot);
+    ASSERT(!mSlots.empty());
+
+    size_t hash = Hash(name.c_str(), name.length());
+    for (size_t slotIndex = hash & mMask;; slotIndex = (slotIndex + 1) & mMask)
+    {
+        Slot &slot = mSlots[slotIndex];
+        if (slot.value == EmptySlot)
+        {
+            slot.hash = hash;
+            slot.nameOffset = static_cast<unsigned int>(mNames.size());
+            slot.nameLength = static_cast<unsigned int>(name.length());
+            slot.value = value;
+            mNames.insert(mNames.end(), name.begin(), name.end());
+            return;
+        }
+
+        if (matches(slot, hash, name.c_str(), name.length()))
+        {
+            return;
+        }
+    }
+}
+
+bool ProgramNameIndex::NameTable::find(const char *name, size_t length, unsigned int *valueOut) const
+{
+    if (mSlots.empty())
+    {
+        return false;
+    }
+
+    size_t hash = Hash(name, length);
+    for (size_t slotIndex = hash & mMask;; slotIndex = (slotIndex + 1) & mMask)
+    {
+        const Slot &slot = mSlots[slotIndex];
+        if (slot.value == EmptySlot)
+        {
+            return false;
+        }
+
+        if (matches(slot, hash, name, length))
+        {
+            *valueOut = slot.value;
+            return true;
+        }
+    }
+}
+
+ProgramNameIndex::ProgramNameIndex()
+{
+}
+
+void ProgramNameIndex::build(const std::vector<gl::LinkedUniform*> &uniforms, const std::vector<gl::VariableLocation> &uniformIndex,
+                             const std::vector<gl::UniformBlock*> &uniformBlocks)
+{
+    clear();
+
+    mUniformNames.reserve(uniforms.size());
+    mUniformSpans.resize(uniforms.size());
+    for (size_t index = 0; index < uniforms.size(); index++)
+    {
+        const gl::LinkedUniform &uniform = *uniforms[index];
+        mUniformNames.insert(uniform.name, static_cast<unsigned int>(index));
+
+        // Uniforms without locations, like gl_DepthRange, keep a first location of -1
+        UniformSpan &span = mUniformSpans[index];
+        span.firstLocation = -1;
+        span.elementCount = uniform.elementCount();
+        span.isArray = uniform.isArray();
+    }
+
+    // The locations of the elements of a uniform are contiguous
+    for (size_t location = 0; location < uniformIndex.size(); location++)
+    {
+        const gl::VariableLocation &variableLocation = uniformIndex[location];
+        UniformSpan &span = mUniformSpans[variableLocation.index];
+        if (span.firstLocation == -1)
+        {
+            span.firstLocation = static_cast<GLint>(location);
+        }
+        ASSERT(static_cast<size_t>(span.firstLocation) + variableLocation.element == location);
+    }
+
+    mUniformBlockNames.reserve(uniformBlocks.size());
+    mUniformBlockElements.resize(uniformBlocks.size());
+    for (size_t blockIndex = 0; blockIndex < uniformBlocks.size(); blockIndex++)
+    {
+        const gl::UniformBlock &uniformBlock = *uniformBlocks[blockIndex];
+        mUniformBlockNames.insert(uniformBlock.name, static_cast<unsigned int>(blockIndex));
+        mUniformBlockElements[blockIndex] = uniformBlock.elementIndex;
+    }
+}
+
+void ProgramNameIndex::clear()
+{
+    mUniformNames.clear();
+    mUniformSpans.clear();
+    mUniformBlockNames.clear();
+    mUniformBlockElements.clear();
+}
+
+GLint ProgramNameIndex::getUniformLocation(const char *name) const
+{
+    unsigned int subscript;
+    size_t length = ParseArrayIndex(name, &subscript);
+
+    unsigned int index;
+    if (!mUniformNames.find(name, length, &index))
+    {
+        return -1;
+    }
+
+    const UniformSpan &span = mUniformSpans[index];
+    if (span.firstLocation == -1 || subscript == GL_INVALID_INDEX)
+    {
+        return span.firstLocation;
+    }
+
+    if (span.isArray && subscript < span.elementCount)
+    {
+        return span.firstLocation + static_cast<GLint>(subscript);
+    }
+
+    return -1;
+}
+
+GLuint ProgramNameIndex::getUniformIndex(const char *name) const
+{
+    unsigned int subscript;
+    size_t length = ParseArrayIndex(name, &subscript);
+
+    // The app is not allowed to specify array indices other than 0 for arrays of basic types
+    if (subscript != 0 && subscript != GL_INVALID_INDEX)
+    {
+        return GL_INVALID_INDEX;
+    }
+
+    unsigned int index;
+    if (!mUniformNames.find(name, length, &index))
+    {
+        return GL_INVALID_INDEX;
+    }
+
+    if (mUniformSpans[index].isArray || subscript == GL_INVALID_INDEX)
+    {
+        return index;
+    }
+
+    return GL_INVALID_INDEX;
+}
+
+GLuint ProgramNameIndex::getUniformBlockIndex(const char *name) const
+{
+    unsigned int subscript;
+    size_t length = ParseArrayIndex(name, &subscript);
+
+    unsigned int firstBlockIndex;
+    if (!mUniformBlockNames.find(name, length, &firstBlockIndex))
+    {
+        return GL_INVALID_INDEX;
+    }
+
+    // A name without a subscript selects a block that is not an array, or element zero of one
+    if (subscript == GL_INVALID_INDEX)
+    {
+        return firstBlockIndex;
+    }
+
+    // The elements of a block array are stored in order and each array restarts at element zero,
+    // so the block holding element N of this array, if it exists, is N blocks after the first.
+    if (subscript < mUniformBlockElements.size() - firstBlockIndex)
+    {
+        const unsigned int blockIndex = firstBlockIndex + subscript;
+        if (mUniformBlockElements[blockIndex] == subscript)
+        {
+            return blockIndex;
+        }
+    }
+
+    return GL_INVALID_INDEX;
+}
+
+}
@@ -0,0 +1,97 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// ProgramNameIndex.h: Defines the rx::ProgramNameIndex class, which answers uniform and
+// uniform block name queries of a linked program with hash lookups.
+
+#ifndef LIBGLESV2_RENDERER_PROGRAMNAMEINDEX_H_
+#define LIBGLESV2_RENDERER_PROGRAMNAMEINDEX_H_
+
+#include "common/angleutils.h"
+
+#include "angle_gl.h"
+
+#include <string>
+#include <vector>
+
+namespace gl
+{
+struct LinkedUniform;
+struct UniformBlock;
+struct VariableLocation;
+}
+
+namespace rx
+{
+
+// Built once a program is linked or loaded. Names are hashed without any trailing array
+// subscript, which is resolved arithmetically against the span of locations or blocks that
+// belong to the base name, so lookups do not allocate.
+class ProgramNameIndex
+{
+  public:
+    ProgramNameIndex();
+
+    void build(const std::vector<gl::LinkedUniform*> &uniforms, const std::vector<gl::VariableLocation> &uniformIndex,
+               const std::vector<gl::UniformBlock*> &uniformBlocks);
+    void clear();
+
+    GLint getUniformLocation(const char *name) const;
+    GLuint getUniformIndex(const char *name) const;
+    GLuint getUniformBlockIndex(const char *name) const;
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(ProgramNameIndex);
+
+    // Open-addressing table from a name to an unsigned value, storing its own copy of the names.
+    class NameTable
+    {
+      public:
+        NameTable();
+
+        void clear();
+        void reserve(size_t count);
+
+        // Keeps the first value inserted for a name
+        void insert(const std::string &name, unsigned int value);
+        bool find(const char *name, size_t length, unsigned int *valueOut) const;
+
+      private:
+        struct Slot
+        {
+            size_t hash;
+            unsigned int nameOffset;
+            unsigned int nameLength;
+            unsigned int value;
+        };
+
+        static size_t Hash(const char *name, size_t length);
+        bool matches(const Slot &slot, size_t hash, const char *name, size_t length) const;
+
+        static const unsigned int EmptySlot = 0xFFFFFFFFu;
+
+        std::vector<Slot> mSlots;
+        std::vector<char> mNames;
+        size_t mMask;
+    };
+
+    struct UniformSpan
+    {
+        GLint firstLocation;
+        unsigned int elementCount;
+        bool isArray;
+    };
+
+    NameTable mUniformNames;
+    std::vector<UniformSpan> mUniformSpans;
+
+    NameTable mUniformBlockNames;
+    std::vector<unsigned int> mUniformBlockElements;
+};
+
+}
+
+#endif // LIBGLESV2_RENDERER_PROGRAMNAMEINDEX_H_
@@ -10,6 +10,8 @@
 #include "libGLESv2/Program.h"
 #include "libGLESv2/renderer/Renderer.h"
 #include "common/utilities.h"
+#include "common/features.h"
+#include "common/WorkerPool.h"
 #include "third_party/trace_event/trace_event.h"
 #include "libGLESv2/Shader.h"
 
@@ -34,6 +36,8 @@
 
 #include <EGL/eglext.h>
 
+#include <algorithm>
+
 namespace rx
 {
 
@@ -41,12 +45,16 @@ Renderer::Renderer(egl::Display *display)
     : mDisplay(display),
       mCapsInitialized(false),
       mWorkaroundsInitialized(false),
-      mCurrentClientVersion(2)
+      mWorkerPoolInitialized(false),
+      mWorkerPool(NULL),
+      mCurrentClientVersion(2),
+      mAppliedStateSerial(0)
 {
 }
 
 Renderer::~Renderer()
 {
+    SafeDelete(mWorkerPool);
 }
 
 const gl::Caps &Renderer::getRendererCaps() const
@@ -93,6 +101,26 @@ const Workarounds &Renderer::getWorkarounds() const
     return mWorkarounds;
 }
 
+gl::WorkerPool *Renderer::getWorkerPool() const
+{
+    if (!mWorkerPoolInitialized)
+    {
+#if ANGLE_PARALLEL_IMAGE_PROCESSING == ANGLE_ENABLED
+        // Image conversions are bound by memory bandwidth long before they run out of cores
+        static const size_t maxImageThreads = 4;
+
+        size_t threadCount = std::min(gl::WorkerPool::GetHardwareThreadCount(), maxImageThreads);
+        if (threadCount > 1)
+        {
+            mWorkerPool = new gl::WorkerPool(threadCount);
+        }
+#endif
+        mWorkerPoolInitialized = true;
+    }
+
+    return mWorkerPool;
+}
+
 typedef Renderer *(*CreateRendererFunction)(egl::Display*, EGLNativeDisplayType, const egl::AttributeMap &);
 
 template <typename RendererType>
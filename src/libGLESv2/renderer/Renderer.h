@@ -66,6 +66,7 @@ class Buffer;
 class Texture;
 class Framebuffer;
 struct VertexAttribCurrentValueData;
+class WorkerPool;
 }
 
 namespace rx
@@ -244,6 +245,7 @@ class Renderer
     // Image operations
     virtual Image *createImage() = 0;
     virtual gl::Error generateMipmap(Image *dest, Image *source) = 0;
+    virtual gl::Error generateMipmapChain(Image *const *images, size_t imageCount) = 0;
     virtual TextureStorage *createTextureStorage2D(SwapChain *swapChain) = 0;
     virtual TextureStorage *createTextureStorage2D(GLenum internalformat, bool renderTarget, GLsizei width, GLsizei height, int levels, bool hintLevelZeroOnly = false) = 0;
     virtual TextureStorage *createTextureStorageCube(GLenum internalformat, bool renderTarget, int size, int levels) = 0;
@@ -284,7 +286,18 @@ class Renderer
 
     const Workarounds &getWorkarounds() const;
 
+    // Threads for splitting large image loads, readbacks and mip generation, NULL when
+    // ANGLE_PARALLEL_IMAGE_PROCESSING is disabled or the machine has a single core.
+    gl::WorkerPool *getWorkerPool() const;
+
+    // Changes whenever the device state applied through setRasterizerState, setBlendState,
+    // setDepthStencilState, setViewport and setScissorRectangle has to be applied again,
+    // because the render targets changed or the state was overwritten behind the caller's back.
+    unsigned int getAppliedStateSerial() const { return mAppliedStateSerial; }
+
   protected:
+    void invalidateAppliedState() { mAppliedStateSerial++; }
+
     egl::Display *mDisplay;
 
   private:
@@ -301,7 +314,12 @@ class Renderer
     mutable bool mWorkaroundsInitialized;
     mutable Workarounds mWorkarounds;
 
+    mutable bool mWorkerPoolInitialized;
+    mutable gl::WorkerPool *mWorkerPool;
+
     int mCurrentClientVersion;
+
+    unsigned int mAppliedStateSerial;
 };
 
 }
@@ -104,10 +104,63 @@ bool IsRowMajorLayout(const sh::ShaderVariable &var)
 
 }
 
+ProgramD3D::LazyExecutable::LazyExecutable(ShaderExecutable *shaderExecutable)
+    : mShaderExecutable(shaderExecutable)
+{
+}
+
+ProgramD3D::LazyExecutable::LazyExecutable(const uint8_t *function, size_t length)
+    : mShaderExecutable(NULL),
+      mFunction(function, function + length)
+{
+}
+
+ProgramD3D::LazyExecutable::~LazyExecutable()
+{
+    SafeDelete(mShaderExecutable);
+}
+
+void ProgramD3D::LazyExecutable::setShaderExecutable(ShaderExecutable *shaderExecutable)
+{
+    ASSERT(mShaderExecutable == NULL);
+    mShaderExecutable = shaderExecutable;
+
+    // The executable keeps its own copy of the function
+    std::vector<uint8_t>().swap(mFunction);
+}
+
+const uint8_t *ProgramD3D::LazyExecutable::function() const
+{
+    if (mShaderExecutable)
+    {
+        return mShaderExecutable->getFunction();
+    }
+
+    return mFunction.empty() ? NULL : &mFunction[0];
+}
+
+size_t ProgramD3D::LazyExecutable::functionLength() const
+{
+    return mShaderExecutable ? mShaderExecutable->getLength() : mFunction.size();
+}
+
 ProgramD3D::VertexExecutable::VertexExecutable(const gl::VertexFormat inputLayout[],
                                                const GLenum signature[],
                                                ShaderExecutable *shaderExecutable)
-    : mShaderExecutable(shaderExecutable)
+    : LazyExecutable(shaderExecutable)
+{
+    setLayout(inputLayout, signature);
+}
+
+ProgramD3D::VertexExecutable::VertexExecutable(const gl::VertexFormat inputLayout[],
+                                               const GLenum signature[],
+                                               const uint8_t *function, size_t length)
+    : LazyExecutable(function, length)
+{
+    setLayout(inputLayout, signature);
+}
+
+void ProgramD3D::VertexExecutable::setLayout(const gl::VertexFormat inputLayout[], const GLenum signature[])
 {
     for (size_t attributeIndex = 0; attributeIndex < gl::MAX_VERTEX_ATTRIBS; attributeIndex++)
     {
@@ -116,11 +169,6 @@ ProgramD3D::VertexExecutable::VertexExecutable(const gl::VertexFormat inputLayou
     }
 }
 
-ProgramD3D::VertexExecutable::~VertexExecutable()
-{
-    SafeDelete(mShaderExecutable);
-}
-
 bool ProgramD3D::VertexExecutable::matchesSignature(const GLenum signature[]) const
 {
     for (size_t attributeIndex = 0; attributeIndex < gl::MAX_VERTEX_ATTRIBS; attributeIndex++)
@@ -135,14 +183,15 @@ bool ProgramD3D::VertexExecutable::matchesSignature(const GLenum signature[]) co
 }
 
 ProgramD3D::PixelExecutable::PixelExecutable(const std::vector<GLenum> &outputSignature, ShaderExecutable *shaderExecutable)
-    : mOutputSignature(outputSignature),
-      mShaderExecutable(shaderExecutable)
+    : LazyExecutable(shaderExecutable),
+      mOutputSignature(outputSignature)
 {
 }
 
-ProgramD3D::PixelExecutable::~PixelExecutable()
+ProgramD3D::PixelExecutable::PixelExecutable(const std::vector<GLenum> &outputSignature, const uint8_t *function, size_t length)
+    : LazyExecutable(function, length),
+      mOutputSignature(outputSignature)
 {
-    SafeDelete(mShaderExecutable);
 }
 
 ProgramD3D::Sampler::Sampler() : active(false), logicalTextureUnit(0), textureType(GL_TEXTURE_2D)
@@ -162,6 +211,9 @@ ProgramD3D::ProgramD3D(Renderer *renderer)
       mUsedVertexSamplerRange(0),
       mUsedPixelSamplerRange(0),
       mDirtySamplerMapping(true),
+      mSamplerMappingSerial(0),
+      mSamplerValidationCached(false),
+      mCachedSamplersValid(false),
       mShaderVersion(100)
 {
     mDynamicHLSL = new DynamicHLSL(renderer);
@@ -268,6 +320,7 @@ void ProgramD3D::updateSamplerMapping()
     }
 
     mDirtySamplerMapping = false;
+    mSamplerMappingSerial++;
 
     // Retrieve sampler uniform values
     for (size_t uniformIndex = 0; uniformIndex < mUniforms.size(); uniformIndex++)
@@ -318,6 +371,22 @@ void ProgramD3D::updateSamplerMapping()
 }
 
 bool ProgramD3D::validateSamplers(gl::InfoLog *infoLog, const gl::Caps &caps)
+{
+    if (infoLog == NULL)
+    {
+        if (!mSamplerValidationCached)
+        {
+            mCachedSamplersValid = validateSamplerMapping(NULL, caps);
+            mSamplerValidationCached = true;
+        }
+
+        return mCachedSamplersValid;
+    }
+
+    return validateSamplerMapping(infoLog, caps);
+}
+
+bool ProgramD3D::validateSamplerMapping(gl::InfoLog *infoLog, const gl::Caps &caps)
 {
     // if any two active samplers in a program are of different types, but refer to the same
     // texture image unit, and this is the current program, then ValidateProgram will fail, and
@@ -553,20 +622,10 @@ gl::LinkResult ProgramD3D::load(gl::InfoLog &infoLog, gl::BinaryInputStream *str
         unsigned int vertexShaderSize = stream->readInt<unsigned int>();
         const unsigned char *vertexShaderFunction = binary + stream->offset();
 
-        ShaderExecutable *shaderExecutable = NULL;
-        gl::Error error = mRenderer->loadExecutable(vertexShaderFunction, vertexShaderSize,
-                                                    SHADER_VERTEX,
-                                                    mTransformFeedbackLinkedVaryings,
-                                                    (mTransformFeedbackBufferMode == GL_SEPARATE_ATTRIBS),
-                                                    &shaderExecutable);
-        if (error.isError())
-        {
-            return gl::LinkResult(false, error);
-        }
-
-        if (!shaderExecutable)
+        stream->skip(vertexShaderSize);
+        if (stream->error())
         {
-            infoLog.append("Could not create vertex shader.");
+            infoLog.append("Invalid program binary.");
             return gl::LinkResult(false, gl::Error(GL_NO_ERROR));
         }
 
@@ -574,10 +633,8 @@ gl::LinkResult ProgramD3D::load(gl::InfoLog &infoLog, gl::BinaryInputStream *str
         GLenum signature[gl::MAX_VERTEX_ATTRIBS];
         getInputLayoutSignature(inputLayout, signature);
 
-        // add new binary
-        mVertexExecutables.push_back(new VertexExecutable(inputLayout, signature, shaderExecutable));
-
-        stream->skip(vertexShaderSize);
+        // the shader is created the first time this input layout is drawn with
+        mVertexExecutables.push_back(new VertexExecutable(inputLayout, signature, vertexShaderFunction, vertexShaderSize));
     }
 
     const size_t pixelShaderCount = stream->readInt<unsigned int>();
@@ -592,26 +649,50 @@ gl::LinkResult ProgramD3D::load(gl::InfoLog &infoLog, gl::BinaryInputStream *str
 
         const size_t pixelShaderSize = stream->readInt<unsigned int>();
         const unsigned char *pixelShaderFunction = binary + stream->offset();
-        ShaderExecutable *shaderExecutable = NULL;
-        gl::Error error = mRenderer->loadExecutable(pixelShaderFunction, pixelShaderSize, SHADER_PIXEL,
-                                                    mTransformFeedbackLinkedVaryings,
-                                                    (mTransformFeedbackBufferMode == GL_SEPARATE_ATTRIBS),
-                                                    &shaderExecutable);
+
+        stream->skip(pixelShaderSize);
+        if (stream->error())
+        {
+            infoLog.append("Invalid program binary.");
+            return gl::LinkResult(false, gl::Error(GL_NO_ERROR));
+        }
+
+        // the shader is created the first time this output layout is drawn with
+        mPixelExecutables.push_back(new PixelExecutable(outputs, pixelShaderFunction, pixelShaderSize));
+    }
+
+    // The first executables are those of the default layouts, which link creates. Creating them
+    // now makes a binary the driver rejects fail the load, as it fails a link.
+    if (!mVertexExecutables.empty())
+    {
+        ShaderExecutable *defaultVertexExecutable = NULL;
+        gl::Error error = loadLazyExecutable(mVertexExecutables[0], SHADER_VERTEX, &defaultVertexExecutable);
         if (error.isError())
         {
             return gl::LinkResult(false, error);
         }
 
-        if (!shaderExecutable)
+        if (!defaultVertexExecutable)
         {
-            infoLog.append("Could not create pixel shader.");
+            infoLog.append("Could not create vertex shader.");
             return gl::LinkResult(false, gl::Error(GL_NO_ERROR));
         }
+    }
 
-        // add new binary
-        mPixelExecutables.push_back(new PixelExecutable(outputs, shaderExecutable));
+    if (!mPixelExecutables.empty())
+    {
+        ShaderExecutable *defaultPixelExecutable = NULL;
+        gl::Error error = loadLazyExecutable(mPixelExecutables[0], SHADER_PIXEL, &defaultPixelExecutable);
+        if (error.isError())
+        {
+            return gl::LinkResult(false, error);
+        }
 
-        stream->skip(pixelShaderSize);
+        if (!defaultPixelExecutable)
+        {
+            infoLog.append("Could not create pixel shader.");
+            return gl::LinkResult(false, gl::Error(GL_NO_ERROR));
+        }
     }
 
     unsigned int geometryShaderSize = stream->readInt<unsigned int>();
@@ -647,6 +728,7 @@ gl::LinkResult ProgramD3D::load(gl::InfoLog &infoLog, gl::BinaryInputStream *str
     }
 
     initializeUniformStorage();
+    dirtyAllUniforms();
 
     return gl::LinkResult(true, gl::Error(GL_NO_ERROR));
 }
@@ -769,10 +851,10 @@ gl::Error ProgramD3D::save(gl::BinaryOutputStream *stream)
             stream->writeInt(vertexInput.mPureInteger);
         }
 
-        size_t vertexShaderSize = vertexExecutable->shaderExecutable()->getLength();
+        size_t vertexShaderSize = vertexExecutable->functionLength();
         stream->writeInt(vertexShaderSize);
 
-        const uint8_t *vertexBlob = vertexExecutable->shaderExecutable()->getFunction();
+        const uint8_t *vertexBlob = vertexExecutable->function();
         stream->writeBytes(vertexBlob, vertexShaderSize);
     }
 
@@ -788,10 +870,10 @@ gl::Error ProgramD3D::save(gl::BinaryOutputStream *stream)
             stream->writeInt(outputs[outputIndex]);
         }
 
-        size_t pixelShaderSize = pixelExecutable->shaderExecutable()->getLength();
+        size_t pixelShaderSize = pixelExecutable->functionLength();
         stream->writeInt(pixelShaderSize);
 
-        const uint8_t *pixelBlob = pixelExecutable->shaderExecutable()->getFunction();
+        const uint8_t *pixelBlob = pixelExecutable->function();
         stream->writeBytes(pixelBlob, pixelShaderSize);
     }
 
@@ -839,8 +921,7 @@ gl::Error ProgramD3D::getPixelExecutableForOutputLayout(const std::vector<GLenum
     {
         if (mPixelExecutables[executableIndex]->matchesSignature(outputSignature))
         {
-            *outExectuable = mPixelExecutables[executableIndex]->shaderExecutable();
-            return gl::Error(GL_NO_ERROR);
+            return loadLazyExecutable(mPixelExecutables[executableIndex], SHADER_PIXEL, outExectuable);
         }
     }
 
@@ -868,6 +949,7 @@ gl::Error ProgramD3D::getPixelExecutableForOutputLayout(const std::vector<GLenum
     else
     {
         mPixelExecutables.push_back(new PixelExecutable(outputSignature, pixelExecutable));
+        mBinaryRevision++;
     }
 
     *outExectuable = pixelExecutable;
@@ -883,8 +965,7 @@ gl::Error ProgramD3D::getVertexExecutableForInputLayout(const gl::VertexFormat i
     {
         if (mVertexExecutables[executableIndex]->matchesSignature(signature))
         {
-            *outExectuable = mVertexExecutables[executableIndex]->shaderExecutable();
-            return gl::Error(GL_NO_ERROR);
+            return loadLazyExecutable(mVertexExecutables[executableIndex], SHADER_VERTEX, outExectuable);
         }
     }
 
@@ -912,12 +993,41 @@ gl::Error ProgramD3D::getVertexExecutableForInputLayout(const gl::VertexFormat i
     else
     {
         mVertexExecutables.push_back(new VertexExecutable(inputLayout, signature, vertexExecutable));
+        mBinaryRevision++;
     }
 
     *outExectuable = vertexExecutable;
     return gl::Error(GL_NO_ERROR);
 }
 
+gl::Error ProgramD3D::loadLazyExecutable(LazyExecutable *executable, ShaderType type, ShaderExecutable **outExecutable)
+{
+    if (!executable->isLoaded())
+    {
+        ShaderExecutable *shaderExecutable = NULL;
+        gl::Error error = mRenderer->loadExecutable(executable->function(), executable->functionLength(), type,
+                                                    mTransformFeedbackLinkedVaryings,
+                                                    (mTransformFeedbackBufferMode == GL_SEPARATE_ATTRIBS),
+                                                    &shaderExecutable);
+        if (error.isError())
+        {
+            return error;
+        }
+
+        if (!shaderExecutable)
+        {
+            ERR("Could not create %s shader from the program binary.", type == SHADER_VERTEX ? "vertex" : "pixel");
+            *outExecutable = NULL;
+            return gl::Error(GL_NO_ERROR);
+        }
+
+        executable->setShaderExecutable(shaderExecutable);
+    }
+
+    *outExecutable = executable->shaderExecutable();
+    return gl::Error(GL_NO_ERROR);
+}
+
 gl::LinkResult ProgramD3D::compileProgramExecutables(gl::InfoLog &infoLog, gl::Shader *fragmentShader, gl::Shader *vertexShader,
                                                      int registers)
 {
@@ -1076,10 +1186,11 @@ gl::Error ProgramD3D::applyUniforms()
         return error;
     }
 
-    for (size_t uniformIndex = 0; uniformIndex < mUniforms.size(); uniformIndex++)
+    for (size_t dirtyIndex = 0; dirtyIndex < mDirtyUniformIndices.size(); dirtyIndex++)
     {
-        mUniforms[uniformIndex]->dirty = false;
+        mUniforms[mDirtyUniformIndices[dirtyIndex]]->clearDirtyRows();
     }
+    mDirtyUniformIndices.clear();
 
     return gl::Error(GL_NO_ERROR);
 }
@@ -1161,10 +1272,13 @@ bool ProgramD3D::assignUniformBlockRegister(gl::InfoLog &infoLog, gl::UniformBlo
 
 void ProgramD3D::dirtyAllUniforms()
 {
+    mDirtyUniformIndices.clear();
+
     unsigned int numUniforms = mUniforms.size();
     for (unsigned int index = 0; index < numUniforms; index++)
     {
-        mUniforms[index]->dirty = true;
+        mUniforms[index]->markAllRowsDirty();
+        mDirtyUniformIndices.push_back(index);
     }
 }
 
@@ -1359,6 +1473,8 @@ bool ProgramD3D::linkUniforms(gl::InfoLog &infoLog, const gl::Shader &vertexShad
         mUniforms.push_back(new gl::LinkedUniform(GL_FLOAT, GL_HIGH_FLOAT, "gl_DepthRange.diff", 0, -1, defaultInfo));
     }
 
+    dirtyAllUniforms();
+
     return true;
 }
 
@@ -1435,15 +1551,8 @@ void ProgramD3D::defineUniform(GLenum shader, const sh::ShaderVariable &uniform,
     }
 }
 
-template <typename T>
-static inline void SetIfDirty(T *dest, const T& source, bool *dirtyFlag)
-{
-    ASSERT(dest != NULL);
-    ASSERT(dirtyFlag != NULL);
-
-    *dirtyFlag = *dirtyFlag || (memcmp(dest, &source, sizeof(T)) != 0);
-    *dest = source;
-}
+// Number of rows formatted on the stack before they are written to a uniform in one go
+static const unsigned int UniformStagingRows = 64;
 
 template <typename T>
 void ProgramD3D::setUniform(GLint location, GLsizei count, const T* v, GLenum targetUniformType)
@@ -1452,80 +1561,77 @@ void ProgramD3D::setUniform(GLint location, GLsizei count, const T* v, GLenum ta
     const GLenum targetBoolType = gl::VariableBoolVectorType(targetUniformType);
 
     gl::LinkedUniform *targetUniform = getUniformByLocation(location);
+    const unsigned int firstElement = mUniformIndex[location].element;
 
     int elementCount = targetUniform->elementCount();
 
-    count = std::min(elementCount - (int)mUniformIndex[location].element, count);
+    count = std::min(elementCount - (int)firstElement, count);
 
-    if (targetUniform->type == targetUniformType)
-    {
-        T *target = reinterpret_cast<T*>(targetUniform->data) + mUniformIndex[location].element * 4;
-
-        for (int i = 0; i < count; i++)
-        {
-            T *dest = target + (i * 4);
-            const T *source = v + (i * components);
+    const bool wasDirty = targetUniform->dirty;
+    bool changed = false;
 
-            for (int c = 0; c < components; c++)
-            {
-                SetIfDirty(dest + c, source[c], &targetUniform->dirty);
-            }
-            for (int c = components; c < 4; c++)
-            {
-                SetIfDirty(dest + c, T(0), &targetUniform->dirty);
-            }
-        }
-    }
-    else if (targetUniform->type == targetBoolType)
+    if (targetUniform->type == targetUniformType && components == 4)
     {
-        GLint *boolParams = reinterpret_cast<GLint*>(targetUniform->data) + mUniformIndex[location].element * 4;
-
-        for (int i = 0; i < count; i++)
-        {
-            GLint *dest = boolParams + (i * 4);
-            const T *source = v + (i * components);
-
-            for (int c = 0; c < components; c++)
-            {
-                SetIfDirty(dest + c, (source[c] == static_cast<T>(0)) ? GL_FALSE : GL_TRUE, &targetUniform->dirty);
-            }
-            for (int c = components; c < 4; c++)
-            {
-                SetIfDirty(dest + c, GL_FALSE, &targetUniform->dirty);
-            }
-        }
+        // vec4 arrays are already laid out as rows
+        changed = targetUniform->writeRows(firstElement, v, count);
     }
-    else if (gl::IsSampler(targetUniform->type))
+    else
     {
-        ASSERT(targetUniformType == GL_INT);
-
-        GLint *target = reinterpret_cast<GLint*>(targetUniform->data) + mUniformIndex[location].element * 4;
+        const bool isBool = (targetUniform->type == targetBoolType);
+        const bool isSampler = gl::IsSampler(targetUniform->type);
+        ASSERT(targetUniform->type == targetUniformType || isBool || isSampler);
+        ASSERT(!isSampler || targetUniformType == GL_INT);
 
-        bool wasDirty = targetUniform->dirty;
+        // Samplers only keep their first component
+        const int copiedComponents = (isSampler ? 1 : components);
 
-        for (int i = 0; i < count; i++)
+        T rows[UniformStagingRows][4];
+        for (int firstRow = 0; firstRow < count; firstRow += UniformStagingRows)
         {
-            GLint *dest = target + (i * 4);
-            const GLint *source = reinterpret_cast<const GLint*>(v) + (i * components);
+            const int rowCount = std::min(count - firstRow, static_cast<int>(UniformStagingRows));
+            for (int i = 0; i < rowCount; i++)
+            {
+                const T *source = v + ((firstRow + i) * components);
+                T *row = rows[i];
 
-            SetIfDirty(dest + 0, source[0], &targetUniform->dirty);
-            SetIfDirty(dest + 1, 0, &targetUniform->dirty);
-            SetIfDirty(dest + 2, 0, &targetUniform->dirty);
-            SetIfDirty(dest + 3, 0, &targetUniform->dirty);
+                for (int c = 0; c < copiedComponents; c++)
+                {
+                    if (isBool)
+                    {
+                        GLint boolValue = (source[c] == static_cast<T>(0)) ? GL_FALSE : GL_TRUE;
+                        memcpy(row + c, &boolValue, sizeof(T));
+                    }
+                    else
+                    {
+                        row[c] = source[c];
+                    }
+                }
+                for (int c = copiedComponents; c < 4; c++)
+                {
+                    // GL_FALSE and zero share their representation
+                    row[c] = T(0);
+                }
+            }
+
+            changed = targetUniform->writeRows(firstElement + firstRow, rows, rowCount) || changed;
         }
 
-        if (!wasDirty && targetUniform->dirty)
+        if (isSampler && changed)
         {
             mDirtySamplerMapping = true;
+            mSamplerValidationCached = false;
         }
     }
-    else UNREACHABLE();
+
+    if (!wasDirty && changed)
+    {
+        mDirtyUniformIndices.push_back(mUniformIndex[location].index);
+    }
 }
 
 template<typename T>
-bool transposeMatrix(T *target, const GLfloat *value, int targetWidth, int targetHeight, int srcWidth, int srcHeight)
+void transposeMatrix(T *target, const GLfloat *value, int targetWidth, int targetHeight, int srcWidth, int srcHeight)
 {
-    bool dirty = false;
     int copyWidth = std::min(targetHeight, srcWidth);
     int copyHeight = std::min(targetWidth, srcHeight);
 
@@ -1533,7 +1639,7 @@ bool transposeMatrix(T *target, const GLfloat *value, int targetWidth, int targe
     {
         for (int y = 0; y < copyHeight; y++)
         {
-            SetIfDirty(target + (x * targetWidth + y), static_cast<T>(value[y * srcWidth + x]), &dirty);
+            target[x * targetWidth + y] = static_cast<T>(value[y * srcWidth + x]);
         }
     }
     // clear unfilled right side
@@ -1541,7 +1647,7 @@ bool transposeMatrix(T *target, const GLfloat *value, int targetWidth, int targe
     {
         for (int x = copyHeight; x < targetWidth; x++)
         {
-            SetIfDirty(target + (y * targetWidth + x), static_cast<T>(0), &dirty);
+            target[y * targetWidth + x] = static_cast<T>(0);
         }
     }
     // clear unfilled bottom.
@@ -1549,17 +1655,14 @@ bool transposeMatrix(T *target, const GLfloat *value, int targetWidth, int targe
     {
         for (int x = 0; x < targetWidth; x++)
         {
-            SetIfDirty(target + (y * targetWidth + x), static_cast<T>(0), &dirty);
+            target[y * targetWidth + x] = static_cast<T>(0);
         }
     }
-
-    return dirty;
 }
 
 template<typename T>
-bool expandMatrix(T *target, const GLfloat *value, int targetWidth, int targetHeight, int srcWidth, int srcHeight)
+void expandMatrix(T *target, const GLfloat *value, int targetWidth, int targetHeight, int srcWidth, int srcHeight)
 {
-    bool dirty = false;
     int copyWidth = std::min(targetWidth, srcWidth);
     int copyHeight = std::min(targetHeight, srcHeight);
 
@@ -1567,7 +1670,7 @@ bool expandMatrix(T *target, const GLfloat *value, int targetWidth, int targetHe
     {
         for (int x = 0; x < copyWidth; x++)
         {
-            SetIfDirty(target + (y * targetWidth + x), static_cast<T>(value[y * srcWidth + x]), &dirty);
+            target[y * targetWidth + x] = static_cast<T>(value[y * srcWidth + x]);
         }
     }
     // clear unfilled right side
@@ -1575,7 +1678,7 @@ bool expandMatrix(T *target, const GLfloat *value, int targetWidth, int targetHe
     {
         for (int x = copyWidth; x < targetWidth; x++)
         {
-            SetIfDirty(target + (y * targetWidth + x), static_cast<T>(0), &dirty);
+            target[y * targetWidth + x] = static_cast<T>(0);
         }
     }
     // clear unfilled bottom.
@@ -1583,37 +1686,55 @@ bool expandMatrix(T *target, const GLfloat *value, int targetWidth, int targetHe
     {
         for (int x = 0; x < targetWidth; x++)
         {
-            SetIfDirty(target + (y * targetWidth + x), static_cast<T>(0), &dirty);
+            target[y * targetWidth + x] = static_cast<T>(0);
         }
     }
-
-    return dirty;
 }
 
 template <int cols, int rows>
 void ProgramD3D::setUniformMatrixfv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value, GLenum targetUniformType)
 {
     gl::LinkedUniform *targetUniform = getUniformByLocation(location);
+    const unsigned int firstElement = mUniformIndex[location].element;
 
     int elementCount = targetUniform->elementCount();
 
-    count = std::min(elementCount - (int)mUniformIndex[location].element, count);
+    count = std::min(elementCount - (int)firstElement, count);
     const unsigned int targetMatrixStride = (4 * rows);
-    GLfloat *target = (GLfloat*)(targetUniform->data + mUniformIndex[location].element * sizeof(GLfloat) * targetMatrixStride);
 
-    for (int i = 0; i < count; i++)
+    const bool wasDirty = targetUniform->dirty;
+    bool changed = false;
+
+    // Each matrix takes one row per register
+    const int stagedMatrices = UniformStagingRows / rows;
+    GLfloat staging[UniformStagingRows * 4];
+
+    for (int firstMatrix = 0; firstMatrix < count; firstMatrix += stagedMatrices)
     {
-        // Internally store matrices as transposed versions to accomodate HLSL matrix indexing
-        if (transpose == GL_FALSE)
-        {
-            targetUniform->dirty = transposeMatrix<GLfloat>(target, value, 4, rows, rows, cols) || targetUniform->dirty;
-        }
-        else
+        const int matrixCount = std::min(count - firstMatrix, stagedMatrices);
+        GLfloat *target = staging;
+
+        for (int i = 0; i < matrixCount; i++)
         {
-            targetUniform->dirty = expandMatrix<GLfloat>(target, value, 4, rows, cols, rows) || targetUniform->dirty;
+            // Internally store matrices as transposed versions to accomodate HLSL matrix indexing
+            if (transpose == GL_FALSE)
+            {
+                transposeMatrix<GLfloat>(target, value, 4, rows, rows, cols);
+            }
+            else
+            {
+                expandMatrix<GLfloat>(target, value, 4, rows, cols, rows);
+            }
+            target += targetMatrixStride;
+            value += cols * rows;
         }
-        target += targetMatrixStride;
-        value += cols * rows;
+
+        changed = targetUniform->writeRows((firstElement + firstMatrix) * rows, staging, matrixCount * rows) || changed;
+    }
+
+    if (!wasDirty && changed)
+    {
+        mDirtyUniformIndices.push_back(mUniformIndex[location].index);
     }
 }
 
@@ -1734,7 +1855,7 @@ bool ProgramD3D::defineUniformBlock(gl::InfoLog &infoLog, const gl::Shader &shad
     const rx::ShaderD3D* shaderD3D = rx::ShaderD3D::makeShaderD3D(shader.getImplementation());
 
     // create uniform block entries if they do not exist
-    if (getUniformBlockIndex(interfaceBlock.name) == GL_INVALID_INDEX)
+    if (findUniformBlockIndex(interfaceBlock.name) == GL_INVALID_INDEX)
     {
         std::vector<unsigned int> blockUniformIndexes;
         const unsigned int blockIndex = mUniformBlocks.size();
@@ -1777,7 +1898,7 @@ bool ProgramD3D::defineUniformBlock(gl::InfoLog &infoLog, const gl::Shader &shad
     if (interfaceBlock.staticUse)
     {
         // Assign registers to the uniform blocks
-        const GLuint blockIndex = getUniformBlockIndex(interfaceBlock.name);
+        const GLuint blockIndex = findUniformBlockIndex(interfaceBlock.name);
         const unsigned int elementCount = std::max(1u, interfaceBlock.arraySize);
         ASSERT(blockIndex != GL_INVALID_INDEX);
         ASSERT(blockIndex + elementCount <= mUniformBlocks.size());
@@ -1927,6 +2048,9 @@ void ProgramD3D::reset()
     mUsedVertexSamplerRange = 0;
     mUsedPixelSamplerRange = 0;
     mDirtySamplerMapping = true;
+    mSamplerValidationCached = false;
+
+    mDirtyUniformIndices.clear();
 }
 
 }
@@ -44,6 +44,7 @@ class ProgramD3D : public ProgramImpl
     GLenum getSamplerTextureType(gl::SamplerType type, unsigned int samplerIndex) const;
     GLint getUsedSamplerRange(gl::SamplerType type) const;
     void updateSamplerMapping();
+    unsigned int getSamplerMappingSerial() const { return mSamplerMappingSerial; }
     bool validateSamplers(gl::InfoLog *infoLog, const gl::Caps &caps);
 
     bool usesPointSize() const { return mUsesPointSize; }
@@ -76,6 +77,9 @@ class ProgramD3D : public ProgramImpl
                                     unsigned int registerIndex, const gl::Caps &caps);
     void dirtyAllUniforms();
 
+    // Uniforms written since the last applyUniforms, each listed once
+    const std::vector<unsigned int> &getDirtyUniformIndices() const { return mDirtyUniformIndices; }
+
     void setUniform1fv(GLint location, GLsizei count, const GLfloat *v);
     void setUniform2fv(GLint location, GLsizei count, const GLfloat *v);
     void setUniform3fv(GLint location, GLsizei count, const GLfloat *v);
@@ -114,42 +118,68 @@ class ProgramD3D : public ProgramImpl
   private:
     DISALLOW_COPY_AND_ASSIGN(ProgramD3D);
 
-    class VertexExecutable
+    // An executable read from a program binary is kept as its function bytes until it is first
+    // used, so loading only creates the shaders that are actually drawn with.
+    class LazyExecutable
+    {
+      public:
+        explicit LazyExecutable(rx::ShaderExecutable *shaderExecutable);
+        LazyExecutable(const uint8_t *function, size_t length);
+        ~LazyExecutable();
+
+        bool isLoaded() const { return mShaderExecutable != NULL; }
+        void setShaderExecutable(rx::ShaderExecutable *shaderExecutable);
+        rx::ShaderExecutable *shaderExecutable() const { return mShaderExecutable; }
+
+        const uint8_t *function() const;
+        size_t functionLength() const;
+
+      private:
+        DISALLOW_COPY_AND_ASSIGN(LazyExecutable);
+
+        rx::ShaderExecutable *mShaderExecutable;
+        std::vector<uint8_t> mFunction;
+    };
+
+    class VertexExecutable : public LazyExecutable
     {
       public:
         VertexExecutable(const gl::VertexFormat inputLayout[gl::MAX_VERTEX_ATTRIBS],
                          const GLenum signature[gl::MAX_VERTEX_ATTRIBS],
                          rx::ShaderExecutable *shaderExecutable);
-        ~VertexExecutable();
+        VertexExecutable(const gl::VertexFormat inputLayout[gl::MAX_VERTEX_ATTRIBS],
+                         const GLenum signature[gl::MAX_VERTEX_ATTRIBS],
+                         const uint8_t *function, size_t length);
 
         bool matchesSignature(const GLenum convertedLayout[gl::MAX_VERTEX_ATTRIBS]) const;
 
         const gl::VertexFormat *inputs() const { return mInputs; }
         const GLenum *signature() const { return mSignature; }
-        rx::ShaderExecutable *shaderExecutable() const { return mShaderExecutable; }
 
       private:
+        void setLayout(const gl::VertexFormat inputLayout[gl::MAX_VERTEX_ATTRIBS],
+                       const GLenum signature[gl::MAX_VERTEX_ATTRIBS]);
+
         gl::VertexFormat mInputs[gl::MAX_VERTEX_ATTRIBS];
         GLenum mSignature[gl::MAX_VERTEX_ATTRIBS];
-        rx::ShaderExecutable *mShaderExecutable;
     };
 
-    class PixelExecutable
+    class PixelExecutable : public LazyExecutable
     {
       public:
         PixelExecutable(const std::vector<GLenum> &outputSignature, rx::ShaderExecutable *shaderExecutable);
-        ~PixelExecutable();
+        PixelExecutable(const std::vector<GLenum> &outputSignature, const uint8_t *function, size_t length);
 
         bool matchesSignature(const std::vector<GLenum> &signature) const { return mOutputSignature == signature; }
 
         const std::vector<GLenum> &outputSignature() const { return mOutputSignature; }
-        rx::ShaderExecutable *shaderExecutable() const { return mShaderExecutable; }
 
       private:
         std::vector<GLenum> mOutputSignature;
-        rx::ShaderExecutable *mShaderExecutable;
     };
 
+    gl::Error loadLazyExecutable(LazyExecutable *executable, ShaderType type, ShaderExecutable **outExecutable);
+
     struct Sampler
     {
         Sampler();
@@ -166,6 +196,7 @@ class ProgramD3D : public ProgramImpl
     bool indexUniforms(gl::InfoLog &infoLog, const gl::Caps &caps);
     static bool assignSamplers(unsigned int startSamplerIndex, GLenum samplerType, unsigned int samplerCount,
                                std::vector<Sampler> &outSamplers, GLuint *outUsedRange);
+    bool validateSamplerMapping(gl::InfoLog *infoLog, const gl::Caps &caps);
 
     template <typename T>
     void setUniform(GLint location, GLsizei count, const T* v, GLenum targetUniformType);
@@ -208,6 +239,14 @@ class ProgramD3D : public ProgramImpl
     GLuint mUsedVertexSamplerRange;
     GLuint mUsedPixelSamplerRange;
     bool mDirtySamplerMapping;
+    unsigned int mSamplerMappingSerial;   // Changes whenever updateSamplerMapping remaps the samplers
+
+    // Result of the last sampler validation without an info log, as draw calls validate the
+    // samplers every time; valid until a sampler uniform changes
+    bool mSamplerValidationCached;
+    bool mCachedSamplersValid;
+
+    std::vector<unsigned int> mDirtyUniformIndices;
 
     int mShaderVersion;
 };
@@ -398,15 +398,15 @@ gl::Error TextureD3D::generateMipmaps()
 
     for (GLint layer = 0; layer < layerCount; ++layer)
     {
-        for (GLint mip = 1; mip < mipCount; ++mip)
+        if (renderableStorage)
         {
-            ASSERT(getLayerCount(mip) == layerCount);
+            for (GLint mip = 1; mip < mipCount; ++mip)
+            {
+                ASSERT(getLayerCount(mip) == layerCount);
 
-            gl::ImageIndex sourceIndex = getImageIndex(mip - 1, layer);
-            gl::ImageIndex destIndex = getImageIndex(mip, layer);
+                gl::ImageIndex sourceIndex = getImageIndex(mip - 1, layer);
+                gl::ImageIndex destIndex = getImageIndex(mip, layer);
 
-            if (renderableStorage)
-            {
                 // GPU-side mipmapping
                 gl::Error error = mTexStorage->generateMipmap(sourceIndex, destIndex);
                 if (error.isError())
@@ -414,14 +414,21 @@ gl::Error TextureD3D::generateMipmaps()
                     return error;
                 }
             }
-            else
+        }
+        else
+        {
+            // CPU-side mipmapping, the whole chain of the layer at once
+            std::vector<Image*> images(mipCount);
+            for (GLint mip = 0; mip < mipCount; ++mip)
             {
-                // CPU-side mipmapping
-                gl::Error error = mRenderer->generateMipmap(getImage(destIndex), getImage(sourceIndex));
-                if (error.isError())
-                {
-                    return error;
-                }
+                ASSERT(getLayerCount(mip) == layerCount);
+                images[mip] = getImage(getImageIndex(mip, layer));
+            }
+
+            gl::Error error = mRenderer->generateMipmapChain(images.data(), images.size());
+            if (error.isError())
+            {
+                return error;
             }
         }
     }
@@ -13,6 +13,8 @@
 #include "libGLESv2/renderer/d3d/d3d11/TextureStorage11.h"
 #include "libGLESv2/renderer/d3d/d3d11/formatutils11.h"
 #include "libGLESv2/renderer/d3d/d3d11/renderer11_utils.h"
+#include "libGLESv2/renderer/generatemip.h"
+#include "libGLESv2/renderer/parallelimage.h"
 #include "libGLESv2/Framebuffer.h"
 #include "libGLESv2/FramebufferAttachment.h"
 #include "libGLESv2/main.h"
@@ -74,9 +76,10 @@ gl::Error Image11::generateMipmap(Image11 *dest, Image11 *src)
     const uint8_t *sourceData = reinterpret_cast<const uint8_t*>(srcMapped.pData);
     uint8_t *destData = reinterpret_cast<uint8_t*>(destMapped.pData);
 
-    dxgiFormatInfo.mipGenerationFunction(src->getWidth(), src->getHeight(), src->getDepth(),
-                                         sourceData, srcMapped.RowPitch, srcMapped.DepthPitch,
-                                         destData, destMapped.RowPitch, destMapped.DepthPitch);
+    GenerateMipParallel(src->mRenderer->getWorkerPool(), dxgiFormatInfo.mipGenerationFunction,
+                        src->getWidth(), src->getHeight(), src->getDepth(),
+                        sourceData, srcMapped.RowPitch, srcMapped.DepthPitch,
+                        destData, destMapped.RowPitch, destMapped.DepthPitch);
 
     dest->unmap();
     src->unmap();
@@ -86,6 +89,72 @@ gl::Error Image11::generateMipmap(Image11 *dest, Image11 *src)
     return gl::Error(GL_NO_ERROR);
 }
 
+gl::Error Image11::generateMipmapChain(Image11 *const *images, size_t imageCount)
+{
+    ASSERT(imageCount > 1);
+
+    // 3D images are filtered one level at a time
+    Image11 *source = images[0];
+    if (source->getDepth() > 1)
+    {
+        for (size_t i = 1; i < imageCount; i++)
+        {
+            gl::Error error = generateMipmap(images[i], images[i - 1]);
+            if (error.isError())
+            {
+                return error;
+            }
+        }
+
+        return gl::Error(GL_NO_ERROR);
+    }
+
+    const d3d11::DXGIFormat &dxgiFormatInfo = d3d11::GetDXGIFormatInfo(source->getDXGIFormat());
+    ASSERT(dxgiFormatInfo.mipGenerationFunction != NULL);
+
+    D3D11_MAPPED_SUBRESOURCE sourceMapped;
+    gl::Error error = source->map(D3D11_MAP_READ, &sourceMapped);
+    if (error.isError())
+    {
+        return error;
+    }
+
+    // Each level is written and then read back as the source of the next one
+    std::vector<uint8_t*> levelData;
+    std::vector<size_t> levelRowPitches;
+    for (size_t i = 1; i < imageCount; i++)
+    {
+        ASSERT(images[i]->getDXGIFormat() == source->getDXGIFormat());
+
+        D3D11_MAPPED_SUBRESOURCE destMapped;
+        error = images[i]->map(D3D11_MAP_READ_WRITE, &destMapped);
+        if (error.isError())
+        {
+            break;
+        }
+
+        levelData.push_back(reinterpret_cast<uint8_t*>(destMapped.pData));
+        levelRowPitches.push_back(destMapped.RowPitch);
+    }
+
+    if (!error.isError())
+    {
+        GenerateMipChain(source->mRenderer->getWorkerPool(), dxgiFormatInfo.mipGenerationFunction,
+                         dxgiFormatInfo.pixelBytes, source->getWidth(), source->getHeight(),
+                         reinterpret_cast<const uint8_t*>(sourceMapped.pData), sourceMapped.RowPitch,
+                         levelData.size(), levelData.data(), levelRowPitches.data());
+    }
+
+    for (size_t i = 0; i < levelData.size(); i++)
+    {
+        images[i + 1]->unmap();
+        images[i + 1]->markDirty();
+    }
+    source->unmap();
+
+    return error;
+}
+
 bool Image11::isDirty() const
 {
     // If mDirty is true
@@ -274,9 +343,9 @@ gl::Error Image11::loadData(GLint xoffset, GLint yoffset, GLint zoffset, GLsizei
     }
 
     uint8_t* offsetMappedData = (reinterpret_cast<uint8_t*>(mappedImage.pData) + (yoffset * mappedImage.RowPitch + xoffset * outputPixelSize + zoffset * mappedImage.DepthPitch));
-    loadFunction(width, height, depth,
-                 reinterpret_cast<const uint8_t*>(input), inputRowPitch, inputDepthPitch,
-                 offsetMappedData, mappedImage.RowPitch, mappedImage.DepthPitch);
+    LoadImageParallel(mRenderer->getWorkerPool(), loadFunction, 1, width, height, depth,
+                      reinterpret_cast<const uint8_t*>(input), inputRowPitch, inputDepthPitch,
+                      offsetMappedData, mappedImage.RowPitch, mappedImage.DepthPitch);
 
     unmap();
 
@@ -312,9 +381,9 @@ gl::Error Image11::loadCompressedData(GLint xoffset, GLint yoffset, GLint zoffse
                                                                            (xoffset / outputBlockWidth) * outputPixelSize +
                                                                            zoffset * mappedImage.DepthPitch);
 
-    loadFunction(width, height, depth,
-                 reinterpret_cast<const uint8_t*>(input), inputRowPitch, inputDepthPitch,
-                 offsetMappedData, mappedImage.RowPitch, mappedImage.DepthPitch);
+    LoadImageParallel(mRenderer->getWorkerPool(), loadFunction, outputBlockHeight, width, height, depth,
+                      reinterpret_cast<const uint8_t*>(input), inputRowPitch, inputDepthPitch,
+                      offsetMappedData, mappedImage.RowPitch, mappedImage.DepthPitch);
 
     unmap();
 
@@ -35,6 +35,7 @@ class Image11 : public ImageD3D
     static Image11 *makeImage11(Image *img);
 
     static gl::Error generateMipmap(Image11 *dest, Image11 *src);
+    static gl::Error generateMipmapChain(Image11 *const *images, size_t imageCount);
 
     virtual bool isDirty() const;
 
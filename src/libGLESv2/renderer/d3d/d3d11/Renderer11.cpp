@@ -28,6 +28,7 @@
 #include "libGLESv2/renderer/d3d/d3d11/Buffer11.h"
 #include "libGLESv2/renderer/d3d/VertexDataManager.h"
 #include "libGLESv2/renderer/d3d/IndexDataManager.h"
+#include "libGLESv2/renderer/parallelimage.h"
 #include "libGLESv2/renderer/d3d/d3d11/TextureStorage11.h"
 #include "libGLESv2/renderer/d3d/d3d11/Query11.h"
 #include "libGLESv2/renderer/d3d/d3d11/Fence11.h"
@@ -813,6 +814,7 @@ void Renderer11::setScissorRectangle(const gl::Rectangle &scissor, bool enabled)
         if (enabled != mScissorEnabled)
         {
             mForceSetRasterState = true;
+            invalidateAppliedState();
         }
 
         mCurScissor = scissor;
@@ -1090,6 +1092,7 @@ gl::Error Renderer11::applyRenderTarget(gl::Framebuffer *framebuffer)
         {
             mForceSetRasterState = true;
         }
+        invalidateAppliedState();
 
         for (unsigned int rtIndex = 0; rtIndex < gl::IMPLEMENTATION_MAX_DRAW_BUFFERS; rtIndex++)
         {
@@ -1803,6 +1806,7 @@ void Renderer11::markAllStateDirty()
     mForceSetDepthStencilState = true;
     mForceSetScissor = true;
     mForceSetViewport = true;
+    invalidateAppliedState();
 
     mRenderToBackBufferActive = false;
 
@@ -2142,6 +2146,7 @@ void Renderer11::setRenderToBackBufferVariables(bool renderingToBackBuffer)
 
     // The rasterizer state must be updated, so that it will update its culling mode.
     mForceSetRasterState = true;
+    invalidateAppliedState();
 
     mVertexConstants.viewScale[0] = 1.0f;
     mVertexConstants.viewScale[1] = 1.0f;
@@ -2856,6 +2861,17 @@ gl::Error Renderer11::generateMipmap(Image *dest, Image *src)
     return Image11::generateMipmap(dest11, src11);
 }
 
+gl::Error Renderer11::generateMipmapChain(Image *const *images, size_t imageCount)
+{
+    std::vector<Image11*> images11(imageCount);
+    for (size_t i = 0; i < imageCount; i++)
+    {
+        images11[i] = Image11::makeImage11(images[i]);
+    }
+
+    return Image11::generateMipmapChain(images11.data(), imageCount);
+}
+
 TextureStorage *Renderer11::createTextureStorage2D(SwapChain *swapChain)
 {
     SwapChain11 *swapChain11 = SwapChain11::makeSwapChain11(swapChain);
@@ -3042,41 +3058,13 @@ gl::Error Renderer11::packPixels(ID3D11Texture2D *readTexture, const PackPixelsP
         const gl::FormatType &destFormatTypeInfo = gl::GetFormatTypeInfo(params.format, params.type);
         const gl::InternalFormat &destFormatInfo = gl::GetInternalFormatInfo(destFormatTypeInfo.internalFormat);
 
-        if (fastCopyFunc)
-        {
-            // Fast copy is possible through some special function
-            for (int y = 0; y < params.area.height; y++)
-            {
-                for (int x = 0; x < params.area.width; x++)
-                {
-                    uint8_t *dest = pixelsOut + params.offset + y * params.outputPitch + x * destFormatInfo.pixelBytes;
-                    const uint8_t *src = source + y * inputPitch + x * sourceFormatInfo.pixelBytes;
-
-                    fastCopyFunc(src, dest);
-                }
-            }
-        }
-        else
-        {
-            uint8_t temp[16]; // Maximum size of any Color<T> type used.
-            META_ASSERT(sizeof(temp) >= sizeof(gl::ColorF)  &&
-                        sizeof(temp) >= sizeof(gl::ColorUI) &&
-                        sizeof(temp) >= sizeof(gl::ColorI));
-
-            for (int y = 0; y < params.area.height; y++)
-            {
-                for (int x = 0; x < params.area.width; x++)
-                {
-                    uint8_t *dest = pixelsOut + params.offset + y * params.outputPitch + x * destFormatInfo.pixelBytes;
-                    const uint8_t *src = source + y * inputPitch + x * sourceFormatInfo.pixelBytes;
-
-                    // readFunc and writeFunc will be using the same type of color, CopyTexImage
-                    // will not allow the copy otherwise.
-                    sourceDXGIFormatInfo.colorReadFunction(src, temp);
-                    destFormatTypeInfo.colorWriteFunction(temp, dest);
-                }
-            }
-        }
+        // Uses the fast copy function when one exists, otherwise a read/write pair through
+        // a temporary color
+        CopyPixelsParallel(getWorkerPool(), fastCopyFunc,
+                           sourceDXGIFormatInfo.colorReadFunction, destFormatTypeInfo.colorWriteFunction,
+                           static_cast<size_t>(params.area.width), static_cast<size_t>(params.area.height),
+                           source, inputPitch, sourceFormatInfo.pixelBytes,
+                           pixelsOut + params.offset, params.outputPitch, destFormatInfo.pixelBytes);
     }
 
     mDeviceContext->Unmap(readTexture, 0);
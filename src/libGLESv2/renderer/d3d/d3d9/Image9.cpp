@@ -13,6 +13,7 @@
 #include "libGLESv2/renderer/d3d/d3d9/Renderer9.h"
 #include "libGLESv2/renderer/d3d/d3d9/RenderTarget9.h"
 #include "libGLESv2/renderer/d3d/d3d9/TextureStorage9.h"
+#include "libGLESv2/renderer/parallelimage.h"
 #include "libGLESv2/main.h"
 #include "libGLESv2/Framebuffer.h"
 #include "libGLESv2/FramebufferAttachment.h"
@@ -505,9 +506,9 @@ gl::Error Image9::loadData(GLint xoffset, GLint yoffset, GLint zoffset, GLsizei
         return error;
     }
 
-    d3dFormatInfo.loadFunction(width, height, depth,
-                               reinterpret_cast<const uint8_t*>(input), inputRowPitch, 0,
-                               reinterpret_cast<uint8_t*>(locked.pBits), locked.Pitch, 0);
+    LoadImageParallel(mRenderer->getWorkerPool(), d3dFormatInfo.loadFunction, 1, width, height, depth,
+                      reinterpret_cast<const uint8_t*>(input), inputRowPitch, 0,
+                      reinterpret_cast<uint8_t*>(locked.pBits), locked.Pitch, 0);
 
     unlock();
 
@@ -544,9 +545,10 @@ gl::Error Image9::loadCompressedData(GLint xoffset, GLint yoffset, GLint zoffset
         return error;
     }
 
-    d3d9FormatInfo.loadFunction(width, height, depth,
-                                reinterpret_cast<const uint8_t*>(input), inputRowPitch, inputDepthPitch,
-                                reinterpret_cast<uint8_t*>(locked.pBits), locked.Pitch, 0);
+    LoadImageParallel(mRenderer->getWorkerPool(), d3d9FormatInfo.loadFunction,
+                      d3d9::GetD3DFormatInfo(d3d9FormatInfo.texFormat).blockHeight, width, height, depth,
+                      reinterpret_cast<const uint8_t*>(input), inputRowPitch, inputDepthPitch,
+                      reinterpret_cast<uint8_t*>(locked.pBits), locked.Pitch, 0);
 
     unlock();
 
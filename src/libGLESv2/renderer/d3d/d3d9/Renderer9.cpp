@@ -26,6 +26,7 @@
 #include "libGLESv2/renderer/d3d/ShaderD3D.h"
 #include "libGLESv2/renderer/d3d/TextureD3D.h"
 #include "libGLESv2/renderer/d3d/TransformFeedbackD3D.h"
+#include "libGLESv2/renderer/parallelimage.h"
 #include "libGLESv2/main.h"
 #include "libGLESv2/Buffer.h"
 #include "libGLESv2/Texture.h"
@@ -1271,12 +1272,14 @@ gl::Error Renderer9::applyRenderTarget(gl::Framebuffer *framebuffer)
         {
             mCurDepthSize = depthSize;
             mForceSetRasterState = true;
+            invalidateAppliedState();
         }
 
         if (!mDepthStencilInitialized || stencilSize != mCurStencilSize)
         {
             mCurStencilSize = stencilSize;
             mForceSetDepthStencilState = true;
+            invalidateAppliedState();
         }
 
         mAppliedDepthbufferSerial = depthbufferSerial;
@@ -1289,6 +1292,7 @@ gl::Error Renderer9::applyRenderTarget(gl::Framebuffer *framebuffer)
         mForceSetScissor = true;
         mForceSetViewport = true;
         mForceSetBlendState = true;
+        invalidateAppliedState();
 
         mRenderTargetDesc.width = attachment->getWidth();
         mRenderTargetDesc.height = attachment->getHeight();
@@ -1762,14 +1766,28 @@ gl::Error Renderer9::applyShaders(gl::ProgramBinary *programBinary, const gl::Ve
 
 gl::Error Renderer9::applyUniforms(const ProgramImpl &program, const std::vector<gl::LinkedUniform*> &uniformArray)
 {
-    for (size_t uniformIndex = 0; uniformIndex < uniformArray.size(); uniformIndex++)
+    const ProgramD3D *programD3D = ProgramD3D::makeProgramD3D(&program);
+    const std::vector<unsigned int> &dirtyUniformIndices = programD3D->getDirtyUniformIndices();
+
+    // Only the registers written since the last apply are uploaded, one span at a time
+    for (size_t dirtyIndex = 0; dirtyIndex < dirtyUniformIndices.size(); dirtyIndex++)
     {
-        gl::LinkedUniform *targetUniform = uniformArray[uniformIndex];
+        gl::LinkedUniform *targetUniform = uniformArray[dirtyUniformIndices[dirtyIndex]];
+        ASSERT(targetUniform->dirty);
 
-        if (targetUniform->dirty)
+        for (size_t spanIndex = 0; spanIndex < targetUniform->dirtyRows.size(); spanIndex++)
         {
-            GLfloat *f = (GLfloat*)targetUniform->data;
-            GLint *i = (GLint*)targetUniform->data;
+            const RangeUI &span = targetUniform->dirtyRows[spanIndex];
+            if (span.start >= targetUniform->registerCount)
+            {
+                break;
+            }
+
+            const unsigned int firstRegister = span.start;
+            const unsigned int registerCount = std::min(span.end, targetUniform->registerCount) - firstRegister;
+
+            GLfloat *f = (GLfloat*)targetUniform->data + firstRegister * 4;
+            GLint *i = (GLint*)targetUniform->data + firstRegister * 4;
 
             switch (targetUniform->type)
             {
@@ -1780,7 +1798,7 @@ gl::Error Renderer9::applyUniforms(const ProgramImpl &program, const std::vector
               case GL_BOOL_VEC2:
               case GL_BOOL_VEC3:
               case GL_BOOL_VEC4:
-                applyUniformnbv(targetUniform, i);
+                applyUniformnbv(targetUniform, firstRegister, registerCount, i);
                 break;
               case GL_FLOAT:
               case GL_FLOAT_VEC2:
@@ -1789,13 +1807,13 @@ gl::Error Renderer9::applyUniforms(const ProgramImpl &program, const std::vector
               case GL_FLOAT_MAT2:
               case GL_FLOAT_MAT3:
               case GL_FLOAT_MAT4:
-                applyUniformnfv(targetUniform, f);
+                applyUniformnfv(targetUniform, firstRegister, registerCount, f);
                 break;
               case GL_INT:
               case GL_INT_VEC2:
               case GL_INT_VEC3:
               case GL_INT_VEC4:
-                applyUniformniv(targetUniform, i);
+                applyUniformniv(targetUniform, firstRegister, registerCount, i);
                 break;
               default:
                 UNREACHABLE();
@@ -1814,25 +1832,27 @@ gl::Error Renderer9::applyUniforms(const ProgramImpl &program, const std::vector
     return gl::Error(GL_NO_ERROR);
 }
 
-void Renderer9::applyUniformnfv(gl::LinkedUniform *targetUniform, const GLfloat *v)
+void Renderer9::applyUniformnfv(gl::LinkedUniform *targetUniform, unsigned int firstRegister, unsigned int registerCount,
+                                const GLfloat *v)
 {
     if (targetUniform->isReferencedByFragmentShader())
     {
-        mDevice->SetPixelShaderConstantF(targetUniform->psRegisterIndex, v, targetUniform->registerCount);
+        mDevice->SetPixelShaderConstantF(targetUniform->psRegisterIndex + firstRegister, v, registerCount);
     }
 
     if (targetUniform->isReferencedByVertexShader())
     {
-        mDevice->SetVertexShaderConstantF(targetUniform->vsRegisterIndex, v, targetUniform->registerCount);
+        mDevice->SetVertexShaderConstantF(targetUniform->vsRegisterIndex + firstRegister, v, registerCount);
     }
 }
 
-void Renderer9::applyUniformniv(gl::LinkedUniform *targetUniform, const GLint *v)
+void Renderer9::applyUniformniv(gl::LinkedUniform *targetUniform, unsigned int firstRegister, unsigned int registerCount,
+                                const GLint *v)
 {
-    ASSERT(targetUniform->registerCount <= MAX_VERTEX_CONSTANT_VECTORS_D3D9);
+    ASSERT(registerCount <= MAX_VERTEX_CONSTANT_VECTORS_D3D9);
     GLfloat vector[MAX_VERTEX_CONSTANT_VECTORS_D3D9][4];
 
-    for (unsigned int i = 0; i < targetUniform->registerCount; i++)
+    for (unsigned int i = 0; i < registerCount; i++)
     {
         vector[i][0] = (GLfloat)v[4 * i + 0];
         vector[i][1] = (GLfloat)v[4 * i + 1];
@@ -1840,15 +1860,16 @@ void Renderer9::applyUniformniv(gl::LinkedUniform *targetUniform, const GLint *v
         vector[i][3] = (GLfloat)v[4 * i + 3];
     }
 
-    applyUniformnfv(targetUniform, (GLfloat*)vector);
+    applyUniformnfv(targetUniform, firstRegister, registerCount, (GLfloat*)vector);
 }
 
-void Renderer9::applyUniformnbv(gl::LinkedUniform *targetUniform, const GLint *v)
+void Renderer9::applyUniformnbv(gl::LinkedUniform *targetUniform, unsigned int firstRegister, unsigned int registerCount,
+                                const GLint *v)
 {
-    ASSERT(targetUniform->registerCount <= MAX_VERTEX_CONSTANT_VECTORS_D3D9);
+    ASSERT(registerCount <= MAX_VERTEX_CONSTANT_VECTORS_D3D9);
     GLfloat vector[MAX_VERTEX_CONSTANT_VECTORS_D3D9][4];
 
-    for (unsigned int i = 0; i < targetUniform->registerCount; i++)
+    for (unsigned int i = 0; i < registerCount; i++)
     {
         vector[i][0] = (v[4 * i + 0] == GL_FALSE) ? 0.0f : 1.0f;
         vector[i][1] = (v[4 * i + 1] == GL_FALSE) ? 0.0f : 1.0f;
@@ -1856,7 +1877,7 @@ void Renderer9::applyUniformnbv(gl::LinkedUniform *targetUniform, const GLint *v
         vector[i][3] = (v[4 * i + 3] == GL_FALSE) ? 0.0f : 1.0f;
     }
 
-    applyUniformnfv(targetUniform, (GLfloat*)vector);
+    applyUniformnfv(targetUniform, firstRegister, registerCount, (GLfloat*)vector);
 }
 
 gl::Error Renderer9::clear(const gl::ClearParameters &clearParams, gl::Framebuffer *frameBuffer)
@@ -2089,6 +2110,7 @@ void Renderer9::markAllStateDirty()
     mForceSetScissor = true;
     mForceSetViewport = true;
     mForceSetBlendState = true;
+    invalidateAppliedState();
 
     ASSERT(mForceSetVertexSamplerStates.size() == mCurVertexTextureSerials.size());
     for (unsigned int i = 0; i < mForceSetVertexSamplerStates.size(); i++)
@@ -2775,37 +2797,13 @@ gl::Error Renderer9::readPixels(gl::Framebuffer *framebuffer, GLint x, GLint y,
         const gl::FormatType &destFormatTypeInfo = gl::GetFormatTypeInfo(format, type);
         const gl::InternalFormat &destFormatInfo = gl::GetInternalFormatInfo(destFormatTypeInfo.internalFormat);
 
-        if (fastCopyFunc)
-        {
-            // Fast copy is possible through some special function
-            for (int y = 0; y < rect.bottom - rect.top; y++)
-            {
-                for (int x = 0; x < rect.right - rect.left; x++)
-                {
-                    uint8_t *dest = pixels + y * outputPitch + x * destFormatInfo.pixelBytes;
-                    const uint8_t *src = source + y * inputPitch + x * sourceFormatInfo.pixelBytes;
-
-                    fastCopyFunc(src, dest);
-                }
-            }
-        }
-        else
-        {
-            uint8_t temp[sizeof(gl::ColorF)];
-            for (int y = 0; y < rect.bottom - rect.top; y++)
-            {
-                for (int x = 0; x < rect.right - rect.left; x++)
-                {
-                    uint8_t *dest = pixels + y * outputPitch + x * destFormatInfo.pixelBytes;
-                    const uint8_t *src = source + y * inputPitch + x * sourceFormatInfo.pixelBytes;
-
-                    // readFunc and writeFunc will be using the same type of color, CopyTexImage
-                    // will not allow the copy otherwise.
-                    sourceD3DFormatInfo.colorReadFunction(src, temp);
-                    destFormatTypeInfo.colorWriteFunction(temp, dest);
-                }
-            }
-        }
+        // Uses the fast copy function when one exists, otherwise a read/write pair through
+        // a temporary color
+        CopyPixelsParallel(getWorkerPool(), fastCopyFunc,
+                           sourceD3DFormatInfo.colorReadFunction, destFormatTypeInfo.colorWriteFunction,
+                           static_cast<size_t>(rect.right - rect.left), static_cast<size_t>(rect.bottom - rect.top),
+                           source, inputPitch, sourceFormatInfo.pixelBytes,
+                           pixels, outputPitch, destFormatInfo.pixelBytes);
     }
 
     systemSurface->UnlockRect();
@@ -3053,6 +3051,21 @@ gl::Error Renderer9::generateMipmap(Image *dest, Image *src)
     return Image9::generateMipmap(dst9, src9);
 }
 
+gl::Error Renderer9::generateMipmapChain(Image *const *images, size_t imageCount)
+{
+    // D3D9 surfaces are filtered one level at a time
+    for (size_t i = 1; i < imageCount; i++)
+    {
+        gl::Error error = generateMipmap(images[i], images[i - 1]);
+        if (error.isError())
+        {
+            return error;
+        }
+    }
+
+    return gl::Error(GL_NO_ERROR);
+}
+
 TextureStorage *Renderer9::createTextureStorage2D(SwapChain *swapChain)
 {
     SwapChain9 *swapChain9 = SwapChain9::makeSwapChain9(swapChain);
@@ -168,6 +168,7 @@ class Renderer9 : public Renderer
     // Image operations
     virtual Image *createImage();
     virtual gl::Error generateMipmap(Image *dest, Image *source);
+    virtual gl::Error generateMipmapChain(Image *const *images, size_t imageCount);
     virtual TextureStorage *createTextureStorage2D(SwapChain *swapChain);
     virtual TextureStorage *createTextureStorage2D(GLenum internalformat, bool renderTarget, GLsizei width, GLsizei height, int levels, bool hintLevelZeroOnly = false);
     virtual TextureStorage *createTextureStorageCube(GLenum internalformat, bool renderTarget, int size, int levels);
@@ -217,9 +218,12 @@ class Renderer9 : public Renderer
 
     void release();
 
-    void applyUniformnfv(gl::LinkedUniform *targetUniform, const GLfloat *v);
-    void applyUniformniv(gl::LinkedUniform *targetUniform, const GLint *v);
-    void applyUniformnbv(gl::LinkedUniform *targetUniform, const GLint *v);
+    void applyUniformnfv(gl::LinkedUniform *targetUniform, unsigned int firstRegister, unsigned int registerCount,
+                         const GLfloat *v);
+    void applyUniformniv(gl::LinkedUniform *targetUniform, unsigned int firstRegister, unsigned int registerCount,
+                         const GLint *v);
+    void applyUniformnbv(gl::LinkedUniform *targetUniform, unsigned int firstRegister, unsigned int registerCount,
+                         const GLint *v);
 
     gl::Error drawLineLoop(GLsizei count, GLenum type, const GLvoid *indices, int minIndex, gl::Buffer *elementArrayBuffer);
     gl::Error drawIndexedPoints(GLsizei count, GLenum type, const GLvoid *indices, int minIndex, gl::Buffer *elementArrayBuffer);
@@ -164,23 +164,6 @@ static InternalFormatInitialzerMap BuildInternalFormatInitialzerMap()
 // in templates that perform format support queries on a Renderer9 object which is supplied
 // when requesting the function or format.
 
-typedef bool(*FallbackPredicateFunction)();
-
-template <FallbackPredicateFunction pred, LoadImageFunction prefered, LoadImageFunction fallback>
-static void FallbackLoad(size_t width, size_t height, size_t depth,
-                         const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
-                         uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
-{
-    if (pred())
-    {
-        prefered(width, height, depth, input, inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
-    }
-    else
-    {
-        fallback(width, height, depth, input, inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
-    }
-}
-
 static void UnreachableLoad(size_t width, size_t height, size_t depth,
                             const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
                             uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
@@ -217,6 +200,20 @@ static inline void InsertD3D9FormatInfo(D3D9FormatMap *map, GLenum internalForma
 
 static D3D9FormatMap BuildD3D9FormatMap()
 {
+    // Pick the fastest variant of each vectorized load the CPU supports, once for all formats using it
+    const LoadImageFunction loadA8ToBGRA8 = SelectLoadFunction(gl::supportsAVX2(), LoadA8ToBGRA8_AVX2,
+                                                               SelectLoadFunction(gl::supportsSSE2(), LoadA8ToBGRA8_SSE2, LoadA8ToBGRA8));
+    const LoadImageFunction loadRGB8ToBGRX8 = SelectLoadFunction(gl::supportsAVX2(), LoadRGB8ToBGRX8_AVX2,
+                                                                 SelectLoadFunction(gl::supportsSSSE3(), LoadRGB8ToBGRX8_SSSE3, LoadRGB8ToBGRX8));
+    const LoadImageFunction loadRGBA8ToBGRA8 = SelectLoadFunction(gl::supportsAVX2(), LoadRGBA8ToBGRA8_AVX2,
+                                                                  SelectLoadFunction(gl::supportsSSE2(), LoadRGBA8ToBGRA8_SSE2, LoadRGBA8ToBGRA8));
+    const LoadImageFunction loadR5G6B5ToBGRA8 = SelectLoadFunction(gl::supportsSSE2(), LoadR5G6B5ToBGRA8_SSE2, LoadR5G6B5ToBGRA8);
+    const LoadImageFunction loadRGBA4ToBGRA8 = SelectLoadFunction(gl::supportsSSE2(), LoadRGBA4ToBGRA8_SSE2, LoadRGBA4ToBGRA8);
+    const LoadImageFunction loadRGB5A1ToBGRA8 = SelectLoadFunction(gl::supportsSSE2(), LoadRGB5A1ToBGRA8_SSE2, LoadRGB5A1ToBGRA8);
+    const LoadImageFunction loadA16FToRGBA16F = SelectLoadFunction(gl::supportsSSE2(), LoadA16FToRGBA16F_SSE2, LoadA16FToRGBA16F);
+    const LoadImageFunction loadL16FToRGBA16F = SelectLoadFunction(gl::supportsSSE2(), LoadL16FToRGBA16F_SSE2, LoadL16FToRGBA16F);
+    const LoadImageFunction loadLA16FToRGBA16F = SelectLoadFunction(gl::supportsSSE2(), LoadLA16FToRGBA16F_SSE2, LoadLA16FToRGBA16F);
+
     D3D9FormatMap map;
 
     //                       | Internal format                     | Texture format      | Render format        | Load function                           |
@@ -248,17 +245,17 @@ static D3D9FormatMap BuildD3D9FormatMap()
     InsertD3D9FormatInfo(&map, GL_RGB16F_EXT,                       D3DFMT_A16B16G16R16F, D3DFMT_A16B16G16R16F,  LoadToNative3To4<GLhalf, gl::Float16One> );
     InsertD3D9FormatInfo(&map, GL_RG16F_EXT,                        D3DFMT_G16R16F,       D3DFMT_G16R16F,        LoadToNative<GLhalf, 2>                  );
     InsertD3D9FormatInfo(&map, GL_R16F_EXT,                         D3DFMT_R16F,          D3DFMT_R16F,           LoadToNative<GLhalf, 1>                  );
-    InsertD3D9FormatInfo(&map, GL_ALPHA16F_EXT,                     D3DFMT_A16B16G16R16F, D3DFMT_UNKNOWN,        LoadA16FToRGBA16F                        );
-    InsertD3D9FormatInfo(&map, GL_LUMINANCE16F_EXT,                 D3DFMT_A16B16G16R16F, D3DFMT_UNKNOWN,        LoadL16FToRGBA16F                        );
-    InsertD3D9FormatInfo(&map, GL_LUMINANCE_ALPHA16F_EXT,           D3DFMT_A16B16G16R16F, D3DFMT_UNKNOWN,        LoadLA16FToRGBA16F                       );
+    InsertD3D9FormatInfo(&map, GL_ALPHA16F_EXT,                     D3DFMT_A16B16G16R16F, D3DFMT_UNKNOWN,        loadA16FToRGBA16F                        );
+    InsertD3D9FormatInfo(&map, GL_LUMINANCE16F_EXT,                 D3DFMT_A16B16G16R16F, D3DFMT_UNKNOWN,        loadL16FToRGBA16F                        );
+    InsertD3D9FormatInfo(&map, GL_LUMINANCE_ALPHA16F_EXT,           D3DFMT_A16B16G16R16F, D3DFMT_UNKNOWN,        loadLA16FToRGBA16F                       );
 
-    InsertD3D9FormatInfo(&map, GL_ALPHA8_EXT,                       D3DFMT_A8R8G8B8,      D3DFMT_A8R8G8B8,       FallbackLoad<gl::supportsSSE2, LoadA8ToBGRA8_SSE2, LoadA8ToBGRA8>);
+    InsertD3D9FormatInfo(&map, GL_ALPHA8_EXT,                       D3DFMT_A8R8G8B8,      D3DFMT_A8R8G8B8,       loadA8ToBGRA8                            );
 
-    InsertD3D9FormatInfo(&map, GL_RGB8_OES,                         D3DFMT_X8R8G8B8,      D3DFMT_X8R8G8B8,       LoadRGB8ToBGRX8                           );
-    InsertD3D9FormatInfo(&map, GL_RGB565,                           D3DFMT_X8R8G8B8,      D3DFMT_X8R8G8B8,       LoadR5G6B5ToBGRA8                         );
-    InsertD3D9FormatInfo(&map, GL_RGBA8_OES,                        D3DFMT_A8R8G8B8,      D3DFMT_A8R8G8B8,       FallbackLoad<gl::supportsSSE2, LoadRGBA8ToBGRA8_SSE2, LoadRGBA8ToBGRA8>);
-    InsertD3D9FormatInfo(&map, GL_RGBA4,                            D3DFMT_A8R8G8B8,      D3DFMT_A8R8G8B8,       LoadRGBA4ToBGRA8                          );
-    InsertD3D9FormatInfo(&map, GL_RGB5_A1,                          D3DFMT_A8R8G8B8,      D3DFMT_A8R8G8B8,       LoadRGB5A1ToBGRA8                         );
+    InsertD3D9FormatInfo(&map, GL_RGB8_OES,                         D3DFMT_X8R8G8B8,      D3DFMT_X8R8G8B8,       loadRGB8ToBGRX8                          );
+    InsertD3D9FormatInfo(&map, GL_RGB565,                           D3DFMT_X8R8G8B8,      D3DFMT_X8R8G8B8,       loadR5G6B5ToBGRA8                        );
+    InsertD3D9FormatInfo(&map, GL_RGBA8_OES,                        D3DFMT_A8R8G8B8,      D3DFMT_A8R8G8B8,       loadRGBA8ToBGRA8                         );
+    InsertD3D9FormatInfo(&map, GL_RGBA4,                            D3DFMT_A8R8G8B8,      D3DFMT_A8R8G8B8,       loadRGBA4ToBGRA8                         );
+    InsertD3D9FormatInfo(&map, GL_RGB5_A1,                          D3DFMT_A8R8G8B8,      D3DFMT_A8R8G8B8,       loadRGB5A1ToBGRA8                        );
     InsertD3D9FormatInfo(&map, GL_R8_EXT,                           D3DFMT_X8R8G8B8,      D3DFMT_X8R8G8B8,       LoadR8ToBGRX8                             );
     InsertD3D9FormatInfo(&map, GL_RG8_EXT,                          D3DFMT_X8R8G8B8,      D3DFMT_X8R8G8B8,       LoadRG8ToBGRX8                            );
 
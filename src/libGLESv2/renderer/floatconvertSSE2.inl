@@ -0,0 +1,168 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// floatconvertSSE2.inl: Defines SSE2 counterparts of the gl:: half float and small float
+// conversions, shared by the vectorized mip generation and image loading functions. Everything
+// here has internal linkage, so each file keeps the copy built with its own instruction set flags.
+
+#include <emmintrin.h>
+
+namespace rx
+{
+
+namespace
+{
+
+// Picks the bits of ifTrue in the lanes where mask is set, those of ifFalse elsewhere
+inline __m128i Select(__m128i mask, __m128i ifTrue, __m128i ifFalse)
+{
+    return _mm_or_si128(_mm_and_si128(mask, ifTrue), _mm_andnot_si128(mask, ifFalse));
+}
+
+// Converts the half floats in the low 16 bits of each lane, bit-exact with gl::float16ToFloat32.
+inline __m128 HalfToFloat(__m128i half)
+{
+    __m128i sign = _mm_slli_epi32(_mm_and_si128(half, _mm_set1_epi32(0x8000)), 16);
+    __m128i magnitude = _mm_and_si128(half, _mm_set1_epi32(0x7FFF));
+
+    // Normalized values only need the exponent rebiased; INF and NAN get the maximum exponent
+    __m128i normal = _mm_add_epi32(_mm_slli_epi32(magnitude, 13), _mm_set1_epi32(0x38000000));
+    __m128i infinity = _mm_cmpgt_epi32(magnitude, _mm_set1_epi32(0x7BFF));
+    normal = _mm_add_epi32(normal, _mm_and_si128(infinity, _mm_set1_epi32(0x38000000)));
+
+    // Denormalized values are the mantissa scaled by 2^-24, which the conversion gives exactly
+    __m128i denormalMask = _mm_cmplt_epi32(magnitude, _mm_set1_epi32(0x0400));
+    __m128 denormal = _mm_mul_ps(_mm_cvtepi32_ps(magnitude), _mm_set1_ps(1.0f / 16777216.0f));
+
+    __m128i bits = Select(denormalMask, _mm_castps_si128(denormal), normal);
+    return _mm_castsi128_ps(_mm_or_si128(bits, sign));
+}
+
+// For values below the smallest normalized half, float11 or float10, the scalar conversions
+// compute ((1 << 23) | mantissa) >> (113 - exponent), which is |value| * 2^37 truncated.
+inline __m128i DenormalizedBits(__m128i magnitude)
+{
+    return _mm_cvttps_epi32(_mm_mul_ps(_mm_castsi128_ps(magnitude), _mm_set1_ps(137438953472.0f)));
+}
+
+// Converts to half floats in the low 16 bits of each lane, bit-exact with gl::float32ToFloat16.
+inline __m128i FloatToHalf(__m128 value)
+{
+    __m128i bits = _mm_castps_si128(value);
+    __m128i sign = _mm_srli_epi32(_mm_and_si128(bits, _mm_set1_epi32(0x80000000)), 16);
+    __m128i magnitude = _mm_and_si128(bits, _mm_set1_epi32(0x7FFFFFFF));
+
+    __m128i denormalMask = _mm_cmplt_epi32(magnitude, _mm_set1_epi32(0x38800000));
+    __m128i rebiased = _mm_add_epi32(magnitude, _mm_set1_epi32(0xC8000000));
+    __m128i shifted = Select(denormalMask, DenormalizedBits(magnitude), rebiased);
+
+    __m128i roundBit = _mm_and_si128(_mm_srli_epi32(shifted, 13), _mm_set1_epi32(1));
+    __m128i rounded = _mm_add_epi32(_mm_add_epi32(shifted, _mm_set1_epi32(0x0FFF)), roundBit);
+    __m128i half = _mm_srli_epi32(rounded, 13);
+
+    __m128i infinity = _mm_cmpgt_epi32(magnitude, _mm_set1_epi32(0x47FFEFFF));
+    half = Select(infinity, _mm_set1_epi32(0x7FFF), half);
+
+    return _mm_or_si128(half, sign);
+}
+
+// Packs the low 16 bits of each lane of two vectors into one vector
+inline __m128i PackLow16(__m128i low, __m128i high)
+{
+    low = _mm_srai_epi32(_mm_slli_epi32(low, 16), 16);
+    high = _mm_srai_epi32(_mm_slli_epi32(high, 16), 16);
+    return _mm_packs_epi32(low, high);
+}
+
+// Describes the unsigned small float layouts used by R11G11B10F
+template <unsigned int MantissaBits>
+struct SmallFloatTraits;
+
+template <>
+struct SmallFloatTraits<6>
+{
+    static const unsigned int Max = 0x7BF;
+    static const unsigned int Float32Max = 0x477E0000;
+    static __m128i nanMantissa(__m128i value)
+    {
+        return _mm_or_si128(_mm_or_si128(_mm_srli_epi32(value, 17), _mm_srli_epi32(value, 11)),
+                            _mm_or_si128(_mm_srli_epi32(value, 6), value));
+    }
+};
+
+template <>
+struct SmallFloatTraits<5>
+{
+    static const unsigned int Max = 0x3DF;
+    static const unsigned int Float32Max = 0x477C0000;
+    static __m128i nanMantissa(__m128i value)
+    {
+        return _mm_or_si128(_mm_or_si128(_mm_srli_epi32(value, 18), _mm_srli_epi32(value, 13)),
+                            _mm_or_si128(_mm_srli_epi32(value, 3), value));
+    }
+};
+
+// Bit-exact with gl::float11ToFloat32 and gl::float10ToFloat32. Both place the mantissa of
+// INF and NAN at bit 17.
+template <unsigned int MantissaBits>
+inline __m128 SmallFloatToFloat(__m128i small)
+{
+    const int mantissaShift = 23 - MantissaBits;
+
+    __m128i mantissa = _mm_and_si128(small, _mm_set1_epi32((1 << MantissaBits) - 1));
+    __m128i exponent = _mm_and_si128(_mm_srli_epi32(small, MantissaBits), _mm_set1_epi32(0x1F));
+
+    __m128i normal = _mm_or_si128(_mm_slli_epi32(_mm_add_epi32(exponent, _mm_set1_epi32(112)), 23),
+                                  _mm_slli_epi32(mantissa, mantissaShift));
+    __m128i infinity = _mm_or_si128(_mm_set1_epi32(0x7F800000), _mm_slli_epi32(mantissa, 17));
+    __m128 denormal = _mm_mul_ps(_mm_cvtepi32_ps(mantissa), _mm_set1_ps(1.0f / static_cast<float>(1 << (14 + MantissaBits))));
+
+    __m128i bits = Select(_mm_cmpeq_epi32(exponent, _mm_set1_epi32(0x1F)), infinity, normal);
+    bits = Select(_mm_cmpeq_epi32(exponent, _mm_setzero_si128()), _mm_castps_si128(denormal), bits);
+    return _mm_castsi128_ps(bits);
+}
+
+// Bit-exact with gl::float32ToFloat11 and gl::float32ToFloat10 for magnitudes of at least 2^-45,
+// which covers every half float and every average of float11 or float10 values. Below that the
+// scalar conversions shift by 32 bits or more.
+template <unsigned int MantissaBits>
+inline __m128i FloatToSmallFloat(__m128 value)
+{
+    typedef SmallFloatTraits<MantissaBits> Traits;
+    const int mantissaShift = 23 - MantissaBits;
+    const int exponentMask = 0x1F << MantissaBits;
+
+    __m128i bits = _mm_castps_si128(value);
+    __m128i negative = _mm_srai_epi32(bits, 31);
+    __m128i magnitude = _mm_and_si128(bits, _mm_set1_epi32(0x7FFFFFFF));
+
+    __m128i denormalMask = _mm_cmplt_epi32(magnitude, _mm_set1_epi32(0x38800000));
+    __m128i rebiased = _mm_add_epi32(magnitude, _mm_set1_epi32(0xC8000000));
+    __m128i shifted = Select(denormalMask, DenormalizedBits(magnitude), rebiased);
+
+    __m128i roundBit = _mm_and_si128(_mm_srli_epi32(shifted, mantissaShift), _mm_set1_epi32(1));
+    __m128i rounded = _mm_add_epi32(_mm_add_epi32(shifted, _mm_set1_epi32((1 << (mantissaShift - 1)) - 1)), roundBit);
+    __m128i small = _mm_srli_epi32(rounded, mantissaShift);
+    small = _mm_and_si128(small, _mm_set1_epi32((1 << (MantissaBits + 5)) - 1));
+
+    __m128i tooLarge = _mm_cmpgt_epi32(magnitude, _mm_set1_epi32(Traits::Float32Max));
+    small = Select(tooLarge, _mm_set1_epi32(Traits::Max), small);
+
+    // Negative values and -INF clamp to zero since the format is positive only
+    small = _mm_andnot_si128(negative, small);
+
+    __m128i infinity = _mm_cmpeq_epi32(magnitude, _mm_set1_epi32(0x7F800000));
+    small = Select(infinity, _mm_andnot_si128(negative, _mm_set1_epi32(exponentMask)), small);
+
+    __m128i nan = _mm_cmpgt_epi32(magnitude, _mm_set1_epi32(0x7F800000));
+    __m128i nanBits = _mm_or_si128(_mm_set1_epi32(exponentMask),
+                                   _mm_and_si128(Traits::nanMantissa(magnitude), _mm_set1_epi32((1 << MantissaBits) - 1)));
+    return Select(nan, nanBits, small);
+}
+
+}
+
+}
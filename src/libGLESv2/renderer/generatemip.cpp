@@ -0,0 +1,150 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// generatemip.cpp: Implements the GenerateMipChain function.
+
+#include "libGLESv2/renderer/generatemip.h"
+#include "libGLESv2/renderer/parallelimage.h"
+
+#include "common/WorkerPool.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace rx
+{
+
+namespace
+{
+
+// The base level is processed in tiles of MipChainTileWidth x 2^MipChainTileLevels texels, and
+// that many levels are generated per tile before moving on, so the smaller levels are built
+// from data that is still in cache. Tiles are wide so that the filters run on rows that are
+// long enough for the vectorized kernels.
+const size_t MipChainTileLevels = 6;
+const size_t MipChainTileHeight = 1 << MipChainTileLevels;
+const size_t MipChainTileWidth = 256;
+
+struct MipChainTask
+{
+    MipGenerationFunction mipFunction;
+    size_t pixelBytes;
+    size_t tileColumns;
+    size_t tileLevels;
+
+    // Level 0 is the base level
+    std::vector<size_t> widths;
+    std::vector<size_t> heights;
+    std::vector<const uint8_t*> sourceData;
+    std::vector<uint8_t*> destData;
+    std::vector<size_t> rowPitches;
+};
+
+void GenerateMipTile(const MipChainTask &task, size_t tileX, size_t tileY)
+{
+    size_t baseX = tileX * MipChainTileWidth;
+    size_t baseY = tileY * MipChainTileHeight;
+
+    for (size_t level = 1; level <= task.tileLevels; level++)
+    {
+        // The part of this level that depends only on the current tile of the base level
+        size_t x0 = baseX >> level;
+        size_t y0 = baseY >> level;
+        size_t x1 = std::min(task.widths[level], (baseX + MipChainTileWidth) >> level);
+        size_t y1 = std::min(task.heights[level], (baseY + MipChainTileHeight) >> level);
+
+        if (x0 >= x1 || y0 >= y1)
+        {
+            continue;
+        }
+
+        // Dimensions that are already 1 are not filtered, and keep a source size of 1 so that
+        // the same filter variant as a whole-level call is picked
+        size_t sourceWidth = (task.widths[level - 1] > 1) ? (x1 - x0) * 2 : 1;
+        size_t sourceHeight = (task.heights[level - 1] > 1) ? (y1 - y0) * 2 : 1;
+
+        const uint8_t *source = task.sourceData[level - 1] + (x0 * 2) * task.pixelBytes +
+                                (y0 * 2) * task.rowPitches[level - 1];
+        uint8_t *dest = task.destData[level] + x0 * task.pixelBytes + y0 * task.rowPitches[level];
+
+        task.mipFunction(sourceWidth, sourceHeight, 1, source, task.rowPitches[level - 1], 0,
+                         dest, task.rowPitches[level], 0);
+    }
+}
+
+void GenerateMipTileRows(size_t begin, size_t end, void *userData)
+{
+    const MipChainTask *task = static_cast<const MipChainTask*>(userData);
+
+    for (size_t tileY = begin; tileY < end; tileY++)
+    {
+        for (size_t tileX = 0; tileX < task->tileColumns; tileX++)
+        {
+            GenerateMipTile(*task, tileX, tileY);
+        }
+    }
+}
+
+}
+
+void GenerateMipChain(gl::WorkerPool *pool, MipGenerationFunction mipFunction, size_t pixelBytes,
+                      size_t baseWidth, size_t baseHeight, const uint8_t *baseData, size_t baseRowPitch,
+                      size_t levelCount, uint8_t *const *levelData, const size_t *levelRowPitches)
+{
+    if (levelCount == 0)
+    {
+        return;
+    }
+
+    MipChainTask task;
+    task.mipFunction = mipFunction;
+    task.pixelBytes = pixelBytes;
+    task.tileColumns = (baseWidth + MipChainTileWidth - 1) / MipChainTileWidth;
+    task.tileLevels = std::min(levelCount, MipChainTileLevels);
+
+    task.widths.push_back(baseWidth);
+    task.heights.push_back(baseHeight);
+    task.sourceData.push_back(baseData);
+    task.destData.push_back(NULL);
+    task.rowPitches.push_back(baseRowPitch);
+
+    size_t tiledBytes = 0;
+    for (size_t level = 1; level <= levelCount; level++)
+    {
+        ASSERT(task.widths.back() > 1 || task.heights.back() > 1);
+
+        task.widths.push_back(std::max<size_t>(1, task.widths.back() >> 1));
+        task.heights.push_back(std::max<size_t>(1, task.heights.back() >> 1));
+        task.sourceData.push_back(levelData[level - 1]);
+        task.destData.push_back(levelData[level - 1]);
+        task.rowPitches.push_back(levelRowPitches[level - 1]);
+
+        if (level <= task.tileLevels)
+        {
+            tiledBytes += task.rowPitches.back() * task.heights.back();
+        }
+    }
+
+    size_t tileRows = (baseHeight + MipChainTileHeight - 1) / MipChainTileHeight;
+    if (ShouldRunParallel(pool, tiledBytes))
+    {
+        pool->parallelFor(tileRows, 1, GenerateMipTileRows, &task);
+    }
+    else
+    {
+        GenerateMipTileRows(0, tileRows, &task);
+    }
+
+    // The remaining levels are at most 1/64th of the base in each dimension
+    for (size_t level = task.tileLevels + 1; level <= levelCount; level++)
+    {
+        mipFunction(task.widths[level - 1], task.heights[level - 1], 1,
+                    task.sourceData[level - 1], task.rowPitches[level - 1], 0,
+                    task.destData[level], task.rowPitches[level], 0);
+    }
+}
+
+}
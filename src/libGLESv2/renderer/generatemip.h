@@ -5,13 +5,20 @@
 //
 
 // generatemip.h: Defines the GenerateMip function, templated on the format
-// type of the image for which mip levels are being generated.
+// type of the image for which mip levels are being generated, and the
+// GenerateMipChain function that produces a whole mip chain at once.
 
 #ifndef LIBGLESV2_RENDERER_GENERATEMIP_H_
 #define LIBGLESV2_RENDERER_GENERATEMIP_H_
 
-#include "libGLESv2/renderer/imageformats.h"
 #include "libGLESv2/angletypes.h"
+#include "libGLESv2/formatutils.h"
+#include "libGLESv2/renderer/imageformats.h"
+
+namespace gl
+{
+class WorkerPool;
+}
 
 namespace rx
 {
@@ -21,6 +28,14 @@ inline void GenerateMip(size_t sourceWidth, size_t sourceHeight, size_t sourceDe
                         const uint8_t *sourceData, size_t sourceRowPitch, size_t sourceDepthPitch,
                         uint8_t *destData, size_t destRowPitch, size_t destDepthPitch);
 
+// Generates levels 1 through levelCount of a 2D image from its base level in a single pass
+// over tiles of the base, so each level is computed while its source tile is still in cache.
+// Tiles are spread over pool when it is not NULL. levelData[i] and levelRowPitches[i] describe
+// level i + 1. The results are identical to calling mipFunction once per level.
+void GenerateMipChain(gl::WorkerPool *pool, MipGenerationFunction mipFunction, size_t pixelBytes,
+                      size_t baseWidth, size_t baseHeight, const uint8_t *baseData, size_t baseRowPitch,
+                      size_t levelCount, uint8_t *const *levelData, const size_t *levelRowPitches);
+
 }
 
 #include "generatemip.inl"
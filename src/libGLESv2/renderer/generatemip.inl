@@ -222,6 +222,57 @@ typedef void (*MipGenerationFunction)(size_t sourceWidth, size_t sourceHeight, s
                                       size_t destWidth, size_t destHeight, size_t destDepth,
                                       uint8_t *destData, size_t destRowPitch, size_t destDepthPitch);
 
+// Vectorized kernels, defined in generatemipSSE2.cpp for the formats below
+template <typename T>
+void GenerateMip_X_SSE2(size_t sourceWidth, size_t sourceHeight, size_t sourceDepth,
+                        const uint8_t *sourceData, size_t sourceRowPitch, size_t sourceDepthPitch,
+                        size_t destWidth, size_t destHeight, size_t destDepth,
+                        uint8_t *destData, size_t destRowPitch, size_t destDepthPitch);
+
+template <typename T>
+void GenerateMip_XY_SSE2(size_t sourceWidth, size_t sourceHeight, size_t sourceDepth,
+                         const uint8_t *sourceData, size_t sourceRowPitch, size_t sourceDepthPitch,
+                         size_t destWidth, size_t destHeight, size_t destDepth,
+                         uint8_t *destData, size_t destRowPitch, size_t destDepthPitch);
+
+template <typename T>
+struct HasSSE2MipFunctions { static const bool value = false; };
+
+template <> struct HasSSE2MipFunctions<A8R8G8B8> { static const bool value = true; };
+template <> struct HasSSE2MipFunctions<R8G8B8A8> { static const bool value = true; };
+template <> struct HasSSE2MipFunctions<B8G8R8A8> { static const bool value = true; };
+template <> struct HasSSE2MipFunctions<B8G8R8X8> { static const bool value = true; };
+template <> struct HasSSE2MipFunctions<R16G16B16A16F> { static const bool value = true; };
+template <> struct HasSSE2MipFunctions<R11G11B10F> { static const bool value = true; };
+
+// Only references the vectorized kernels for formats that instantiate them
+template <typename T, bool HasSSE2 = HasSSE2MipFunctions<T>::value>
+struct SSE2MipFunctions
+{
+    static MipGenerationFunction Get(uint8_t index)
+    {
+        return NULL;
+    }
+};
+
+template <typename T>
+struct SSE2MipFunctions<T, true>
+{
+    static MipGenerationFunction Get(uint8_t index)
+    {
+        if (gl::supportsSSE2())
+        {
+            switch (index)
+            {
+              case 1: return GenerateMip_X_SSE2<T>;
+              case 3: return GenerateMip_XY_SSE2<T>;
+            }
+        }
+
+        return NULL;
+    }
+};
+
 template <typename T>
 static MipGenerationFunction GetMipGenerationFunction(size_t sourceWidth, size_t sourceHeight, size_t sourceDepth)
 {
@@ -229,6 +280,12 @@ static MipGenerationFunction GetMipGenerationFunction(size_t sourceWidth, size_t
                     ((sourceHeight > 1) ? 2 : 0) |
                     ((sourceDepth > 1)  ? 4 : 0);
 
+    MipGenerationFunction vectorizedFunction = SSE2MipFunctions<T>::Get(index);
+    if (vectorizedFunction != NULL)
+    {
+        return vectorizedFunction;
+    }
+
     switch (index)
     {
       case 0: return NULL;
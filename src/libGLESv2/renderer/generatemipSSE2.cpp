@@ -0,0 +1,243 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// generatemipSSE2.cpp: Defines the vectorized mip generation functions. It's
+// in a separated file for GCC, which can enable SSE usage only per-file,
+// not for code blocks that use SSE2 explicitly.
+
+#include "libGLESv2/renderer/generatemip.h"
+
+#if !defined(_M_ARM)
+#include "libGLESv2/renderer/floatconvertSSE2.inl"
+#endif
+
+namespace rx
+{
+
+namespace priv
+{
+
+#if !defined(_M_ARM)
+
+namespace
+{
+
+// Per-byte average rounded down, matching gl::average and the 0xFEFEFEFE trick
+// used by the 4-byte formats. _mm_avg_epu8 rounds up, so subtract the carried bit.
+inline __m128i FloorAverage(__m128i a, __m128i b)
+{
+    __m128i roundingBits = _mm_and_si128(_mm_xor_si128(a, b), _mm_set1_epi8(1));
+    return _mm_sub_epi8(_mm_avg_epu8(a, b), roundingBits);
+}
+
+inline __m128 Average(__m128 a, __m128 b)
+{
+    return _mm_mul_ps(_mm_add_ps(a, b), _mm_set1_ps(0.5f));
+}
+
+// Vector counterparts of the T::average functions, each averaging a full vector of texels.
+template <typename T>
+struct TexelAverage;
+
+struct ByteTexelAverage
+{
+    static __m128i average(__m128i a, __m128i b)
+    {
+        return FloorAverage(a, b);
+    }
+};
+
+template <> struct TexelAverage<A8R8G8B8> : ByteTexelAverage { };
+template <> struct TexelAverage<R8G8B8A8> : ByteTexelAverage { };
+template <> struct TexelAverage<B8G8R8A8> : ByteTexelAverage { };
+
+template <>
+struct TexelAverage<B8G8R8X8>
+{
+    static __m128i average(__m128i a, __m128i b)
+    {
+        return _mm_or_si128(FloorAverage(a, b), _mm_set1_epi32(0xFF000000));
+    }
+};
+
+template <>
+struct TexelAverage<R16G16B16A16F>
+{
+    static __m128i average(__m128i a, __m128i b)
+    {
+        __m128i zero = _mm_setzero_si128();
+        __m128 low = Average(HalfToFloat(_mm_unpacklo_epi16(a, zero)), HalfToFloat(_mm_unpacklo_epi16(b, zero)));
+        __m128 high = Average(HalfToFloat(_mm_unpackhi_epi16(a, zero)), HalfToFloat(_mm_unpackhi_epi16(b, zero)));
+        return PackLow16(FloatToHalf(low), FloatToHalf(high));
+    }
+};
+
+template <>
+struct TexelAverage<R11G11B10F>
+{
+    static __m128i average(__m128i a, __m128i b)
+    {
+        const __m128i float11Mask = _mm_set1_epi32(0x7FF);
+
+        __m128 red = Average(SmallFloatToFloat<6>(_mm_and_si128(a, float11Mask)),
+                             SmallFloatToFloat<6>(_mm_and_si128(b, float11Mask)));
+        __m128 green = Average(SmallFloatToFloat<6>(_mm_and_si128(_mm_srli_epi32(a, 11), float11Mask)),
+                               SmallFloatToFloat<6>(_mm_and_si128(_mm_srli_epi32(b, 11), float11Mask)));
+        __m128 blue = Average(SmallFloatToFloat<5>(_mm_srli_epi32(a, 22)),
+                              SmallFloatToFloat<5>(_mm_srli_epi32(b, 22)));
+
+        return _mm_or_si128(_mm_or_si128(FloatToSmallFloat<6>(red),
+                                         _mm_slli_epi32(FloatToSmallFloat<6>(green), 11)),
+                            _mm_slli_epi32(FloatToSmallFloat<5>(blue), 22));
+    }
+};
+
+// Splits two vectors of consecutive texels into their even and odd texels
+template <size_t TexelSize>
+struct TexelPairs;
+
+template <>
+struct TexelPairs<4>
+{
+    static __m128i even(__m128i first, __m128i second)
+    {
+        return _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(first), _mm_castsi128_ps(second), _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+
+    static __m128i odd(__m128i first, __m128i second)
+    {
+        return _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(first), _mm_castsi128_ps(second), _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+};
+
+template <>
+struct TexelPairs<8>
+{
+    static __m128i even(__m128i first, __m128i second)
+    {
+        return _mm_unpacklo_epi64(first, second);
+    }
+
+    static __m128i odd(__m128i first, __m128i second)
+    {
+        return _mm_unpackhi_epi64(first, second);
+    }
+};
+
+template <typename T>
+inline __m128i AverageTexelPairs(__m128i first, __m128i second)
+{
+    return TexelAverage<T>::average(TexelPairs<sizeof(T)>::even(first, second),
+                                    TexelPairs<sizeof(T)>::odd(first, second));
+}
+
+inline __m128i Load(const void *source)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+}
+
+}
+
+#endif
+
+template <typename T>
+void GenerateMip_X_SSE2(size_t sourceWidth, size_t sourceHeight, size_t sourceDepth,
+                        const uint8_t *sourceData, size_t sourceRowPitch, size_t sourceDepthPitch,
+                        size_t destWidth, size_t destHeight, size_t destDepth,
+                        uint8_t *destData, size_t destRowPitch, size_t destDepthPitch)
+{
+#if defined(_M_ARM)
+    // Ensure that this function is reported as not implemented for ARM builds because
+    // the instructions below are not present for that architecture.
+    UNIMPLEMENTED();
+    return;
+#else
+    ASSERT(sourceWidth > 1);
+    ASSERT(sourceHeight == 1);
+    ASSERT(sourceDepth == 1);
+
+    const size_t texelsPerVector = 16 / sizeof(T);
+    const T *source = reinterpret_cast<const T*>(sourceData);
+    T *dest = reinterpret_cast<T*>(destData);
+
+    size_t x = 0;
+    for (; x + texelsPerVector <= destWidth; x += texelsPerVector)
+    {
+        __m128i first = Load(source + x * 2);
+        __m128i second = Load(source + x * 2 + texelsPerVector);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + x), AverageTexelPairs<T>(first, second));
+    }
+
+    for (; x < destWidth; x++)
+    {
+        T::average(dest + x, source + x * 2, source + x * 2 + 1);
+    }
+#endif
+}
+
+template <typename T>
+void GenerateMip_XY_SSE2(size_t sourceWidth, size_t sourceHeight, size_t sourceDepth,
+                         const uint8_t *sourceData, size_t sourceRowPitch, size_t sourceDepthPitch,
+                         size_t destWidth, size_t destHeight, size_t destDepth,
+                         uint8_t *destData, size_t destRowPitch, size_t destDepthPitch)
+{
+#if defined(_M_ARM)
+    // Ensure that this function is reported as not implemented for ARM builds because
+    // the instructions below are not present for that architecture.
+    UNIMPLEMENTED();
+    return;
+#else
+    ASSERT(sourceWidth > 1);
+    ASSERT(sourceHeight > 1);
+    ASSERT(sourceDepth == 1);
+
+    const size_t texelsPerVector = 16 / sizeof(T);
+
+    for (size_t y = 0; y < destHeight; y++)
+    {
+        const T *source0 = reinterpret_cast<const T*>(sourceData + (y * 2) * sourceRowPitch);
+        const T *source1 = reinterpret_cast<const T*>(sourceData + (y * 2 + 1) * sourceRowPitch);
+        T *dest = reinterpret_cast<T*>(destData + y * destRowPitch);
+
+        // Like the scalar path, average vertically first and then horizontally
+        size_t x = 0;
+        for (; x + texelsPerVector <= destWidth; x += texelsPerVector)
+        {
+            __m128i first = TexelAverage<T>::average(Load(source0 + x * 2), Load(source1 + x * 2));
+            __m128i second = TexelAverage<T>::average(Load(source0 + x * 2 + texelsPerVector),
+                                                      Load(source1 + x * 2 + texelsPerVector));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + x), AverageTexelPairs<T>(first, second));
+        }
+
+        for (; x < destWidth; x++)
+        {
+            T left, right;
+            T::average(&left, source0 + x * 2, source1 + x * 2);
+            T::average(&right, source0 + x * 2 + 1, source1 + x * 2 + 1);
+            T::average(dest + x, &left, &right);
+        }
+    }
+#endif
+}
+
+#define INSTANTIATE_SSE2_MIP_FUNCTIONS(format) \
+    template void GenerateMip_X_SSE2<format>(size_t, size_t, size_t, const uint8_t *, size_t, size_t, \
+                                             size_t, size_t, size_t, uint8_t *, size_t, size_t); \
+    template void GenerateMip_XY_SSE2<format>(size_t, size_t, size_t, const uint8_t *, size_t, size_t, \
+                                              size_t, size_t, size_t, uint8_t *, size_t, size_t)
+
+INSTANTIATE_SSE2_MIP_FUNCTIONS(A8R8G8B8);
+INSTANTIATE_SSE2_MIP_FUNCTIONS(R8G8B8A8);
+INSTANTIATE_SSE2_MIP_FUNCTIONS(B8G8R8A8);
+INSTANTIATE_SSE2_MIP_FUNCTIONS(B8G8R8X8);
+INSTANTIATE_SSE2_MIP_FUNCTIONS(R16G16B16A16F);
+INSTANTIATE_SSE2_MIP_FUNCTIONS(R11G11B10F);
+
+#undef INSTANTIATE_SSE2_MIP_FUNCTIONS
+
+}
+
+}
@@ -242,6 +242,14 @@ void LoadRGB8ToBGRX8(size_t width, size_t height, size_t depth,
     }
 }
 
+void LoadRGB8ToRGBA8(size_t width, size_t height, size_t depth,
+                     const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                     uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+    LoadToNative3To4<GLubyte, 0xFF>(width, height, depth, input, inputRowPitch, inputDepthPitch,
+                                    output, outputRowPitch, outputDepthPitch);
+}
+
 void LoadRG8ToBGRX8(size_t width, size_t height, size_t depth,
                     const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
                     uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
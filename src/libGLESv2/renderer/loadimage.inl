@@ -21,6 +21,11 @@ inline const T *OffsetDataPointer(const uint8_t *data, size_t y, size_t z, size_
     return reinterpret_cast<const T*>(data + (y * rowPitch) + (z * depthPitch));
 }
 
+inline LoadImageFunction SelectLoadFunction(bool preferedSupported, LoadImageFunction prefered, LoadImageFunction fallback)
+{
+    return preferedSupported ? prefered : fallback;
+}
+
 template <typename type, size_t componentCount>
 inline void LoadToNative(size_t width, size_t height, size_t depth,
                          const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
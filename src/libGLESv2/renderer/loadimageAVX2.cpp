@@ -0,0 +1,212 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// loadimageAVX2.cpp: Defines the 8-bit image loading functions that use 256-bit byte shuffles.
+// It's in a separated file for GCC, which can enable AVX2 usage only per-file,
+// not for code blocks that use AVX2 explicitly. Nothing here may instantiate the inline
+// templates of loadimage.h: the linker could keep this -mavx2 copy for every caller.
+
+#include "libGLESv2/renderer/loadimage.h"
+
+#if !defined(_M_ARM)
+#include <immintrin.h>
+#endif
+
+namespace rx
+{
+
+#if !defined(_M_ARM)
+
+namespace
+{
+
+inline __m256i BothLanes(__m128i value)
+{
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(value), value, 1);
+}
+
+// Reads eight pixels of sourceBytes bytes each, without reading past the last of them
+template <size_t sourceBytes>
+inline __m256i LoadPixels(const uint8_t *source);
+
+template <>
+inline __m256i LoadPixels<1>(const uint8_t *source)
+{
+    return _mm256_castsi128_si256(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(source)));
+}
+
+template <>
+inline __m256i LoadPixels<2>(const uint8_t *source)
+{
+    return _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source)));
+}
+
+template <>
+inline __m256i LoadPixels<3>(const uint8_t *source)
+{
+    __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+    __m128i last = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(source + 16));
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(first), last, 1);
+}
+
+template <>
+inline __m256i LoadPixels<4>(const uint8_t *source)
+{
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source));
+}
+
+// Loads 8-bit pixels of sourceBytes bytes to 4-byte pixels, eight at a time. The permutation moves
+// the 32-bit words holding the first four pixels to the low lane and those holding the last four
+// to the high lane. The shuffle mask then selects the source byte for each destination byte within
+// a lane; entries with the high bit set produce zero, which the fill then sets.
+template <size_t sourceBytes, LoadImageFunction scalarLoad>
+void LoadBytesTo4Component(const __m256i &permutation, const __m128i &shuffleMask, uint32_t fill,
+                           size_t width, size_t height, size_t depth,
+                           const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                           uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+    __m256i laneShuffleMask = BothLanes(shuffleMask);
+    __m256i fillBits = _mm256_set1_epi32(static_cast<int>(fill));
+
+    for (size_t z = 0; z < depth; z++)
+    {
+        for (size_t y = 0; y < height; y++)
+        {
+            const uint8_t *source = input + y * inputRowPitch + z * inputDepthPitch;
+            uint8_t *dest = output + y * outputRowPitch + z * outputDepthPitch;
+
+            size_t x = 0;
+
+            for (; x + 7 < width; x += 8)
+            {
+                __m256i sourceData = _mm256_permutevar8x32_epi32(LoadPixels<sourceBytes>(&source[sourceBytes * x]), permutation);
+                __m256i result = _mm256_or_si256(_mm256_shuffle_epi8(sourceData, laneShuffleMask), fillBits);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(&dest[4 * x]), result);
+            }
+
+            // Perform leftover writes
+            if (x < width)
+            {
+                scalarLoad(width - x, 1, 1, &source[sourceBytes * x], inputRowPitch, inputDepthPitch,
+                           &dest[4 * x], outputRowPitch, outputDepthPitch);
+            }
+        }
+    }
+}
+
+}
+
+#endif
+
+void LoadA8ToBGRA8_AVX2(size_t width, size_t height, size_t depth,
+                        const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                        uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+#if defined(_M_ARM)
+    // Ensure that this function is reported as not implemented for ARM builds because
+    // the instructions below are not present for that architecture.
+    UNIMPLEMENTED();
+    return;
+#else
+    const __m256i permutation = _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1);
+    const __m128i shuffleMask = _mm_setr_epi8(-1, -1, -1, 0, -1, -1, -1, 1, -1, -1, -1, 2, -1, -1, -1, 3);
+    LoadBytesTo4Component<1, LoadA8ToBGRA8>(permutation, shuffleMask, 0, width, height, depth,
+                                            input, inputRowPitch, inputDepthPitch,
+                                            output, outputRowPitch, outputDepthPitch);
+#endif
+}
+
+void LoadL8ToRGBA8_AVX2(size_t width, size_t height, size_t depth,
+                        const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                        uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+#if defined(_M_ARM)
+    // Ensure that this function is reported as not implemented for ARM builds because
+    // the instructions below are not present for that architecture.
+    UNIMPLEMENTED();
+    return;
+#else
+    const __m256i permutation = _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1);
+    const __m128i shuffleMask = _mm_setr_epi8(0, 0, 0, -1, 1, 1, 1, -1, 2, 2, 2, -1, 3, 3, 3, -1);
+    LoadBytesTo4Component<1, LoadL8ToRGBA8>(permutation, shuffleMask, 0xFF000000, width, height, depth,
+                                            input, inputRowPitch, inputDepthPitch,
+                                            output, outputRowPitch, outputDepthPitch);
+#endif
+}
+
+void LoadLA8ToRGBA8_AVX2(size_t width, size_t height, size_t depth,
+                         const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                         uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+#if defined(_M_ARM)
+    // Ensure that this function is reported as not implemented for ARM builds because
+    // the instructions below are not present for that architecture.
+    UNIMPLEMENTED();
+    return;
+#else
+    const __m256i permutation = _mm256_setr_epi32(0, 1, 0, 1, 2, 3, 2, 3);
+    const __m128i shuffleMask = _mm_setr_epi8(0, 0, 0, 1, 2, 2, 2, 3, 4, 4, 4, 5, 6, 6, 6, 7);
+    LoadBytesTo4Component<2, LoadLA8ToRGBA8>(permutation, shuffleMask, 0, width, height, depth,
+                                             input, inputRowPitch, inputDepthPitch,
+                                             output, outputRowPitch, outputDepthPitch);
+#endif
+}
+
+void LoadRGB8ToBGRX8_AVX2(size_t width, size_t height, size_t depth,
+                          const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                          uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+#if defined(_M_ARM)
+    // Ensure that this function is reported as not implemented for ARM builds because
+    // the instructions below are not present for that architecture.
+    UNIMPLEMENTED();
+    return;
+#else
+    const __m256i permutation = _mm256_setr_epi32(0, 1, 2, 2, 3, 4, 5, 5);
+    const __m128i shuffleMask = _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+    LoadBytesTo4Component<3, LoadRGB8ToBGRX8>(permutation, shuffleMask, 0xFF000000, width, height, depth,
+                                              input, inputRowPitch, inputDepthPitch,
+                                              output, outputRowPitch, outputDepthPitch);
+#endif
+}
+
+void LoadRGB8ToRGBA8_AVX2(size_t width, size_t height, size_t depth,
+                          const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                          uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+#if defined(_M_ARM)
+    // Ensure that this function is reported as not implemented for ARM builds because
+    // the instructions below are not present for that architecture.
+    UNIMPLEMENTED();
+    return;
+#else
+    const __m256i permutation = _mm256_setr_epi32(0, 1, 2, 2, 3, 4, 5, 5);
+    const __m128i shuffleMask = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    LoadBytesTo4Component<3, LoadRGB8ToRGBA8>(permutation, shuffleMask, 0xFF000000, width, height, depth,
+                                              input, inputRowPitch, inputDepthPitch,
+                                              output, outputRowPitch, outputDepthPitch);
+#endif
+}
+
+void LoadRGBA8ToBGRA8_AVX2(size_t width, size_t height, size_t depth,
+                           const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                           uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+#if defined(_M_ARM)
+    // Ensure that this function is reported as not implemented for ARM builds because
+    // the instructions below are not present for that architecture.
+    UNIMPLEMENTED();
+    return;
+#else
+    const __m256i permutation = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m128i shuffleMask = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    LoadBytesTo4Component<4, LoadRGBA8ToBGRA8>(permutation, shuffleMask, 0, width, height, depth,
+                                               input, inputRowPitch, inputDepthPitch,
+                                               output, outputRowPitch, outputDepthPitch);
+#endif
+}
+
+}
@@ -10,9 +10,309 @@
 
 #include "libGLESv2/renderer/loadimage.h"
 
+#if !defined(_M_ARM)
+#include "libGLESv2/renderer/floatconvertSSE2.inl"
+#endif
+
 namespace rx
 {
 
+#if !defined(_M_ARM)
+
+namespace
+{
+
+// Expands the bits of each 16-bit lane selected by mask to an 8-bit value in the low byte of the
+// lane, as ((value & mask) >> highShift) | ((value & mask) >> lowShift) does in the scalar loads.
+template <int highShift, int lowShift>
+inline __m128i ExpandBitsRight(__m128i value, __m128i mask)
+{
+    __m128i bits = _mm_and_si128(value, mask);
+    return _mm_or_si128(_mm_srli_epi16(bits, highShift), _mm_srli_epi16(bits, lowShift));
+}
+
+template <int highShift, int lowShift>
+inline __m128i ExpandBitsLeft(__m128i value, __m128i mask)
+{
+    __m128i bits = _mm_and_si128(value, mask);
+    return _mm_or_si128(_mm_slli_epi16(bits, highShift), _mm_srli_epi16(bits, lowShift));
+}
+
+// Interleaves four vectors of 8-bit channel values held in 16-bit lanes into eight
+// 4-byte pixels.
+inline void StorePixels(__m128i c0, __m128i c1, __m128i c2, __m128i c3, uint8_t *dest)
+{
+    __m128i c01 = _mm_or_si128(c0, _mm_slli_epi16(c1, 8));
+    __m128i c23 = _mm_or_si128(c2, _mm_slli_epi16(c3, 8));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), _mm_unpacklo_epi16(c01, c23));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + 16), _mm_unpackhi_epi16(c01, c23));
+}
+
+struct R5G6B5Channels
+{
+    static void Expand(__m128i rgb, __m128i *r, __m128i *g, __m128i *b, __m128i *a)
+    {
+        *r = ExpandBitsRight<8, 13>(rgb, _mm_set1_epi16(static_cast<short>(0xF800)));
+        *g = ExpandBitsRight<3, 9>(rgb, _mm_set1_epi16(0x07E0));
+        *b = ExpandBitsLeft<3, 2>(rgb, _mm_set1_epi16(0x001F));
+        *a = _mm_set1_epi16(0xFF);
+    }
+};
+
+struct RGBA4Channels
+{
+    static void Expand(__m128i rgba, __m128i *r, __m128i *g, __m128i *b, __m128i *a)
+    {
+        *r = ExpandBitsRight<8, 12>(rgba, _mm_set1_epi16(static_cast<short>(0xF000)));
+        *g = ExpandBitsRight<4, 8>(rgba, _mm_set1_epi16(0x0F00));
+        *b = ExpandBitsRight<0, 4>(rgba, _mm_set1_epi16(0x00F0));
+        *a = ExpandBitsLeft<4, 0>(rgba, _mm_set1_epi16(0x000F));
+    }
+};
+
+struct RGB5A1Channels
+{
+    static void Expand(__m128i rgba, __m128i *r, __m128i *g, __m128i *b, __m128i *a)
+    {
+        const __m128i alphaBit = _mm_set1_epi16(0x0001);
+
+        *r = ExpandBitsRight<8, 13>(rgba, _mm_set1_epi16(static_cast<short>(0xF800)));
+        *g = ExpandBitsRight<3, 8>(rgba, _mm_set1_epi16(0x07C0));
+        *b = ExpandBitsLeft<2, 3>(rgba, _mm_set1_epi16(0x003E));
+        *a = _mm_and_si128(_mm_cmpeq_epi16(_mm_and_si128(rgba, alphaBit), alphaBit), _mm_set1_epi16(0xFF));
+    }
+};
+
+// Loads 16-bit packed pixels to 8-bit RGBA or BGRA, eight pixels at a time. The columns left over
+// at the end of each row go through the scalar load function, which keeps the results identical.
+template <typename Channels, bool bgra, LoadImageFunction scalarLoad>
+void LoadPacked16ToRGBA8(size_t width, size_t height, size_t depth,
+                         const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                         uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+    for (size_t z = 0; z < depth; z++)
+    {
+        for (size_t y = 0; y < height; y++)
+        {
+            const uint16_t *source = OffsetDataPointer<uint16_t>(input, y, z, inputRowPitch, inputDepthPitch);
+            uint8_t *dest = OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
+
+            size_t x = 0;
+
+            for (; x + 7 < width; x += 8)
+            {
+                __m128i sourceData = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[x]));
+
+                __m128i r, g, b, a;
+                Channels::Expand(sourceData, &r, &g, &b, &a);
+
+                if (bgra)
+                {
+                    StorePixels(b, g, r, a, &dest[4 * x]);
+                }
+                else
+                {
+                    StorePixels(r, g, b, a, &dest[4 * x]);
+                }
+            }
+
+            // Perform leftover writes
+            if (x < width)
+            {
+                scalarLoad(width - x, 1, 1, reinterpret_cast<const uint8_t*>(&source[x]), inputRowPitch, inputDepthPitch,
+                           &dest[4 * x], outputRowPitch, outputDepthPitch);
+            }
+        }
+    }
+}
+
+// Splits four packed 3-component pixels, held in three vectors of 32-bit lanes, into one vector
+// per component. The lanes are only moved, so NAN payloads survive.
+inline void SplitComponents(__m128i first, __m128i second, __m128i third, __m128i *x, __m128i *y, __m128i *z)
+{
+    __m128 a = _mm_castsi128_ps(first);
+    __m128 b = _mm_castsi128_ps(second);
+    __m128 c = _mm_castsi128_ps(third);
+
+    __m128 xTail = _mm_shuffle_ps(b, c, _MM_SHUFFLE(0, 1, 0, 2));
+    *x = _mm_castps_si128(_mm_shuffle_ps(a, xTail, _MM_SHUFFLE(2, 0, 3, 0)));
+
+    __m128 yHead = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+    __m128 yTail = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+    *y = _mm_castps_si128(_mm_shuffle_ps(yHead, yTail, _MM_SHUFFLE(2, 0, 2, 0)));
+
+    __m128 zHead = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+    __m128 zTail = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0));
+    *z = _mm_castps_si128(_mm_shuffle_ps(zHead, zTail, _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+// Reads four RGB half float pixels, one component per vector, each half in the low 16 bits of a lane
+inline void LoadRGB16FComponents(const uint16_t *source, __m128i *r, __m128i *g, __m128i *b)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+    __m128i last = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(source + 8));
+    SplitComponents(_mm_unpacklo_epi16(first, zero), _mm_unpackhi_epi16(first, zero), _mm_unpacklo_epi16(last, zero), r, g, b);
+}
+
+// Reads four RGB float pixels, one component per vector
+inline void LoadRGB32FComponents(const float *source, __m128 *r, __m128 *g, __m128 *b)
+{
+    __m128i red, green, blue;
+    SplitComponents(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source)),
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 4)),
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 8)),
+                    &red, &green, &blue);
+    *r = _mm_castsi128_ps(red);
+    *g = _mm_castsi128_ps(green);
+    *b = _mm_castsi128_ps(blue);
+}
+
+// gl::convertRGBFloatsTo999E5 clamps the components to 65408 and takes the natural logarithm of
+// the largest, so it derives exponents from -16 to 11. These are the thresholds of the exponents
+// above -16, looked up once.
+struct SharedExponentThresholds
+{
+    static const int Count = 27;
+
+    SharedExponentThresholds()
+    {
+        for (int i = 0; i < Count; i++)
+        {
+            values[i] = gl::sharedExponentThreshold999E5(i - 15);
+        }
+    }
+
+    float values[Count];
+};
+
+const SharedExponentThresholds &GetSharedExponentThresholds()
+{
+    static const SharedExponentThresholds thresholds;
+    return thresholds;
+}
+
+// Rounds to the nearest integer, halves up, without the rounding error of adding 0.5 in single
+// precision: the scalar conversion adds it to the double the C++ pow overloads return.
+inline __m128i RoundHalfUp(__m128 value)
+{
+    __m128i truncated = _mm_cvttps_epi32(value);
+    __m128 fraction = _mm_sub_ps(value, _mm_cvtepi32_ps(truncated));
+    __m128i roundUp = _mm_castps_si128(_mm_cmpge_ps(fraction, _mm_set1_ps(0.5f)));
+    return _mm_sub_epi32(truncated, roundUp);
+}
+
+// Returns 2^(24 - exponent) for the biased exponents of RGB9E5, which scales a component to the
+// 9-bit mantissa of that exponent.
+inline __m128 MantissaScale(__m128i exponent)
+{
+    return _mm_castsi128_ps(_mm_slli_epi32(_mm_sub_epi32(_mm_set1_epi32(127 + 24), exponent), 23));
+}
+
+// Converts four pixels to RGB9E5, bit-exact with gl::convertRGBFloatsTo999E5. The exponent of
+// each pixel is the number of thresholds its largest component reaches.
+inline __m128i ConvertToRGB9E5(__m128 red, __m128 green, __m128 blue, const __m128 *thresholds)
+{
+    // Same operand order as the std::min and std::max calls, so NAN clamps to the maximum and
+    // -0 to +0
+    const __m128 maxValue = _mm_set1_ps(65408.0f);
+    const __m128 zero = _mm_setzero_ps();
+    red = _mm_max_ps(_mm_min_ps(red, maxValue), zero);
+    green = _mm_max_ps(_mm_min_ps(green, maxValue), zero);
+    blue = _mm_max_ps(_mm_min_ps(blue, maxValue), zero);
+    __m128 maxComponent = _mm_max_ps(_mm_max_ps(red, green), blue);
+
+    __m128i exponent = _mm_setzero_si128();
+    for (int i = 0; i < SharedExponentThresholds::Count; i++)
+    {
+        exponent = _mm_sub_epi32(exponent, _mm_castps_si128(_mm_cmpge_ps(maxComponent, thresholds[i])));
+    }
+
+    // The largest component must fit in 9 bits after rounding, else the exponent goes up by one.
+    // The scalar conversion rounds it in single precision.
+    __m128 maxMantissa = _mm_add_ps(_mm_mul_ps(maxComponent, MantissaScale(exponent)), _mm_set1_ps(0.5f));
+    __m128i overflow = _mm_cmpgt_epi32(_mm_cvttps_epi32(maxMantissa), _mm_set1_epi32(511));
+    exponent = _mm_sub_epi32(exponent, overflow);
+
+    __m128 scale = MantissaScale(exponent);
+    __m128i mantissaMask = _mm_set1_epi32(0x1FF);
+    __m128i r = _mm_and_si128(RoundHalfUp(_mm_mul_ps(red, scale)), mantissaMask);
+    __m128i g = _mm_and_si128(RoundHalfUp(_mm_mul_ps(green, scale)), mantissaMask);
+    __m128i b = _mm_and_si128(RoundHalfUp(_mm_mul_ps(blue, scale)), mantissaMask);
+    __m128i e = _mm_and_si128(exponent, _mm_set1_epi32(0x1F));
+
+    return _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 9)),
+                        _mm_or_si128(_mm_slli_epi32(b, 18), _mm_slli_epi32(e, 27)));
+}
+
+// Loads RGB half float or float pixels to RGB9E5, four pixels at a time
+template <typename Source>
+struct RGB9E5Loader;
+
+template <>
+struct RGB9E5Loader<uint16_t>
+{
+    static __m128i Load(const uint16_t *source, const __m128 *thresholds)
+    {
+        __m128i r, g, b;
+        LoadRGB16FComponents(source, &r, &g, &b);
+        return ConvertToRGB9E5(HalfToFloat(r), HalfToFloat(g), HalfToFloat(b), thresholds);
+    }
+};
+
+template <>
+struct RGB9E5Loader<float>
+{
+    static __m128i Load(const float *source, const __m128 *thresholds)
+    {
+        __m128 r, g, b;
+        LoadRGB32FComponents(source, &r, &g, &b);
+        return ConvertToRGB9E5(r, g, b, thresholds);
+    }
+};
+
+template <typename Source, LoadImageFunction scalarLoad>
+void LoadRGBToRGB9E5(size_t width, size_t height, size_t depth,
+                     const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                     uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+    const SharedExponentThresholds &sharedThresholds = GetSharedExponentThresholds();
+    __m128 thresholds[SharedExponentThresholds::Count];
+    for (int i = 0; i < SharedExponentThresholds::Count; i++)
+    {
+        thresholds[i] = _mm_set1_ps(sharedThresholds.values[i]);
+    }
+
+    for (size_t z = 0; z < depth; z++)
+    {
+        for (size_t y = 0; y < height; y++)
+        {
+            const Source *source = OffsetDataPointer<Source>(input, y, z, inputRowPitch, inputDepthPitch);
+            uint32_t *dest = OffsetDataPointer<uint32_t>(output, y, z, outputRowPitch, outputDepthPitch);
+
+            size_t x = 0;
+
+            for (; x + 3 < width; x += 4)
+            {
+                __m128i result = RGB9E5Loader<Source>::Load(&source[3 * x], thresholds);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&dest[x]), result);
+            }
+
+            // Perform leftover writes
+            if (x < width)
+            {
+                scalarLoad(width - x, 1, 1, reinterpret_cast<const uint8_t*>(&source[3 * x]), inputRowPitch, inputDepthPitch,
+                           reinterpret_cast<uint8_t*>(&dest[x]), outputRowPitch, outputDepthPitch);
+            }
+        }
+    }
+}
+
+}
+
+#endif
+
 void LoadA8ToBGRA8_SSE2(size_t width, size_t height, size_t depth,
                         const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
                         uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
@@ -115,4 +415,438 @@ void LoadRGBA8ToBGRA8_SSE2(size_t width, size_t height, size_t depth,
 #endif
 }
 
+void LoadL8ToRGBA8_SSE2(size_t width, size_t height, size_t depth,
+                        const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                        uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+#if defined(_M_ARM)
+    // Ensure that this function is reported as not implemented for ARM builds because
+    // the instructions below are not present for that architecture.
+    UNIMPLEMENTED();
+    return;
+#else
+    __m128i alpha = _mm_set1_epi8(static_cast<char>(0xFF));
+
+    for (size_t z = 0; z < depth; z++)
+    {
+        for (size_t y = 0; y < height; y++)
+        {
+            const uint8_t *source = OffsetDataPointer<uint8_t>(input, y, z, inputRowPitch, inputDepthPitch);
+            uint8_t *dest = OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
+
+            size_t x = 0;
+
+            for (; x + 15 < width; x += 16)
+            {
+                __m128i sourceData = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[x]));
+                // Pair each luminance byte with itself and with the opaque alpha
+                __m128i lumLo = _mm_unpacklo_epi8(sourceData, sourceData);
+                __m128i lumHi = _mm_unpackhi_epi8(sourceData, sourceData);
+                __m128i lumAlphaLo = _mm_unpacklo_epi8(sourceData, alpha);
+                __m128i lumAlphaHi = _mm_unpackhi_epi8(sourceData, alpha);
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&dest[4 * x +  0]), _mm_unpacklo_epi16(lumLo, lumAlphaLo));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&dest[4 * x + 16]), _mm_unpackhi_epi16(lumLo, lumAlphaLo));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&dest[4 * x + 32]), _mm_unpacklo_epi16(lumHi, lumAlphaHi));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&dest[4 * x + 48]), _mm_unpackhi_epi16(lumHi, lumAlphaHi));
+            }
+
+            // Perform leftover writes
+            if (x < width)
+            {
+                LoadL8ToRGBA8(width - x, 1, 1, &source[x], inputRowPitch, inputDepthPitch,
+                              &dest[4 * x], outputRowPitch, outputDepthPitch);
+            }
+        }
+    }
+#endif
+}
+
+void LoadLA8ToRGBA8_SSE2(size_t width, size_t height, size_t depth,
+                         const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                         uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+#if defined(_M_ARM)
+    // Ensure that this function is reported as not implemented for ARM builds because
+    // the instructions below are not present for that architecture.
+    UNIMPLEMENTED();
+    return;
+#else
+    __m128i lumMask = _mm_set1_epi16(0x00FF);
+
+    for (size_t z = 0; z < depth; z++)
+    {
+        for (size_t y = 0; y < height; y++)
+        {
+            const uint8_t *source = OffsetDataPointer<uint8_t>(input, y, z, inputRowPitch, inputDepthPitch);
+            uint8_t *dest = OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
+
+            size_t x = 0;
+
+            for (; x + 7 < width; x += 8)
+            {
+                // Each 16-bit lane holds one luminance-alpha pixel
+                __m128i lumAlpha = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[2 * x]));
+                __m128i lum = _mm_and_si128(lumAlpha, lumMask);
+                __m128i lumLum = _mm_or_si128(lum, _mm_slli_epi16(lum, 8));
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&dest[4 * x +  0]), _mm_unpacklo_epi16(lumLum, lumAlpha));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&dest[4 * x + 16]), _mm_unpackhi_epi16(lumLum, lumAlpha));
+            }
+
+            // Perform leftover writes
+            if (x < width)
+            {
+                LoadLA8ToRGBA8(width - x, 1, 1, &source[2 * x], inputRowPitch, inputDepthPitch,
+                               &dest[4 * x], outputRowPitch, outputDepthPitch);
+            }
+        }
+    }
+#endif
+}
+
+void LoadR5G6B5ToBGRA8_SSE2(size_t width, size_t height, size_t depth,
+                            const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                            uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+#if defined(_M_ARM)
+    // Ensure that this function is reported as not implemented for ARM builds because
+    // the instructions below are not present for that architecture.
+    UNIMPLEMENTED();
+    return;
+#else
+    LoadPacked16ToRGBA8<R5G6B5Channels, true, LoadR5G6B5ToBGRA8>(width, height, depth, input, inputRowPitch, inputDepthPitch,
+                                                                 output, outputRowPitch, outputDepthPitch);
+#endif
+}
+
+void LoadR5G6B5ToRGBA8_SSE2(size_t width, size_t height, size_t depth,
+                            const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                            uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+#if defined(_M_ARM)
+    // Ensure that this function is reported as not implemented for ARM builds because
+    // the instructions below are not present for that architecture.
+    UNIMPLEMENTED();
+    return;
+#else
+    LoadPacked16ToRGBA8<R5G6B5Channels, false, LoadR5G6B5ToRGBA8>(width, height, depth, input, inputRowPitch, inputDepthPitch,
+                                                                  output, outputRowPitch, outputDepthPitch);
+#endif
+}
+
+void LoadRGBA4ToBGRA8_SSE2(size_t width, size_t height, size_t depth,
+                           const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                           uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+#if defined(_M_ARM)
+    // Ensure that this function is reported as not implemented for ARM builds because
+    // the instructions below are not present for that architecture.
+    UNIMPLEMENTED();
+    return;
+#else
+    LoadPacked16ToRGBA8<RGBA4Channels, true, LoadRGBA4ToBGRA8>(width, height, depth, input, inputRowPitch, inputDepthPitch,
+                                                               output, outputRowPitch, outputDepthPitch);
+#endif
+}
+
+void LoadRGBA4ToRGBA8_SSE2(size_t width, size_t height, size_t depth,
+                           const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                           uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+#if defined(_M_ARM)
+    // Ensure that this function is reported as not implemented for ARM builds because
+    // the instructions below are not present for that architecture.
+    UNIMPLEMENTED();
+    return;
+#else
+    LoadPacked16ToRGBA8<RGBA4Channels, false, LoadRGBA4ToRGBA8>(width, height, depth, input, inputRowPitch, inputDepthPitch,
+                                                                output, outputRowPitch, outputDepthPitch);
+#endif
+}
+
+void LoadRGB5A1ToBGRA8_SSE2(size_t width, size_t height, size_t depth,
+                            const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                            uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+#if defined(_M_ARM)
+    // Ensure that this function is reported as not implemented for ARM builds because
+    // the instructions below are not present for that architecture.
+    UNIMPLEMENTED();
+    return;
+#else
+    LoadPacked16ToRGBA8<RGB5A1Channels, true, LoadRGB5A1ToBGRA8>(width, height, depth, input, inputRowPitch, inputDepthPitch,
+                                                                 output, outputRowPitch, outputDepthPitch);
+#endif
+}
+
+void LoadRGB5A1ToRGBA8_SSE2(size_t width, size_t height, size_t depth,
+                            const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                            uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+#if defined(_M_ARM)
+    // Ensure that this function is reported as not implemented for ARM builds because
+    // the instructions below are not present for that architecture.
+    UNIMPLEMENTED();
+    return;
+#else
+    LoadPacked16ToRGBA8<RGB5A1Channels, false, LoadRGB5A1ToRGBA8>(width, height, depth, input, inputRowPitch, inputDepthPitch,
+                                                                  output, outputRowPitch, outputDepthPitch);
+#endif
+}
+
+
+void LoadA16FToRGBA16F_SSE2(size_t width, size_t height, size_t depth,
+                            const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                            uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+#if defined(_M_ARM)
+    // Ensure that this function is reported as not implemented for ARM builds because
+    // the instructions below are not present for that architecture.
+    UNIMPLEMENTED();
+    return;
+#else
+    __m128i zero = _mm_setzero_si128();
+
+    for (size_t z = 0; z < depth; z++)
+    {
+        for (size_t y = 0; y < height; y++)
+        {
+            const uint16_t *source = OffsetDataPointer<uint16_t>(input, y, z, inputRowPitch, inputDepthPitch);
+            uint16_t *dest = OffsetDataPointer<uint16_t>(output, y, z, outputRowPitch, outputDepthPitch);
+
+            size_t x = 0;
+
+            for (; x + 7 < width; x += 8)
+            {
+                __m128i sourceData = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[x]));
+                // Move each alpha value to the top 16 bits of a 32-bit lane, then of a 64-bit pixel
+                __m128i alphaLo = _mm_unpacklo_epi16(zero, sourceData);
+                __m128i alphaHi = _mm_unpackhi_epi16(zero, sourceData);
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&dest[4 * x +  0]), _mm_unpacklo_epi32(zero, alphaLo));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&dest[4 * x +  8]), _mm_unpackhi_epi32(zero, alphaLo));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&dest[4 * x + 16]), _mm_unpacklo_epi32(zero, alphaHi));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&dest[4 * x + 24]), _mm_unpackhi_epi32(zero, alphaHi));
+            }
+
+            // Perform leftover writes
+            if (x < width)
+            {
+                LoadA16FToRGBA16F(width - x, 1, 1, reinterpret_cast<const uint8_t*>(&source[x]), inputRowPitch, inputDepthPitch,
+                                  reinterpret_cast<uint8_t*>(&dest[4 * x]), outputRowPitch, outputDepthPitch);
+            }
+        }
+    }
+#endif
+}
+
+void LoadL16FToRGBA16F_SSE2(size_t width, size_t height, size_t depth,
+                            const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                            uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+#if defined(_M_ARM)
+    // Ensure that this function is reported as not implemented for ARM builds because
+    // the instructions below are not present for that architecture.
+    UNIMPLEMENTED();
+    return;
+#else
+    __m128i one = _mm_set1_epi16(gl::Float16One);
+
+    for (size_t z = 0; z < depth; z++)
+    {
+        for (size_t y = 0; y < height; y++)
+        {
+            const uint16_t *source = OffsetDataPointer<uint16_t>(input, y, z, inputRowPitch, inputDepthPitch);
+            uint16_t *dest = OffsetDataPointer<uint16_t>(output, y, z, outputRowPitch, outputDepthPitch);
+
+            size_t x = 0;
+
+            for (; x + 7 < width; x += 8)
+            {
+                __m128i sourceData = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[x]));
+                // Pair each luminance value with itself and with the alpha of one
+                __m128i lumLo = _mm_unpacklo_epi16(sourceData, sourceData);
+                __m128i lumHi = _mm_unpackhi_epi16(sourceData, sourceData);
+                __m128i lumAlphaLo = _mm_unpacklo_epi16(sourceData, one);
+                __m128i lumAlphaHi = _mm_unpackhi_epi16(sourceData, one);
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&dest[4 * x +  0]), _mm_unpacklo_epi32(lumLo, lumAlphaLo));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&dest[4 * x +  8]), _mm_unpackhi_epi32(lumLo, lumAlphaLo));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&dest[4 * x + 16]), _mm_unpacklo_epi32(lumHi, lumAlphaHi));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&dest[4 * x + 24]), _mm_unpackhi_epi32(lumHi, lumAlphaHi));
+            }
+
+            // Perform leftover writes
+            if (x < width)
+            {
+                LoadL16FToRGBA16F(width - x, 1, 1, reinterpret_cast<const uint8_t*>(&source[x]), inputRowPitch, inputDepthPitch,
+                                  reinterpret_cast<uint8_t*>(&dest[4 * x]), outputRowPitch, outputDepthPitch);
+            }
+        }
+    }
+#endif
+}
+
+void LoadLA16FToRGBA16F_SSE2(size_t width, size_t height, size_t depth,
+                             const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                             uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+#if defined(_M_ARM)
+    // Ensure that this function is reported as not implemented for ARM builds because
+    // the instructions below are not present for that architecture.
+    UNIMPLEMENTED();
+    return;
+#else
+    for (size_t z = 0; z < depth; z++)
+    {
+        for (size_t y = 0; y < height; y++)
+        {
+            const uint16_t *source = OffsetDataPointer<uint16_t>(input, y, z, inputRowPitch, inputDepthPitch);
+            uint16_t *dest = OffsetDataPointer<uint16_t>(output, y, z, outputRowPitch, outputDepthPitch);
+
+            size_t x = 0;
+
+            for (; x + 3 < width; x += 4)
+            {
+                __m128i sourceData = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[2 * x]));
+                // Give each pixel 64 bits holding its luminance and alpha twice, then spread the
+                // luminance over the first three values
+                __m128i pixelsLo = _mm_unpacklo_epi32(sourceData, sourceData);
+                __m128i pixelsHi = _mm_unpackhi_epi32(sourceData, sourceData);
+                pixelsLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixelsLo, _MM_SHUFFLE(1, 0, 0, 0)), _MM_SHUFFLE(1, 0, 0, 0));
+                pixelsHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixelsHi, _MM_SHUFFLE(1, 0, 0, 0)), _MM_SHUFFLE(1, 0, 0, 0));
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&dest[4 * x + 0]), pixelsLo);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&dest[4 * x + 8]), pixelsHi);
+            }
+
+            // Perform leftover writes
+            if (x < width)
+            {
+                LoadLA16FToRGBA16F(width - x, 1, 1, reinterpret_cast<const uint8_t*>(&source[2 * x]), inputRowPitch, inputDepthPitch,
+                                   reinterpret_cast<uint8_t*>(&dest[4 * x]), outputRowPitch, outputDepthPitch);
+            }
+        }
+    }
+#endif
+}
+
+void LoadRGB16FToRGB9E5_SSE2(size_t width, size_t height, size_t depth,
+                             const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                             uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+#if defined(_M_ARM)
+    // Ensure that this function is reported as not implemented for ARM builds because
+    // the instructions below are not present for that architecture.
+    UNIMPLEMENTED();
+    return;
+#else
+    LoadRGBToRGB9E5<uint16_t, LoadRGB16FToRGB9E5>(width, height, depth, input, inputRowPitch, inputDepthPitch,
+                                                  output, outputRowPitch, outputDepthPitch);
+#endif
+}
+
+void LoadRGB32FToRGB9E5_SSE2(size_t width, size_t height, size_t depth,
+                             const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                             uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+#if defined(_M_ARM)
+    // Ensure that this function is reported as not implemented for ARM builds because
+    // the instructions below are not present for that architecture.
+    UNIMPLEMENTED();
+    return;
+#else
+    LoadRGBToRGB9E5<float, LoadRGB32FToRGB9E5>(width, height, depth, input, inputRowPitch, inputDepthPitch,
+                                               output, outputRowPitch, outputDepthPitch);
+#endif
+}
+
+void LoadRGB16FToRG11B10F_SSE2(size_t width, size_t height, size_t depth,
+                               const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                               uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+#if defined(_M_ARM)
+    // Ensure that this function is reported as not implemented for ARM builds because
+    // the instructions below are not present for that architecture.
+    UNIMPLEMENTED();
+    return;
+#else
+    for (size_t z = 0; z < depth; z++)
+    {
+        for (size_t y = 0; y < height; y++)
+        {
+            const uint16_t *source = OffsetDataPointer<uint16_t>(input, y, z, inputRowPitch, inputDepthPitch);
+            uint32_t *dest = OffsetDataPointer<uint32_t>(output, y, z, outputRowPitch, outputDepthPitch);
+
+            size_t x = 0;
+
+            for (; x + 3 < width; x += 4)
+            {
+                __m128i r, g, b;
+                LoadRGB16FComponents(&source[3 * x], &r, &g, &b);
+
+                __m128i red = FloatToSmallFloat<6>(HalfToFloat(r));
+                __m128i green = FloatToSmallFloat<6>(HalfToFloat(g));
+                __m128i blue = FloatToSmallFloat<5>(HalfToFloat(b));
+                __m128i result = _mm_or_si128(_mm_or_si128(red, _mm_slli_epi32(green, 11)), _mm_slli_epi32(blue, 22));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&dest[x]), result);
+            }
+
+            // Perform leftover writes
+            if (x < width)
+            {
+                LoadRGB16FToRG11B10F(width - x, 1, 1, reinterpret_cast<const uint8_t*>(&source[3 * x]), inputRowPitch, inputDepthPitch,
+                                     reinterpret_cast<uint8_t*>(&dest[x]), outputRowPitch, outputDepthPitch);
+            }
+        }
+    }
+#endif
+}
+
+void LoadRGB32FToRGBA16F_SSE2(size_t width, size_t height, size_t depth,
+                              const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                              uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+#if defined(_M_ARM)
+    // Ensure that this function is reported as not implemented for ARM builds because
+    // the instructions below are not present for that architecture.
+    UNIMPLEMENTED();
+    return;
+#else
+    __m128i one = _mm_set1_epi32(gl::Float16One << 16);
+
+    for (size_t z = 0; z < depth; z++)
+    {
+        for (size_t y = 0; y < height; y++)
+        {
+            const float *source = OffsetDataPointer<float>(input, y, z, inputRowPitch, inputDepthPitch);
+            uint16_t *dest = OffsetDataPointer<uint16_t>(output, y, z, outputRowPitch, outputDepthPitch);
+
+            size_t x = 0;
+
+            for (; x + 3 < width; x += 4)
+            {
+                __m128 r, g, b;
+                LoadRGB32FComponents(&source[3 * x], &r, &g, &b);
+
+                // Each pixel is the 32 bits of red and green followed by those of blue and one
+                __m128i redGreen = _mm_or_si128(FloatToHalf(r), _mm_slli_epi32(FloatToHalf(g), 16));
+                __m128i blueAlpha = _mm_or_si128(FloatToHalf(b), one);
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&dest[4 * x + 0]), _mm_unpacklo_epi32(redGreen, blueAlpha));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&dest[4 * x + 8]), _mm_unpackhi_epi32(redGreen, blueAlpha));
+            }
+
+            // Perform leftover writes
+            if (x < width)
+            {
+                LoadRGB32FToRGBA16F(width - x, 1, 1, reinterpret_cast<const uint8_t*>(&source[3 * x]), inputRowPitch, inputDepthPitch,
+                                    reinterpret_cast<uint8_t*>(&dest[4 * x]), outputRowPitch, outputDepthPitch);
+            }
+        }
+    }
+#endif
+}
+
 }
@@ -0,0 +1,101 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// loadimageSSSE3.cpp: Defines image loading functions that need the SSSE3 byte shuffle.
+// It's in a separated file for GCC, which can enable SSE usage only per-file,
+// not for code blocks that use SSSE3 explicitly. Nothing here may instantiate the inline
+// templates of loadimage.h: the linker could keep this -mssse3 copy for every caller.
+
+#include "libGLESv2/renderer/loadimage.h"
+
+#if !defined(_M_ARM)
+#include <tmmintrin.h>
+#endif
+
+namespace rx
+{
+
+#if !defined(_M_ARM)
+
+namespace
+{
+
+// Expands packed 3-byte pixels to 4-byte pixels with an opaque fourth byte, four pixels at a time.
+// The shuffle mask selects the source byte for each destination byte; entries with the high bit
+// set produce zero, which the alpha mask then fills in.
+template <LoadImageFunction scalarLoad>
+void LoadRGB8To4Component(const __m128i &shuffleMask,
+                          size_t width, size_t height, size_t depth,
+                          const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                          uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+    __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+
+    for (size_t z = 0; z < depth; z++)
+    {
+        for (size_t y = 0; y < height; y++)
+        {
+            const uint8_t *source = input + y * inputRowPitch + z * inputDepthPitch;
+            uint8_t *dest = output + y * outputRowPitch + z * outputDepthPitch;
+
+            size_t x = 0;
+
+            // Each iteration reads 16 bytes but only consumes 12, so stop while the full read
+            // still lies within the row.
+            for (; x + 5 < width; x += 4)
+            {
+                __m128i sourceData = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[3 * x]));
+                __m128i result = _mm_or_si128(_mm_shuffle_epi8(sourceData, shuffleMask), alphaMask);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&dest[4 * x]), result);
+            }
+
+            // Perform leftover writes
+            if (x < width)
+            {
+                scalarLoad(width - x, 1, 1, &source[3 * x], inputRowPitch, inputDepthPitch,
+                           &dest[4 * x], outputRowPitch, outputDepthPitch);
+            }
+        }
+    }
+}
+
+}
+
+#endif
+
+void LoadRGB8ToBGRX8_SSSE3(size_t width, size_t height, size_t depth,
+                           const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                           uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+#if defined(_M_ARM)
+    // Ensure that this function is reported as not implemented for ARM builds because
+    // the instructions below are not present for that architecture.
+    UNIMPLEMENTED();
+    return;
+#else
+    const __m128i shuffleMask = _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+    LoadRGB8To4Component<LoadRGB8ToBGRX8>(shuffleMask, width, height, depth, input, inputRowPitch, inputDepthPitch,
+                                          output, outputRowPitch, outputDepthPitch);
+#endif
+}
+
+void LoadRGB8ToRGBA8_SSSE3(size_t width, size_t height, size_t depth,
+                           const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                           uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+#if defined(_M_ARM)
+    // Ensure that this function is reported as not implemented for ARM builds because
+    // the instructions below are not present for that architecture.
+    UNIMPLEMENTED();
+    return;
+#else
+    const __m128i shuffleMask = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    LoadRGB8To4Component<LoadRGB8ToRGBA8>(shuffleMask, width, height, depth, input, inputRowPitch, inputDepthPitch,
+                                          output, outputRowPitch, outputDepthPitch);
+#endif
+}
+
+}
@@ -0,0 +1,262 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// parallelimage.cpp: Implements helpers that run image loads, pixel copies and mip
+// generation on a gl::WorkerPool.
+
+#include "libGLESv2/renderer/parallelimage.h"
+
+#include "common/WorkerPool.h"
+#include "common/debug.h"
+
+#include <algorithm>
+
+namespace rx
+{
+
+namespace
+{
+
+// Smallest amount of destination data handed to a single thread.
+const size_t MinParallelRangeBytes = 64 * 1024;
+
+size_t GetMinRangeSize(size_t itemBytes)
+{
+    return (itemBytes > 0) ? std::max<size_t>(1, MinParallelRangeBytes / itemBytes) : 1;
+}
+
+struct LoadImageTask
+{
+    LoadImageFunction loadFunction;
+    size_t blockHeight;
+    size_t blockRows;
+    size_t width;
+    size_t height;
+    const uint8_t *input;
+    size_t inputRowPitch;
+    size_t inputDepthPitch;
+    uint8_t *output;
+    size_t outputRowPitch;
+    size_t outputDepthPitch;
+};
+
+// Items are block rows numbered across all depth slices; a range may span several slices.
+void LoadImageRange(size_t begin, size_t end, void *userData)
+{
+    const LoadImageTask *task = static_cast<const LoadImageTask*>(userData);
+
+    size_t item = begin;
+    while (item < end)
+    {
+        size_t z = item / task->blockRows;
+        size_t firstRow = item % task->blockRows;
+        size_t lastRow = std::min(task->blockRows, firstRow + (end - item));
+
+        size_t firstPixelRow = firstRow * task->blockHeight;
+        size_t pixelRows = std::min(lastRow * task->blockHeight, task->height) - firstPixelRow;
+
+        const uint8_t *input = task->input + z * task->inputDepthPitch + firstRow * task->inputRowPitch;
+        uint8_t *output = task->output + z * task->outputDepthPitch + firstRow * task->outputRowPitch;
+
+        task->loadFunction(task->width, pixelRows, 1,
+                           input, task->inputRowPitch, task->inputDepthPitch,
+                           output, task->outputRowPitch, task->outputDepthPitch);
+
+        item += lastRow - firstRow;
+    }
+}
+
+struct GenerateMipTask
+{
+    MipGenerationFunction mipFunction;
+    size_t sourceWidth;
+    size_t sourceHeight;
+    const uint8_t *sourceData;
+    size_t sourceRowPitch;
+    size_t sourceDepthPitch;
+    uint8_t *destData;
+    size_t destRowPitch;
+    size_t destDepthPitch;
+};
+
+// Items are destination depth slices, each produced from two source slices.
+void GenerateMipSlices(size_t begin, size_t end, void *userData)
+{
+    const GenerateMipTask *task = static_cast<const GenerateMipTask*>(userData);
+
+    task->mipFunction(task->sourceWidth, task->sourceHeight, (end - begin) * 2,
+                      task->sourceData + begin * 2 * task->sourceDepthPitch, task->sourceRowPitch, task->sourceDepthPitch,
+                      task->destData + begin * task->destDepthPitch, task->destRowPitch, task->destDepthPitch);
+}
+
+// Items are destination rows of a 2D image, each produced from two source rows.
+void GenerateMipRows(size_t begin, size_t end, void *userData)
+{
+    const GenerateMipTask *task = static_cast<const GenerateMipTask*>(userData);
+
+    task->mipFunction(task->sourceWidth, (end - begin) * 2, 1,
+                      task->sourceData + begin * 2 * task->sourceRowPitch, task->sourceRowPitch, task->sourceDepthPitch,
+                      task->destData + begin * task->destRowPitch, task->destRowPitch, task->destDepthPitch);
+}
+
+struct CopyPixelsTask
+{
+    ColorCopyFunction fastCopyFunction;
+    ColorReadFunction readFunction;
+    ColorWriteFunction writeFunction;
+    size_t width;
+    const uint8_t *source;
+    ptrdiff_t sourceRowPitch;
+    size_t sourcePixelBytes;
+    uint8_t *dest;
+    ptrdiff_t destRowPitch;
+    size_t destPixelBytes;
+};
+
+void CopyPixelRows(size_t begin, size_t end, void *userData)
+{
+    const CopyPixelsTask *task = static_cast<const CopyPixelsTask*>(userData);
+
+    uint8_t temp[16]; // Maximum size of any Color<T> type used.
+    META_ASSERT(sizeof(temp) >= sizeof(gl::ColorF)  &&
+                sizeof(temp) >= sizeof(gl::ColorUI) &&
+                sizeof(temp) >= sizeof(gl::ColorI));
+
+    for (size_t y = begin; y < end; y++)
+    {
+        const uint8_t *sourceRow = task->source + static_cast<ptrdiff_t>(y) * task->sourceRowPitch;
+        uint8_t *destRow = task->dest + static_cast<ptrdiff_t>(y) * task->destRowPitch;
+
+        if (task->fastCopyFunction)
+        {
+            for (size_t x = 0; x < task->width; x++)
+            {
+                task->fastCopyFunction(sourceRow + x * task->sourcePixelBytes, destRow + x * task->destPixelBytes);
+            }
+        }
+        else
+        {
+            for (size_t x = 0; x < task->width; x++)
+            {
+                // readFunc and writeFunc will be using the same type of color, CopyTexImage
+                // will not allow the copy otherwise.
+                task->readFunction(sourceRow + x * task->sourcePixelBytes, temp);
+                task->writeFunction(temp, destRow + x * task->destPixelBytes);
+            }
+        }
+    }
+}
+
+}
+
+bool ShouldRunParallel(const gl::WorkerPool *pool, size_t destBytes)
+{
+    return pool != NULL && pool->getThreadCount() > 1 && destBytes >= MinParallelImageBytes;
+}
+
+void LoadImageParallel(gl::WorkerPool *pool, LoadImageFunction loadFunction, size_t blockHeight,
+                       size_t width, size_t height, size_t depth,
+                       const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                       uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+    ASSERT(blockHeight > 0);
+    size_t blockRows = (height + blockHeight - 1) / blockHeight;
+
+    if (!ShouldRunParallel(pool, outputRowPitch * blockRows * depth))
+    {
+        loadFunction(width, height, depth, input, inputRowPitch, inputDepthPitch,
+                     output, outputRowPitch, outputDepthPitch);
+        return;
+    }
+
+    LoadImageTask task;
+    task.loadFunction = loadFunction;
+    task.blockHeight = blockHeight;
+    task.blockRows = blockRows;
+    task.width = width;
+    task.height = height;
+    task.input = input;
+    task.inputRowPitch = inputRowPitch;
+    task.inputDepthPitch = inputDepthPitch;
+    task.output = output;
+    task.outputRowPitch = outputRowPitch;
+    task.outputDepthPitch = outputDepthPitch;
+
+    pool->parallelFor(blockRows * depth, GetMinRangeSize(outputRowPitch), LoadImageRange, &task);
+}
+
+void GenerateMipParallel(gl::WorkerPool *pool, MipGenerationFunction mipFunction,
+                         size_t sourceWidth, size_t sourceHeight, size_t sourceDepth,
+                         const uint8_t *sourceData, size_t sourceRowPitch, size_t sourceDepthPitch,
+                         uint8_t *destData, size_t destRowPitch, size_t destDepthPitch)
+{
+    size_t destHeight = std::max<size_t>(1, sourceHeight >> 1);
+    size_t destDepth = std::max<size_t>(1, sourceDepth >> 1);
+
+    // Images that are a single row and slice can only be split along x, which the mip
+    // functions do not support; they are small enough to generate inline anyway.
+    bool splitSlices = sourceDepth > 1;
+    bool splitRows = !splitSlices && sourceHeight > 1;
+
+    if (!(splitSlices || splitRows) || !ShouldRunParallel(pool, destRowPitch * destHeight * destDepth))
+    {
+        mipFunction(sourceWidth, sourceHeight, sourceDepth, sourceData, sourceRowPitch, sourceDepthPitch,
+                    destData, destRowPitch, destDepthPitch);
+        return;
+    }
+
+    GenerateMipTask task;
+    task.mipFunction = mipFunction;
+    task.sourceWidth = sourceWidth;
+    task.sourceHeight = sourceHeight;
+    task.sourceData = sourceData;
+    task.sourceRowPitch = sourceRowPitch;
+    task.sourceDepthPitch = sourceDepthPitch;
+    task.destData = destData;
+    task.destRowPitch = destRowPitch;
+    task.destDepthPitch = destDepthPitch;
+
+    if (splitSlices)
+    {
+        pool->parallelFor(destDepth, GetMinRangeSize(destRowPitch * destHeight), GenerateMipSlices, &task);
+    }
+    else
+    {
+        pool->parallelFor(destHeight, GetMinRangeSize(destRowPitch), GenerateMipRows, &task);
+    }
+}
+
+void CopyPixelsParallel(gl::WorkerPool *pool, ColorCopyFunction fastCopyFunction,
+                        ColorReadFunction readFunction, ColorWriteFunction writeFunction,
+                        size_t width, size_t height,
+                        const uint8_t *source, ptrdiff_t sourceRowPitch, size_t sourcePixelBytes,
+                        uint8_t *dest, ptrdiff_t destRowPitch, size_t destPixelBytes)
+{
+    ASSERT(fastCopyFunction != NULL || (readFunction != NULL && writeFunction != NULL));
+
+    CopyPixelsTask task;
+    task.fastCopyFunction = fastCopyFunction;
+    task.readFunction = readFunction;
+    task.writeFunction = writeFunction;
+    task.width = width;
+    task.source = source;
+    task.sourceRowPitch = sourceRowPitch;
+    task.sourcePixelBytes = sourcePixelBytes;
+    task.dest = dest;
+    task.destRowPitch = destRowPitch;
+    task.destPixelBytes = destPixelBytes;
+
+    size_t destRowBytes = width * destPixelBytes;
+    if (!ShouldRunParallel(pool, destRowBytes * height))
+    {
+        CopyPixelRows(0, height, &task);
+        return;
+    }
+
+    pool->parallelFor(height, GetMinRangeSize(destRowBytes), CopyPixelRows, &task);
+}
+
+}
@@ -0,0 +1,59 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// parallelimage.h: Defines helpers that split image loads, pixel copies and mip
+// generation into bands of rows or depth slices and run them on a gl::WorkerPool.
+
+#ifndef LIBGLESV2_RENDERER_PARALLELIMAGE_H_
+#define LIBGLESV2_RENDERER_PARALLELIMAGE_H_
+
+#include "libGLESv2/formatutils.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gl
+{
+class WorkerPool;
+}
+
+namespace rx
+{
+
+// Destinations smaller than this are processed inline; waking the workers costs more than
+// the conversion itself.
+const size_t MinParallelImageBytes = 256 * 1024;
+
+// Returns whether work writing destBytes of image data should be split across the threads
+// of pool, which may be NULL.
+bool ShouldRunParallel(const gl::WorkerPool *pool, size_t destBytes);
+
+// Each helper runs inline when pool is NULL or when the destination is too small for
+// threading to pay off, so callers can use them unconditionally.
+
+// blockHeight is the number of pixel rows covered by one row of input and output data,
+// 1 for uncompressed formats and the compressed block height otherwise.
+void LoadImageParallel(gl::WorkerPool *pool, LoadImageFunction loadFunction, size_t blockHeight,
+                       size_t width, size_t height, size_t depth,
+                       const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                       uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch);
+
+void GenerateMipParallel(gl::WorkerPool *pool, MipGenerationFunction mipFunction,
+                         size_t sourceWidth, size_t sourceHeight, size_t sourceDepth,
+                         const uint8_t *sourceData, size_t sourceRowPitch, size_t sourceDepthPitch,
+                         uint8_t *destData, size_t destRowPitch, size_t destDepthPitch);
+
+// Converts pixels one at a time with fastCopyFunction, or with readFunction followed by
+// writeFunction when no fast copy exists. Row pitches may be negative to flip the image.
+void CopyPixelsParallel(gl::WorkerPool *pool, ColorCopyFunction fastCopyFunction,
+                        ColorReadFunction readFunction, ColorWriteFunction writeFunction,
+                        size_t width, size_t height,
+                        const uint8_t *source, ptrdiff_t sourceRowPitch, size_t sourcePixelBytes,
+                        uint8_t *dest, ptrdiff_t destRowPitch, size_t destPixelBytes);
+
+}
+
+#endif // LIBGLESV2_RENDERER_PARALLELIMAGE_H_
@@ -1423,9 +1423,10 @@ static bool ValidateDrawBase(Context *context, GLenum mode, GLsizei count, GLsiz
     }
 
     const State &state = context->getState();
+    const VertexAttribLimits &attribLimits = context->getVertexAttribLimits();
 
     // Check for mapped buffers
-    if (state.hasMappedBuffer(GL_ARRAY_BUFFER))
+    if (attribLimits.mappedArrayBuffer)
     {
         context->recordError(Error(GL_INVALID_OPERATION));
         return false;
@@ -1465,48 +1466,22 @@ static bool ValidateDrawBase(Context *context, GLenum mode, GLsizei count, GLsiz
     }
 
     // Buffer validations
-    const VertexArray *vao = state.getVertexArray();
-    for (int attributeIndex = 0; attributeIndex < MAX_VERTEX_ATTRIBS; attributeIndex++)
+    if (attribLimits.missingVertexData)
     {
-        const VertexAttribute &attrib = vao->getVertexAttribute(attributeIndex);
-        bool attribActive = (programBinary->getSemanticIndex(attributeIndex) != -1);
-        if (attribActive && attrib.enabled)
-        {
-            gl::Buffer *buffer = attrib.buffer.get();
-
-            if (buffer)
-            {
-                GLint64 attribStride = static_cast<GLint64>(ComputeVertexAttributeStride(attrib));
-                GLint64 maxVertexElement = 0;
-
-                if (attrib.divisor > 0)
-                {
-                    maxVertexElement = static_cast<GLint64>(primcount) / static_cast<GLint64>(attrib.divisor);
-                }
-                else
-                {
-                    maxVertexElement = static_cast<GLint64>(maxVertex);
-                }
-
-                GLint64 attribDataSize = maxVertexElement * attribStride;
+        // This is an application error that would normally result in a crash,
+        // but we catch it and return an error
+        context->recordError(Error(GL_INVALID_OPERATION, "An enabled vertex array has no buffer and no pointer."));
+        return false;
+    }
 
-                // [OpenGL ES 3.0.2] section 2.9.4 page 40:
-                // We can return INVALID_OPERATION if our vertex attribute does not have
-                // enough backing data.
-                if (attribDataSize > buffer->getSize())
-                {
-                    context->recordError(Error(GL_INVALID_OPERATION));
-                    return false;
-                }
-            }
-            else if (attrib.pointer == NULL)
-            {
-                // This is an application error that would normally result in a crash,
-                // but we catch it and return an error
-                context->recordError(Error(GL_INVALID_OPERATION, "An enabled vertex array has no buffer and no pointer."));
-                return false;
-            }
-        }
+    // [OpenGL ES 3.0.2] section 2.9.4 page 40:
+    // We can return INVALID_OPERATION if our vertex attribute does not have
+    // enough backing data.
+    if (static_cast<GLint64>(maxVertex) > attribLimits.maxVertexCount ||
+        static_cast<GLint64>(primcount) > attribLimits.maxInstanceCount)
+    {
+        context->recordError(Error(GL_INVALID_OPERATION));
+        return false;
     }
 
     // No-op if zero count
@@ -1561,19 +1536,9 @@ bool ValidateDrawArraysInstanced(Context *context, GLenum mode, GLint first, GLs
 static bool ValidateDrawInstancedANGLE(Context *context)
 {
     // Verify there is at least one active attribute with a divisor of zero
-    const gl::State& state = context->getState();
-
-    gl::ProgramBinary *programBinary = state.getCurrentProgramBinary();
-
-    const VertexArray *vao = state.getVertexArray();
-    for (int attributeIndex = 0; attributeIndex < MAX_VERTEX_ATTRIBS; attributeIndex++)
+    if (context->getVertexAttribLimits().activeNonInstancedAttribute)
     {
-        const VertexAttribute &attrib = vao->getVertexAttribute(attributeIndex);
-        bool active = (programBinary->getSemanticIndex(attributeIndex) != -1);
-        if (active && attrib.divisor == 0)
-        {
-            return true;
-        }
+        return true;
     }
 
     context->recordError(Error(GL_INVALID_OPERATION, "ANGLE_instanced_arrays requires that at least one active attribute"
@@ -1630,7 +1595,7 @@ bool ValidateDrawElements(Context *context, GLenum mode, GLsizei count, GLenum t
     }
 
     const gl::VertexArray *vao = state.getVertexArray();
-    const gl::Buffer *elementArrayBuffer = vao->getElementArrayBuffer();
+    gl::Buffer *elementArrayBuffer = vao->getElementArrayBuffer();
     if (!indices && !elementArrayBuffer)
     {
         context->recordError(Error(GL_INVALID_OPERATION));
@@ -1684,8 +1649,9 @@ bool ValidateDrawElements(Context *context, GLenum mode, GLsizei count, GLenum t
                 return false;
             }
 
-            const uint8_t *offsetPointer = dataPointer + offset;
-            *indexRangeOut = rx::IndexRangeCache::ComputeRange(type, offsetPointer, count);
+            size_t dataSize = static_cast<size_t>(elementArrayBuffer->getSize());
+            *indexRangeOut = elementArrayBuffer->getIndexRangeCache()->computeRange(type, dataPointer, dataSize,
+                                                                                     static_cast<unsigned int>(offset), count);
         }
     }
     else
@@ -42,8 +42,8 @@ namespace {
 
 class ArrayBoundsClamperMarker : public TIntermTraverser {
 public:
-    ArrayBoundsClamperMarker()
-        : mNeedsClamp(false)
+    ArrayBoundsClamperMarker(bool* needsClamp)
+        : mNeedsClamp(needsClamp)
    {
    }
 
@@ -55,16 +55,14 @@ public:
            if (left->isArray() || left->isVector() || left->isMatrix())
            {
                node->setAddIndexClamp();
-               mNeedsClamp = true;
+               *mNeedsClamp = true;
            }
        }
        return true;
    }
 
-    bool GetNeedsClamp() { return mNeedsClamp; }
-
 private:
-    bool mNeedsClamp;
+    bool* mNeedsClamp;
 };
 
 }  // anonymous namespace
@@ -80,16 +78,9 @@ void ArrayBoundsClamper::SetClampingStrategy(ShArrayIndexClampingStrategy clampi
     mClampingStrategy = clampingStrategy;
 }
 
-void ArrayBoundsClamper::MarkIndirectArrayBoundsForClamping(TIntermNode* root)
+TIntermTraverser* ArrayBoundsClamper::CreateClampingMarker()
 {
-    ASSERT(root);
-
-    ArrayBoundsClamperMarker clamper;
-    root->traverse(&clamper);
-    if (clamper.GetNeedsClamp())
-    {
-        SetArrayBoundsClampDefinitionNeeded();
-    }
+    return new ArrayBoundsClamperMarker(&mArrayBoundsClampDefinitionNeeded);
 }
 
 void ArrayBoundsClamper::OutputClampingFunctionDefinition(TInfoSinkBase& out) const
@@ -37,9 +37,9 @@ public:
     // between the translated shaders and any necessary prequel.
     void SetClampingStrategy(ShArrayIndexClampingStrategy clampingStrategy);
 
-    // Marks nodes in the tree that index arrays indirectly as
-    // requiring clamping.
-    void MarkIndirectArrayBoundsForClamping(TIntermNode* root);
+    // Returns a traverser that marks nodes in the tree that index arrays
+    // indirectly as requiring clamping. It is allocated from the current pool.
+    TIntermTraverser* CreateClampingMarker();
 
     // If necessary, output array clamp function source into the shader source.
     void OutputClampingFunctionDefinition(TInfoSinkBase& out) const;
@@ -51,7 +51,6 @@ public:
 
 private:
     bool GetArrayBoundsClampDefinitionNeeded() const { return mArrayBoundsClampDefinitionNeeded; }
-    void SetArrayBoundsClampDefinitionNeeded() { mArrayBoundsClampDefinitionNeeded = true; }
 
     ShArrayIndexClampingStrategy mClampingStrategy;
     bool mArrayBoundsClampDefinitionNeeded;
@@ -0,0 +1,189 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "gtest/gtest.h"
+#include "libGLESv2/formatutils.h"
+
+#include <set>
+#include <vector>
+
+namespace
+{
+
+// Every enum the lookups have to answer for, known or not. All the enums of the tables are below 0x10000.
+std::vector<GLenum> AllEnums()
+{
+    std::vector<GLenum> enums;
+    for (GLenum value = 0; value <= 0x10000; value++)
+    {
+        enums.push_back(value);
+    }
+    enums.push_back(0x10000 | GL_RGBA);
+    enums.push_back(0x10000 | GL_RGBA8);
+    enums.push_back(0xFFFFFFFF);
+    return enums;
+}
+
+void ExpectEqualInternalFormats(const gl::InternalFormat &expected, const gl::InternalFormat &actual, GLenum internalFormat)
+{
+    EXPECT_EQ(expected.redBits, actual.redBits) << internalFormat;
+    EXPECT_EQ(expected.greenBits, actual.greenBits) << internalFormat;
+    EXPECT_EQ(expected.blueBits, actual.blueBits) << internalFormat;
+    EXPECT_EQ(expected.luminanceBits, actual.luminanceBits) << internalFormat;
+    EXPECT_EQ(expected.alphaBits, actual.alphaBits) << internalFormat;
+    EXPECT_EQ(expected.sharedBits, actual.sharedBits) << internalFormat;
+    EXPECT_EQ(expected.depthBits, actual.depthBits) << internalFormat;
+    EXPECT_EQ(expected.stencilBits, actual.stencilBits) << internalFormat;
+    EXPECT_EQ(expected.pixelBytes, actual.pixelBytes) << internalFormat;
+    EXPECT_EQ(expected.componentCount, actual.componentCount) << internalFormat;
+    EXPECT_EQ(expected.compressed, actual.compressed) << internalFormat;
+    EXPECT_EQ(expected.compressedBlockWidth, actual.compressedBlockWidth) << internalFormat;
+    EXPECT_EQ(expected.compressedBlockHeight, actual.compressedBlockHeight) << internalFormat;
+    EXPECT_EQ(expected.format, actual.format) << internalFormat;
+    EXPECT_EQ(expected.type, actual.type) << internalFormat;
+    EXPECT_EQ(expected.componentType, actual.componentType) << internalFormat;
+    EXPECT_EQ(expected.colorEncoding, actual.colorEncoding) << internalFormat;
+    EXPECT_EQ(expected.textureSupport, actual.textureSupport) << internalFormat;
+    EXPECT_EQ(expected.renderSupport, actual.renderSupport) << internalFormat;
+    EXPECT_EQ(expected.filterSupport, actual.filterSupport) << internalFormat;
+}
+
+TEST(FormatUtilsTest, InternalFormatInfoMatchesMap)
+{
+    const gl::priv::InternalFormatInfoMap map = gl::priv::BuildInternalFormatInfoMap();
+    const gl::InternalFormat defaultInfo;
+
+    std::vector<GLenum> enums = AllEnums();
+    for (size_t i = 0; i < enums.size(); i++)
+    {
+        gl::priv::InternalFormatInfoMap::const_iterator iter = map.find(enums[i]);
+        const gl::InternalFormat &expected = (iter != map.end()) ? iter->second : defaultInfo;
+        ExpectEqualInternalFormats(expected, gl::GetInternalFormatInfo(enums[i]), enums[i]);
+    }
+}
+
+TEST(FormatUtilsTest, TypeInfoMatchesMap)
+{
+    const gl::priv::TypeInfoMap map = gl::priv::BuildTypeInfoMap();
+    const gl::Type defaultInfo;
+
+    std::vector<GLenum> enums = AllEnums();
+    for (size_t i = 0; i < enums.size(); i++)
+    {
+        gl::priv::TypeInfoMap::const_iterator iter = map.find(enums[i]);
+        const gl::Type &expected = (iter != map.end()) ? iter->second : defaultInfo;
+        const gl::Type &actual = gl::GetTypeInfo(enums[i]);
+        EXPECT_EQ(expected.bytes, actual.bytes) << enums[i];
+        EXPECT_EQ(expected.specialInterpretation, actual.specialInterpretation) << enums[i];
+    }
+}
+
+TEST(FormatUtilsTest, FormatTypeInfoMatchesMap)
+{
+    const gl::priv::FormatMap map = gl::priv::BuildFormatMap();
+    const gl::FormatType defaultInfo;
+
+    // Every known format with every type, and every known type with every format
+    std::set<GLenum> formats;
+    std::set<GLenum> types;
+    for (gl::priv::FormatMap::const_iterator i = map.begin(); i != map.end(); i++)
+    {
+        formats.insert(i->first.first);
+        types.insert(i->first.second);
+    }
+
+    std::vector<std::pair<GLenum, GLenum> > pairs;
+    std::vector<GLenum> enums = AllEnums();
+    for (size_t i = 0; i < enums.size(); i++)
+    {
+        for (std::set<GLenum>::const_iterator format = formats.begin(); format != formats.end(); format++)
+        {
+            pairs.push_back(std::make_pair(*format, enums[i]));
+        }
+        for (std::set<GLenum>::const_iterator type = types.begin(); type != types.end(); type++)
+        {
+            pairs.push_back(std::make_pair(enums[i], *type));
+        }
+    }
+
+    for (size_t i = 0; i < pairs.size(); i++)
+    {
+        gl::priv::FormatMap::const_iterator iter = map.find(pairs[i]);
+        const gl::FormatType &expected = (iter != map.end()) ? iter->second : defaultInfo;
+        const gl::FormatType &actual = gl::GetFormatTypeInfo(pairs[i].first, pairs[i].second);
+        ASSERT_EQ(expected.internalFormat, actual.internalFormat) << pairs[i].first << ", " << pairs[i].second;
+        ASSERT_EQ(expected.colorWriteFunction, actual.colorWriteFunction) << pairs[i].first << ", " << pairs[i].second;
+    }
+}
+
+TEST(FormatUtilsTest, AllSizedInternalFormats)
+{
+    const gl::priv::InternalFormatInfoMap map = gl::priv::BuildInternalFormatInfoMap();
+
+    gl::FormatSet expected;
+    for (gl::priv::InternalFormatInfoMap::const_iterator i = map.begin(); i != map.end(); i++)
+    {
+        if (i->second.pixelBytes > 0)
+        {
+            expected.insert(i->first);
+        }
+    }
+
+    EXPECT_EQ(expected, gl::GetAllSizedInternalFormats());
+}
+
+TEST(FormatUtilsTest, InternalFormatIndices)
+{
+    const gl::priv::InternalFormatInfoMap map = gl::priv::BuildInternalFormatInfoMap();
+
+    std::set<size_t> indices;
+    for (gl::priv::InternalFormatInfoMap::const_iterator i = map.begin(); i != map.end(); i++)
+    {
+        size_t index = gl::GetInternalFormatIndex(i->first);
+        EXPECT_NE(0u, index) << i->first;
+        EXPECT_TRUE(indices.insert(index).second) << i->first;
+    }
+
+    EXPECT_EQ(0u, gl::GetInternalFormatIndex(GL_TEXTURE_2D));
+    EXPECT_EQ(0u, gl::GetInternalFormatIndex(0x10000 | GL_RGBA8));
+}
+
+TEST(FormatUtilsTest, TextureCapsMap)
+{
+    gl::TextureCapsMap capsMap;
+
+    gl::TextureCaps caps;
+    caps.texturable = true;
+    caps.filterable = true;
+
+    // A known format, and an enum that is not an internal format
+    capsMap.insert(GL_RGBA8, caps);
+    capsMap.insert(GL_TEXTURE_2D, caps);
+    EXPECT_EQ(2u, capsMap.size());
+    EXPECT_TRUE(capsMap.get(GL_RGBA8).filterable);
+    EXPECT_TRUE(capsMap.get(GL_TEXTURE_2D).filterable);
+    EXPECT_FALSE(capsMap.get(GL_RGB8).texturable);
+
+    // Inserting a format again keeps its caps, as the map did
+    gl::TextureCaps otherCaps;
+    capsMap.insert(GL_RGBA8, otherCaps);
+    EXPECT_TRUE(capsMap.get(GL_RGBA8).filterable);
+
+    capsMap.remove(GL_RGBA8);
+    capsMap.remove(GL_TEXTURE_2D);
+    EXPECT_EQ(0u, capsMap.size());
+    EXPECT_FALSE(capsMap.get(GL_RGBA8).texturable);
+    EXPECT_FALSE(capsMap.get(GL_TEXTURE_2D).texturable);
+
+    // Copies answer for their own formats
+    capsMap.insert(GL_RGB8, caps);
+    gl::TextureCapsMap copy = capsMap;
+    capsMap.remove(GL_RGB8);
+    EXPECT_TRUE(copy.get(GL_RGB8).texturable);
+    EXPECT_FALSE(capsMap.get(GL_RGB8).texturable);
+}
+
+}
@@ -0,0 +1,303 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "gtest/gtest.h"
+#include "common/WorkerPool.h"
+#include "libGLESv2/renderer/generatemip.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+
+// Random source bytes with any INF or NAN encodings replaced by finite values. The vectorized
+// kernels only guarantee the same bits as the scalar ones for non-NAN results, and averaging
+// infinities of opposite signs would produce a NAN.
+uint16_t RemoveNaN(uint16_t value, unsigned int mantissaBits)
+{
+    const unsigned int exponentMask = 0x1F << mantissaBits;
+    if ((value & exponentMask) == exponentMask)
+    {
+        value &= ~(1 << (mantissaBits + 4));
+    }
+    return value;
+}
+
+void RemoveNaN(rx::R16G16B16A16F *texel)
+{
+    texel->R = RemoveNaN(texel->R, 10);
+    texel->G = RemoveNaN(texel->G, 10);
+    texel->B = RemoveNaN(texel->B, 10);
+    texel->A = RemoveNaN(texel->A, 10);
+}
+
+void RemoveNaN(rx::R11G11B10F *texel)
+{
+    texel->R = RemoveNaN(texel->R, 6);
+    texel->G = RemoveNaN(texel->G, 6);
+    texel->B = RemoveNaN(texel->B, 5);
+}
+
+template <typename T>
+void RemoveNaN(T *texel)
+{
+}
+
+template <typename T>
+void RemoveTexelNaN(uint8_t *texel)
+{
+    RemoveNaN(reinterpret_cast<T*>(texel));
+}
+
+// The per-texel 2D kernels only, as GenerateMip used before the vectorized ones
+template <typename T>
+void GenerateMipScalar(size_t sourceWidth, size_t sourceHeight, size_t sourceDepth,
+                       const uint8_t *sourceData, size_t sourceRowPitch, size_t sourceDepthPitch,
+                       uint8_t *destData, size_t destRowPitch, size_t destDepthPitch)
+{
+    size_t mipWidth = std::max<size_t>(1, sourceWidth >> 1);
+    size_t mipHeight = std::max<size_t>(1, sourceHeight >> 1);
+
+    if (sourceWidth > 1 && sourceHeight > 1)
+    {
+        rx::priv::GenerateMip_XY<T>(sourceWidth, sourceHeight, 1, sourceData, sourceRowPitch, 0,
+                                    mipWidth, mipHeight, 1, destData, destRowPitch, 0);
+    }
+    else if (sourceWidth > 1)
+    {
+        rx::priv::GenerateMip_X<T>(sourceWidth, 1, 1, sourceData, sourceRowPitch, 0,
+                                   mipWidth, 1, 1, destData, destRowPitch, 0);
+    }
+    else
+    {
+        rx::priv::GenerateMip_Y<T>(1, sourceHeight, 1, sourceData, sourceRowPitch, 0,
+                                   1, mipHeight, 1, destData, destRowPitch, 0);
+    }
+}
+
+struct MipFormat
+{
+    const char *name;
+    MipGenerationFunction mipFunction;
+    MipGenerationFunction scalarMipFunction;
+    size_t pixelBytes;
+    void (*removeNaN)(uint8_t *texel);
+};
+
+const MipFormat mipFormats[] =
+{
+    { "R8",            rx::GenerateMip<rx::R8>,            GenerateMipScalar<rx::R8>,            1, RemoveTexelNaN<rx::R8> },
+    { "R8G8B8A8",      rx::GenerateMip<rx::R8G8B8A8>,      GenerateMipScalar<rx::R8G8B8A8>,      4, RemoveTexelNaN<rx::R8G8B8A8> },
+    { "B8G8R8A8",      rx::GenerateMip<rx::B8G8R8A8>,      GenerateMipScalar<rx::B8G8R8A8>,      4, RemoveTexelNaN<rx::B8G8R8A8> },
+    { "R16G16B16A16F", rx::GenerateMip<rx::R16G16B16A16F>, GenerateMipScalar<rx::R16G16B16A16F>, 8, RemoveTexelNaN<rx::R16G16B16A16F> },
+    { "R11G11B10F",    rx::GenerateMip<rx::R11G11B10F>,    GenerateMipScalar<rx::R11G11B10F>,    4, RemoveTexelNaN<rx::R11G11B10F> },
+};
+
+// Storage for a full 2D mip chain, with padded row pitches
+struct MipChain
+{
+    MipChain(const MipFormat &format, size_t width, size_t height)
+    {
+        size_t levelWidth = width;
+        size_t levelHeight = height;
+        while (true)
+        {
+            widths.push_back(levelWidth);
+            heights.push_back(levelHeight);
+            rowPitches.push_back(levelWidth * format.pixelBytes + 8);
+            levels.push_back(std::vector<uint8_t>(rowPitches.back() * levelHeight, 0));
+
+            if (levelWidth == 1 && levelHeight == 1)
+            {
+                break;
+            }
+            levelWidth = std::max<size_t>(1, levelWidth >> 1);
+            levelHeight = std::max<size_t>(1, levelHeight >> 1);
+        }
+
+        for (size_t i = 0; i < levels[0].size(); i++)
+        {
+            levels[0][i] = static_cast<uint8_t>(rand());
+        }
+        for (size_t y = 0; y < height; y++)
+        {
+            for (size_t x = 0; x < width; x++)
+            {
+                format.removeNaN(&levels[0][y * rowPitches[0] + x * format.pixelBytes]);
+            }
+        }
+    }
+
+    void generateByLevel(MipGenerationFunction mipFunction)
+    {
+        for (size_t level = 1; level < levels.size(); level++)
+        {
+            mipFunction(widths[level - 1], heights[level - 1], 1,
+                               &levels[level - 1][0], rowPitches[level - 1], 0,
+                               &levels[level][0], rowPitches[level], 0);
+        }
+    }
+
+    void generateChain(const MipFormat &format, gl::WorkerPool *pool)
+    {
+        std::vector<uint8_t*> levelData;
+        for (size_t level = 1; level < levels.size(); level++)
+        {
+            levelData.push_back(&levels[level][0]);
+        }
+
+        rx::GenerateMipChain(pool, format.mipFunction, format.pixelBytes, widths[0], heights[0],
+                             &levels[0][0], rowPitches[0], levelData.size(), &levelData[0], &rowPitches[1]);
+    }
+
+    std::vector<size_t> widths;
+    std::vector<size_t> heights;
+    std::vector<size_t> rowPitches;
+    std::vector<std::vector<uint8_t> > levels;
+};
+
+class GenerateMipChainTest : public testing::TestWithParam<MipFormat>
+{
+};
+
+TEST_P(GenerateMipChainTest, MatchesLevelByLevel)
+{
+    const MipFormat &format = GetParam();
+
+    const size_t sizes[][2] =
+    {
+        { 1, 2 },
+        { 2, 1 },
+        { 64, 64 },
+        { 129, 65 },
+        { 1000, 37 },
+        { 1, 300 },
+        { 300, 1 },
+        { 65, 1025 },
+        { 1024, 1024 },
+    };
+
+    gl::WorkerPool pool(3);
+
+    for (size_t sizeIndex = 0; sizeIndex < ArraySize(sizes); sizeIndex++)
+    {
+        MipChain expected(format, sizes[sizeIndex][0], sizes[sizeIndex][1]);
+        MipChain serial = expected;
+        MipChain parallel = expected;
+
+        expected.generateByLevel(format.scalarMipFunction);
+        serial.generateChain(format, NULL);
+        parallel.generateChain(format, &pool);
+
+        for (size_t level = 1; level < expected.levels.size(); level++)
+        {
+            EXPECT_EQ(expected.levels[level], serial.levels[level])
+                << format.name << " " << sizes[sizeIndex][0] << "x" << sizes[sizeIndex][1] << " level " << level;
+            EXPECT_EQ(expected.levels[level], parallel.levels[level])
+                << format.name << " " << sizes[sizeIndex][0] << "x" << sizes[sizeIndex][1] << " level " << level;
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(MipFormats, GenerateMipChainTest, testing::ValuesIn(mipFormats));
+
+#if defined(ANGLE_X86_CPU)
+
+// The vectorized kernels must match the per-texel template exactly, including the
+// scalar tail of rows that are not a multiple of the vector width.
+template <typename T>
+void CheckSIMDMatchesScalar()
+{
+    const size_t width = 515;
+    const size_t height = 7;
+    const size_t sourceRowPitch = width * sizeof(T) + 4;
+    const size_t destRowPitch = (width / 2) * sizeof(T) + 12;
+
+    std::vector<uint8_t> source(sourceRowPitch * height);
+    for (size_t i = 0; i < source.size(); i++)
+    {
+        source[i] = static_cast<uint8_t>(rand());
+    }
+    for (size_t y = 0; y < height; y++)
+    {
+        for (size_t x = 0; x < width; x++)
+        {
+            RemoveNaN(reinterpret_cast<T*>(&source[y * sourceRowPitch + x * sizeof(T)]));
+        }
+    }
+
+    std::vector<uint8_t> expected(destRowPitch * (height / 2), 0);
+    std::vector<uint8_t> actual(expected.size(), 0);
+
+    rx::priv::GenerateMip_XY<T>(width, height, 1, &source[0], sourceRowPitch, 0,
+                                width / 2, height / 2, 1, &expected[0], destRowPitch, 0);
+    rx::priv::GenerateMip_XY_SSE2<T>(width, height, 1, &source[0], sourceRowPitch, 0,
+                                     width / 2, height / 2, 1, &actual[0], destRowPitch, 0);
+    EXPECT_EQ(expected, actual);
+
+    std::fill(expected.begin(), expected.end(), 0);
+    std::fill(actual.begin(), actual.end(), 0);
+
+    rx::priv::GenerateMip_X<T>(width, 1, 1, &source[0], sourceRowPitch, 0,
+                               width / 2, 1, 1, &expected[0], destRowPitch, 0);
+    rx::priv::GenerateMip_X_SSE2<T>(width, 1, 1, &source[0], sourceRowPitch, 0,
+                                    width / 2, 1, 1, &actual[0], destRowPitch, 0);
+    EXPECT_EQ(expected, actual);
+}
+
+TEST(GenerateMipSIMDTest, MatchesScalar)
+{
+    ASSERT_TRUE(gl::supportsSSE2()) << "The SSE2 kernels were not tested, the CPU lacks SSE2";
+
+    CheckSIMDMatchesScalar<rx::A8R8G8B8>();
+    CheckSIMDMatchesScalar<rx::R8G8B8A8>();
+    CheckSIMDMatchesScalar<rx::B8G8R8A8>();
+    CheckSIMDMatchesScalar<rx::B8G8R8X8>();
+    CheckSIMDMatchesScalar<rx::R16G16B16A16F>();
+    CheckSIMDMatchesScalar<rx::R11G11B10F>();
+}
+
+// Half float and R11G11B10F averages go through float32 with the scalar rounding rules,
+// so check every half float against a spread of second operands.
+TEST(GenerateMipSIMDTest, HalfFloatMatchesScalar)
+{
+    ASSERT_TRUE(gl::supportsSSE2()) << "The SSE2 kernels were not tested, the CPU lacks SSE2";
+
+    const size_t width = 2 * 16384;
+    std::vector<rx::R16G16B16A16F> source(width);
+    std::vector<rx::R16G16B16A16F> expected(width / 2);
+    std::vector<rx::R16G16B16A16F> actual(width / 2);
+
+    for (unsigned int second = 0; second < 0x10000; second += 257)
+    {
+        for (size_t i = 0; i < width / 2; i++)
+        {
+            unsigned short first = static_cast<unsigned short>(i * 4);
+            rx::R16G16B16A16F &left = source[i * 2];
+            rx::R16G16B16A16F &right = source[i * 2 + 1];
+            left.R = first;
+            left.G = first + 1;
+            left.B = first + 2;
+            left.A = first + 3;
+            right.R = right.G = right.B = right.A = static_cast<unsigned short>(second);
+            RemoveNaN(&left);
+            RemoveNaN(&right);
+        }
+
+        const uint8_t *sourceData = reinterpret_cast<const uint8_t*>(&source[0]);
+        rx::priv::GenerateMip_X<rx::R16G16B16A16F>(width, 1, 1, sourceData, 0, 0, width / 2, 1, 1,
+                                                   reinterpret_cast<uint8_t*>(&expected[0]), 0, 0);
+        rx::priv::GenerateMip_X_SSE2<rx::R16G16B16A16F>(width, 1, 1, sourceData, 0, 0, width / 2, 1, 1,
+                                                        reinterpret_cast<uint8_t*>(&actual[0]), 0, 0);
+        ASSERT_EQ(0, memcmp(&expected[0], &actual[0], expected.size() * sizeof(rx::R16G16B16A16F))) << "second operand " << second;
+    }
+}
+
+#endif // defined(ANGLE_X86_CPU)
+
+}
@@ -0,0 +1,234 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "gtest/gtest.h"
+#include "libGLESv2/renderer/IndexRangeCache.h"
+#include "libGLESv2/formatutils.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace
+{
+
+class IndexRangeCacheTest : public testing::TestWithParam<GLenum>
+{
+  protected:
+    virtual void SetUp()
+    {
+        mType = GetParam();
+        mTypeBytes = gl::GetTypeInfo(mType).bytes;
+
+        // Large enough to cover several levels of the block summary, with a partial last block
+        mIndexCount = 50000;
+        mData.resize(mIndexCount * mTypeBytes);
+        for (size_t i = 0; i < mData.size(); i++)
+        {
+            mData[i] = static_cast<uint8_t>(rand());
+        }
+    }
+
+    void expectRangeMatches(size_t firstIndex, size_t count)
+    {
+        unsigned int offset = static_cast<unsigned int>(firstIndex * mTypeBytes);
+        rx::RangeUI expected = rx::IndexRangeCache::ComputeRange(mType, &mData[offset], static_cast<GLsizei>(count));
+        rx::RangeUI actual = mCache.computeRange(mType, &mData[0], mData.size(), offset, static_cast<GLsizei>(count));
+
+        EXPECT_EQ(expected.start, actual.start);
+        EXPECT_EQ(expected.end, actual.end);
+    }
+
+    GLenum mType;
+    unsigned int mTypeBytes;
+    size_t mIndexCount;
+    std::vector<uint8_t> mData;
+    rx::IndexRangeCache mCache;
+};
+
+TEST_P(IndexRangeCacheTest, RandomSubRanges)
+{
+    for (int iteration = 0; iteration < 1000; iteration++)
+    {
+        size_t firstIndex = rand() % mIndexCount;
+        size_t count = 1 + rand() % (mIndexCount - firstIndex);
+        expectRangeMatches(firstIndex, count);
+    }
+}
+
+TEST_P(IndexRangeCacheTest, WholeBuffer)
+{
+    expectRangeMatches(0, mIndexCount);
+    expectRangeMatches(1, mIndexCount - 1);
+    expectRangeMatches(0, mIndexCount - 1);
+}
+
+TEST_P(IndexRangeCacheTest, InvalidateRange)
+{
+    expectRangeMatches(0, mIndexCount);
+
+    // Write a new extreme into the middle of the buffer and check the summary picks it up
+    size_t updateIndex = mIndexCount / 2 + 3;
+    memset(&mData[updateIndex * mTypeBytes], 0xFF, mTypeBytes);
+    mCache.invalidateRange(static_cast<unsigned int>(updateIndex * mTypeBytes), mTypeBytes);
+
+    expectRangeMatches(0, mIndexCount);
+    expectRangeMatches(updateIndex - 1000, 2000);
+
+    memset(&mData[updateIndex * mTypeBytes], 0, mTypeBytes);
+    mCache.invalidateRange(static_cast<unsigned int>(updateIndex * mTypeBytes), mTypeBytes);
+
+    expectRangeMatches(0, mIndexCount);
+    expectRangeMatches(updateIndex - 1000, 2000);
+}
+
+TEST_P(IndexRangeCacheTest, Clear)
+{
+    expectRangeMatches(0, mIndexCount);
+
+    // Redefine the buffer with a different size, as glBufferData would
+    mIndexCount /= 3;
+    mData.resize(mIndexCount * mTypeBytes);
+    for (size_t i = 0; i < mData.size(); i++)
+    {
+        mData[i] = static_cast<uint8_t>(rand());
+    }
+    mCache.clear();
+
+    expectRangeMatches(0, mIndexCount);
+    expectRangeMatches(mIndexCount / 4, mIndexCount / 2);
+}
+
+TEST_P(IndexRangeCacheTest, PrimitiveRestart)
+{
+    // Every other index is the restart index, which must not contribute to the maximum. Clear the
+    // top bit of the remaining indices so none of them are restart indices by chance.
+    std::vector<uint8_t> restartData(mData);
+    for (size_t index = 0; index < mIndexCount; index++)
+    {
+        if (index % 2 == 0)
+        {
+            memset(&restartData[index * mTypeBytes], 0xFF, mTypeBytes);
+        }
+        else
+        {
+            restartData[(index + 1) * mTypeBytes - 1] &= 0x7F;
+        }
+    }
+
+    for (int iteration = 0; iteration < 100; iteration++)
+    {
+        size_t firstIndex = rand() % mIndexCount;
+        size_t count = 1 + rand() % (mIndexCount - firstIndex);
+        GLsizei glCount = static_cast<GLsizei>(count);
+
+        const uint8_t *indices = &restartData[firstIndex * mTypeBytes];
+        rx::RangeUI restartRange = rx::IndexRangeCache::ComputeRangeWithPrimitiveRestart(mType, indices, glCount);
+
+        // Compare against the plain range of the non-restart indices only
+        size_t firstData = firstIndex + ((firstIndex % 2 == 0) ? 1 : 0);
+        if (firstData >= firstIndex + count)
+        {
+            EXPECT_EQ(0u, restartRange.start);
+            EXPECT_EQ(0u, restartRange.end);
+            continue;
+        }
+
+        unsigned int expectedMin = std::numeric_limits<unsigned int>::max();
+        unsigned int expectedMax = 0;
+        for (size_t index = firstData; index < firstIndex + count; index += 2)
+        {
+            rx::RangeUI single = rx::IndexRangeCache::ComputeRange(mType, &restartData[index * mTypeBytes], 1);
+            expectedMin = std::min(expectedMin, single.start);
+            expectedMax = std::max(expectedMax, single.end);
+        }
+
+        EXPECT_EQ(expectedMin, restartRange.start);
+        EXPECT_EQ(expectedMax, restartRange.end);
+    }
+}
+
+// Reads the indices one at a time, as the scalar loop of ComputeRange does
+rx::RangeUI ComputeScalarRange(GLenum type, const uint8_t *data, size_t count, bool primitiveRestart)
+{
+    const size_t typeBytes = gl::GetTypeInfo(type).bytes;
+    const unsigned int restartIndex = (typeBytes == 4) ? 0xFFFFFFFFu : ((1u << (typeBytes * 8)) - 1);
+
+    unsigned int minIndex = std::numeric_limits<unsigned int>::max();
+    unsigned int maxIndex = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        unsigned int index = 0;
+        switch (type)
+        {
+          case GL_UNSIGNED_BYTE:  index = reinterpret_cast<const GLubyte*>(data)[i]; break;
+          case GL_UNSIGNED_SHORT: index = reinterpret_cast<const GLushort*>(data)[i]; break;
+          case GL_UNSIGNED_INT:   index = reinterpret_cast<const GLuint*>(data)[i]; break;
+        }
+
+        if (primitiveRestart && index == restartIndex)
+        {
+            continue;
+        }
+        minIndex = std::min(minIndex, index);
+        maxIndex = std::max(maxIndex, index);
+    }
+
+    if (minIndex > maxIndex)
+    {
+        return rx::RangeUI(0, 0);
+    }
+    return rx::RangeUI(minIndex, maxIndex);
+}
+
+#if defined(ANGLE_X86_CPU)
+
+TEST_P(IndexRangeCacheTest, SIMDKernelsMatchScalar)
+{
+    ASSERT_TRUE(gl::supportsSSE2()) << "The SSE2 kernels were not tested, the CPU lacks SSE2";
+    ASSERT_TRUE(gl::supportsSSE41()) << "The SSE4.1 kernels were not tested, the CPU lacks SSE4.1";
+
+    // Some of the indices are restart indices, for the primitive restart variants
+    std::vector<uint8_t> data(mData);
+    for (size_t index = 0; index < mIndexCount; index += 1 + rand() % 64)
+    {
+        memset(&data[index * mTypeBytes], 0xFF, mTypeBytes);
+    }
+
+    for (int iteration = 0; iteration < 1000; iteration++)
+    {
+        // Start anywhere, so that the vector loads are unaligned, and end anywhere, so that every
+        // length of remainder is covered. Most lists are short enough to stress the remainder.
+        size_t firstIndex = rand() % mIndexCount;
+        size_t maxCount = std::min<size_t>(mIndexCount - firstIndex, (iteration % 4 == 0) ? mIndexCount : 300);
+        size_t count = 1 + rand() % maxCount;
+        GLsizei glCount = static_cast<GLsizei>(count);
+        const uint8_t *indices = &data[firstIndex * mTypeBytes];
+
+        for (int restart = 0; restart < 2; restart++)
+        {
+            bool primitiveRestart = (restart != 0);
+            rx::RangeUI expected = ComputeScalarRange(mType, indices, count, primitiveRestart);
+
+            rx::RangeUI actual = rx::ComputeIndexRange_SSE2(mType, indices, glCount, primitiveRestart);
+            EXPECT_EQ(expected.start, actual.start) << "SSE2 " << firstIndex << ", " << count;
+            EXPECT_EQ(expected.end, actual.end) << "SSE2 " << firstIndex << ", " << count;
+
+            actual = rx::ComputeIndexRange_SSE41(mType, indices, glCount, primitiveRestart);
+            EXPECT_EQ(expected.start, actual.start) << "SSE4.1 " << firstIndex << ", " << count;
+            EXPECT_EQ(expected.end, actual.end) << "SSE4.1 " << firstIndex << ", " << count;
+        }
+    }
+}
+
+#endif // defined(ANGLE_X86_CPU)
+
+INSTANTIATE_TEST_CASE_P(IndexTypes, IndexRangeCacheTest,
+                        testing::Values(GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT, GL_UNSIGNED_INT));
+
+}
@@ -0,0 +1,234 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "gtest/gtest.h"
+#include "libGLESv2/renderer/loadimage.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace
+{
+
+#if defined(ANGLE_X86_CPU)
+
+// What the source pixels of a load function hold, which decides how the test fills them
+enum SourceData
+{
+    SOURCE_BYTES,
+    SOURCE_FLOATS,
+};
+
+struct LoadFunctionPair
+{
+    const char *name;
+    bool (*supported)();
+    LoadImageFunction simdLoad;
+    LoadImageFunction scalarLoad;
+    size_t sourcePixelBytes;
+    size_t destPixelBytes;
+    SourceData sourceData;
+};
+
+const LoadFunctionPair loadFunctionPairs[] =
+{
+    { "A8ToBGRA8_SSE2",          gl::supportsSSE2,  rx::LoadA8ToBGRA8_SSE2,         rx::LoadA8ToBGRA8,         1, 4, SOURCE_BYTES  },
+    { "A8ToBGRA8_AVX2",          gl::supportsAVX2,  rx::LoadA8ToBGRA8_AVX2,         rx::LoadA8ToBGRA8,         1, 4, SOURCE_BYTES  },
+    { "L8ToRGBA8_SSE2",          gl::supportsSSE2,  rx::LoadL8ToRGBA8_SSE2,         rx::LoadL8ToRGBA8,         1, 4, SOURCE_BYTES  },
+    { "L8ToRGBA8_AVX2",          gl::supportsAVX2,  rx::LoadL8ToRGBA8_AVX2,         rx::LoadL8ToRGBA8,         1, 4, SOURCE_BYTES  },
+    { "LA8ToRGBA8_SSE2",         gl::supportsSSE2,  rx::LoadLA8ToRGBA8_SSE2,        rx::LoadLA8ToRGBA8,        2, 4, SOURCE_BYTES  },
+    { "LA8ToRGBA8_AVX2",         gl::supportsAVX2,  rx::LoadLA8ToRGBA8_AVX2,        rx::LoadLA8ToRGBA8,        2, 4, SOURCE_BYTES  },
+    { "RGB8ToBGRX8_SSSE3",       gl::supportsSSSE3, rx::LoadRGB8ToBGRX8_SSSE3,      rx::LoadRGB8ToBGRX8,       3, 4, SOURCE_BYTES  },
+    { "RGB8ToBGRX8_AVX2",        gl::supportsAVX2,  rx::LoadRGB8ToBGRX8_AVX2,       rx::LoadRGB8ToBGRX8,       3, 4, SOURCE_BYTES  },
+    { "RGB8ToRGBA8_SSSE3",       gl::supportsSSSE3, rx::LoadRGB8ToRGBA8_SSSE3,      rx::LoadRGB8ToRGBA8,       3, 4, SOURCE_BYTES  },
+    { "RGB8ToRGBA8_AVX2",        gl::supportsAVX2,  rx::LoadRGB8ToRGBA8_AVX2,       rx::LoadRGB8ToRGBA8,       3, 4, SOURCE_BYTES  },
+    { "R5G6B5ToBGRA8_SSE2",      gl::supportsSSE2,  rx::LoadR5G6B5ToBGRA8_SSE2,     rx::LoadR5G6B5ToBGRA8,     2, 4, SOURCE_BYTES  },
+    { "R5G6B5ToRGBA8_SSE2",      gl::supportsSSE2,  rx::LoadR5G6B5ToRGBA8_SSE2,     rx::LoadR5G6B5ToRGBA8,     2, 4, SOURCE_BYTES  },
+    { "RGBA8ToBGRA8_SSE2",       gl::supportsSSE2,  rx::LoadRGBA8ToBGRA8_SSE2,      rx::LoadRGBA8ToBGRA8,      4, 4, SOURCE_BYTES  },
+    { "RGBA8ToBGRA8_AVX2",       gl::supportsAVX2,  rx::LoadRGBA8ToBGRA8_AVX2,      rx::LoadRGBA8ToBGRA8,      4, 4, SOURCE_BYTES  },
+    { "RGBA4ToBGRA8_SSE2",       gl::supportsSSE2,  rx::LoadRGBA4ToBGRA8_SSE2,      rx::LoadRGBA4ToBGRA8,      2, 4, SOURCE_BYTES  },
+    { "RGBA4ToRGBA8_SSE2",       gl::supportsSSE2,  rx::LoadRGBA4ToRGBA8_SSE2,      rx::LoadRGBA4ToRGBA8,      2, 4, SOURCE_BYTES  },
+    { "RGB5A1ToBGRA8_SSE2",      gl::supportsSSE2,  rx::LoadRGB5A1ToBGRA8_SSE2,     rx::LoadRGB5A1ToBGRA8,     2, 4, SOURCE_BYTES  },
+    { "RGB5A1ToRGBA8_SSE2",      gl::supportsSSE2,  rx::LoadRGB5A1ToRGBA8_SSE2,     rx::LoadRGB5A1ToRGBA8,     2, 4, SOURCE_BYTES  },
+    { "A16FToRGBA16F_SSE2",      gl::supportsSSE2,  rx::LoadA16FToRGBA16F_SSE2,     rx::LoadA16FToRGBA16F,     2, 8, SOURCE_BYTES  },
+    { "L16FToRGBA16F_SSE2",      gl::supportsSSE2,  rx::LoadL16FToRGBA16F_SSE2,     rx::LoadL16FToRGBA16F,     2, 8, SOURCE_BYTES  },
+    { "LA16FToRGBA16F_SSE2",     gl::supportsSSE2,  rx::LoadLA16FToRGBA16F_SSE2,    rx::LoadLA16FToRGBA16F,    4, 8, SOURCE_BYTES  },
+    { "RGB16FToRG11B10F_SSE2",   gl::supportsSSE2,  rx::LoadRGB16FToRG11B10F_SSE2,  rx::LoadRGB16FToRG11B10F,  6, 4, SOURCE_BYTES  },
+    { "RGB16FToRGB9E5_SSE2",     gl::supportsSSE2,  rx::LoadRGB16FToRGB9E5_SSE2,    rx::LoadRGB16FToRGB9E5,    6, 4, SOURCE_BYTES  },
+    { "RGB32FToRGB9E5_SSE2",     gl::supportsSSE2,  rx::LoadRGB32FToRGB9E5_SSE2,    rx::LoadRGB32FToRGB9E5,   12, 4, SOURCE_FLOATS },
+    { "RGB32FToRGBA16F_SSE2",    gl::supportsSSE2,  rx::LoadRGB32FToRGBA16F_SSE2,   rx::LoadRGB32FToRGBA16F,  12, 8, SOURCE_FLOATS },
+};
+
+// Returns a float of random sign and mantissa with an exponent around the range of half floats,
+// or now and then a zero, an infinity or a NAN
+float RandomFloat()
+{
+    const float specials[] =
+    {
+        0.0f, -0.0f, std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::quiet_NaN(),
+    };
+
+    int choice = rand() % 64;
+    if (choice < static_cast<int>(ArraySize(specials)))
+    {
+        return specials[choice];
+    }
+
+    float mantissa = static_cast<float>(rand() % 0x1000000) / static_cast<float>(0x1000000) + 1.0f;
+    float value = ldexp(mantissa, rand() % 48 - 30);
+    return (rand() % 4 == 0) ? -value : value;
+}
+
+void FillSource(SourceData sourceData, std::vector<uint8_t> *input)
+{
+    if (sourceData == SOURCE_FLOATS)
+    {
+        for (size_t i = 0; i + sizeof(float) <= input->size(); i += sizeof(float))
+        {
+            float value = RandomFloat();
+            memcpy(&(*input)[i], &value, sizeof(float));
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < input->size(); i++)
+        {
+            (*input)[i] = static_cast<uint8_t>(rand());
+        }
+    }
+}
+
+class LoadImageTest : public testing::TestWithParam<LoadFunctionPair>
+{
+};
+
+// The vectorized loads must produce bit-exact copies of the scalar loads, including for widths
+// that leave a partial vector at the end of each row and for padded row and depth pitches.
+TEST_P(LoadImageTest, MatchesScalarLoad)
+{
+    const LoadFunctionPair &pair = GetParam();
+    ASSERT_TRUE(pair.supported()) << pair.name << " was not tested, the CPU lacks its instruction set";
+
+    const size_t sizes[][3] =
+    {
+        { 1, 1, 1 },
+        { 7, 3, 1 },
+        { 16, 16, 1 },
+        { 33, 17, 2 },
+        { 257, 5, 3 },
+    };
+
+    for (size_t sizeIndex = 0; sizeIndex < ArraySize(sizes); sizeIndex++)
+    {
+        size_t width = sizes[sizeIndex][0];
+        size_t height = sizes[sizeIndex][1];
+        size_t depth = sizes[sizeIndex][2];
+
+        // Float sources stay aligned to their components, as the GL unpack alignment guarantees
+        size_t padding = (pair.sourceData == SOURCE_FLOATS) ? sizeIndex * sizeof(float) : sizeIndex;
+        size_t inputRowPitch = width * pair.sourcePixelBytes + padding;
+        size_t inputDepthPitch = inputRowPitch * height + 2 * padding;
+        size_t outputRowPitch = width * pair.destPixelBytes + 4 * sizeIndex;
+        size_t outputDepthPitch = outputRowPitch * height;
+
+        std::vector<uint8_t> input(inputDepthPitch * depth);
+        FillSource(pair.sourceData, &input);
+
+        std::vector<uint8_t> expected(outputDepthPitch * depth, 0);
+        std::vector<uint8_t> actual(outputDepthPitch * depth, 0);
+
+        pair.scalarLoad(width, height, depth, &input[0], inputRowPitch, inputDepthPitch,
+                        &expected[0], outputRowPitch, outputDepthPitch);
+        pair.simdLoad(width, height, depth, &input[0], inputRowPitch, inputDepthPitch,
+                      &actual[0], outputRowPitch, outputDepthPitch);
+
+        EXPECT_EQ(expected, actual) << pair.name << " " << width << "x" << height << "x" << depth;
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(LoadFunctions, LoadImageTest, testing::ValuesIn(loadFunctionPairs));
+
+// Runs every half float through each component of the vectorized half float conversions
+TEST(LoadImageTest, HalfFloatConversionsMatchForEveryValue)
+{
+    ASSERT_TRUE(gl::supportsSSE2()) << "The SSE2 loads were not tested, the CPU lacks SSE2";
+
+    const size_t width = 0x10000;
+    std::vector<uint16_t> input(width * 3);
+    for (size_t component = 0; component < 3; component++)
+    {
+        for (size_t x = 0; x < width; x++)
+        {
+            input[x * 3 + component] = static_cast<uint16_t>(x);
+            input[x * 3 + (component + 1) % 3] = static_cast<uint16_t>(rand());
+            input[x * 3 + (component + 2) % 3] = static_cast<uint16_t>(rand());
+        }
+
+        const uint8_t *source = reinterpret_cast<const uint8_t*>(&input[0]);
+        std::vector<uint32_t> expected(width);
+        std::vector<uint32_t> actual(width);
+
+        rx::LoadRGB16FToRG11B10F(width, 1, 1, source, width * 6, width * 6, reinterpret_cast<uint8_t*>(&expected[0]), width * 4, width * 4);
+        rx::LoadRGB16FToRG11B10F_SSE2(width, 1, 1, source, width * 6, width * 6, reinterpret_cast<uint8_t*>(&actual[0]), width * 4, width * 4);
+        EXPECT_EQ(expected, actual) << "RGB16FToRG11B10F, component " << component;
+
+        rx::LoadRGB16FToRGB9E5(width, 1, 1, source, width * 6, width * 6, reinterpret_cast<uint8_t*>(&expected[0]), width * 4, width * 4);
+        rx::LoadRGB16FToRGB9E5_SSE2(width, 1, 1, source, width * 6, width * 6, reinterpret_cast<uint8_t*>(&actual[0]), width * 4, width * 4);
+        EXPECT_EQ(expected, actual) << "RGB16FToRGB9E5, component " << component;
+    }
+}
+
+// The RGB9E5 exponent comes from comparisons with precomputed thresholds and the mantissas from
+// rounding; check the values next to each threshold and next to each rounding boundary.
+TEST(LoadImageTest, RGB9E5MatchesAtBoundaries)
+{
+    ASSERT_TRUE(gl::supportsSSE2()) << "The SSE2 loads were not tested, the CPU lacks SSE2";
+
+    std::vector<float> values;
+    for (int exponent = -16; exponent <= 12; exponent++)
+    {
+        float threshold = gl::sharedExponentThreshold999E5(exponent);
+        values.push_back(threshold);
+        values.push_back(nextafterf(threshold, 0.0f));
+        values.push_back(nextafterf(threshold, std::numeric_limits<float>::infinity()));
+    }
+    for (int exponent = -30; exponent <= 16; exponent++)
+    {
+        for (int mantissa = 0; mantissa < 1024; mantissa += 37)
+        {
+            float boundary = ldexp(mantissa + 0.5f, exponent);
+            values.push_back(boundary);
+            values.push_back(nextafterf(boundary, 0.0f));
+            values.push_back(nextafterf(boundary, std::numeric_limits<float>::infinity()));
+        }
+    }
+
+    // Use each value as the largest component and as a smaller one
+    std::vector<float> input;
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        float other = values[rand() % values.size()];
+        float pixel[] = { values[i], other, other * 0.5f, other * 0.5f, values[i], other, other, other * 0.5f, values[i] };
+        input.insert(input.end(), pixel, pixel + ArraySize(pixel));
+    }
+
+    size_t width = input.size() / 3;
+    const uint8_t *source = reinterpret_cast<const uint8_t*>(&input[0]);
+    std::vector<uint32_t> expected(width);
+    std::vector<uint32_t> actual(width);
+
+    rx::LoadRGB32FToRGB9E5(width, 1, 1, source, width * 12, width * 12, reinterpret_cast<uint8_t*>(&expected[0]), width * 4, width * 4);
+    rx::LoadRGB32FToRGB9E5_SSE2(width, 1, 1, source, width * 12, width * 12, reinterpret_cast<uint8_t*>(&actual[0]), width * 4, width * 4);
+    EXPECT_EQ(expected, actual);
+}
+
+#endif // defined(ANGLE_X86_CPU)
+
+}
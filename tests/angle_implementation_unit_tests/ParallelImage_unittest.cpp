@@ -0,0 +1,144 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "gtest/gtest.h"
+#include "common/WorkerPool.h"
+#include "libGLESv2/renderer/copyimage.h"
+#include "libGLESv2/renderer/generatemip.h"
+#include "libGLESv2/renderer/loadimage.h"
+#include "libGLESv2/renderer/parallelimage.h"
+
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+
+void FillRandom(std::vector<uint8_t> *data)
+{
+    for (size_t i = 0; i < data->size(); i++)
+    {
+        (*data)[i] = static_cast<uint8_t>(rand());
+    }
+}
+
+class ParallelImageTest : public testing::Test
+{
+  protected:
+    ParallelImageTest()
+        : mPool(4)
+    {
+    }
+
+    // Loads the image inline and through the pool and checks both outputs are identical
+    void expectLoadMatches(LoadImageFunction loadFunction, size_t blockHeight, size_t inputBlockBytes,
+                           size_t outputBlockBytes, size_t width, size_t height, size_t depth)
+    {
+        size_t blockRows = (height + blockHeight - 1) / blockHeight;
+        size_t inputRowPitch = width * inputBlockBytes + 3;
+        size_t inputDepthPitch = inputRowPitch * blockRows;
+        size_t outputRowPitch = width * outputBlockBytes + 16;
+        size_t outputDepthPitch = outputRowPitch * blockRows;
+
+        std::vector<uint8_t> input(inputDepthPitch * depth);
+        FillRandom(&input);
+
+        std::vector<uint8_t> expected(outputDepthPitch * depth, 0);
+        std::vector<uint8_t> actual(outputDepthPitch * depth, 0);
+
+        loadFunction(width, height, depth, &input[0], inputRowPitch, inputDepthPitch,
+                     &expected[0], outputRowPitch, outputDepthPitch);
+        rx::LoadImageParallel(&mPool, loadFunction, blockHeight, width, height, depth,
+                              &input[0], inputRowPitch, inputDepthPitch,
+                              &actual[0], outputRowPitch, outputDepthPitch);
+
+        EXPECT_EQ(expected, actual) << width << "x" << height << "x" << depth;
+    }
+
+    void expectMipMatches(size_t width, size_t height, size_t depth)
+    {
+        size_t sourceRowPitch = width * 4;
+        size_t sourceDepthPitch = sourceRowPitch * height;
+        size_t destRowPitch = std::max<size_t>(1, width >> 1) * 4;
+        size_t destDepthPitch = destRowPitch * std::max<size_t>(1, height >> 1);
+        size_t destDepth = std::max<size_t>(1, depth >> 1);
+
+        std::vector<uint8_t> source(sourceDepthPitch * depth);
+        FillRandom(&source);
+
+        std::vector<uint8_t> expected(destDepthPitch * destDepth, 0);
+        std::vector<uint8_t> actual(destDepthPitch * destDepth, 0);
+
+        rx::GenerateMip<rx::R8G8B8A8>(width, height, depth, &source[0], sourceRowPitch, sourceDepthPitch,
+                                      &expected[0], destRowPitch, destDepthPitch);
+        rx::GenerateMipParallel(&mPool, rx::GenerateMip<rx::R8G8B8A8>, width, height, depth,
+                                &source[0], sourceRowPitch, sourceDepthPitch,
+                                &actual[0], destRowPitch, destDepthPitch);
+
+        EXPECT_EQ(expected, actual) << width << "x" << height << "x" << depth;
+    }
+
+    gl::WorkerPool mPool;
+};
+
+TEST_F(ParallelImageTest, LoadRows)
+{
+    expectLoadMatches(rx::LoadRGB8ToBGRX8, 1, 3, 4, 1024, 701, 1);
+    expectLoadMatches(rx::LoadRGB8ToBGRX8, 1, 3, 4, 3, 5, 1);
+}
+
+TEST_F(ParallelImageTest, LoadSlices)
+{
+    expectLoadMatches(rx::LoadRGB8ToBGRX8, 1, 3, 4, 256, 200, 7);
+    expectLoadMatches(rx::LoadRGB8ToBGRX8, 1, 3, 4, 64, 5, 300);
+}
+
+TEST_F(ParallelImageTest, LoadCompressedBlockRows)
+{
+    // Sizes are in blocks for the pitches; the height is not a multiple of the block height
+    expectLoadMatches(rx::LoadCompressedToNative<4, 4, 8>, 4, 8, 8, 1024, 1023, 1);
+    expectLoadMatches(rx::LoadCompressedToNative<4, 4, 16>, 4, 16, 16, 256, 254, 3);
+}
+
+TEST_F(ParallelImageTest, GenerateMip)
+{
+    expectMipMatches(1024, 1024, 1);
+    expectMipMatches(1023, 1021, 1);
+    expectMipMatches(1, 4096, 1);
+    expectMipMatches(130, 66, 9);
+    expectMipMatches(258, 130, 17);
+    expectMipMatches(2048, 1, 256);
+    expectMipMatches(5, 3, 1);
+}
+
+TEST_F(ParallelImageTest, CopyPixelsFlipped)
+{
+    const size_t width = 700;
+    const size_t height = 500;
+    const ptrdiff_t rowPitch = width * 4;
+
+    std::vector<uint8_t> source(rowPitch * height);
+    FillRandom(&source);
+
+    // Read the rows bottom-up, as packPixels does for reverse row order
+    const uint8_t *lastRow = &source[0] + rowPitch * (height - 1);
+
+    std::vector<uint8_t> fastExpected(source.size(), 0);
+    std::vector<uint8_t> fastActual(source.size(), 0);
+    rx::CopyPixelsParallel(NULL, rx::CopyBGRA8ToRGBA8, NULL, NULL, width, height,
+                           lastRow, -rowPitch, 4, &fastExpected[0], rowPitch, 4);
+    rx::CopyPixelsParallel(&mPool, rx::CopyBGRA8ToRGBA8, NULL, NULL, width, height,
+                           lastRow, -rowPitch, 4, &fastActual[0], rowPitch, 4);
+    EXPECT_EQ(fastExpected, fastActual);
+
+    // The generic path goes through a float color and should give back the source pixels
+    std::vector<uint8_t> genericActual(source.size(), 0);
+    rx::CopyPixelsParallel(&mPool, NULL, rx::ReadColor<rx::R8G8B8A8, GLfloat>, rx::WriteColor<rx::R8G8B8A8, GLfloat>,
+                           width, height, &source[0], rowPitch, 4, &genericActual[0], rowPitch, 4);
+    EXPECT_EQ(source, genericActual);
+}
+
+}
@@ -0,0 +1,227 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "gtest/gtest.h"
+#include "libGLESv2/renderer/ProgramNameIndex.h"
+#include "libGLESv2/ProgramBinary.h"
+#include "libGLESv2/Uniform.h"
+
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// The linear searches the name index replaces, kept as the reference behaviour.
+unsigned int ParseAndStripArrayIndex(std::string *name)
+{
+    unsigned int subscript = GL_INVALID_INDEX;
+
+    size_t open = name->find_last_of('[');
+    size_t close = name->find_last_of(']');
+    if (open != std::string::npos && close == name->length() - 1)
+    {
+        subscript = atoi(name->substr(open + 1).c_str());
+        name->erase(open);
+    }
+
+    return subscript;
+}
+
+class ProgramNameIndexTest : public testing::Test
+{
+  protected:
+    virtual void TearDown()
+    {
+        SafeDeleteContainer(mUniforms);
+        SafeDeleteContainer(mUniformBlocks);
+    }
+
+    void addUniform(const std::string &name, unsigned int arraySize, bool hasLocations = true)
+    {
+        const unsigned int uniformIndex = mUniforms.size();
+        mUniforms.push_back(new gl::LinkedUniform(GL_FLOAT_VEC4, GL_MEDIUM_FLOAT, name, arraySize, -1,
+                                                  sh::BlockMemberInfo::getDefaultBlockInfo()));
+
+        if (hasLocations)
+        {
+            for (unsigned int element = 0; element < mUniforms.back()->elementCount(); element++)
+            {
+                mUniformIndex.push_back(gl::VariableLocation(name, element, uniformIndex));
+            }
+        }
+    }
+
+    void addUniformBlock(const std::string &name, unsigned int arraySize)
+    {
+        if (arraySize == 0)
+        {
+            mUniformBlocks.push_back(new gl::UniformBlock(name, GL_INVALID_INDEX, 16));
+        }
+        for (unsigned int element = 0; element < arraySize; element++)
+        {
+            mUniformBlocks.push_back(new gl::UniformBlock(name, element, 16));
+        }
+    }
+
+    GLint linearUniformLocation(std::string name) const
+    {
+        unsigned int subscript = ParseAndStripArrayIndex(&name);
+        for (unsigned int location = 0; location < mUniformIndex.size(); location++)
+        {
+            if (mUniformIndex[location].name == name)
+            {
+                const bool isArray = mUniforms[mUniformIndex[location].index]->isArray();
+                if ((isArray && mUniformIndex[location].element == subscript) || subscript == GL_INVALID_INDEX)
+                {
+                    return location;
+                }
+            }
+        }
+        return -1;
+    }
+
+    GLuint linearUniformIndex(std::string name) const
+    {
+        unsigned int subscript = ParseAndStripArrayIndex(&name);
+        if (subscript != 0 && subscript != GL_INVALID_INDEX)
+        {
+            return GL_INVALID_INDEX;
+        }
+        for (unsigned int index = 0; index < mUniforms.size(); index++)
+        {
+            if (mUniforms[index]->name == name && (mUniforms[index]->isArray() || subscript == GL_INVALID_INDEX))
+            {
+                return index;
+            }
+        }
+        return GL_INVALID_INDEX;
+    }
+
+    GLuint linearUniformBlockIndex(std::string name) const
+    {
+        unsigned int subscript = ParseAndStripArrayIndex(&name);
+        for (unsigned int blockIndex = 0; blockIndex < mUniformBlocks.size(); blockIndex++)
+        {
+            const gl::UniformBlock &uniformBlock = *mUniformBlocks[blockIndex];
+            if (uniformBlock.name == name)
+            {
+                const bool arrayElementZero = (subscript == GL_INVALID_INDEX && uniformBlock.elementIndex == 0);
+                if (subscript == uniformBlock.elementIndex || arrayElementZero)
+                {
+                    return blockIndex;
+                }
+            }
+        }
+        return GL_INVALID_INDEX;
+    }
+
+    void expectMatchesLinearSearch(const std::string &name)
+    {
+        EXPECT_EQ(linearUniformLocation(name), mIndex.getUniformLocation(name.c_str())) << name;
+        EXPECT_EQ(linearUniformIndex(name), mIndex.getUniformIndex(name.c_str())) << name;
+        EXPECT_EQ(linearUniformBlockIndex(name), mIndex.getUniformBlockIndex(name.c_str())) << name;
+    }
+
+    std::vector<gl::LinkedUniform*> mUniforms;
+    std::vector<gl::VariableLocation> mUniformIndex;
+    std::vector<gl::UniformBlock*> mUniformBlocks;
+    rx::ProgramNameIndex mIndex;
+};
+
+TEST_F(ProgramNameIndexTest, EmptyIndex)
+{
+    EXPECT_EQ(-1, mIndex.getUniformLocation("u"));
+    EXPECT_EQ(GL_INVALID_INDEX, mIndex.getUniformIndex("u"));
+    EXPECT_EQ(GL_INVALID_INDEX, mIndex.getUniformBlockIndex("b"));
+}
+
+TEST_F(ProgramNameIndexTest, ResolvesArrayElements)
+{
+    addUniform("scalar", 0);
+    addUniform("array", 5);
+    addUniform("s[1].field", 3);
+    addUniform("gl_DepthRange.near", 0, false);
+    addUniformBlock("block", 0);
+    addUniformBlock("blockArray", 3);
+    addUniformBlock("tail", 2);
+    mIndex.build(mUniforms, mUniformIndex, mUniformBlocks);
+
+    EXPECT_EQ(0, mIndex.getUniformLocation("scalar"));
+    EXPECT_EQ(1, mIndex.getUniformLocation("array"));
+    EXPECT_EQ(4, mIndex.getUniformLocation("array[3]"));
+    EXPECT_EQ(-1, mIndex.getUniformLocation("array[5]"));
+    EXPECT_EQ(7, mIndex.getUniformLocation("s[1].field[1]"));
+    EXPECT_EQ(-1, mIndex.getUniformLocation("gl_DepthRange.near"));
+    EXPECT_EQ(3u, mIndex.getUniformIndex("gl_DepthRange.near"));
+    EXPECT_EQ(1u, mIndex.getUniformIndex("array[0]"));
+    EXPECT_EQ(GL_INVALID_INDEX, mIndex.getUniformIndex("array[1]"));
+    EXPECT_EQ(3u, mIndex.getUniformBlockIndex("blockArray[2]"));
+    EXPECT_EQ(GL_INVALID_INDEX, mIndex.getUniformBlockIndex("blockArray[3]"));
+
+    const char *names[] =
+    {
+        "", "scalar", "scalar[0]", "scalar[1]", "array", "array[0]", "array[4]", "array[5]", "array[-1]",
+        "array[]", "array[ 2]", "array[2", "array]", "arr", "arrayy", "s", "s[1]", "s[1].field", "s[1].field[2]",
+        "s[0].field", "gl_DepthRange.near", "gl_DepthRange.near[0]", "block", "block[0]", "blockArray",
+        "blockArray[0]", "blockArray[1]", "blockArray[3]", "blockArray[4]", "tail[0]", "tail[1]", "tail[2]",
+    };
+    for (size_t nameIndex = 0; nameIndex < ArraySize(names); nameIndex++)
+    {
+        expectMatchesLinearSearch(names[nameIndex]);
+    }
+
+    mIndex.clear();
+    EXPECT_EQ(-1, mIndex.getUniformLocation("scalar"));
+}
+
+TEST_F(ProgramNameIndexTest, ManyUniforms)
+{
+    for (int uniform = 0; uniform < 400; uniform++)
+    {
+        std::ostringstream name;
+        name << "u" << uniform;
+        addUniform(name.str(), uniform % 4);
+    }
+    for (int block = 0; block < 20; block++)
+    {
+        std::ostringstream name;
+        name << "b" << block;
+        addUniformBlock(name.str(), block % 3);
+    }
+    mIndex.build(mUniforms, mUniformIndex, mUniformBlocks);
+
+    for (int uniform = 0; uniform < 401; uniform++)
+    {
+        for (int element = -1; element < 4; element++)
+        {
+            std::ostringstream name;
+            name << "u" << uniform;
+            if (element >= 0)
+            {
+                name << "[" << element << "]";
+            }
+            expectMatchesLinearSearch(name.str());
+        }
+    }
+    for (int block = 0; block < 21; block++)
+    {
+        for (int element = -1; element < 3; element++)
+        {
+            std::ostringstream name;
+            name << "b" << block;
+            if (element >= 0)
+            {
+                name << "[" << element << "]";
+            }
+            expectMatchesLinearSearch(name.str());
+        }
+    }
+}
+
+}
@@ -0,0 +1,151 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "gtest/gtest.h"
+#include "libGLESv2/ResourceMap.h"
+
+#include <map>
+#include <vector>
+
+namespace
+{
+
+struct Resource
+{
+    explicit Resource(GLuint handle) : handle(handle) {}
+
+    GLuint handle;
+};
+
+typedef gl::ResourceMap<Resource> ResourceMap;
+
+TEST(ResourceMapTest, GeneratedAndBoundHandles)
+{
+    ResourceMap map;
+    EXPECT_TRUE(map.empty());
+
+    // A generated handle is in the map before it has an object
+    map.assign(1, NULL);
+    EXPECT_TRUE(map.contains(1));
+    EXPECT_EQ(NULL, map.query(1));
+    EXPECT_FALSE(map.contains(2));
+    EXPECT_EQ(NULL, map.query(2));
+
+    Resource resource(1);
+    map.assign(1, &resource);
+    EXPECT_EQ(&resource, map.query(1));
+    EXPECT_EQ(1u, map.size());
+
+    map.erase(1);
+    EXPECT_FALSE(map.contains(1));
+    EXPECT_EQ(NULL, map.query(1));
+    EXPECT_TRUE(map.empty());
+}
+
+TEST(ResourceMapTest, ApplicationChosenNames)
+{
+    ResourceMap map;
+
+    // Names far apart, including ones too large for the vector
+    const GLuint handles[] = { 0, 3, 0x3FFF, 0x4001, 0x12345, 0xFFFFFFFE };
+    std::vector<Resource> resources;
+    for (size_t i = 0; i < ArraySize(handles); i++)
+    {
+        resources.push_back(Resource(handles[i]));
+    }
+
+    for (size_t i = 0; i < ArraySize(handles); i++)
+    {
+        map.assign(handles[i], &resources[i]);
+    }
+    EXPECT_EQ(ArraySize(handles), map.size());
+
+    for (size_t i = 0; i < ArraySize(handles); i++)
+    {
+        EXPECT_TRUE(map.contains(handles[i])) << handles[i];
+        EXPECT_EQ(&resources[i], map.query(handles[i])) << handles[i];
+        EXPECT_FALSE(map.contains(handles[i] + 1)) << handles[i];
+    }
+
+    for (size_t i = 0; i < ArraySize(handles); i++)
+    {
+        map.erase(handles[i]);
+        EXPECT_FALSE(map.contains(handles[i])) << handles[i];
+        EXPECT_EQ(ArraySize(handles) - i - 1, map.size());
+    }
+    EXPECT_TRUE(map.empty());
+}
+
+TEST(ResourceMapTest, Iteration)
+{
+    ResourceMap map;
+    std::map<GLuint, Resource*> expected;
+
+    std::vector<Resource> resources;
+    for (GLuint handle = 0; handle < 100; handle++)
+    {
+        resources.push_back(Resource(handle * 331));
+    }
+
+    for (size_t i = 0; i < resources.size(); i++)
+    {
+        GLuint handle = resources[i].handle;
+        Resource *object = (i % 3 == 0) ? NULL : &resources[i];
+        map.assign(handle, object);
+        expected[handle] = object;
+    }
+
+    for (size_t i = 0; i < resources.size(); i += 7)
+    {
+        map.erase(resources[i].handle);
+        expected.erase(resources[i].handle);
+    }
+
+    std::map<GLuint, Resource*> visited;
+    for (ResourceMap::const_iterator iter = map.begin(); iter != map.end(); iter++)
+    {
+        EXPECT_TRUE(visited.insert(*iter).second) << iter->first;
+    }
+    EXPECT_EQ(expected, visited);
+}
+
+TEST(ResourceMapTest, DeleteFirstUntilEmpty)
+{
+    ResourceMap map;
+
+    std::vector<Resource> resources;
+    for (GLuint handle = 1; handle <= 100; handle++)
+    {
+        resources.push_back(Resource(handle));
+    }
+    resources.push_back(Resource(0x80000000));
+
+    for (size_t i = 0; i < resources.size(); i++)
+    {
+        map.assign(resources[i].handle, &resources[i]);
+    }
+
+    size_t deleted = 0;
+    while (!map.empty())
+    {
+        GLuint handle = map.begin()->first;
+        EXPECT_EQ(&resources[deleted], map.begin()->second);
+        map.erase(handle);
+        deleted++;
+
+        // A handle generated again while deleting is still visited
+        if (deleted == 50)
+        {
+            map.assign(resources[0].handle, &resources[0]);
+            EXPECT_EQ(resources[0].handle, map.begin()->first);
+            map.erase(resources[0].handle);
+        }
+    }
+    EXPECT_EQ(resources.size(), deleted);
+    EXPECT_TRUE(map.begin() == map.end());
+}
+
+}
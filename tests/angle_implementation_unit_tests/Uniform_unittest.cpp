@@ -0,0 +1,109 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "gtest/gtest.h"
+#include "libGLESv2/Uniform.h"
+
+#include <cstring>
+#include <vector>
+
+namespace
+{
+
+gl::LinkedUniform *CreateUniform(GLenum type, unsigned int arraySize)
+{
+    return new gl::LinkedUniform(type, GL_HIGH_FLOAT, "u", arraySize, -1, sh::BlockMemberInfo::getDefaultBlockInfo());
+}
+
+std::vector<GLfloat> MakeRows(unsigned int rowCount, GLfloat seed)
+{
+    std::vector<GLfloat> rows(rowCount * 4);
+    for (size_t i = 0; i < rows.size(); i++)
+    {
+        rows[i] = seed + static_cast<GLfloat>(i);
+    }
+    return rows;
+}
+
+void ExpectDirtyRows(const gl::LinkedUniform &uniform, const unsigned int *spans, size_t spanCount)
+{
+    ASSERT_EQ(spanCount, uniform.dirtyRows.size());
+    for (size_t spanIndex = 0; spanIndex < spanCount; spanIndex++)
+    {
+        EXPECT_EQ(spans[spanIndex * 2], uniform.dirtyRows[spanIndex].start);
+        EXPECT_EQ(spans[spanIndex * 2 + 1], uniform.dirtyRows[spanIndex].end);
+    }
+    EXPECT_EQ(spanCount > 0, uniform.dirty);
+}
+
+TEST(UniformTest, NewUniformIsDirty)
+{
+    gl::LinkedUniform *uniform = CreateUniform(GL_FLOAT_MAT4, 3);
+    EXPECT_EQ(12u, uniform->rowCount());
+
+    const unsigned int spans[] = { 0, 12 };
+    ExpectDirtyRows(*uniform, spans, 1);
+
+    uniform->clearDirtyRows();
+    ExpectDirtyRows(*uniform, NULL, 0);
+
+    SafeDelete(uniform);
+}
+
+TEST(UniformTest, WriteRowsRecordsChangedSpans)
+{
+    gl::LinkedUniform *uniform = CreateUniform(GL_FLOAT_VEC4, 64);
+    uniform->clearDirtyRows();
+
+    std::vector<GLfloat> rows = MakeRows(64, 1.0f);
+    EXPECT_TRUE(uniform->writeRows(0, &rows[0], 64));
+    EXPECT_EQ(0, memcmp(uniform->data, &rows[0], rows.size() * sizeof(GLfloat)));
+    uniform->clearDirtyRows();
+
+    // Writing the same values again changes nothing
+    EXPECT_FALSE(uniform->writeRows(0, &rows[0], 64));
+    EXPECT_FALSE(uniform->dirty);
+
+    // Change a few scattered rows through one write
+    rows[4 * 3] = -1.0f;
+    rows[4 * 4 + 2] = -1.0f;
+    rows[4 * 10 + 3] = -1.0f;
+    rows[4 * 63] = -1.0f;
+    EXPECT_TRUE(uniform->writeRows(0, &rows[0], 64));
+    EXPECT_EQ(0, memcmp(uniform->data, &rows[0], rows.size() * sizeof(GLfloat)));
+
+    const unsigned int spans[] = { 3, 5, 10, 11, 63, 64 };
+    ExpectDirtyRows(*uniform, spans, 3);
+
+    SafeDelete(uniform);
+}
+
+TEST(UniformTest, MarkRowsDirtyMergesSpans)
+{
+    gl::LinkedUniform *uniform = CreateUniform(GL_FLOAT_VEC4, 100);
+    uniform->clearDirtyRows();
+
+    uniform->markRowsDirty(20, 30);
+    uniform->markRowsDirty(50, 60);
+    uniform->markRowsDirty(0, 5);
+    const unsigned int separateSpans[] = { 0, 5, 20, 30, 50, 60 };
+    ExpectDirtyRows(*uniform, separateSpans, 3);
+
+    // Touching spans are joined, and a span covering several swallows them
+    uniform->markRowsDirty(5, 8);
+    uniform->markRowsDirty(25, 55);
+    const unsigned int mergedSpans[] = { 0, 8, 20, 60 };
+    ExpectDirtyRows(*uniform, mergedSpans, 2);
+
+    uniform->markRowsDirty(70, 71);
+    uniform->markRowsDirty(8, 20);
+    const unsigned int finalSpans[] = { 0, 60, 70, 71 };
+    ExpectDirtyRows(*uniform, finalSpans, 2);
+
+    SafeDelete(uniform);
+}
+
+}
@@ -0,0 +1,131 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "gtest/gtest.h"
+#include "common/WorkerPool.h"
+
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+struct RangeRecord
+{
+    std::vector<int> visits;
+    std::vector<size_t> rangeSizes;
+    std::thread::id threadId;
+    std::mutex mutex;
+};
+
+void RecordRange(size_t begin, size_t end, void *userData)
+{
+    RangeRecord *record = static_cast<RangeRecord*>(userData);
+
+    // Ranges are disjoint, so the visit counts can be written without the lock
+    for (size_t i = begin; i < end; i++)
+    {
+        record->visits[i]++;
+    }
+
+    std::lock_guard<std::mutex> lock(record->mutex);
+    record->rangeSizes.push_back(end - begin);
+    record->threadId = std::this_thread::get_id();
+}
+
+TEST(WorkerPoolTest, SingleThreadRunsInline)
+{
+    gl::WorkerPool pool(1);
+    EXPECT_EQ(1u, pool.getThreadCount());
+
+    RangeRecord record;
+    record.visits.resize(1000, 0);
+    pool.parallelFor(record.visits.size(), 1, RecordRange, &record);
+
+    ASSERT_EQ(1u, record.rangeSizes.size());
+    EXPECT_EQ(1000u, record.rangeSizes[0]);
+    EXPECT_EQ(std::this_thread::get_id(), record.threadId);
+}
+
+TEST(WorkerPoolTest, VisitsEveryItemOnce)
+{
+    gl::WorkerPool pool(4);
+    EXPECT_EQ(4u, pool.getThreadCount());
+
+    const size_t counts[] = { 0, 1, 3, 4, 7, 100, 10007 };
+    for (size_t countIndex = 0; countIndex < ArraySize(counts); countIndex++)
+    {
+        // Repeat to give late-waking workers a chance to pick up a finished job
+        for (int iteration = 0; iteration < 50; iteration++)
+        {
+            RangeRecord record;
+            record.visits.resize(counts[countIndex], 0);
+            pool.parallelFor(record.visits.size(), 1, RecordRange, &record);
+
+            for (size_t i = 0; i < record.visits.size(); i++)
+            {
+                ASSERT_EQ(1, record.visits[i]) << "count " << counts[countIndex] << " item " << i;
+            }
+            EXPECT_LE(record.rangeSizes.size(), pool.getThreadCount());
+        }
+    }
+}
+
+TEST(WorkerPoolTest, RespectsMinimumRangeSize)
+{
+    gl::WorkerPool pool(4);
+
+    const size_t counts[] = { 7, 59, 60, 61, 121, 1000 };
+    for (size_t countIndex = 0; countIndex < ArraySize(counts); countIndex++)
+    {
+        RangeRecord record;
+        record.visits.resize(counts[countIndex], 0);
+        pool.parallelFor(record.visits.size(), 60, RecordRange, &record);
+
+        ASSERT_FALSE(record.rangeSizes.empty());
+        if (record.rangeSizes.size() > 1)
+        {
+            for (size_t i = 0; i < record.rangeSizes.size(); i++)
+            {
+                EXPECT_GE(record.rangeSizes[i], 60u) << "count " << counts[countIndex];
+            }
+        }
+    }
+}
+
+TEST(WorkerPoolTest, SubmitFromSeveralThreads)
+{
+    gl::WorkerPool pool(3);
+
+    std::vector<RangeRecord> records(4);
+    std::vector<std::thread> submitters;
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        records[i].visits.resize(5000, 0);
+        submitters.push_back(std::thread([&pool, &records, i]()
+        {
+            for (int iteration = 0; iteration < 20; iteration++)
+            {
+                pool.parallelFor(records[i].visits.size(), 16, RecordRange, &records[i]);
+            }
+        }));
+    }
+
+    for (size_t i = 0; i < submitters.size(); i++)
+    {
+        submitters[i].join();
+    }
+
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        for (size_t item = 0; item < records[i].visits.size(); item++)
+        {
+            ASSERT_EQ(20, records[i].visits[item]);
+        }
+    }
+}
+
+}
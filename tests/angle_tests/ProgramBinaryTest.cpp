@@ -153,3 +153,43 @@ TYPED_TEST(ProgramBinaryTest, SaveAndLoadBinary)
         glDeleteProgram(program2);
     }
 }
+
+// This tests that a loaded program reports the same length and saves the same bytes as the
+// program it was saved from.
+TYPED_TEST(ProgramBinaryTest, ResaveLoadedBinary)
+{
+    GLint programLength = 0;
+    glGetProgramiv(mProgram, GL_PROGRAM_BINARY_LENGTH_OES, &programLength);
+    ASSERT_GT(programLength, 0);
+
+    GLenum binaryFormat = 0;
+    std::vector<uint8_t> binary(programLength);
+    glGetProgramBinaryOES(mProgram, programLength, NULL, &binaryFormat, binary.data());
+    EXPECT_GL_NO_ERROR();
+
+    // A buffer one byte too small fails without writing anything
+    GLint writtenLength = -1;
+    std::vector<uint8_t> smallBinary(programLength - 1);
+    glGetProgramBinaryOES(mProgram, programLength - 1, &writtenLength, &binaryFormat, smallBinary.data());
+    EXPECT_GL_ERROR(GL_INVALID_OPERATION);
+
+    GLuint program2 = glCreateProgram();
+    glProgramBinaryOES(program2, binaryFormat, binary.data(), programLength);
+    EXPECT_GL_NO_ERROR();
+
+    GLint linkStatus = 0;
+    glGetProgramiv(program2, GL_LINK_STATUS, &linkStatus);
+    EXPECT_EQ(GL_TRUE, linkStatus);
+
+    GLint program2Length = 0;
+    glGetProgramiv(program2, GL_PROGRAM_BINARY_LENGTH_OES, &program2Length);
+    EXPECT_EQ(programLength, program2Length);
+
+    std::vector<uint8_t> binary2(program2Length);
+    glGetProgramBinaryOES(program2, program2Length, &writtenLength, &binaryFormat, binary2.data());
+    EXPECT_GL_NO_ERROR();
+    EXPECT_EQ(program2Length, writtenLength);
+    EXPECT_EQ(binary, binary2);
+
+    glDeleteProgram(program2);
+}
@@ -0,0 +1,255 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// BatchCompile_test.cpp:
+//   Tests that ShCompileBatch gives the same results as compiling the same
+//   shaders one after the other with ShCompile.
+//
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+
+#include <sstream>
+
+namespace
+{
+
+const int CompileOptions = SH_OBJECT_CODE | SH_VARIABLES;
+
+struct CompilerConfig
+{
+    sh::GLenum type;
+    ShShaderSpec spec;
+    ShShaderOutput output;
+};
+
+const CompilerConfig CompilerConfigs[] =
+{
+    { GL_VERTEX_SHADER, SH_GLES2_SPEC, SH_GLSL_OUTPUT },
+    { GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_ESSL_OUTPUT },
+    { GL_VERTEX_SHADER, SH_WEBGL_SPEC, SH_HLSL9_OUTPUT },
+    { GL_FRAGMENT_SHADER, SH_WEBGL_SPEC, SH_HLSL9_OUTPUT },
+    { GL_VERTEX_SHADER, SH_GLES3_SPEC, SH_HLSL11_OUTPUT },
+    { GL_FRAGMENT_SHADER, SH_GLES3_SPEC, SH_HLSL11_OUTPUT },
+};
+
+struct CompileResult
+{
+    bool success;
+    std::string infoLog;
+    std::string objectCode;
+    std::vector<sh::Uniform> uniforms;
+};
+
+}
+
+class BatchCompileTest : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        ShInitBuiltInResources(&mResources);
+        mResources.MaxDrawBuffers = 4;
+        mResources.OES_standard_derivatives = 1;
+    }
+
+    virtual void TearDown()
+    {
+        destroyCompilers();
+    }
+
+    // Builds shaders for every compiler configuration, with a few that fail to compile.
+    void buildCorpus(size_t shadersPerConfig)
+    {
+        const size_t configCount = sizeof(CompilerConfigs) / sizeof(CompilerConfigs[0]);
+        for (size_t configIndex = 0; configIndex < configCount; configIndex++)
+        {
+            const CompilerConfig &config = CompilerConfigs[configIndex];
+            bool essl3 = (config.spec == SH_GLES3_SPEC);
+            bool vertex = (config.type == GL_VERTEX_SHADER);
+
+            for (size_t shaderIndex = 0; shaderIndex < shadersPerConfig; shaderIndex++)
+            {
+                std::ostringstream stream;
+                if (essl3)
+                {
+                    stream << "#version 300 es\n";
+                }
+                stream << "precision mediump float;\n"
+                          "uniform vec4 u" << shaderIndex << "[" << (shaderIndex % 7 + 1) << "];\n"
+                          "struct S { vec4 v; float f[" << (shaderIndex % 3 + 1) << "]; };\n"
+                          "uniform S s;\n";
+
+                if (vertex)
+                {
+                    stream << (essl3 ? "in" : "attribute") << " vec4 position;\n"
+                           << (essl3 ? "out" : "varying") << " vec4 color;\n";
+                }
+                else
+                {
+                    stream << "uniform sampler2D tex;\n"
+                           << (essl3 ? "in" : "varying") << " vec4 color;\n";
+                    if (essl3)
+                    {
+                        stream << "out vec4 fragColor;\n";
+                    }
+                }
+
+                stream << "vec4 f" << shaderIndex << "(vec4 a, int n) {\n"
+                          "    vec4 r = a;\n"
+                          "    for (int i = 0; i < " << (shaderIndex % 5 + 1) << "; i++) {\n"
+                          "        r = r * s.v + u" << shaderIndex << "[0] * float(i);\n"
+                          "        if (r.x > s.f[0]) { r = normalize(r); }\n"
+                          "    }\n"
+                          "    return r;\n"
+                          "}\n"
+                          "void main() {\n";
+
+                // Every seventh shader uses an undeclared variable
+                const char *operand = (shaderIndex % 7 == 6 ? "undeclared" : "color");
+                if (vertex)
+                {
+                    stream << "    color = f" << shaderIndex << "(position, 2);\n"
+                              "    gl_Position = position * " << operand << ";\n";
+                }
+                else
+                {
+                    const char *sample = (essl3 ? "texture" : "texture2D");
+                    stream << "    vec4 c = f" << shaderIndex << "(" << operand << ", 3) * "
+                           << sample << "(tex, color.xy);\n"
+                           << (essl3 ? "    fragColor" : "    gl_FragColor") << " = c;\n";
+                }
+                stream << "}\n";
+
+                mSources.push_back(stream.str());
+                mConfigIndices.push_back(configIndex);
+            }
+        }
+    }
+
+    void createCompilers()
+    {
+        destroyCompilers();
+        for (size_t shaderIndex = 0; shaderIndex < mSources.size(); shaderIndex++)
+        {
+            const CompilerConfig &config = CompilerConfigs[mConfigIndices[shaderIndex]];
+            ShHandle compiler = ShConstructCompiler(config.type, config.spec, config.output, &mResources);
+            ASSERT_TRUE(compiler != NULL);
+            mCompilers.push_back(compiler);
+        }
+    }
+
+    void destroyCompilers()
+    {
+        for (size_t index = 0; index < mCompilers.size(); index++)
+        {
+            ShDestruct(mCompilers[index]);
+        }
+        mCompilers.clear();
+    }
+
+    std::vector<ShCompileJob> makeJobs()
+    {
+        mSourcePointers.resize(mSources.size());
+        std::vector<ShCompileJob> jobs(mSources.size());
+        for (size_t shaderIndex = 0; shaderIndex < mSources.size(); shaderIndex++)
+        {
+            mSourcePointers[shaderIndex] = mSources[shaderIndex].c_str();
+
+            ShCompileJob &job = jobs[shaderIndex];
+            job.handle = mCompilers[shaderIndex];
+            job.shaderStrings = &mSourcePointers[shaderIndex];
+            job.numStrings = 1;
+            job.compileOptions = CompileOptions;
+            job.success = false;
+        }
+        return jobs;
+    }
+
+    std::vector<CompileResult> compileSerially()
+    {
+        createCompilers();
+
+        std::vector<CompileResult> results(mSources.size());
+        for (size_t shaderIndex = 0; shaderIndex < mSources.size(); shaderIndex++)
+        {
+            const char *source = mSources[shaderIndex].c_str();
+            results[shaderIndex].success = ShCompile(mCompilers[shaderIndex], &source, 1, CompileOptions);
+            getResults(shaderIndex, &results[shaderIndex]);
+        }
+        return results;
+    }
+
+    void getResults(size_t shaderIndex, CompileResult *result)
+    {
+        ShHandle compiler = mCompilers[shaderIndex];
+        result->infoLog = ShGetInfoLog(compiler);
+        result->objectCode = ShGetObjectCode(compiler);
+        result->uniforms = *ShGetUniforms(compiler);
+    }
+
+    ShBuiltInResources mResources;
+    std::vector<std::string> mSources;
+    std::vector<size_t> mConfigIndices;
+    std::vector<const char *> mSourcePointers;
+    std::vector<ShHandle> mCompilers;
+};
+
+TEST_F(BatchCompileTest, EmptyBatch)
+{
+    EXPECT_TRUE(ShCompileBatch(NULL, 0, 0));
+}
+
+TEST_F(BatchCompileTest, RejectsSharedHandles)
+{
+    buildCorpus(2);
+    createCompilers();
+
+    std::vector<ShCompileJob> jobs = makeJobs();
+    jobs[1].handle = jobs[0].handle;
+    EXPECT_FALSE(ShCompileBatch(&jobs[0], jobs.size(), 0));
+    EXPECT_EQ("", ShGetObjectCode(jobs[0].handle));
+}
+
+// Compiles the whole corpus on every hardware thread, and with a single thread,
+// and checks that the results match compiling each shader with ShCompile.
+TEST_F(BatchCompileTest, MatchesSerialCompile)
+{
+    buildCorpus(40);
+    std::vector<CompileResult> expected = compileSerially();
+
+    size_t threadCounts[] = { 0, 1, 3 };
+    for (size_t threadIndex = 0; threadIndex < sizeof(threadCounts) / sizeof(threadCounts[0]); threadIndex++)
+    {
+        createCompilers();
+
+        std::vector<ShCompileJob> jobs = makeJobs();
+        bool allSucceeded = ShCompileBatch(&jobs[0], jobs.size(), threadCounts[threadIndex]);
+        EXPECT_FALSE(allSucceeded);
+
+        size_t failures = 0;
+        for (size_t shaderIndex = 0; shaderIndex < jobs.size(); shaderIndex++)
+        {
+            CompileResult actual;
+            actual.success = jobs[shaderIndex].success;
+            getResults(shaderIndex, &actual);
+
+            const CompileResult &expectedResult = expected[shaderIndex];
+            EXPECT_EQ(expectedResult.success, actual.success) << "shader " << shaderIndex;
+            EXPECT_EQ(expectedResult.infoLog, actual.infoLog) << "shader " << shaderIndex;
+            EXPECT_EQ(expectedResult.objectCode, actual.objectCode) << "shader " << shaderIndex;
+            EXPECT_EQ(expectedResult.uniforms, actual.uniforms) << "shader " << shaderIndex;
+
+            if (!actual.success)
+            {
+                failures++;
+            }
+        }
+
+        // Only the shaders using an undeclared variable fail
+        EXPECT_EQ(6u * (40 / 7), failures);
+    }
+}
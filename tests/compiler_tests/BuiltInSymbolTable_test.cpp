@@ -0,0 +1,123 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// BuiltInSymbolTable_test.cpp:
+//   Tests that compilers with the same configuration share their built-in
+//   symbols, and that the shared symbols stay valid for as long as they are used.
+//
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/BuiltInSymbolTable.h"
+#include "compiler/translator/TranslatorGLSL.h"
+
+class BuiltInSymbolTableTest : public testing::Test
+{
+  public:
+    BuiltInSymbolTableTest() {}
+
+  protected:
+    virtual void SetUp()
+    {
+        ShInitBuiltInResources(&mResources);
+        mResources.MaxDrawBuffers = 4;
+    }
+
+    TranslatorGLSL *createTranslator(GLenum shaderType)
+    {
+        TranslatorGLSL *translator = new TranslatorGLSL(shaderType, SH_GLES3_SPEC);
+        EXPECT_TRUE(translator->Init(mResources));
+        return translator;
+    }
+
+    static bool compile(TranslatorGLSL *translator, const std::string &shaderString)
+    {
+        const char *shaderStrings[] = { shaderString.c_str() };
+        return translator->compile(shaderStrings, 1, SH_OBJECT_CODE | SH_VARIABLES);
+    }
+
+    ShBuiltInResources mResources;
+};
+
+TEST_F(BuiltInSymbolTableTest, SharedBetweenCompilers)
+{
+    TranslatorGLSL *first = createTranslator(GL_FRAGMENT_SHADER);
+    TranslatorGLSL *second = createTranslator(GL_FRAGMENT_SHADER);
+
+    const TSymbol *firstSymbol = first->getSymbolTable().findBuiltIn("gl_FragCoord", 300);
+    const TSymbol *secondSymbol = second->getSymbolTable().findBuiltIn("gl_FragCoord", 300);
+    ASSERT_TRUE(firstSymbol != NULL);
+    EXPECT_EQ(firstSymbol, secondSymbol);
+
+    // A different shader type or different resources get their own built-ins
+    TranslatorGLSL *vertex = createTranslator(GL_VERTEX_SHADER);
+    EXPECT_TRUE(vertex->getSymbolTable().findBuiltIn("gl_FragCoord", 300) == NULL);
+
+    mResources.MaxDrawBuffers = 8;
+    TranslatorGLSL *moreDrawBuffers = createTranslator(GL_FRAGMENT_SHADER);
+    const TVariable *maxDrawBuffers =
+        static_cast<const TVariable*>(moreDrawBuffers->getSymbolTable().findBuiltIn("gl_MaxDrawBuffers", 300));
+    ASSERT_TRUE(maxDrawBuffers != NULL);
+    EXPECT_EQ(8, maxDrawBuffers->getConstPointer()->getIConst());
+    EXPECT_NE(firstSymbol, moreDrawBuffers->getSymbolTable().findBuiltIn("gl_FragCoord", 300));
+
+    delete first;
+    delete second;
+    delete vertex;
+    delete moreDrawBuffers;
+}
+
+TEST_F(BuiltInSymbolTableTest, UserSymbolsStayPrivate)
+{
+    TranslatorGLSL *first = createTranslator(GL_FRAGMENT_SHADER);
+    TranslatorGLSL *second = createTranslator(GL_FRAGMENT_SHADER);
+
+    const std::string &firstShader =
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "out vec4 color;\n"
+        "float f(float x) { return x * 2.0; }\n"
+        "void main() {\n"
+        "   color = vec4(f(gl_FragCoord.x));\n"
+        "}\n";
+    // Redeclares f with a different meaning, which must not clash with the first shader
+    const std::string &secondShader =
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "out vec4 color;\n"
+        "vec4 f(float x) { return vec4(x); }\n"
+        "void main() {\n"
+        "   color = f(gl_FragCoord.y);\n"
+        "}\n";
+
+    EXPECT_TRUE(compile(first, firstShader));
+    EXPECT_TRUE(compile(second, secondShader));
+    EXPECT_TRUE(compile(first, firstShader));
+    EXPECT_TRUE(first->getSymbolTable().findBuiltIn("f(f1;", 300) == NULL);
+
+    delete first;
+    delete second;
+}
+
+TEST_F(BuiltInSymbolTableTest, OutlivesCache)
+{
+    TranslatorGLSL *translator = createTranslator(GL_FRAGMENT_SHADER);
+
+    // Compilers keep their built-ins alive after the cache lets go of them
+    TBuiltInSymbolTable::ReleaseAll();
+
+    const std::string &shaderString =
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "uniform sampler2D tex;\n"
+        "out vec4 color;\n"
+        "void main() {\n"
+        "   color = texture(tex, gl_FragCoord.xy) * float(gl_MaxDrawBuffers);\n"
+        "}\n";
+    EXPECT_TRUE(compile(translator, shaderString));
+
+    delete translator;
+}
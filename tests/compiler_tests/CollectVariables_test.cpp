@@ -368,3 +368,23 @@ TEST_F(CollectVertexVariablesTest, VaryingInterpolation)
     EXPECT_EQ("vary", varying->name);
     EXPECT_EQ(sh::INTERPOLATION_CENTROID, varying->interpolation);
 }
+
+// The variables are collected in the walk that finds float loop indices into sampler arrays,
+// but a shader that fails that check has none.
+TEST_F(CollectFragmentVariablesTest, NoVariablesForFloatSamplerArrayIndex)
+{
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "uniform sampler2D samplers[2];\n"
+        "void main() {\n"
+        "   for (float f = 0.0; f < 2.0; f += 1.0) {\n"
+        "       gl_FragColor += texture2D(samplers[int(f)], vec2(0.0));\n"
+        "   }\n"
+        "}\n";
+
+    const char *shaderStrings[] = { shaderString.c_str() };
+    ASSERT_FALSE(mTranslator->compile(shaderStrings, 1, SH_VARIABLES | SH_UNROLL_FOR_LOOP_WITH_SAMPLER_ARRAY_INDEX));
+
+    EXPECT_TRUE(mTranslator->getUniforms().empty());
+    EXPECT_TRUE(mTranslator->getOutputVariables().empty());
+}
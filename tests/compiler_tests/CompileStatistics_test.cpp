@@ -0,0 +1,166 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// CompileStatistics_test.cpp:
+//   Tests the phase timings, pool memory and tree sizes reported by
+//   ShGetCompileStatistics.
+//
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+
+#include <sstream>
+#include <stdio.h>
+
+namespace
+{
+
+const char *TranslationCacheFileName = "angle_compile_statistics_test.bin";
+
+std::string MakeShader(int functionCount)
+{
+    std::ostringstream stream;
+    stream << "precision mediump float;\n"
+              "uniform vec4 u;\n";
+    for (int function = 0; function < functionCount; function++)
+    {
+        stream << "vec4 f" << function << "(vec4 a) { return a * u + vec4(" << function << ".0); }\n";
+    }
+    stream << "void main() {\n"
+              "    vec4 r = u;\n";
+    for (int function = 0; function < functionCount; function++)
+    {
+        stream << "    r = f" << function << "(r);\n";
+    }
+    stream << "    gl_FragColor = r;\n"
+              "}\n";
+    return stream.str();
+}
+
+}
+
+class CompileStatisticsTest : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+        mCompiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_GLSL_OUTPUT, &resources);
+        ASSERT_TRUE(mCompiler != NULL);
+    }
+
+    virtual void TearDown()
+    {
+        ShDestruct(mCompiler);
+    }
+
+    ShCompileStatistics compile(const std::string &shaderString, int compileOptions)
+    {
+        const char *shaderStrings[] = { shaderString.c_str() };
+        ShCompile(mCompiler, shaderStrings, 1, compileOptions);
+
+        ShCompileStatistics statistics;
+        EXPECT_TRUE(ShGetCompileStatistics(mCompiler, &statistics));
+        return statistics;
+    }
+
+    ShHandle mCompiler;
+};
+
+TEST_F(CompileStatisticsTest, PhaseNames)
+{
+    for (int phase = 0; phase < SH_COMPILE_PHASE_COUNT; phase++)
+    {
+        EXPECT_TRUE(ShGetCompilePhaseName(static_cast<ShCompilePhase>(phase)) != NULL);
+    }
+    EXPECT_TRUE(ShGetCompilePhaseName(SH_COMPILE_PHASE_COUNT) == NULL);
+}
+
+TEST_F(CompileStatisticsTest, ReportsPhasesAndMemory)
+{
+    ShCompileStatistics statistics = compile(MakeShader(10), SH_OBJECT_CODE | SH_VARIABLES);
+
+    double phaseSum = 0.0;
+    for (int phase = 0; phase < SH_COMPILE_PHASE_COUNT; phase++)
+    {
+        EXPECT_GE(statistics.phaseMicroseconds[phase], 0.0);
+        phaseSum += statistics.phaseMicroseconds[phase];
+    }
+    EXPECT_GT(statistics.phaseMicroseconds[SH_COMPILE_PHASE_PARSE], 0.0);
+    EXPECT_GT(statistics.phaseMicroseconds[SH_COMPILE_PHASE_TRANSLATE], 0.0);
+    EXPECT_GE(statistics.totalMicroseconds, phaseSum);
+
+    EXPECT_GT(statistics.poolAllocationCount, 0u);
+    EXPECT_GT(statistics.poolAllocatedBytes, 0u);
+    EXPECT_GE(statistics.poolPeakBytes, statistics.poolAllocatedBytes);
+    EXPECT_GT(statistics.astNodeCount, 0u);
+    EXPECT_GT(statistics.symbolLookupCount, 0u);
+    EXPECT_GE(statistics.symbolProbeCount, statistics.symbolLookupCount);
+}
+
+TEST_F(CompileStatisticsTest, ScalesWithShaderSize)
+{
+    ShCompileStatistics small = compile(MakeShader(5), SH_OBJECT_CODE);
+    ShCompileStatistics large = compile(MakeShader(50), SH_OBJECT_CODE);
+    ShCompileStatistics smallAgain = compile(MakeShader(5), SH_OBJECT_CODE);
+
+    EXPECT_GT(large.astNodeCount, small.astNodeCount);
+    EXPECT_GT(large.poolAllocatedBytes, small.poolAllocatedBytes);
+    EXPECT_GT(large.symbolLookupCount, small.symbolLookupCount);
+
+    // Nothing carries over from one compile to the next
+    EXPECT_EQ(small.astNodeCount, smallAgain.astNodeCount);
+    EXPECT_EQ(small.poolAllocationCount, smallAgain.poolAllocationCount);
+    EXPECT_EQ(small.poolAllocatedBytes, smallAgain.poolAllocatedBytes);
+    EXPECT_EQ(small.symbolLookupCount, smallAgain.symbolLookupCount);
+}
+
+TEST_F(CompileStatisticsTest, MacroExpansions)
+{
+    const char *shaderString =
+        "precision mediump float;\n"
+        "#define ONE 1.0\n"
+        "#define COLOR vec4(ONE, ONE, ONE, ONE)\n"
+        "#define SCALE(v) ((v) * ONE)\n"
+        "void main() {\n"
+        "    gl_FragColor = SCALE(COLOR) + COLOR + COLOR;\n"
+        "}\n";
+    ShCompileStatistics statistics = compile(shaderString, SH_OBJECT_CODE);
+
+    // COLOR is expanded in full once and reused twice
+    EXPECT_EQ(2u, statistics.macroExpansionCacheHitCount);
+    EXPECT_GE(statistics.macroExpansionCount, 5u);
+
+    statistics = compile(MakeShader(3), SH_OBJECT_CODE);
+    EXPECT_EQ(0u, statistics.macroExpansionCount);
+    EXPECT_EQ(0u, statistics.macroExpansionCacheHitCount);
+}
+
+TEST_F(CompileStatisticsTest, FailedParse)
+{
+    ShCompileStatistics statistics = compile("void main() { syntax error }", SH_OBJECT_CODE);
+    EXPECT_GT(statistics.phaseMicroseconds[SH_COMPILE_PHASE_PARSE], 0.0);
+    EXPECT_EQ(0.0, statistics.phaseMicroseconds[SH_COMPILE_PHASE_TRANSLATE]);
+    EXPECT_EQ(0u, statistics.astNodeCount);
+}
+
+TEST_F(CompileStatisticsTest, TranslationCacheHitIsEmpty)
+{
+    remove(TranslationCacheFileName);
+    ASSERT_TRUE(ShSetTranslationCacheFile(TranslationCacheFileName));
+
+    std::string shaderString = MakeShader(3);
+    EXPECT_GT(compile(shaderString, SH_OBJECT_CODE).astNodeCount, 0u);
+
+    ShCompileStatistics statistics = compile(shaderString, SH_OBJECT_CODE);
+    EXPECT_EQ(0.0, statistics.totalMicroseconds);
+    EXPECT_EQ(0u, statistics.astNodeCount);
+    EXPECT_EQ(0u, statistics.poolAllocatedBytes);
+
+    ShSetTranslationCacheFile(NULL);
+    remove(TranslationCacheFileName);
+}
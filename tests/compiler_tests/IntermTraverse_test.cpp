@@ -0,0 +1,176 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// IntermTraverse_test.cpp:
+//   Tests that the iterative traversal visits nodes in the same order, at the
+//   same depths, as the recursive one, and that it handles very deep trees.
+//
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/TranslatorESSL.h"
+
+#include <sstream>
+
+namespace
+{
+
+// Records every visit, and cuts off some subtrees and in-visits so that
+// skipped children are covered too.
+class RecordingTraverser : public TIntermTraverser
+{
+  public:
+    RecordingTraverser(bool preVisit, bool inVisit, bool postVisit, bool rightToLeft, bool iterative)
+        : TIntermTraverser(preVisit, inVisit, postVisit, rightToLeft, iterative),
+          mVisitCount(0)
+    {
+    }
+
+    virtual void visitSymbol(TIntermSymbol *node) { record(PreVisit, "symbol", node); }
+    virtual void visitConstantUnion(TIntermConstantUnion *node) { record(PreVisit, "constant", node); }
+    virtual bool visitBinary(Visit visit, TIntermBinary *node) { return record(visit, "binary", node); }
+    virtual bool visitUnary(Visit visit, TIntermUnary *node) { return record(visit, "unary", node); }
+    virtual bool visitSelection(Visit visit, TIntermSelection *node) { return record(visit, "selection", node); }
+    virtual bool visitAggregate(Visit visit, TIntermAggregate *node) { return record(visit, "aggregate", node); }
+    virtual bool visitLoop(Visit visit, TIntermLoop *node) { return record(visit, "loop", node); }
+    virtual bool visitBranch(Visit visit, TIntermBranch *node) { return record(visit, "branch", node); }
+
+    std::string log() const { return mLog.str(); }
+
+  private:
+    bool record(Visit visit, const char *type, TIntermNode *node)
+    {
+        mLog << visit << " " << type << " " << node << " depth " << mDepth
+             << " parent " << getParentNode() << "\n";
+        return ++mVisitCount % 11 != 0;
+    }
+
+    std::ostringstream mLog;
+    int mVisitCount;
+};
+
+// Compares the recursive traversal of every tree it translates with the
+// default one, and with a traversal that is iterative from the root.
+class ComparingTranslator : public TranslatorESSL
+{
+  public:
+    ComparingTranslator()
+        : TranslatorESSL(GL_FRAGMENT_SHADER, SH_GLES2_SPEC)
+    {
+    }
+
+  protected:
+    virtual void translate(TIntermNode *root)
+    {
+        for (int flags = 0; flags < 16; flags++)
+        {
+            bool preVisit = (flags & 1) != 0;
+            bool inVisit = (flags & 2) != 0;
+            bool postVisit = (flags & 4) != 0;
+            bool rightToLeft = (flags & 8) != 0;
+
+            RecordingTraverser recursive(preVisit, inVisit, postVisit, rightToLeft, false);
+            root->traverse(&recursive);
+            RecordingTraverser mixed(preVisit, inVisit, postVisit, rightToLeft, true);
+            root->traverse(&mixed);
+            RecordingTraverser iterative(preVisit, inVisit, postVisit, rightToLeft, true);
+            iterative.traverseIteratively(root);
+
+            EXPECT_FALSE(recursive.log().empty());
+            EXPECT_EQ(recursive.log(), mixed.log()) << "preVisit " << preVisit << " inVisit " << inVisit
+                                                    << " postVisit " << postVisit << " rightToLeft " << rightToLeft;
+            EXPECT_EQ(recursive.log(), iterative.log()) << "preVisit " << preVisit << " inVisit " << inVisit
+                                                        << " postVisit " << postVisit << " rightToLeft " << rightToLeft;
+        }
+
+        TranslatorESSL::translate(root);
+    }
+};
+
+// An expression nested |depth| binary operators deep.
+std::string MakeDeepExpressionShader(int depth)
+{
+    std::ostringstream stream;
+    stream << "precision mediump float;\n"
+              "uniform float u;\n"
+              "void main() {\n"
+              "    float f = u";
+    for (int term = 0; term < depth; term++)
+    {
+        stream << (term % 2 ? " + u" : " * 2.0");
+    }
+    stream << ";\n"
+              "    gl_FragColor = vec4(f);\n"
+              "}\n";
+    return stream.str();
+}
+
+}
+
+class IntermTraverseTest : public testing::Test
+{
+  protected:
+    template <typename T>
+    static void compile(T *translator, const std::string &shaderString)
+    {
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+        ASSERT_TRUE(translator->Init(resources));
+
+        const char *shaderStrings[] = { shaderString.c_str() };
+        EXPECT_TRUE(translator->compile(shaderStrings, 1, SH_OBJECT_CODE))
+            << translator->getInfoSink().info.c_str();
+    }
+};
+
+TEST_F(IntermTraverseTest, SameVisitOrder)
+{
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "uniform sampler2D s;\n"
+        "struct S { vec4 v; float a; };\n"
+        "float f(float x, inout float y) { y = -x; return y * 2.0; }\n"
+        "void main() {\n"
+        "    S st = S(u, 2.0);\n"
+        "    float y;\n"
+        "    vec4 c = vec4(0.0);\n"
+        "    for (int i = 0; i < 4; i++) {\n"
+        "        if (u.x > 0.5) { c += texture2D(s, u.xy); continue; }\n"
+        "        else if (u.y > 0.5) break;\n"
+        "        c.x = f(c.y, y) + st.a;\n"
+        "    }\n"
+        "    c = u.z > 0.0 ? c : -c;\n"
+        "    if (c.w < 0.0) discard;\n"
+        "    gl_FragColor = ++c * st.v;\n"
+        "}\n";
+
+    ComparingTranslator translator;
+    compile(&translator, shaderString);
+}
+
+TEST_F(IntermTraverseTest, SameVisitOrderPastIterativeDepth)
+{
+    ComparingTranslator translator;
+    compile(&translator, MakeDeepExpressionShader(TIntermTraverser::kIterativeTraversalDepth * 4));
+}
+
+TEST_F(IntermTraverseTest, DeepExpression)
+{
+    std::string shaderString = MakeDeepExpressionShader(100000);
+
+    ShBuiltInResources resources;
+    ShInitBuiltInResources(&resources);
+    ShHandle compiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_ESSL_OUTPUT, &resources);
+    ASSERT_TRUE(compiler != NULL);
+
+    const char *shaderStrings[] = { shaderString.c_str() };
+    EXPECT_TRUE(ShCompile(compiler, shaderStrings, 1, SH_OBJECT_CODE));
+
+    // The expression complexity limit still rejects it
+    EXPECT_FALSE(ShCompile(compiler, shaderStrings, 1, SH_OBJECT_CODE | SH_LIMIT_EXPRESSION_COMPLEXITY));
+    ShDestruct(compiler);
+}
@@ -0,0 +1,224 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// OptimizeTree_test.cpp:
+//   Tests that SH_OPTIMIZE removes uncalled functions and unread variables,
+//   folds constants, and leaves code that still compiles.
+//
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+
+#include <sstream>
+
+namespace
+{
+
+// A shader that includes a library of |functionCount| functions, and a few
+// settings, of which it uses little.
+std::string MakeLibraryShader(int functionCount)
+{
+    std::ostringstream stream;
+    stream << "precision mediump float;\n"
+              "uniform vec4 u;\n"
+              "uniform sampler2D s;\n";
+    for (int function = 0; function < functionCount; function++)
+    {
+        stream << "vec4 library" << function << "(vec4 a) {\n"
+                  "    vec4 t = texture2D(s, a.xy) * " << function << ".0;\n"
+                  "    float unused = dot(t, a);\n"
+                  "    return t + a;\n"
+                  "}\n";
+    }
+    stream << "void main() {\n"
+              "    const float kScale = 2.0;\n"
+              "    float scale = kScale * 0.5;\n"
+              "    bool useFog = false;\n"
+              "    vec4 color = library0(u) * scale;\n"
+              "    if (useFog) {\n"
+              "        color = library1(color);\n"
+              "    }\n"
+              "    gl_FragColor = color;\n"
+              "}\n";
+    return stream.str();
+}
+
+}
+
+class OptimizeTreeTest : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+        mCompiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_ESSL_OUTPUT, &resources);
+        ASSERT_TRUE(mCompiler != NULL);
+    }
+
+    virtual void TearDown()
+    {
+        ShDestruct(mCompiler);
+    }
+
+    // Optimizes the shader, and checks the result compiles too.
+    std::string optimize(const std::string &shaderString)
+    {
+        const char *shaderStrings[] = { shaderString.c_str() };
+        EXPECT_TRUE(ShCompile(mCompiler, shaderStrings, 1, SH_OBJECT_CODE | SH_OPTIMIZE))
+            << ShGetInfoLog(mCompiler);
+        std::string objectCode = ShGetObjectCode(mCompiler);
+
+        const char *objectCodeStrings[] = { objectCode.c_str() };
+        EXPECT_TRUE(ShCompile(mCompiler, objectCodeStrings, 1, SH_OBJECT_CODE))
+            << ShGetInfoLog(mCompiler) << "\n" << objectCode;
+        return objectCode;
+    }
+
+    ShHandle mCompiler;
+};
+
+TEST_F(OptimizeTreeTest, RemovesUncalledFunctions)
+{
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "vec4 unusedLeaf(vec4 a);\n"
+        "vec4 unusedRoot(vec4 a) { return unusedLeaf(a) * 2.0; }\n"
+        "vec4 unusedLeaf(vec4 a) { return a + 1.0; }\n"
+        "vec4 usedLeaf(vec4 a) { return -a; }\n"
+        "vec4 used(vec4 a) { return usedLeaf(a); }\n"
+        "void main() {\n"
+        "    gl_FragColor = used(u);\n"
+        "}\n";
+
+    std::string objectCode = optimize(shaderString);
+    EXPECT_NE(std::string::npos, objectCode.find("used("));
+    EXPECT_NE(std::string::npos, objectCode.find("usedLeaf("));
+    EXPECT_EQ(std::string::npos, objectCode.find("unused"));
+}
+
+TEST_F(OptimizeTreeTest, FoldsConstants)
+{
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "float globalScale = 3.0;\n"
+        "void main() {\n"
+        "    float scale = 2.0;\n"
+        "    float doubled = scale * globalScale;\n"
+        "    bool useFog = false;\n"
+        "    gl_FragColor = u * doubled;\n"
+        "    if (useFog) {\n"
+        "        gl_FragColor.rgb = vec3(1.0);\n"
+        "    }\n"
+        "    gl_FragColor.a = !useFog ? 1.0 : 0.0;\n"
+        "}\n";
+
+    std::string objectCode = optimize(shaderString);
+    EXPECT_NE(std::string::npos, objectCode.find("6.0"));
+    EXPECT_EQ(std::string::npos, objectCode.find("scale"));
+    EXPECT_EQ(std::string::npos, objectCode.find("Scale"));
+    EXPECT_EQ(std::string::npos, objectCode.find("doubled"));
+    EXPECT_EQ(std::string::npos, objectCode.find("useFog"));
+    EXPECT_EQ(std::string::npos, objectCode.find("if ("));
+    EXPECT_EQ(std::string::npos, objectCode.find("?"));
+}
+
+TEST_F(OptimizeTreeTest, KeepsWrittenVariables)
+{
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "void set(out float x) { x = u.y; }\n"
+        "void main() {\n"
+        "    float written = 1.0;\n"
+        "    if (u.x > 0.0) written = 2.0;\n"
+        "    float setByCall = 0.0;\n"
+        "    set(setByCall);\n"
+        "    vec2 partlyWritten = vec2(0.0);\n"
+        "    partlyWritten.x = u.z;\n"
+        "    gl_FragColor = vec4(written, setByCall, partlyWritten);\n"
+        "}\n";
+
+    std::string objectCode = optimize(shaderString);
+    EXPECT_NE(std::string::npos, objectCode.find("gl_FragColor = vec4(written, setByCall, partlyWritten)"));
+    EXPECT_NE(std::string::npos, objectCode.find("set(setByCall)"));
+    EXPECT_NE(std::string::npos, objectCode.find("partlyWritten.x ="));
+}
+
+TEST_F(OptimizeTreeTest, RemovesUnreadVariables)
+{
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "vec4 unreadGlobal;\n"
+        "float sideEffect(inout float x) { x += 1.0; return x; }\n"
+        "void main() {\n"
+        "    vec4 unread = u * 2.0;\n"
+        "    unread += u;\n"
+        "    unreadGlobal = unread;\n"
+        "    float counter = 0.0;\n"
+        "    float kept = sideEffect(counter);\n"
+        "    gl_FragColor = u * counter;\n"
+        "}\n";
+
+    std::string objectCode = optimize(shaderString);
+    EXPECT_EQ(std::string::npos, objectCode.find("unread"));
+    EXPECT_EQ(std::string::npos, objectCode.find("unreadGlobal"));
+
+    // The call still has to run
+    EXPECT_NE(std::string::npos, objectCode.find("kept = sideEffect(counter)"));
+}
+
+TEST_F(OptimizeTreeTest, KeepsScopeOfTakenBranch)
+{
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "void main() {\n"
+        "    float x = u.x;\n"
+        "    if (true) {\n"
+        "        float x = u.y;\n"
+        "        gl_FragColor = vec4(x);\n"
+        "    }\n"
+        "    gl_FragColor += vec4(x);\n"
+        "}\n";
+
+    std::string objectCode = optimize(shaderString);
+    EXPECT_EQ(std::string::npos, objectCode.find("if ("));
+}
+
+TEST_F(OptimizeTreeTest, VariablesOfRemovedCode)
+{
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "uniform vec4 used;\n"
+        "uniform vec4 unused;\n"
+        "vec4 uncalled() { return unused; }\n"
+        "void main() {\n"
+        "    gl_FragColor = used;\n"
+        "}\n";
+
+    const char *shaderStrings[] = { shaderString.c_str() };
+    ASSERT_TRUE(ShCompile(mCompiler, shaderStrings, 1, SH_OBJECT_CODE | SH_OPTIMIZE | SH_VARIABLES));
+    const std::vector<sh::Uniform> *uniforms = ShGetUniforms(mCompiler);
+    ASSERT_EQ(2u, uniforms->size());
+    for (size_t index = 0; index < uniforms->size(); index++)
+    {
+        const sh::Uniform &uniform = (*uniforms)[index];
+        EXPECT_EQ(uniform.name == "used", uniform.staticUse) << uniform.name;
+    }
+}
+
+TEST_F(OptimizeTreeTest, LibraryShader)
+{
+    std::string objectCode = optimize(MakeLibraryShader(10));
+    EXPECT_NE(std::string::npos, objectCode.find("library0("));
+    EXPECT_EQ(std::string::npos, objectCode.find("library1("));
+    EXPECT_EQ(std::string::npos, objectCode.find("unused"));
+    EXPECT_EQ(std::string::npos, objectCode.find("useFog"));
+}
@@ -0,0 +1,258 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PassManager_test.cpp:
+//   Tests that passes sharing a walk see the same visits as when they walk
+//   the tree on their own, and that compiles share walks between passes.
+//
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/PassManager.h"
+#include "compiler/translator/TranslatorESSL.h"
+
+#include <sstream>
+
+namespace
+{
+
+// Records every visit. Every |cutOff|th visit returns false, and loops are
+// optionally traversed by the visitor itself, the way ValidateLimitations
+// does it.
+class RecordingTraverser : public TIntermTraverser
+{
+  public:
+    RecordingTraverser(bool preVisit, bool inVisit, bool postVisit, bool rightToLeft, int cutOff,
+                       bool traversesLoops)
+        : TIntermTraverser(preVisit, inVisit, postVisit, rightToLeft),
+          mCutOff(cutOff),
+          mTraversesLoops(traversesLoops),
+          mVisitCount(0)
+    {
+    }
+
+    virtual void visitSymbol(TIntermSymbol *node) { record(PreVisit, "symbol", node); }
+    virtual void visitConstantUnion(TIntermConstantUnion *node) { record(PreVisit, "constant", node); }
+    virtual bool visitBinary(Visit visit, TIntermBinary *node) { return record(visit, "binary", node); }
+    virtual bool visitUnary(Visit visit, TIntermUnary *node) { return record(visit, "unary", node); }
+    virtual bool visitSelection(Visit visit, TIntermSelection *node) { return record(visit, "selection", node); }
+    virtual bool visitAggregate(Visit visit, TIntermAggregate *node) { return record(visit, "aggregate", node); }
+    virtual bool visitBranch(Visit visit, TIntermBranch *node) { return record(visit, "branch", node); }
+
+    virtual bool visitLoop(Visit visit, TIntermLoop *node)
+    {
+        bool visitChildren = record(visit, "loop", node);
+        if (visit == PreVisit && visitChildren && mTraversesLoops)
+        {
+            node->getBody()->traverse(this);
+            return false;
+        }
+        return visitChildren;
+    }
+
+    std::string log() const { return mLog.str(); }
+
+  private:
+    bool record(Visit visit, const char *type, TIntermNode *node)
+    {
+        mLog << visit << " " << type << " " << node << " depth " << mDepth
+             << " max depth " << mMaxDepth << " parent " << getParentNode() << "\n";
+        return ++mVisitCount % mCutOff != 0;
+    }
+
+    int mCutOff;
+    bool mTraversesLoops;
+    std::ostringstream mLog;
+    int mVisitCount;
+};
+
+const int kTraverserCount = 8;
+
+RecordingTraverser *CreateTraverser(int index)
+{
+    bool preVisit = index != 3;
+    bool inVisit = (index % 2) == 1;
+    bool postVisit = (index % 3) != 0;
+    bool rightToLeft = index >= 6;
+    return new RecordingTraverser(preVisit, inVisit, postVisit, rightToLeft, 5 + index * 2, index == 2 || index == 7);
+}
+
+// Runs the recording traversers on every tree it translates, each on its own
+// and all through a pass manager, and compares what they saw.
+class ComparingTranslator : public TranslatorESSL
+{
+  public:
+    ComparingTranslator()
+        : TranslatorESSL(GL_FRAGMENT_SHADER, SH_GLES2_SPEC)
+    {
+    }
+
+  protected:
+    virtual void translate(TIntermNode *root)
+    {
+        RecordingTraverser *separate[kTraverserCount];
+        RecordingTraverser *fused[kTraverserCount];
+        TPassManager passes;
+        for (int index = 0; index < kTraverserCount; index++)
+        {
+            separate[index] = CreateTraverser(index);
+            root->traverse(separate[index]);
+
+            fused[index] = CreateTraverser(index);
+            passes.addPass(fused[index], SH_COMPILE_PHASE_TRANSLATE);
+        }
+        passes.run(root);
+
+        // One walk in each direction
+        EXPECT_EQ(2u, passes.getWalkCount());
+        for (int index = 0; index < kTraverserCount; index++)
+        {
+            EXPECT_FALSE(separate[index]->log().empty());
+            EXPECT_EQ(separate[index]->log(), fused[index]->log()) << "traverser " << index;
+        }
+
+        double phaseMicroseconds[SH_COMPILE_PHASE_COUNT] = { 0.0 };
+        passes.chargePhases(100.0, phaseMicroseconds);
+        EXPECT_NEAR(100.0, phaseMicroseconds[SH_COMPILE_PHASE_TRANSLATE], 0.001);
+
+        TranslatorESSL::translate(root);
+    }
+};
+
+std::string MakeShader(int functionCount)
+{
+    std::ostringstream stream;
+    stream << "precision mediump float;\n"
+              "uniform vec4 u;\n";
+    for (int function = 0; function < functionCount; function++)
+    {
+        stream << "vec4 f" << function << "(vec4 a) {\n"
+                  "    vec4 r = a;\n"
+                  "    for (int i = 0; i < 4; i++) { r = r * u + vec4(" << function << ".0); }\n"
+                  "    return r.x > 0.5 ? r : -r;\n"
+                  "}\n";
+    }
+    stream << "void main() {\n"
+              "    vec4 r = u;\n";
+    for (int function = 0; function < functionCount; function++)
+    {
+        stream << "    r = f" << function << "(r);\n";
+    }
+    stream << "    gl_FragColor = r;\n"
+              "}\n";
+    return stream.str();
+}
+
+}
+
+class PassManagerTest : public testing::Test
+{
+  protected:
+    template <typename T>
+    static void compile(T *translator, const std::string &shaderString)
+    {
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+        ASSERT_TRUE(translator->Init(resources));
+
+        const char *shaderStrings[] = { shaderString.c_str() };
+        EXPECT_TRUE(translator->compile(shaderStrings, 1, SH_OBJECT_CODE))
+            << translator->getInfoSink().info.c_str();
+    }
+
+    static ShCompileStatistics compile(ShHandle compiler, const std::string &shaderString, int compileOptions,
+                                       bool expectSuccess = true)
+    {
+        const char *shaderStrings[] = { shaderString.c_str() };
+        EXPECT_EQ(expectSuccess, ShCompile(compiler, shaderStrings, 1, compileOptions));
+
+        ShCompileStatistics statistics;
+        EXPECT_TRUE(ShGetCompileStatistics(compiler, &statistics));
+        return statistics;
+    }
+};
+
+TEST_F(PassManagerTest, FusedPassesSeeTheSameVisits)
+{
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "float f(float x, inout float y) { y = -x; return y * 2.0; }\n"
+        "void main() {\n"
+        "    float y;\n"
+        "    vec4 c = vec4(0.0);\n"
+        "    for (int i = 0; i < 4; i++) {\n"
+        "        if (u.x > 0.5) { c += u * float(i); continue; }\n"
+        "        else if (u.y > 0.5) break;\n"
+        "        c.x = f(c.y, y) + (u.z + u.w) * (c.x - c.z);\n"
+        "    }\n"
+        "    c = u.z > 0.0 ? c : -c;\n"
+        "    if (c.w < 0.0) discard;\n"
+        "    gl_FragColor = ++c * u;\n"
+        "}\n";
+
+    ComparingTranslator translator;
+    compile(&translator, shaderString);
+}
+
+TEST_F(PassManagerTest, CompilesShareWalks)
+{
+    ShBuiltInResources resources;
+    ShInitBuiltInResources(&resources);
+    ShHandle compiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_WEBGL_SPEC, SH_GLSL_OUTPUT, &resources);
+    ASSERT_TRUE(compiler != NULL);
+
+    const int analysisOptions = SH_VARIABLES | SH_LIMIT_EXPRESSION_COMPLEXITY | SH_LIMIT_CALL_STACK_DEPTH |
+                                SH_EMULATE_BUILT_IN_FUNCTIONS | SH_CLAMP_INDIRECT_ARRAY_BOUNDS |
+                                SH_UNROLL_FOR_LOOP_WITH_INTEGER_INDEX;
+    std::string shaderString = MakeShader(4);
+
+    // One walk for the validation passes, and one for the rest
+    ShCompileStatistics statistics = compile(compiler, shaderString, SH_OBJECT_CODE | analysisOptions);
+    EXPECT_EQ(2u, statistics.analysisWalkCount);
+
+    // Variables are collected after the tree has been rewritten
+    statistics = compile(compiler, shaderString, SH_OBJECT_CODE | analysisOptions | SH_UNFOLD_SHORT_CIRCUIT);
+    EXPECT_EQ(3u, statistics.analysisWalkCount);
+
+    ShDestruct(compiler);
+}
+
+TEST_F(PassManagerTest, FirstFailedValidationReports)
+{
+    ShBuiltInResources resources;
+    ShInitBuiltInResources(&resources);
+    ShHandle compiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_WEBGL_SPEC, SH_GLSL_OUTPUT, &resources);
+    ASSERT_TRUE(compiler != NULL);
+
+    // Recursion and a while loop, which WebGL does not allow
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "float f(float x) { return x > 0.0 ? f(x - 1.0) : 0.0; }\n"
+        "void main() {\n"
+        "    float x = 0.0;\n"
+        "    while (x < 1.0) { x += 0.5; }\n"
+        "    gl_FragColor = vec4(f(x));\n"
+        "}\n";
+    compile(compiler, shaderString, SH_OBJECT_CODE, false);
+
+    std::string log = ShGetInfoLog(compiler);
+    EXPECT_NE(std::string::npos, log.find("Function recursion detected"));
+    EXPECT_EQ(std::string::npos, log.find("while"));
+
+    // Without the recursion, the loop is reported
+    const std::string &loopShaderString =
+        "precision mediump float;\n"
+        "void main() {\n"
+        "    float x = 0.0;\n"
+        "    while (x < 1.0) { x += 0.5; }\n"
+        "    gl_FragColor = vec4(x);\n"
+        "}\n";
+    compile(compiler, loopShaderString, SH_OBJECT_CODE, false);
+    EXPECT_NE(std::string::npos, ShGetInfoLog(compiler).find("while"));
+
+    ShDestruct(compiler);
+}
@@ -0,0 +1,192 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PoolAlloc_test.cpp:
+//   Tests that pools take their pages from the process-wide page cache and
+//   give them back to it, and that compiles report the pages they used.
+//
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/PoolAlloc.h"
+
+#include <sstream>
+#include <string.h>
+
+namespace
+{
+
+std::string MakeShader(int functionCount)
+{
+    std::ostringstream stream;
+    stream << "precision mediump float;\n"
+              "uniform vec4 u;\n";
+    for (int function = 0; function < functionCount; function++)
+    {
+        stream << "vec4 f" << function << "(vec4 a) { return a * u + vec4(" << function << ".0); }\n";
+    }
+    stream << "void main() {\n"
+              "    vec4 r = u;\n";
+    for (int function = 0; function < functionCount; function++)
+    {
+        stream << "    r = f" << function << "(r);\n";
+    }
+    stream << "    gl_FragColor = r;\n"
+              "}\n";
+    return stream.str();
+}
+
+}
+
+class PoolAllocTest : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        TPoolPageCache::Trim();
+    }
+
+    virtual void TearDown()
+    {
+        TPoolPageCache::SetEnabled(true);
+        TPoolPageCache::SetHugePagesEnabled(false);
+    }
+
+    ShHandle createCompiler()
+    {
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+        ShHandle compiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_GLSL_OUTPUT, &resources);
+        EXPECT_TRUE(compiler != NULL);
+        return compiler;
+    }
+
+    static ShCompileStatistics compile(ShHandle compiler, const std::string &shaderString)
+    {
+        const char *shaderStrings[] = { shaderString.c_str() };
+        EXPECT_TRUE(ShCompile(compiler, shaderStrings, 1, SH_OBJECT_CODE));
+
+        ShCompileStatistics statistics;
+        EXPECT_TRUE(ShGetCompileStatistics(compiler, &statistics));
+        return statistics;
+    }
+};
+
+TEST_F(PoolAllocTest, CacheRoundsUpToSizeClasses)
+{
+    TPoolBlock block = TPoolPageCache::Allocate(5000);
+    ASSERT_TRUE(block.memory != NULL);
+    EXPECT_EQ(8u * 1024u, block.size);
+    EXPECT_FALSE(block.reused);
+    TPoolPageCache::Free(block.memory, block.size, block.hugePages);
+    EXPECT_EQ(8u * 1024u, TPoolPageCache::GetStatistics().cachedBytes);
+
+    // A request of the same size class gets the cached block back
+    TPoolBlock reusedBlock = TPoolPageCache::Allocate(8 * 1024);
+    EXPECT_EQ(block.memory, reusedBlock.memory);
+    EXPECT_TRUE(reusedBlock.reused);
+    EXPECT_EQ(0u, TPoolPageCache::GetStatistics().cachedBytes);
+    TPoolPageCache::Free(reusedBlock.memory, reusedBlock.size, reusedBlock.hugePages);
+
+    // Blocks larger than the largest class are not cached
+    TPoolBlock largeBlock = TPoolPageCache::Allocate(1024 * 1024);
+    EXPECT_EQ(1024u * 1024u, largeBlock.size);
+    TPoolPageCache::Free(largeBlock.memory, largeBlock.size, largeBlock.hugePages);
+    EXPECT_EQ(8u * 1024u, TPoolPageCache::GetStatistics().cachedBytes);
+
+    TPoolPageCache::Trim();
+    EXPECT_EQ(0u, TPoolPageCache::GetStatistics().cachedBytes);
+}
+
+TEST_F(PoolAllocTest, DestroyedPoolsFillCache)
+{
+    TPoolPageCacheStatistics before = TPoolPageCache::GetStatistics();
+    {
+        TPoolAllocator allocator;
+        allocator.push();
+        for (int allocation = 0; allocation < 100; allocation++)
+        {
+            memset(allocator.allocate(1000), 0, 1000);
+        }
+        memset(allocator.allocate(100 * 1024), 0, 100 * 1024);
+        EXPECT_LT(0u, allocator.getPageCount());
+        EXPECT_EQ(0u, allocator.getReusedPageCount());
+        allocator.pop();
+    }
+    size_t cachedBytes = TPoolPageCache::GetStatistics().cachedBytes;
+    EXPECT_LT(100u * 1024u, cachedBytes);
+
+    // A new pool doing the same allocations takes every page from the cache
+    {
+        TPoolAllocator allocator;
+        allocator.push();
+        for (int allocation = 0; allocation < 100; allocation++)
+        {
+            memset(allocator.allocate(1000), 0, 1000);
+        }
+        memset(allocator.allocate(100 * 1024), 0, 100 * 1024);
+        EXPECT_EQ(allocator.getPageCount(), allocator.getReusedPageCount());
+        allocator.pop();
+    }
+    EXPECT_EQ(cachedBytes, TPoolPageCache::GetStatistics().cachedBytes);
+    EXPECT_LT(before.hitCount, TPoolPageCache::GetStatistics().hitCount);
+}
+
+TEST_F(PoolAllocTest, DisabledCache)
+{
+    TPoolPageCache::SetEnabled(false);
+    {
+        TPoolAllocator allocator;
+        allocator.push();
+        allocator.allocate(1000);
+        allocator.pop();
+    }
+    EXPECT_EQ(0u, TPoolPageCache::GetStatistics().cachedBytes);
+}
+
+TEST_F(PoolAllocTest, HugePageAllocations)
+{
+    TPoolPageCache::SetHugePagesEnabled(true);
+
+    TPoolAllocator allocator;
+    allocator.push();
+    const size_t size = 3 * 1024 * 1024;
+    unsigned char *memory = static_cast<unsigned char*>(allocator.allocate(size));
+    ASSERT_TRUE(memory != NULL);
+    memset(memory, 0xab, size);
+    EXPECT_EQ(0xab, memory[size - 1]);
+    allocator.pop();
+
+    EXPECT_EQ(0u, TPoolPageCache::GetStatistics().cachedBytes);
+}
+
+TEST_F(PoolAllocTest, CompilesReusePages)
+{
+    std::string shaderString = MakeShader(20);
+
+    ShHandle compiler = createCompiler();
+    ShCompileStatistics statistics = compile(compiler, shaderString);
+    EXPECT_LT(0u, statistics.poolPageCount);
+    EXPECT_GE(statistics.poolPageCount, statistics.poolReusedPageCount);
+
+    // The second compile finds the pages of the first in its pool
+    statistics = compile(compiler, shaderString);
+    EXPECT_EQ(statistics.poolPageCount, statistics.poolReusedPageCount);
+    ShDestruct(compiler);
+
+    // A new compiler takes them from the page cache
+    compiler = createCompiler();
+    statistics = compile(compiler, shaderString);
+    EXPECT_EQ(statistics.poolPageCount, statistics.poolReusedPageCount);
+    ShDestruct(compiler);
+
+    size_t hitCount = 0;
+    size_t missCount = 0;
+    size_t cachedBytes = 0;
+    ShGetPoolPageCacheStatistics(&hitCount, &missCount, &cachedBytes);
+    EXPECT_LT(0u, hitCount);
+    EXPECT_LT(0u, cachedBytes);
+}
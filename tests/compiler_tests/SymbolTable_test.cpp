@@ -0,0 +1,132 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// SymbolTable_test.cpp:
+//   Tests symbol lookups through the scopes of the symbol table, and measures
+//   how many hash table probes the parser needs.
+//
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/TranslatorGLSL.h"
+
+class SymbolTableTest : public testing::Test
+{
+  public:
+    SymbolTableTest() {}
+
+  protected:
+    virtual void SetUp()
+    {
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+        mTranslator = new TranslatorGLSL(GL_FRAGMENT_SHADER, SH_GLES3_SPEC);
+        ASSERT_TRUE(mTranslator->Init(resources));
+
+        mAllocator.push();
+        mPreviousAllocator = GetGlobalPoolAllocator();
+        SetGlobalPoolAllocator(&mAllocator);
+    }
+
+    virtual void TearDown()
+    {
+        SetGlobalPoolAllocator(mPreviousAllocator);
+        mAllocator.pop();
+        delete mTranslator;
+    }
+
+    TSymbolTable &symbolTable() { return mTranslator->getSymbolTable(); }
+
+    static TVariable *newVariable(const char *name, TBasicType type)
+    {
+        return new TVariable(NewPoolTString(name), TType(type, EbpHigh, EvqGlobal, 1));
+    }
+
+    bool compile(const std::string &shaderString)
+    {
+        const char *shaderStrings[] = { shaderString.c_str() };
+        return mTranslator->compile(shaderStrings, 1, SH_OBJECT_CODE);
+    }
+
+    TranslatorGLSL *mTranslator;
+    TPoolAllocator mAllocator;
+    TPoolAllocator *mPreviousAllocator;
+};
+
+TEST_F(SymbolTableTest, InnerScopesShadowOuterScopes)
+{
+    TSymbolTable &table = symbolTable();
+    table.push();
+
+    TVariable *outer = newVariable("x", EbtFloat);
+    EXPECT_TRUE(table.declare(outer));
+    EXPECT_FALSE(table.declare(newVariable("x", EbtInt)));
+
+    table.push();
+    TVariable *inner = newVariable("x", EbtInt);
+    EXPECT_TRUE(table.declare(inner));
+
+    bool builtIn = true;
+    bool sameScope = false;
+    EXPECT_EQ(inner, table.find("x", 300, &builtIn, &sameScope));
+    EXPECT_FALSE(builtIn);
+    EXPECT_TRUE(sameScope);
+
+    table.pop();
+    EXPECT_EQ(outer, table.find("x", 300, &builtIn, &sameScope));
+    EXPECT_TRUE(sameScope);
+
+    table.pop();
+    EXPECT_TRUE(table.find("x", 300) == NULL);
+}
+
+TEST_F(SymbolTableTest, BuiltInLevelsFollowShaderVersion)
+{
+    TSymbolTable &table = symbolTable();
+
+    bool builtIn = false;
+    EXPECT_TRUE(table.find("gl_FragColor", 100, &builtIn) != NULL);
+    EXPECT_TRUE(builtIn);
+    EXPECT_TRUE(table.find("gl_FragColor", 300) == NULL);
+
+    EXPECT_TRUE(table.find("gl_MaxFragmentInputVectors", 300) != NULL);
+    EXPECT_TRUE(table.find("gl_MaxFragmentInputVectors", 100) == NULL);
+
+    // User symbols hide built-ins with the same name
+    table.push();
+    TVariable *fragCoord = newVariable("gl_FragCoord", EbtFloat);
+    EXPECT_TRUE(table.declare(fragCoord));
+    EXPECT_EQ(fragCoord, table.find("gl_FragCoord", 300, &builtIn));
+    EXPECT_FALSE(builtIn);
+    EXPECT_NE(fragCoord, table.findBuiltIn("gl_FragCoord", 300));
+    table.pop();
+}
+
+TEST_F(SymbolTableTest, CountsLookupsAndProbes)
+{
+    TSymbolTable &table = symbolTable();
+    table.resetLookupCounts();
+
+    // Names that were never inserted fail without touching any level
+    EXPECT_TRUE(table.find("neverDeclared", 300) == NULL);
+    EXPECT_EQ(1u, table.getLookupCount());
+    size_t probeCount = table.getProbeCount();
+    EXPECT_GE(probeCount, 1u);
+
+    EXPECT_TRUE(table.findBuiltIn("gl_FragCoord", 300) != NULL);
+    EXPECT_EQ(2u, table.getLookupCount());
+    EXPECT_GT(table.getProbeCount(), probeCount + 1);
+
+    const std::string &shaderString =
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "void main() {\n"
+        "   gl_FragColor = u;\n"
+        "}\n";
+    EXPECT_TRUE(compile(shaderString));
+    EXPECT_GT(table.getLookupCount(), 0u);
+    EXPECT_GE(table.getProbeCount(), table.getLookupCount());
+}
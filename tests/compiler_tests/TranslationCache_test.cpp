@@ -0,0 +1,324 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// TranslationCache_test.cpp:
+//   Tests that results served from the translation cache match fresh compiles,
+//   and that the cache file survives being reopened, truncated or corrupted.
+//
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/Compiler.h"
+
+#include <stdio.h>
+
+namespace
+{
+
+const char *CacheFileName = "angle_translation_cache_test.bin";
+
+// The HLSL translator relies on collected variables
+const int CompileOptions = SH_OBJECT_CODE | SH_VARIABLES;
+
+const char *FragmentShader =
+    "#version 300 es\n"
+    "precision mediump float;\n"
+    "uniform Block { vec4 color; mat2 m; } block;\n"
+    "uniform sampler2D tex;\n"
+    "uniform vec4 offsets[4];\n"
+    "in vec2 texCoord;\n"
+    "out vec4 fragColor;\n"
+    "void main() {\n"
+    "    fragColor = texture(tex, texCoord + offsets[2].xy) * block.color;\n"
+    "}\n";
+
+const char *StructUniformShader =
+    "precision mediump float;\n"
+    "struct Light { vec3 position; float intensities[2]; };\n"
+    "uniform Light lights[3];\n"
+    "uniform mat3 transforms[2];\n"
+    "void main() {\n"
+    "    gl_FragColor = vec4(transforms[1] * lights[2].position * lights[0].intensities[1], 1.0);\n"
+    "}\n";
+
+const char *InvalidShader =
+    "precision mediump float;\n"
+    "void main() {\n"
+    "    gl_FragColor = undeclared;\n"
+    "}\n";
+
+khronos_uint64_t HashByLength(const char *str, size_t length)
+{
+    return length;
+}
+
+struct CompileResult
+{
+    bool success;
+    std::string infoLog;
+    std::string objectCode;
+    std::vector<sh::Uniform> uniforms;
+    std::vector<sh::ShaderVariable> expandedUniforms;
+    std::vector<sh::Varying> varyings;
+    std::vector<sh::Attribute> outputVariables;
+    std::vector<sh::InterfaceBlock> interfaceBlocks;
+    unsigned int samplerRegister;
+    unsigned int blockRegister;
+};
+
+}
+
+class TranslationCacheTest : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        remove(CacheFileName);
+
+        ShInitBuiltInResources(&mResources);
+        mCompiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES3_SPEC, SH_HLSL11_OUTPUT, &mResources);
+        ASSERT_TRUE(mCompiler != NULL);
+    }
+
+    virtual void TearDown()
+    {
+        ShDestruct(mCompiler);
+        ShSetTranslationCacheFile(NULL);
+        remove(CacheFileName);
+    }
+
+    CompileResult compile(const char *source, int compileOptions)
+    {
+        CompileResult result;
+        result.success = ShCompile(mCompiler, &source, 1, compileOptions);
+        result.infoLog = ShGetInfoLog(mCompiler);
+        result.objectCode = ShGetObjectCode(mCompiler);
+        result.uniforms = *ShGetUniforms(mCompiler);
+        result.expandedUniforms = static_cast<TShHandleBase*>(mCompiler)->getAsCompiler()->getExpandedUniforms();
+        result.varyings = *ShGetVaryings(mCompiler);
+        result.outputVariables = *ShGetOutputVariables(mCompiler);
+        result.interfaceBlocks = *ShGetInterfaceBlocks(mCompiler);
+
+        result.samplerRegister = 0;
+        result.blockRegister = 0;
+        if (result.success && source == FragmentShader)
+        {
+            EXPECT_TRUE(ShGetUniformRegister(mCompiler, "tex", &result.samplerRegister));
+            EXPECT_TRUE(ShGetInterfaceBlockRegister(mCompiler, "Block", &result.blockRegister));
+        }
+        return result;
+    }
+
+    void expectStatistics(size_t expectedHits, size_t expectedMisses)
+    {
+        size_t hits = 0;
+        size_t misses = 0;
+        ShGetTranslationCacheStatistics(&hits, &misses);
+        EXPECT_EQ(expectedHits, hits);
+        EXPECT_EQ(expectedMisses, misses);
+    }
+
+    static void expectSameResults(const CompileResult &expected, const CompileResult &actual)
+    {
+        EXPECT_EQ(expected.success, actual.success);
+        EXPECT_EQ(expected.infoLog, actual.infoLog);
+        EXPECT_EQ(expected.objectCode, actual.objectCode);
+        EXPECT_EQ(expected.uniforms, actual.uniforms);
+        EXPECT_EQ(expected.varyings, actual.varyings);
+        EXPECT_EQ(expected.outputVariables, actual.outputVariables);
+        EXPECT_EQ(expected.samplerRegister, actual.samplerRegister);
+        EXPECT_EQ(expected.blockRegister, actual.blockRegister);
+
+        // Expanded uniforms are plain sh::ShaderVariables, which have no public operator==
+        ASSERT_EQ(expected.expandedUniforms.size(), actual.expandedUniforms.size());
+        for (size_t index = 0; index < expected.expandedUniforms.size(); index++)
+        {
+            const sh::ShaderVariable &expectedUniform = expected.expandedUniforms[index];
+            const sh::ShaderVariable &actualUniform = actual.expandedUniforms[index];
+            EXPECT_EQ(expectedUniform.type, actualUniform.type);
+            EXPECT_EQ(expectedUniform.precision, actualUniform.precision);
+            EXPECT_EQ(expectedUniform.name, actualUniform.name);
+            EXPECT_EQ(expectedUniform.mappedName, actualUniform.mappedName);
+            EXPECT_EQ(expectedUniform.arraySize, actualUniform.arraySize);
+            EXPECT_EQ(expectedUniform.staticUse, actualUniform.staticUse);
+            EXPECT_EQ(expectedUniform.structName, actualUniform.structName);
+            EXPECT_EQ(expectedUniform.fields.size(), actualUniform.fields.size());
+        }
+
+        ASSERT_EQ(expected.interfaceBlocks.size(), actual.interfaceBlocks.size());
+        for (size_t index = 0; index < expected.interfaceBlocks.size(); index++)
+        {
+            const sh::InterfaceBlock &expectedBlock = expected.interfaceBlocks[index];
+            const sh::InterfaceBlock &actualBlock = actual.interfaceBlocks[index];
+            EXPECT_EQ(expectedBlock.name, actualBlock.name);
+            EXPECT_EQ(expectedBlock.mappedName, actualBlock.mappedName);
+            EXPECT_EQ(expectedBlock.instanceName, actualBlock.instanceName);
+            EXPECT_EQ(expectedBlock.arraySize, actualBlock.arraySize);
+            EXPECT_EQ(expectedBlock.layout, actualBlock.layout);
+            EXPECT_EQ(expectedBlock.isRowMajorLayout, actualBlock.isRowMajorLayout);
+            EXPECT_EQ(expectedBlock.staticUse, actualBlock.staticUse);
+            EXPECT_EQ(expectedBlock.fields, actualBlock.fields);
+        }
+    }
+
+    ShBuiltInResources mResources;
+    ShHandle mCompiler;
+};
+
+TEST_F(TranslationCacheTest, HitMatchesCompile)
+{
+    CompileResult uncached = compile(FragmentShader, CompileOptions);
+    ASSERT_TRUE(uncached.success);
+    EXPECT_EQ(1u, uncached.interfaceBlocks.size());
+
+    ASSERT_TRUE(ShSetTranslationCacheFile(CacheFileName));
+
+    CompileResult miss = compile(FragmentShader, CompileOptions);
+    expectStatistics(0, 1);
+    expectSameResults(uncached, miss);
+
+    // Clear the results held by the compiler so a hit has to restore all of them
+    compile(InvalidShader, CompileOptions);
+    expectStatistics(0, 2);
+
+    CompileResult hit = compile(FragmentShader, CompileOptions);
+    expectStatistics(1, 2);
+    expectSameResults(uncached, hit);
+}
+
+// Packing restrictions are checked against the uniforms expanded into their struct fields
+// and array elements, which a hit has to restore as well.
+TEST_F(TranslationCacheTest, HitRestoresExpandedUniforms)
+{
+    CompileResult uncached = compile(StructUniformShader, CompileOptions);
+    ASSERT_TRUE(uncached.success);
+    EXPECT_LT(uncached.uniforms.size(), uncached.expandedUniforms.size());
+
+    ASSERT_TRUE(ShSetTranslationCacheFile(CacheFileName));
+    compile(StructUniformShader, CompileOptions);
+    compile(InvalidShader, CompileOptions);
+
+    CompileResult hit = compile(StructUniformShader, CompileOptions);
+    expectStatistics(1, 2);
+    expectSameResults(uncached, hit);
+}
+
+TEST_F(TranslationCacheTest, FailedCompileIsCached)
+{
+    ASSERT_TRUE(ShSetTranslationCacheFile(CacheFileName));
+
+    CompileResult miss = compile(InvalidShader, CompileOptions);
+    EXPECT_FALSE(miss.success);
+    EXPECT_NE(std::string::npos, miss.infoLog.find("undeclared"));
+
+    CompileResult hit = compile(InvalidShader, CompileOptions);
+    expectStatistics(1, 1);
+    expectSameResults(miss, hit);
+}
+
+TEST_F(TranslationCacheTest, KeyIncludesOptionsAndResources)
+{
+    ASSERT_TRUE(ShSetTranslationCacheFile(CacheFileName));
+
+    compile(FragmentShader, CompileOptions);
+    compile(FragmentShader, CompileOptions | SH_VALIDATE_LOOP_INDEXING);
+    expectStatistics(0, 2);
+
+    ShDestruct(mCompiler);
+    mResources.MaxDrawBuffers = 4;
+    mCompiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES3_SPEC, SH_HLSL11_OUTPUT, &mResources);
+    compile(FragmentShader, CompileOptions);
+    expectStatistics(0, 3);
+
+    ShDestruct(mCompiler);
+    mCompiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_HLSL11_OUTPUT, &mResources);
+    compile(FragmentShader, CompileOptions);
+    expectStatistics(0, 4);
+
+    compile(FragmentShader, CompileOptions);
+    expectStatistics(1, 4);
+}
+
+TEST_F(TranslationCacheTest, PersistsAcrossOpen)
+{
+
+    ASSERT_TRUE(ShSetTranslationCacheFile(CacheFileName));
+    CompileResult miss = compile(FragmentShader, CompileOptions);
+    compile(InvalidShader, CompileOptions);
+    expectStatistics(0, 2);
+
+    ASSERT_TRUE(ShSetTranslationCacheFile(CacheFileName));
+    CompileResult hit = compile(FragmentShader, CompileOptions);
+    compile(InvalidShader, CompileOptions);
+    expectStatistics(2, 0);
+    expectSameResults(miss, hit);
+}
+
+TEST_F(TranslationCacheTest, TruncatedFile)
+{
+    ASSERT_TRUE(ShSetTranslationCacheFile(CacheFileName));
+    compile(FragmentShader, CompileOptions);
+    compile(InvalidShader, CompileOptions);
+    ASSERT_TRUE(ShSetTranslationCacheFile(NULL));
+
+    // Cut the last entry short, as if the process died while writing it
+    FILE *file = fopen(CacheFileName, "rb");
+    ASSERT_TRUE(file != NULL);
+    std::vector<char> contents;
+    char buffer[1024];
+    size_t readSize = 0;
+    while ((readSize = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        contents.insert(contents.end(), buffer, buffer + readSize);
+    }
+    fclose(file);
+
+    file = fopen(CacheFileName, "wb");
+    ASSERT_TRUE(file != NULL);
+    fwrite(&contents[0], 1, contents.size() - 8, file);
+    fclose(file);
+
+    ASSERT_TRUE(ShSetTranslationCacheFile(CacheFileName));
+    compile(FragmentShader, CompileOptions);
+    compile(InvalidShader, CompileOptions);
+    expectStatistics(1, 1);
+
+    // The damaged entry was dropped and written again
+    ASSERT_TRUE(ShSetTranslationCacheFile(CacheFileName));
+    compile(FragmentShader, CompileOptions);
+    compile(InvalidShader, CompileOptions);
+    expectStatistics(2, 0);
+}
+
+TEST_F(TranslationCacheTest, CorruptFile)
+{
+    FILE *file = fopen(CacheFileName, "wb");
+    ASSERT_TRUE(file != NULL);
+    fputs("not a translation cache", file);
+    fclose(file);
+
+    ASSERT_TRUE(ShSetTranslationCacheFile(CacheFileName));
+    CompileResult miss = compile(FragmentShader, CompileOptions);
+    EXPECT_TRUE(miss.success);
+    expectStatistics(0, 1);
+
+    ASSERT_TRUE(ShSetTranslationCacheFile(CacheFileName));
+    CompileResult hit = compile(FragmentShader, CompileOptions);
+    expectStatistics(1, 0);
+    expectSameResults(miss, hit);
+}
+
+TEST_F(TranslationCacheTest, NameHashingIsNotCached)
+{
+    ShDestruct(mCompiler);
+    mResources.HashFunction = HashByLength;
+    mCompiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES3_SPEC, SH_HLSL11_OUTPUT, &mResources);
+
+    ASSERT_TRUE(ShSetTranslationCacheFile(CacheFileName));
+    compile(FragmentShader, CompileOptions);
+    compile(FragmentShader, CompileOptions);
+    expectStatistics(0, 0);
+}
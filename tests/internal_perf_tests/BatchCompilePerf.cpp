@@ -0,0 +1,183 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// BatchCompilePerf.cpp:
+//   Times compiling a corpus of shaders for every compiler configuration serially with
+//   ShCompile, and as one ShCompileBatch on all hardware threads.
+//
+
+#include "InternalBenchmark.h"
+
+#include "angle_gl.h"
+#include "GLSLANG/ShaderLang.h"
+
+#include <sstream>
+
+namespace
+{
+
+const int CompileOptions = SH_OBJECT_CODE | SH_VARIABLES;
+
+struct CompilerConfig
+{
+    sh::GLenum type;
+    ShShaderSpec spec;
+    ShShaderOutput output;
+};
+
+const CompilerConfig CompilerConfigs[] =
+{
+    { GL_VERTEX_SHADER, SH_GLES2_SPEC, SH_GLSL_OUTPUT },
+    { GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_ESSL_OUTPUT },
+    { GL_VERTEX_SHADER, SH_WEBGL_SPEC, SH_HLSL9_OUTPUT },
+    { GL_FRAGMENT_SHADER, SH_WEBGL_SPEC, SH_HLSL9_OUTPUT },
+    { GL_VERTEX_SHADER, SH_GLES3_SPEC, SH_HLSL11_OUTPUT },
+    { GL_FRAGMENT_SHADER, SH_GLES3_SPEC, SH_HLSL11_OUTPUT },
+};
+
+std::string MakeShader(const CompilerConfig &config, size_t shaderIndex)
+{
+    bool essl3 = (config.spec == SH_GLES3_SPEC);
+    bool vertex = (config.type == GL_VERTEX_SHADER);
+
+    std::ostringstream stream;
+    if (essl3)
+    {
+        stream << "#version 300 es\n";
+    }
+    stream << "precision mediump float;\n"
+              "uniform vec4 u" << shaderIndex << "[" << (shaderIndex % 7 + 1) << "];\n"
+              "struct S { vec4 v; float f[" << (shaderIndex % 3 + 1) << "]; };\n"
+              "uniform S s;\n";
+
+    if (vertex)
+    {
+        stream << (essl3 ? "in" : "attribute") << " vec4 position;\n"
+               << (essl3 ? "out" : "varying") << " vec4 color;\n";
+    }
+    else
+    {
+        stream << "uniform sampler2D tex;\n"
+               << (essl3 ? "in" : "varying") << " vec4 color;\n";
+        if (essl3)
+        {
+            stream << "out vec4 fragColor;\n";
+        }
+    }
+
+    stream << "vec4 f" << shaderIndex << "(vec4 a, int n) {\n"
+              "    vec4 r = a;\n"
+              "    for (int i = 0; i < " << (shaderIndex % 5 + 1) << "; i++) {\n"
+              "        r = r * s.v + u" << shaderIndex << "[0] * float(i);\n"
+              "        if (r.x > s.f[0]) { r = normalize(r); }\n"
+              "    }\n"
+              "    return r;\n"
+              "}\n"
+              "void main() {\n";
+
+    if (vertex)
+    {
+        stream << "    color = f" << shaderIndex << "(position, 2);\n"
+                  "    gl_Position = position * color;\n";
+    }
+    else
+    {
+        const char *sample = (essl3 ? "texture" : "texture2D");
+        stream << "    vec4 c = f" << shaderIndex << "(color, 3) * " << sample << "(tex, color.xy);\n"
+               << (essl3 ? "    fragColor" : "    gl_FragColor") << " = c;\n";
+    }
+    stream << "}\n";
+
+    return stream.str();
+}
+
+class BatchCompileBenchmark : public InternalBenchmark
+{
+  public:
+    BatchCompileBenchmark()
+        : InternalBenchmark("BatchCompile")
+    {
+        ShInitBuiltInResources(&mResources);
+        mResources.MaxDrawBuffers = 4;
+        mResources.OES_standard_derivatives = 1;
+    }
+
+    virtual void runBenchmark()
+    {
+        const size_t shadersPerConfig = 200;
+        for (size_t configIndex = 0; configIndex < ArraySize(CompilerConfigs); configIndex++)
+        {
+            for (size_t shaderIndex = 0; shaderIndex < shadersPerConfig; shaderIndex++)
+            {
+                mSources.push_back(MakeShader(CompilerConfigs[configIndex], shaderIndex));
+                mSourcePointers.push_back(NULL);
+                mConfigIndices.push_back(configIndex);
+            }
+        }
+        for (size_t shaderIndex = 0; shaderIndex < mSources.size(); shaderIndex++)
+        {
+            mSourcePointers[shaderIndex] = mSources[shaderIndex].c_str();
+        }
+
+        createCompilers();
+        bool serialSuccess = true;
+        BenchmarkClock::time_point start = BenchmarkClock::now();
+        for (size_t shaderIndex = 0; shaderIndex < mSources.size(); shaderIndex++)
+        {
+            serialSuccess = ShCompile(mCompilers[shaderIndex], &mSourcePointers[shaderIndex], 1, CompileOptions) && serialSuccess;
+        }
+        double serialTime = ElapsedMilliseconds(start);
+
+        createCompilers();
+        std::vector<ShCompileJob> jobs(mSources.size());
+        for (size_t shaderIndex = 0; shaderIndex < mSources.size(); shaderIndex++)
+        {
+            ShCompileJob &job = jobs[shaderIndex];
+            job.handle = mCompilers[shaderIndex];
+            job.shaderStrings = &mSourcePointers[shaderIndex];
+            job.numStrings = 1;
+            job.compileOptions = CompileOptions;
+            job.success = false;
+        }
+        start = BenchmarkClock::now();
+        bool batchSuccess = ShCompileBatch(&jobs[0], jobs.size(), 0);
+        double batchTime = ElapsedMilliseconds(start);
+        destroyCompilers();
+
+        checkResult(serialSuccess && batchSuccess, "a shader of the corpus failed to compile");
+        printResult("serial", serialTime, "ms", true);
+        printResult("batch", batchTime, "ms", true);
+    }
+
+  private:
+    void createCompilers()
+    {
+        destroyCompilers();
+        for (size_t shaderIndex = 0; shaderIndex < mSources.size(); shaderIndex++)
+        {
+            const CompilerConfig &config = CompilerConfigs[mConfigIndices[shaderIndex]];
+            mCompilers.push_back(ShConstructCompiler(config.type, config.spec, config.output, &mResources));
+        }
+    }
+
+    void destroyCompilers()
+    {
+        for (size_t index = 0; index < mCompilers.size(); index++)
+        {
+            ShDestruct(mCompilers[index]);
+        }
+        mCompilers.clear();
+    }
+
+    ShBuiltInResources mResources;
+    std::vector<std::string> mSources;
+    std::vector<const char *> mSourcePointers;
+    std::vector<size_t> mConfigIndices;
+    std::vector<ShHandle> mCompilers;
+};
+
+ANGLE_INTERNAL_BENCHMARK(BatchCompileBenchmark);
+
+}
@@ -0,0 +1,85 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// BuiltInSymbolTablePerf.cpp:
+//   Times constructing compilers that build their own built-in symbols and compilers that
+//   share them.
+//
+
+#include "InternalBenchmark.h"
+
+#include "angle_gl.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/BuiltInSymbolTable.h"
+#include "compiler/translator/TranslatorGLSL.h"
+
+namespace
+{
+
+class BuiltInSymbolTableBenchmark : public InternalBenchmark
+{
+  public:
+    BuiltInSymbolTableBenchmark()
+        : InternalBenchmark("BuiltInSymbolTableConstruction")
+    {
+        ShInitBuiltInResources(&mResources);
+        mResources.MaxDrawBuffers = 4;
+    }
+
+    virtual void runBenchmark()
+    {
+        const int compilerCount = 100;
+
+        BenchmarkClock::time_point start = BenchmarkClock::now();
+        for (int index = 0; index < compilerCount; index++)
+        {
+            TBuiltInSymbolTable::ReleaseAll();
+            delete createTranslator();
+        }
+        double unsharedTime = ElapsedMilliseconds(start);
+
+        TBuiltInSymbolTable::ReleaseAll();
+        TBuiltInSymbolTableStatistics before;
+        TBuiltInSymbolTable::GetStatistics(&before);
+
+        std::vector<TranslatorGLSL*> translators;
+        start = BenchmarkClock::now();
+        for (int index = 0; index < compilerCount; index++)
+        {
+            translators.push_back(createTranslator());
+        }
+        double sharedTime = ElapsedMilliseconds(start);
+
+        TBuiltInSymbolTableStatistics after;
+        TBuiltInSymbolTable::GetStatistics(&after);
+        checkResult(after.buildCount - before.buildCount == 1, "the compilers built the built-ins more than once");
+        checkResult(after.reuseCount - before.reuseCount == static_cast<size_t>(compilerCount - 1),
+                    "the compilers did not all share the built-ins");
+
+        for (size_t index = 0; index < translators.size(); index++)
+        {
+            delete translators[index];
+        }
+
+        printResult("unshared_construction", unsharedTime / compilerCount, "ms", true);
+        printResult("shared_construction", sharedTime / compilerCount, "ms", true);
+        printResult("built_in_bytes", after.poolBytes - before.poolBytes, "bytes", false);
+        printResult("saved_bytes", after.savedPoolBytes - before.savedPoolBytes, "bytes", false);
+    }
+
+  private:
+    TranslatorGLSL *createTranslator()
+    {
+        TranslatorGLSL *translator = new TranslatorGLSL(GL_FRAGMENT_SHADER, SH_GLES3_SPEC);
+        checkResult(translator->Init(mResources), "a compiler failed to initialize");
+        return translator;
+    }
+
+    ShBuiltInResources mResources;
+};
+
+ANGLE_INTERNAL_BENCHMARK(BuiltInSymbolTableBenchmark);
+
+}
@@ -0,0 +1,67 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// FormatUtilsPerf.cpp:
+//   Times looking up every sized internal format in the dense tables and in the maps they
+//   replace.
+//
+
+#include "InternalBenchmark.h"
+
+#include "libGLESv2/formatutils.h"
+
+namespace
+{
+
+class FormatUtilsBenchmark : public InternalBenchmark
+{
+  public:
+    FormatUtilsBenchmark()
+        : InternalBenchmark("FormatUtilsLookups")
+    {
+    }
+
+    virtual void runBenchmark()
+    {
+        const int iterations = 1000;
+
+        const gl::priv::InternalFormatInfoMap map = gl::priv::BuildInternalFormatInfoMap();
+        const gl::FormatSet &formatSet = gl::GetAllSizedInternalFormats();
+        std::vector<GLenum> formats(formatSet.begin(), formatSet.end());
+
+        GLuint mapBytes = 0;
+        BenchmarkClock::time_point start = BenchmarkClock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            for (size_t format = 0; format < formats.size(); format++)
+            {
+                mapBytes += map.find(formats[format])->second.pixelBytes;
+            }
+        }
+        double mapTime = ElapsedMilliseconds(start);
+
+        GLuint tableBytes = 0;
+        start = BenchmarkClock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            for (size_t format = 0; format < formats.size(); format++)
+            {
+                tableBytes += gl::GetInternalFormatInfo(formats[format]).pixelBytes;
+            }
+        }
+        double tableTime = ElapsedMilliseconds(start);
+
+        checkResult(mapBytes == tableBytes, "the tables and the maps describe different formats");
+
+        double lookups = static_cast<double>(iterations * formats.size());
+        printResult("internal_formats", formats.size(), "formats", false);
+        printResult("map_lookup", mapTime * 1000000.0 / lookups, "ns", false);
+        printResult("table_lookup", tableTime * 1000000.0 / lookups, "ns", true);
+    }
+};
+
+ANGLE_INTERNAL_BENCHMARK(FormatUtilsBenchmark);
+
+}
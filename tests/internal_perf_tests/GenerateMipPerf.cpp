@@ -0,0 +1,173 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// GenerateMipPerf.cpp:
+//   Builds a full 2048x2048 mip chain one level at a time, with the per-texel and the
+//   vectorized kernels, and with GenerateMipChain, serially and on all hardware threads.
+//
+
+#include "InternalBenchmark.h"
+
+#include "common/WorkerPool.h"
+#include "libGLESv2/renderer/generatemip.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace
+{
+
+// The per-texel 2D kernels only, as GenerateMip used before the vectorized ones
+template <typename T>
+void GenerateMipScalar(size_t sourceWidth, size_t sourceHeight, size_t sourceDepth,
+                       const uint8_t *sourceData, size_t sourceRowPitch, size_t sourceDepthPitch,
+                       uint8_t *destData, size_t destRowPitch, size_t destDepthPitch)
+{
+    size_t mipWidth = std::max<size_t>(1, sourceWidth >> 1);
+    size_t mipHeight = std::max<size_t>(1, sourceHeight >> 1);
+
+    if (sourceWidth > 1 && sourceHeight > 1)
+    {
+        rx::priv::GenerateMip_XY<T>(sourceWidth, sourceHeight, 1, sourceData, sourceRowPitch, 0,
+                                    mipWidth, mipHeight, 1, destData, destRowPitch, 0);
+    }
+    else if (sourceWidth > 1)
+    {
+        rx::priv::GenerateMip_X<T>(sourceWidth, 1, 1, sourceData, sourceRowPitch, 0,
+                                   mipWidth, 1, 1, destData, destRowPitch, 0);
+    }
+    else
+    {
+        rx::priv::GenerateMip_Y<T>(1, sourceHeight, 1, sourceData, sourceRowPitch, 0,
+                                   1, mipHeight, 1, destData, destRowPitch, 0);
+    }
+}
+
+struct MipFormat
+{
+    const char *name;
+    MipGenerationFunction mipFunction;
+    MipGenerationFunction scalarMipFunction;
+    size_t pixelBytes;
+};
+
+const MipFormat mipFormats[] =
+{
+    { "R8",            rx::GenerateMip<rx::R8>,            GenerateMipScalar<rx::R8>,            1 },
+    { "R8G8B8A8",      rx::GenerateMip<rx::R8G8B8A8>,      GenerateMipScalar<rx::R8G8B8A8>,      4 },
+    { "B8G8R8A8",      rx::GenerateMip<rx::B8G8R8A8>,      GenerateMipScalar<rx::B8G8R8A8>,      4 },
+    { "R16G16B16A16F", rx::GenerateMip<rx::R16G16B16A16F>, GenerateMipScalar<rx::R16G16B16A16F>, 8 },
+    { "R11G11B10F",    rx::GenerateMip<rx::R11G11B10F>,    GenerateMipScalar<rx::R11G11B10F>,    4 },
+};
+
+// Storage for a full 2D mip chain with a random base level
+struct MipChain
+{
+    MipChain(const MipFormat &format, size_t width, size_t height)
+    {
+        size_t levelWidth = width;
+        size_t levelHeight = height;
+        while (true)
+        {
+            widths.push_back(levelWidth);
+            heights.push_back(levelHeight);
+            rowPitches.push_back(levelWidth * format.pixelBytes);
+            levels.push_back(std::vector<uint8_t>(rowPitches.back() * levelHeight, 0));
+
+            if (levelWidth == 1 && levelHeight == 1)
+            {
+                break;
+            }
+            levelWidth = std::max<size_t>(1, levelWidth >> 1);
+            levelHeight = std::max<size_t>(1, levelHeight >> 1);
+        }
+
+        for (size_t i = 0; i < levels[0].size(); i++)
+        {
+            levels[0][i] = static_cast<uint8_t>(rand());
+        }
+    }
+
+    void generateByLevel(MipGenerationFunction mipFunction)
+    {
+        for (size_t level = 1; level < levels.size(); level++)
+        {
+            mipFunction(widths[level - 1], heights[level - 1], 1,
+                        &levels[level - 1][0], rowPitches[level - 1], 0,
+                        &levels[level][0], rowPitches[level], 0);
+        }
+    }
+
+    void generateChain(const MipFormat &format, gl::WorkerPool *pool)
+    {
+        std::vector<uint8_t*> levelData;
+        for (size_t level = 1; level < levels.size(); level++)
+        {
+            levelData.push_back(&levels[level][0]);
+        }
+
+        rx::GenerateMipChain(pool, format.mipFunction, format.pixelBytes, widths[0], heights[0],
+                             &levels[0][0], rowPitches[0], levelData.size(), &levelData[0], &rowPitches[1]);
+    }
+
+    std::vector<size_t> widths;
+    std::vector<size_t> heights;
+    std::vector<size_t> rowPitches;
+    std::vector<std::vector<uint8_t> > levels;
+};
+
+class GenerateMipBenchmark : public InternalBenchmark
+{
+  public:
+    GenerateMipBenchmark()
+        : InternalBenchmark("GenerateMipChain2048")
+    {
+    }
+
+    virtual void runBenchmark()
+    {
+        const int iterations = 10;
+        gl::WorkerPool pool(gl::WorkerPool::GetHardwareThreadCount());
+
+        for (size_t formatIndex = 0; formatIndex < ArraySize(mipFormats); formatIndex++)
+        {
+            const MipFormat &format = mipFormats[formatIndex];
+            const std::string name = format.name;
+            MipChain chain(format, 2048, 2048);
+
+            BenchmarkClock::time_point start = BenchmarkClock::now();
+            for (int i = 0; i < iterations; i++)
+            {
+                chain.generateByLevel(format.scalarMipFunction);
+            }
+            printResult(name + "_scalar_by_level", ElapsedMilliseconds(start) / iterations, "ms", false);
+
+            start = BenchmarkClock::now();
+            for (int i = 0; i < iterations; i++)
+            {
+                chain.generateByLevel(format.mipFunction);
+            }
+            printResult(name + "_by_level", ElapsedMilliseconds(start) / iterations, "ms", true);
+
+            start = BenchmarkClock::now();
+            for (int i = 0; i < iterations; i++)
+            {
+                chain.generateChain(format, NULL);
+            }
+            printResult(name + "_tiled", ElapsedMilliseconds(start) / iterations, "ms", true);
+
+            start = BenchmarkClock::now();
+            for (int i = 0; i < iterations; i++)
+            {
+                chain.generateChain(format, &pool);
+            }
+            printResult(name + "_tiled_parallel", ElapsedMilliseconds(start) / iterations, "ms", true);
+        }
+    }
+};
+
+ANGLE_INTERNAL_BENCHMARK(GenerateMipBenchmark);
+
+}
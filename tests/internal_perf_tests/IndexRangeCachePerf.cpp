@@ -0,0 +1,132 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// IndexRangeCachePerf.cpp:
+//   Times the index range queries of the IndexDataRanges perf test, which draws random
+//   sub-ranges of a 1M index buffer and updates 256 bytes of it every frame, with the block
+//   summary and with the exact (type, offset, count) map it replaces, which scans the range on
+//   every miss. The perf test only reaches the cache through draw calls, which always use the
+//   summary.
+//
+
+#include "InternalBenchmark.h"
+
+#include "libGLESv2/renderer/IndexRangeCache.h"
+
+#include <cstdlib>
+
+namespace
+{
+
+struct IndexType
+{
+    GLenum type;
+    const char *name;
+    unsigned int bytes;
+};
+
+const IndexType indexTypes[] =
+{
+    { GL_UNSIGNED_BYTE,  "ubyte",  1 },
+    { GL_UNSIGNED_SHORT, "ushort", 2 },
+    { GL_UNSIGNED_INT,   "uint",   4 },
+};
+
+class IndexRangeCacheBenchmark : public InternalBenchmark
+{
+  public:
+    IndexRangeCacheBenchmark()
+        : InternalBenchmark("IndexRangeCacheLookups")
+    {
+    }
+
+    virtual void runBenchmark()
+    {
+        for (size_t typeIndex = 0; typeIndex < ArraySize(indexTypes); typeIndex++)
+        {
+            runType(indexTypes[typeIndex]);
+        }
+    }
+
+  private:
+    void runType(const IndexType &indexType)
+    {
+        const size_t indexCount = 1024 * 1024;
+        const size_t maxDrawCount = 64 * 1024;
+        const size_t drawsPerFrame = 100;
+        const size_t frameCount = 100;
+        const unsigned int updateSize = 256;
+
+        std::vector<uint8_t> data(indexCount * indexType.bytes);
+        for (size_t i = 0; i < data.size(); i++)
+        {
+            data[i] = static_cast<uint8_t>(rand());
+        }
+
+        std::vector<unsigned int> drawOffsets;
+        std::vector<GLsizei> drawCounts;
+        for (size_t draw = 0; draw < 4096; draw++)
+        {
+            size_t count = 1 + rand() % maxDrawCount;
+            size_t first = rand() % (indexCount - count + 1);
+            drawOffsets.push_back(static_cast<unsigned int>(first * indexType.bytes));
+            drawCounts.push_back(static_cast<GLsizei>(count));
+        }
+
+        std::vector<unsigned int> updateOffsets;
+        for (size_t frame = 0; frame < frameCount; frame++)
+        {
+            updateOffsets.push_back(static_cast<unsigned int>(rand() % (data.size() - updateSize + 1)));
+        }
+
+        rx::IndexRangeCache mapCache;
+        unsigned int mapSum = 0;
+        size_t nextDraw = 0;
+        BenchmarkClock::time_point start = BenchmarkClock::now();
+        for (size_t frame = 0; frame < frameCount; frame++)
+        {
+            mapCache.invalidateRange(updateOffsets[frame], updateSize);
+            for (size_t draw = 0; draw < drawsPerFrame; draw++, nextDraw = (nextDraw + 1) % drawOffsets.size())
+            {
+                unsigned int offset = drawOffsets[nextDraw];
+                GLsizei count = drawCounts[nextDraw];
+
+                rx::RangeUI range;
+                if (!mapCache.findRange(indexType.type, offset, count, &range, NULL))
+                {
+                    range = rx::IndexRangeCache::ComputeRange(indexType.type, &data[offset], count);
+                    mapCache.addRange(indexType.type, offset, count, range, offset);
+                }
+                mapSum += range.start + range.end;
+            }
+        }
+        double mapTime = ElapsedMilliseconds(start);
+
+        rx::IndexRangeCache summaryCache;
+        unsigned int summarySum = 0;
+        nextDraw = 0;
+        start = BenchmarkClock::now();
+        for (size_t frame = 0; frame < frameCount; frame++)
+        {
+            summaryCache.invalidateRange(updateOffsets[frame], updateSize);
+            for (size_t draw = 0; draw < drawsPerFrame; draw++, nextDraw = (nextDraw + 1) % drawOffsets.size())
+            {
+                rx::RangeUI range = summaryCache.computeRange(indexType.type, &data[0], data.size(),
+                                                              drawOffsets[nextDraw], drawCounts[nextDraw]);
+                summarySum += range.start + range.end;
+            }
+        }
+        double summaryTime = ElapsedMilliseconds(start);
+
+        const std::string name = indexType.name;
+        checkResult(mapSum == summarySum, name + " ranges of the map and the block summary differ");
+        printResult(name + "_range_map", mapTime / frameCount, "ms", false);
+        printResult(name + "_block_summary", summaryTime / frameCount, "ms", true);
+    }
+};
+
+ANGLE_INTERNAL_BENCHMARK(IndexRangeCacheBenchmark);
+
+}
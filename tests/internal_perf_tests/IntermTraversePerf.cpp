@@ -0,0 +1,185 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// IntermTraversePerf.cpp:
+//   Times default, iterative and recursive traversals of expressions of increasing depth, and
+//   only the first two for a 100000 deep expression, which the recursive traversal may not
+//   survive.
+//
+
+#include "InternalBenchmark.h"
+
+#include "angle_gl.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/TranslatorESSL.h"
+
+#include <sstream>
+
+namespace
+{
+
+class NodeCountTraverser : public TIntermTraverser
+{
+  public:
+    NodeCountTraverser(bool iterative)
+        : TIntermTraverser(true, true, true, false, iterative),
+          mNodeCount(0)
+    {
+    }
+
+    virtual void visitSymbol(TIntermSymbol *) { mNodeCount++; }
+    virtual void visitConstantUnion(TIntermConstantUnion *) { mNodeCount++; }
+    virtual bool visitBinary(Visit visit, TIntermBinary *) { return count(visit); }
+    virtual bool visitUnary(Visit visit, TIntermUnary *) { return count(visit); }
+    virtual bool visitAggregate(Visit visit, TIntermAggregate *) { return count(visit); }
+
+    size_t nodeCount() const { return mNodeCount; }
+
+  private:
+    bool count(Visit visit)
+    {
+        if (visit == PreVisit)
+            mNodeCount++;
+        return true;
+    }
+
+    size_t mNodeCount;
+};
+
+// Times node counting traversals of the tree it translates, in nanoseconds per node.
+class TimingTranslator : public TranslatorESSL
+{
+  public:
+    TimingTranslator(bool recursive)
+        : TranslatorESSL(GL_FRAGMENT_SHADER, SH_GLES2_SPEC),
+          mRecursive(recursive),
+          mNodeCount(0),
+          mMixedTime(0.0),
+          mIterativeTime(0.0),
+          mRecursiveTime(0.0)
+    {
+    }
+
+    size_t nodeCount() const { return mNodeCount; }
+    double mixedTime() const { return mMixedTime; }
+    double iterativeTime() const { return mIterativeTime; }
+    double recursiveTime() const { return mRecursiveTime; }
+
+  protected:
+    virtual void translate(TIntermNode *root)
+    {
+        const int traversalCount = 20;
+
+        BenchmarkClock::time_point start = BenchmarkClock::now();
+        for (int traversal = 0; traversal < traversalCount; traversal++)
+        {
+            NodeCountTraverser traverser(true);
+            root->traverse(&traverser);
+            mNodeCount = traverser.nodeCount();
+        }
+        mMixedTime = perNode(ElapsedMilliseconds(start), traversalCount);
+
+        start = BenchmarkClock::now();
+        for (int traversal = 0; traversal < traversalCount; traversal++)
+        {
+            NodeCountTraverser traverser(true);
+            traverser.traverseIteratively(root);
+        }
+        mIterativeTime = perNode(ElapsedMilliseconds(start), traversalCount);
+
+        if (mRecursive)
+        {
+            start = BenchmarkClock::now();
+            for (int traversal = 0; traversal < traversalCount; traversal++)
+            {
+                NodeCountTraverser traverser(false);
+                root->traverse(&traverser);
+            }
+            mRecursiveTime = perNode(ElapsedMilliseconds(start), traversalCount);
+        }
+    }
+
+  private:
+    double perNode(double milliseconds, int traversalCount) const
+    {
+        return milliseconds * 1000000.0 / (traversalCount * mNodeCount);
+    }
+
+    bool mRecursive;
+    size_t mNodeCount;
+    double mMixedTime;
+    double mIterativeTime;
+    double mRecursiveTime;
+};
+
+// An expression nested |depth| binary operators deep.
+std::string MakeDeepExpressionShader(int depth)
+{
+    std::ostringstream stream;
+    stream << "precision mediump float;\n"
+              "uniform float u;\n"
+              "void main() {\n"
+              "    float f = u";
+    for (int term = 0; term < depth; term++)
+    {
+        stream << (term % 2 ? " + u" : " * 2.0");
+    }
+    stream << ";\n"
+              "    gl_FragColor = vec4(f);\n"
+              "}\n";
+    return stream.str();
+}
+
+class IntermTraverseBenchmark : public InternalBenchmark
+{
+  public:
+    IntermTraverseBenchmark()
+        : InternalBenchmark("IntermTraverseDeepExpressions")
+    {
+        ShInitBuiltInResources(&mResources);
+    }
+
+    virtual void runBenchmark()
+    {
+        const int depths[] = { 100, 1000, 10000 };
+        for (size_t depthIndex = 0; depthIndex < ArraySize(depths); depthIndex++)
+        {
+            runDepth(depths[depthIndex], true);
+        }
+
+        runDepth(100000, false);
+    }
+
+  private:
+    void runDepth(int depth, bool recursive)
+    {
+        std::ostringstream trace;
+        trace << depth << "_deep";
+
+        TimingTranslator translator(recursive);
+        std::string shaderString = MakeDeepExpressionShader(depth);
+        const char *shaderStrings[] = { shaderString.c_str() };
+        bool compiled = translator.Init(mResources) && translator.compile(shaderStrings, 1, SH_OBJECT_CODE);
+        checkResult(compiled && translator.nodeCount() > 0, "the " + trace.str() + " expression failed to compile");
+        if (!compiled)
+        {
+            return;
+        }
+
+        printResult(trace.str() + "_nodes", translator.nodeCount(), "nodes", false);
+        printResult(trace.str() + "_default", translator.mixedTime(), "ns", true);
+        printResult(trace.str() + "_iterative", translator.iterativeTime(), "ns", true);
+        if (recursive)
+        {
+            printResult(trace.str() + "_recursive", translator.recursiveTime(), "ns", true);
+        }
+    }
+
+    ShBuiltInResources mResources;
+};
+
+ANGLE_INTERNAL_BENCHMARK(IntermTraverseBenchmark);
+
+}
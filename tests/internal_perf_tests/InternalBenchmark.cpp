@@ -0,0 +1,65 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "InternalBenchmark.h"
+
+#include "perf_tests/third_party/perf/perf_test.h"
+
+#include <iostream>
+
+namespace
+{
+
+std::vector<InternalBenchmarkFactory> &Benchmarks()
+{
+    static std::vector<InternalBenchmarkFactory> benchmarks;
+    return benchmarks;
+}
+
+}
+
+InternalBenchmark::InternalBenchmark(const std::string &name)
+    : mName(name),
+      mMatched(true)
+{
+}
+
+bool InternalBenchmark::run()
+{
+    mMatched = true;
+    runBenchmark();
+    return mMatched;
+}
+
+void InternalBenchmark::printResult(const std::string &trace, double value, const std::string &units, bool important) const
+{
+    perf_test::PrintResult(mName, "", trace, value, units, important);
+}
+
+void InternalBenchmark::printResult(const std::string &trace, size_t value, const std::string &units, bool important) const
+{
+    perf_test::PrintResult(mName, "", trace, value, units, important);
+}
+
+void InternalBenchmark::checkResult(bool matches, const std::string &message)
+{
+    if (!matches)
+    {
+        std::cerr << mName << ": " << message << std::endl;
+        mMatched = false;
+    }
+}
+
+bool RegisterInternalBenchmark(InternalBenchmarkFactory factory)
+{
+    Benchmarks().push_back(factory);
+    return true;
+}
+
+const std::vector<InternalBenchmarkFactory> &GetInternalBenchmarks()
+{
+    return Benchmarks();
+}
@@ -0,0 +1,71 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// InternalBenchmark.h:
+//   Base class of the benchmarks of ANGLE internals, the translator and the implementation
+//   classes, that can't be reached through the GL entry points the perf tests use.
+//
+
+#ifndef INTERNAL_PERF_TESTS_INTERNAL_BENCHMARK_H
+#define INTERNAL_PERF_TESTS_INTERNAL_BENCHMARK_H
+
+#include "common/angleutils.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+typedef std::chrono::high_resolution_clock BenchmarkClock;
+
+// Milliseconds since start
+inline double ElapsedMilliseconds(BenchmarkClock::time_point start)
+{
+    std::chrono::duration<double, std::milli> elapsed = BenchmarkClock::now() - start;
+    return elapsed.count();
+}
+
+class InternalBenchmark
+{
+  public:
+    explicit InternalBenchmark(const std::string &name);
+    virtual ~InternalBenchmark() { }
+
+    // Returns false if the variants the benchmark compares computed different results
+    bool run();
+
+    const std::string &getName() const { return mName; }
+
+  protected:
+    virtual void runBenchmark() = 0;
+
+    void printResult(const std::string &trace, double value, const std::string &units, bool important) const;
+    void printResult(const std::string &trace, size_t value, const std::string &units, bool important) const;
+
+    // Reports a mismatch between two ways of computing the same thing, which fails the run
+    void checkResult(bool matches, const std::string &message);
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(InternalBenchmark);
+
+    std::string mName;
+    bool mMatched;
+};
+
+typedef InternalBenchmark *(*InternalBenchmarkFactory)();
+
+bool RegisterInternalBenchmark(InternalBenchmarkFactory factory);
+const std::vector<InternalBenchmarkFactory> &GetInternalBenchmarks();
+
+template <typename BenchmarkT>
+InternalBenchmark *CreateInternalBenchmark()
+{
+    return new BenchmarkT();
+}
+
+// Adds a benchmark class, default constructible, to those angle_internal_perf_tests runs
+#define ANGLE_INTERNAL_BENCHMARK(BenchmarkT) \
+    static const bool BenchmarkT ## Registered = RegisterInternalBenchmark(CreateInternalBenchmark<BenchmarkT>)
+
+#endif // INTERNAL_PERF_TESTS_INTERNAL_BENCHMARK_H
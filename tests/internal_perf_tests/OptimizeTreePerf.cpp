@@ -0,0 +1,129 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// OptimizeTreePerf.cpp:
+//   Compares the size of the translated code of library shaders, with and without
+//   SH_OPTIMIZE, for each output, and the time it takes to translate them. The time it takes
+//   the translator to compile the ESSL output again stands in for the time the driver takes to
+//   compile it.
+//
+
+#include "InternalBenchmark.h"
+
+#include "angle_gl.h"
+#include "GLSLANG/ShaderLang.h"
+
+#include <sstream>
+
+namespace
+{
+
+// A shader that includes a library of |functionCount| functions, and a few
+// settings, of which it uses little.
+std::string MakeLibraryShader(int functionCount)
+{
+    std::ostringstream stream;
+    stream << "precision mediump float;\n"
+              "uniform vec4 u;\n"
+              "uniform sampler2D s;\n";
+    for (int function = 0; function < functionCount; function++)
+    {
+        stream << "vec4 library" << function << "(vec4 a) {\n"
+                  "    vec4 t = texture2D(s, a.xy) * " << function << ".0;\n"
+                  "    float unused = dot(t, a);\n"
+                  "    return t + a;\n"
+                  "}\n";
+    }
+    stream << "void main() {\n"
+              "    const float kScale = 2.0;\n"
+              "    float scale = kScale * 0.5;\n"
+              "    bool useFog = false;\n"
+              "    vec4 color = library0(u) * scale;\n"
+              "    if (useFog) {\n"
+              "        color = library1(color);\n"
+              "    }\n"
+              "    gl_FragColor = color;\n"
+              "}\n";
+    return stream.str();
+}
+
+class OptimizeTreeBenchmark : public InternalBenchmark
+{
+  public:
+    OptimizeTreeBenchmark()
+        : InternalBenchmark("OptimizeTreeLibraryShaders")
+    {
+        ShInitBuiltInResources(&mResources);
+    }
+
+    virtual void runBenchmark()
+    {
+        const ShShaderOutput outputs[] = { SH_ESSL_OUTPUT, SH_GLSL_OUTPUT, SH_HLSL11_OUTPUT };
+        const char *outputNames[] = { "essl", "glsl", "hlsl11" };
+        const int functionCounts[] = { 10, 100 };
+
+        ShHandle esslCompiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_ESSL_OUTPUT, &mResources);
+        for (size_t outputIndex = 0; outputIndex < ArraySize(outputs); outputIndex++)
+        {
+            ShHandle compiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC, outputs[outputIndex], &mResources);
+            for (size_t countIndex = 0; countIndex < ArraySize(functionCounts); countIndex++)
+            {
+                for (int optimized = 0; optimized < 2; optimized++)
+                {
+                    std::ostringstream trace;
+                    trace << outputNames[outputIndex] << "_" << functionCounts[countIndex] << "_functions"
+                          << (optimized ? "_optimized" : "");
+                    runShader(compiler, esslCompiler, trace.str(), MakeLibraryShader(functionCounts[countIndex]),
+                              optimized != 0, outputs[outputIndex] == SH_ESSL_OUTPUT);
+                }
+            }
+            ShDestruct(compiler);
+        }
+        ShDestruct(esslCompiler);
+    }
+
+  private:
+    void runShader(ShHandle compiler, ShHandle esslCompiler, const std::string &trace, const std::string &shaderString,
+                   bool optimized, bool compileOutput)
+    {
+        const int compileCount = 100;
+        const int compileOptions = SH_OBJECT_CODE | SH_VARIABLES | (optimized ? SH_OPTIMIZE : 0);
+
+        const char *shaderStrings[] = { shaderString.c_str() };
+        bool compiled = true;
+        BenchmarkClock::time_point start = BenchmarkClock::now();
+        for (int compile = 0; compile < compileCount; compile++)
+        {
+            compiled = ShCompile(compiler, shaderStrings, 1, compileOptions) && compiled;
+        }
+        double translateTime = ElapsedMilliseconds(start);
+        checkResult(compiled, trace + " failed to translate");
+        std::string objectCode = ShGetObjectCode(compiler);
+
+        printResult(trace + "_size", objectCode.size(), "bytes", true);
+        printResult(trace + "_translate", translateTime * 1000.0 / compileCount, "us", true);
+
+        if (compileOutput)
+        {
+            const char *objectCodeStrings[] = { objectCode.c_str() };
+            compiled = true;
+            start = BenchmarkClock::now();
+            for (int compile = 0; compile < compileCount; compile++)
+            {
+                compiled = ShCompile(esslCompiler, objectCodeStrings, 1, SH_OBJECT_CODE) && compiled;
+            }
+            double outputTime = ElapsedMilliseconds(start);
+            checkResult(compiled, "the output of " + trace + " failed to compile");
+
+            printResult(trace + "_compile_output", outputTime * 1000.0 / compileCount, "us", true);
+        }
+    }
+
+    ShBuiltInResources mResources;
+};
+
+ANGLE_INTERNAL_BENCHMARK(OptimizeTreeBenchmark);
+
+}
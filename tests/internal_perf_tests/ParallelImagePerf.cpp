@@ -0,0 +1,68 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ParallelImagePerf.cpp:
+//   Times a 4096x4096 RGB8 upload through LoadImageParallel for every thread count up to the
+//   hardware thread count.
+//
+
+#include "InternalBenchmark.h"
+
+#include "common/WorkerPool.h"
+#include "libGLESv2/renderer/loadimage.h"
+#include "libGLESv2/renderer/parallelimage.h"
+
+#include <cstdlib>
+#include <sstream>
+
+namespace
+{
+
+class ParallelImageBenchmark : public InternalBenchmark
+{
+  public:
+    ParallelImageBenchmark()
+        : InternalBenchmark("ParallelImageLoad4096")
+    {
+    }
+
+    virtual void runBenchmark()
+    {
+        const size_t width = 4096;
+        const size_t height = 4096;
+        const int iterations = 10;
+
+        std::vector<uint8_t> input(width * height * 3);
+        for (size_t i = 0; i < input.size(); i++)
+        {
+            input[i] = static_cast<uint8_t>(rand());
+        }
+        std::vector<uint8_t> output(width * height * 4);
+
+        size_t maxThreads = gl::WorkerPool::GetHardwareThreadCount();
+        for (size_t threadCount = 1; threadCount <= maxThreads; threadCount++)
+        {
+            gl::WorkerPool pool(threadCount);
+
+            BenchmarkClock::time_point start = BenchmarkClock::now();
+            for (int i = 0; i < iterations; i++)
+            {
+                rx::LoadImageParallel(&pool, rx::LoadRGB8ToBGRX8, 1, width, height, 1,
+                                      &input[0], width * 3, 0, &output[0], width * 4, 0);
+            }
+            double milliseconds = ElapsedMilliseconds(start);
+
+            std::ostringstream trace;
+            trace << threadCount << "_threads";
+            double megabytes = static_cast<double>(output.size() * iterations) / (1024.0 * 1024.0);
+            printResult(trace.str() + "_upload_time", milliseconds / iterations, "ms", true);
+            printResult(trace.str() + "_throughput", megabytes * 1000.0 / milliseconds, "MB/s", false);
+        }
+    }
+};
+
+ANGLE_INTERNAL_BENCHMARK(ParallelImageBenchmark);
+
+}
@@ -0,0 +1,164 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PassManagerPerf.cpp:
+//   Times running eight read-only passes over a large shader one walk at a time and in one
+//   shared walk.
+//
+
+#include "InternalBenchmark.h"
+
+#include "angle_gl.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/PassManager.h"
+#include "compiler/translator/TranslatorESSL.h"
+
+#include <sstream>
+
+namespace
+{
+
+const int kPassCount = 8;
+
+// A read-only pass that only counts the nodes it visits.
+class CountingTraverser : public TIntermTraverser
+{
+  public:
+    CountingTraverser(bool inVisit, bool postVisit)
+        : TIntermTraverser(true, inVisit, postVisit, false),
+          mVisitCount(0)
+    {
+    }
+
+    virtual void visitSymbol(TIntermSymbol *) { mVisitCount++; }
+    virtual void visitConstantUnion(TIntermConstantUnion *) { mVisitCount++; }
+    virtual bool visitBinary(Visit, TIntermBinary *) { return count(); }
+    virtual bool visitUnary(Visit, TIntermUnary *) { return count(); }
+    virtual bool visitSelection(Visit, TIntermSelection *) { return count(); }
+    virtual bool visitAggregate(Visit, TIntermAggregate *) { return count(); }
+    virtual bool visitLoop(Visit, TIntermLoop *) { return count(); }
+    virtual bool visitBranch(Visit, TIntermBranch *) { return count(); }
+
+  private:
+    bool count()
+    {
+        mVisitCount++;
+        return true;
+    }
+
+    size_t mVisitCount;
+};
+
+// Times counting passes over the tree it translates, each in a walk of its own and all in a
+// shared walk, in microseconds per run of all the passes.
+class TimingTranslator : public TranslatorESSL
+{
+  public:
+    TimingTranslator()
+        : TranslatorESSL(GL_FRAGMENT_SHADER, SH_GLES2_SPEC),
+          mSeparateTime(0.0),
+          mFusedTime(0.0),
+          mWalkCount(0)
+    {
+    }
+
+    double separateTime() const { return mSeparateTime; }
+    double fusedTime() const { return mFusedTime; }
+    size_t walkCount() const { return mWalkCount; }
+
+  protected:
+    virtual void translate(TIntermNode *root)
+    {
+        const int runCount = 50;
+
+        BenchmarkClock::time_point start = BenchmarkClock::now();
+        for (int run = 0; run < runCount; run++)
+        {
+            for (int index = 0; index < kPassCount; index++)
+            {
+                TPassManager passes;
+                passes.addPass(createPass(index), SH_COMPILE_PHASE_TRANSLATE);
+                passes.run(root);
+            }
+        }
+        mSeparateTime = ElapsedMilliseconds(start) * 1000.0 / runCount;
+
+        start = BenchmarkClock::now();
+        for (int run = 0; run < runCount; run++)
+        {
+            TPassManager passes;
+            for (int index = 0; index < kPassCount; index++)
+            {
+                passes.addPass(createPass(index), SH_COMPILE_PHASE_TRANSLATE);
+            }
+            passes.run(root);
+            mWalkCount = passes.getWalkCount();
+        }
+        mFusedTime = ElapsedMilliseconds(start) * 1000.0 / runCount;
+    }
+
+  private:
+    TIntermTraverser *createPass(int index)
+    {
+        return new CountingTraverser(index % 2 == 1, index % 3 != 0);
+    }
+
+    double mSeparateTime;
+    double mFusedTime;
+    size_t mWalkCount;
+};
+
+std::string MakeShader(int functionCount)
+{
+    std::ostringstream stream;
+    stream << "precision mediump float;\n"
+              "uniform vec4 u;\n";
+    for (int function = 0; function < functionCount; function++)
+    {
+        stream << "vec4 f" << function << "(vec4 a) {\n"
+                  "    vec4 r = a;\n"
+                  "    for (int i = 0; i < 4; i++) { r = r * u + vec4(" << function << ".0); }\n"
+                  "    return r.x > 0.5 ? r : -r;\n"
+                  "}\n";
+    }
+    stream << "void main() {\n"
+              "    vec4 r = u;\n";
+    for (int function = 0; function < functionCount; function++)
+    {
+        stream << "    r = f" << function << "(r);\n";
+    }
+    stream << "    gl_FragColor = r;\n"
+              "}\n";
+    return stream.str();
+}
+
+class PassManagerBenchmark : public InternalBenchmark
+{
+  public:
+    PassManagerBenchmark()
+        : InternalBenchmark("PassManagerFusedWalks")
+    {
+    }
+
+    virtual void runBenchmark()
+    {
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+
+        TimingTranslator translator;
+        std::string shaderString = MakeShader(200);
+        const char *shaderStrings[] = { shaderString.c_str() };
+        bool compiled = translator.Init(resources) && translator.compile(shaderStrings, 1, SH_OBJECT_CODE);
+        checkResult(compiled, "the shader failed to compile");
+        checkResult(translator.walkCount() == 1, "the passes did not share one walk");
+
+        printResult("separate_walks", translator.separateTime(), "us", true);
+        printResult("fused_walk", translator.fusedTime(), "us", true);
+    }
+};
+
+ANGLE_INTERNAL_BENCHMARK(PassManagerBenchmark);
+
+}
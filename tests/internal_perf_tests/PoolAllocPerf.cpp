@@ -0,0 +1,104 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PoolAllocPerf.cpp:
+//   Times compiling the same shader 10000 times on one compiler, and on a new compiler for
+//   every 100 compiles, with and without the process-wide pool page cache.
+//
+
+#include "InternalBenchmark.h"
+
+#include "angle_gl.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/PoolAlloc.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace
+{
+
+std::string MakeShader(int functionCount)
+{
+    std::ostringstream stream;
+    stream << "precision mediump float;\n"
+              "uniform vec4 u;\n";
+    for (int function = 0; function < functionCount; function++)
+    {
+        stream << "vec4 f" << function << "(vec4 a) { return a * u + vec4(" << function << ".0); }\n";
+    }
+    stream << "void main() {\n"
+              "    vec4 r = u;\n";
+    for (int function = 0; function < functionCount; function++)
+    {
+        stream << "    r = f" << function << "(r);\n";
+    }
+    stream << "    gl_FragColor = r;\n"
+              "}\n";
+    return stream.str();
+}
+
+class PoolAllocBenchmark : public InternalBenchmark
+{
+  public:
+    PoolAllocBenchmark()
+        : InternalBenchmark("PoolAllocRepeatedCompiles")
+    {
+        ShInitBuiltInResources(&mResources);
+    }
+
+    virtual void runBenchmark()
+    {
+        const int compileCount = 10000;
+        const int compilesPerCompiler[] = { compileCount, 100 };
+        std::string shaderString = MakeShader(20);
+        const char *shaderStrings[] = { shaderString.c_str() };
+
+        bool success = true;
+        for (int cached = 0; cached < 2; cached++)
+        {
+            TPoolPageCache::SetEnabled(cached != 0);
+            for (size_t modeIndex = 0; modeIndex < ArraySize(compilesPerCompiler); modeIndex++)
+            {
+                TPoolPageCache::Trim();
+                TPoolPageCacheStatistics before = TPoolPageCache::GetStatistics();
+                size_t peakBytes = 0;
+
+                BenchmarkClock::time_point start = BenchmarkClock::now();
+                for (int compileIndex = 0; compileIndex < compileCount; compileIndex += compilesPerCompiler[modeIndex])
+                {
+                    ShHandle compiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_GLSL_OUTPUT, &mResources);
+                    for (int repeat = 0; repeat < compilesPerCompiler[modeIndex]; repeat++)
+                    {
+                        ShCompileStatistics statistics;
+                        success = ShCompile(compiler, shaderStrings, 1, SH_OBJECT_CODE) && success;
+                        success = ShGetCompileStatistics(compiler, &statistics) && success;
+                        peakBytes = std::max(peakBytes, statistics.poolPeakBytes);
+                    }
+                    ShDestruct(compiler);
+                }
+                double time = ElapsedMilliseconds(start);
+
+                TPoolPageCacheStatistics after = TPoolPageCache::GetStatistics();
+                std::ostringstream trace;
+                trace << compilesPerCompiler[modeIndex] << "_compiles_per_compiler" << (cached ? "_cached" : "");
+                printResult(trace.str(), time * 1000.0 / compileCount, "us", true);
+                printResult(trace.str() + "_peak_pool", peakBytes, "bytes", false);
+                printResult(trace.str() + "_cache_hits", after.hitCount - before.hitCount, "blocks", false);
+                printResult(trace.str() + "_os_blocks", after.missCount - before.missCount, "blocks", false);
+            }
+        }
+        TPoolPageCache::SetEnabled(true);
+
+        checkResult(success, "the shader failed to compile");
+    }
+
+  private:
+    ShBuiltInResources mResources;
+};
+
+ANGLE_INTERNAL_BENCHMARK(PoolAllocBenchmark);
+
+}
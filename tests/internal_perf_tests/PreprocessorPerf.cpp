@@ -0,0 +1,157 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PreprocessorPerf.cpp:
+//   Times preprocessing macro-heavy shaders of increasing size, with and without the macro
+//   expansion cache, and reports the tokens and bytes preprocessed per second.
+//
+
+#include "InternalBenchmark.h"
+
+#include "compiler/preprocessor/DiagnosticsBase.h"
+#include "compiler/preprocessor/DirectiveHandlerBase.h"
+#include "compiler/preprocessor/Macro.h"
+#include "compiler/preprocessor/Preprocessor.h"
+#include "compiler/preprocessor/Token.h"
+
+#include <sstream>
+
+namespace
+{
+
+// A shader in the style of generated material and lighting code: small function-like
+// macros that expand other macros, both in their bodies and in their arguments.
+std::string MakeMacroHeavyShader(int lineCount)
+{
+    std::ostringstream stream;
+    stream << "#define SCALE 0.5\n"
+              "#define ADD(a, b) ((a) + (b))\n"
+              "#define MUL(a, b) ((a) * (b))\n"
+              "#define MAD(a, b, c) ADD(MUL(a, b), c)\n"
+              "#define LERP(a, b, t) MAD(ADD(b, -(a)), t, a)\n"
+              "#define HALF_COLOR vec4(SCALE, SCALE, SCALE, 1.0)\n"
+              "#define SAMPLE_WEIGHTED(weight, offset) MUL(texture2D(s, uv + offset), weight)\n";
+    for (int line = 0; line < lineCount; line++)
+    {
+        stream << "c = LERP(c, HALF_COLOR, MAD(t, SCALE, " << line << ".0)) + "
+                  "SAMPLE_WEIGHTED(SCALE, vec2(" << line << ".0, SCALE));\n";
+    }
+    return stream.str();
+}
+
+class CountingDiagnostics : public pp::Diagnostics
+{
+  public:
+    CountingDiagnostics()
+        : mCount(0)
+    {
+    }
+
+    size_t count() const { return mCount; }
+
+  protected:
+    virtual void print(ID id, const pp::SourceLocation &loc, const std::string &text)
+    {
+        mCount++;
+    }
+
+  private:
+    size_t mCount;
+};
+
+class IgnoringDirectiveHandler : public pp::DirectiveHandler
+{
+  public:
+    virtual void handleError(const pp::SourceLocation &loc, const std::string &msg) {}
+    virtual void handlePragma(const pp::SourceLocation &loc, const std::string &name,
+                              const std::string &value, bool stdgl) {}
+    virtual void handleExtension(const pp::SourceLocation &loc, const std::string &name,
+                                 const std::string &behavior) {}
+    virtual void handleVersion(const pp::SourceLocation &loc, int version) {}
+};
+
+class PreprocessorBenchmark : public InternalBenchmark
+{
+  public:
+    PreprocessorBenchmark()
+        : InternalBenchmark("PreprocessorMacroHeavyShaders")
+    {
+    }
+
+    virtual void runBenchmark()
+    {
+        const int lineCounts[] = { 100, 1000, 10000 };
+        for (size_t countIndex = 0; countIndex < ArraySize(lineCounts); countIndex++)
+        {
+            runLineCount(lineCounts[countIndex]);
+        }
+
+        checkResult(mDiagnostics.count() == 0, "the shaders were preprocessed with diagnostics");
+    }
+
+  private:
+    // Returns the number of tokens produced for the input.
+    size_t lexAll(pp::Preprocessor *preprocessor, const char *input)
+    {
+        if (!preprocessor->init(1, &input, NULL))
+        {
+            return 0;
+        }
+
+        size_t tokenCount = 0;
+        pp::Token token;
+        do
+        {
+            preprocessor->lex(&token);
+            tokenCount++;
+        } while (token.type != pp::Token::LAST);
+        return tokenCount;
+    }
+
+    void runLineCount(int lineCount)
+    {
+        std::string shader = MakeMacroHeavyShader(lineCount);
+        const int iterationCount = 50000 / lineCount;
+
+        size_t tokenCounts[2] = { 0, 0 };
+        for (int cached = 0; cached < 2; cached++)
+        {
+            pp::MacroStatistics statistics;
+            BenchmarkClock::time_point start = BenchmarkClock::now();
+            for (int iteration = 0; iteration < iterationCount; iteration++)
+            {
+                pp::Preprocessor preprocessor(&mDiagnostics, &mDirectiveHandler);
+                preprocessor.setMacroExpansionCacheEnabled(cached != 0);
+                tokenCounts[cached] += lexAll(&preprocessor, shader.c_str());
+                statistics = preprocessor.getMacroStatistics();
+            }
+            double seconds = ElapsedMilliseconds(start) / 1000.0;
+
+            std::ostringstream trace;
+            trace << lineCount << "_lines" << (cached ? "_cached" : "");
+            size_t cacheUseCount = statistics.cacheHitCount + statistics.cacheMissCount;
+            printResult(trace.str(), seconds * 1000.0 / iterationCount, "ms", true);
+            printResult(trace.str() + "_tokens", tokenCounts[cached] / seconds / 1000000.0, "Mtokens/s", false);
+            printResult(trace.str() + "_bytes", shader.size() * iterationCount / seconds / (1024.0 * 1024.0), "MB/s", false);
+            printResult(trace.str() + "_expansions", statistics.expansionCount, "expansions", false);
+            if (cached)
+            {
+                printResult(trace.str() + "_hit_rate", cacheUseCount ? 100.0 * statistics.cacheHitCount / cacheUseCount : 0.0,
+                            "%", false);
+            }
+        }
+
+        std::ostringstream message;
+        message << lineCount << " lines preprocessed to different tokens with the expansion cache";
+        checkResult(tokenCounts[0] == tokenCounts[1], message.str());
+    }
+
+    CountingDiagnostics mDiagnostics;
+    IgnoringDirectiveHandler mDirectiveHandler;
+};
+
+ANGLE_INTERNAL_BENCHMARK(PreprocessorBenchmark);
+
+}
@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ProgramNameIndexPerf.cpp:
+//   Times glGetUniformLocation style lookups through the name index and through the linear
+//   search it replaces, for increasing uniform counts.
+//
+
+#include "InternalBenchmark.h"
+
+#include "libGLESv2/renderer/ProgramNameIndex.h"
+#include "libGLESv2/ProgramBinary.h"
+#include "libGLESv2/Uniform.h"
+
+#include <cstdlib>
+#include <sstream>
+
+namespace
+{
+
+unsigned int ParseAndStripArrayIndex(std::string *name)
+{
+    unsigned int subscript = GL_INVALID_INDEX;
+
+    size_t open = name->find_last_of('[');
+    size_t close = name->find_last_of(']');
+    if (open != std::string::npos && close == name->length() - 1)
+    {
+        subscript = atoi(name->substr(open + 1).c_str());
+        name->erase(open);
+    }
+
+    return subscript;
+}
+
+// The search of the uniform locations the name index replaces
+GLint LinearUniformLocation(const std::vector<gl::LinkedUniform*> &uniforms,
+                            const std::vector<gl::VariableLocation> &uniformIndex, std::string name)
+{
+    unsigned int subscript = ParseAndStripArrayIndex(&name);
+    for (unsigned int location = 0; location < uniformIndex.size(); location++)
+    {
+        if (uniformIndex[location].name == name)
+        {
+            const bool isArray = uniforms[uniformIndex[location].index]->isArray();
+            if ((isArray && uniformIndex[location].element == subscript) || subscript == GL_INVALID_INDEX)
+            {
+                return location;
+            }
+        }
+    }
+    return -1;
+}
+
+class ProgramNameIndexBenchmark : public InternalBenchmark
+{
+  public:
+    ProgramNameIndexBenchmark()
+        : InternalBenchmark("ProgramNameIndexLookups")
+    {
+    }
+
+    virtual void runBenchmark()
+    {
+        const int uniformCounts[] = { 8, 32, 128, 512 };
+        for (size_t countIndex = 0; countIndex < ArraySize(uniformCounts); countIndex++)
+        {
+            runUniformCount(uniformCounts[countIndex]);
+        }
+    }
+
+  private:
+    void runUniformCount(int uniformCount)
+    {
+        const int lookupCount = 100000;
+
+        std::vector<gl::LinkedUniform*> uniforms;
+        std::vector<gl::VariableLocation> uniformIndex;
+        std::vector<gl::UniformBlock*> uniformBlocks;
+        std::vector<std::string> names;
+        for (int uniform = 0; uniform < uniformCount; uniform++)
+        {
+            std::ostringstream name;
+            name << "material.uniform" << uniform;
+            unsigned int arraySize = (uniform % 2) ? 4 : 0;
+            uniforms.push_back(new gl::LinkedUniform(GL_FLOAT_VEC4, GL_MEDIUM_FLOAT, name.str(), arraySize, -1,
+                                                     sh::BlockMemberInfo::getDefaultBlockInfo()));
+            for (unsigned int element = 0; element < uniforms.back()->elementCount(); element++)
+            {
+                uniformIndex.push_back(gl::VariableLocation(name.str(), element, uniform));
+            }
+            names.push_back(name.str() + (arraySize ? "[3]" : ""));
+        }
+
+        rx::ProgramNameIndex index;
+        index.build(uniforms, uniformIndex, uniformBlocks);
+
+        GLint checksum = 0;
+        BenchmarkClock::time_point start = BenchmarkClock::now();
+        for (int lookup = 0; lookup < lookupCount; lookup++)
+        {
+            checksum += LinearUniformLocation(uniforms, uniformIndex, names[lookup % names.size()]);
+        }
+        double linearTime = ElapsedMilliseconds(start);
+
+        start = BenchmarkClock::now();
+        for (int lookup = 0; lookup < lookupCount; lookup++)
+        {
+            checksum -= index.getUniformLocation(names[lookup % names.size()].c_str());
+        }
+        double indexTime = ElapsedMilliseconds(start);
+
+        SafeDeleteContainer(uniforms);
+
+        std::ostringstream trace;
+        trace << uniformCount << "_uniforms";
+        checkResult(checksum == 0, trace.str() + " locations of the index and the linear search differ");
+        printResult(trace.str() + "_linear", linearTime * 1000000.0 / lookupCount, "ns", false);
+        printResult(trace.str() + "_indexed", indexTime * 1000000.0 / lookupCount, "ns", true);
+    }
+};
+
+ANGLE_INTERNAL_BENCHMARK(ProgramNameIndexBenchmark);
+
+}
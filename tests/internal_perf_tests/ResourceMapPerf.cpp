@@ -0,0 +1,86 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ResourceMapPerf.cpp:
+//   Times the lookups of a bind-heavy trace, which binds each of a few hundred generated
+//   objects in turn, with the resource map and with the unordered_map it replaces.
+//
+
+#include "InternalBenchmark.h"
+
+#include "libGLESv2/ResourceMap.h"
+
+#include <unordered_map>
+
+namespace
+{
+
+struct Resource
+{
+    explicit Resource(GLuint handle) : handle(handle) {}
+
+    GLuint handle;
+};
+
+class ResourceMapBenchmark : public InternalBenchmark
+{
+  public:
+    ResourceMapBenchmark()
+        : InternalBenchmark("ResourceMapBindLookups")
+    {
+    }
+
+    virtual void runBenchmark()
+    {
+        const int iterations = 10000;
+        const GLuint objectCount = 256;
+
+        std::vector<Resource> resources;
+        for (GLuint handle = 1; handle <= objectCount; handle++)
+        {
+            resources.push_back(Resource(handle));
+        }
+
+        std::unordered_map<GLuint, Resource*> hashMap;
+        gl::ResourceMap<Resource> map;
+        for (size_t i = 0; i < resources.size(); i++)
+        {
+            hashMap[resources[i].handle] = &resources[i];
+            map.assign(resources[i].handle, &resources[i]);
+        }
+
+        GLuint hashHandles = 0;
+        BenchmarkClock::time_point start = BenchmarkClock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            for (GLuint handle = 1; handle <= objectCount; handle++)
+            {
+                hashHandles += hashMap.find(handle)->second->handle;
+            }
+        }
+        double hashTime = ElapsedMilliseconds(start);
+
+        GLuint mapHandles = 0;
+        start = BenchmarkClock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            for (GLuint handle = 1; handle <= objectCount; handle++)
+            {
+                mapHandles += map.query(handle)->handle;
+            }
+        }
+        double mapTime = ElapsedMilliseconds(start);
+
+        checkResult(hashHandles == mapHandles, "the resource map and the unordered_map found different objects");
+
+        double lookups = static_cast<double>(iterations) * objectCount;
+        printResult("unordered_map_lookup", hashTime * 1000000.0 / lookups, "ns", false);
+        printResult("resource_map_lookup", mapTime * 1000000.0 / lookups, "ns", true);
+    }
+};
+
+ANGLE_INTERNAL_BENCHMARK(ResourceMapBenchmark);
+
+}
@@ -0,0 +1,77 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// SymbolTablePerf.cpp:
+//   Times compiling a shader with many declarations and scopes, and reports the symbol
+//   lookups and hash table probes the parser needed.
+//
+
+#include "InternalBenchmark.h"
+
+#include "angle_gl.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/TranslatorGLSL.h"
+
+#include <sstream>
+
+namespace
+{
+
+class SymbolTableBenchmark : public InternalBenchmark
+{
+  public:
+    SymbolTableBenchmark()
+        : InternalBenchmark("SymbolTableLookups")
+    {
+    }
+
+    virtual void runBenchmark()
+    {
+        std::ostringstream shaderStream;
+        shaderStream << "precision mediump float;\n";
+        const int functionCount = 200;
+        for (int function = 0; function < functionCount; function++)
+        {
+            shaderStream << "uniform vec4 u" << function << ";\n"
+                         << "vec4 f" << function << "(vec4 a) {\n"
+                         << "   vec4 b = a * u" << function << ";\n"
+                         << "   for (int i = 0; i < 4; i++) { vec4 c = b + a; b = c * 0.5; }\n"
+                         << "   return clamp(normalize(b), 0.0, 1.0);\n"
+                         << "}\n";
+        }
+        shaderStream << "void main() {\n   vec4 r = vec4(0.0);\n";
+        for (int function = 0; function < functionCount; function++)
+        {
+            shaderStream << "   r += f" << function << "(r);\n";
+        }
+        shaderStream << "   gl_FragColor = r;\n}\n";
+        std::string shaderString = shaderStream.str();
+        const char *shaderStrings[] = { shaderString.c_str() };
+
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+        TranslatorGLSL translator(GL_FRAGMENT_SHADER, SH_GLES3_SPEC);
+        checkResult(translator.Init(resources), "the compiler failed to initialize");
+
+        const int compileCount = 20;
+        bool compiled = true;
+        BenchmarkClock::time_point start = BenchmarkClock::now();
+        for (int index = 0; index < compileCount; index++)
+        {
+            compiled = translator.compile(shaderStrings, 1, SH_OBJECT_CODE) && compiled;
+        }
+        double compileTime = ElapsedMilliseconds(start);
+        checkResult(compiled, "the shader failed to compile");
+
+        const TSymbolTable &table = translator.getSymbolTable();
+        printResult("compile_time", compileTime / compileCount, "ms", true);
+        printResult("lookups", table.getLookupCount(), "lookups", false);
+        printResult("probes", table.getProbeCount(), "probes", false);
+    }
+};
+
+ANGLE_INTERNAL_BENCHMARK(SymbolTableBenchmark);
+
+}
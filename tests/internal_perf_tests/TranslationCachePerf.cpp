@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// TranslationCachePerf.cpp:
+//   Translates a corpus of distinct shaders without the translation cache, with a cold cache
+//   and with a warm cache that was reopened from disk.
+//
+
+#include "InternalBenchmark.h"
+
+#include "angle_gl.h"
+#include "GLSLANG/ShaderLang.h"
+
+#include <sstream>
+#include <stdio.h>
+
+namespace
+{
+
+const char *CacheFileName = "angle_translation_cache_perf.bin";
+
+class TranslationCacheBenchmark : public InternalBenchmark
+{
+  public:
+    TranslationCacheBenchmark()
+        : InternalBenchmark("TranslationCache")
+    {
+    }
+
+    virtual void runBenchmark()
+    {
+        const size_t shaderCount = 200;
+
+        std::vector<std::string> corpus;
+        for (size_t shaderIndex = 0; shaderIndex < shaderCount; shaderIndex++)
+        {
+            std::ostringstream stream;
+            stream << "#version 300 es\n"
+                      "precision mediump float;\n"
+                      "uniform Block { vec4 color; mat2 m; } block;\n"
+                      "uniform sampler2D tex;\n"
+                      "uniform vec4 offsets[" << (shaderIndex % 16 + 1) << "];\n"
+                      "in vec2 texCoord;\n"
+                      "out vec4 fragColor;\n"
+                      "vec4 shade" << shaderIndex << "(vec2 uv) {\n"
+                      "    vec4 sum = vec4(0.0);\n"
+                      "    for (int i = 0; i < " << (shaderIndex % 8 + 1) << "; i++) {\n"
+                      "        sum += texture(tex, uv + offsets[0].xy * float(i));\n"
+                      "    }\n"
+                      "    return sum * block.color;\n"
+                      "}\n"
+                      "void main() {\n"
+                      "    fragColor = shade" << shaderIndex << "(texCoord) + vec4(" << shaderIndex << ".0);\n"
+                      "}\n";
+            corpus.push_back(stream.str());
+        }
+
+        remove(CacheFileName);
+
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+        ShHandle compiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES3_SPEC, SH_HLSL11_OUTPUT, &resources);
+
+        // The HLSL translator relies on collected variables
+        const int compileOptions = SH_OBJECT_CODE | SH_VARIABLES;
+        const char *passNames[] = { "uncached", "cold_cache", "warm_cache" };
+        for (int pass = 0; pass < 3; pass++)
+        {
+            bool cacheSet = ShSetTranslationCacheFile(pass == 0 ? NULL : CacheFileName);
+            checkResult(pass == 0 || cacheSet, "could not open the cache file");
+
+            bool compiled = true;
+            BenchmarkClock::time_point start = BenchmarkClock::now();
+            for (size_t shaderIndex = 0; shaderIndex < corpus.size(); shaderIndex++)
+            {
+                const char *source = corpus[shaderIndex].c_str();
+                compiled = ShCompile(compiler, &source, 1, compileOptions) && compiled;
+            }
+            printResult(passNames[pass], ElapsedMilliseconds(start), "ms", true);
+            checkResult(compiled, std::string("a shader failed to compile ") + passNames[pass]);
+        }
+
+        size_t hits = 0;
+        size_t misses = 0;
+        ShGetTranslationCacheStatistics(&hits, &misses);
+        checkResult(hits == shaderCount && misses == 0, "the warm cache missed");
+
+        ShDestruct(compiler);
+        ShSetTranslationCacheFile(NULL);
+        remove(CacheFileName);
+    }
+};
+
+ANGLE_INTERNAL_BENCHMARK(TranslationCacheBenchmark);
+
+}
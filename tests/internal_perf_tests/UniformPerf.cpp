@@ -0,0 +1,139 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// UniformPerf.cpp:
+//   Times updating a palette of 4x4 bone matrices, the way setUniformMatrix4fv stores them
+//   with and without the row writer, and a vec4 array the way setUniform4fv does, when only a
+//   few elements change between updates.
+//
+
+#include "InternalBenchmark.h"
+
+#include "libGLESv2/Uniform.h"
+
+#include <cstring>
+
+namespace
+{
+
+gl::LinkedUniform *CreateUniform(GLenum type, unsigned int arraySize)
+{
+    return new gl::LinkedUniform(type, GL_HIGH_FLOAT, "u", arraySize, -1, sh::BlockMemberInfo::getDefaultBlockInfo());
+}
+
+std::vector<GLfloat> MakeRows(unsigned int rowCount)
+{
+    std::vector<GLfloat> rows(rowCount * 4);
+    for (size_t i = 0; i < rows.size(); i++)
+    {
+        rows[i] = static_cast<GLfloat>(i);
+    }
+    return rows;
+}
+
+// The per-component compare and copy the row writer replaces
+template <typename T>
+inline void SetIfDirty(T *dest, const T& source, bool *dirtyFlag)
+{
+    *dirtyFlag = *dirtyFlag || (memcmp(dest, &source, sizeof(T)) != 0);
+    *dest = source;
+}
+
+class UniformBenchmark : public InternalBenchmark
+{
+  public:
+    UniformBenchmark()
+        : InternalBenchmark("UniformUpdates")
+    {
+    }
+
+    virtual void runBenchmark()
+    {
+        const unsigned int boneCount = 64;
+        const int updateCount = 20000;
+
+        gl::LinkedUniform *bones = CreateUniform(GL_FLOAT_MAT4, boneCount);
+        std::vector<GLfloat> matrices = MakeRows(boneCount * 4);
+
+        BenchmarkClock::time_point start = BenchmarkClock::now();
+        for (int update = 0; update < updateCount; update++)
+        {
+            matrices[(update % boneCount) * 16] += 1.0f;
+
+            GLfloat *target = reinterpret_cast<GLfloat*>(bones->data);
+            for (unsigned int bone = 0; bone < boneCount; bone++)
+            {
+                for (int x = 0; x < 4; x++)
+                {
+                    for (int y = 0; y < 4; y++)
+                    {
+                        SetIfDirty(target + bone * 16 + x * 4 + y, matrices[bone * 16 + y * 4 + x], &bones->dirty);
+                    }
+                }
+            }
+        }
+        double scalarMatrixTime = ElapsedMilliseconds(start);
+
+        start = BenchmarkClock::now();
+        size_t dirtyRowCount = 0;
+        for (int update = 0; update < updateCount; update++)
+        {
+            matrices[(update % boneCount) * 16] += 1.0f;
+            bones->clearDirtyRows();
+
+            GLfloat staging[boneCount * 16];
+            for (unsigned int bone = 0; bone < boneCount; bone++)
+            {
+                for (int x = 0; x < 4; x++)
+                {
+                    for (int y = 0; y < 4; y++)
+                    {
+                        staging[bone * 16 + x * 4 + y] = matrices[bone * 16 + y * 4 + x];
+                    }
+                }
+            }
+            bones->writeRows(0, staging, boneCount * 4);
+            dirtyRowCount += bones->dirtyRows.empty() ? 0 : bones->dirtyRows[0].length();
+        }
+        double rowMatrixTime = ElapsedMilliseconds(start);
+        SafeDelete(bones);
+
+        gl::LinkedUniform *vectors = CreateUniform(GL_FLOAT_VEC4, 256);
+        std::vector<GLfloat> values = MakeRows(256);
+
+        start = BenchmarkClock::now();
+        for (int update = 0; update < updateCount; update++)
+        {
+            values[(update % 256) * 4] += 1.0f;
+
+            GLfloat *target = reinterpret_cast<GLfloat*>(vectors->data);
+            for (size_t component = 0; component < values.size(); component++)
+            {
+                SetIfDirty(target + component, values[component], &vectors->dirty);
+            }
+        }
+        double scalarVectorTime = ElapsedMilliseconds(start);
+
+        start = BenchmarkClock::now();
+        for (int update = 0; update < updateCount; update++)
+        {
+            values[(update % 256) * 4] += 1.0f;
+            vectors->clearDirtyRows();
+            vectors->writeRows(0, &values[0], 256);
+        }
+        double rowVectorTime = ElapsedMilliseconds(start);
+        SafeDelete(vectors);
+
+        printResult("mat4_palette_per_component", scalarMatrixTime * 1000.0 / updateCount, "us", false);
+        printResult("mat4_palette_per_row", rowMatrixTime * 1000.0 / updateCount, "us", true);
+        printResult("mat4_palette_dirty_registers", static_cast<double>(dirtyRowCount) / updateCount, "registers", false);
+        printResult("vec4_array_per_component", scalarVectorTime * 1000.0 / updateCount, "us", false);
+        printResult("vec4_array_per_row", rowVectorTime * 1000.0 / updateCount, "us", true);
+    }
+};
+
+ANGLE_INTERNAL_BENCHMARK(UniformBenchmark);
+
+}
@@ -0,0 +1,45 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "InternalBenchmark.h"
+
+#include "GLSLANG/ShaderLang.h"
+
+#include <iostream>
+#include <memory>
+
+// Runs every benchmark, or those whose name contains the first argument
+int main(int argc, char **argv)
+{
+    std::string filter = (argc > 1) ? argv[1] : "";
+    int result = 0;
+
+    if (!ShInitialize())
+    {
+        std::cerr << "Failed to initialize the compiler." << std::endl;
+        return 1;
+    }
+
+    const std::vector<InternalBenchmarkFactory> &benchmarks = GetInternalBenchmarks();
+    for (size_t benchIndex = 0; benchIndex < benchmarks.size(); benchIndex++)
+    {
+        std::unique_ptr<InternalBenchmark> benchmark(benchmarks[benchIndex]());
+        if (benchmark->getName().find(filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        if (!benchmark->run())
+        {
+            std::cerr << benchmark->getName() << " FAILED" << std::endl;
+            result = 1;
+        }
+    }
+
+    ShFinalize();
+
+    return result;
+}
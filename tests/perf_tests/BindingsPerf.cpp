@@ -0,0 +1,120 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "BindingsPerf.h"
+
+#include <cassert>
+#include <sstream>
+
+namespace
+{
+
+// Application names are spread out by this much, as with names derived from asset ids
+const GLuint ApplicationNameStride = 7919;
+
+// Binding a name that was not generated creates the object of that name
+void ChooseApplicationNames(std::vector<GLuint> *names)
+{
+    for (size_t index = 0; index < names->size(); index++)
+    {
+        (*names)[index] = 1 + static_cast<GLuint>(index) * ApplicationNameStride;
+    }
+}
+
+}
+
+std::string BindingsPerfParams::suffix() const
+{
+    std::stringstream strstr;
+
+    strstr << "_" << objectCount << "_objects";
+
+    if (applicationNames)
+    {
+        strstr << "_application_names";
+    }
+
+    return strstr.str();
+}
+
+BindingsPerfBenchmark::BindingsPerfBenchmark(const BindingsPerfParams &params)
+    : SimpleBenchmark("BindingsPerf", 256, 256, 2, params),
+      mBindCount(0),
+      mParams(params)
+{
+    mDrawIterations = mParams.iterations;
+
+    assert(mParams.iterations > 0);
+    assert(mParams.objectCount > 0);
+}
+
+bool BindingsPerfBenchmark::initializeBenchmark()
+{
+    mBuffers.resize(mParams.objectCount);
+    mTextures.resize(mParams.objectCount);
+    mRenderbuffers.resize(mParams.objectCount);
+
+    if (mParams.applicationNames)
+    {
+        ChooseApplicationNames(&mBuffers);
+        ChooseApplicationNames(&mTextures);
+        ChooseApplicationNames(&mRenderbuffers);
+    }
+    else
+    {
+        glGenBuffers(mParams.objectCount, &mBuffers[0]);
+        glGenTextures(mParams.objectCount, &mTextures[0]);
+        glGenRenderbuffers(mParams.objectCount, &mRenderbuffers[0]);
+    }
+
+    // Give every object its storage, so the binds of the benchmark only look them up
+    const GLubyte bufferData[16] = { 0 };
+    const GLubyte textureData[4] = { 0 };
+    for (unsigned int object = 0; object < mParams.objectCount; object++)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, mBuffers[object]);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(bufferData), bufferData, GL_STATIC_DRAW);
+
+        glBindTexture(GL_TEXTURE_2D, mTextures[object]);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, textureData);
+
+        glBindRenderbuffer(GL_RENDERBUFFER, mRenderbuffers[object]);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA4, 1, 1);
+    }
+
+    GLenum glErr = glGetError();
+    if (glErr != GL_NO_ERROR)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+void BindingsPerfBenchmark::destroyBenchmark()
+{
+    // print static parameters
+    printResult("iterations", static_cast<size_t>(mParams.iterations), "passes", false);
+    printResult("objects", static_cast<size_t>(mParams.objectCount), "objects", false);
+
+    double nanosecondsPerBind = mRunTimeSeconds * 1000000000.0 / static_cast<double>(mBindCount);
+    printResult("bind_time", nanosecondsPerBind, "ns", true);
+
+    glDeleteBuffers(static_cast<GLsizei>(mBuffers.size()), &mBuffers[0]);
+    glDeleteTextures(static_cast<GLsizei>(mTextures.size()), &mTextures[0]);
+    glDeleteRenderbuffers(static_cast<GLsizei>(mRenderbuffers.size()), &mRenderbuffers[0]);
+}
+
+void BindingsPerfBenchmark::drawBenchmark()
+{
+    for (unsigned int object = 0; object < mParams.objectCount; object++)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, mBuffers[object]);
+        glBindTexture(GL_TEXTURE_2D, mTextures[object]);
+        glBindRenderbuffer(GL_RENDERBUFFER, mRenderbuffers[object]);
+    }
+    mBindCount += mParams.objectCount * 3;
+}
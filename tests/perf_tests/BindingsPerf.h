@@ -0,0 +1,44 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "SimpleBenchmark.h"
+
+struct BindingsPerfParams : public BenchmarkParams
+{
+    virtual std::string suffix() const;
+
+    // Number of buffers, textures and renderbuffers, each bound in turn
+    unsigned int objectCount;
+
+    // Whether the objects are named by the application, far apart, rather than generated
+    bool applicationNames;
+
+    // Static parameters
+    unsigned int iterations;
+};
+
+// Binds each of many buffers, textures and renderbuffers in turn, as applications streaming
+// their objects through a few binding points do. Nothing is drawn, so the time per bind is the
+// CPU cost of looking up the object and changing the binding.
+class BindingsPerfBenchmark : public SimpleBenchmark
+{
+  public:
+    BindingsPerfBenchmark(const BindingsPerfParams &params);
+
+    virtual bool initializeBenchmark();
+    virtual void destroyBenchmark();
+    virtual void drawBenchmark();
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(BindingsPerfBenchmark);
+
+    std::vector<GLuint> mBuffers;
+    std::vector<GLuint> mTextures;
+    std::vector<GLuint> mRenderbuffers;
+    unsigned int mBindCount;
+
+    const BindingsPerfParams mParams;
+};
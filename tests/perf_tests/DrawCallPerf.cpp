@@ -0,0 +1,242 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "DrawCallPerf.h"
+
+#include <cassert>
+#include <sstream>
+
+#include "shader_utils.h"
+
+namespace
+{
+
+// Enough copies of the triangle to draw each one from a different offset
+const unsigned int TriangleCount = 64;
+
+}
+
+std::string DrawCallPerfParams::suffix() const
+{
+    std::stringstream strstr;
+
+    switch (stateChange)
+    {
+      case DRAW_CALL_NO_STATE_CHANGE: strstr << "_no_state_change"; break;
+      case DRAW_CALL_VERTEX_BUFFER_OFFSET_CHANGE: strstr << "_vertex_buffer_offset_change"; break;
+      case DRAW_CALL_RENDER_STATE_CHANGE: strstr << "_render_state_change"; break;
+      default: strstr << "_unk_" << stateChange; break;
+    }
+
+    if (vertexAttribCount > 1)
+    {
+        strstr << "_" << vertexAttribCount << "_attribs";
+    }
+
+    if (textureCount > 0)
+    {
+        strstr << "_" << textureCount << "_textures";
+    }
+
+    return strstr.str();
+}
+
+DrawCallPerfBenchmark::DrawCallPerfBenchmark(const DrawCallPerfParams &params)
+    : SimpleBenchmark("DrawCallPerf", 256, 256, 2, params),
+      mProgram(0),
+      mPositionLocation(-1),
+      mDrawCount(0),
+      mParams(params)
+{
+    mDrawIterations = mParams.iterations;
+
+    assert(mParams.iterations > 0);
+    assert(mParams.vertexAttribCount > 0);
+}
+
+bool DrawCallPerfBenchmark::initializeBenchmark()
+{
+    // The position is the sum of all the attributes, so none of them is optimized away
+    std::stringstream vs;
+    for (unsigned int attrib = 0; attrib < mParams.vertexAttribCount; attrib++)
+    {
+        vs << "attribute vec2 vPosition" << attrib << ";\n";
+    }
+    vs << "void main()\n"
+          "{\n"
+          "    vec2 position = vPosition0;\n";
+    for (unsigned int attrib = 1; attrib < mParams.vertexAttribCount; attrib++)
+    {
+        vs << "    position += vPosition" << attrib << ";\n";
+    }
+    vs << "    gl_Position = vec4(position, 0, 1);\n"
+          "}\n";
+
+    // The color is the sum of all the textures, so none of them is optimized away
+    std::stringstream fs;
+    fs << "precision mediump float;\n";
+    for (unsigned int texture = 0; texture < mParams.textureCount; texture++)
+    {
+        fs << "uniform sampler2D sTexture" << texture << ";\n";
+    }
+    fs << "void main()\n"
+          "{\n"
+          "    vec4 color = vec4(1.0, 0.0, 0.0, 1.0);\n";
+    for (unsigned int texture = 0; texture < mParams.textureCount; texture++)
+    {
+        fs << "    color += texture2D(sTexture" << texture << ", vec2(0.5, 0.5));\n";
+    }
+    fs << "    gl_FragColor = color;\n"
+          "}\n";
+
+    mProgram = CompileProgram(vs.str(), fs.str());
+    if (!mProgram)
+    {
+        return false;
+    }
+
+    glUseProgram(mProgram);
+
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+
+    // A small triangle in the corner of the window, repeated for every offset
+    const GLfloat triangle[] = { -1.0f, -1.0f, -0.99f, -1.0f, -1.0f, -0.99f };
+    std::vector<GLfloat> vertices;
+    for (unsigned int copy = 0; copy < TriangleCount; copy++)
+    {
+        vertices.insert(vertices.end(), triangle, triangle + ArraySize(triangle));
+    }
+
+    // The first attribute holds the triangles, the others add zero to them
+    std::vector<GLfloat> zeros(vertices.size(), 0.0f);
+
+    mBuffers.resize(mParams.vertexAttribCount);
+    glGenBuffers(mParams.vertexAttribCount, &mBuffers[0]);
+    for (unsigned int attrib = 0; attrib < mParams.vertexAttribCount; attrib++)
+    {
+        std::stringstream name;
+        name << "vPosition" << attrib;
+        GLint location = glGetAttribLocation(mProgram, name.str().c_str());
+        if (location == -1)
+        {
+            return false;
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, mBuffers[attrib]);
+        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(GLfloat), (attrib == 0) ? &vertices[0] : &zeros[0],
+                     GL_STATIC_DRAW);
+
+        glVertexAttribPointer(location, 2, GL_FLOAT, GL_FALSE, 0, 0);
+        glEnableVertexAttribArray(location);
+    }
+
+    // The vertex buffer offset change moves the first attribute
+    mPositionLocation = glGetAttribLocation(mProgram, "vPosition0");
+    glBindBuffer(GL_ARRAY_BUFFER, mBuffers[0]);
+
+    // Black mipmapped textures, so sampling them does not change the color
+    const GLsizei textureSize = 64;
+    std::vector<GLubyte> textureData(textureSize * textureSize * 4, 0);
+
+    mTextures.resize(mParams.textureCount);
+    if (mParams.textureCount > 0)
+    {
+        glGenTextures(mParams.textureCount, &mTextures[0]);
+    }
+    for (unsigned int texture = 0; texture < mParams.textureCount; texture++)
+    {
+        std::stringstream name;
+        name << "sTexture" << texture;
+        GLint location = glGetUniformLocation(mProgram, name.str().c_str());
+        if (location == -1)
+        {
+            return false;
+        }
+
+        glActiveTexture(GL_TEXTURE0 + texture);
+        glBindTexture(GL_TEXTURE_2D, mTextures[texture]);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, textureSize, textureSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, &textureData[0]);
+        glGenerateMipmap(GL_TEXTURE_2D);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        glUniform1i(location, texture);
+    }
+    glActiveTexture(GL_TEXTURE0);
+
+    glBlendFunc(GL_ONE, GL_ONE);
+
+    glViewport(0, 0, getWindow()->getWidth(), getWindow()->getHeight());
+
+    GLenum glErr = glGetError();
+    if (glErr != GL_NO_ERROR)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+void DrawCallPerfBenchmark::destroyBenchmark()
+{
+    // print static parameters
+    printResult("iterations", static_cast<size_t>(mParams.iterations), "draws", false);
+    printResult("vertex_attribs", static_cast<size_t>(mParams.vertexAttribCount), "attribs", false);
+    printResult("textures", static_cast<size_t>(mParams.textureCount), "textures", false);
+
+    double microsecondsPerDraw = mRunTimeSeconds * 1000000.0 / static_cast<double>(mDrawCount);
+    printResult("draw_time", microsecondsPerDraw, "us", true);
+
+    glDeleteProgram(mProgram);
+    if (!mBuffers.empty())
+    {
+        glDeleteBuffers(static_cast<GLsizei>(mBuffers.size()), &mBuffers[0]);
+    }
+    if (!mTextures.empty())
+    {
+        glDeleteTextures(static_cast<GLsizei>(mTextures.size()), &mTextures[0]);
+    }
+}
+
+void DrawCallPerfBenchmark::beginDrawBenchmark()
+{
+    // Clear the color buffer
+    glClear(GL_COLOR_BUFFER_BIT);
+}
+
+void DrawCallPerfBenchmark::drawBenchmark()
+{
+    switch (mParams.stateChange)
+    {
+      case DRAW_CALL_NO_STATE_CHANGE:
+        break;
+
+      case DRAW_CALL_VERTEX_BUFFER_OFFSET_CHANGE:
+        {
+            GLintptr offset = (mDrawCount % TriangleCount) * 6 * sizeof(GLfloat);
+            glVertexAttribPointer(mPositionLocation, 2, GL_FLOAT, GL_FALSE, 0, reinterpret_cast<GLvoid*>(offset));
+        }
+        break;
+
+      case DRAW_CALL_RENDER_STATE_CHANGE:
+        if ((mDrawCount % 2) == 0)
+        {
+            glEnable(GL_BLEND);
+        }
+        else
+        {
+            glDisable(GL_BLEND);
+        }
+        break;
+
+      default:
+        assert(0);
+        break;
+    }
+
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    mDrawCount++;
+}
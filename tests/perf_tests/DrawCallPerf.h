@@ -0,0 +1,55 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "SimpleBenchmark.h"
+
+enum DrawCallStateChange
+{
+    DRAW_CALL_NO_STATE_CHANGE,
+    DRAW_CALL_VERTEX_BUFFER_OFFSET_CHANGE,
+    DRAW_CALL_RENDER_STATE_CHANGE,
+};
+
+struct DrawCallPerfParams : public BenchmarkParams
+{
+    virtual std::string suffix() const;
+
+    DrawCallStateChange stateChange;
+
+    // Number of enabled vertex attributes, each in its own buffer, that draw calls validate
+    unsigned int vertexAttribCount;
+
+    // Number of mipmapped textures, each bound to its own texture unit, that the draw calls sample
+    unsigned int textureCount;
+
+    // Static parameters
+    unsigned int iterations;
+};
+
+// Issues many draw calls of a single triangle, changing no state, the offset of the vertex
+// buffer, or the blend state between them. The draws are too small for the GPU to matter,
+// so the time per draw is the CPU cost of a draw call.
+class DrawCallPerfBenchmark : public SimpleBenchmark
+{
+  public:
+    DrawCallPerfBenchmark(const DrawCallPerfParams &params);
+
+    virtual bool initializeBenchmark();
+    virtual void destroyBenchmark();
+    virtual void beginDrawBenchmark();
+    virtual void drawBenchmark();
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(DrawCallPerfBenchmark);
+
+    GLuint mProgram;
+    std::vector<GLuint> mBuffers;
+    std::vector<GLuint> mTextures;
+    GLint mPositionLocation;
+    unsigned int mDrawCount;
+
+    const DrawCallPerfParams mParams;
+};
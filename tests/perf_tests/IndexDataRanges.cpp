@@ -0,0 +1,220 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "IndexDataRanges.h"
+
+#include <cassert>
+#include <sstream>
+
+#include "shader_utils.h"
+
+namespace
+{
+
+template <class T>
+void FillIndices(GLsizei indexCount, GLsizei vertexCount, std::vector<uint8_t> *data)
+{
+    data->resize(indexCount * sizeof(T));
+    T *indices = reinterpret_cast<T*>(data->data());
+
+    for (GLsizei index = 0; index < indexCount; index++)
+    {
+        indices[index] = static_cast<T>(rand() % vertexCount);
+    }
+}
+
+GLsizei GetVertexCount(GLenum indexType)
+{
+    return (indexType == GL_UNSIGNED_BYTE) ? 256 : 65536;
+}
+
+GLsizei GetIndexTypeBytes(GLenum indexType)
+{
+    switch (indexType)
+    {
+      case GL_UNSIGNED_BYTE:  return sizeof(GLubyte);
+      case GL_UNSIGNED_SHORT: return sizeof(GLushort);
+      case GL_UNSIGNED_INT:   return sizeof(GLuint);
+      default: assert(0); return 0;
+    }
+}
+
+}
+
+std::string IndexDataRangesParams::suffix() const
+{
+    std::stringstream strstr;
+
+    switch (indexType)
+    {
+      case GL_UNSIGNED_BYTE: strstr << "_ubyte"; break;
+      case GL_UNSIGNED_SHORT: strstr << "_ushort"; break;
+      case GL_UNSIGNED_INT: strstr << "_uint"; break;
+      default: strstr << "_iunk_" << indexType << "_"; break;
+    }
+
+    if (clientSideIndices)
+    {
+        strstr << "_client";
+    }
+    else
+    {
+        strstr << "_every" << updatesEveryNFrames;
+    }
+
+    return strstr.str();
+}
+
+IndexDataRangesBenchmark::IndexDataRangesBenchmark(const IndexDataRangesParams &params)
+    : SimpleBenchmark("IndexDataRanges", 256, 256, 2, params),
+      mProgram(0),
+      mVertexBuffer(0),
+      mIndexBuffer(0),
+      mNextDraw(0),
+      mIndexBytesDrawn(0.0),
+      mParams(params)
+{
+    mDrawIterations = mParams.iterations;
+
+    assert(mParams.iterations > 0);
+    assert(mParams.maxDrawCount > 0 && mParams.maxDrawCount <= mParams.indexCount);
+}
+
+bool IndexDataRangesBenchmark::initializeBenchmark()
+{
+    const std::string vs = SHADER_SOURCE
+    (
+        attribute vec2 vPosition;
+        void main()
+        {
+            gl_PointSize = 1.0;
+            gl_Position = vec4(vPosition, 0, 1);
+        }
+    );
+
+    const std::string fs = SHADER_SOURCE
+    (
+        precision mediump float;
+        void main()
+        {
+            gl_FragColor = vec4(1.0, 0.0, 0.0, 1.0);
+        }
+    );
+
+    mProgram = CompileProgram(vs, fs);
+    if (!mProgram)
+    {
+        return false;
+    }
+
+    glUseProgram(mProgram);
+
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+
+    GLsizei vertexCount = GetVertexCount(mParams.indexType);
+    std::vector<GLfloat> vertices(vertexCount * 2);
+    for (size_t component = 0; component < vertices.size(); component++)
+    {
+        vertices[component] = static_cast<GLfloat>(rand() % 2000) / 1000.0f - 1.0f;
+    }
+
+    glGenBuffers(1, &mVertexBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(GLfloat), &vertices[0], GL_STATIC_DRAW);
+
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, 0);
+    glEnableVertexAttribArray(0);
+
+    switch (mParams.indexType)
+    {
+      case GL_UNSIGNED_BYTE:  FillIndices<GLubyte>(mParams.indexCount, vertexCount, &mIndexData); break;
+      case GL_UNSIGNED_SHORT: FillIndices<GLushort>(mParams.indexCount, vertexCount, &mIndexData); break;
+      case GL_UNSIGNED_INT:   FillIndices<GLuint>(mParams.indexCount, vertexCount, &mIndexData); break;
+      default: assert(0); return false;
+    }
+
+    if (!mParams.clientSideIndices)
+    {
+        glGenBuffers(1, &mIndexBuffer);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, mIndexData.size(), &mIndexData[0], GL_DYNAMIC_DRAW);
+
+        if (mParams.updateSize > 0)
+        {
+            mUpdateData.assign(mIndexData.begin(), mIndexData.begin() + mParams.updateSize);
+        }
+    }
+
+    // Pre-generate the random draw ranges so the measured loop only contains GL calls
+    const size_t rangeCount = 4096;
+    for (size_t range = 0; range < rangeCount; range++)
+    {
+        GLsizei count = 1 + rand() % mParams.maxDrawCount;
+        GLsizei first = rand() % (mParams.indexCount - count + 1);
+
+        mDrawOffsets.push_back(first);
+        mDrawCounts.push_back(count);
+    }
+
+    glViewport(0, 0, getWindow()->getWidth(), getWindow()->getHeight());
+
+    GLenum glErr = glGetError();
+    if (glErr != GL_NO_ERROR)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+void IndexDataRangesBenchmark::destroyBenchmark()
+{
+    // print static parameters
+    printResult("index_count", static_cast<size_t>(mParams.indexCount), "indices", false);
+    printResult("max_draw_count", static_cast<size_t>(mParams.maxDrawCount), "indices", false);
+    printResult("update_size", static_cast<size_t>(mParams.updateSize), "b", false);
+    printResult("iterations", static_cast<size_t>(mParams.iterations), "draws", false);
+
+    double gigabytesPerSecond = mIndexBytesDrawn / (1024.0 * 1024.0 * 1024.0) / mRunTimeSeconds;
+    printResult("index_throughput", gigabytesPerSecond, "GB/s", true);
+
+    glDeleteProgram(mProgram);
+    glDeleteBuffers(1, &mVertexBuffer);
+    glDeleteBuffers(1, &mIndexBuffer);
+}
+
+void IndexDataRangesBenchmark::beginDrawBenchmark()
+{
+    // Clear the color buffer
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    if (!mParams.clientSideIndices && mParams.updateSize > 0 &&
+        ((mNumFrames % mParams.updatesEveryNFrames) == 0))
+    {
+        GLsizeiptr bufferSize = mParams.indexCount * GetIndexTypeBytes(mParams.indexType);
+        GLintptr offset = rand() % (bufferSize - mParams.updateSize + 1);
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset, mParams.updateSize, &mUpdateData[0]);
+    }
+}
+
+void IndexDataRangesBenchmark::drawBenchmark()
+{
+    GLsizei first = mDrawOffsets[mNextDraw];
+    GLsizei count = mDrawCounts[mNextDraw];
+    mNextDraw = (mNextDraw + 1) % mDrawOffsets.size();
+
+    GLintptr offset = first * GetIndexTypeBytes(mParams.indexType);
+    mIndexBytesDrawn += static_cast<double>(count * GetIndexTypeBytes(mParams.indexType));
+
+    if (mParams.clientSideIndices)
+    {
+        glDrawElements(GL_POINTS, count, mParams.indexType, &mIndexData[offset]);
+    }
+    else
+    {
+        glDrawElements(GL_POINTS, count, mParams.indexType, reinterpret_cast<GLvoid*>(offset));
+    }
+}
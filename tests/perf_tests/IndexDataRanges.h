@@ -0,0 +1,54 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "SimpleBenchmark.h"
+
+struct IndexDataRangesParams : public BenchmarkParams
+{
+    virtual std::string suffix() const;
+
+    GLenum indexType;
+    unsigned int updatesEveryNFrames;
+
+    // Draw from client memory instead of a buffer object, so every draw scans its whole index range
+    bool clientSideIndices;
+
+    // Static parameters
+    GLsizei indexCount;
+    GLsizei maxDrawCount;
+    GLsizeiptr updateSize;
+    unsigned int iterations;
+};
+
+// Draws randomized sub-ranges of one large element array buffer, so almost every draw call
+// misses the exact (type, offset, count) index range cache. Reports the index throughput of
+// the draw calls as well as the frame time.
+class IndexDataRangesBenchmark : public SimpleBenchmark
+{
+  public:
+    IndexDataRangesBenchmark(const IndexDataRangesParams &params);
+
+    virtual bool initializeBenchmark();
+    virtual void destroyBenchmark();
+    virtual void beginDrawBenchmark();
+    virtual void drawBenchmark();
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(IndexDataRangesBenchmark);
+
+    GLuint mProgram;
+    GLuint mVertexBuffer;
+    GLuint mIndexBuffer;
+
+    std::vector<uint8_t> mIndexData;
+    std::vector<uint8_t> mUpdateData;
+    std::vector<GLsizei> mDrawOffsets;
+    std::vector<GLsizei> mDrawCounts;
+    size_t mNextDraw;
+    double mIndexBytesDrawn;
+
+    const IndexDataRangesParams mParams;
+};
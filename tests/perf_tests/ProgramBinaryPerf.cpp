@@ -0,0 +1,140 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "ProgramBinaryPerf.h"
+
+#include <cassert>
+#include <sstream>
+
+#include "shader_utils.h"
+
+std::string ProgramBinaryPerfParams::suffix() const
+{
+    std::stringstream strstr;
+
+    strstr << BenchmarkParams::suffix();
+    strstr << "_" << uniformCount << "_uniforms_" << varyingCount << "_varyings";
+
+    return strstr.str();
+}
+
+ProgramBinaryPerfBenchmark::ProgramBinaryPerfBenchmark(const ProgramBinaryPerfParams &params)
+    : SimpleBenchmark("ProgramBinaryPerf", 128, 128, 2, params),
+      mProgram(0),
+      mLoadedProgram(0),
+      mBuffer(0),
+      mBinaryFormat(GL_NONE),
+      mLoadCount(0),
+      mParams(params)
+{
+    mDrawIterations = mParams.iterations;
+
+    assert(mParams.iterations > 0);
+}
+
+bool ProgramBinaryPerfBenchmark::initializeBenchmark()
+{
+    std::ostringstream vertexStream;
+    std::ostringstream fragmentStream;
+    vertexStream << "attribute vec4 inputAttribute;\n"
+                    "uniform mat4 bones[" << mParams.uniformCount << "];\n";
+    fragmentStream << "precision mediump float;\n";
+    for (unsigned int index = 0; index < mParams.uniformCount; index++)
+    {
+        vertexStream << "uniform vec4 vertexUniform" << index << ";\n";
+    }
+    for (unsigned int index = 0; index < mParams.varyingCount; index++)
+    {
+        vertexStream << "varying vec4 v" << index << ";\n";
+        fragmentStream << "varying vec4 v" << index << ";\n";
+    }
+
+    vertexStream << "void main() {\n"
+                    "    vec4 p = inputAttribute;\n";
+    for (unsigned int index = 0; index < mParams.uniformCount; index++)
+    {
+        vertexStream << "    p = bones[" << index << "] * p + vertexUniform" << index << ";\n";
+    }
+    fragmentStream << "void main() {\n"
+                      "    vec4 c = vec4(0.0);\n";
+    for (unsigned int index = 0; index < mParams.varyingCount; index++)
+    {
+        vertexStream << "    v" << index << " = p * " << index << ".0;\n";
+        fragmentStream << "    c += v" << index << ";\n";
+    }
+    vertexStream << "    gl_Position = p;\n"
+                    "}\n";
+    fragmentStream << "    gl_FragColor = c;\n"
+                      "}\n";
+
+    std::unique_ptr<Timer> timer(CreateTimer());
+    timer->start();
+    mProgram = CompileProgram(vertexStream.str(), fragmentStream.str());
+    double linkTime = timer->getElapsedTime();
+    if (mProgram == 0)
+    {
+        return false;
+    }
+
+    const int queryCount = 1000;
+    GLint programLength = 0;
+    timer->start();
+    for (int query = 0; query < queryCount; query++)
+    {
+        glGetProgramiv(mProgram, GL_PROGRAM_BINARY_LENGTH_OES, &programLength);
+    }
+    double lengthTime = timer->getElapsedTime();
+
+    mBinary.resize(programLength);
+    timer->start();
+    for (int query = 0; query < queryCount; query++)
+    {
+        glGetProgramBinaryOES(mProgram, programLength, NULL, &mBinaryFormat, &mBinary[0]);
+    }
+    double saveTime = timer->getElapsedTime();
+
+    printResult("binary_size", static_cast<size_t>(programLength), "bytes", false);
+    printResult("link_time", linkTime * 1000.0, "ms", true);
+    printResult("length_query_time", lengthTime * 1000000.0 / queryCount, "us", false);
+    printResult("save_time", saveTime * 1000000.0 / queryCount, "us", true);
+
+    mLoadedProgram = glCreateProgram();
+
+    glGenBuffers(1, &mBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, mBuffer);
+    glBufferData(GL_ARRAY_BUFFER, 128, NULL, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 16, NULL);
+    glEnableVertexAttribArray(0);
+
+    GLenum glErr = glGetError();
+    if (glErr != GL_NO_ERROR)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+void ProgramBinaryPerfBenchmark::destroyBenchmark()
+{
+    // print static parameters
+    printResult("iterations", static_cast<size_t>(mParams.iterations), "loads", false);
+
+    double millisecondsPerLoad = mRunTimeSeconds * 1000.0 / static_cast<double>(mLoadCount);
+    printResult("load_and_first_draw_time", millisecondsPerLoad, "ms", true);
+
+    glDeleteBuffers(1, &mBuffer);
+    glDeleteProgram(mLoadedProgram);
+    glDeleteProgram(mProgram);
+}
+
+void ProgramBinaryPerfBenchmark::drawBenchmark()
+{
+    glProgramBinaryOES(mLoadedProgram, mBinaryFormat, &mBinary[0], static_cast<GLint>(mBinary.size()));
+    glUseProgram(mLoadedProgram);
+    glDrawArrays(GL_POINTS, 0, 1);
+    mLoadCount++;
+}
@@ -0,0 +1,45 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "SimpleBenchmark.h"
+
+struct ProgramBinaryPerfParams : public BenchmarkParams
+{
+    virtual std::string suffix() const;
+
+    // Number of vec4 vertex uniforms, besides as many mat4 bones, and of varyings
+    unsigned int uniformCount;
+    unsigned int varyingCount;
+
+    // Static parameters
+    unsigned int iterations;
+};
+
+// Loads a program with many uniforms and varyings from its binary and draws with it, as
+// applications restoring their programs from a disk cache at startup do. The first draw
+// after a load creates the shaders the load deferred. The link, the length query and the
+// save are timed once, before the loads.
+class ProgramBinaryPerfBenchmark : public SimpleBenchmark
+{
+  public:
+    ProgramBinaryPerfBenchmark(const ProgramBinaryPerfParams &params);
+
+    virtual bool initializeBenchmark();
+    virtual void destroyBenchmark();
+    virtual void drawBenchmark();
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(ProgramBinaryPerfBenchmark);
+
+    GLuint mProgram;
+    GLuint mLoadedProgram;
+    GLuint mBuffer;
+    GLenum mBinaryFormat;
+    std::vector<uint8_t> mBinary;
+    unsigned int mLoadCount;
+
+    const ProgramBinaryPerfParams mParams;
+};
@@ -8,6 +8,10 @@
 #include "BufferSubData.h"
 #include "TexSubImage.h"
 #include "PointSprites.h"
+#include "IndexDataRanges.h"
+#include "DrawCallPerf.h"
+#include "BindingsPerf.h"
+#include "ProgramBinaryPerf.h"
 
 EGLint platforms[] =
 {
@@ -22,6 +26,33 @@ GLsizeiptr updateSizes[] = { 300 };
 GLsizeiptr bufferSizes[] = { 1024 * 1024 };
 unsigned int iterationCounts[] = { 10 };
 unsigned int updatesEveryNFrames[] = { 1, 4 };
+GLenum indexTypes[] = { GL_UNSIGNED_SHORT, GL_UNSIGNED_INT };
+GLenum allIndexTypes[] = { GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT, GL_UNSIGNED_INT };
+unsigned int indexUpdatesEveryNFrames[] = { 1, 1000000 };
+DrawCallStateChange drawCallStateChanges[] =
+{
+    DRAW_CALL_NO_STATE_CHANGE,
+    DRAW_CALL_VERTEX_BUFFER_OFFSET_CHANGE,
+    DRAW_CALL_RENDER_STATE_CHANGE,
+};
+
+struct TexSubImageFormat
+{
+    GLenum internalFormat;
+    GLenum format;
+    GLenum type;
+};
+
+TexSubImageFormat subImageFormats[] =
+{
+    { GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE },
+    { GL_RGB8, GL_RGB, GL_UNSIGNED_BYTE },
+    { GL_RGB565, GL_RGB, GL_UNSIGNED_SHORT_5_6_5 },
+    { GL_RGBA4, GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4 },
+    { GL_RGB5_A1, GL_RGBA, GL_UNSIGNED_SHORT_5_5_5_1 },
+    { GL_LUMINANCE8_EXT, GL_LUMINANCE, GL_UNSIGNED_BYTE },
+    { GL_LUMINANCE8_ALPHA8_EXT, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE },
+};
 
 int main(int argc, char **argv)
 {
@@ -88,16 +119,22 @@ int main(int argc, char **argv)
 
     for (size_t platIt = 0; platIt < ArraySize(platforms); platIt++)
     {
-        TexSubImageParams params;
+        for (size_t formatIt = 0; formatIt < ArraySize(subImageFormats); formatIt++)
+        {
+            TexSubImageParams params;
 
-        params.requestedRenderer = platforms[platIt];
-        params.imageWidth = 1024;
-        params.imageHeight = 1024;
-        params.subImageHeight = 64;
-        params.subImageWidth = 64;
-        params.iterations = 10;
+            params.requestedRenderer = platforms[platIt];
+            params.imageWidth = 1024;
+            params.imageHeight = 1024;
+            params.subImageHeight = 64;
+            params.subImageWidth = 64;
+            params.internalFormat = subImageFormats[formatIt].internalFormat;
+            params.format = subImageFormats[formatIt].format;
+            params.type = subImageFormats[formatIt].type;
+            params.iterations = 10;
 
-        subImageParams.push_back(params);
+            subImageParams.push_back(params);
+        }
     }
 
     RunBenchmarks<TexSubImageBenchmark>(subImageParams);
@@ -118,4 +155,119 @@ int main(int argc, char **argv)
     }
 
     RunBenchmarks<PointSpritesBenchmark>(pointSpriteParams);
+
+    std::vector<IndexDataRangesParams> indexRangeParams;
+
+    for (size_t platIt = 0; platIt < ArraySize(platforms); platIt++)
+    {
+        for (size_t typeIt = 0; typeIt < ArraySize(indexTypes); typeIt++)
+        {
+            for (size_t nfrIt = 0; nfrIt < ArraySize(indexUpdatesEveryNFrames); nfrIt++)
+            {
+                IndexDataRangesParams params;
+
+                params.requestedRenderer = platforms[platIt];
+                params.indexType = indexTypes[typeIt];
+                params.updatesEveryNFrames = indexUpdatesEveryNFrames[nfrIt];
+                params.indexCount = 1024 * 1024;
+                params.maxDrawCount = 64 * 1024;
+                params.updateSize = 256;
+                params.iterations = 100;
+                params.clientSideIndices = false;
+
+                indexRangeParams.push_back(params);
+            }
+        }
+
+        // Full scans of client-side index data for every index type
+        for (size_t typeIt = 0; typeIt < ArraySize(allIndexTypes); typeIt++)
+        {
+            IndexDataRangesParams params;
+
+            params.requestedRenderer = platforms[platIt];
+            params.indexType = allIndexTypes[typeIt];
+            params.updatesEveryNFrames = 1;
+            params.indexCount = 1024 * 1024;
+            params.maxDrawCount = 1024 * 1024;
+            params.updateSize = 0;
+            params.iterations = 10;
+            params.clientSideIndices = true;
+
+            indexRangeParams.push_back(params);
+        }
+    }
+
+    RunBenchmarks<IndexDataRangesBenchmark>(indexRangeParams);
+
+    std::vector<DrawCallPerfParams> drawCallParams;
+
+    for (size_t platIt = 0; platIt < ArraySize(platforms); platIt++)
+    {
+        for (size_t changeIt = 0; changeIt < ArraySize(drawCallStateChanges); changeIt++)
+        {
+            DrawCallPerfParams params;
+
+            params.requestedRenderer = platforms[platIt];
+            params.stateChange = drawCallStateChanges[changeIt];
+            params.vertexAttribCount = 1;
+            params.textureCount = 0;
+            params.iterations = 1000;
+
+            drawCallParams.push_back(params);
+        }
+
+        // Validation of many vertex attributes per draw
+        DrawCallPerfParams params;
+
+        params.requestedRenderer = platforms[platIt];
+        params.stateChange = DRAW_CALL_NO_STATE_CHANGE;
+        params.vertexAttribCount = 16;
+        params.textureCount = 0;
+        params.iterations = 1000;
+
+        drawCallParams.push_back(params);
+
+        // Completeness checks of many mipmapped textures per draw
+        params.vertexAttribCount = 1;
+        params.textureCount = 16;
+
+        drawCallParams.push_back(params);
+    }
+
+    RunBenchmarks<DrawCallPerfBenchmark>(drawCallParams);
+
+    std::vector<BindingsPerfParams> bindingsParams;
+
+    for (size_t platIt = 0; platIt < ArraySize(platforms); platIt++)
+    {
+        for (int applicationNames = 0; applicationNames < 2; applicationNames++)
+        {
+            BindingsPerfParams params;
+
+            params.requestedRenderer = platforms[platIt];
+            params.objectCount = 256;
+            params.applicationNames = (applicationNames != 0);
+            params.iterations = 100;
+
+            bindingsParams.push_back(params);
+        }
+    }
+
+    RunBenchmarks<BindingsPerfBenchmark>(bindingsParams);
+
+    std::vector<ProgramBinaryPerfParams> programBinaryParams;
+
+    for (size_t platIt = 0; platIt < ArraySize(platforms); platIt++)
+    {
+        ProgramBinaryPerfParams params;
+
+        params.requestedRenderer = platforms[platIt];
+        params.uniformCount = 48;
+        params.varyingCount = 6;
+        params.iterations = 20;
+
+        programBinaryParams.push_back(params);
+    }
+
+    RunBenchmarks<ProgramBinaryPerfBenchmark>(programBinaryParams);
 }
@@ -11,9 +11,53 @@
 
 #include "shader_utils.h"
 
+namespace
+{
+
+GLsizei GetPixelBytes(GLenum format, GLenum type)
+{
+    switch (type)
+    {
+      case GL_UNSIGNED_SHORT_5_6_5:
+      case GL_UNSIGNED_SHORT_4_4_4_4:
+      case GL_UNSIGNED_SHORT_5_5_5_1:
+        return 2;
+      case GL_UNSIGNED_BYTE:
+        switch (format)
+        {
+          case GL_LUMINANCE:       return 1;
+          case GL_LUMINANCE_ALPHA: return 2;
+          case GL_RGB:             return 3;
+          case GL_RGBA:            return 4;
+          default: assert(0);      return 0;
+        }
+      default:
+        assert(0);
+        return 0;
+    }
+}
+
+}
+
 std::string TexSubImageParams::suffix() const
 {
-    return "";
+    // RGBA8 keeps the original, unsuffixed name so existing results stay comparable
+    switch (internalFormat)
+    {
+      case GL_RGBA8:                  return "";
+      case GL_RGB8:                   return "_rgb8";
+      case GL_RGB565:                 return "_rgb565";
+      case GL_RGBA4:                  return "_rgba4";
+      case GL_RGB5_A1:                return "_rgb5a1";
+      case GL_LUMINANCE8_EXT:         return "_l8";
+      case GL_LUMINANCE8_ALPHA8_EXT:  return "_la8";
+      default:
+        {
+            std::stringstream strstr;
+            strstr << "_fmt_" << internalFormat;
+            return strstr.str();
+        }
+    }
 }
 
 TexSubImageBenchmark::TexSubImageBenchmark(const TexSubImageParams &params)
@@ -26,7 +70,8 @@ TexSubImageBenchmark::TexSubImageBenchmark(const TexSubImageParams &params)
       mTexture(0),
       mVertexBuffer(0),
       mIndexBuffer(0),
-      mPixels(NULL)
+      mPixels(NULL),
+      mTexelBytesUploaded(0.0)
 {
     assert(mParams.iterations > 0);
     mDrawIterations = mParams.iterations;
@@ -44,7 +89,7 @@ GLuint TexSubImageBenchmark::createTexture()
     // Bind the texture object
     glBindTexture(GL_TEXTURE_2D, texture);
 
-    glTexStorage2DEXT(GL_TEXTURE_2D, 1, GL_RGBA8, mParams.imageWidth, mParams.imageHeight);
+    glTexStorage2DEXT(GL_TEXTURE_2D, 1, mParams.internalFormat, mParams.imageWidth, mParams.imageHeight);
 
     // Set the filtering mode
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -118,19 +163,14 @@ bool TexSubImageBenchmark::initializeBenchmark()
 
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
 
-    mPixels = new GLubyte[mParams.subImageWidth * mParams.subImageHeight * 4];
+    GLsizei pixelBytes = GetPixelBytes(mParams.format, mParams.type);
+    GLsizei imageBytes = mParams.subImageWidth * mParams.subImageHeight * pixelBytes;
+    mPixels = new GLubyte[imageBytes];
 
-    // Fill the pixels structure with random data:
-    for (int y = 0; y < mParams.subImageHeight; ++y)
+    // Fill the pixels structure with random data, the packed formats take any bit pattern
+    for (GLsizei byte = 0; byte < imageBytes; ++byte)
     {
-        for (int x = 0; x < mParams.subImageWidth; ++x)
-        {
-            int offset = (x + (y * mParams.subImageWidth)) * 4;
-            mPixels[offset + 0] = rand() % 255; // Red
-            mPixels[offset + 1] = rand() % 255; // Green
-            mPixels[offset + 2] = rand() % 255; // Blue
-            mPixels[offset + 3] = 255; // Alpha
-        }
+        mPixels[byte] = rand() % 255;
     }
 
     return true;
@@ -145,6 +185,9 @@ void TexSubImageBenchmark::destroyBenchmark()
     printResult("subimage_height", static_cast<size_t>(mParams.subImageHeight), "pix", false);
     printResult("iterations", static_cast<size_t>(mParams.iterations), "updates", false);
 
+    double megabytesPerSecond = mTexelBytesUploaded / (1024.0 * 1024.0) / mRunTimeSeconds;
+    printResult("upload_throughput", megabytesPerSecond, "MB/s", true);
+
     glDeleteProgram(mProgram);
     glDeleteBuffers(1, &mVertexBuffer);
     glDeleteBuffers(1, &mIndexBuffer);
@@ -189,7 +232,10 @@ void TexSubImageBenchmark::drawBenchmark()
                     rand() % (mParams.imageWidth - mParams.subImageWidth),
                     rand() % (mParams.imageHeight - mParams.subImageHeight),
                     mParams.subImageWidth, mParams.subImageHeight,
-                    GL_RGBA, GL_UNSIGNED_BYTE, mPixels);
+                    mParams.format, mParams.type, mPixels);
+
+    mTexelBytesUploaded += static_cast<double>(mParams.subImageWidth * mParams.subImageHeight *
+                                               GetPixelBytes(mParams.format, mParams.type));
 
     glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0);
 }
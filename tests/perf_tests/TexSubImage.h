@@ -15,6 +15,9 @@ struct TexSubImageParams : public BenchmarkParams
     int imageHeight;
     int subImageWidth;
     int subImageHeight;
+    GLenum internalFormat;
+    GLenum format;
+    GLenum type;
     unsigned int iterations;
 };
 
@@ -51,4 +54,6 @@ class TexSubImageBenchmark : public SimpleBenchmark
     GLuint mIndexBuffer;
 
     GLubyte *mPixels;
+
+    double mTexelBytesUploaded;
 };
@@ -0,0 +1,87 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "PreprocessorTest.h"
+#include "Token.h"
+
+#include <cstdlib>
+#include <new>
+#include <sstream>
+
+namespace
+{
+
+bool gCountAllocations = false;
+size_t gAllocationCount = 0;
+
+}
+
+// Counts the allocations of the whole test binary while gCountAllocations is set.
+void *operator new(std::size_t size)
+{
+    if (gCountAllocations)
+    {
+        gAllocationCount++;
+    }
+
+    void *memory = malloc(size > 0 ? size : 1);
+    if (memory == NULL)
+    {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void *memory)
+{
+    free(memory);
+}
+
+class AllocationTest : public PreprocessorTest
+{
+  protected:
+    // Lexes the lines of the input up to |countFromLine| to let the buffers of the
+    // preprocessor grow, then returns the allocations made lexing the rest.
+    size_t countSteadyStateAllocations(const std::string &input, int countFromLine)
+    {
+        const char *inputString = input.c_str();
+        EXPECT_TRUE(mPreprocessor.init(1, &inputString, NULL));
+
+        pp::Token token;
+        do
+        {
+            mPreprocessor.lex(&token);
+        } while (token.type != pp::Token::LAST && token.location.line < countFromLine);
+
+        gAllocationCount = 0;
+        gCountAllocations = true;
+        while (token.type != pp::Token::LAST)
+        {
+            mPreprocessor.lex(&token);
+        }
+        gCountAllocations = false;
+
+        return gAllocationCount;
+    }
+};
+
+// std::string in libstdc++ before the C++11 ABI is copy-on-write and has no inline buffer.
+#if !defined(__GLIBCXX__) || _GLIBCXX_USE_CXX11_ABI
+TEST_F(AllocationTest, ShortSpellingsDoNotAllocate)
+{
+    // Every spelling is short enough for the inline buffer of std::string
+    std::ostringstream stream;
+    stream << "#define SCALE 0.5\n"
+              "#define ADD(a, b) ((a) + (b))\n"
+              "#define MAD(a, b, c) ADD((a) * (b), c)\n";
+    for (int line = 0; line < 100; line++)
+    {
+        stream << "c = MAD(c, SCALE, ADD(t, 2.0)) + texture2D(s, uv);\n";
+    }
+
+    EXPECT_EQ(0u, countSteadyStateAllocations(stream.str(), 50));
+}
+#endif
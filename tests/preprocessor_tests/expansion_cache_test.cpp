@@ -0,0 +1,187 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "PreprocessorTest.h"
+#include "Macro.h"
+#include "Token.h"
+
+class ExpansionCacheTest : public PreprocessorTest
+{
+  protected:
+    // Preprocesses the input with and without the expansion cache, and
+    // verifies that both match the expected output.
+    void preprocessCached(const char *input, const char *expected)
+    {
+        preprocess(input, expected);
+
+        pp::Preprocessor uncached(&mDiagnostics, &mDirectiveHandler);
+        uncached.setMacroExpansionCacheEnabled(false);
+        ASSERT_TRUE(uncached.init(1, &input, NULL));
+
+        int line = 1;
+        pp::Token token;
+        std::stringstream stream;
+        do
+        {
+            uncached.lex(&token);
+            for (; line < token.location.line; ++line)
+            {
+                stream << "\n";
+            }
+            stream << token;
+        } while (token.type != pp::Token::LAST);
+        EXPECT_EQ(expected, stream.str());
+        EXPECT_EQ(0u, uncached.getMacroStatistics().cacheHitCount);
+    }
+
+    const pp::MacroStatistics &statistics() const
+    {
+        return mPreprocessor.getMacroStatistics();
+    }
+};
+
+TEST_F(ExpansionCacheTest, ReusesNestedExpansion)
+{
+    const char *input = "#define ONE 1\n"
+                        "#define TWO (ONE + ONE)\n"
+                        "#define FOUR (TWO * TWO)\n"
+                        "FOUR FOUR\n"
+                        "FOUR\n";
+    const char *expected = "\n"
+                           "\n"
+                           "\n"
+                           "((1 + 1) * (1 + 1)) ((1 + 1) * (1 + 1))\n"
+                           "((1 + 1) * (1 + 1))\n";
+    preprocessCached(input, expected);
+
+    // FOUR and TWO are expanded in full once each and ONE needs no cache.
+    // The second TWO in FOUR and the last two FOURs are read from the cache.
+    EXPECT_EQ(2u, statistics().cacheMissCount);
+    EXPECT_EQ(3u, statistics().cacheHitCount);
+    EXPECT_LE(5u, statistics().expansionCount);
+}
+
+TEST_F(ExpansionCacheTest, InvalidatedByDefinitions)
+{
+    const char *input = "#define A B\n"
+                        "#define B 1\n"
+                        "A\n"
+                        "#undef B\n"
+                        "A\n"
+                        "#define B 2\n"
+                        "A\n";
+    const char *expected = "\n"
+                           "\n"
+                           "1\n"
+                           "\n"
+                           "B\n"
+                           "\n"
+                           "2\n";
+    preprocessCached(input, expected);
+}
+
+TEST_F(ExpansionCacheTest, RecursiveMacros)
+{
+    const char *input = "#define A B + A\n"
+                        "#define B A + C\n"
+                        "#define C 1\n"
+                        "A\n"
+                        "B\n"
+                        "A B\n";
+    const char *expected = "\n"
+                           "\n"
+                           "\n"
+                           "A + 1 + A\n"
+                           "B + A + 1\n"
+                           "A + 1 + A B + A + 1\n";
+    preprocessCached(input, expected);
+    EXPECT_EQ(0u, statistics().cacheHitCount);
+}
+
+TEST_F(ExpansionCacheTest, ExpandedInsideDisabledMacro)
+{
+    const char *input = "#define ONE 1\n"
+                        "#define X (Y + ONE)\n"
+                        "#define Y X\n"
+                        "#define f(a) a\n"
+                        "X\n"
+                        "Y\n"
+                        "f(X) f(ONE)\n";
+    const char *expected = "\n"
+                           "\n"
+                           "\n"
+                           "\n"
+                           "(X + 1)\n"
+                           "(Y + 1)\n"
+                           "(X + 1) 1\n";
+    preprocessCached(input, expected);
+}
+
+TEST_F(ExpansionCacheTest, FunctionLikeMacroAtEnd)
+{
+    const char *input = "#define f(a) [a]\n"
+                        "#define G f\n"
+                        "#define H G(1)\n"
+                        "G(2) G (3) G\n"
+                        "H H\n";
+    const char *expected = "\n"
+                           "\n"
+                           "\n"
+                           "[2] [3] f\n"
+                           "[1] [1]\n";
+    preprocessCached(input, expected);
+}
+
+TEST_F(ExpansionCacheTest, LineInReplacementList)
+{
+    const char *input = "#define ONE 1\n"
+                        "#define L (__LINE__ + ONE)\n"
+                        "L\n"
+                        "L\n";
+    const char *expected = "\n"
+                           "\n"
+                           "(3 + 1)\n"
+                           "(4 + 1)\n";
+    preprocessCached(input, expected);
+    EXPECT_EQ(0u, statistics().cacheHitCount);
+}
+
+TEST_F(ExpansionCacheTest, ManyMacros)
+{
+    // Enough definitions and undefinitions to grow the table and reuse
+    // erased slots.
+    std::stringstream input;
+    std::stringstream expected;
+    for (int i = 0; i < 500; ++i)
+    {
+        input << "#define M" << i << " " << i << "\n";
+        expected << "\n";
+    }
+    for (int i = 0; i < 500; i += 2)
+    {
+        input << "#undef M" << i << "\n";
+        expected << "\n";
+    }
+    for (int i = 0; i < 500; ++i)
+    {
+        input << "M" << i << "\n";
+        if (i % 2)
+            expected << i << "\n";
+        else
+            expected << "M" << i << "\n";
+    }
+    for (int i = 0; i < 500; i += 4)
+    {
+        input << "#define M" << i << " (M" << i + 1 << ")\n"
+              << "M" << i << "\n";
+        expected << "\n"
+                 << "(" << i + 1 << ")\n";
+    }
+
+    std::string inputString = input.str();
+    std::string expectedString = expected.str();
+    preprocessCached(inputString.c_str(), expectedString.c_str());
+}
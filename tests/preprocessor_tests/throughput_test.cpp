@@ -0,0 +1,84 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "PreprocessorTest.h"
+#include "Token.h"
+
+#include <sstream>
+
+namespace
+{
+
+// A shader in the style of generated material and lighting code: small function-like
+// macros that expand other macros, both in their bodies and in their arguments.
+std::string MakeMacroHeavyShader(int lineCount)
+{
+    std::ostringstream stream;
+    stream << "#define SCALE 0.5\n"
+              "#define ADD(a, b) ((a) + (b))\n"
+              "#define MUL(a, b) ((a) * (b))\n"
+              "#define MAD(a, b, c) ADD(MUL(a, b), c)\n"
+              "#define LERP(a, b, t) MAD(ADD(b, -(a)), t, a)\n"
+              "#define HALF_COLOR vec4(SCALE, SCALE, SCALE, 1.0)\n"
+              "#define SAMPLE_WEIGHTED(weight, offset) MUL(texture2D(s, uv + offset), weight)\n";
+    for (int line = 0; line < lineCount; line++)
+    {
+        stream << "c = LERP(c, HALF_COLOR, MAD(t, SCALE, " << line << ".0)) + "
+                  "SAMPLE_WEIGHTED(SCALE, vec2(" << line << ".0, SCALE));\n";
+    }
+    return stream.str();
+}
+
+}
+
+class ThroughputTest : public PreprocessorTest
+{
+  protected:
+    // Returns the number of tokens produced for the input.
+    size_t lexAll(pp::Preprocessor *preprocessor, const char *input)
+    {
+        EXPECT_TRUE(preprocessor->init(1, &input, NULL));
+
+        size_t tokenCount = 0;
+        pp::Token token;
+        do
+        {
+            preprocessor->lex(&token);
+            tokenCount++;
+        } while (token.type != pp::Token::LAST);
+        return tokenCount;
+    }
+};
+
+TEST_F(ThroughputTest, MacroHeavyShader)
+{
+    const char *input = "#define ONE 1.0\n"
+                        "#define ADD(a, b) ((a) + (b))\n"
+                        "#define MUL(a, b) ((a) * (b))\n"
+                        "#define MAD(a, b, c) ADD(MUL(a, b), c)\n"
+                        "MAD(ONE, ADD(x, ONE), MUL(y,z))\n"
+                        "MAD(ADD, MUL, ONE)\n";
+    const char *expected = "\n"
+                           "\n"
+                           "\n"
+                           "\n"
+                           "((((1.0) * (((x) + (1.0))))) + (((y) * (z))))\n"
+                           "((((ADD) * (MUL))) + (1.0))\n";
+
+    preprocess(input, expected);
+}
+
+TEST_F(ThroughputTest, RepeatedExpansion)
+{
+    // The same input gives the same tokens however often its macros are expanded
+    std::string shader = MakeMacroHeavyShader(50);
+    size_t firstCount = lexAll(&mPreprocessor, shader.c_str());
+    for (int iteration = 0; iteration < 3; iteration++)
+    {
+        pp::Preprocessor preprocessor(&mDiagnostics, &mDirectiveHandler);
+        EXPECT_EQ(firstCount, lexAll(&preprocessor, shader.c_str()));
+    }
+}
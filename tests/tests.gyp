@@ -128,6 +128,76 @@
                 },
             },
         },
+        {
+            # Benchmarks of the translator and of implementation classes, which the perf tests
+            # can't reach through the GL entry points.
+            'target_name': 'angle_internal_perf_tests',
+            'type': 'executable',
+            'dependencies':
+            [
+                '../src/angle.gyp:translator_static',
+            ],
+            'include_dirs':
+            [
+                '.',
+                '../include',
+                '../src',
+            ],
+            'includes': [ '../build/common_defines.gypi', ],
+            'sources':
+            [
+                'internal_perf_tests/BatchCompilePerf.cpp',
+                'internal_perf_tests/BuiltInSymbolTablePerf.cpp',
+                'internal_perf_tests/InternalBenchmark.cpp',
+                'internal_perf_tests/InternalBenchmark.h',
+                'internal_perf_tests/IntermTraversePerf.cpp',
+                'internal_perf_tests/OptimizeTreePerf.cpp',
+                'internal_perf_tests/PassManagerPerf.cpp',
+                'internal_perf_tests/PoolAllocPerf.cpp',
+                'internal_perf_tests/PreprocessorPerf.cpp',
+                'internal_perf_tests/ResourceMapPerf.cpp',
+                'internal_perf_tests/SymbolTablePerf.cpp',
+                'internal_perf_tests/TranslationCachePerf.cpp',
+                'internal_perf_tests/internal_perf_tests_main.cpp',
+                'perf_tests/third_party/perf/perf_test.cc',
+                'perf_tests/third_party/perf/perf_test.h',
+            ],
+            'conditions':
+            [
+                ['OS=="win"',
+                {
+                    'dependencies':
+                    [
+                        '../src/angle.gyp:libGLESv2_static',
+                    ],
+                    'sources':
+                    [
+                        'internal_perf_tests/FormatUtilsPerf.cpp',
+                        'internal_perf_tests/GenerateMipPerf.cpp',
+                        'internal_perf_tests/IndexRangeCachePerf.cpp',
+                        'internal_perf_tests/ParallelImagePerf.cpp',
+                        'internal_perf_tests/ProgramNameIndexPerf.cpp',
+                        'internal_perf_tests/UniformPerf.cpp',
+                    ],
+                }],
+            ],
+            'msvs_settings':
+            {
+                'VCLinkerTool':
+                {
+                    'conditions':
+                    [
+                        ['angle_build_winrt==1',
+                        {
+                            'AdditionalDependencies':
+                            [
+                                'runtimeobject.lib',
+                            ],
+                        }],
+                    ],
+                },
+            },
+        },
     ],
 
     'conditions':
@@ -196,10 +266,18 @@
                     ],
                     'sources':
                     [
+                        'perf_tests/BindingsPerf.cpp',
+                        'perf_tests/BindingsPerf.h',
                         'perf_tests/BufferSubData.cpp',
                         'perf_tests/BufferSubData.h',
+                        'perf_tests/DrawCallPerf.cpp',
+                        'perf_tests/DrawCallPerf.h',
+                        'perf_tests/IndexDataRanges.cpp',
+                        'perf_tests/IndexDataRanges.h',
                         'perf_tests/PointSprites.cpp',
                         'perf_tests/PointSprites.h',
+                        'perf_tests/ProgramBinaryPerf.cpp',
+                        'perf_tests/ProgramBinaryPerf.h',
                         'perf_tests/SimpleBenchmark.cpp',
                         'perf_tests/SimpleBenchmark.h',
                         'perf_tests/SimpleBenchmarks.cpp',